@@ -7,6 +7,7 @@
 
 #include <qstring.h>
 
+#include "Fofem6BarkThickness.h"
 #include "Fofem6Mortality.h"
 #include "Fofem6Species.h"
 
@@ -213,3 +214,201 @@ double Fofem6Mortality::mortalityRate(
 	}
 	return 0.;
 }
+
+//------------------------------------------------------------------------------
+/*! \brief Resolves an array of Fofem6Species indices to their mortality and
+ *	bark thickness equation numbers.
+ *
+ *	This is done once per tree list so that standMortality() never looks up
+ *	a species by its code.
+ *
+ *  \param trees Number of trees in the list.
+ *  \param speciesIndex Array of Fofem6Species indices (see
+ *	Fofem6Species::getFofem6SpeciesIndex()).
+ *  \param mortalityEquation Array where the mortality equation numbers are
+ *	returned, or -1 for an invalid species index.
+ *  \param barkEquation Array where the bark thickness equation numbers are
+ *	returned, or -1 for an invalid species index.
+ *
+ *  \return Number of trees with an invalid species index.
+ */
+
+int Fofem6Mortality::resolveSpecies(
+	int trees,
+	const int* speciesIndex,
+	int* mortalityEquation,
+	int* barkEquation
+)
+{
+	// Build the per-species lookup once, then apply it to every tree
+	int species = Fofem6Species::getSpeciesCount();
+	int* mortEq = new int[ species ];
+	int* barkEq = new int[ species ];
+	for ( int idx=0; idx<species; idx++ )
+	{
+		mortEq[idx] = Fofem6Species::getMortalityEquationIndexAt( idx );
+		barkEq[idx] = Fofem6Species::getBarkEquationIndexAt( idx );
+	}
+	int invalid = 0;
+	for ( int tree=0; tree<trees; tree++ )
+	{
+		int idx = speciesIndex[tree];
+		if ( idx >= 0 && idx < species )
+		{
+			mortalityEquation[tree] = mortEq[idx];
+			barkEquation[tree] = barkEq[idx];
+		}
+		else
+		{
+			mortalityEquation[tree] = -1;
+			barkEquation[tree] = -1;
+			invalid++;
+		}
+	}
+	delete[] mortEq;
+	delete[] barkEq;
+	return invalid;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Calculates probability of tree mortality for every tree in a stand
+ *	for each of a series of fire scorch heights, and summarizes the number
+ *	of trees and basal area killed by each.
+ *
+ *	The tree list is passed as separate columns so that each pass over the
+ *	trees reads contiguous arrays.  Species are resolved to their equation
+ *	numbers once by resolveSpecies(), and each tree's bark thickness, crown
+ *	length, crown base height, and basal area are computed once for all the
+ *	scenarios.  Each scenario then makes a branch-free pass to compute the
+ *	crown length and volume scorched (using the same geometry as
+ *	FBL_TreeCrownScorch()) followed by a pass through mortalityRate().
+ *	Scenarios are independent, and are evaluated in parallel when compiled
+ *	with OpenMP.
+ *
+ *	As with the single tree methods, tree dbh is limited to a minimum
+ *	of 1 inch, and trees with an invalid species index are not killed.
+ *
+ *  \param trees Number of trees in the list.
+ *  \param speciesIndex Array of Fofem6Species indices.
+ *  \param dbh Array of tree diameters at breast height (in).
+ *  \param crownRatio Array of tree crown ratios (fraction).
+ *  \param treeHt Array of tree heights (ft).
+ *  \param treeCount Array of the number of trees represented by each record
+ *	(e.g., the plot expansion factor), or NULL if each record is one tree.
+ *  \param scenarios Number of fire scenarios.
+ *  \param scorchHt Array of scenario scorch heights (ft).
+ *  \param mortality Array of scenarios*trees where the tree mortality
+ *	probabilities [0..1] are returned (mortality[scenario*trees+tree]),
+ *	or NULL if not wanted.
+ *  \param summary Array of scenarios StandSummary structures where the
+ *	stand summaries are returned, or NULL if not wanted.
+ */
+
+void Fofem6Mortality::standMortality(
+	int trees,
+	const int* speciesIndex,
+	const double* dbh,			// in
+	const double* crownRatio,	// fraction
+	const double* treeHt,		// ft
+	const double* treeCount,	// trees per record
+	int scenarios,
+	const double* scorchHt,		// ft
+	double* mortality,			// fraction
+	StandSummary* summary
+)
+{
+	if ( trees <= 0 || scenarios <= 0 )
+	{
+		return;
+	}
+	// Resolve species and all scenario-independent tree attributes once
+	int* mortEq = new int[ trees ];
+	int* barkEq = new int[ trees ];
+	resolveSpecies( trees, speciesIndex, mortEq, barkEq );
+	double* treeDbh   = new double[ trees ];
+	double* treeBark  = new double[ trees ];
+	double* crownLeng = new double[ trees ];
+	double* crownBase = new double[ trees ];
+	double* treeBa    = new double[ trees ];
+	double* treeN     = new double[ trees ];
+	double totalTrees = 0.;
+	double totalBa = 0.;
+	int tree;
+	for ( tree=0; tree<trees; tree++ )
+	{
+		double d = ( dbh[tree] < 1.0 ) ? 1.0 : dbh[tree];
+		treeDbh[tree]   = d;
+		treeBark[tree]  = ( barkEq[tree] < 0 ) ? 0.
+						: Fofem6BarkThickness::barkThickness( barkEq[tree], d );
+		crownLeng[tree] = treeHt[tree] * crownRatio[tree];
+		crownBase[tree] = treeHt[tree] - crownLeng[tree];
+		treeN[tree]     = treeCount ? treeCount[tree] : 1.0;
+		// Basal area (ft2) from dbh (in) is pi * dbh * dbh / 576
+		treeBa[tree]    = treeN[tree] * 0.005454154 * dbh[tree] * dbh[tree];
+		totalTrees += treeN[tree];
+		totalBa += treeBa[tree];
+	}
+
+	// Each scenario is independent of the others
+	int scenario;
+#ifdef _OPENMP
+#pragma omp parallel for private(tree)
+#endif
+	for ( scenario=0; scenario<scenarios; scenario++ )
+	{
+		double sht = scorchHt[scenario];
+		double* cls = new double[ trees ];
+		double* cvs = new double[ trees ];
+		double* mr  = mortality ? ( mortality + scenario * trees )
+							   : new double[ trees ];
+		// Crown length fraction and crown volume scorched
+		for ( tree=0; tree<trees; tree++ )
+		{
+			double cl = crownLeng[tree];
+			double sl = sht - crownBase[tree];
+			sl = ( sl < 0. ) ? 0. : sl;
+			sl = ( sl > cl ) ? cl : sl;
+			double big = ( cl < 1.0e-07 ) ? 0. : 1.;
+			double den = big * cl + ( 1. - big );
+			cls[tree] = big * ( sl / den ) + ( 1. - big ) * ( ( sl > 0. ) ? 1. : 0. );
+			cvs[tree] = big * ( sl * ( 2. * cl - sl ) / ( den * den ) );
+		}
+		// Mortality probability
+		for ( tree=0; tree<trees; tree++ )
+		{
+			mr[tree] = ( mortEq[tree] < 0 ) ? 0.
+				: mortalityRate( mortEq[tree], treeDbh[tree], treeBark[tree],
+					sht, cls[tree], cvs[tree] );
+		}
+		// Stand summary
+		if ( summary )
+		{
+			double killed = 0.;
+			double baKilled = 0.;
+			for ( tree=0; tree<trees; tree++ )
+			{
+				killed += treeN[tree] * mr[tree];
+				baKilled += treeBa[tree] * mr[tree];
+			}
+			summary[scenario].trees = totalTrees;
+			summary[scenario].treesKilled = killed;
+			summary[scenario].basalArea = totalBa;
+			summary[scenario].basalAreaKilled = baKilled;
+		}
+		if ( ! mortality )
+		{
+			delete[] mr;
+		}
+		delete[] cls;
+		delete[] cvs;
+	}
+	delete[] mortEq;
+	delete[] barkEq;
+	delete[] treeDbh;
+	delete[] treeBark;
+	delete[] crownLeng;
+	delete[] crownBase;
+	delete[] treeBa;
+	delete[] treeN;
+	return;
+}
@@ -11,6 +11,18 @@
 class Fofem6Mortality
 {
 public:
+	/*!	\struct StandSummary
+	*	\brief Stand-level results for one fire scenario returned by
+	*	standMortality().
+	*/
+	typedef struct _standSummary
+	{
+		double trees;				// Number of trees
+		double treesKilled;			// Expected number of trees killed
+		double basalArea;			// Basal area (ft2)
+		double basalAreaKilled;		// Expected basal area killed (ft2)
+	} StandSummary;
+
 	static double mortalityRate(
 		int    equationId,			//!> 1,3,5,10-12,14-20
 		double dbh,					//!> in
@@ -26,6 +38,24 @@ public:
 		double scorchHt,			//!> ft
 		double crownLengScorched,	//!> fraction
 		double crownVolScorched );	//!> fraction
+
+	static int resolveSpecies(
+		int trees,
+		const int* speciesIndex,	//!> Fofem6Species index [trees]
+		int* mortalityEquation,		//!> returned equation id [trees]
+		int* barkEquation );		//!> returned equation id [trees]
+
+	static void standMortality(
+		int trees,
+		const int* speciesIndex,	//!> Fofem6Species index [trees]
+		const double* dbh,			//!> in [trees]
+		const double* crownRatio,	//!> fraction [trees]
+		const double* treeHt,		//!> ft [trees]
+		const double* treeCount,	//!> trees per record [trees], or NULL
+		int scenarios,
+		const double* scorchHt,		//!> ft [scenarios]
+		double* mortality,			//!> [scenarios*trees], or NULL
+		StandSummary* summary );	//!> [scenarios], or NULL
 };
 
 #endif	// BEHAVEPLUS6_ALGORITHMS_FOFEM6MORTALITY
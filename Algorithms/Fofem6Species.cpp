@@ -3,9 +3,111 @@
 
 */
 
+#include <algorithm>
+#include <cstring>
 #include <string>
 #include "Fofem6Species.h"
 
+Fofem6Species::SpeciesRecord* Fofem6Species::m_record = 0;
+int* Fofem6Species::m_fofem5Index = 0;
+int* Fofem6Species::m_fofem6Index = 0;
+int  Fofem6Species::m_count = -1;
+
+//------------------------------------------------------------------------------
+/*!	\brief Orders Species[] indices by FOFEM 5 or 6 code, then by index, so that
+	a lookup finds the first Species[] entry with a duplicated code.
+*/
+struct Fofem6SpeciesLess
+{
+	Fofem6SpeciesLess( Fofem6Species::SpeciesStruct* species, bool fofem5 ) :
+		m_species( species ),
+		m_fofem5( fofem5 )
+	{}
+	bool operator()( int a, int b ) const
+	{
+		int cmp = m_fofem5
+			? strcmp( m_species[a].fofem5, m_species[b].fofem5 )
+			: strcmp( m_species[a].fofem6, m_species[b].fofem6 );
+		return ( cmp < 0 ) || ( cmp == 0 && a < b );
+	}
+	Fofem6Species::SpeciesStruct* m_species;
+	bool m_fofem5;
+};
+
+//------------------------------------------------------------------------------
+/*!	\brief Builds the compact species records and the sorted FOFEM 5 and
+	FOFEM 6 code indexes on first use.
+*/
+void Fofem6Species::buildIndex( void )
+{
+	if ( m_count >= 0 )
+	{
+		return;
+	}
+	int count = 0;
+	while ( m_species[count].fofem6 != 0 )
+	{
+		count++;
+	}
+	m_record = new SpeciesRecord[ count ];
+	m_fofem5Index = new int[ count ];
+	m_fofem6Index = new int[ count ];
+	for ( int idx=0; idx<count; idx++ )
+	{
+		m_record[idx].species = idx;
+		m_record[idx].mortEq  = m_species[idx].mortEq;
+		m_record[idx].barkEq  = m_species[idx].barkEq;
+		m_fofem5Index[idx] = idx;
+		m_fofem6Index[idx] = idx;
+	}
+	std::sort( m_fofem5Index, m_fofem5Index + count,
+		Fofem6SpeciesLess( m_species, true ) );
+	std::sort( m_fofem6Index, m_fofem6Index + count,
+		Fofem6SpeciesLess( m_species, false ) );
+	m_count = count;
+}
+
+//------------------------------------------------------------------------------
+/*!	\brief Binary searches a sorted code index for a species code.
+	\param index Sorted code index (m_fofem5Index or m_fofem6Index).
+	\param fofem5 TRUE if \a index is sorted by FOFEM 5 code.
+	\param code The species code to find.
+	\return Returns the lowest Species[] index with the code, or -1 if not found.
+*/
+int Fofem6Species::findCode( const int* index, bool fofem5, const char* code )
+{
+	if ( code == 0 )
+	{
+		return -1;
+	}
+	int lo = 0;
+	int hi = m_count;
+	while ( lo < hi )
+	{
+		int mid = ( lo + hi ) / 2;
+		const char* key = fofem5 ? m_species[index[mid]].fofem5
+								 : m_species[index[mid]].fofem6;
+		if ( strcmp( key, code ) < 0 )
+		{
+			lo = mid + 1;
+		}
+		else
+		{
+			hi = mid;
+		}
+	}
+	if ( lo < m_count )
+	{
+		int idx = index[lo];
+		const char* key = fofem5 ? m_species[idx].fofem5 : m_species[idx].fofem6;
+		if ( strcmp( key, code ) == 0 )
+		{
+			return idx;
+		}
+	}
+	return -1;
+}
+
 //------------------------------------------------------------------------------
 /*!	\brief Returns the species bark equation index given the FOFEM5 species code.
 	\param fofem5SpeciesCode The FOFEM v5 species alphabetic code.
@@ -13,8 +115,8 @@
 */
 int Fofem6Species::getFofem5BarkEquationIndex( const char* fofem5SpeciesCode )
 {
-	int idx = getFofem5SpeciesIndex( fofem5SpeciesCode );
-	return ( idx < 0 ) ? -1 : m_species[idx].barkEq;
+	const SpeciesRecord* rec = getFofem5SpeciesRecord( fofem5SpeciesCode );
+	return ( rec == 0 ) ? -1 : rec->barkEq;
 }
 
 //------------------------------------------------------------------------------
@@ -24,8 +126,8 @@ int Fofem6Species::getFofem5BarkEquationIndex( const char* fofem5SpeciesCode )
 */
 int Fofem6Species::getFofem5MortalityEquationIndex( const char* fofem5SpeciesCode )
 {
-	int idx = getFofem5SpeciesIndex( fofem5SpeciesCode );
-	return ( idx < 0 ) ? -1 : m_species[idx].mortEq;
+	const SpeciesRecord* rec = getFofem5SpeciesRecord( fofem5SpeciesCode );
+	return ( rec == 0 ) ? -1 : rec->mortEq;
 }
 
 //------------------------------------------------------------------------------
@@ -40,20 +142,25 @@ const char* Fofem6Species::getFofem6SpeciesCode( const char* fofem5SpeciesCode )
 }
 
 //------------------------------------------------------------------------------
-/*!	\brief Returns the FOFEM6 Species[] index given the FOFEM6 species code.
+/*!	\brief Returns the FOFEM6 Species[] index given the FOFEM5 species code.
 	\param fofem5SpeciesCode The FOFEM v5 species alphabetic code.
 	\return Returns a non-negative index on success, -1 on failure.
 */
 int Fofem6Species::getFofem5SpeciesIndex( const char* fofem5SpeciesCode )
 {
-	for( int idx=0; m_species[idx].fofem5 != 0; idx++ )
-	{
-		if ( strcmp( fofem5SpeciesCode, m_species[idx].fofem5 ) == 0 )
-		{
-			return idx;
-		}
-	}
-	return -1;
+	buildIndex();
+	return findCode( m_fofem5Index, true, fofem5SpeciesCode );
+}
+
+//------------------------------------------------------------------------------
+/*!	\brief Returns the compact species record given the FOFEM5 species code.
+	\param fofem5SpeciesCode The FOFEM v5 species alphabetic code.
+	\return Returns a pointer to the species record on success, NULL on failure.
+*/
+const Fofem6Species::SpeciesRecord* Fofem6Species::getFofem5SpeciesRecord(
+	const char* fofem5SpeciesCode )
+{
+	return getSpeciesRecordAt( getFofem5SpeciesIndex( fofem5SpeciesCode ) );
 }
 
 //------------------------------------------------------------------------------
@@ -63,8 +170,8 @@ int Fofem6Species::getFofem5SpeciesIndex( const char* fofem5SpeciesCode )
 */
 int Fofem6Species::getFofem6BarkEquationIndex( const char* fofem6SpeciesCode )
 {
-	int idx = getFofem6SpeciesIndex( fofem6SpeciesCode );
-	return ( idx < 0 ) ? -1 : m_species[idx].barkEq;
+	const SpeciesRecord* rec = getFofem6SpeciesRecord( fofem6SpeciesCode );
+	return ( rec == 0 ) ? -1 : rec->barkEq;
 }
 
 //------------------------------------------------------------------------------
@@ -74,8 +181,8 @@ int Fofem6Species::getFofem6BarkEquationIndex( const char* fofem6SpeciesCode )
 */
 int Fofem6Species::getFofem6MortalityEquationIndex( const char* fofem6SpeciesCode )
 {
-	int idx = getFofem6SpeciesIndex( fofem6SpeciesCode );
-	return ( idx < 0 ) ? -1 : m_species[idx].mortEq;
+	const SpeciesRecord* rec = getFofem6SpeciesRecord( fofem6SpeciesCode );
+	return ( rec == 0 ) ? -1 : rec->mortEq;
 }
 
 //------------------------------------------------------------------------------
@@ -85,12 +192,62 @@ int Fofem6Species::getFofem6MortalityEquationIndex( const char* fofem6SpeciesCod
 */
 int Fofem6Species::getFofem6SpeciesIndex( const char* fofem6SpeciesCode )
 {
-	for( int idx=0; m_species[idx].fofem6 != 0; idx++ )
-	{
-		if ( strcmp( fofem6SpeciesCode, m_species[idx].fofem6 ) == 0 )
-		{
-			return idx;
-		}
-	}
-	return -1;
+	buildIndex();
+	return findCode( m_fofem6Index, false, fofem6SpeciesCode );
+}
+
+//------------------------------------------------------------------------------
+/*!	\brief Returns the compact species record given the FOFEM6 species code.
+	\param fofem6SpeciesCode The FOFEM v6 species alphanumeric code.
+	\return Returns a pointer to the species record on success, NULL on failure.
+*/
+const Fofem6Species::SpeciesRecord* Fofem6Species::getFofem6SpeciesRecord(
+	const char* fofem6SpeciesCode )
+{
+	return getSpeciesRecordAt( getFofem6SpeciesIndex( fofem6SpeciesCode ) );
+}
+
+//------------------------------------------------------------------------------
+/*!	\brief Returns the species bark equation index given its Species[] index.
+	\param speciesIndex The species index as returned by getFofem6SpeciesIndex().
+	\return Returns a non-negative index on success, -1 on failure.
+*/
+int Fofem6Species::getBarkEquationIndexAt( int speciesIndex )
+{
+	const SpeciesRecord* rec = getSpeciesRecordAt( speciesIndex );
+	return ( rec == 0 ) ? -1 : rec->barkEq;
+}
+
+//------------------------------------------------------------------------------
+/*!	\brief Returns the species mortality equation index given its Species[] index.
+	\param speciesIndex The species index as returned by getFofem6SpeciesIndex().
+	\return Returns a non-negative index on success, -1 on failure.
+*/
+int Fofem6Species::getMortalityEquationIndexAt( int speciesIndex )
+{
+	const SpeciesRecord* rec = getSpeciesRecordAt( speciesIndex );
+	return ( rec == 0 ) ? -1 : rec->mortEq;
+}
+
+//------------------------------------------------------------------------------
+/*!	\brief Returns the number of species in the Species[] array.
+	\return Returns the number of species (excluding the terminating entry).
+*/
+int Fofem6Species::getSpeciesCount( void )
+{
+	buildIndex();
+	return m_count;
+}
+
+//------------------------------------------------------------------------------
+/*!	\brief Returns the compact species record given its Species[] index.
+	\param speciesIndex The species index as returned by getFofem6SpeciesIndex().
+	\return Returns a pointer to the species record on success, NULL on failure.
+*/
+const Fofem6Species::SpeciesRecord* Fofem6Species::getSpeciesRecordAt(
+	int speciesIndex )
+{
+	buildIndex();
+	return ( speciesIndex < 0 || speciesIndex >= m_count )
+		? 0 : &m_record[speciesIndex];
 }
@@ -11,6 +11,12 @@
 *	mortality equations.
 *
 *	Note that all the species codes changed from FOFEM v5 to v6.
+*
+*	Species codes are looked up by binary search of two sorted code indexes
+*	(one each for the FOFEM v5 and v6 codes) that are built on first use,
+*	and resolve to a compact SpeciesRecord.  Callers that evaluate the same
+*	species repeatedly should keep the species index or SpeciesRecord
+*	rather than the code.
 */
 class Fofem6Species
 {
@@ -26,6 +32,25 @@ public:
 	static int getFofem6MortalityEquationIndex( const char* fofem6SpeciesCode );
 	static int getFofem6SpeciesIndex( const char* fofem6SpeciesCode );
 
+	// Methods for accessing FOFEM species info by their Species[] index
+	static int getBarkEquationIndexAt( int speciesIndex );
+	static int getMortalityEquationIndexAt( int speciesIndex );
+	static int getSpeciesCount( void );
+
+	/*!	\struct SpeciesRecord
+	*	\brief Compact resolved species record.
+	*/
+	typedef struct _speciesRecord
+	{
+		int species;		// Index into Species[]
+		int mortEq;			// Index to mortality equation
+		int barkEq;			// Index to single bark thickness equation
+	} SpeciesRecord;
+
+	static const SpeciesRecord* getFofem5SpeciesRecord( const char* fofem5SpeciesCode );
+	static const SpeciesRecord* getFofem6SpeciesRecord( const char* fofem6SpeciesCode );
+	static const SpeciesRecord* getSpeciesRecordAt( int speciesIndex );
+
 	typedef struct _species
 	{
 		char *fofem6;		// FOFEM 6 genus-species abbreviation
@@ -38,7 +63,14 @@ public:
 	} SpeciesStruct;
 
 private:
+	static void buildIndex( void );
+	static int  findCode( const int* index, bool fofem5, const char* code );
+
 	static SpeciesStruct m_species[];
+	static SpeciesRecord* m_record;		// Compact records in Species[] order
+	static int* m_fofem5Index;			// Species[] indices sorted by FOFEM 5 code
+	static int* m_fofem6Index;			// Species[] indices sorted by FOFEM 6 code
+	static int  m_count;				// Number of Species[] entries
 };
 
 #endif	// BEHAVEPLUS6_ALGORITHMS_FOFEM6SPECIES
\ No newline at end of file
@@ -1,10 +1,12 @@
 #include "Bp6CrownFire.h"
+#include "Bp6Dual.h"
 #include "Bp6FuelModel10.h"
 #include <math.h>
 
 //------------------------------------------------------------------------------
-Bp6CrownFire::Bp6CrownFire() :
-	Bp6SurfaceFire(),
+template <class Real>
+Bp6CrownFireT<Real>::Bp6CrownFireT() :
+	Bp6SurfaceFireT<Real>(),
 	// Canopy inputs
 	m_canopyBaseHeight( 0. ),
 	m_canopyBulkDensity( 0. ),
@@ -72,153 +74,175 @@ Bp6CrownFire::Bp6CrownFire() :
 }
 
 //------------------------------------------------------------------------------
-Bp6CrownFire::~Bp6CrownFire()
+template <class Real>
+Bp6CrownFireT<Real>::~Bp6CrownFireT()
 {}
 
 //------------------------------------------------------------------------------
 /*!	\brief Returns the fire area (ft2) of a potential active crown fire.
  */
-double Bp6CrownFire::getActiveCrownFireArea() const
+template <class Real>
+Real Bp6CrownFireT<Real>::getActiveCrownFireArea() const
 {
 	return m_activeCrownFireArea;
 }
 //------------------------------------------------------------------------------
 /*!	\brief Returns the flame length (ft) of a potential active crown fire.
  */
-double Bp6CrownFire::getActiveCrownFireFlame() const
+template <class Real>
+Real Bp6CrownFireT<Real>::getActiveCrownFireFlame() const
 {
 	return m_activeCrownFireFlame;
 }
 //------------------------------------------------------------------------------
 /*!	\brief Returns the fireline intensity (btu/ft/s) of a potential active crown fire.
  */
-double Bp6CrownFire::getActiveCrownFireFli() const
+template <class Real>
+Real Bp6CrownFireT<Real>::getActiveCrownFireFli() const
 {
 	return m_activeCrownFireFli;
 }
 //------------------------------------------------------------------------------
 /*!	\brief Returns the heat per unit area (btu/ft2) of a potential active crown fire.
  */
-double Bp6CrownFire::getActiveCrownFireHpua() const
+template <class Real>
+Real Bp6CrownFireT<Real>::getActiveCrownFireHpua() const
 {
 	return m_activeCrownFireHpua;
 }
 //------------------------------------------------------------------------------
 /*!	\brief Returns the forward spread distance (ft) of a potential active crown fire.
  */
-double Bp6CrownFire::getActiveCrownFireLength() const
+template <class Real>
+Real Bp6CrownFireT<Real>::getActiveCrownFireLength() const
 {
 	return m_activeCrownFireLength;
 }
 //------------------------------------------------------------------------------
 /*!	\brief Returns the fire perimeter (ft) of a potential active crown fire.
  */
-double Bp6CrownFire::getActiveCrownFirePerimeter() const
+template <class Real>
+Real Bp6CrownFireT<Real>::getActiveCrownFirePerimeter() const
 {
 	return m_activeCrownFirePerimeter;
 }
 //------------------------------------------------------------------------------
 /*!	\brief Returns Rothermel's active crowning ratio (dl).
  */
-double Bp6CrownFire::getActiveCrownFireRatio() const
+template <class Real>
+Real Bp6CrownFireT<Real>::getActiveCrownFireRatio() const
 {
 	return m_activeCrownFireRatio;
 }
 //------------------------------------------------------------------------------
 /*!	\brief Returns the spread rate (ft/min) of a potential active crown fire.
  */
-double Bp6CrownFire::getActiveCrownFireRos() const
+template <class Real>
+Real Bp6CrownFireT<Real>::getActiveCrownFireRos() const
 {
 	return m_activeCrownFireRos;
 }
 //------------------------------------------------------------------------------
 /*!	\brief Returnsd the fire width (ft) of a potential active crown fire.
  */
-double Bp6CrownFire::getActiveCrownFireWidth() const
+template <class Real>
+Real Bp6CrownFireT<Real>::getActiveCrownFireWidth() const
 {
 	return m_activeCrownFireWidth;
 }
 //------------------------------------------------------------------------------
 /*!	\brief Returns the crown canopy total fuel load (lb/ft2).
  */
-double Bp6CrownFire::getCanopyFuelLoad() const
+template <class Real>
+Real Bp6CrownFireT<Real>::getCanopyFuelLoad() const
 {
 	return m_canopyFuelLoad;
 }
 //------------------------------------------------------------------------------
 /*!	\brief returns the crown canopy heat per unit area (btu/lb).
  */
-double Bp6CrownFire::getCanopyHpua() const
+template <class Real>
+Real Bp6CrownFireT<Real>::getCanopyHpua() const
 {
 	return m_canopyHpua;
 }
 //------------------------------------------------------------------------------
 /*!	\brief Returns the crown fire spread rate required to sustain active crowning (ft/min).
  */
-double Bp6CrownFire::getCriticalCrownFireRos() const
+template <class Real>
+Real Bp6CrownFireT<Real>::getCriticalCrownFireRos() const
 {
 	return m_criticalCrownFireRos;
 }
 //------------------------------------------------------------------------------
 /*!	\brief Returns the critical surface fire flame length to initiate crowning (ft).
  */
-double Bp6CrownFire::getCriticalSurfaceFireFlame() const
+template <class Real>
+Real Bp6CrownFireT<Real>::getCriticalSurfaceFireFlame() const
 {
 	return m_criticalSurfaceFireFlame;
 }
 //------------------------------------------------------------------------------
 /*!	\brief Returns the critical surface fireline intensity to initiate crowning (btu/ft/s).
  */
-double Bp6CrownFire::getCriticalSurfaceFireFli() const
+template <class Real>
+Real Bp6CrownFireT<Real>::getCriticalSurfaceFireFli() const
 {
 	return m_criticalSurfaceFireFli;
 }
 //------------------------------------------------------------------------------
 /*!	\brief Returns the critical surface fire spread rate to initiate crown fire (ft/min).
  */
-double Bp6CrownFire::getCriticalSurfaceFireRos() const
+template <class Real>
+Real Bp6CrownFireT<Real>::getCriticalSurfaceFireRos() const
 {
 	return m_criticalSurfaceFireRos;
 }
 //------------------------------------------------------------------------------
 /*!	\brief Returns the canopy fraction burned by the crown fire (ratio).
 */
-double Bp6CrownFire::getCrownFractionBurned() const
+template <class Real>
+Real Bp6CrownFireT<Real>::getCrownFractionBurned() const
 {
 	return m_crownFractionBurned;
 }
 //------------------------------------------------------------------------------
 /*!	\brief Returns the crown fire ellipse length-to-width ratio (dl).
  */
-double Bp6CrownFire::getCrownFireLwRatio() const
+template <class Real>
+Real Bp6CrownFireT<Real>::getCrownFireLwRatio() const
 {
 	return m_crownFireLwRatio;
 }
 //------------------------------------------------------------------------------
 /*!	\brief Returns the final flame length (ft) based upon the final fire type.
  */
-double Bp6CrownFire::getFinalFireFlame() const
+template <class Real>
+Real Bp6CrownFireT<Real>::getFinalFireFlame() const
 {
 	return m_finalFireFlame;
 }
 //------------------------------------------------------------------------------
 /*!	\brief Returns the final fireline intensity (btu/ft/s) based upon the final fire type.
  */
-double Bp6CrownFire::getFinalFireFli() const
+template <class Real>
+Real Bp6CrownFireT<Real>::getFinalFireFli() const
 {
 	return m_finalFireFli;
 }
 //------------------------------------------------------------------------------
 /*!	\brief Returns the final heat per unit area (btu/ft2) based upon the final fire type.
  */
-double Bp6CrownFire::getFinalFireHpua() const
+template <class Real>
+Real Bp6CrownFireT<Real>::getFinalFireHpua() const
 {
 	return m_finalFireHpua;
 }
 //------------------------------------------------------------------------------
 /*!	\brief Returns the final spread rate (ft/min) based upon the final fire type.
  */
-double Bp6CrownFire::getFinalFireRos() const
+template <class Real>
+Real Bp6CrownFireT<Real>::getFinalFireRos() const
 {
 	return m_finalFireRos;
 }
@@ -229,112 +253,128 @@ double Bp6CrownFire::getFinalFireRos() const
  *	\retval 2 if the final fire type is a surface fire that would be an active crown fire if it transitions
  *	\retval 3 if the final fire type is an active crown fire
  */
-int Bp6CrownFire::getFinalFireType() const
+template <class Real>
+int Bp6CrownFireT<Real>::getFinalFireType() const
 {
 	return m_finalFireType;
 }
 //------------------------------------------------------------------------------
 /*!	\brief Returns the wind speed at 20 ft (ft/min) required to sustain a fully active crown fire.
  */
-double Bp6CrownFire::getFullCrownFireU20() const
+template <class Real>
+Real Bp6CrownFireT<Real>::getFullCrownFireU20() const
 {
 	return m_fullCrownFireU20;
 }
 //------------------------------------------------------------------------------
 /*!	\brief Returns the surface fire spread rate (ft/min) required to sustain a fully active crown fire.
  */
-double Bp6CrownFire::getFullCrownFireRos() const
+template <class Real>
+Real Bp6CrownFireT<Real>::getFullCrownFireRos() const
 {
 	return m_fullCrownFireRos;
 }
 //------------------------------------------------------------------------------
 /*!	\brief returns the fire area (ft2) of a potential passive (torching) crown fire.
  */
-double Bp6CrownFire::getPassiveCrownFireArea() const
+template <class Real>
+Real Bp6CrownFireT<Real>::getPassiveCrownFireArea() const
 {
 	return m_passiveCrownFireArea;
 }
 //------------------------------------------------------------------------------
 /*!	\brief Returns the flame length (ft) of a potential passive/torching crown fire.
  */
-double Bp6CrownFire::getPassiveCrownFireFlame() const
+template <class Real>
+Real Bp6CrownFireT<Real>::getPassiveCrownFireFlame() const
 {
 	return m_passiveCrownFireFlame;
 }
 //------------------------------------------------------------------------------
 /*!	\brief Returns the fireline intensity (btu/ft/s) of a potential passive/torching crown fire.
  */
-double Bp6CrownFire::getPassiveCrownFireFli() const
+template <class Real>
+Real Bp6CrownFireT<Real>::getPassiveCrownFireFli() const
 {
 	return m_passiveCrownFireFli;
 }
 //------------------------------------------------------------------------------
 /*!	\brief Returns the heat per unit area (btu/ft2) of a potential passive/torching crown fire.
  */
-double Bp6CrownFire::getPassiveCrownFireHpua() const
+template <class Real>
+Real Bp6CrownFireT<Real>::getPassiveCrownFireHpua() const
 {
 	return m_passiveCrownFireHpua;
 }
 //------------------------------------------------------------------------------
 /*!	\brief Returns the forward spread distance (ft) of a potential passive (torching) crown fire.
  */
-double Bp6CrownFire::getPassiveCrownFireLength() const
+template <class Real>
+Real Bp6CrownFireT<Real>::getPassiveCrownFireLength() const
 {
 	return m_passiveCrownFireLength;
 }
 //------------------------------------------------------------------------------
 /*!	\brief Returns the fire perimeter (ft) of a potential passive (torching) crown fire.
  */
-double Bp6CrownFire::getPassiveCrownFirePerimeter() const
+template <class Real>
+Real Bp6CrownFireT<Real>::getPassiveCrownFirePerimeter() const
 {
 	return m_passiveCrownFirePerimeter;
 }
 //------------------------------------------------------------------------------
 /*!	\brief Returns the spread rate (ft/min) of a potential passive (torching) crown fire.
  */
-double Bp6CrownFire::getPassiveCrownFireRos() const
+template <class Real>
+Real Bp6CrownFireT<Real>::getPassiveCrownFireRos() const
 {
 	return m_passiveCrownFireRos;
 }
 //------------------------------------------------------------------------------
 /*!	\brief Returns the fire width (ft) of a potential passive (torching) crown fire.
  */
-double Bp6CrownFire::getPassiveCrownFireWidth() const
+template <class Real>
+Real Bp6CrownFireT<Real>::getPassiveCrownFireWidth() const
 {
 	return m_passiveCrownFireWidth;
 }
 //------------------------------------------------------------------------------
 /*!	\brief Returns Rothermel's measure of the power of the fire (ft-lb/ft2/s).
  */
-double Bp6CrownFire::getPowerFire() const
+template <class Real>
+Real Bp6CrownFireT<Real>::getPowerFire() const
 {
 	return m_powerFire;
 }
 //------------------------------------------------------------------------------
 /*!	\brief Returns Rothermel's measure of the power of the wind (ft-lb/ft2/s).
  */
-double Bp6CrownFire::getPowerWind() const
+template <class Real>
+Real Bp6CrownFireT<Real>::getPowerWind() const
 {
 	return m_powerWind;
 }
 //------------------------------------------------------------------------------
 /*!	\brief Returns the ratio of the power-of-the-fire to the power-of-the-wind (dl).
  */
-double Bp6CrownFire::getPowerRatio() const
+template <class Real>
+Real Bp6CrownFireT<Real>::getPowerRatio() const
 {
 	return m_powerRatio;
 }
 //------------------------------------------------------------------------------
 /*!	\brief Returns the ratio of the power-of-the-fire to the power-of-the-wind (dl).
  */
-Bp6SurfaceFire* Bp6CrownFire::getSurfaceFire() const
+template <class Real>
+Bp6SurfaceFireT<Real>* Bp6CrownFireT<Real>::getSurfaceFire() const
 {
 	return m_surfaceFire;
 }
 //------------------------------------------------------------------------------
 /*!	\brief Returns the ratio of actual-to-critical surface fireline intensity (dl).
  */
-double Bp6CrownFire::getTransRatio() const
+template <class Real>
+Real Bp6CrownFireT<Real>::getTransRatio() const
 {
 	return m_transRatio;
 }
@@ -342,25 +382,27 @@ double Bp6CrownFire::getTransRatio() const
 //------------------------------------------------------------------------------
 /*!	\brief Initializes the base Bp6SurfaceFire instance with Fuel Model 10.
  */
-void Bp6CrownFire::init()
+template <class Real>
+void Bp6CrownFireT<Real>::init()
 {
 	// Crown fire model always uses standard fire behavior fuel model 10:
-    static double depth     = 1.0;
-    static double deadFuelMext = 0.25;
+    static Real depth     = 1.0;
+    static Real deadFuelMext = 0.25;
     static int    particles = 4;
     static int    life[4] = {     0,     0,     0,     2 };
-    static double load[4] = { 0.138, 0.092, 0.230, 0.092 };
-    static double savr[4] = { 2000.,  109.,   30., 1500. };
-    static double heat[4] = { 8000., 8000., 8000., 8000. };
-    static double dens[4] = {  32.0,  32.0,  32.0,  32.0 };
-    static double stot[4] = { .0555, .0555, .0555, .0555 };
-    static double seff[4] = { .0100, .0100, .0100, .0100 };
-	setFuel( depth, deadFuelMext, particles, life, load, savr, heat, dens, stot, seff );
+    static Real load[4] = { 0.138, 0.092, 0.230, 0.092 };
+    static Real savr[4] = { 2000.,  109.,   30., 1500. };
+    static Real heat[4] = { 8000., 8000., 8000., 8000. };
+    static Real dens[4] = {  32.0,  32.0,  32.0,  32.0 };
+    static Real stot[4] = { .0555, .0555, .0555, .0555 };
+    static Real seff[4] = { .0100, .0100, .0100, .0100 };
+	this->setFuel( depth, deadFuelMext, particles, life, load, savr, heat, dens, stot, seff );
 }
 //------------------------------------------------------------------------------
 /*!	\brief Returns TRUE if the final fire type is an active crown fire.
 */
-bool Bp6CrownFire::isActiveCrownFire() const
+template <class Real>
+bool Bp6CrownFireT<Real>::isActiveCrownFire() const
 {
 	return m_isActiveCrownFire;
 }
@@ -368,35 +410,40 @@ bool Bp6CrownFire::isActiveCrownFire() const
 /*!	\brief Returns TRUE if the final fire type is either a passive (torching)
  *	or an active crown fire (i.e., if it is NOT a surface fire).
 */
-bool Bp6CrownFire::isCrownFire() const
+template <class Real>
+bool Bp6CrownFireT<Real>::isCrownFire() const
 {
 	return m_isCrownFire;
 }
 //------------------------------------------------------------------------------
 /*!	\brief Returns TRUE if the final fire type is a passive (torching) fire.
 */
-bool Bp6CrownFire::isPassiveCrownFire() const
+template <class Real>
+bool Bp6CrownFireT<Real>::isPassiveCrownFire() const
 {
 	return m_isPassiveCrownFire;
 }
 //------------------------------------------------------------------------------
 /*!	\brief Returns TRUE if the power of the fire exceeds the power of the wind.
 */
-bool Bp6CrownFire::isPlumeDominated() const
+template <class Real>
+bool Bp6CrownFireT<Real>::isPlumeDominated() const
 {
 	return m_isPlumeDominated;
 }
 //------------------------------------------------------------------------------
 /*!	\brief Returns TRUE if the final fire type if a surface fire.
 */
-bool Bp6CrownFire::isSurfaceFire() const
+template <class Real>
+bool Bp6CrownFireT<Real>::isSurfaceFire() const
 {
 	return m_isSurfaceFire;
 }
 //------------------------------------------------------------------------------
 /*!	\brief Returns TRUE if the power of the wind exceeds the power of the fire.
 */
-bool Bp6CrownFire::isWindDriven() const
+template <class Real>
+bool Bp6CrownFireT<Real>::isWindDriven() const
 {
 	return m_isWindDriven;
 }
@@ -404,7 +451,8 @@ bool Bp6CrownFire::isWindDriven() const
 //------------------------------------------------------------------------------
 /*!	\brief Resets the canopy input member variables to their values.
  */
-void Bp6CrownFire::resetCanopyInput()
+template <class Real>
+void Bp6CrownFireT<Real>::resetCanopyInput()
 {
 	m_canopyBaseHeight	= 0.;
 	m_canopyBulkDensity = 0.;
@@ -417,14 +465,15 @@ void Bp6CrownFire::resetCanopyInput()
 //------------------------------------------------------------------------------
 /*!	\brief Resets all canopy output member variables tp default values.
 */
-void Bp6CrownFire::resetCanopyOutput()
+template <class Real>
+void Bp6CrownFireT<Real>::resetCanopyOutput()
 {
 	m_activeCrownFireRatio		= 0.;
 	m_canopyFuelLoad			= 0.;
 	m_canopyHpua				= 0.;
-	m_criticalCrownFireRos		= m_infinity;
-	m_criticalSurfaceFireFlame	= m_infinity;
-	m_criticalSurfaceFireFli	= m_infinity;
+	m_criticalCrownFireRos		= this->m_infinity;
+	m_criticalSurfaceFireFlame	= this->m_infinity;
+	m_criticalSurfaceFireFli	= this->m_infinity;
 	m_crownFireLwRatio			= 1.;
 	m_powerWind					= 0.;
 }
@@ -432,7 +481,8 @@ void Bp6CrownFire::resetCanopyOutput()
 //------------------------------------------------------------------------------
 /*!	\brief Hook to derived class extensions called by the base resetSiteOutput() method.
 */
-void Bp6CrownFire::resetSiteOutputExtension()
+template <class Real>
+void Bp6CrownFireT<Real>::resetSiteOutputExtension()
 {
 	m_activeCrownFireRos = 0.;
 }
@@ -440,7 +490,8 @@ void Bp6CrownFire::resetSiteOutputExtension()
 //------------------------------------------------------------------------------
 /*!	\brief Resets the surface fire input member variables to their default values.
  */
-void Bp6CrownFire::resetSurfaceFireInput()
+template <class Real>
+void Bp6CrownFireT<Real>::resetSurfaceFireInput()
 {
 	m_surfaceFire    = 0;
 	m_surfaceFireFli = 0;
@@ -451,13 +502,14 @@ void Bp6CrownFire::resetSurfaceFireInput()
 //------------------------------------------------------------------------------
 /*!	\brief Resets the surface fire output member variables to their default values.
  */
-void Bp6CrownFire::resetSurfaceFireOutput()
+template <class Real>
+void Bp6CrownFireT<Real>::resetSurfaceFireOutput()
 {
 	m_activeCrownFireFlame	= 0.;
 	m_activeCrownFireFli	= 0.;
 	m_activeCrownFireHpua	= 0.;
 
-	m_criticalSurfaceFireRos= m_infinity;
+	m_criticalSurfaceFireRos= this->m_infinity;
 	m_crownFractionBurned	= 0.;
 
 	m_finalFireFlame		= 0.;
@@ -466,8 +518,8 @@ void Bp6CrownFire::resetSurfaceFireOutput()
 	m_finalFireRos			= 0.;
 	m_finalFireType			= 0;	// 0=surface, 1=passive, 2=conditional crown, 3=crown
 
-	m_fullCrownFireU20		= m_infinity;
-	m_fullCrownFireRos		= m_infinity;
+	m_fullCrownFireU20		= this->m_infinity;
+	m_fullCrownFireRos		= this->m_infinity;
 
 	m_isActiveCrownFire		= false;
 	m_isCrownFire			= false;
@@ -486,7 +538,8 @@ void Bp6CrownFire::resetSurfaceFireOutput()
 //------------------------------------------------------------------------------
 /*!	\brief Hook to derived class extensions called by the base resetTimeOutput() method.
 */
-void Bp6CrownFire::resetTimeOutputExtension()
+template <class Real>
+void Bp6CrownFireT<Real>::resetTimeOutputExtension()
 {
 	m_activeCrownFireArea		= 0.;
 	m_activeCrownFireLength		= 0.;
@@ -503,12 +556,13 @@ void Bp6CrownFire::resetTimeOutputExtension()
 /*!	\brief Sets all the canopy input variables and then updates all the canopy
  *	dependent output variables.
  */
-void Bp6CrownFire::setCanopy(
-	double canopyHeight,
-	double canopyBaseHeight,
-	double canopyBulkDensity,
-	double canopyFoliarMoisture,
-	double canopyHeat )
+template <class Real>
+void Bp6CrownFireT<Real>::setCanopy(
+	Real canopyHeight,
+	Real canopyBaseHeight,
+	Real canopyBulkDensity,
+	Real canopyFoliarMoisture,
+	Real canopyHeat )
 {
 	resetCanopyInput();
 	resetCanopyOutput();
@@ -523,11 +577,12 @@ void Bp6CrownFire::setCanopy(
 /*!	\brief Reimplemented to prevent use from within Bp6CrownFire. Client should
  *	use setWind() instead.
  */
-void Bp6CrownFire::setSite(
-        double slopeFraction,			// terrain slope (rise/reach)
-		double aspect,					// degrees clockwise from north
-        double midflameWindSpeed,		// mid-flame wind speed (ft/min)
-        double windDirFromUpslope,		// wind heading direction (degrees clockwise from upslope)
+template <class Real>
+void Bp6CrownFireT<Real>::setSite(
+        Real slopeFraction,			// terrain slope (rise/reach)
+		Real aspect,					// degrees clockwise from north
+        Real midflameWindSpeed,		// mid-flame wind speed (ft/min)
+        Real windDirFromUpslope,		// wind heading direction (degrees clockwise from upslope)
 		bool   applyWindSpeedLimit )	// if TRUE, apply Rothermel's upper wind speed limit
 {
 	setWindSpeedAt20FtFpm( midflameWindSpeed / 0.4 );
@@ -537,7 +592,8 @@ void Bp6CrownFire::setSite(
 /*!	\brief Sets all the surface fire input variables and then updates all the
  *	surface fire dependent output variables.
  */
-void Bp6CrownFire::setSurfaceFire( Bp6SurfaceFire *surfaceFire )
+template <class Real>
+void Bp6CrownFireT<Real>::setSurfaceFire( Bp6SurfaceFireT<Real> *surfaceFire )
 {
 	resetSurfaceFireInput();
 	resetSurfaceFireOutput();
@@ -552,7 +608,8 @@ void Bp6CrownFire::setSurfaceFire( Bp6SurfaceFire *surfaceFire )
 /*!	\brief Sets all the surface fire input variables and then updates all the
  *	surface fire dependent output variables.
  */
-void Bp6CrownFire::setSurfaceFire( double ros, double fli, double hpua )
+template <class Real>
+void Bp6CrownFireT<Real>::setSurfaceFire( Real ros, Real fli, Real hpua )
 {
 	m_surfaceFire		= 0;
 	m_surfaceFireFli	= fli;
@@ -568,23 +625,25 @@ void Bp6CrownFire::setSurfaceFire( double ros, double fli, double hpua )
  *	This overrides the Bp6SurfaceFire::setSite(), since the crown fire models
  *	treats many of the arguments as constants.
  */
-void Bp6CrownFire::setWindSpeedAt20FtFpm(
-        double windSpeedAt20Ft )		// mid-flame wind speed (ft/min)
+template <class Real>
+void Bp6CrownFireT<Real>::setWindSpeedAt20FtFpm(
+        Real windSpeedAt20Ft )		// mid-flame wind speed (ft/min)
 {
-	resetSiteOutput();
-	m_slopeFraction			= 0.0;
-	m_aspect				= 180.;
+	this->resetSiteOutput();
+	this->m_slopeFraction			= 0.0;
+	this->m_aspect				= 180.;
 	m_windSpeedAt20ft		= windSpeedAt20Ft;
-	m_midflameWindSpeed		= 0.4 * windSpeedAt20Ft;
-	m_windDirFromUpslope	= 0.;
-	m_applyWindSpeedLimit	= true;
-	updateSite();
+	this->m_midflameWindSpeed		= 0.4 * windSpeedAt20Ft;
+	this->m_windDirFromUpslope	= 0.;
+	this->m_applyWindSpeedLimit	= true;
+	this->updateSite();
 }
 
 //------------------------------------------------------------------------------
 /*!	\brief Updates all canopy-dependent output member data variables.
 */
-void Bp6CrownFire::updateCanopy()
+template <class Real>
+void Bp6CrownFireT<Real>::updateCanopy()
 {
 	// Crown fire length-to-width ratio (dl)
     m_crownFireLwRatio = calcCrownFireLengthToWidth( m_windSpeedAt20ft );
@@ -593,13 +652,13 @@ void Bp6CrownFire::updateCanopy()
     m_canopyFuelLoad = calcCrownFuelLoad( m_canopyBulkDensity, m_canopyHeight, m_canopyBaseHeight );
 
 	// Canopy heat per unit area (Btu/ft2)
-	m_canopyHpua = ( m_activeCrownFireRos > m_smidgen ) ? m_canopyFuelLoad * m_canopyHeat : 0.;
+	m_canopyHpua = ( m_activeCrownFireRos > this->m_smidgen ) ? m_canopyFuelLoad * m_canopyHeat : 0.;
 
 	// Rothermel's critical surface fire intensity (I'initiation) (btu/ft/s)
 	m_criticalSurfaceFireFli = calcCriticalSurfaceFireIntensity( m_canopyFoliarMois, m_canopyBaseHeight );
 
 	// Rothermel's critical surface fire flame length (ft) using Byram
-    m_criticalSurfaceFireFlame = calcFlameLengthByram( m_criticalSurfaceFireFli );
+    m_criticalSurfaceFireFlame = this->calcFlameLengthByram( m_criticalSurfaceFireFli );
 
 	// Rothermel's critical crown fire spread rate (R'active) (ft/min)
 	m_criticalCrownFireRos = calcCriticalCrownFireSpreadRate( m_canopyBulkDensity );
@@ -615,16 +674,18 @@ void Bp6CrownFire::updateCanopy()
 /*!	\brief Called by the base updateSite() method to perform additional
  *	member variable updates for this derived class.
  */
-void Bp6CrownFire::updateSiteExtension()
+template <class Real>
+void Bp6CrownFireT<Real>::updateSiteExtension()
 {
 	// Rothermel's crown fire ros (no foliar moisture effect)
-	m_activeCrownFireRos = 3.34 * m_rosHead;
+	m_activeCrownFireRos = 3.34 * this->m_rosHead;
 }
 
 //------------------------------------------------------------------------------
 /*!	\brief Updates all surface fire-dependent output member data variables.
 */
-void Bp6CrownFire::updateSurfaceFire()
+template <class Real>
+void Bp6CrownFireT<Real>::updateSurfaceFire()
 {
 	// Active crown fire heat per unit area (combines surface and canopy heat) (Btu/ft2)
 	m_activeCrownFireHpua = m_canopyHpua + m_surfaceFireHpua;
@@ -633,7 +694,7 @@ void Bp6CrownFire::updateSurfaceFire()
 	m_activeCrownFireFli = ( m_activeCrownFireRos / 60. ) * m_activeCrownFireHpua;
 
 	// Active crown fire flame length (ft) - uses Thomas (1963) instead of Byram (1959)
-	m_activeCrownFireFlame = calcFlameLengthThomas( m_activeCrownFireFli );
+	m_activeCrownFireFlame = this->calcFlameLengthThomas( m_activeCrownFireFli );
 
 	// Rothermel/s crown fire transition ratio
 	m_transRatio = calcTransitionRatio( m_surfaceFireFli, m_criticalSurfaceFireFli );
@@ -659,7 +720,7 @@ void Bp6CrownFire::updateSurfaceFire()
 
 	// Scott & Reinhardt crown fraction burned
 	// This can only be determined if a Bp6SurfaceFire has been provided
-	if ( ! m_surfaceFire || m_canopyBulkDensity < m_smidgen )
+	if ( ! m_surfaceFire || m_canopyBulkDensity < this->m_smidgen )
 	{
 		m_fullCrownFireU20 = 0.;
 		m_fullCrownFireRos = 0.;
@@ -671,7 +732,7 @@ void Bp6CrownFire::updateSurfaceFire()
 	else
 	{
 		m_fullCrownFireU20 =
-			calcCrowningIndex( m_canopyBulkDensity, m_totalRxInt, m_rbQig, m_slopeFactor );
+			calcCrowningIndex( m_canopyBulkDensity, this->m_totalRxInt, this->m_rbQig, this->m_slopeFactor );
 		m_fullCrownFireRos =
 			m_surfaceFire->getRsa( 0.4 * m_fullCrownFireU20 );
 		m_crownFractionBurned =
@@ -684,7 +745,7 @@ void Bp6CrownFire::updateSurfaceFire()
 	}
 
 	// Scott & Reinhardt torching (passive) flame length
-	m_passiveCrownFireFlame = calcFlameLengthThomas( m_passiveCrownFireFli );
+	m_passiveCrownFireFlame = this->calcFlameLengthThomas( m_passiveCrownFireFli );
 
 	// Determine final fire behavior
 	if ( m_isSurfaceFire )
@@ -692,7 +753,7 @@ void Bp6CrownFire::updateSurfaceFire()
 		m_finalFireRos   = m_surfaceFireRos;
 		m_finalFireHpua  = m_surfaceFireHpua;
 		m_finalFireFli   = m_surfaceFireFli;
-		m_finalFireFlame = calcFlameLengthByram( m_surfaceFireFli );
+		m_finalFireFlame = this->calcFlameLengthByram( m_surfaceFireFli );
 	}
 	else if ( m_isPassiveCrownFire )
 	{
@@ -713,32 +774,33 @@ void Bp6CrownFire::updateSurfaceFire()
 //------------------------------------------------------------------------------
 /*!	\brief Updates all time-dependent output member variables.
  */
-void Bp6CrownFire::updateTimeExtension()
+template <class Real>
+void Bp6CrownFireT<Real>::updateTimeExtension()
 {
 	// Rothermel (1991) ignores backing spread rate and distance
-	m_activeCrownFireLength = m_elapsed * m_activeCrownFireRos;
-	m_passiveCrownFireLength = m_elapsed * m_passiveCrownFireRos;
+	m_activeCrownFireLength = this->m_elapsed * m_activeCrownFireRos;
+	m_passiveCrownFireLength = this->m_elapsed * m_passiveCrownFireRos;
 
 	m_activeCrownFireWidth  = m_activeCrownFireLength / m_crownFireLwRatio;
 	m_passiveCrownFireWidth = m_passiveCrownFireLength / m_crownFireLwRatio;
 
 	// Calculate the crown fire area from Rothermel (1991) equation 11 on page 16
 	// (which ignores backing distance).
-    m_activeCrownFireArea = calcEllipseArea( m_activeCrownFireLength, m_crownFireLwRatio );
-    m_passiveCrownFireArea = calcEllipseArea( m_passiveCrownFireLength, m_crownFireLwRatio );
+    m_activeCrownFireArea = this->calcEllipseArea( m_activeCrownFireLength, m_crownFireLwRatio );
+    m_passiveCrownFireArea = this->calcEllipseArea( m_passiveCrownFireLength, m_crownFireLwRatio );
 
 	// Estimates crown fire perimeter from forward spread distance and
 	// as per Rothermel (1991) equation 13 on page 16.
     m_activeCrownFirePerimeter =
-		calcEllipsePerimeterRothermel( m_activeCrownFireLength, m_crownFireLwRatio );
+		this->calcEllipsePerimeterRothermel( m_activeCrownFireLength, m_crownFireLwRatio );
     m_passiveCrownFirePerimeter =
-		calcEllipsePerimeterRothermel( m_passiveCrownFireLength, m_crownFireLwRatio );
+		this->calcEllipsePerimeterRothermel( m_passiveCrownFireLength, m_crownFireLwRatio );
 
 	// Method used for surface fires:	
     m_activeCrownFirePerimeter =
-		calcEllipsePerimeter( m_activeCrownFireLength, m_activeCrownFireWidth );
+		this->calcEllipsePerimeter( m_activeCrownFireLength, m_activeCrownFireWidth );
     m_passiveCrownFirePerimeter =
-		calcEllipsePerimeter( m_passiveCrownFireLength, m_passiveCrownFireWidth );
+		this->calcEllipsePerimeter( m_passiveCrownFireLength, m_passiveCrownFireWidth );
 }
 
 //------------------------------------------------------------------------------
@@ -751,10 +813,11 @@ void Bp6CrownFire::updateTimeExtension()
  *	\param canopyBulkDensity Crown canopy bulk density (lb/ft3).
  *	\return Critical crown fire spread rate (ft/min).
  */
-double Bp6CrownFire::calcCriticalCrownFireSpreadRate( double canopyBulkDensity ) const
+template <class Real>
+Real Bp6CrownFireT<Real>::calcCriticalCrownFireSpreadRate( Real canopyBulkDensity ) const
 {
-    double cbd = 16.0185 * canopyBulkDensity;			// convert to Kg/m3
-    double ros = ( cbd <= 0. ) ? 0. : ( 3.0 / cbd );	// m/min
+    Real cbd = 16.0185 * canopyBulkDensity;			// convert to Kg/m3
+    Real ros = ( cbd <= 0. ) ? 0. : ( 3.0 / cbd );	// m/min
     return 3.28084 * ros;								// return as ft/min
 }
 
@@ -766,15 +829,16 @@ double Bp6CrownFire::calcCriticalCrownFireSpreadRate( double canopyBulkDensity )
  *	\return Critical surface fireline intensity (btu/ft/s) required to initiate
  *	a passive or active crown fire.
  */
-double Bp6CrownFire::calcCriticalSurfaceFireIntensity(
-	double foliarMoisture,
-	double canopyBaseHeight ) const
+template <class Real>
+Real Bp6CrownFireT<Real>::calcCriticalSurfaceFireIntensity(
+	Real foliarMoisture,
+	Real canopyBaseHeight ) const
 {
-    double fmc = 100. * foliarMoisture;				// convert to percent
+    Real fmc = 100. * foliarMoisture;				// convert to percent
     fmc = ( fmc < 30.0 ) ? 30. : fmc;				// constrain to lower limit
-    double cbh = 0.3048 * canopyBaseHeight;			// convert to meters
+    Real cbh = 0.3048 * canopyBaseHeight;			// convert to meters
     cbh = ( cbh < 0.1 ) ? 0.1 : cbh;				// contrain to lower limt
-    double csfi = pow( ( 0.010 * cbh * ( 460. + 25.9 * fmc ) ), 1.5 ); // (kW/m)
+    Real csfi = pow( ( 0.010 * cbh * ( 460. + 25.9 * fmc ) ), 1.5 ); // (kW/m)
     csfi *= 0.288672;								// convert to Btu/ft/s
 	return csfi;
 }
@@ -786,12 +850,13 @@ double Bp6CrownFire::calcCriticalSurfaceFireIntensity(
  *  \param surfaceFireHpua Surface fire heat per unit area (Btu/ft2)
  *	\return Critical surface fire spread rate (ft/min)
  */
-double Bp6CrownFire::calcCriticalSurfaceFireSpreadRate(
-		double criticalSurfaceFireIntensity,
-		double surfaceFireHpua ) const
+template <class Real>
+Real Bp6CrownFireT<Real>::calcCriticalSurfaceFireSpreadRate(
+		Real criticalSurfaceFireIntensity,
+		Real surfaceFireHpua ) const
 {
 	// Scott & Reinhardt's critical surface fire spread rate (R'initiation) (ft/min)
-	double ros = ( surfaceFireHpua <= 0. ) ? m_infinity
+	Real ros = ( surfaceFireHpua <= 0. ) ? this->m_infinity
 		: ( 60. * criticalSurfaceFireIntensity ) / surfaceFireHpua;
 	return ros;
 }
@@ -802,11 +867,12 @@ double Bp6CrownFire::calcCriticalSurfaceFireSpreadRate(
  *  \param criticalSpreadRate   Critical crown fire spread rate (ft/min).
  *  \return Crown fire active ratio (dl).
  */
-double Bp6CrownFire::calcCrownFireActiveRatio(
-		double crownSpreadRate,
-        double criticalSpreadRate ) const
+template <class Real>
+Real Bp6CrownFireT<Real>::calcCrownFireActiveRatio(
+		Real crownSpreadRate,
+        Real criticalSpreadRate ) const
 {
-    double ratio = ( criticalSpreadRate < 0. ) ? 0. : ( crownSpreadRate / criticalSpreadRate );
+    Real ratio = ( criticalSpreadRate < 0. ) ? 0. : ( crownSpreadRate / criticalSpreadRate );
 	return ratio;
 }
 
@@ -816,10 +882,11 @@ double Bp6CrownFire::calcCrownFireActiveRatio(
  *  \param windSpeedAt20ft Wind speed at 20-ft (ft/min).
  *  \return Crown fire length-to-width ratio (dl).
  */
-double Bp6CrownFire::calcCrownFireLengthToWidth( double windSpeedAt20Ft ) const
+template <class Real>
+Real Bp6CrownFireT<Real>::calcCrownFireLengthToWidth( Real windSpeedAt20Ft ) const
 {
-	double mph = windSpeedAt20Ft / 88.;		// Wind speed must be in mi/h
-	double lw = 1. + 0.125 * mph;
+	Real mph = windSpeedAt20Ft / 88.;		// Wind speed must be in mi/h
+	Real lw = 1. + 0.125 * mph;
 	return lw;
 }
 
@@ -833,14 +900,15 @@ double Bp6CrownFire::calcCrownFireLengthToWidth( double windSpeedAt20Ft ) const
  *	burned is 1.
  *  \return Crown fration burned (dl).
  */
-double Bp6CrownFire::calcCrownFractionBurned(
-		double surfaceFireRos,
-		double criticalSurfaceFireRos,
-		double crowningSurfaceFireRos ) const
-{
-	double num = surfaceFireRos - criticalSurfaceFireRos;
-	double den = crowningSurfaceFireRos - criticalSurfaceFireRos;
-	double cfb = ( den > m_smidgen ) ? ( num / den ) : 0.;
+template <class Real>
+Real Bp6CrownFireT<Real>::calcCrownFractionBurned(
+		Real surfaceFireRos,
+		Real criticalSurfaceFireRos,
+		Real crowningSurfaceFireRos ) const
+{
+	Real num = surfaceFireRos - criticalSurfaceFireRos;
+	Real den = crowningSurfaceFireRos - criticalSurfaceFireRos;
+	Real cfb = ( den > this->m_smidgen ) ? ( num / den ) : 0.;
 	cfb = ( cfb > 1. ) ? 1. : cfb;
 	cfb = ( cfb < 0. ) ? 0. : cfb;
 	return cfb;
@@ -853,12 +921,13 @@ double Bp6CrownFire::calcCrownFractionBurned(
  *	\param baseHt Canopy base height (ft)
  *  \return Crown canopy fuel load (lb/ft2).
  */
-double Bp6CrownFire::calcCrownFuelLoad(
-		double canopyBulkDensity,
-		double canopyHt,
-		double baseHt ) const
+template <class Real>
+Real Bp6CrownFireT<Real>::calcCrownFuelLoad(
+		Real canopyBulkDensity,
+		Real canopyHt,
+		Real baseHt ) const
 {
-    double load = canopyBulkDensity * ( canopyHt - baseHt );
+    Real load = canopyBulkDensity * ( canopyHt - baseHt );
 	return load;
 }
 
@@ -872,23 +941,24 @@ double Bp6CrownFire::calcCrownFuelLoad(
  *	\param slopeFactor
  *  \return Crowing index, aka O'active (ft/min).
 */
-double Bp6CrownFire::calcCrowningIndex(
-		double canopyBulkDensity,
-		double reactionIntensity,
-		double heatSink,
-		double slopeFactor ) const
-{
-	double rhob = 0.5520;							// Fuel model 10 bulk density (lb/ft3)
-	double cbd = 16.0185 * canopyBulkDensity;		// Convert from lb/ft3 to kg/m3
-	double rxInt = 0.189422 * reactionIntensity;	// Convert from Btu/ft2/min to kW/m2
+template <class Real>
+Real Bp6CrownFireT<Real>::calcCrowningIndex(
+		Real canopyBulkDensity,
+		Real reactionIntensity,
+		Real heatSink,
+		Real slopeFactor ) const
+{
+	Real rhob = 0.5520;							// Fuel model 10 bulk density (lb/ft3)
+	Real cbd = 16.0185 * canopyBulkDensity;		// Convert from lb/ft3 to kg/m3
+	Real rxInt = 0.189422 * reactionIntensity;	// Convert from Btu/ft2/min to kW/m2
 	// Determine the epsilon * Qig product from the fuel bed rbQig heat sink
-	double epsQig = heatSink / rhob;				// Product of eff htg num and heat of preignition
+	Real epsQig = heatSink / rhob;				// Product of eff htg num and heat of preignition
 	epsQig *= 2.32779;								// Convert from Btu/lb to kJ/kg
-	double numerator = ( 164.8 * epsQig / ( rxInt * cbd ) ) - slopeFactor - 1.;
-	double term = numerator / 0.001612;
+	Real numerator = ( 164.8 * epsQig / ( rxInt * cbd ) ) - slopeFactor - 1.;
+	Real term = numerator / 0.001612;
 	// Scott & Reinhardt Eq 20 to derive wind speed at 20-ft that sustains a fully active crown fire
-	double oActive = 0.0457 * pow( term, 0.7 );		// m/min
-	double fpm = 3.2808 * oActive;					// Convert from m/min to ft/min
+	Real oActive = 0.0457 * pow( term, 0.7 );		// m/min
+	Real fpm = 3.2808 * oActive;					// Convert from m/min to ft/min
 	return fpm;
 }
 
@@ -903,9 +973,10 @@ double Bp6CrownFire::calcCrowningIndex(
  *	\retval 2 indicates a surface fire that could conditionally transition to ana ctive crown fire
  *	\retval 3 indicates an active crown fire
  */
-int Bp6CrownFire::calcFireType(
-		double transRatio,
-		double activeRatio ) const
+template <class Real>
+int Bp6CrownFireT<Real>::calcFireType(
+		Real transRatio,
+		Real activeRatio ) const
 {
 	int fireType = 0;			// surface fire
     if ( transRatio < 1.0 )
@@ -934,9 +1005,10 @@ int Bp6CrownFire::calcFireType(
  *  \param crownFirelineintensity Crown fire fireline intensity (Btu/ft/s).
  *  \return Rothermel's power of the fire (ft-lb/ft2/s).
  */
-double Bp6CrownFire::calcPowerOfFire( double crownFirelineIntensity ) const
+template <class Real>
+Real Bp6CrownFireT<Real>::calcPowerOfFire( Real crownFirelineIntensity ) const
 {
-    double powerFire = crownFirelineIntensity / 129.;
+    Real powerFire = crownFirelineIntensity / 129.;
 	return powerFire;
 }
 
@@ -945,13 +1017,14 @@ double Bp6CrownFire::calcPowerOfFire( double crownFirelineIntensity ) const
  *  \param windSpeedAt20ft Wind speed at 20-ft (mi/h).
  *  \return Rothermel's power of the wind (ft-lb/ft2/s).
  */
-double Bp6CrownFire::calcPowerOfWind(
-		double windSpeedAt20ft,
-		double spreadRate ) const
+template <class Real>
+Real Bp6CrownFireT<Real>::calcPowerOfWind(
+		Real windSpeedAt20ft,
+		Real spreadRate ) const
 {
-    double diff = ( windSpeedAt20ft - spreadRate ) / 60.;
+    Real diff = ( windSpeedAt20ft - spreadRate ) / 60.;
     diff = ( diff < 0. ) ? 0. : diff;
-    double powerWind = 0.00106 * diff * diff * diff;
+    Real powerWind = 0.00106 * diff * diff * diff;
 	return powerWind;
 }
 //------------------------------------------------------------------------------
@@ -961,11 +1034,18 @@ double Bp6CrownFire::calcPowerOfWind(
  *		required to initiate active or passive crowning (Btu/ft/s).
  *  \return Rothermel's power of the wind (ft-lb/ft2/s).
  */
-double Bp6CrownFire::calcTransitionRatio(
-		double surfaceFireIntensity,
-		double criticalSurfaceFireIntensity ) const
+template <class Real>
+Real Bp6CrownFireT<Real>::calcTransitionRatio(
+		Real surfaceFireIntensity,
+		Real criticalSurfaceFireIntensity ) const
 {
-	double ratio = ( criticalSurfaceFireIntensity <= 0. ) ? 0.
+	Real ratio = ( criticalSurfaceFireIntensity <= 0. ) ? 0.
 		: ( surfaceFireIntensity / criticalSurfaceFireIntensity );
 	return ratio;
 }
+
+//------------------------------------------------------------------------------
+// The double crown fire model, and the Bp6Dual crown fire model that also
+// carries the derivatives of every variable.
+template class Bp6CrownFireT<double>;
+template class Bp6CrownFireT<Bp6Dual>;
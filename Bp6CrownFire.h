@@ -3,7 +3,7 @@
 
 #include "Bp6SurfaceFire.h"
 
-/*!	\class Bp6CrownFire
+/*!	\class Bp6CrownFireT
  *	\brief Implements the Rothermel (1991) and the Scott & Reinhardt
  *	crown fire spread model.
  *
@@ -89,50 +89,51 @@
 	cf->getPassiveCrownFirePerimeter();// fire perimeter (ft) of a potential passive (torching) crown fire
 	cf->getPassiveCrownFireWidth();	// fire width (ft) of a potential passive (torching) crown fire
  */
-class Bp6CrownFire : public Bp6SurfaceFire
+template <class Real>
+class Bp6CrownFireT : public Bp6SurfaceFireT<Real>
 {
 public:
-	Bp6CrownFire();
-	virtual ~Bp6CrownFire();
+	Bp6CrownFireT();
+	virtual ~Bp6CrownFireT();
 
 	// Accessors
-	double getActiveCrownFireArea() const;
-	double getActiveCrownFireFlame() const;
-	double getActiveCrownFireFli() const;
-	double getActiveCrownFireHpua() const;
-	double getActiveCrownFireLength() const;
-	double getActiveCrownFirePerimeter() const;
-	double getActiveCrownFireRatio() const;
-	double getActiveCrownFireRos() const;
-	double getActiveCrownFireWidth() const;
-	double getCanopyFuelLoad() const;
-	double getCanopyHpua() const;
-	double getCriticalCrownFireRos() const;
-	double getCriticalSurfaceFireFlame() const;
-	double getCriticalSurfaceFireFli() const;
-	double getCriticalSurfaceFireRos() const;
-	double getCrownFireLwRatio() const;
-	double getCrownFractionBurned() const;
-	double getFinalFireFlame() const;
-	double getFinalFireFli() const;
-	double getFinalFireHpua() const;
-	double getFinalFireRos() const;
+	Real   getActiveCrownFireArea() const;
+	Real   getActiveCrownFireFlame() const;
+	Real   getActiveCrownFireFli() const;
+	Real   getActiveCrownFireHpua() const;
+	Real   getActiveCrownFireLength() const;
+	Real   getActiveCrownFirePerimeter() const;
+	Real   getActiveCrownFireRatio() const;
+	Real   getActiveCrownFireRos() const;
+	Real   getActiveCrownFireWidth() const;
+	Real   getCanopyFuelLoad() const;
+	Real   getCanopyHpua() const;
+	Real   getCriticalCrownFireRos() const;
+	Real   getCriticalSurfaceFireFlame() const;
+	Real   getCriticalSurfaceFireFli() const;
+	Real   getCriticalSurfaceFireRos() const;
+	Real   getCrownFireLwRatio() const;
+	Real   getCrownFractionBurned() const;
+	Real   getFinalFireFlame() const;
+	Real   getFinalFireFli() const;
+	Real   getFinalFireHpua() const;
+	Real   getFinalFireRos() const;
 	int	   getFinalFireType() const;
-	double getFullCrownFireU20() const;
-	double getFullCrownFireRos() const;
-	double getPassiveCrownFireArea() const;
-	double getPassiveCrownFireFlame() const;
-	double getPassiveCrownFireFli() const;
-	double getPassiveCrownFireHpua() const;
-	double getPassiveCrownFireLength() const;
-	double getPassiveCrownFirePerimeter() const;
-	double getPassiveCrownFireRos() const;
-	double getPassiveCrownFireWidth() const;
-	double getPowerFire() const;
-	double getPowerWind() const;
-	double getPowerRatio() const;
-	Bp6SurfaceFire* getSurfaceFire() const;
-	double getTransRatio() const;
+	Real   getFullCrownFireU20() const;
+	Real   getFullCrownFireRos() const;
+	Real   getPassiveCrownFireArea() const;
+	Real   getPassiveCrownFireFlame() const;
+	Real   getPassiveCrownFireFli() const;
+	Real   getPassiveCrownFireHpua() const;
+	Real   getPassiveCrownFireLength() const;
+	Real   getPassiveCrownFirePerimeter() const;
+	Real   getPassiveCrownFireRos() const;
+	Real   getPassiveCrownFireWidth() const;
+	Real   getPowerFire() const;
+	Real   getPowerWind() const;
+	Real   getPowerRatio() const;
+	Bp6SurfaceFireT<Real>* getSurfaceFire() const;
+	Real   getTransRatio() const;
 	bool   isActiveCrownFire() const;
 	bool   isCrownFire() const;
 	bool   isPassiveCrownFire() const;
@@ -153,110 +154,110 @@ public:
 	void resetSurfaceFireOutput();
 
 	void setCanopy(
-		double canopyHeight,
-		double canopyBaseHeight,
-		double canopyBulkDensity,
-		double canopyFoliarMoisture,
-		double canopyHeat=8000. );	// 7732.64 btu/lb = 18,000 kJ/kg
-	// This masks the Bp6SurfaceFire version of setSite() since its not implemented!
+		Real   canopyHeight,
+		Real   canopyBaseHeight,
+		Real   canopyBulkDensity,
+		Real   canopyFoliarMoisture,
+		Real   canopyHeat=8000. );	// 7732.64 btu/lb = 18,000 kJ/kg
+	// This masks the Bp6SurfaceFireT version of setSite() since its not implemented!
 	virtual void setSite(
-        double slopeFraction,			// rise/reach
-		double aspect,					// degrees clockwise from north
-        double midflameWindSpeed,		// ft/min
-        double windDirFromUpslope,		// degrees clockwise from North
+        Real   slopeFraction,			// rise/reach
+		Real   aspect,					// degrees clockwise from north
+        Real   midflameWindSpeed,		// ft/min
+        Real   windDirFromUpslope,		// degrees clockwise from North
 		bool   applyWindSpeedLimit );
-	void setSurfaceFire( Bp6SurfaceFire* surfaceFire );
+	void setSurfaceFire( Bp6SurfaceFireT<Real>* surfaceFire );
 	void setSurfaceFire(
-		double ros,
-		double fli,
-		double hpua );
+		Real   ros,
+		Real   fli,
+		Real   hpua );
 	// Use this instead of setSite()
-	void setWindSpeedAt20FtFpm( double windSpeedAt20ft );	// wind speed at 20 ft (ft/min)
+	void setWindSpeedAt20FtFpm( Real windSpeedAt20ft );	// wind speed at 20 ft (ft/min)
 	virtual void updateCanopy();
 	virtual void updateSurfaceFire();
 
 	// Static methods
-	double calcCriticalCrownFireSpreadRate( double canopyBulkDensity ) const;
+	Real   calcCriticalCrownFireSpreadRate( Real canopyBulkDensity ) const;
 
-	double calcCriticalSurfaceFireIntensity(
-		double foliarMoisture,
-		double canopyBaseHeight ) const;
+	Real   calcCriticalSurfaceFireIntensity(
+		Real   foliarMoisture,
+		Real   canopyBaseHeight ) const;
 
-	double calcCriticalSurfaceFireSpreadRate(
-			double criticalSurfaceFireIntensity,
-			double surfaceFireHpua ) const;
+	Real   calcCriticalSurfaceFireSpreadRate(
+			Real   criticalSurfaceFireIntensity,
+			Real   surfaceFireHpua ) const;
 
-	double calcCrownFireActiveRatio(
-		double crownSpreadRate,
-		double criticalSpreadRate ) const;
+	Real   calcCrownFireActiveRatio(
+		Real   crownSpreadRate,
+		Real   criticalSpreadRate ) const;
 
-	double calcCrownFireLengthToWidth( double windSpeedAt20ft ) const;
+	Real   calcCrownFireLengthToWidth( Real windSpeedAt20ft ) const;
 
-	double calcCrownFractionBurned(
-		double surfaceFireRos,
-		double criticalSurfaceFireRos,
-		double crowningSurfaceFireRos ) const;
+	Real   calcCrownFractionBurned(
+		Real   surfaceFireRos,
+		Real   criticalSurfaceFireRos,
+		Real   crowningSurfaceFireRos ) const;
 
-	double calcCrownFuelLoad(
-		double canopyBulkDensity,
-		double canopyHt,
-		double baseHt ) const;
+	Real   calcCrownFuelLoad(
+		Real   canopyBulkDensity,
+		Real   canopyHt,
+		Real   baseHt ) const;
 	
-	double calcCrowningIndex(
-		double canopyBulkDensity,
-		double reactionIntensity,
-		double heatSink,
-		double slopeFactor ) const;
+	Real   calcCrowningIndex(
+		Real   canopyBulkDensity,
+		Real   reactionIntensity,
+		Real   heatSink,
+		Real   slopeFactor ) const;
 
 	int calcFireType(
-		double tranRatio,
-		double activeRatio ) const;
+		Real   tranRatio,
+		Real   activeRatio ) const;
 
-	double calcPowerOfFire( double crownFirelineIntensity ) const;
+	Real   calcPowerOfFire( Real crownFirelineIntensity ) const;
 
-	double calcPowerOfWind(
-		double windSpeedAt20ft,
-		double spreadRate ) const;
+	Real   calcPowerOfWind(
+		Real   windSpeedAt20ft,
+		Real   spreadRate ) const;
 
-	double calcTransitionRatio(
-		double surfaceFireIntensity,
-		double critcalSurfaceFireIntensity ) const;
+	Real   calcTransitionRatio(
+		Real   surfaceFireIntensity,
+		Real   critcalSurfaceFireIntensity ) const;
 
 private:
 	void init();
 
 private:
 	// Canopy inputs
-	double m_canopyBaseHeight;
-	double m_canopyBulkDensity;
-	double m_canopyFoliarMois;
-	double m_canopyHeat;
-	double m_canopyHeight;
-	double m_windSpeedAt20ft;
+	Real   m_canopyBaseHeight;
+	Real   m_canopyBulkDensity;
+	Real   m_canopyFoliarMois;
+	Real   m_canopyHeat;
+	Real   m_canopyHeight;
+	Real   m_windSpeedAt20ft;
 	// Canopy-dependent outputs
-	double m_activeCrownFireRatio;
-	double m_canopyFuelLoad;
-	double m_canopyHpua;
-	double m_criticalCrownFireRos;
-	double m_criticalSurfaceFireFlame;
-	double m_criticalSurfaceFireFli;
-	double m_crownFireLwRatio;
-	double m_powerWind;
+	Real   m_activeCrownFireRatio;
+	Real   m_canopyFuelLoad;
+	Real   m_canopyHpua;
+	Real   m_criticalCrownFireRos;
+	Real   m_criticalSurfaceFireFlame;
+	Real   m_criticalSurfaceFireFli;
+	Real   m_crownFireLwRatio;
+	Real   m_powerWind;
 	// Surface fire inputs
-	Bp6SurfaceFire* m_surfaceFire;
-	double m_surfaceFireFli;
-	double m_surfaceFireHpua;
-	double m_surfaceFireRos;
+	Bp6SurfaceFireT<Real>* m_surfaceFire;
+	Real   m_surfaceFireFli;
+	Real   m_surfaceFireHpua;
+	Real   m_surfaceFireRos;
 	// Surface fire and canopy dependent outputs
-	double m_activeCrownFireFlame;
-	double m_activeCrownFireFli;
-	double m_activeCrownFireHpua;
-	double m_criticalSurfaceFireRos;
-	double m_crownFractionBurned;
-	double m_finalFireFlame;
-	double m_finalFireFli;
-	double m_finalFireHpua;
-	double m_finalFireRos;
+	Real   m_activeCrownFireFlame;
+	Real   m_activeCrownFireFli;
+	Real   m_activeCrownFireHpua;
+	Real   m_criticalSurfaceFireRos;
+	Real   m_crownFractionBurned;
+	Real   m_finalFireFlame;
+	Real   m_finalFireFli;
+	Real   m_finalFireHpua;
+	Real   m_finalFireRos;
 	int	   m_finalFireType;				// 0=surface, 1=passive, 2=conditional crown, 3=crown
 	bool   m_isActiveCrownFire;
 	bool   m_isCrownFire;
@@ -264,25 +265,28 @@ private:
 	bool   m_isPlumeDominated;
 	bool   m_isSurfaceFire;
 	bool   m_isWindDriven;
-	double m_fullCrownFireU20;
-	double m_fullCrownFireRos;
-	double m_passiveCrownFireFlame;
-	double m_passiveCrownFireFli;
-	double m_passiveCrownFireHpua;
-	double m_passiveCrownFireRos;
-	double m_powerFire;
-	double m_powerRatio;
-	double m_transRatio;
+	Real   m_fullCrownFireU20;
+	Real   m_fullCrownFireRos;
+	Real   m_passiveCrownFireFlame;
+	Real   m_passiveCrownFireFli;
+	Real   m_passiveCrownFireHpua;
+	Real   m_passiveCrownFireRos;
+	Real   m_powerFire;
+	Real   m_powerRatio;
+	Real   m_transRatio;
 	// updateSiteExtension() outputs
-	double m_activeCrownFireRos;
+	Real   m_activeCrownFireRos;
 	// updateTimeExtension() outputs
-	double m_activeCrownFireArea;
-	double m_activeCrownFireLength;
-	double m_activeCrownFirePerimeter;
-	double m_activeCrownFireWidth;
-	double m_passiveCrownFireArea;
-	double m_passiveCrownFireLength;
-	double m_passiveCrownFirePerimeter;
-	double m_passiveCrownFireWidth;
+	Real   m_activeCrownFireArea;
+	Real   m_activeCrownFireLength;
+	Real   m_activeCrownFirePerimeter;
+	Real   m_activeCrownFireWidth;
+	Real   m_passiveCrownFireArea;
+	Real   m_passiveCrownFireLength;
+	Real   m_passiveCrownFirePerimeter;
+	Real   m_passiveCrownFireWidth;
 };
+
+typedef Bp6CrownFireT<double> Bp6CrownFire;
+
 #endif	// BP6_CROWN_FIRE_H
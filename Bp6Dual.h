@@ -0,0 +1,200 @@
+#ifndef BP6_DUAL_H
+#define BP6_DUAL_H
+
+#include <math.h>
+
+/*!	\class Bp6Dual
+ *	\brief Forward-mode dual number: a value and its first derivatives with
+ *	respect to up to Size independent inputs.
+ *
+ *	Bp6SurfaceFireT<Bp6Dual> and Bp6CrownFireT<Bp6Dual> carry the derivatives
+ *	of every fire model variable alongside its value.  The values are
+ *	computed exactly as by the double instantiations.
+ *
+ *	\par Usage
+	// Step 1 - seed each input with its derivatives
+	Bp6Dual wind = Bp6Dual::seed( 440., 0 );	// d(wind)/d(input 0) = 1
+	Bp6Dual mois[10] ...;
+	mois[0] = Bp6Dual::seed( 0.06, 1 );			// d(mois)/d(input 1) = 1
+
+	// Step 2 - run the fire model
+	Bp6SurfaceFireT<Bp6Dual> fire;
+	...
+	fire.setSite( slope, aspect, wind, dir, true );
+
+	// Step 3 - read the value and derivatives of any output
+	Bp6Dual ros = fire.getSpreadRateAtHead();
+	ros.value();		// spread rate (ft/min)
+	ros.derivative( 0 );// d(ros)/d(wind) ((ft/min)/(ft/min))
+ */
+class Bp6Dual
+{
+public:
+	static const int Size = 16;
+
+	//! Constant (all derivatives zero)
+	Bp6Dual( double value=0. ) :
+		m_val( value )
+	{
+		for ( int i=0; i<Size; i++ )
+		{
+			m_der[i] = 0.;
+		}
+	}
+
+	//! Independent input \a index with unit derivative
+	static Bp6Dual seed( double value, int index )
+	{
+		Bp6Dual x( value );
+		x.m_der[index] = 1.;
+		return x;
+	}
+
+	double value() const { return m_val; }
+	double derivative( int index ) const { return m_der[index]; }
+	void   setDerivative( int index, double der ) { m_der[index] = der; }
+
+	Bp6Dual& operator+=( const Bp6Dual& b )
+	{
+		m_val += b.m_val;
+		for ( int i=0; i<Size; i++ )
+		{
+			m_der[i] += b.m_der[i];
+		}
+		return *this;
+	}
+	Bp6Dual& operator-=( const Bp6Dual& b )
+	{
+		m_val -= b.m_val;
+		for ( int i=0; i<Size; i++ )
+		{
+			m_der[i] -= b.m_der[i];
+		}
+		return *this;
+	}
+	Bp6Dual& operator*=( const Bp6Dual& b )
+	{
+		for ( int i=0; i<Size; i++ )
+		{
+			m_der[i] = m_der[i] * b.m_val + m_val * b.m_der[i];
+		}
+		m_val *= b.m_val;
+		return *this;
+	}
+	Bp6Dual& operator/=( const Bp6Dual& b )
+	{
+		double v = m_val / b.m_val;
+		for ( int i=0; i<Size; i++ )
+		{
+			m_der[i] = ( m_der[i] - v * b.m_der[i] ) / b.m_val;
+		}
+		m_val = v;
+		return *this;
+	}
+
+	//! Applies the chain rule for f(x) with f'(x) = \a slope.
+	//! Derivatives that are zero stay zero even where \a slope is infinite.
+	Bp6Dual chain( double value, double slope ) const
+	{
+		Bp6Dual r( value );
+		for ( int i=0; i<Size; i++ )
+		{
+			r.m_der[i] = ( m_der[i] == 0. ) ? 0. : slope * m_der[i];
+		}
+		return r;
+	}
+
+private:
+	double m_val;			// value
+	double m_der[Size];		// derivatives with respect to each input
+};
+
+//------------------------------------------------------------------------------
+// Arithmetic
+//------------------------------------------------------------------------------
+
+inline Bp6Dual operator-( const Bp6Dual& a )
+	{ return a.chain( -a.value(), -1. ); }
+inline Bp6Dual operator+( const Bp6Dual& a, const Bp6Dual& b )
+	{ Bp6Dual r( a ); r += b; return r; }
+inline Bp6Dual operator-( const Bp6Dual& a, const Bp6Dual& b )
+	{ Bp6Dual r( a ); r -= b; return r; }
+inline Bp6Dual operator*( const Bp6Dual& a, const Bp6Dual& b )
+	{ Bp6Dual r( a ); r *= b; return r; }
+inline Bp6Dual operator/( const Bp6Dual& a, const Bp6Dual& b )
+	{ Bp6Dual r( a ); r /= b; return r; }
+inline Bp6Dual operator+( const Bp6Dual& a, double b )
+	{ return a.chain( a.value() + b, 1. ); }
+inline Bp6Dual operator+( double a, const Bp6Dual& b )
+	{ return b.chain( a + b.value(), 1. ); }
+inline Bp6Dual operator-( const Bp6Dual& a, double b )
+	{ return a.chain( a.value() - b, 1. ); }
+inline Bp6Dual operator-( double a, const Bp6Dual& b )
+	{ return b.chain( a - b.value(), -1. ); }
+inline Bp6Dual operator*( const Bp6Dual& a, double b )
+	{ return a.chain( a.value() * b, b ); }
+inline Bp6Dual operator*( double a, const Bp6Dual& b )
+	{ return b.chain( a * b.value(), a ); }
+inline Bp6Dual operator/( const Bp6Dual& a, double b )
+	{ return a.chain( a.value() / b, 1. / b ); }
+inline Bp6Dual operator/( double a, const Bp6Dual& b )
+	{ double v = a / b.value(); return b.chain( v, -v / b.value() ); }
+
+//------------------------------------------------------------------------------
+// Comparisons (of the values only)
+//------------------------------------------------------------------------------
+
+inline bool operator< ( const Bp6Dual& a, const Bp6Dual& b ) { return a.value() <  b.value(); }
+inline bool operator<=( const Bp6Dual& a, const Bp6Dual& b ) { return a.value() <= b.value(); }
+inline bool operator> ( const Bp6Dual& a, const Bp6Dual& b ) { return a.value() >  b.value(); }
+inline bool operator>=( const Bp6Dual& a, const Bp6Dual& b ) { return a.value() >= b.value(); }
+inline bool operator==( const Bp6Dual& a, const Bp6Dual& b ) { return a.value() == b.value(); }
+inline bool operator!=( const Bp6Dual& a, const Bp6Dual& b ) { return a.value() != b.value(); }
+inline bool operator< ( const Bp6Dual& a, double b ) { return a.value() <  b; }
+inline bool operator<=( const Bp6Dual& a, double b ) { return a.value() <= b; }
+inline bool operator> ( const Bp6Dual& a, double b ) { return a.value() >  b; }
+inline bool operator>=( const Bp6Dual& a, double b ) { return a.value() >= b; }
+inline bool operator==( const Bp6Dual& a, double b ) { return a.value() == b; }
+inline bool operator!=( const Bp6Dual& a, double b ) { return a.value() != b; }
+inline bool operator< ( double a, const Bp6Dual& b ) { return a <  b.value(); }
+inline bool operator<=( double a, const Bp6Dual& b ) { return a <= b.value(); }
+inline bool operator> ( double a, const Bp6Dual& b ) { return a >  b.value(); }
+inline bool operator>=( double a, const Bp6Dual& b ) { return a >= b.value(); }
+inline bool operator==( double a, const Bp6Dual& b ) { return a == b.value(); }
+inline bool operator!=( double a, const Bp6Dual& b ) { return a != b.value(); }
+
+//------------------------------------------------------------------------------
+// Math library
+//------------------------------------------------------------------------------
+
+inline Bp6Dual asin( const Bp6Dual& a )
+	{ return a.chain( asin( a.value() ), 1. / sqrt( 1. - a.value() * a.value() ) ); }
+inline Bp6Dual cos( const Bp6Dual& a )
+	{ return a.chain( cos( a.value() ), -sin( a.value() ) ); }
+inline Bp6Dual exp( const Bp6Dual& a )
+	{ double v = exp( a.value() ); return a.chain( v, v ); }
+inline Bp6Dual fabs( const Bp6Dual& a )
+	{ return a.chain( fabs( a.value() ), ( a.value() < 0. ) ? -1. : 1. ); }
+inline Bp6Dual log( const Bp6Dual& a )
+	{ return a.chain( log( a.value() ), 1. / a.value() ); }
+inline Bp6Dual pow( const Bp6Dual& a, double b )
+	{ return a.chain( pow( a.value(), b ), b * pow( a.value(), b - 1. ) ); }
+inline Bp6Dual pow( double a, const Bp6Dual& b )
+	{ double v = pow( a, b.value() ); return b.chain( v, v * log( a ) ); }
+inline Bp6Dual pow( const Bp6Dual& a, const Bp6Dual& b )
+{
+	// d(a^b) = b a^(b-1) da + a^b ln(a) db
+	Bp6Dual r = a.chain( pow( a.value(), b.value() ),
+		b.value() * pow( a.value(), b.value() - 1. ) );
+	if ( a.value() > 0. )
+	{
+		r += b.chain( 0., r.value() * log( a.value() ) );
+	}
+	return r;
+}
+inline Bp6Dual sin( const Bp6Dual& a )
+	{ return a.chain( sin( a.value() ), cos( a.value() ) ); }
+inline Bp6Dual sqrt( const Bp6Dual& a )
+	{ double v = sqrt( a.value() ); return a.chain( v, 0.5 / v ); }
+
+#endif // BP6_DUAL_H
@@ -1,10 +1,13 @@
 #include "Bp6SurfaceFire.h"
+#include "Bp6Dual.h"
 #include <math.h>
 
-Bp6SurfaceFire::Bp6SurfaceFire() :
+template <class Real>
+Bp6SurfaceFireT<Real>::Bp6SurfaceFireT() :
 	m_pi( 3.141592654 ),
 	m_smidgen( 1.0e-7 ),
-	m_infinity( 999999999999. )
+	m_infinity( 999999999999. ),
+	m_specialized( true )
 {
 	resetFuelInput();
 	resetFuelOutput();
@@ -17,11 +20,13 @@ Bp6SurfaceFire::Bp6SurfaceFire() :
 }
 
 //------------------------------------------------------------------------------
-Bp6SurfaceFire::~Bp6SurfaceFire()
+template <class Real>
+Bp6SurfaceFireT<Real>::~Bp6SurfaceFireT()
 {}
 
 //------------------------------------------------------------------------------
-int Bp6SurfaceFire::fuelLife( int lifeCode )
+template <class Real>
+int Bp6SurfaceFireT<Real>::fuelLife( int lifeCode )
 {
     static int Life[4] =
     {
@@ -38,63 +43,78 @@ int Bp6SurfaceFire::fuelLife( int lifeCode )
 }
 
 // Fuel particle member variable accessors
-double Bp6SurfaceFire::getDeadMext() const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::getDeadMext() const
 {
 	return m_deadMext;
 }
-double Bp6SurfaceFire::getDepth() const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::getDepth() const
 {
 	return m_depth;
 }
-int    Bp6SurfaceFire::getParticles() const
+template <class Real>
+int    Bp6SurfaceFireT<Real>::getParticles() const
 {
 	return m_particles;
 }
-double Bp6SurfaceFire::getParticleArea( int particleIndex ) const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::getParticleArea( int particleIndex ) const
 {
 	return m_area[particleIndex];
 }
-double Bp6SurfaceFire::getParticleAwtg( int particleIndex ) const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::getParticleAwtg( int particleIndex ) const
 {
 	return m_aWtg[particleIndex];
 }
-double Bp6SurfaceFire::getParticleDens( int particleIndex ) const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::getParticleDens( int particleIndex ) const
 {
 	return m_dens[particleIndex];
 }
-double Bp6SurfaceFire::getParticleHeat( int particleIndex ) const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::getParticleHeat( int particleIndex ) const
 {
 	return m_heat[particleIndex];
 }
-int    Bp6SurfaceFire::getParticleLife( int particleIndex ) const
+template <class Real>
+int    Bp6SurfaceFireT<Real>::getParticleLife( int particleIndex ) const
 {
 	return m_life[particleIndex];
 }
-double Bp6SurfaceFire::getParticleLoad( int particleIndex ) const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::getParticleLoad( int particleIndex ) const
 {
 	return m_load[particleIndex];
 }
-double Bp6SurfaceFire::getParticleSavr( int particleIndex ) const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::getParticleSavr( int particleIndex ) const
 {
 	return m_savr[particleIndex];
 }
-double Bp6SurfaceFire::getParticleSeff( int particleIndex ) const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::getParticleSeff( int particleIndex ) const
 {
 	return m_seff[particleIndex];
 }
-double Bp6SurfaceFire::getParticleSigK( int particleIndex ) const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::getParticleSigK( int particleIndex ) const
 {
 	return m_sigK[particleIndex];
 }
-int Bp6SurfaceFire::getParticleSize( int particleIndex ) const
+template <class Real>
+int Bp6SurfaceFireT<Real>::getParticleSize( int particleIndex ) const
 {
 	return m_size[particleIndex];
 }
-double Bp6SurfaceFire::getParticleStot( int particleIndex ) const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::getParticleStot( int particleIndex ) const
 {
 	return m_stot[particleIndex];
 }
-double Bp6SurfaceFire::getParticleSwtg( int particleIndex ) const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::getParticleSwtg( int particleIndex ) const
 {
 	return m_sWtg[particleIndex];
 }
@@ -103,7 +123,8 @@ double Bp6SurfaceFire::getParticleSwtg( int particleIndex ) const
 /*!	\brief Returns the life category (dead or live) total surface area (ft2).
  *	\param lifeCat 0=dead, 1=live
  */
-double Bp6SurfaceFire::getLifeArea( int lifeCat ) const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::getLifeArea( int lifeCat ) const
 {
 	return m_lifeArea[lifeCat];
 }
@@ -111,7 +132,8 @@ double Bp6SurfaceFire::getLifeArea( int lifeCat ) const
 /*!	\brief Returns the life category (dead or live) surface area weighting factor (fraction).
  *	\param lifeCat 0=dead, 1=live
  */
-double Bp6SurfaceFire::getLifeAwtg( int lifeCat ) const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::getLifeAwtg( int lifeCat ) const
 {
 	return m_lifeAwtg[lifeCat];
 }
@@ -119,7 +141,8 @@ double Bp6SurfaceFire::getLifeAwtg( int lifeCat ) const
 /*!	\brief Returns the life category (dead or live) mineral damping coefficient (fraction).
  *	\param lifeCat 0=dead, 1=live
  */
-double Bp6SurfaceFire::getLifeEtaS( int lifeCat ) const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::getLifeEtaS( int lifeCat ) const
 {
 	return m_lifeEtaS[lifeCat];
 }
@@ -131,7 +154,8 @@ double Bp6SurfaceFire::getLifeEtaS( int lifeCat ) const
  *
  *	\param lifeCat 0=dead, 1=live
  */
-double Bp6SurfaceFire::getLifeFine( int lifeCat ) const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::getLifeFine( int lifeCat ) const
 {
 	return m_lifeFine[lifeCat];
 }
@@ -139,7 +163,8 @@ double Bp6SurfaceFire::getLifeFine( int lifeCat ) const
 /*!	\brief Returns the life category (dead or live) weighted heat of combustion (btu/lb).
   *	\param lifeCat 0=dead, 1=live
 */
-double Bp6SurfaceFire::getLifeHeat( int lifeCat ) const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::getLifeHeat( int lifeCat ) const
 {
 	return m_lifeHeat[lifeCat];
 }
@@ -147,7 +172,8 @@ double Bp6SurfaceFire::getLifeHeat( int lifeCat ) const
 /*!	\brief Returns the life category (dead or live) size-class weighted fuel load (lb/ft2).
  *	\param lifeCat 0=dead, 1=live
  */
-double Bp6SurfaceFire::getLifeLoad( int lifeCat ) const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::getLifeLoad( int lifeCat ) const
 {
 	return m_lifeLoad[lifeCat];
 }
@@ -157,7 +183,8 @@ double Bp6SurfaceFire::getLifeLoad( int lifeCat ) const
  *		coefficient is applied.
  *	\param lifeCat 0=dead, 1=live
  */
-double Bp6SurfaceFire::getLifeRxDry( int lifeCat ) const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::getLifeRxDry( int lifeCat ) const
 {
 	return m_lifeRxDry[lifeCat];
 }
@@ -165,7 +192,8 @@ double Bp6SurfaceFire::getLifeRxDry( int lifeCat ) const
 /*!	\brief Returns the life category (dead or live) weighted surface area-to-volume ratio (1/ft).
  *	\param lifeCat 0=dead, 1=live
 */
-double Bp6SurfaceFire::getLifeSavr( int lifeCat ) const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::getLifeSavr( int lifeCat ) const
 {
 	return m_lifeSavr[lifeCat];
 }
@@ -174,7 +202,8 @@ double Bp6SurfaceFire::getLifeSavr( int lifeCat ) const
  *	mineral content (fraction).
  *	\param lifeCat 0=dead, 1=live
  */
-double Bp6SurfaceFire::getLifeSeff( int lifeCat ) const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::getLifeSeff( int lifeCat ) const
 {
 	return m_lifeSeff[lifeCat];
 }
@@ -182,7 +211,8 @@ double Bp6SurfaceFire::getLifeSeff( int lifeCat ) const
 /*!	\brief Returns the life category (dead or live) weighted total mineral content (fraction).
  *	\param lifeCat 0=dead, 1=live
 */
-double Bp6SurfaceFire::getLifeStot( int lifeCat ) const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::getLifeStot( int lifeCat ) const
 {
 	return m_lifeStot[lifeCat];
 }
@@ -192,109 +222,134 @@ double Bp6SurfaceFire::getLifeStot( int lifeCat ) const
  *	\param lifeCat 0=dead, 1=live
  *	\param size Size class index [0..5]
 */
-double Bp6SurfaceFire::getLifeSwtg( int lifeCat, int size ) const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::getLifeSwtg( int lifeCat, int size ) const
 {
 	return m_lifeSwtg[lifeCat][size];
 }
 
 // Fuel bed member variable accessors
-double Bp6SurfaceFire::getAa() const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::getAa() const
 {
 	return m_aa;
 }
-double Bp6SurfaceFire::getBetaRatio() const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::getBetaRatio() const
 {
 	return m_betaRatio;
 }
-double Bp6SurfaceFire::getBulkDensity() const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::getBulkDensity() const
 {
 	return m_bulkDensity;
 }
-double Bp6SurfaceFire::getC() const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::getC() const
 {
 	return m_c;
 }
-double Bp6SurfaceFire::getE() const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::getE() const
 {
 	return m_e;
 }
-double Bp6SurfaceFire::getEffectiveHeatingNumber() const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::getEffectiveHeatingNumber() const
 {
 	return m_epsilon;
 }
-double Bp6SurfaceFire::getGammaMax() const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::getGammaMax() const
 {
 	return m_gammaMax;
 }
-double Bp6SurfaceFire::getGammaOpt() const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::getGammaOpt() const
 {
 	return m_gammaOpt;
 }
-double Bp6SurfaceFire::getLiveMextK() const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::getLiveMextK() const
 {
 	return m_liveMextK;
 }
-double Bp6SurfaceFire::getOptimumPackingRatio() const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::getOptimumPackingRatio() const
 {
 	return m_betaOpt;
 }
-double Bp6SurfaceFire::getPackingRatio() const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::getPackingRatio() const
 {
 	return m_packingRatio;
 }
-double Bp6SurfaceFire::getPropagatingFlux() const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::getPropagatingFlux() const
 {
 	return m_propFlux;
 }
-double Bp6SurfaceFire::getResidenceTime() const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::getResidenceTime() const
 {
 	return m_resTime;
 }
-double Bp6SurfaceFire::getSigma() const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::getSigma() const
 {
 	return m_sigma;
 }
-double Bp6SurfaceFire::getSigma15() const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::getSigma15() const
 {
 	return m_sigma15;
 }
-double Bp6SurfaceFire::getSlopeK() const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::getSlopeK() const
 {
 	return m_slopeK;
 }
-double Bp6SurfaceFire::getTotalArea() const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::getTotalArea() const
 {
 	return m_totalArea;
 }
-double Bp6SurfaceFire::getTotalLoad() const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::getTotalLoad() const
 {
 	return m_totalLoad;
 }
-double Bp6SurfaceFire::getWindB() const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::getWindB() const
 {
 	return m_windB;
 }
-double Bp6SurfaceFire::getWindE() const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::getWindE() const
 {
 	return m_windE;
 }
-double Bp6SurfaceFire::getWindK() const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::getWindK() const
 {
 	return m_windK;
 }
 //------------------------------------------------------------------------------
 // Fuel moisture input accessors
-double Bp6SurfaceFire::getMois( int particleIndex ) const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::getMois( int particleIndex ) const
 {
 	return m_mois[ particleIndex ];
 }
 //------------------------------------------------------------------------------
 // Fuel moisture dependent output member data accessors
-double  Bp6SurfaceFire::getDeadMois() const
+template <class Real>
+Real  Bp6SurfaceFireT<Real>::getDeadMois() const
 {
 	return m_deadMois;
 }
-double  Bp6SurfaceFire::getDeadRxDry() const
+template <class Real>
+Real  Bp6SurfaceFireT<Real>::getDeadRxDry() const
 {
 	return m_lifeRxDry[DeadCat];
 }
@@ -302,11 +357,13 @@ double  Bp6SurfaceFire::getDeadRxDry() const
 /*!	\brief Returns the ratio of the water mass / fuel mass that must be heated
  *	to ignition (used to derive the live fuel moisture content of extinction).
  */
-double  Bp6SurfaceFire::getFdMois() const
+template <class Real>
+Real  Bp6SurfaceFireT<Real>::getFdMois() const
 {
 	return m_fdmois;
 }
-double  Bp6SurfaceFire::getHeatSink() const
+template <class Real>
+Real  Bp6SurfaceFireT<Real>::getHeatSink() const
 {
 	return m_rbQig;
 }
@@ -314,7 +371,8 @@ double  Bp6SurfaceFire::getHeatSink() const
 /*!	\brief Returns the life category (dead or live) fuel moisture content of extinction (ratio).
  *	\param lifeCat 0=dead, 1=live
 */
-double Bp6SurfaceFire::getLifeMext( int lifeCat ) const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::getLifeMext( int lifeCat ) const
 {
 	return ( lifeCat == DeadCat ) ? m_deadMext : m_liveMextApplied;
 }
@@ -322,7 +380,8 @@ double Bp6SurfaceFire::getLifeMext( int lifeCat ) const
 /*!	\brief Returns the life category (dead or live) weighted fuel moisture content (ratio).
  *	\param lifeCat 0=dead, 1=live
 */
-double Bp6SurfaceFire::getLifeMois( int lifeCat ) const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::getLifeMois( int lifeCat ) const
 {
 	return ( lifeCat == DeadCat ) ? m_deadMois : m_liveMois;
 }
@@ -336,14 +395,16 @@ double Bp6SurfaceFire::getLifeMois( int lifeCat ) const
  *
  *	If m_liveMextChaparral < 0.5, then m_liveMextCalculated is applied.
 */
-double  Bp6SurfaceFire::getLiveMextApplied() const
+template <class Real>
+Real  Bp6SurfaceFireT<Real>::getLiveMextApplied() const
 {
 	return m_liveMextApplied;
 }
 //------------------------------------------------------------------------------
 /*!	\brief Returns the \a calculated live fuel moisture content of extinction (ratio).
 */
-double  Bp6SurfaceFire::getLiveMextCalculated() const
+template <class Real>
+Real  Bp6SurfaceFireT<Real>::getLiveMextCalculated() const
 {
 	return m_liveMextCalculated;
 }
@@ -356,19 +417,23 @@ double  Bp6SurfaceFire::getLiveMextCalculated() const
  *
  *	If m_liveMextChaparral < 0.5, then m_liveMextCalculated is applied.
 */
-double  Bp6SurfaceFire::getLiveMextChaparral() const
+template <class Real>
+Real  Bp6SurfaceFireT<Real>::getLiveMextChaparral() const
 {
 	return m_liveMextChaparral;
 }
-double  Bp6SurfaceFire::getLiveMois() const
+template <class Real>
+Real  Bp6SurfaceFireT<Real>::getLiveMois() const
 {
 	return m_liveMois;
 }
-double  Bp6SurfaceFire::getLiveRxDry() const
+template <class Real>
+Real  Bp6SurfaceFireT<Real>::getLiveRxDry() const
 {
 	return m_lifeRxDry[LiveCat];
 }
-double  Bp6SurfaceFire::getRbQig() const
+template <class Real>
+Real  Bp6SurfaceFireT<Real>::getRbQig() const
 {
 	return m_rbQig;
 }
@@ -376,77 +441,88 @@ double  Bp6SurfaceFire::getRbQig() const
 /*!	\brief Returns the ratio of the mass of water within the mass of fuel that
  *	must be heated to ignition (used to derive the live fuel moisture content of extinction).
  */
-double  Bp6SurfaceFire::getWfmd() const
+template <class Real>
+Real  Bp6SurfaceFireT<Real>::getWfmd() const
 {
 	return m_wfmd;
 }
 //------------------------------------------------------------------------------
 /*!	\brief Returns the dead fuel moisture damping coefficient (dl).
  */
- double Bp6SurfaceFire::getDeadEtaM() const
+template <class Real>
+ Real Bp6SurfaceFireT<Real>::getDeadEtaM() const
  {
 	 return m_deadEtaM;
  }
 //------------------------------------------------------------------------------
 /*!	\brief Returns the dead fuel fire reaction intensity (Btu/ft2/min).
  */
- double Bp6SurfaceFire::getDeadRxInt() const
+template <class Real>
+ Real Bp6SurfaceFireT<Real>::getDeadRxInt() const
  {
 	 return m_deadRxInt;
  }
 //------------------------------------------------------------------------------
 /*!	\brief Returns the live fuel moisture damping coefficient (dl).
  */
- double Bp6SurfaceFire::getLiveEtaM() const
+template <class Real>
+ Real Bp6SurfaceFireT<Real>::getLiveEtaM() const
  {
 	 return m_liveEtaM;
  }
 //------------------------------------------------------------------------------
 /*!	\brief Returns the live fuel fire reaction intensity (Btu/ft2/min).
  */
- double Bp6SurfaceFire::getLiveRxInt() const
+template <class Real>
+ Real Bp6SurfaceFireT<Real>::getLiveRxInt() const
  {
 	 return m_liveRxInt;
  }
 //------------------------------------------------------------------------------
 /*!	\brief Returns the total (dead plus live) fire reaction intensity (Btu/ft2/min).
  */
- double Bp6SurfaceFire::getTotalRxInt() const
+template <class Real>
+ Real Bp6SurfaceFireT<Real>::getTotalRxInt() const
  {
 	 return m_totalRxInt;
  }
 //------------------------------------------------------------------------------
 /*! \brief Returns the current no-wind, no-slope spread rate (ft/min).
 */
- double Bp6SurfaceFire::getNoWindNoSlopeSpreadRate() const
+template <class Real>
+ Real Bp6SurfaceFireT<Real>::getNoWindNoSlopeSpreadRate() const
 {
 	return m_ros0;
 }
 //------------------------------------------------------------------------------
 /*! \brief Returns the current input applyWindSpeedLimit toggle.
 */
-bool Bp6SurfaceFire::getApplyWindSpeedLimit() const
+template <class Real>
+bool Bp6SurfaceFireT<Real>::getApplyWindSpeedLimit() const
 {
 	return m_applyWindSpeedLimit;
 }
 //------------------------------------------------------------------------------
 /*! \brief Returns the current input terrain aspect (degrees clockwie from north).
 */
-double Bp6SurfaceFire::getAspect() const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::getAspect() const
 {
 	return m_aspect;
 }
 //------------------------------------------------------------------------------
 /*! \brief Returns the fire perimeter eccentricity (fl).
 */
-double Bp6SurfaceFire::getEccentricity() const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::getEccentricity() const
 {
 	return m_eccent;
 }
 //------------------------------------------------------------------------------
 /*! \brief Returns the updated effective wind speed (ft/min)
 */
-double Bp6SurfaceFire::getEffectiveWindSpeed() const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::getEffectiveWindSpeed() const
 {
 	return m_effectiveWindSpeed;
 }
@@ -456,108 +532,123 @@ double Bp6SurfaceFire::getEffectiveWindSpeed() const
  *	Replaces the xfblib function FBL_EffectWindSpeedAtVector
  *  which requires use of the global m_* variables.
  */
-double Bp6SurfaceFire::getEffectiveWindSpeedAtVector( double vectorRos ) const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::getEffectiveWindSpeedAtVector( Real vectorRos ) const
 {
-	double phiEw   = ( m_ros0 < m_smidgen ) ? 0. : ( vectorRos / m_ros0 - 1. );
-    double effWind = ( ( phiEw * m_windE ) < m_smidgen || m_windB < m_smidgen )
+	Real phiEw   = ( m_ros0 < m_smidgen ) ? 0. : ( vectorRos / m_ros0 - 1. );
+    Real effWind = ( ( phiEw * m_windE ) < m_smidgen || m_windB < m_smidgen )
                    ? 0. : pow( ( phiEw * m_windE ), ( 1. / m_windB ) );
     return effWind;
 }
 //------------------------------------------------------------------------------
 /*! \brief Returns the updated direction of maximum spread (degrees clockwise from upslope).
 */
-double Bp6SurfaceFire::getHeadDirFromUpslope() const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::getHeadDirFromUpslope() const
 {
 	return m_headDirFromUpslope;
 }
 //------------------------------------------------------------------------------
 /*! \brief Returns the updated heat per unit area (btu/ft2).
 */
-double Bp6SurfaceFire::getHeatPerUnitArea() const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::getHeatPerUnitArea() const
 {
 	return m_hpua;
 }
 //------------------------------------------------------------------------------
 /*! \brief Returns the updated fireline intensity at the fire back (btu/ft/s).
 */
-double Bp6SurfaceFire::getFirelineIntensityAtBack() const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::getFirelineIntensityAtBack() const
 {
 	return m_fliBack;
 }
 //------------------------------------------------------------------------------
 /*! \brief Returns the updated fireline intensity at the fire flank (btu/ft/s).
 */
-double Bp6SurfaceFire::getFirelineIntensityAtFlank() const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::getFirelineIntensityAtFlank() const
 {
 	return m_fliFlank;
 }
 //------------------------------------------------------------------------------
 /*! \brief Returns the updated fireline intensity at the fire head (btu/ft/s).
 */
-double Bp6SurfaceFire::getFirelineIntensityAtHead() const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::getFirelineIntensityAtHead() const
 {
 	return m_fliHead;
 }
 //------------------------------------------------------------------------------
 /*! \brief Returns the updated flame length at the fire back (btu/ft/s).
 */
-double Bp6SurfaceFire::getFlameLengthAtBack() const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::getFlameLengthAtBack() const
 {
 	return m_flameBack;
 }
 //------------------------------------------------------------------------------
 /*! \brief Returns the updated flame length at the fire flank (btu/ft/s).
 */
-double Bp6SurfaceFire::getFlameLengthAtFlank() const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::getFlameLengthAtFlank() const
 {
 	return m_flameFlank;
 }
 //------------------------------------------------------------------------------
 /*! \brief Returns the updated flame length at the fire head (btu/ft/s).
 */
-double Bp6SurfaceFire::getFlameLengthAtHead() const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::getFlameLengthAtHead() const
 {
 	return m_flameHead;
 }
 //------------------------------------------------------------------------------
 /*! \brief Returns the updated fire length-to-width ratio
 */
-double Bp6SurfaceFire::getLengthToWidthRatio() const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::getLengthToWidthRatio() const
 {
 	return m_lwRatio;
 }
 //------------------------------------------------------------------------------
 /*! \brief Returns the current input midflame wind speed (mi/h).
 */
-double Bp6SurfaceFire::getMidflameWindSpeed() const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::getMidflameWindSpeed() const
 {
 	return m_midflameWindSpeed;
 }
 //------------------------------------------------------------------------------
 /*! \brief Returns the updated fire spread rate situation code (1..6).
 */
-int Bp6SurfaceFire::getSituation() const
+template <class Real>
+int Bp6SurfaceFireT<Real>::getSituation() const
 {
 	return m_situation;
 }
 //------------------------------------------------------------------------------
 /*! \brief Returns the updated fire spread rate slope factor phiS (dl).
 */
-double Bp6SurfaceFire::getSlopeFactor() const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::getSlopeFactor() const
 {
 	return m_slopeFactor;
 }
 //------------------------------------------------------------------------------
 /*! \brief Returns the current input terrain slope steepnes (rise/reach).
 */
-double Bp6SurfaceFire::getSlopeFraction() const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::getSlopeFraction() const
 {
 	return m_slopeFraction;
 }
 //------------------------------------------------------------------------------
 /*! \brief Returns the updated spread rate at the fire back (ft/min).
 */
-double Bp6SurfaceFire::getSpreadRateAtBack() const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::getSpreadRateAtBack() const
 {
 	return m_rosBack;
 }
@@ -565,98 +656,209 @@ double Bp6SurfaceFire::getSpreadRateAtBack() const
 /*! \brief Returns the updated spread rate at the specified beta vector (ft/min).
  *	\param beta Vector of interest (degrees clockwise from heading direction).
 */
-double Bp6SurfaceFire::getSpreadRateAtBeta( double beta ) const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::getSpreadRateAtBeta( Real beta ) const
 {
 	return calcSpreadRateAtBeta( m_rosHead, m_lwRatio, beta );
 }
 //------------------------------------------------------------------------------
+/*! \brief Fills arrays with the updated spread rate (ft/min), fireline
+ *	intensity (btu/ft/s), and flame length (ft) at \a directions beta
+ *	vectors equally spaced clockwise from the heading direction.
+ *
+ *	Gives the same values as getSpreadRateAtBeta() for each direction, but
+ *	the head spread rate and eccentricity of the current site are reused
+ *	for all of them.  Since beta is measured from the ignition point, the
+ *	fire perimeter after \a t minutes lies at ros[i] * t in each direction.
+ *
+ *	Does nothing if \a directions is not positive or \a ros is NULL.
+ *
+ *	\param directions Number of directions (e.g., 360 for every degree).
+ *	\param ros Array of \a directions spread rates (ft/min).
+ *	\param fli Array of \a directions fireline intensities (btu/ft/s), or NULL.
+ *	\param flame Array of \a directions flame lengths (ft), or NULL.
+ */
+template <class Real>
+void Bp6SurfaceFireT<Real>::getSpreadProfileAtBeta( int directions, Real* ros,
+	Real* fli, Real* flame ) const
+{
+	if ( directions <= 0 || ! ros )
+	{
+		return;
+	}
+	Real step = 360. / (Real) directions;
+	Real factor = m_rosHead * ( 1. - m_eccent );
+	for ( int d=0; d<directions; d++ )
+	{
+		Real beta = step * d;
+		ros[d] = m_rosHead;
+		if ( fabs( beta ) > 0.1 )
+		{
+			ros[d] = factor / ( 1. - m_eccent * cos( calcRadians( beta ) ) );
+		}
+		if ( fli || flame )
+		{
+			Real i = calcFirelineIntensity( ros[d], m_totalRxInt, m_resTime );
+			if ( fli )
+			{
+				fli[d] = i;
+			}
+			if ( flame )
+			{
+				flame[d] = calcFlameLengthByram( i );
+			}
+		}
+	}
+}
+//------------------------------------------------------------------------------
+/*! \brief Fills arrays with the updated fire front expansion rate (ft/min),
+ *	fireline intensity (btu/ft/s), and flame length (ft) at \a directions psi
+ *	vectors (normals to the fire perimeter) equally spaced clockwise from the
+ *	heading direction.
+ *
+ *	Uses the Catchpole et al. (1982) ellipse expansion rate
+ *	g cos(psi) + sqrt( f^2 cos^2(psi) + h^2 sin^2(psi) ) of
+ *	FBL_SurfaceFireExpansionRateAtPsi() with the ellipse rate factors of the
+ *	current site, as EqCalc::FireSpreadAtPsi() does for a single direction.
+ *
+ *	Does nothing if \a directions is not positive or \a ros is NULL.
+ *
+ *	\param directions Number of directions (e.g., 360 for every degree).
+ *	\param ros Array of \a directions expansion rates (ft/min).
+ *	\param fli Array of \a directions fireline intensities (btu/ft/s), or NULL.
+ *	\param flame Array of \a directions flame lengths (ft), or NULL.
+ */
+template <class Real>
+void Bp6SurfaceFireT<Real>::getSpreadProfileAtPsi( int directions, Real* ros,
+	Real* fli, Real* flame ) const
+{
+	if ( directions <= 0 || ! ros )
+	{
+		return;
+	}
+	Real step = 360. / (Real) directions;
+	Real f2 = m_ellipseF * m_ellipseF;
+	Real h2 = m_ellipseH * m_ellipseH;
+	for ( int d=0; d<directions; d++ )
+	{
+		Real cosPsi = cos( calcRadians( step * d ) );
+		Real cos2Psi = cosPsi * cosPsi;
+		ros[d] = m_ellipseG * cosPsi + sqrt( f2 * cos2Psi + h2 * ( 1. - cos2Psi ) );
+		if ( fli || flame )
+		{
+			Real i = calcFirelineIntensity( ros[d], m_totalRxInt, m_resTime );
+			if ( fli )
+			{
+				fli[d] = i;
+			}
+			if ( flame )
+			{
+				flame[d] = calcFlameLengthByram( i );
+			}
+		}
+	}
+}
+//------------------------------------------------------------------------------
 /*! \brief Returns the updated spread rate at the fire flank (ft/min).
 */
-double Bp6SurfaceFire::getSpreadRateAtFlank() const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::getSpreadRateAtFlank() const
 {
 	return m_rosFlank;
 }
 //------------------------------------------------------------------------------
 /*! \brief Returns the updated spread rate at the fire head (ft/min).
 */
-double Bp6SurfaceFire::getSpreadRateAtHead() const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::getSpreadRateAtHead() const
 {
 	return m_rosHead;
 }
 //------------------------------------------------------------------------------
 /*! \brief Returns the updated spread rate-exceeds-wind speed flag.
 */
-bool Bp6SurfaceFire::getSpreadRateExceedsWindSpeed() const
+template <class Real>
+bool Bp6SurfaceFireT<Real>::getSpreadRateExceedsWindSpeed() const
 {
 	return m_spreadExceedsWind;
 }
 //------------------------------------------------------------------------------
 /*! \brief Returns the current input no-wind, no-slope fire spread rate (ft/min).
 */
-double Bp6SurfaceFire::getWindDirFromUpslope() const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::getWindDirFromUpslope() const
 {
 	return m_windDirFromUpslope;
 }
 //------------------------------------------------------------------------------
 /*! \brief Returns the updated fire spread rate wind factor phiW (dl).
 */
-double Bp6SurfaceFire::getWindFactor() const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::getWindFactor() const
 {
 	return m_windFactor;
 }
 //------------------------------------------------------------------------------
 /*! \brief Returns the updated wind limit exceeded flag.
 */
-bool Bp6SurfaceFire::getWindLimitExceeded() const
+template <class Real>
+bool Bp6SurfaceFireT<Real>::getWindLimitExceeded() const
 {
 	return m_windLimitExceeded;
 }
 //------------------------------------------------------------------------------
 /*! \brief Returns the updated fire spread rate combined wind-slope factor phiEw (dl).
 */
-double Bp6SurfaceFire::getWindSlopeFactor() const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::getWindSlopeFactor() const
 {
 	return m_windFactor + m_slopeFactor;
 }
 //------------------------------------------------------------------------------
 /*! \brief Returns the updated fire spread wind speed limit (ft/min).
 */
-double Bp6SurfaceFire::getWindSpeedLimit() const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::getWindSpeedLimit() const
 {
 	return m_windSpeedLimit;
 }
 //------------------------------------------------------------------------------
 /*! \brief Returns the updated fire area in acres.
 */
-double Bp6SurfaceFire::getFireAcres() const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::getFireAcres() const
 {
 	return m_fireArea / ( 66. * 660.);
 }
 //------------------------------------------------------------------------------
 /*! \brief Returns the updated fire area in ft2.
 */
-double Bp6SurfaceFire::getFireArea() const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::getFireArea() const
 {
 	return m_fireArea;
 }
 //------------------------------------------------------------------------------
 /*! \brief Returns the updated fire length (ft).
 */
-double Bp6SurfaceFire::getFireLength() const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::getFireLength() const
 {
 	return m_fireLength;
 }
 //------------------------------------------------------------------------------
 /*! \brief Returns the updated fire perimeter (ft).
 */
-double Bp6SurfaceFire::getFirePerimeter() const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::getFirePerimeter() const
 {
 	return m_firePerimeter;
 }
 //------------------------------------------------------------------------------
 /*! \brief Returns the updated fire width (ft).
 */
-double Bp6SurfaceFire::getFireWidth() const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::getFireWidth() const
 {
 	return m_fireWidth;
 }
@@ -664,24 +866,60 @@ double Bp6SurfaceFire::getFireWidth() const
 /*!	\brief This is a convenience routine used only by the derived Bp6CrownFire
  *	class to easily derive the R'sa of the surface fuel below the canopy.
  */
-double Bp6SurfaceFire::getRsa(
-        double midflameWindSpeed )		// mid-flame wind speed (ft/min)
+template <class Real>
+Real Bp6SurfaceFireT<Real>::getRsa(
+        Real midflameWindSpeed )		// mid-flame wind speed (ft/min)
 {
-	double saved = m_midflameWindSpeed;
+	Real saved = m_midflameWindSpeed;
 	m_midflameWindSpeed	= midflameWindSpeed;
 	updateSite();
-	double rsa = m_rosHead;
+	Real rsa = m_rosHead;
 	m_midflameWindSpeed = saved;
 	updateSite();
 	return rsa;
 }
 
 //------------------------------------------------------------------------------
-void Bp6SurfaceFire::resetFuelInput()
+/*!	\brief Returns TRUE if the fuel inputs are identical to those of the
+ *	most recent call to setFuel() or copyFuel().
+ */
+template <class Real>
+bool Bp6SurfaceFireT<Real>::isSameFuel(
+	Real depth,		// fuel bed depth (ft)
+	Real deadMext,	// fuel dead dead fuel moisture of extinction
+	int    particles,	// number of particles in following arrays
+	int    *life,		// array of fuel particle life codes
+	Real *load,		// array of fuel particle loads (lb/ft2)
+	Real *savr,		// array of fuel aprticle surface area-to-volume rations (ft3/ft2)
+	Real *heat,		// array of fuel particle low heat of combustions (btu/lb)
+	Real *dens,		// array of fuel particle densities (lb/ft3)
+	Real *stot,		// array of fuel particle total Silica contents (lb/lb)
+	Real *seff ) const	// array of fuel particle effective Silica contents (lb/lb)
+{
+	if ( depth != m_depth || deadMext != m_deadMext || particles != m_particles )
+	{
+		return false;
+	}
+	for( int p=0; p<m_particles; p++ )
+	{
+		if ( life[p] != m_life[p] || load[p] != m_load[p] || savr[p] != m_savr[p]
+		  || heat[p] != m_heat[p] || dens[p] != m_dens[p] || stot[p] != m_stot[p]
+		  || seff[p] != m_seff[p] )
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+//------------------------------------------------------------------------------
+template <class Real>
+void Bp6SurfaceFireT<Real>::resetFuelInput()
 {
 	m_depth = 1.;
 	m_deadMext = 0.;
 	m_particles = 0;
+	m_kernelParts = 0;
 	for( int p=0; p<MaxParts; p++ )
 	{
 		m_life[p] = DeadCat;
@@ -694,7 +932,8 @@ void Bp6SurfaceFire::resetFuelInput()
 	}
 }
 //------------------------------------------------------------------------------
-void Bp6SurfaceFire::resetFuelOutput()
+template <class Real>
+void Bp6SurfaceFireT<Real>::resetFuelOutput()
 {
     // Fuel bed intermediates output by this function
 	m_aa           = 0.;
@@ -749,7 +988,8 @@ void Bp6SurfaceFire::resetFuelOutput()
 }
 
 //------------------------------------------------------------------------------
-void Bp6SurfaceFire::resetMoistureInput()
+template <class Real>
+void Bp6SurfaceFireT<Real>::resetMoistureInput()
 {
 	for( int p=0; p<MaxParts; p++ )
 	{
@@ -758,7 +998,8 @@ void Bp6SurfaceFire::resetMoistureInput()
 }
 
 //------------------------------------------------------------------------------
-void Bp6SurfaceFire::resetMoistureOutput()
+template <class Real>
+void Bp6SurfaceFireT<Real>::resetMoistureOutput()
 {
     m_rbQig    = 0.;
     m_fdmois   = 0.;
@@ -776,7 +1017,8 @@ void Bp6SurfaceFire::resetMoistureOutput()
 	m_liveMextChaparral = 0.;
 }
 //------------------------------------------------------------------------------
-void Bp6SurfaceFire::resetSiteInput()
+template <class Real>
+void Bp6SurfaceFireT<Real>::resetSiteInput()
 {
 	m_aspect				= 180.;
 	m_slopeFraction			= 0.;
@@ -785,7 +1027,8 @@ void Bp6SurfaceFire::resetSiteInput()
 	m_applyWindSpeedLimit	= true;
 }
 //------------------------------------------------------------------------------
-void Bp6SurfaceFire::resetSiteOutput()
+template <class Real>
+void Bp6SurfaceFireT<Real>::resetSiteOutput()
 {
 	m_rosHead = 0.;
     m_headDirFromUpslope = 0.;
@@ -816,16 +1059,19 @@ void Bp6SurfaceFire::resetSiteOutput()
 //------------------------------------------------------------------------------
 /*!	\brief Hook to derived class extensions.
 */
-void Bp6SurfaceFire::resetSiteOutputExtension()
+template <class Real>
+void Bp6SurfaceFireT<Real>::resetSiteOutputExtension()
 {
 }
 //------------------------------------------------------------------------------
-void Bp6SurfaceFire::resetTimeInput()
+template <class Real>
+void Bp6SurfaceFireT<Real>::resetTimeInput()
 {
 	m_elapsed = 0.;
 }
 //------------------------------------------------------------------------------
-void Bp6SurfaceFire::resetTimeOutput()
+template <class Real>
+void Bp6SurfaceFireT<Real>::resetTimeOutput()
 {
 	m_fireLength = 0.;
 	m_fireWidth = 0.;
@@ -836,22 +1082,99 @@ void Bp6SurfaceFire::resetTimeOutput()
 //------------------------------------------------------------------------------
 /*!	\brief Hook to derived class extensions.
 */
-void Bp6SurfaceFire::resetTimeOutputExtension()
+template <class Real>
+void Bp6SurfaceFireT<Real>::resetTimeOutputExtension()
 {
 }
 
 //------------------------------------------------------------------------------
-void Bp6SurfaceFire::setFuel(
-	double depth,		// fuel bed depth (ft)
-	double deadMext,	// fuel dead dead fuel moisture of extinction
+/*!	\brief Copies the fuel inputs and all the variables that depend only upon
+ *	them from another instance, so a fuel bed whose updateFuel() results
+ *	are already known need not be updated again.
+ *
+ *	Like setFuel(), this resets all the moisture and site outputs.
+ */
+template <class Real>
+void Bp6SurfaceFireT<Real>::copyFuel( const Bp6SurfaceFireT& other )
+{
+	resetMoistureOutput();
+	resetSiteOutput();
+	// fuel inputs
+	m_depth     = other.m_depth;
+	m_deadMext  = other.m_deadMext;
+	m_particles = other.m_particles;
+	m_kernelParts = other.m_kernelParts;
+	for( int p=0; p<MaxParts; p++ )
+	{
+		m_life[p] = other.m_life[p];
+		m_load[p] = other.m_load[p];
+		m_savr[p] = other.m_savr[p];
+		m_heat[p] = other.m_heat[p];
+		m_dens[p] = other.m_dens[p];
+		m_stot[p] = other.m_stot[p];
+		m_seff[p] = other.m_seff[p];
+		// fuel particle intermediates
+		m_area[p] = other.m_area[p];
+		m_aWtg[p] = other.m_aWtg[p];
+		m_sigK[p] = other.m_sigK[p];
+		m_size[p] = other.m_size[p];
+		m_sWtg[p] = other.m_sWtg[p];
+	}
+	// fuel life category intermediates
+	for ( int l=0; l<MaxCats; l++ )
+	{
+		m_lifeArea[l]  = other.m_lifeArea[l];
+		m_lifeAwtg[l]  = other.m_lifeAwtg[l];
+		m_lifeEtaS[l]  = other.m_lifeEtaS[l];
+		m_lifeFine[l]  = other.m_lifeFine[l];
+		m_lifeHeat[l]  = other.m_lifeHeat[l];
+		m_lifeLoad[l]  = other.m_lifeLoad[l];
+		m_lifeRxDry[l] = other.m_lifeRxDry[l];
+		m_lifeSavr[l]  = other.m_lifeSavr[l];
+		m_lifeSeff[l]  = other.m_lifeSeff[l];
+		m_lifeStot[l]  = other.m_lifeStot[l];
+		for ( int s=0; s<MaxSizes; s++ )
+		{
+			m_lifeSwtg[l][s] = other.m_lifeSwtg[l][s];
+		}
+	}
+	// fuel bed intermediates
+	m_aa           = other.m_aa;
+	m_betaOpt      = other.m_betaOpt;
+	m_betaRatio    = other.m_betaRatio;
+	m_bulkDensity  = other.m_bulkDensity;
+	m_c            = other.m_c;
+	m_e            = other.m_e;
+	m_epsilon      = other.m_epsilon;
+	m_gammaMax     = other.m_gammaMax;
+	m_gammaOpt     = other.m_gammaOpt;
+	m_liveMextK    = other.m_liveMextK;
+	m_packingRatio = other.m_packingRatio;
+	m_propFlux     = other.m_propFlux;
+	m_resTime      = other.m_resTime;
+	m_sigma        = other.m_sigma;
+	m_sigma15      = other.m_sigma15;
+	m_slopeK       = other.m_slopeK;
+	m_totalArea    = other.m_totalArea;
+	m_totalLoad    = other.m_totalLoad;
+	m_windB        = other.m_windB;
+	m_windE        = other.m_windE;
+	m_windK        = other.m_windK;
+}
+
+//------------------------------------------------------------------------------
+template <class Real>
+void Bp6SurfaceFireT<Real>::setFuel(
+	Real depth,		// fuel bed depth (ft)
+	Real deadMext,	// fuel dead dead fuel moisture of extinction
 	int    particles,	// number of particles in following arrays
 	int    *life,		// array of fuel particle life codes
-	double *load,		// array of fuel particle loads (lb/ft2)
-	double *savr,		// array of fuel aprticle surface area-to-volume rations (ft3/ft2)
-	double *heat,		// array of fuel particle low heat of combustions (btu/lb)
-	double *dens,		// array of fuel particle densities (lb/ft3)
-	double *stot,		// array of fuel particle total Silica contents (lb/lb)
-	double *seff )		// array of fuel particle effective Silica contents (lb/lb)
+	Real *load,		// array of fuel particle loads (lb/ft2)
+	Real *savr,		// array of fuel aprticle surface area-to-volume rations (ft3/ft2)
+	Real *heat,		// array of fuel particle low heat of combustions (btu/lb)
+	Real *dens,		// array of fuel particle densities (lb/ft3)
+	Real *stot,		// array of fuel particle total Silica contents (lb/lb)
+	Real *seff )		// array of fuel particle effective Silica contents (lb/lb)
 {
 	resetFuelOutput();
 	resetMoistureOutput();
@@ -869,6 +1192,13 @@ void Bp6SurfaceFire::setFuel(
 		m_stot[p] = stot[p];
 		m_seff[p] = seff[p];
 	}
+	// Trailing empty dead particles are left out of the kernels
+	m_kernelParts = m_particles;
+	while ( m_specialized && m_kernelParts > 0 && m_load[m_kernelParts-1] == 0.
+		&& fuelLife( m_life[m_kernelParts-1] ) == DeadCat )
+	{
+		m_kernelParts--;
+	}
 	updateFuel();
 }
 
@@ -877,9 +1207,10 @@ void Bp6SurfaceFire::setFuel(
  *	\param chaparralLiveMext Weise, et al. uses 0.65 for chamise and 0.74 for mixed brush.
  *	If liveMext is 0., then live fuel extinction moisture is calculated internally.
 */
-void Bp6SurfaceFire::setMoisture(
-		double* mois,// array of fuel particle moisture contents (lb/lb)
-		double chaparralLiveMext	// Rothermel & Philpot chaparral live mext
+template <class Real>
+void Bp6SurfaceFireT<Real>::setMoisture(
+		Real* mois,// array of fuel particle moisture contents (lb/lb)
+		Real chaparralLiveMext	// Rothermel & Philpot chaparral live mext
 	)
 {
 	resetMoistureOutput();
@@ -893,11 +1224,12 @@ void Bp6SurfaceFire::setMoisture(
 }
 
 //------------------------------------------------------------------------------
-void Bp6SurfaceFire::setSite(
-        double slopeFraction,			// terrain slope (rise/reach)
-		double aspect,					// degrees clockwise from north
-        double midflameWindSpeed,		// mid-flame wind speed (ft/min)
-        double windDirFromUpslope,		// wind heading direction (degrees clockwise from upslope)
+template <class Real>
+void Bp6SurfaceFireT<Real>::setSite(
+        Real slopeFraction,			// terrain slope (rise/reach)
+		Real aspect,					// degrees clockwise from north
+        Real midflameWindSpeed,		// mid-flame wind speed (ft/min)
+        Real windDirFromUpslope,		// wind heading direction (degrees clockwise from upslope)
 		bool   applyWindSpeedLimit )	// if TRUE, apply Rothermel's upper wind speed limit
 {
 	resetSiteOutput();
@@ -910,7 +1242,21 @@ void Bp6SurfaceFire::setSite(
 }
 
 //------------------------------------------------------------------------------
-void Bp6SurfaceFire::setTime( double elapsed )	// elapsed time since ignition (min)
+/*!	\brief Selects the fuel and moisture kernels specialized for the number of
+ *	particles (the default), or the generic kernel over all the particles.
+ *
+ *	The two give identical results; the generic kernel is kept for the
+ *	Bp6SurfaceFireBench comparison.  Applies from the next setFuel().
+ */
+template <class Real>
+void Bp6SurfaceFireT<Real>::setSpecializedKernels( bool specialized )
+{
+	m_specialized = specialized;
+}
+
+//------------------------------------------------------------------------------
+template <class Real>
+void Bp6SurfaceFireT<Real>::setTime( Real elapsed )	// elapsed time since ignition (min)
 {
 	resetTimeOutput();
 	m_elapsed = elapsed;
@@ -925,21 +1271,28 @@ void Bp6SurfaceFire::setTime( double elapsed )	// elapsed time since ignition (m
  *	and adds calculation of:
  *	- propagating flux
  *	- fire residence time.
+ *
+ *	Specialized at compile time for the common particle counts (see
+ *	updateFuel()), so the particle loops may be unrolled.
  */
-void Bp6SurfaceFire::updateFuel()
+template <class Real>
+template <int Parts>
+void Bp6SurfaceFireT<Real>::updateFuelKernel()
 {
+	// Parts is 0 for the generic kernel
+	const int n = Parts ? Parts : m_kernelParts;
 	// If no fuel bed depth, we're done
 	// If no fuel, or missing pointers, or no fuel bed depth, them we're done
-    if ( m_depth < m_smidgen  || m_particles < 1
+    if ( m_depth < m_smidgen  || n < 1
 		|| ! m_life || ! m_load || ! m_savr || ! m_heat || ! m_dens || ! m_stot || ! m_stot )
 	{
 		return;
 	}
 
 	// Savr by size class                 .04"  .25"  0.5"  1.0"  3.0"
-    static double Size_bdy[MaxSizes] = { 1200., 192., 96.0, 48.0, 16.0, 0. };
+    static Real Size_bdy[MaxSizes] = { 1200., 192., 96.0, 48.0, 16.0, 0. };
     // Determine particle area, savr exponent factor, and size class.
-    for ( int p=0; p<m_particles; p++ )
+    for ( int p=0; p<n; p++ )
     {
         // Accumulate fuel bed total load
         m_totalLoad += m_load[p];
@@ -978,14 +1331,14 @@ void Bp6SurfaceFire::updateFuel()
     m_slopeK = ( m_packingRatio < m_smidgen ) ? ( 0.0 ) : ( 5.275 * pow( m_packingRatio, -0.3 ) );
     // Surface area wtg factor for each particle within its life category
     // and within its size class category (used to weight loading).
-    for ( int p=0; p<m_particles; p++ )
+    for ( int p=0; p<n; p++ )
     {
         int l = fuelLife( m_life[p] );
         m_aWtg[p] = ( m_lifeArea[l] < m_smidgen ) ? ( 0.0 ) : ( m_area[p] / m_lifeArea[l] );
         m_lifeSwtg[l][m_size[p]] += m_aWtg[p];
     }
     // Assign size class surface area weights to each particle.
-    for ( int p=0; p<m_particles; p++ )
+    for ( int p=0; p<n; p++ )
     {
         int l = fuelLife( m_life[p] );
         m_sWtg[p] = m_lifeSwtg[l][m_size[p]];
@@ -997,7 +1350,7 @@ void Bp6SurfaceFire::updateFuel()
     }
     // Accumulate life category weighted load, savr, heat, seff, and stot,
     // and the particle's contribution to bulk density and packing ratio.
-    for ( int p=0; p<m_particles; p++ )
+    for ( int p=0; p<n; p++ )
     {
         int l = fuelLife( m_life[p] );
         m_lifeLoad[l] += m_sWtg[p] * m_load[p];
@@ -1044,7 +1397,7 @@ void Bp6SurfaceFire::updateFuel()
 			* m_lifeEtaS[l];
     }
     //  Mass of dead and live fuel that must be heated to ignition
-    for ( int p=0; p<m_particles; p++ )
+    for ( int p=0; p<n; p++ )
     {
         int l = fuelLife( m_life[p] );
         if ( l == DeadCat )
@@ -1078,14 +1431,20 @@ void Bp6SurfaceFire::updateFuel()
  *	- FBL_SurfaceFireReactionIntensity
  *	And adds calculation of:
  *	- no-wind, no-slope fire spread rate.
+ *
+ *	Specialized at compile time like updateFuelKernel().
  */
-void Bp6SurfaceFire::updateMoisture()
+template <class Real>
+template <int Parts>
+void Bp6SurfaceFireT<Real>::updateMoistureKernel()
 {
+	// Parts is 0 for the generic kernel
+	const int n = Parts ? Parts : m_kernelParts;
     int nLive = 0;
     // Compute category weighted moisture and accumulate the rbQig.
-	for ( int p=0; p<m_particles; p++ )
+	for ( int p=0; p<n; p++ )
     {
-        double qig = 250. + 1116. * m_mois[p];
+        Real qig = 250. + 1116. * m_mois[p];
         int lifeCat = fuelLife( m_life[p] );
         if ( lifeCat == DeadCat )
         {
@@ -1110,7 +1469,7 @@ void Bp6SurfaceFire::updateMoisture()
 	m_liveMextCalculated = m_deadMext;
     if ( nLive )
     {
-		double deadFine = m_lifeFine[DeadCat];
+		Real deadFine = m_lifeFine[DeadCat];
 		// Ratio of water mass to fuel mass that must be heated to ignition
 		// Used to derive the live fuel moisture content of extinction
         m_fdmois = ( deadFine < m_smidgen ) ? ( 0.0 ) : ( m_wfmd / deadFine );
@@ -1130,7 +1489,7 @@ void Bp6SurfaceFire::updateMoisture()
     //}
     
 	//  Moisture damping coefficient by life class.
-    double r;
+    Real r;
     if ( m_deadMext >= m_smidgen && ( ( r = m_deadMois / m_deadMext ) ) < 1. )
 	{
         m_deadEtaM = 1.0 - 2.59*r + 5.11*r*r - 3.52*r*r*r;
@@ -1149,6 +1508,44 @@ void Bp6SurfaceFire::updateMoisture()
 	// No-wind, no-slope spread rate
     m_ros0 = ( m_rbQig < m_smidgen ) ? ( 0.0 ) : ( m_totalRxInt * m_propFlux / m_rbQig );
 }
+
+//------------------------------------------------------------------------------
+/*!	\brief Updates all the variables that depend only upon fuel parameters
+ *	using the fuel kernel specialized for the number of particles.
+ *
+ *	Standard and custom fuel models have 6 particles (1-h, 10-h, and 100-h
+ *	dead, live herb, live wood, and dead herb), or 5 when there is no dead
+ *	herb, although EqCalc always passes all of its particle slots.  The
+ *	trailing empty dead particles contribute nothing to any sum, so
+ *	setFuel() leaves them out of m_kernelParts.
+ */
+template <class Real>
+void Bp6SurfaceFireT<Real>::updateFuel()
+{
+	switch ( m_specialized ? m_kernelParts : 0 )
+	{
+		case 4:  updateFuelKernel<4>(); break;
+		case 5:  updateFuelKernel<5>(); break;
+		case 6:  updateFuelKernel<6>(); break;
+		default: updateFuelKernel<0>(); break;
+	}
+}
+
+//------------------------------------------------------------------------------
+/*!	\brief Updates all variables that depend upon fuel and moisture parameters
+ *	using the moisture kernel specialized for the number of particles.
+ */
+template <class Real>
+void Bp6SurfaceFireT<Real>::updateMoisture()
+{
+	switch ( m_specialized ? m_kernelParts : 0 )
+	{
+		case 4:  updateMoistureKernel<4>(); break;
+		case 5:  updateMoistureKernel<5>(); break;
+		case 6:  updateMoistureKernel<6>(); break;
+		default: updateMoistureKernel<0>(); break;
+	}
+}
 //------------------------------------------------------------------------------
 /*!	\brief Updates all the variables that depend upon fuel, moisture, slope, and
  *	wind variables.
@@ -1161,28 +1558,29 @@ void Bp6SurfaceFire::updateMoisture()
  *	\par UNITS CHANGE!
  *	Effective wind speed and the wind speed limit are now in ft/min, NOT mi/h!
  */
-void Bp6SurfaceFire::updateSite( bool applyExtension )
+template <class Real>
+void Bp6SurfaceFireT<Real>::updateSite( bool applyExtension )
 {
     // Slope factor
-    double phiS  = m_slopeK * m_slopeFraction * m_slopeFraction;
+    Real phiS  = m_slopeK * m_slopeFraction * m_slopeFraction;
 
     // Wind factor
-    double windFpm = m_midflameWindSpeed;
-    double phiW  = ( windFpm < m_smidgen )
+    Real windFpm = m_midflameWindSpeed;
+    Real phiW  = ( windFpm < m_smidgen )
                  ? ( 0.0 )
                  : ( m_windK * pow( windFpm, m_windB ) );
 
     // Combined wind-slope factor
-    double phiEw = phiS + phiW;
+    Real phiEw = phiS + phiW;
 
     // Wind direction relative to upslope
-    double windDir = m_windDirFromUpslope;
+    Real windDir = m_windDirFromUpslope;
 
     // No-wind no-slope spread rate and parameters
-    double ros0      = m_ros0;
-    double rosMax    = ros0;
-    double dirMax    = 0.;
-    double effWind   = 0.;
+    Real ros0      = m_ros0;
+    Real rosMax    = ros0;
+    Real dirMax    = 0.;
+    Real effWind   = 0.;
     bool   doEffWind = false;
     bool   windLimitExceeded = false;
     int    situation = 0;
@@ -1237,20 +1635,20 @@ void Bp6SurfaceFire::updateSite( bool applyExtension )
     else
     {
         // Calculate spread rate in optimal direction.
-        double splitRad  = windDir * m_pi / 180.;
-        double slpRate   = ros0 * phiS;
-        double wndRate   = ros0 * phiW;
-        double x         = slpRate + wndRate * cos(splitRad);
-        double y         = wndRate * sin(splitRad);
-        double rv        = sqrt(x*x + y*y);
+        Real splitRad  = windDir * m_pi / 180.;
+        Real slpRate   = ros0 * phiS;
+        Real wndRate   = ros0 * phiW;
+        Real x         = slpRate + wndRate * cos(splitRad);
+        Real y         = wndRate * sin(splitRad);
+        Real rv        = sqrt(x*x + y*y);
         rosMax = ros0 + rv;
 
         // Recalculate phiEw in the optimal direction.
         phiEw     = ( ros0 < m_smidgen ) ? ( 0.0 ) : ( rosMax / ros0 - 1.0 );
         doEffWind = ( phiEw >= m_smidgen );
         // Recalculate direction of maximum spread in azimuth degrees.
-        double al = ( rv < m_smidgen ) ? ( 0.0 ) : ( asin( fabs( y ) / rv ) );
-        double a;
+        Real al = ( rv < m_smidgen ) ? ( 0.0 ) : ( asin( fabs( y ) / rv ) );
+        Real a;
         if ( x >= 0. )
         {
             a = ( y >= 0. ) ? ( al ) : ( m_pi + m_pi - al );
@@ -1274,7 +1672,7 @@ void Bp6SurfaceFire::updateSite( bool applyExtension )
                 : ( pow( ( phiEw * m_windE ), ( 1. / m_windB ) ) );
     }
     // If effective wind exceeds maximum wind, scale back spread & phiEw.
-    double maxWind = 0.9 * m_totalRxInt;
+    Real maxWind = 0.9 * m_totalRxInt;
     if ( effWind > maxWind )
     {
         windLimitExceeded = true;
@@ -1347,12 +1745,14 @@ void Bp6SurfaceFire::updateSite( bool applyExtension )
 //------------------------------------------------------------------------------
 /*!	\brief Hook into derived class extensions
  */
-void Bp6SurfaceFire::updateSiteExtension()
+template <class Real>
+void Bp6SurfaceFireT<Real>::updateSiteExtension()
 {}
 //------------------------------------------------------------------------------
 /*!	\brief Updates all the variables that depend upon elapsed time.
  */
-void Bp6SurfaceFire::updateTime( bool applyExtension )
+template <class Real>
+void Bp6SurfaceFireT<Real>::updateTime( bool applyExtension )
 {
 	m_fireLength = m_rosMajor * m_elapsed;
 	m_fireWidth = 2. * m_rosFlank * m_elapsed;
@@ -1368,7 +1768,8 @@ void Bp6SurfaceFire::updateTime( bool applyExtension )
 //------------------------------------------------------------------------------
 /*!	\brief Hook into derived class extensions
  */
-void Bp6SurfaceFire::updateTimeExtension()
+template <class Real>
+void Bp6SurfaceFireT<Real>::updateTimeExtension()
 {}
 
 //------------------------------------------------------------------------------
@@ -1378,7 +1779,8 @@ void Bp6SurfaceFire::updateTimeExtension()
 //------------------------------------------------------------------------------
 /*! \brief Constrains compass degrees to the range [0-360].
  */
-double Bp6SurfaceFire::constrainCompassDegrees( double degrees ) const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::constrainCompassDegrees( Real degrees ) const
 {
     while ( degrees > 360 )
     {
@@ -1390,9 +1792,10 @@ double Bp6SurfaceFire::constrainCompassDegrees( double degrees ) const
 //------------------------------------------------------------------------------
 /*! \brief Returns compass degrees (clockwise from north) from radians.
  */
-double Bp6SurfaceFire::calcDegrees( double radians ) const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::calcDegrees( Real radians ) const
 {
-    double degrees = radians * 180. / m_pi;
+    Real degrees = radians * 180. / m_pi;
 	return degrees;
 }
 
@@ -1401,11 +1804,12 @@ double Bp6SurfaceFire::calcDegrees( double radians ) const
  *	length-to-width ratio as per Rothermel (1991) equation 11 on page 16
  * (which ignores backing distance).
  */
-double Bp6SurfaceFire::calcEllipseArea(
-		double length,
-		double lwRatio ) const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::calcEllipseArea(
+		Real length,
+		Real lwRatio ) const
 {
-    double area = m_pi * length * length / ( 4. * lwRatio );
+    Real area = m_pi * length * length / ( 4. * lwRatio );
 	return area;
 }
 
@@ -1414,10 +1818,11 @@ double Bp6SurfaceFire::calcEllipseArea(
  *	\param lwRatio Ellipse length-to-width ratio.
  *	\return Ellipse eccentricity (dl).
  */
-double Bp6SurfaceFire::calcEllipseEccentricity( double lwRatio ) const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::calcEllipseEccentricity( Real lwRatio ) const
 {
-    double x = m_lwRatio * m_lwRatio - 1.0;
-	double eccent = ( x <= 0. ) ? 0. : ( sqrt( x ) / lwRatio );
+    Real x = m_lwRatio * m_lwRatio - 1.0;
+	Real eccent = ( x <= 0. ) ? 0. : ( sqrt( x ) / lwRatio );
 	return eccent;
 }
 
@@ -1427,10 +1832,11 @@ double Bp6SurfaceFire::calcEllipseEccentricity( double lwRatio ) const
  *	\param Effective wind speed (ft/min)
  *	\return Fire ellipse length-to-width ratio (dl).
  */
-double Bp6SurfaceFire::calcEllipseLengthToWidth( double effectiveWindSpeed ) const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::calcEllipseLengthToWidth( Real effectiveWindSpeed ) const
 {
-	double mph = effectiveWindSpeed / 88.;	// must be in mi/h
-	double ratio = 1. + 0.25 * mph;
+	Real mph = effectiveWindSpeed / 88.;	// must be in mi/h
+	Real ratio = 1. + 0.25 * mph;
 	return ratio;
 }
 
@@ -1440,15 +1846,16 @@ double Bp6SurfaceFire::calcEllipseLengthToWidth( double effectiveWindSpeed ) con
  *	\param lwRatio Ellipse length-to-width ratio (dl).
  *	\returns Ellipse perimeter (same units as \a length).
  */
-double Bp6SurfaceFire::calcEllipsePerimeter(
-		double length,
-		double width ) const
-{
-    double a = 0.5 * length;
-    double b = 0.5 * width;
-	double xm = ( ( a + b ) <= 0. ) ? 0. : ( ( a - b ) / ( a + b ) );
-    double xk = 1. + xm * xm / 4. + xm * xm * xm * xm / 64.;
-    double perim = m_pi * ( a + b ) * xk;
+template <class Real>
+Real Bp6SurfaceFireT<Real>::calcEllipsePerimeter(
+		Real length,
+		Real width ) const
+{
+    Real a = 0.5 * length;
+    Real b = 0.5 * width;
+	Real xm = ( ( a + b ) <= 0. ) ? 0. : ( ( a - b ) / ( a + b ) );
+    Real xk = 1. + xm * xm / 4. + xm * xm * xm * xm / 64.;
+    Real perim = m_pi * ( a + b ) * xk;
     return perim;
 }
 
@@ -1459,11 +1866,12 @@ double Bp6SurfaceFire::calcEllipsePerimeter(
  *	\param lwRatio Ellipse length-to-width ratio (dl).
  *	\returns Ellipse perimeter (same units as \a length).
  */
-double Bp6SurfaceFire::calcEllipsePerimeterRothermel(
-		double length,
-		double lwRatio ) const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::calcEllipsePerimeterRothermel(
+		Real length,
+		Real lwRatio ) const
 {
-    double perim = 0.5 * m_pi * length * ( 1. + 1. / lwRatio );
+    Real perim = 0.5 * m_pi * length * ( 1. + 1. / lwRatio );
 	return perim;
 }
 
@@ -1475,12 +1883,13 @@ double Bp6SurfaceFire::calcEllipsePerimeterRothermel(
  *	\param residenceTime Fire flaming front residence time (min)
  *	\return Byram's fireline intensity (btu/ft/s)
  */
-double Bp6SurfaceFire::calcFirelineIntensity(
-	double spreadRate,
-	double reactionIntensity,
-	double residenceTime ) const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::calcFirelineIntensity(
+	Real spreadRate,
+	Real reactionIntensity,
+	Real residenceTime ) const
 {
-	double fli = spreadRate * residenceTime * reactionIntensity / 60.;
+	Real fli = spreadRate * residenceTime * reactionIntensity / 60.;
 	return fli;
 }
 
@@ -1488,9 +1897,10 @@ double Bp6SurfaceFire::calcFirelineIntensity(
 /*!	\brief Returns the fireline intensity (btu/ft/s) given the flame length (ft)
  *	using Byram's (1959) equation.
  */
-double Bp6SurfaceFire::calcFirelineIntensityByram( double flameLength ) const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::calcFirelineIntensityByram( Real flameLength ) const
 {
-	double fli = ( flameLength <= 0.) ? 0. : pow( ( flameLength / 0.45 ), ( 1. / 0.46 ) );
+	Real fli = ( flameLength <= 0.) ? 0. : pow( ( flameLength / 0.45 ), ( 1. / 0.46 ) );
 	return fli;
 }
 
@@ -1498,27 +1908,30 @@ double Bp6SurfaceFire::calcFirelineIntensityByram( double flameLength ) const
 /*!	\brief Returns the fireline intensity (btu/ft/s) given the flame length (ft)
  *	using Thomas's (1963) equation.
  */
-double Bp6SurfaceFire::calcFirelineIntensityThomas( double flameLength ) const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::calcFirelineIntensityThomas( Real flameLength ) const
 {
-	double fli = ( flameLength <= 0.) ? 0. : pow( ( 5. * flameLength ), 1.5 );
+	Real fli = ( flameLength <= 0.) ? 0. : pow( ( 5. * flameLength ), 1.5 );
 	return fli;
 }
 
 //------------------------------------------------------------------------------
 /*!	\brief Returns Byram's (1959) flame length (ft) given a fireline intensity (Btu/ft/s).
  */
-double Bp6SurfaceFire::calcFlameLengthByram( double firelineIntensity ) const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::calcFlameLengthByram( Real firelineIntensity ) const
 {
-	double fl = ( firelineIntensity <= 0.) ? 0.0 : ( 0.45 * pow( firelineIntensity, 0.46 ) );
+	Real fl = ( firelineIntensity <= 0.) ? 0.0 : ( 0.45 * pow( firelineIntensity, 0.46 ) );
 	return fl;
 }
 
 //------------------------------------------------------------------------------
 /*!	\brief Returns Thomas's (1963) flame length (ft) given a fireline intensity (Btu/ft/s).
  */
-double Bp6SurfaceFire::calcFlameLengthThomas( double firelineIntensity ) const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::calcFlameLengthThomas( Real firelineIntensity ) const
 {
-	double fl = ( firelineIntensity <= 0.) ? 0.	: ( 0.2 * pow( firelineIntensity, (2./3.) ) );
+	Real fl = ( firelineIntensity <= 0.) ? 0.	: ( 0.2 * pow( firelineIntensity, (2./3.) ) );
 	return fl;
 }
 
@@ -1528,9 +1941,10 @@ double Bp6SurfaceFire::calcFlameLengthThomas( double firelineIntensity ) const
  *  \param residenceTime     Fire residence time (min).
  *  \return Fire's heat per unit area (Btu/ft2).
  */
-double Bp6SurfaceFire::calcHeatPerUnitArea(
-		double reactionIntensity,
-		double residenceTime ) const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::calcHeatPerUnitArea(
+		Real reactionIntensity,
+		Real residenceTime ) const
 {
     return( reactionIntensity * residenceTime );
 }
@@ -1540,9 +1954,10 @@ double Bp6SurfaceFire::calcHeatPerUnitArea(
  *  \param moistureContent Live herbaceous fuel moisture content (fraction).
  *  \return Fraction [0..1] of live herbaceous fuel that is cured.
  */
-double Bp6SurfaceFire::calcHerbaceousFuelLoadCuredFraction( double moistureContent ) const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::calcHerbaceousFuelLoadCuredFraction( Real moistureContent ) const
 {
-    double fraction = 1.333 - 1.11 * moistureContent;
+    Real fraction = 1.333 - 1.11 * moistureContent;
     fraction = ( fraction < 0.0 ) ? 0.0 : fraction;
     fraction = ( fraction > 1.0 ) ? 1.0 : fraction;
     return( fraction );
@@ -1551,9 +1966,10 @@ double Bp6SurfaceFire::calcHerbaceousFuelLoadCuredFraction( double moistureConte
 //------------------------------------------------------------------------------
 /*! \brief Returns radians of the compass degrees (clockwise from north).
  */
-double Bp6SurfaceFire::calcRadians( double degrees ) const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::calcRadians( Real degrees ) const
 {
-    double radians = degrees * m_pi / 180.;
+    Real radians = degrees * m_pi / 180.;
 	return radians;
 }
 
@@ -1563,12 +1979,13 @@ double Bp6SurfaceFire::calcRadians( double degrees ) const
  *	\param Fire ellipse length-to-width ratio (dl).
  *  \return Fire spread rate at the back of the ellipse (ft/min).
  */
-double Bp6SurfaceFire::calcSpreadRateAtBack(
-		double rosHead,
-		double lwRatio ) const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::calcSpreadRateAtBack(
+		Real rosHead,
+		Real lwRatio ) const
 {
-	double eccent = calcEllipseEccentricity( lwRatio );
-    double rosBack = rosHead * ( 1. - eccent ) / ( 1. + eccent );
+	Real eccent = calcEllipseEccentricity( lwRatio );
+    Real rosBack = rosHead * ( 1. - eccent ) / ( 1. + eccent );
 	return rosBack;
 }
 
@@ -1580,18 +1997,19 @@ double Bp6SurfaceFire::calcSpreadRateAtBack(
  *  \param beta Fire spread vector of interest (degrees clockwise from heading direction).
  *  \return Fire spread rate along the specified vector (ft/min).
  */
-double Bp6SurfaceFire::calcSpreadRateAtBeta(
-		double rosHead,
-		double lwRatio,
-        double beta ) const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::calcSpreadRateAtBeta(
+		Real rosHead,
+		Real lwRatio,
+        Real beta ) const
 {
-    double rosBeta = rosHead;
+    Real rosBeta = rosHead;
     // Calculate the fire spread rate in this azimuth
     // if it deviates more than a tenth degree from the maximum azimuth
     if ( fabs( beta ) > 0.1 )
     {
-        double radians = calcRadians( beta );
-		double eccent = calcEllipseEccentricity( lwRatio );
+        Real radians = calcRadians( beta );
+		Real eccent = calcEllipseEccentricity( lwRatio );
         rosBeta = rosHead * ( 1. - eccent ) / ( 1. - eccent * cos( radians ) );
     }
     return rosBeta;
@@ -1604,15 +2022,22 @@ double Bp6SurfaceFire::calcSpreadRateAtBeta(
  *  \return Fire spread rate at the the widest point of the ellipse (ft/min).
  *	Double this result for the elliptical width expansion rate.
  */
-double Bp6SurfaceFire::calcSpreadRateAtFlank(
-		double rosHead,
-		double lwRatio ) const
+template <class Real>
+Real Bp6SurfaceFireT<Real>::calcSpreadRateAtFlank(
+		Real rosHead,
+		Real lwRatio ) const
 {
 	// Spread rate at ellipse back
-    double rosBack = calcSpreadRateAtBack( rosHead, lwRatio );
+    Real rosBack = calcSpreadRateAtBack( rosHead, lwRatio );
 	// Spread rate along ellipse major axis
-	double rosMajor = rosHead + rosBack;
+	Real rosMajor = rosHead + rosBack;
 	// Spread rate along the ellipse minor axis (flank)
-	double rosFlank = 0.5 * rosMajor / lwRatio;
+	Real rosFlank = 0.5 * rosMajor / lwRatio;
 	return rosFlank;
 }
+
+//------------------------------------------------------------------------------
+// The double fire model, and the Bp6Dual fire model that also carries the
+// derivatives of every variable.
+template class Bp6SurfaceFireT<double>;
+template class Bp6SurfaceFireT<Bp6Dual>;
@@ -1,7 +1,14 @@
 #ifndef BP6_SURFACE_FIRE_H
 #define BP6_SURFACE_FIRE_H
 
-class Bp6SurfaceFire
+/*!	\class Bp6SurfaceFireT
+ *	\brief Rothermel (1972) surface fire spread model.
+ *
+ *	Templated on its scalar type so Bp6SurfaceFireT<Bp6Dual> can carry
+ *	derivatives; Bp6SurfaceFire is the double version.
+ */
+template <class Real>
+class Bp6SurfaceFireT
 {
 public:
 	static const int DeadCat = 0;
@@ -10,189 +17,207 @@ public:
 	static const int MaxParts = 20;
 	static const int MaxSizes = 6;
 
-	Bp6SurfaceFire();
-	virtual ~Bp6SurfaceFire();
+	Bp6SurfaceFireT();
+	virtual ~Bp6SurfaceFireT();
 
 	// Fuel particle member variable accessors
-	double getDeadMext() const;
-	double getDepth() const;
+	Real   getDeadMext() const;
+	Real   getDepth() const;
 	int    getParticles() const;
-	double getParticleArea( int particleIndex ) const;
-	double getParticleAwtg( int particleIndex ) const;
-	double getParticleDens( int particleIndex ) const;
-	double getParticleHeat( int particleIndex ) const;
+	Real   getParticleArea( int particleIndex ) const;
+	Real   getParticleAwtg( int particleIndex ) const;
+	Real   getParticleDens( int particleIndex ) const;
+	Real   getParticleHeat( int particleIndex ) const;
 	int    getParticleLife( int particleIndex ) const;
-	double getParticleLoad( int particleIndex ) const;
-	double getParticleSavr( int particleIndex ) const;
-	double getParticleSeff( int particleIndex ) const;
-	double getParticleSigK( int particleIndex ) const;
+	Real   getParticleLoad( int particleIndex ) const;
+	Real   getParticleSavr( int particleIndex ) const;
+	Real   getParticleSeff( int particleIndex ) const;
+	Real   getParticleSigK( int particleIndex ) const;
 	int    getParticleSize( int particleIndex ) const;
-	double getParticleStot( int particleIndex ) const;
-	double getParticleSwtg( int particleIndex ) const;
+	Real   getParticleStot( int particleIndex ) const;
+	Real   getParticleSwtg( int particleIndex ) const;
 
 	// Fuel life category member variable accessors
-	double getLifeArea( int lifeCat ) const;
-	double getLifeAwtg( int lifeCat ) const;
-	double getLifeEtaS( int lifeCat ) const;
-	double getLifeFine( int lifeCat ) const;
-	double getLifeHeat( int lifeCat ) const;
-	double getLifeLoad( int lifeCat ) const;
-	double getLifeRxDry( int lifeCat ) const;
-	double getLifeSavr( int lifeCat ) const;
-	double getLifeSeff( int lifeCat ) const;
-	double getLifeStot( int lifeCat ) const;
-	double getLifeSwtg( int lifeCat, int size ) const;
+	Real   getLifeArea( int lifeCat ) const;
+	Real   getLifeAwtg( int lifeCat ) const;
+	Real   getLifeEtaS( int lifeCat ) const;
+	Real   getLifeFine( int lifeCat ) const;
+	Real   getLifeHeat( int lifeCat ) const;
+	Real   getLifeLoad( int lifeCat ) const;
+	Real   getLifeRxDry( int lifeCat ) const;
+	Real   getLifeSavr( int lifeCat ) const;
+	Real   getLifeSeff( int lifeCat ) const;
+	Real   getLifeStot( int lifeCat ) const;
+	Real   getLifeSwtg( int lifeCat, int size ) const;
 
 	// Fuel bed member variable accessors
-	double getAa() const;
-	double getBetaRatio() const;
-	double getBulkDensity() const;
-	double getC() const;
-	double getE() const;
-	double getEffectiveHeatingNumber() const;
-	double getGammaMax() const;
-	double getGammaOpt() const;
-	double getLiveMextK() const;
-	double getOptimumPackingRatio() const;
-	double getPackingRatio() const;
-	double getPropagatingFlux() const;
-	double getResidenceTime() const;
-	double getSigma() const;
-	double getSigma15() const;
-	double getSlopeK() const;
-	double getTotalArea() const;
-	double getTotalLoad() const;
-	double getWindB() const;
-	double getWindE() const;
-	double getWindK() const;
+	Real   getAa() const;
+	Real   getBetaRatio() const;
+	Real   getBulkDensity() const;
+	Real   getC() const;
+	Real   getE() const;
+	Real   getEffectiveHeatingNumber() const;
+	Real   getGammaMax() const;
+	Real   getGammaOpt() const;
+	Real   getLiveMextK() const;
+	Real   getOptimumPackingRatio() const;
+	Real   getPackingRatio() const;
+	Real   getPropagatingFlux() const;
+	Real   getResidenceTime() const;
+	Real   getSigma() const;
+	Real   getSigma15() const;
+	Real   getSlopeK() const;
+	Real   getTotalArea() const;
+	Real   getTotalLoad() const;
+	Real   getWindB() const;
+	Real   getWindE() const;
+	Real   getWindK() const;
 
 	// Fuel moisture input accessors
-	double getMois( int particleIndex ) const;
+	Real   getMois( int particleIndex ) const;
 
 	// Fuel moisture dependent member variable accessors
-	double getDeadMois() const;
-	double getDeadRxDry() const;
-	double getFdMois() const;
-	double getHeatSink() const;
-	double getLifeMext( int lifeCat ) const;
-	double getLifeMois( int lifeCat ) const;
-	double getLiveMextApplied() const;
-	double getLiveMextCalculated() const;
-	double getLiveMextChaparral() const;
-	double getLiveMois() const;
-	double getLiveRxDry() const;
-	double getRbQig() const;
-	double getWfmd() const;
-	double getDeadEtaM() const;
-	double getDeadRxInt() const;
-	double getLiveEtaM() const;
-	double getLiveRxInt() const;
-	double getTotalRxInt() const;
-	double getNoWindNoSlopeSpreadRate() const;
+	Real   getDeadMois() const;
+	Real   getDeadRxDry() const;
+	Real   getFdMois() const;
+	Real   getHeatSink() const;
+	Real   getLifeMext( int lifeCat ) const;
+	Real   getLifeMois( int lifeCat ) const;
+	Real   getLiveMextApplied() const;
+	Real   getLiveMextCalculated() const;
+	Real   getLiveMextChaparral() const;
+	Real   getLiveMois() const;
+	Real   getLiveRxDry() const;
+	Real   getRbQig() const;
+	Real   getWfmd() const;
+	Real   getDeadEtaM() const;
+	Real   getDeadRxInt() const;
+	Real   getLiveEtaM() const;
+	Real   getLiveRxInt() const;
+	Real   getTotalRxInt() const;
+	Real   getNoWindNoSlopeSpreadRate() const;
 
 	// Fire site input member variable accessors
-	double getAspect() const ;
+	Real   getAspect() const ;
 	bool   getApplyWindSpeedLimit() const;
-	double getMidflameWindSpeed() const ;
-	double getSlopeFraction() const ;
-	double getWindDirFromUpslope() const;
+	Real   getMidflameWindSpeed() const ;
+	Real   getSlopeFraction() const ;
+	Real   getWindDirFromUpslope() const;
 
 	// Fire site dependent member variable accessors
-	double getEccentricity() const;
-	double getEffectiveWindSpeed() const;
-	double getEffectiveWindSpeedAtVector( double vectorRos ) const;
-	double getFirelineIntensityAtBack() const;
-	double getFirelineIntensityAtFlank() const;
-	double getFirelineIntensityAtHead() const;
-	double getFlameLengthAtBack() const;
-	double getFlameLengthAtFlank() const;
-	double getFlameLengthAtHead() const;
-	double getHeadDirFromUpslope() const;
-	double getHeatPerUnitArea() const;
-	double getLengthToWidthRatio() const;
+	Real   getEccentricity() const;
+	Real   getEffectiveWindSpeed() const;
+	Real   getEffectiveWindSpeedAtVector( Real vectorRos ) const;
+	Real   getFirelineIntensityAtBack() const;
+	Real   getFirelineIntensityAtFlank() const;
+	Real   getFirelineIntensityAtHead() const;
+	Real   getFlameLengthAtBack() const;
+	Real   getFlameLengthAtFlank() const;
+	Real   getFlameLengthAtHead() const;
+	Real   getHeadDirFromUpslope() const;
+	Real   getHeatPerUnitArea() const;
+	Real   getLengthToWidthRatio() const;
 	int    getSituation() const;
-	double getSlopeFactor() const;
+	Real   getSlopeFactor() const;
 	bool   getSpreadRateExceedsWindSpeed() const;
-	double getSpreadRateAtBack() const;
-	double getSpreadRateAtBeta( double beta ) const;
-	double getSpreadRateAtHead() const;
-	double getSpreadRateAtFlank() const;
-	double getSpreadRateAtMajorAxis() const;
-	double getWindFactor() const;
+	Real   getSpreadRateAtBack() const;
+	Real   getSpreadRateAtBeta( Real beta ) const;
+	void   getSpreadProfileAtBeta( int directions, Real* ros,
+				Real* fli=0, Real* flame=0 ) const;
+	void   getSpreadProfileAtPsi( int directions, Real* ros,
+				Real* fli=0, Real* flame=0 ) const;
+	Real   getSpreadRateAtHead() const;
+	Real   getSpreadRateAtFlank() const;
+	Real   getSpreadRateAtMajorAxis() const;
+	Real   getWindFactor() const;
 	bool   getWindLimitExceeded() const;
-	double getWindSlopeFactor() const;
-	double getWindSpeedLimit() const;
+	Real   getWindSlopeFactor() const;
+	Real   getWindSpeedLimit() const;
 
 	// Fire time dependent member variable accessors
-	double getFireAcres() const;
-	double getFireArea() const;
-	double getFireLength() const;
-	double getFirePerimeter() const;
-	double getFireWidth() const;
+	Real   getFireAcres() const;
+	Real   getFireArea() const;
+	Real   getFireLength() const;
+	Real   getFirePerimeter() const;
+	Real   getFireWidth() const;
 
-	double getRsa( double midflameWindSpeed );
+	Real   getRsa( Real midflameWindSpeed );
+	bool   isSameFuel(
+		Real   depth,
+		Real   deadMext,
+		int    particles,
+		int    *life,
+		Real   *load,
+		Real   *savr,
+		Real   *heat,
+		Real   *dens,
+		Real   *stot,
+		Real   *seff ) const;
 
 	// Mutators
+	virtual void copyFuel( const Bp6SurfaceFireT& other );
 	virtual void setFuel(
-		double depth,		// ft
-		double deadMext,	// lb/lb
+		Real   depth,		// ft
+		Real   deadMext,	// lb/lb
 		int    particles,	// count
 		int    *life,
-		double *load,
-		double *savr,
-		double *heat,
-		double *dens,
-		double *stot,
-		double *seff );
+		Real   *load,
+		Real   *savr,
+		Real   *heat,
+		Real   *dens,
+		Real   *stot,
+		Real   *seff );
 
 	virtual void setMoisture(
-		double* mois,
-		double  liveMextChaparral=0. );
+		Real* mois,
+		Real    liveMextChaparral=0. );
 
 	virtual void setSite(
-        double slopeFraction,			// rise/reach
-		double aspect,					// degrees clockwise from north
-        double midflameWindSpeed,		// ft/min
-        double windDirFromUpslope,		// degrees clockwise from North
+        Real   slopeFraction,			// rise/reach
+		Real   aspect,					// degrees clockwise from north
+        Real   midflameWindSpeed,		// ft/min
+        Real   windDirFromUpslope,		// degrees clockwise from North
 		bool   applyWindSpeedLimit );
 
-	virtual void setTime( double elapsed );
+	void setSpecializedKernels( bool specialized );
+
+	virtual void setTime( Real elapsed );
 
 	// Possibly static methods
-	double constrainCompassDegrees( double degrees ) const;
-	double calcDegrees( double radians ) const;
-	double calcEllipseArea( double length, double lwRatio ) const;
-	double calcEllipseEccentricity( double lwRatio ) const;
-	double calcEllipseLengthToWidth( double effectiveWindSpeed ) const;
-	double calcEllipsePerimeter(
-		double length,
-		double width ) const;
-	double calcEllipsePerimeterRothermel(
-		double length,
-		double width ) const;
-	double calcFirelineIntensity(
-		double spreadRate,
-		double reactionIntensity,
-		double residenceTime ) const;
-	double calcFirelineIntensityByram( double flameLength ) const;
-	double calcFirelineIntensityThomas( double flameLength ) const;
-	double calcFlameLengthByram( double firelineIntensity ) const;
-	double calcFlameLengthThomas( double firelineIntensity ) const;
-	double calcHeatPerUnitArea(
-		double reactionIntensity,
-		double residenceTime ) const;
-	double calcHerbaceousFuelLoadCuredFraction( double moistureContent ) const;
-	double calcRadians( double degrees ) const;
-	double calcSpreadRateAtBack(
-		double rosHead,
-		double eccent ) const;
-	double calcSpreadRateAtBeta(
-		double rosHead,
-		double lwRatio,
-        double beta ) const;
-	double calcSpreadRateAtFlank(
-		double rosHead,
-		double lwRatio ) const;
+	Real   constrainCompassDegrees( Real degrees ) const;
+	Real   calcDegrees( Real radians ) const;
+	Real   calcEllipseArea( Real length, Real lwRatio ) const;
+	Real   calcEllipseEccentricity( Real lwRatio ) const;
+	Real   calcEllipseLengthToWidth( Real effectiveWindSpeed ) const;
+	Real   calcEllipsePerimeter(
+		Real   length,
+		Real   width ) const;
+	Real   calcEllipsePerimeterRothermel(
+		Real   length,
+		Real   width ) const;
+	Real   calcFirelineIntensity(
+		Real   spreadRate,
+		Real   reactionIntensity,
+		Real   residenceTime ) const;
+	Real   calcFirelineIntensityByram( Real flameLength ) const;
+	Real   calcFirelineIntensityThomas( Real flameLength ) const;
+	Real   calcFlameLengthByram( Real firelineIntensity ) const;
+	Real   calcFlameLengthThomas( Real firelineIntensity ) const;
+	Real   calcHeatPerUnitArea(
+		Real   reactionIntensity,
+		Real   residenceTime ) const;
+	Real   calcHerbaceousFuelLoadCuredFraction( Real moistureContent ) const;
+	Real   calcRadians( Real degrees ) const;
+	Real   calcSpreadRateAtBack(
+		Real   rosHead,
+		Real   eccent ) const;
+	Real   calcSpreadRateAtBeta(
+		Real   rosHead,
+		Real   lwRatio,
+        Real   beta ) const;
+	Real   calcSpreadRateAtFlank(
+		Real   rosHead,
+		Real   lwRatio ) const;
 
 protected:
 	int  fuelLife( int lifeCode );
@@ -208,6 +233,8 @@ protected:
 	virtual void resetTimeOutputExtension();
 	virtual void updateFuel();
 	virtual void updateMoisture();
+	template <int Parts> void updateFuelKernel();
+	template <int Parts> void updateMoistureKernel();
 	virtual void updateSite( bool applyExtension=true );
 	virtual void updateSiteExtension();	// Hook for crown fire to update m_activeCrownFireRos
 	virtual void updateTime( bool applyExtension=true );
@@ -215,114 +242,118 @@ protected:
 
 protected:
 	// constants
-	double	m_pi;					// close to diameter / radius
-	double	m_smidgen;				// close to zero
-	double	m_infinity;				// close to infinity
+	Real	m_pi;					// close to diameter / radius
+	Real	m_smidgen;				// close to zero
+	Real	m_infinity;				// close to infinity
 	// fuel inputs
-	double m_depth;					// fuel bed depth (ft)
-	double m_deadMext;				// fuel bed dead fuel moisture of extinction (lb water / lb ovendry fuel)
+	Real   m_depth;					// fuel bed depth (ft)
+	Real   m_deadMext;				// fuel bed dead fuel moisture of extinction (lb water / lb ovendry fuel)
 	int	   m_particles;				// fuel bed number of fuel particle types
+	int    m_kernelParts;			// number of leading particles used by the fuel and moisture kernels
+	bool   m_specialized;			// use the kernels specialized for m_kernelParts (false forces the generic kernel)
 	int    m_life[MaxParts];		// fuel particle life category (DeadCat or LiveCat)
-	double m_load[MaxParts];		// fuel particle ovendry load (lb/ft2)
-	double m_savr[MaxParts];		// fuel particle surface area-to-volume ratio (ft3/ft2)
-	double m_heat[MaxParts];		// fuel particle low heat of combustion (btu/lb)
-	double m_dens[MaxParts];		// fuel particle density (lb/ft3)
-	double m_stot[MaxParts];		// fuel particle total Silica content (lb si / lb fuel)
-	double m_seff[MaxParts];		// fuel particle effective silica content (lb si / lb fuel)
+	Real   m_load[MaxParts];		// fuel particle ovendry load (lb/ft2)
+	Real   m_savr[MaxParts];		// fuel particle surface area-to-volume ratio (ft3/ft2)
+	Real   m_heat[MaxParts];		// fuel particle low heat of combustion (btu/lb)
+	Real   m_dens[MaxParts];		// fuel particle density (lb/ft3)
+	Real   m_stot[MaxParts];		// fuel particle total Silica content (lb si / lb fuel)
+	Real   m_seff[MaxParts];		// fuel particle effective silica content (lb si / lb fuel)
     // fuel particle intermediates
-    double m_area[MaxParts];		// fuel particle surface area (ft2)
-	double m_aWtg[MaxParts];		// fuel particle surface area weighting factor (dl)
-	double m_sigK[MaxParts];		// fuel particle effective heating number (dl)
+    Real   m_area[MaxParts];		// fuel particle surface area (ft2)
+	Real   m_aWtg[MaxParts];		// fuel particle surface area weighting factor (dl)
+	Real   m_sigK[MaxParts];		// fuel particle effective heating number (dl)
     int    m_size[MaxParts];		// fuel particle sie class (index)
-    double m_sWtg[MaxParts];		// fuel particle fuel load weighting factor for its size class (dl)
+    Real   m_sWtg[MaxParts];		// fuel particle fuel load weighting factor for its size class (dl)
     // fuel life category intermediates.
-    double m_lifeArea[MaxCats];		// life category surface area (ft2)
-	double m_lifeAwtg[MaxCats];		// life category surface area weighting factor (dl)
-    double m_lifeEtaS[MaxCats];		// life category Silica damping coefficient (dl)
-	double m_lifeFine[MaxCats];		//
-    double m_lifeHeat[MaxCats];		// life category weighted heat of combustion (btu/lb)
-    double m_lifeLoad[MaxCats];		// life category fuel load (lb/ft2)
-	double m_lifeRxDry[MaxCats];	// life category reaction intensity WITHOUT moisture damping (btu/ft/min)
-    double m_lifeSavr[MaxCats];		// life category weighted surface area-to-volume ration (ft3/ft2)
-    double m_lifeSeff[MaxCats];		// life category weighted effective SIlica content (lb Si / lb fuel)
-    double m_lifeStot[MaxCats];		// life category weighted total Silica content (lb Si / lb fuel )
-    double m_lifeSwtg[MaxCats][MaxSizes];	// life category fuel load weighting factors by size class
+    Real   m_lifeArea[MaxCats];		// life category surface area (ft2)
+	Real   m_lifeAwtg[MaxCats];		// life category surface area weighting factor (dl)
+    Real   m_lifeEtaS[MaxCats];		// life category Silica damping coefficient (dl)
+	Real   m_lifeFine[MaxCats];		//
+    Real   m_lifeHeat[MaxCats];		// life category weighted heat of combustion (btu/lb)
+    Real   m_lifeLoad[MaxCats];		// life category fuel load (lb/ft2)
+	Real   m_lifeRxDry[MaxCats];	// life category reaction intensity WITHOUT moisture damping (btu/ft/min)
+    Real   m_lifeSavr[MaxCats];		// life category weighted surface area-to-volume ration (ft3/ft2)
+    Real   m_lifeSeff[MaxCats];		// life category weighted effective SIlica content (lb Si / lb fuel)
+    Real   m_lifeStot[MaxCats];		// life category weighted total Silica content (lb Si / lb fuel )
+    Real   m_lifeSwtg[MaxCats][MaxSizes];	// life category fuel load weighting factors by size class
     // fuel bed intermediates
-	double m_aa;					// arbitrary variable 'A' used to derive gammaOpt (dl) [eq 39, p 19]
-	double m_betaOpt;				// optium packing ratio (dl) [eq 37]
-    double m_betaRatio;				// packing ratio / optimum packing ratio
-    double m_bulkDensity;			// fuel bed bulk density (lb/ft3) [eq 40]
-	double m_c;						// wind coefficient correlation parameter 'C' (dl) [eq 48, p23]
-	double m_e;						// wind coefficient correlation parameter 'E' (dl) [eq 50, p23]
-	double m_epsilon;				// fuel bed effective heating number (dl) [eq 14]
-	double m_gammaMax;				// maximum reaction velocity (1/min) [eq 36]
-	double m_gammaOpt;				// optimum reaction velocity (1/min) [eq 38]
-	double m_liveMextK;
-    double m_packingRatio;			// fuel bed packing ratio (dl)
-	double m_propFlux;				// propagating flux ratio (dl) [eq 42]
-	double m_resTime;				// flame residence time (min)
-    double m_sigma;					// fuel bed characteristic surface area-to-volume ratio (ft3/ft2)
-	double m_sigma15;				// pow( sigma, 1.5)
-	double m_slopeK;				// factor used to derive the slope coefficient (dl) [from eq 51]
-    double m_totalArea;				// fuel bed total surface area (ft2)
-    double m_totalLoad;				// fuel bed total load (lb/ft2)
-	double m_windB;					// wind coefficient correlation parameter 'C' [eq 49, p23]
-	double m_windE;					// inverse factor of m_windK (dl) [from eq 47]
-	double m_windK;					// factor used to derive the wind coefficient (dl) [from eq 47]
+	Real   m_aa;					// arbitrary variable 'A' used to derive gammaOpt (dl) [eq 39, p 19]
+	Real   m_betaOpt;				// optium packing ratio (dl) [eq 37]
+    Real   m_betaRatio;				// packing ratio / optimum packing ratio
+    Real   m_bulkDensity;			// fuel bed bulk density (lb/ft3) [eq 40]
+	Real   m_c;						// wind coefficient correlation parameter 'C' (dl) [eq 48, p23]
+	Real   m_e;						// wind coefficient correlation parameter 'E' (dl) [eq 50, p23]
+	Real   m_epsilon;				// fuel bed effective heating number (dl) [eq 14]
+	Real   m_gammaMax;				// maximum reaction velocity (1/min) [eq 36]
+	Real   m_gammaOpt;				// optimum reaction velocity (1/min) [eq 38]
+	Real   m_liveMextK;
+    Real   m_packingRatio;			// fuel bed packing ratio (dl)
+	Real   m_propFlux;				// propagating flux ratio (dl) [eq 42]
+	Real   m_resTime;				// flame residence time (min)
+    Real   m_sigma;					// fuel bed characteristic surface area-to-volume ratio (ft3/ft2)
+	Real   m_sigma15;				// pow( sigma, 1.5)
+	Real   m_slopeK;				// factor used to derive the slope coefficient (dl) [from eq 51]
+    Real   m_totalArea;				// fuel bed total surface area (ft2)
+    Real   m_totalLoad;				// fuel bed total load (lb/ft2)
+	Real   m_windB;					// wind coefficient correlation parameter 'C' [eq 49, p23]
+	Real   m_windE;					// inverse factor of m_windK (dl) [from eq 47]
+	Real   m_windK;					// factor used to derive the wind coefficient (dl) [from eq 47]
 	// fuel moisture inputs
-	double m_mois[MaxParts];		// fuel particle moisture content (lb water / lb ovendry fuel)
+	Real   m_mois[MaxParts];		// fuel particle moisture content (lb water / lb ovendry fuel)
 	// fuel moisture outputs
-    double m_rbQig;					// fuel bed heat sink (btu/ft3)
-    double m_fdmois;
-    double m_wfmd;
-	double m_deadMois;				// fuel bed weighted dead fuel moisture content (lb water / lb dead fuel)
-	double m_liveMois;				// fuel bed weighted live fuel moisture content (lb water / lb live fuel)
-	double m_liveMextApplied;		// live fuel moisture of extinction (lb/lb)
-	double m_liveMextCalculated;	// live fuel moisture of extinction (lb/lb)
-	double m_liveMextChaparral;		// live fuel moisture of extinction (lb/lb)
-    double m_deadEtaM;				// dead fuel moisture damping coefficient (dl) [eq 29]
-	double m_deadRxInt;				// dead fuel reaction intensity (btu/ft2/min) [eq 27]
-	double m_liveEtaM;				// live fuel moisture damping coefficient (dl) [eq 29]
-	double m_liveRxInt;				// live fuel reaction intensity [btu/ft2/min] [eq 27]
-	double m_totalRxInt;			// total reaction intensity (btu/ft2/min)
-	double m_ros0;					// no-wind, no-slope fire spread rate (ft/min)
+    Real   m_rbQig;					// fuel bed heat sink (btu/ft3)
+    Real   m_fdmois;
+    Real   m_wfmd;
+	Real   m_deadMois;				// fuel bed weighted dead fuel moisture content (lb water / lb dead fuel)
+	Real   m_liveMois;				// fuel bed weighted live fuel moisture content (lb water / lb live fuel)
+	Real   m_liveMextApplied;		// live fuel moisture of extinction (lb/lb)
+	Real   m_liveMextCalculated;	// live fuel moisture of extinction (lb/lb)
+	Real   m_liveMextChaparral;		// live fuel moisture of extinction (lb/lb)
+    Real   m_deadEtaM;				// dead fuel moisture damping coefficient (dl) [eq 29]
+	Real   m_deadRxInt;				// dead fuel reaction intensity (btu/ft2/min) [eq 27]
+	Real   m_liveEtaM;				// live fuel moisture damping coefficient (dl) [eq 29]
+	Real   m_liveRxInt;				// live fuel reaction intensity [btu/ft2/min] [eq 27]
+	Real   m_totalRxInt;			// total reaction intensity (btu/ft2/min)
+	Real   m_ros0;					// no-wind, no-slope fire spread rate (ft/min)
 	// site (terrain and weather) inputs
-    double m_slopeFraction;			// terrain slope (rise/reach)
-	double m_aspect;				// terrain aspect (down slope direction) (degrees clockwise from north)
-    double m_midflameWindSpeed;		// midflame wind speed (ft/min)
-    double m_windDirFromUpslope;	// compass degrees clockwise from north
+    Real   m_slopeFraction;			// terrain slope (rise/reach)
+	Real   m_aspect;				// terrain aspect (down slope direction) (degrees clockwise from north)
+    Real   m_midflameWindSpeed;		// midflame wind speed (ft/min)
+    Real   m_windDirFromUpslope;	// compass degrees clockwise from north
 	bool   m_applyWindSpeedLimit;	//
 	// site (terrain and weather) outputs
-	double m_rosHead;				// surface fire rate of spread at fire head (ft/min)
-    double m_headDirFromUpslope;	// direction of maximum spread (head direction, degrees clowise from north)
-    double m_effectiveWindSpeed;	// effective wind speed (ft/min)
-    double m_windSpeedLimit;		// upper wind speed limit (ft/min)
+	Real   m_rosHead;				// surface fire rate of spread at fire head (ft/min)
+    Real   m_headDirFromUpslope;	// direction of maximum spread (head direction, degrees clowise from north)
+    Real   m_effectiveWindSpeed;	// effective wind speed (ft/min)
+    Real   m_windSpeedLimit;		// upper wind speed limit (ft/min)
     bool   m_windLimitExceeded;		// TRUE if m_rosHead > m_windSpeedLimit
-    double m_windFactor;			// wind coefficient (dl)
-    double m_slopeFactor;			// slope coefficient (dl)
+    Real   m_windFactor;			// wind coefficient (dl)
+    Real   m_slopeFactor;			// slope coefficient (dl)
 	bool   m_spreadExceedsWind;		// TRUE if m_rosHead > m_midflameWindSpeed
 	int    m_situation;
-	double m_lwRatio;				// surface fire perimeter length-to-width ratio (dl)
-	double m_eccent;				// surface fire perimeter eccentricity (dl)
-	double m_hpua;					// surface fire heat per uniut area (btu/lb)
-	double m_rosBack;				// surface fire rate of spread at perimeter back (ft/min)
-	double m_rosMajor;				// surface fire rate of spread at perimeter head and back (ft/min)
-	double m_rosFlank;				// surface fire rate of spread at peimeret flank (ft/min)
-	double m_fliHead;
-	double m_fliBack;
-	double m_fliFlank;
-	double m_flameHead;
-	double m_flameBack;
-	double m_flameFlank;
-	double m_ellipseF;
-	double m_ellipseG;
-	double m_ellipseH;
+	Real   m_lwRatio;				// surface fire perimeter length-to-width ratio (dl)
+	Real   m_eccent;				// surface fire perimeter eccentricity (dl)
+	Real   m_hpua;					// surface fire heat per uniut area (btu/lb)
+	Real   m_rosBack;				// surface fire rate of spread at perimeter back (ft/min)
+	Real   m_rosMajor;				// surface fire rate of spread at perimeter head and back (ft/min)
+	Real   m_rosFlank;				// surface fire rate of spread at peimeret flank (ft/min)
+	Real   m_fliHead;
+	Real   m_fliBack;
+	Real   m_fliFlank;
+	Real   m_flameHead;
+	Real   m_flameBack;
+	Real   m_flameFlank;
+	Real   m_ellipseF;
+	Real   m_ellipseG;
+	Real   m_ellipseH;
 	// time inputs and outputs
-	double m_elapsed;
-	double m_fireLength;
-	double m_fireWidth;
-	double m_fireArea;
-	double m_firePerimeter;
+	Real   m_elapsed;
+	Real   m_fireLength;
+	Real   m_fireWidth;
+	Real   m_fireArea;
+	Real   m_firePerimeter;
 };
 
+typedef Bp6SurfaceFireT<double> Bp6SurfaceFire;
+
 #endif // BP6_SURFACE_FIRE_H
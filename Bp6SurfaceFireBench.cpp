@@ -0,0 +1,436 @@
+//------------------------------------------------------------------------------
+/*! \file Bp6SurfaceFireBench.cpp
+ *  \brief Times Bp6SurfaceFire's specialized fuel and moisture kernels
+ *	against the generic kernel, and checks that both give identical results.
+ *
+ *	Each evaluation is one setFuel() and setMoisture() of a standard fuel
+ *	model laid out in EqCalc's 10 particle slots, as FuelBedIntermediates()
+ *	passes it.  Also checks the Bp6Dual fire's values against the double
+ *	fire and its derivatives against central differences.  Built and run by
+ *	the makefile's Bp6SurfaceFireBench target; exits non-zero if any output
+ *	differs between the two kernels or any derivative check fails.
+ */
+
+#include "Bp6Dual.h"
+#include "Bp6SurfaceFire.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+static const int Slots = 10;		// EqCalc's MaxParts
+static const int Repeats = 100000;	// evaluations per timed run
+static const int Trials = 5;		// timed runs per fuel model per kernel
+static const double Tolerance = 1.e-5;	// relative derivative tolerance
+
+//------------------------------------------------------------------------------
+/*!	\brief Standard fire behavior fuel model parameters, as added by
+ *	FuelModelList::addStandardFuelModels().
+ */
+struct BenchFuelModel
+{
+	const char* name;
+	double depth;
+	double mext;
+	double load1;
+	double load10;
+	double load100;
+	double loadHerb;
+	double loadWood;
+	double savr1;
+	double savrHerb;
+	double savrWood;
+	bool   dynamic;
+};
+
+static const double f = 2000. / 43560.;
+
+static const BenchFuelModel Models[] =
+{
+	{ "1",   1.0, 0.12, 0.034, 0.000, 0.000, 0.000, 0.000, 3500., 1500., 1500., false },
+	{ "2",   1.0, 0.15, 0.092, 0.046, 0.023, 0.023, 0.000, 3000., 1500., 1500., false },
+	{ "3",   2.5, 0.25, 0.138, 0.000, 0.000, 0.000, 0.000, 1500., 1500., 1500., false },
+	{ "4",   6.0, 0.20, 0.230, 0.184, 0.092, 0.000, 0.230, 2000., 1500., 1500., false },
+	{ "5",   2.0, 0.20, 0.046, 0.023, 0.000, 0.000, 0.092, 2000., 1500., 1500., false },
+	{ "6",   2.5, 0.25, 0.069, 0.115, 0.092, 0.000, 0.000, 1750., 1500., 1500., false },
+	{ "7",   2.5, 0.40, 0.052, 0.086, 0.069, 0.000, 0.017, 1750., 1500., 1500., false },
+	{ "8",   0.2, 0.30, 0.069, 0.046, 0.115, 0.000, 0.000, 2000., 1500., 1500., false },
+	{ "9",   0.2, 0.25, 0.134, 0.019, 0.007, 0.000, 0.000, 2500., 1500., 1500., false },
+	{ "10",  1.0, 0.25, 0.138, 0.092, 0.230, 0.000, 0.092, 2000., 1500., 1500., false },
+	{ "11",  1.0, 0.15, 0.069, 0.207, 0.253, 0.000, 0.000, 1500., 1500., 1500., false },
+	{ "12",  2.3, 0.20, 0.184, 0.644, 0.759, 0.000, 0.000, 1500., 1500., 1500., false },
+	{ "13",  3.0, 0.25, 0.322, 1.058, 1.288, 0.000, 0.000, 1500., 1500., 1500., false },
+	{ "gr1", 0.4, 0.15, 0.1*f, 0.000, 0.000, 0.3*f, 0.000, 2200., 2000., 1500., true },
+	{ "gr4", 2.0, 0.15, 0.25*f, 0.000, 0.000, 1.9*f, 0.000, 2000., 1800., 1500., true },
+	{ "gs2", 1.5, 0.15, 0.5*f, 0.5*f, 0.000, 0.6*f, 1.0*f, 2000., 1800., 1800., true },
+	{ "sh5", 6.0, 0.15, 3.6*f, 2.1*f, 0.000, 0.000, 2.9*f, 750., 1800., 1600., false },
+	{ "tu1", 0.6, 0.20, 0.2*f, 0.9*f, 1.5*f, 0.2*f, 0.9*f, 2000., 1800., 1600., true },
+	{ "tl3", 0.3, 0.20, 0.5*f, 2.2*f, 2.8*f, 0.000, 0.000, 2000., 1800., 1600., false },
+	{ "sb3", 1.2, 0.25, 5.5*f, 2.75*f, 3.0*f, 0.000, 0.000, 2000., 1800., 1600., false },
+};
+
+static const int NumModels = sizeof( Models ) / sizeof( Models[0] );
+
+//------------------------------------------------------------------------------
+/*!	\brief Particle arrays of one fuel model in EqCalc's slot layout
+ *	(see EqCalc::FuelBedParms() and EqCalc::FuelBedIntermediates()).
+ */
+struct BenchFuelBed
+{
+	double depth;
+	double mext;
+	int    life[Slots];
+	double load[Slots];
+	double savr[Slots];
+	double heat[Slots];
+	double dens[Slots];
+	double stot[Slots];
+	double seff[Slots];
+	double mois[Slots];
+};
+
+//------------------------------------------------------------------------------
+static void benchFuelBed( const BenchFuelModel& fm, BenchFuelBed& bed )
+{
+	// Dead 1-h, 10-h, and 100-h, live herb, and live wood moisture
+	const double moisDead1 = 0.06;
+	const double moisDead10 = 0.07;
+	const double moisDead100 = 0.08;
+	const double moisHerb = 0.60;
+	const double moisWood = 0.90;
+
+	bed.depth = fm.depth;
+	bed.mext  = fm.mext;
+	for ( int p=0; p<Slots; p++ )
+	{
+		bed.life[p] = 0;
+		bed.load[p] = 0.;
+		bed.savr[p] = 1.;
+		bed.heat[p] = 8000.;
+		bed.dens[p] = 32.;
+		bed.stot[p] = 0.0555;
+		bed.seff[p] = 0.0100;
+		bed.mois[p] = moisDead100;
+	}
+	bed.life[3] = 1;
+	bed.life[4] = 2;
+	bed.load[0] = fm.load1;
+	bed.load[1] = fm.load10;
+	bed.load[2] = fm.load100;
+	bed.load[3] = fm.loadHerb;
+	bed.load[4] = fm.loadWood;
+	bed.savr[0] = fm.savr1;
+	bed.savr[1] = 109.;
+	bed.savr[2] = 30.;
+	bed.savr[3] = fm.savrHerb;
+	bed.savr[4] = fm.savrWood;
+	bed.savr[5] = fm.savrHerb;
+	bed.mois[0] = moisDead1;
+	bed.mois[1] = moisDead10;
+	bed.mois[2] = moisDead100;
+	bed.mois[3] = moisHerb;
+	bed.mois[4] = moisWood;
+	bed.mois[5] = moisDead1;
+	// Dynamic fuel models transfer cured herb load to the dead herb slot
+	if ( fm.dynamic )
+	{
+		Bp6SurfaceFire fire;
+		double fraction = fire.calcHerbaceousFuelLoadCuredFraction( moisHerb );
+		bed.load[5] = fraction * bed.load[3];
+		bed.load[3] -= bed.load[5];
+	}
+}
+
+//------------------------------------------------------------------------------
+static void benchEvaluate( Bp6SurfaceFire& fire, BenchFuelBed& bed )
+{
+	fire.setFuel( bed.depth, bed.mext, Slots, bed.life, bed.load, bed.savr,
+		bed.heat, bed.dens, bed.stot, bed.seff );
+	fire.setMoisture( bed.mois );
+}
+
+//------------------------------------------------------------------------------
+/*!	\brief Stores every fuel and moisture kernel output of \a fire in \a out.
+ *
+ *	The intermediates of empty particles are skipped, since the specialized
+ *	kernels leave the trailing empty dead particles out entirely.
+ *
+ *	\return Number of outputs stored.
+ */
+static int benchOutputs( const Bp6SurfaceFire& fire, const BenchFuelBed& bed,
+	double* out )
+{
+	int n = 0;
+	for ( int p=0; p<Slots; p++ )
+	{
+		if ( bed.load[p] == 0. )
+		{
+			continue;
+		}
+		out[n++] = fire.getParticleArea( p );
+		out[n++] = fire.getParticleAwtg( p );
+		out[n++] = fire.getParticleSigK( p );
+		out[n++] = fire.getParticleSwtg( p );
+		out[n++] = fire.getParticleSize( p );
+	}
+	for ( int l=0; l<Bp6SurfaceFire::MaxCats; l++ )
+	{
+		out[n++] = fire.getLifeArea( l );
+		out[n++] = fire.getLifeAwtg( l );
+		out[n++] = fire.getLifeEtaS( l );
+		out[n++] = fire.getLifeFine( l );
+		out[n++] = fire.getLifeHeat( l );
+		out[n++] = fire.getLifeLoad( l );
+		out[n++] = fire.getLifeRxDry( l );
+		out[n++] = fire.getLifeSavr( l );
+		out[n++] = fire.getLifeSeff( l );
+		out[n++] = fire.getLifeStot( l );
+		out[n++] = fire.getLifeMext( l );
+		out[n++] = fire.getLifeMois( l );
+		for ( int s=0; s<Bp6SurfaceFire::MaxSizes; s++ )
+		{
+			out[n++] = fire.getLifeSwtg( l, s );
+		}
+	}
+	out[n++] = fire.getAa();
+	out[n++] = fire.getBetaRatio();
+	out[n++] = fire.getBulkDensity();
+	out[n++] = fire.getC();
+	out[n++] = fire.getE();
+	out[n++] = fire.getEffectiveHeatingNumber();
+	out[n++] = fire.getGammaMax();
+	out[n++] = fire.getGammaOpt();
+	out[n++] = fire.getLiveMextK();
+	out[n++] = fire.getOptimumPackingRatio();
+	out[n++] = fire.getPackingRatio();
+	out[n++] = fire.getPropagatingFlux();
+	out[n++] = fire.getResidenceTime();
+	out[n++] = fire.getSigma();
+	out[n++] = fire.getSigma15();
+	out[n++] = fire.getSlopeK();
+	out[n++] = fire.getTotalArea();
+	out[n++] = fire.getTotalLoad();
+	out[n++] = fire.getWindB();
+	out[n++] = fire.getWindE();
+	out[n++] = fire.getWindK();
+	out[n++] = fire.getDeadMois();
+	out[n++] = fire.getDeadRxDry();
+	out[n++] = fire.getFdMois();
+	out[n++] = fire.getHeatSink();
+	out[n++] = fire.getLiveMextApplied();
+	out[n++] = fire.getLiveMextCalculated();
+	out[n++] = fire.getLiveMois();
+	out[n++] = fire.getLiveRxDry();
+	out[n++] = fire.getRbQig();
+	out[n++] = fire.getWfmd();
+	out[n++] = fire.getDeadEtaM();
+	out[n++] = fire.getDeadRxInt();
+	out[n++] = fire.getLiveEtaM();
+	out[n++] = fire.getLiveRxInt();
+	out[n++] = fire.getTotalRxInt();
+	out[n++] = fire.getNoWindNoSlopeSpreadRate();
+	return n;
+}
+
+//------------------------------------------------------------------------------
+/*!	\brief Times Trials runs of Repeats evaluations of \a bed.
+ *	\return Nanoseconds per evaluation of the fastest run.
+ */
+static double benchTime( Bp6SurfaceFire& fire, BenchFuelBed& bed, double* sink )
+{
+	double best = 0.;
+	for ( int t=0; t<Trials; t++ )
+	{
+		clock_t start = clock();
+		for ( int i=0; i<Repeats; i++ )
+		{
+			benchEvaluate( fire, bed );
+			*sink += fire.getNoWindNoSlopeSpreadRate();
+		}
+		clock_t stop = clock();
+		double ns = 1.e9 * (double) ( stop - start ) / CLOCKS_PER_SEC / Repeats;
+		if ( t == 0 || ns < best )
+		{
+			best = ns;
+		}
+	}
+	return best;
+}
+
+//------------------------------------------------------------------------------
+/*!	\brief Inputs seeded in the Bp6Dual fire by the derivative checks.
+ */
+enum BenchInput
+{
+	InputDepth,
+	InputLoad1,
+	InputMois1,
+	InputMoisHerb,
+	InputSlope,
+	InputWind,
+	InputWindDir,
+	Inputs
+};
+
+//------------------------------------------------------------------------------
+/*!	\brief Runs \a fire on \a bed with the checked inputs \a x, and stores
+ *	its head fire outputs in \a out.
+ */
+template <class Real>
+static void benchSiteOutputs( Bp6SurfaceFireT<Real>& fire,
+	const BenchFuelBed& bed, const Real* x, Real* out )
+{
+	int  life[Slots];
+	Real load[Slots], mois[Slots];
+	for ( int p=0; p<Slots; p++ )
+	{
+		life[p] = bed.life[p];
+		load[p] = bed.load[p];
+		mois[p] = bed.mois[p];
+	}
+	load[0] = x[InputLoad1];
+	mois[0] = x[InputMois1];
+	mois[3] = x[InputMoisHerb];
+	Real savr[Slots], heat[Slots], dens[Slots], stot[Slots], seff[Slots];
+	for ( int p=0; p<Slots; p++ )
+	{
+		savr[p] = bed.savr[p];
+		heat[p] = bed.heat[p];
+		dens[p] = bed.dens[p];
+		stot[p] = bed.stot[p];
+		seff[p] = bed.seff[p];
+	}
+	fire.setFuel( x[InputDepth], bed.mext, Slots, life, load, savr,
+		heat, dens, stot, seff );
+	fire.setMoisture( mois );
+	fire.setSite( x[InputSlope], 0., x[InputWind], x[InputWindDir], false );
+	fire.setTime( 60. );
+	out[0] = fire.getSpreadRateAtHead();
+	out[1] = fire.getFirelineIntensityAtHead();
+	out[2] = fire.getFlameLengthAtHead();
+	out[3] = fire.getHeatPerUnitArea();
+	out[4] = fire.getLengthToWidthRatio();
+	out[5] = fire.getFireArea();
+}
+
+static const int SiteOutputs = 6;
+
+//------------------------------------------------------------------------------
+/*!	\brief Checks the Bp6Dual fire of \a bed against the double fire.
+ *
+ *	Its values must be bit-for-bit those of the double fire, and its
+ *	derivatives must match central differences of the double fire.
+ *
+ *	\return Number of failed checks.
+ */
+static int benchDerivatives( const BenchFuelBed& bed )
+{
+	double x[Inputs];
+	x[InputDepth]    = bed.depth;
+	x[InputLoad1]    = bed.load[0];
+	x[InputMois1]    = bed.mois[0];
+	x[InputMoisHerb] = bed.mois[3];
+	x[InputSlope]    = 0.3;
+	x[InputWind]     = 352.;
+	x[InputWindDir]  = 30.;
+
+	Bp6SurfaceFireT<Bp6Dual> dualFire;
+	Bp6Dual dx[Inputs], dualOut[SiteOutputs];
+	for ( int i=0; i<Inputs; i++ )
+	{
+		dx[i] = Bp6Dual::seed( x[i], i );
+	}
+	benchSiteOutputs( dualFire, bed, dx, dualOut );
+
+	Bp6SurfaceFire fire;
+	double out[SiteOutputs], hiOut[SiteOutputs], loOut[SiteOutputs];
+	benchSiteOutputs( fire, bed, x, out );
+
+	int failed = 0;
+	for ( int o=0; o<SiteOutputs; o++ )
+	{
+		double value = dualOut[o].value();
+		if ( memcmp( &value, &out[o], sizeof( double ) ) != 0 )
+		{
+			failed++;
+		}
+	}
+	for ( int i=0; i<Inputs; i++ )
+	{
+		double h = 1.e-6 * ( ( x[i] != 0. ) ? fabs( x[i] ) : 1. );
+		double xi = x[i];
+		x[i] = xi + h;
+		benchSiteOutputs( fire, bed, x, hiOut );
+		x[i] = xi - h;
+		benchSiteOutputs( fire, bed, x, loOut );
+		x[i] = xi;
+		for ( int o=0; o<SiteOutputs; o++ )
+		{
+			double fd = ( hiOut[o] - loOut[o] ) / ( 2. * h );
+			double ad = dualOut[o].derivative( i );
+			double scale = fabs( out[o] / xi ) + fabs( fd ) + 1.e-12;
+			if ( fabs( ad - fd ) > Tolerance * scale )
+			{
+				failed++;
+			}
+		}
+	}
+	return failed;
+}
+
+//------------------------------------------------------------------------------
+int main()
+{
+	Bp6SurfaceFire specialized;
+	Bp6SurfaceFire generic;
+	generic.setSpecializedKernels( false );
+
+	double specOut[512], genOut[512];
+	double specTotal = 0.;
+	double genTotal = 0.;
+	double sink = 0.;
+	int mismatches = 0;
+	int derivativeFailures = 0;
+
+	printf( "%-6s %12s %12s %8s  %s\n",
+		"Model", "Generic ns", "Special ns", "Speedup", "Outputs" );
+	for ( int m=0; m<NumModels; m++ )
+	{
+		BenchFuelBed bed;
+		benchFuelBed( Models[m], bed );
+
+		// Both kernels must give bit-for-bit identical outputs
+		benchEvaluate( specialized, bed );
+		benchEvaluate( generic, bed );
+		int n = benchOutputs( specialized, bed, specOut );
+		benchOutputs( generic, bed, genOut );
+		int differ = 0;
+		for ( int i=0; i<n; i++ )
+		{
+			if ( memcmp( &specOut[i], &genOut[i], sizeof( double ) ) != 0 )
+			{
+				differ++;
+			}
+		}
+		mismatches += differ;
+		derivativeFailures += benchDerivatives( bed );
+
+		double genNs  = benchTime( generic, bed, &sink );
+		double specNs = benchTime( specialized, bed, &sink );
+		genTotal  += genNs;
+		specTotal += specNs;
+		printf( "%-6s %12.1f %12.1f %7.1f%%  %d of %d differ\n",
+			Models[m].name, genNs, specNs, 100. * ( genNs - specNs ) / genNs,
+			differ, n );
+	}
+	printf( "%-6s %12.1f %12.1f %7.1f%%  %d differ\n", "Mean",
+		genTotal / NumModels, specTotal / NumModels,
+		100. * ( genTotal - specTotal ) / genTotal, mismatches );
+	printf( "%d Bp6Dual derivative checks failed\n", derivativeFailures );
+	// Keeps the timed evaluations from being optimized away
+	if ( sink < 0. )
+	{
+		printf( "%g\n", sink );
+	}
+	return ( mismatches == 0 && derivativeFailures == 0 ) ? 0 : 1;
+}
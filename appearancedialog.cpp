@@ -14,6 +14,9 @@
 #include "propertydialog.h"
 #include "property.h"
 #include "varcheckbox.h"
+#include "xeqdiskcache.h"
+#include "xeqrxwindow.h"
+#include "xeqsample.h"
 
 // Qt include files
 #include <qcheckbox.h>
@@ -237,7 +240,7 @@ AppearanceDialog::AppearanceDialog( BpDocument *bp, const QString &captionKey,
                      3, 1, 3, 1 );
 
     // Add the "Graph Elements" page
-    p = addPage( "AppearanceDialog:GraphElements:Tab", 10, 2,
+    p = addPage( "AppearanceDialog:GraphElements:Tab", 12, 2,
         "EveningInTheBob3.png", Bmw, "graphElements.html" );
 
         p->addLabel( "AppearanceDialog:GraphElements:Background",
@@ -288,6 +291,13 @@ AppearanceDialog::AppearanceDialog( BpDocument *bp, const QString &captionKey,
                      9, 0, 9, 0 );
         p->addSpin(  "graphGridWidth", 0, 9, 1,
                      9, 1, 9, 1 );
+        p->addCheck( "graphLineAdaptive",
+                     "AppearanceDialog:GraphElements:CurveAdaptive", "",
+                     10, 0, 10, 1 );
+        p->addLabel( "AppearanceDialog:GraphElements:CurveMaxPoints",
+                     11, 0, 11, 0 );
+        p->addSpin(  "graphLineMaxPoints", 4, 2000, 50,
+                     11, 1, 11, 1);
 
     // Add the "Page Tabs" page
     p = addPage( "AppearanceDialog:PageTabs:Tab", 6, 2,
@@ -328,7 +338,7 @@ AppearanceDialog::AppearanceDialog( BpDocument *bp, const QString &captionKey,
     // TO DO: add controls for tableTextFont{Color,Family,Size}.
     // TO DO: add controls for tableTitleFont{Color,Family,Size}.
     // TO DO: add controls for tableValueFont{Color,Family,Size}.
-    p = addPage( "AppearanceDialog:Tables:Tab", 2, 2,
+    p = addPage( "AppearanceDialog:Tables:Tab", 25, 2,
         "TellerWildlifeRefuge2.png", Twr, "tablesAppearance.html" );
 
         p->addCheck( "tableRowBackgroundColorActive",
@@ -342,6 +352,98 @@ AppearanceDialog::AppearanceDialog( BpDocument *bp, const QString &captionKey,
         p->addCheck( "tableShadingBlank",
                     "AppearanceDialog:Tables:RxVariablesBlank", "",
                     2, 0, 2, 1 );
+        p->addCheck( "tableSweepActive",
+                    "AppearanceDialog:Tables:SweepActive", "",
+                    3, 0, 3, 1 );
+        p->addCheck( "uncertaintyActive",
+                    "AppearanceDialog:Tables:UncertaintyActive", "",
+                    4, 0, 4, 1 );
+        p->addLabel( "AppearanceDialog:Tables:UncertaintySamples",
+                     5, 0, 5, 0 );
+        p->addSpin(  "uncertaintySamples", EqSampleMinSamples,
+                     EqSampleMaxSamples, 100,
+                     5, 1, 5, 1 );
+        p->addCheck( "uncertaintyLatinHypercube",
+                    "AppearanceDialog:Tables:UncertaintyLatinHypercube", "",
+                    6, 0, 6, 1 );
+        p->addCheck( "uncertaintyNormal",
+                    "AppearanceDialog:Tables:UncertaintyNormal", "",
+                    7, 0, 7, 1 );
+        p->addCheck( "weatherStreamActive",
+                    "AppearanceDialog:Tables:WeatherStreamActive", "",
+                    8, 0, 8, 1 );
+        p->addLabel( "AppearanceDialog:Tables:WeatherStreamFile",
+                     9, 0, 9, 0 );
+        le = p->addEntry( "weatherStreamFile",
+                     9, 1, 9, 1 );
+        le->setFixedWidth( l_width );
+        p->addLabel( "AppearanceDialog:Tables:WeatherStreamResultFile",
+                     10, 0, 10, 0 );
+        le = p->addEntry( "weatherStreamResultFile",
+                     10, 1, 10, 1 );
+        le->setFixedWidth( l_width );
+        p->addCheck( "resultCacheActive",
+                    "AppearanceDialog:Tables:ResultCacheActive", "",
+                    11, 0, 11, 1 );
+        p->addLabel( "AppearanceDialog:Tables:ResultCacheMaxEntries",
+                     12, 0, 12, 0 );
+        p->addSpin(  "resultCacheMaxEntries", EqDiskCacheMinEntries,
+                     EqDiskCacheMaxEntries, EqDiskCacheMinEntries,
+                     12, 1, 12, 1 );
+        p->addCheck( "goalSeekActive",
+                    "AppearanceDialog:Tables:GoalSeekActive", "",
+                    13, 0, 13, 1 );
+        p->addLabel( "AppearanceDialog:Tables:GoalSeekInput",
+                     14, 0, 14, 0 );
+        le = p->addEntry( "goalSeekInput",
+                     14, 1, 14, 1 );
+        le->setFixedWidth( l_width );
+        p->addLabel( "AppearanceDialog:Tables:GoalSeekOutput",
+                     15, 0, 15, 0 );
+        le = p->addEntry( "goalSeekOutput",
+                     15, 1, 15, 1 );
+        le->setFixedWidth( l_width );
+        p->addLabel( "AppearanceDialog:Tables:GoalSeekTarget",
+                     16, 0, 16, 0 );
+        le = p->addEntry( "goalSeekTarget",
+                     16, 1, 16, 1 );
+        le->setFixedWidth( l_width );
+        p->addLabel( "AppearanceDialog:Tables:GoalSeekMinimum",
+                     17, 0, 17, 0 );
+        le = p->addEntry( "goalSeekMinimum",
+                     17, 1, 17, 1 );
+        le->setFixedWidth( l_width );
+        p->addLabel( "AppearanceDialog:Tables:GoalSeekMaximum",
+                     18, 0, 18, 0 );
+        le = p->addEntry( "goalSeekMaximum",
+                     18, 1, 18, 1 );
+        le->setFixedWidth( l_width );
+        p->addLabel( "AppearanceDialog:Tables:GoalSeekResultFile",
+                     19, 0, 19, 0 );
+        le = p->addEntry( "goalSeekResultFile",
+                     19, 1, 19, 1 );
+        le->setFixedWidth( l_width );
+        p->addCheck( "rxWindowActive",
+                    "AppearanceDialog:Tables:RxWindowActive", "",
+                    20, 0, 20, 1 );
+        p->addLabel( "AppearanceDialog:Tables:RxWindowDepth",
+                     21, 0, 21, 0 );
+        p->addSpin(  "rxWindowDepth", EqRxWindowMinDepth,
+                     EqRxWindowMaxDepth, 1,
+                     21, 1, 21, 1 );
+        p->addLabel( "AppearanceDialog:Tables:RxWindowResultFile",
+                     22, 0, 22, 0 );
+        le = p->addEntry( "rxWindowResultFile",
+                     22, 1, 22, 1 );
+        le->setFixedWidth( l_width );
+        p->addCheck( "sensitivityActive",
+                    "AppearanceDialog:Tables:SensitivityActive", "",
+                    23, 0, 23, 1 );
+        p->addLabel( "AppearanceDialog:Tables:SensitivityResultFile",
+                     24, 0, 24, 0 );
+        le = p->addEntry( "sensitivityResultFile",
+                     24, 1, 24, 1 );
+        le->setFixedWidth( l_width );
 
     // Add the "Worksheet" page
     // TO DO: add control for worksheetmaskColor property.
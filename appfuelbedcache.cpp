@@ -0,0 +1,52 @@
+//------------------------------------------------------------------------------
+/*! \file appfuelbedcache.cpp
+ *  \version BehavePlus6
+ *  \author Copyright (C) 2002-2018 by Collin D. Bevins.  All rights reserved.
+ *
+ *  \brief Application-wide, shared FuelBedCache access.
+ */
+
+// Custom include files
+#include "appfuelbedcache.h"
+#include "appmessage.h"
+
+// Shared, application-wide FuelBedCache object.
+static FuelBedCache *AppFuelBedCache = 0;
+
+//------------------------------------------------------------------------------
+/*! \brief Access to the shared, application-wide FuelBedCache.
+ *
+ *  \return Pointer to the shared, application-wide FuelBedCache.
+ */
+
+FuelBedCache *appFuelBedCache( void )
+{
+    return( AppFuelBedCache );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Creates the shared, application-wide FuelBedCache.
+ */
+
+void appFuelBedCacheCreate( void )
+{
+    AppFuelBedCache = new FuelBedCache();
+    checkmem( __FILE__, __LINE__, AppFuelBedCache,
+        "FuelBedCache AppFuelBedCache", 1 );
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Deletes the shared, application-wide FuelBedCache.
+ */
+
+void appFuelBedCacheDelete( void )
+{
+    delete AppFuelBedCache;     AppFuelBedCache = 0;
+    return;
+}
+
+//------------------------------------------------------------------------------
+//  End of appfuelbedcache.cpp
+//------------------------------------------------------------------------------
+
@@ -0,0 +1,28 @@
+//------------------------------------------------------------------------------
+/*! \file appfuelbedcache.h
+ *  \version BehavePlus6
+ *  \author Copyright (C) 2002-2018 by Collin D. Bevins.  All rights reserved.
+ *
+ *  \brief Application-wide, shared FuelBedCache access.
+ */
+
+#ifndef _APPFUELBEDCACHE_H_
+/*! \def _APPFUELBEDCACHE_H_
+ *  \brief Prevent redundant includes.
+ */
+#define _APPFUELBEDCACHE_H_ 1
+
+// Class references
+#include "fuelbedcache.h"
+
+// Public functions
+void appFuelBedCacheCreate( void ) ;
+void appFuelBedCacheDelete( void ) ;
+FuelBedCache *appFuelBedCache( void ) ;
+
+#endif
+
+//------------------------------------------------------------------------------
+//  End of appfuelbedcache.h
+//------------------------------------------------------------------------------
+
@@ -0,0 +1,54 @@
+//------------------------------------------------------------------------------
+/*! \file appgeoplaceindex.cpp
+ *  \version BehavePlus6
+ *  \author Copyright (C) 2002-2018 by Collin D. Bevins.  All rights reserved.
+ *
+ *  \brief Application-wide, shared GeoPlaceIndex access.
+ */
+
+// Custom include files
+#include "appfilesystem.h"
+#include "appgeoplaceindex.h"
+#include "appmessage.h"
+
+// Shared, application-wide GeoPlaceIndex object.
+static GeoPlaceIndex *AppGeoPlaceIndex = 0;
+
+//------------------------------------------------------------------------------
+/*! \brief Access to the shared, application-wide GeoPlaceIndex.
+ *
+ *  The index is created on first use, since it is only needed if the user
+ *  browses the GeoFolder, and is refreshed from its index file (or rebuilt
+ *  from the *.geo files) whenever the GeoFolder has changed.
+ *
+ *  \return Pointer to the shared, application-wide GeoPlaceIndex.
+ */
+
+GeoPlaceIndex *appGeoPlaceIndex( void )
+{
+    if ( ! AppGeoPlaceIndex )
+    {
+        AppGeoPlaceIndex = new GeoPlaceIndex( appFileSystem()->docGeoPath(),
+            appFileSystem()->composerPath( "GeoFolder.idx" ) );
+        checkmem( __FILE__, __LINE__, AppGeoPlaceIndex,
+            "GeoPlaceIndex AppGeoPlaceIndex", 1 );
+    }
+    AppGeoPlaceIndex->refresh();
+    return( AppGeoPlaceIndex );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Deletes the shared, application-wide GeoPlaceIndex (if it was
+ *  ever created), which also unmaps its index file.
+ */
+
+void appGeoPlaceIndexDelete( void )
+{
+    delete AppGeoPlaceIndex;    AppGeoPlaceIndex = 0;
+    return;
+}
+
+//------------------------------------------------------------------------------
+//  End of appgeoplaceindex.cpp
+//------------------------------------------------------------------------------
+
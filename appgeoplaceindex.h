@@ -0,0 +1,27 @@
+//------------------------------------------------------------------------------
+/*! \file appgeoplaceindex.h
+ *  \version BehavePlus6
+ *  \author Copyright (C) 2002-2018 by Collin D. Bevins.  All rights reserved.
+ *
+ *  \brief Application-wide, shared GeoPlaceIndex access.
+ */
+
+#ifndef _APPGEOPLACEINDEX_H_
+/*! \def _APPGEOPLACEINDEX_H_
+ *  \brief Prevent redundant includes.
+ */
+#define _APPGEOPLACEINDEX_H_ 1
+
+// Class references
+#include "geoplaceindex.h"
+
+// Public functions
+void appGeoPlaceIndexDelete( void ) ;
+GeoPlaceIndex *appGeoPlaceIndex( void ) ;
+
+#endif
+
+//------------------------------------------------------------------------------
+//  End of appgeoplaceindex.h
+//------------------------------------------------------------------------------
+
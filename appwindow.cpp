@@ -57,6 +57,7 @@
 #include "globalposition.h"
 #include "horizontaldistancedialog.h"
 #include "humiditydialog.h"
+#include "landscaperun.h"
 #include "platform.h"
 #include "property.h"
 #include "slopetooldialog.h"
@@ -504,6 +505,8 @@ AppWindow::~AppWindow( void )
 /*  \brief Scans the command line for following switches:
  *  -   -run <runFile> opens and runs the specified file
  *  -   -open <runFile> opens the specified file
+ *  -   -landscape <controlFile> runs the landscape grids specified by the
+ *            control file (see LandscapeRun)
  *  -   -kill exists the program after completing this function
  *            (used for coverage testing)
  *  -   -splash causes Help-Splash to save the splash screen to a BMP file
@@ -609,6 +612,32 @@ void AppWindow::checkCommandLineSwitches( void )
             m_startupFile = qApp->argv()[i+1];
             i++;        // Skip its value argument
         }
+        // "-landscape <controlFile>"
+        else if ( strncmp( qApp->argv()[i], "-landscape", 3 ) == 0 )
+        {
+            log( "Found -landscape switch\n" );
+            // There must be a fileName argument
+            if ( i == qApp->argc()-1 )
+            {
+                log( "-landscape switch is missing its argument.\n" );
+                translate( text, "AppWindow:MissingArg", qApp->argv()[i] );
+                error( text );
+                platformExit(1);
+            }
+            LandscapeRun landscape( m_eqApp->m_fuelModelList );
+            if ( ! landscape.load( qApp->argv()[i+1] )
+              || ! landscape.run() )
+            {
+                error( landscape.error() );
+            }
+            else
+            {
+                log( QString( "Landscape run of %1 cells evaluated %2.\n" )
+                    .arg( landscape.cells() )
+                    .arg( landscape.evaluations() ) );
+            }
+            i++;        // Skip its value argument
+        }
         // All other arguments are unknown.
         else
         {
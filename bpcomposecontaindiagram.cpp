@@ -14,8 +14,10 @@
 #include "docdevicesize.h"
 #include "docpagesize.h"
 #include "graph.h"
+#include "panegeometry.h"
 #include "property.h"
 #include "xeqcalc.h"
+#include "xeqtrace.h"
 #include "xeqtree.h"
 #include "xeqvar.h"
 #include "xeqvaritem.h"
@@ -27,9 +29,126 @@
 
 // Standard include files
 #include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+//------------------------------------------------------------------------------
+/*! \class ContainDiagramGeometry
+ *
+ *  \brief Decodes and scales the constructed fireline coordinates of every
+ *  containment diagram pane in parallel.
+ *
+ *  Each pane's fireline is decoded from the ContainFF() coordinate records
+ *  of the decoded trace text, and converted from WORLD into DIAGRAM inches
+ *  relative to the upper left corner of the pane's figure.
+ */
+
+class ContainDiagramGeometry : public PaneGeometry
+{
+public:
+    ContainDiagramGeometry( const char *text, const long *fpos,
+            const int *dataSet, const double *steps, int cells,
+            double figWd, double figHt, double gXMin, double gXMax,
+            double gYMax ) :
+        PaneGeometry(),
+        m_start(0),
+        m_x(0),
+        m_yTop(0),
+        m_yBot(0),
+        m_text(text),
+        m_fpos(fpos),
+        m_dataSet(dataSet),
+        m_steps(steps),
+        m_figWd(figWd),
+        m_figHt(figHt),
+        m_gXMin(gXMin),
+        m_gXMax(gXMax),
+        m_gYMax(gYMax)
+    {
+        // Each pane's points start where the previous pane's points end
+        m_start = new int[ cells + 1 ];
+        checkmem( __FILE__, __LINE__, m_start, "int m_start", cells + 1 );
+        m_start[0] = 0;
+        for ( int datum = 0;
+              datum < cells;
+              datum++ )
+        {
+            m_start[datum+1] = m_start[datum] + points( datum );
+        }
+        int n = ( m_start[cells] > 0 ) ? m_start[cells] : 1;
+        m_x = new double[ n ];
+        checkmem( __FILE__, __LINE__, m_x, "double m_x", n );
+        m_yTop = new double[ n ];
+        checkmem( __FILE__, __LINE__, m_yTop, "double m_yTop", n );
+        m_yBot = new double[ n ];
+        checkmem( __FILE__, __LINE__, m_yBot, "double m_yBot", n );
+    }
+
+    ~ContainDiagramGeometry( void )
+    {
+        delete[] m_start;   m_start = 0;
+        delete[] m_x;       m_x = 0;
+        delete[] m_yTop;    m_yTop = 0;
+        delete[] m_yBot;    m_yBot = 0;
+    }
+
+    //! Number of fireline points of the \a datum's pane
+    int points( int datum ) const
+    {
+        return( (int) ( m_steps[ m_dataSet[datum] ] + 0.1 ) );
+    }
+
+    int     *m_start;   //!< Index of each pane's first point
+    double  *m_x;       //!< Point x (inches right of the figure left)
+    double  *m_yTop;    //!< Upper fireline y (inches below the figure top)
+    double  *m_yBot;    //!< Lower fireline y (inches below the figure top)
+
+protected:
+    void compute( int datum )
+    {
+        const char *ptr = m_text + m_fpos[ m_dataSet[datum] ];
+        char *end;
+        double fx, fz;
+        for ( int i = m_start[datum];
+              i < m_start[datum+1];
+              i++ )
+        {
+            // Read the coordinate pair
+            fx = strtod( ptr, &end );
+            fz = strtod( end, &end );
+            // Convert from WORLD into DIAGRAM (inches)
+            m_x[i]    = m_figWd * ( ( fx - m_gXMin ) / ( m_gXMax - m_gXMin ) );
+            m_yTop[i] = m_figHt * ( ( m_gYMax - fz ) / ( m_gYMax + m_gYMax ) );
+            m_yBot[i] = m_figHt * ( ( m_gYMax + fz ) / ( m_gYMax + m_gYMax ) );
+            // Advance to the next coordinate record
+            if ( ( ptr = strchr( end, '\n' ) ) != 0 )
+            {
+                ptr++;
+            }
+            else
+            {
+                ptr = end;
+            }
+        }
+        return;
+    }
+
+    const char   *m_text;       //!< Decoded trace text
+    const long   *m_fpos;       //!< Offset of each data set's first point
+    const int    *m_dataSet;    //!< Data set of each pane
+    const double *m_steps;      //!< Number of points in each data set
+    double m_figWd;             //!< Figure width (inches)
+    double m_figHt;             //!< Figure height (inches)
+    double m_gXMin;             //!< Diagram WORLD minimum X
+    double m_gXMax;             //!< Diagram WORLD maximum X
+    double m_gYMax;             //!< Diagram WORLD maximum Y
+};
 
 //------------------------------------------------------------------------------
 /*! \brief Composes the Contain Module's fire shape diagram.
+ *
+ *  The fireline of every pane is first decoded and scaled in parallel by a
+ *  ContainDiagramGeometry, then each page is written to the Composer.
  */
 
 void BpDocument::composeContainDiagram( void )
@@ -151,16 +270,23 @@ void BpDocument::composeContainDiagram( void )
     legendHt = ( legendMetrics.lineSpacing() + m_screenSize->m_padHt ) / yppi;
     // END THE STANDARD PREAMBLE USED BY ALL TABLE COMPOSITION FUNCTIONS.
 
-    // Attempt to open the temporary file with the fire shape data.
+    // Attempt to decode the binary trace file with the fire shape data
+    // into a scratch text file.
     QString fileName = m_eqTree->m_traceFile;
     FILE *fptr = 0;
-    if ( ! ( fptr = fopen( fileName.latin1(), "r" ) ) )
+    if ( ! ( fptr = tmpfile() )
+      || ! EqTrace::decode( fileName, fptr ) )
     // This code block should never be executed!
     {
+        if ( fptr )
+        {
+            fclose( fptr );
+        }
         translate( text, "BpDocument:Diagrams:UnableToOpenTempFile", fileName );
         error( text );
         return;
     }
+    rewind( fptr );
 
     // Subscript constants for the CONTAIN input and output variables
     const int SPREAD = 0;
@@ -316,8 +442,15 @@ void BpDocument::composeContainDiagram( void )
         }
     }
 
-    // Rewind the file.
+    // Read the entire decoded trace text into memory and close the file.
+    fseek( fptr, 0, SEEK_END );
+    long bytes = ftell( fptr );
     rewind( fptr );
+    char *traceText = new char[ bytes + 1 ];
+    checkmem( __FILE__, __LINE__, traceText, "char traceText", bytes + 1 );
+    bytes = (long) fread( traceText, 1, bytes, fptr );
+    traceText[bytes] = '\0';
+    fclose( fptr );
 
     // Determine maximum fire and fireline distances
     int i;
@@ -453,6 +586,11 @@ void BpDocument::composeContainDiagram( void )
             left[pane] = m_pageSize->m_marginLeft + col * paneWd;
         }
     }
+    // Decode and scale every pane's constructed fireline in parallel
+    ContainDiagramGeometry geometry( traceText, fpos, dataSet, val[STEPS],
+        cells, figWd, figHt, gXMin, gXMax, gYMax );
+    geometry.run( cells );
+
     // Get translated text
     QString title("");
     translate( title, "BpDocument:Diagrams:ContainTitle" );
@@ -636,29 +774,16 @@ void BpDocument::composeContainDiagram( void )
 
                     // Draw fireline constructed
                     m_composer->pen( firelinePen );
-                    if ( fseek( fptr, fpos[dataSet[datum]], SEEK_SET ) )
-                    {
-                        text = QString( "Unable to position to file %1 byte %2 "
-                            " for Contain Diagram %3" )
-                            .arg( fileName ).arg( fpos[dataSet[datum]] ).arg( datum );
-                        bomb( text );
-                    }
-                    for ( i = 0;
-                          i < (int) (val[STEPS][dataSet[datum]] + 0.1 );
+                    for ( i = geometry.m_start[datum];
+                          i < geometry.m_start[datum+1];
                           i++ )
                     {
-                        // Read the coordinate pair
-                        fgets( buffer, sizeof(buffer), fptr );
-                        sscanf( buffer, "%lf %lf", &fx, &fz );
-                        // Convert from WORLD into DIAGRAM (inches)
-                        fx = left[pane]
-                           + figWd * ( ( fx - gXMin ) / ( gXMax - gXMin ) );
-                        fy = top[pane] + figTop
-                           + figHt * ( ( gYMax - fz ) / ( gYMax + gYMax ) );
-                        fz = top[pane] + figTop
-                           + figHt * ( ( gYMax + fz ) / ( gYMax + gYMax ) );
+                        // Place the precomputed point within the pane
+                        fx = left[pane] + geometry.m_x[i];
+                        fy = top[pane] + figTop + geometry.m_yTop[i];
+                        fz = top[pane] + figTop + geometry.m_yBot[i];
                         // If not the first point, draw the line segment
-                        if ( i )
+                        if ( i > geometry.m_start[datum] )
                         {
                             m_composer->line( l_x,  l_y, fx, fy );
                             m_composer->line( l_x,  z, fx, fz );
@@ -771,6 +896,7 @@ void BpDocument::composeContainDiagram( void )
                     if ( progress->wasCancelled() )
                     {
                         delete progress;    progress = 0;
+                        delete[] traceText; traceText = 0;
                         return;
                     }
                 }   // Next paneCol
@@ -778,11 +904,9 @@ void BpDocument::composeContainDiagram( void )
         }   // Next pageCol
     }   // Next pageRow
 
-    // Close the file.
-    fclose( fptr );
-
     // Clean up and return
     delete progress;    progress = 0;
+    delete[] traceText; traceText = 0;
     for ( parm = 0;
           parm < PARMS;
           parm++ )
@@ -14,8 +14,10 @@
 #include "composer.h"
 #include "docdevicesize.h"
 #include "docpagesize.h"
+#include "panegeometry.h"
 #include "property.h"
 #include "xeqcalc.h"
+#include "xeqresultstore.h"
 #include "xeqtree.h"
 #include "xeqvar.h"
 #include "xeqvaritem.h"
@@ -137,8 +139,8 @@ void BpDocument::composeFireMaxDirDiagram( void )
 
     // Open the result file
     QString resultFile = m_eqTree->m_resultFile;
-    FILE *fptr = 0;
-    if ( ! ( fptr = fopen( resultFile.latin1(), "r" ) ) )
+    EqResultStore store;
+    if ( ! store.open( resultFile ) )
     // This code block should never be executed!
     {
         translate( text, "BpDocument:Diagrams:UnableToOpenTempFile",
@@ -245,46 +247,19 @@ void BpDocument::composeFireMaxDirDiagram( void )
     rosDir = new double[ cells ];
     checkmem( __FILE__, __LINE__, rosDir, "double rosDir", cells );
 
-    char   buffer[1024], varName[128];
-    int    row, col, cell;
-    double value;
-    while ( fgets( buffer, sizeof(buffer), fptr ) )
+    // As of V6, the maxDirName could also be the rosDirName,
+    // so need to get them both
+    store.column( maxDirName, maxDir );
+    store.column( rosDirName, rosDir );
+    if ( wind )
     {
-        if ( strncmp( buffer, "CELL", 4 ) == 0 )
-        {
-            if ( strstr( buffer, maxDirName ) )
-            {
-                sscanf( buffer, "CELL %d %d %s cont %lf",
-                    &row, &col, varName, &value );
-                cell = ( col - 1 ) + ( cols * ( row - 1) );
-                maxDir[ cell ] = value;
-            }
-			// As of V6, the maxDirName could also be the rosDirName,
-			// so need to get them both
-            if ( rosDir && strstr( buffer, rosDirName ) )
-            {
-                sscanf( buffer, "CELL %d %d %s cont %lf",
-                    &row, &col, varName, &value );
-                cell = ( col - 1 ) + ( cols * ( row - 1) );
-                rosDir[ cell ] = value;
-            }
-            else if ( wind && strstr( buffer, windName ) )
-            {
-                sscanf( buffer, "CELL %d %d %s cont %lf",
-                    &row, &col, varName, &value );
-                cell = ( col - 1 ) + ( cols * ( row - 1) );
-                wind[ cell ] = value;
-            }
-            else if ( aspect && strstr( buffer, aspectName ) )
-            {
-                sscanf( buffer, "CELL %d %d %s cont %lf",
-                    &row, &col, varName, &value );
-                cell = ( col - 1 ) + ( cols * ( row - 1) );
-                aspect[ cell ] = value;
-            }
-        }
+        store.column( windName, wind );
     }
-    fclose( fptr );
+    if ( aspect )
+    {
+        store.column( aspectName, aspect );
+    }
+    int row, col, cell;
 
     // Determine number of diagram panes on each page.
     int paneCols = property()->integer( "surfaceFireMaxDirDiagramCols" );
@@ -354,6 +329,17 @@ void BpDocument::composeFireMaxDirDiagram( void )
     translate( windVector, "BpDocument:Diagrams:DirOfWindVector" );
     QString desc( m_eqTree->m_eqCalc->docDescriptionStore().stripWhiteSpace() );
 
+    // Compute every pane's vector directions in parallel
+    FireDiagramGeometry geometry;
+    geometry.m_wind           = wind;
+    geometry.m_aspect         = aspect;
+    geometry.m_degreesNorth   = degreesNorth;
+    geometry.m_degreesUpslope = degreesUpslope;
+    geometry.m_windDirInput   = windDirInput;
+    geometry.m_windDirUpslope = windDirUpslope;
+    geometry.allocate( cells );
+    geometry.run( cells );
+
     // Loop for each PAGE across and down.
     double yPos, deg;
     double arrow = 0.5 * textHt;
@@ -612,24 +598,13 @@ void BpDocument::composeFireMaxDirDiagram( void )
                         *(maxDirVar->m_label) );
 
                     // Draw the wind flow direction vector
+                    deg = geometry.m_windDeg[datum];
                     if ( windDirInput )
                     {
-                        deg = wind[datum];
                         qStr1 = *(windVar->m_label);
                     }
                     else if ( windDirUpslope )
                     {
-                        if ( degreesUpslope )
-                        {
-                            deg = 0;
-                        }
-                        else if ( degreesNorth )
-                        {
-                            if ( ( deg = aspect[datum] - 180 ) < 0. )
-                            {
-                                deg += 360.;
-                            }
-                        }
                         qStr1 = windVector;
                     }
                     yPos = top[pane] + figTop + 0.19 * figHt;
@@ -686,12 +661,7 @@ void BpDocument::composeFireMaxDirDiagram( void )
                     // Draw the upslope vector if using compass coordinate system
                     if ( aspectVar )
                     {
-                        deg = ( aspect )
-                              ? aspect[datum]
-                              : 180.;
-                        deg += ( deg < 180 )
-                              ? 180.
-                              : -180. ;
+                        deg = geometry.m_slopeDeg[datum];
                         yPos = top[pane] + figTop + 0.26 * figHt;
                         m_composer->font( legendFont );
                         m_composer->pen( slopePen );
@@ -13,8 +13,10 @@
 #include "composer.h"
 #include "docdevicesize.h"
 #include "docpagesize.h"
+#include "panegeometry.h"
 #include "property.h"
 #include "xeqcalc.h"
+#include "xeqresultstore.h"
 #include "xeqtree.h"
 #include "xeqvar.h"
 #include "xeqvaritem.h"
@@ -138,8 +140,8 @@ void BpDocument::composeFireShapeDiagram( void )
 
     // Open the result file
     QString resultFile = m_eqTree->m_resultFile;
-    FILE *fptr = 0;
-    if ( ! ( fptr = fopen( resultFile.latin1(), "r" ) ) )
+    EqResultStore store;
+    if ( ! store.open( resultFile ) )
     // This code block should never be executed!
     {
         translate( text, "BpDocument:Diagrams:UnableToOpenTempFile",
@@ -314,93 +316,42 @@ void BpDocument::composeFireShapeDiagram( void )
 
     // Read and store up to 12 values per cell (head, leng, width, maxDir,
     // rosDir, wind, aspect, area, perim, etime, and back)
-    char   buffer[1024], varName[128];
-    int    row, col, cell;
-    double value;
-    while ( fgets( buffer, sizeof(buffer), fptr ) )
+    store.column( headName, head );
+    store.column( lengName, leng );
+    store.column( widthName, l_width );
+    if ( maxDir )
     {
-        if ( strncmp( buffer, "CELL", 4 ) == 0 )
-        {
-            if ( strstr( buffer, headName ) )
-            {
-                sscanf( buffer, "CELL %d %d %s cont %lf",
-                    &row, &col, varName, &value );
-                cell = ( col - 1 ) + ( cols * ( row - 1) );
-                head[ cell ] = value;
-            }
-            else if ( strstr( buffer, lengName ) )
-            {
-                sscanf( buffer, "CELL %d %d %s cont %lf",
-                    &row, &col, varName, &value );
-                cell = ( col - 1 ) + ( cols * ( row - 1) );
-                leng[ cell ] = value;
-            }
-            else if ( strstr( buffer, widthName ) )
-            {
-                sscanf( buffer, "CELL %d %d %s cont %lf",
-                    &row, &col, varName, &value );
-                cell = ( col - 1 ) + ( cols * ( row - 1) );
-                l_width[ cell ] = value;
-            }
-            else if ( strstr( buffer, maxDirName ) )
-            {
-                sscanf( buffer, "CELL %d %d %s cont %lf",
-                    &row, &col, varName, &value );
-                cell = ( col - 1 ) + ( cols * ( row - 1) );
-                maxDir[ cell ] = value;
-            }
-            else if ( wind && strstr( buffer, windName ) )
-            {
-                sscanf( buffer, "CELL %d %d %s cont %lf",
-                    &row, &col, varName, &value );
-                cell = ( col - 1 ) + ( cols * ( row - 1) );
-                wind[ cell ] = value;
-            }
-            else if ( aspect && strstr( buffer, aspectName ) )
-            {
-                sscanf( buffer, "CELL %d %d %s cont %lf",
-                    &row, &col, varName, &value );
-                cell = ( col - 1 ) + ( cols * ( row - 1) );
-                aspect[ cell ] = value;
-            }
-            else if ( rosDir && strstr( buffer, rosDirName ) )
-            {
-                sscanf( buffer, "CELL %d %d %s cont %lf",
-                    &row, &col, varName, &value );
-                cell = ( col - 1 ) + ( cols * ( row - 1) );
-                rosDir[ cell ] = value;
-            }
-            else if ( area && strstr( buffer, areaName ) )
-            {
-                sscanf( buffer, "CELL %d %d %s cont %lf",
-                    &row, &col, varName, &value );
-                cell = ( col - 1 ) + ( cols * ( row - 1) );
-                area[ cell ] = value;
-            }
-            else if ( perim && strstr( buffer, perimName ) )
-            {
-                sscanf( buffer, "CELL %d %d %s cont %lf",
-                    &row, &col, varName, &value );
-                cell = ( col - 1 ) + ( cols * ( row - 1) );
-                perim[ cell ] = value;
-            }
-            else if ( etime && strstr( buffer, timeName ) )
-            {
-                sscanf( buffer, "CELL %d %d %s cont %lf",
-                    &row, &col, varName, &value );
-                cell = ( col - 1 ) + ( cols * ( row - 1) );
-                etime[ cell ] = value;
-            }
-            else if ( back && strstr( buffer, backName ) )
-            {
-                sscanf( buffer, "CELL %d %d %s cont %lf",
-                    &row, &col, varName, &value );
-                cell = ( col - 1 ) + ( cols * ( row - 1) );
-                back[ cell ] = value;
-            }
-        }
+        store.column( maxDirName, maxDir );
+    }
+    if ( wind )
+    {
+        store.column( windName, wind );
+    }
+    if ( aspect )
+    {
+        store.column( aspectName, aspect );
+    }
+    if ( rosDir )
+    {
+        store.column( rosDirName, rosDir );
     }
-    fclose( fptr );
+    if ( area )
+    {
+        store.column( areaName, area );
+    }
+    if ( perim )
+    {
+        store.column( perimName, perim );
+    }
+    if ( etime )
+    {
+        store.column( timeName, etime );
+    }
+    if ( back )
+    {
+        store.column( backName, back );
+    }
+    int row, col, cell;
 
     // Determine maximum values for scaling purposes
     double maxLeng = leng[0];
@@ -509,6 +460,22 @@ void BpDocument::composeFireShapeDiagram( void )
     translate( windVector, "BpDocument:Diagrams:DirOfWindVector" );
     QString desc( m_eqTree->m_eqCalc->docDescriptionStore().stripWhiteSpace() );
 
+    // Compute every pane's ellipse and vector directions in parallel
+    FireDiagramGeometry geometry;
+    geometry.m_leng           = leng;
+    geometry.m_width          = l_width;
+    geometry.m_head           = head;
+    geometry.m_wind           = wind;
+    geometry.m_aspect         = aspect;
+    geometry.m_maxLeng        = maxLeng;
+    geometry.m_figHt          = figHt;
+    geometry.m_degreesNorth   = degreesNorth;
+    geometry.m_degreesUpslope = degreesUpslope;
+    geometry.m_windDirInput   = windDirInput;
+    geometry.m_windDirUpslope = windDirUpslope;
+    geometry.allocate( cells );
+    geometry.run( cells );
+
     // Loop for each PAGE across and down.
     double xPos, yPos, ellipseHt, ellipseWd, deg;
     double arrow = 0.5 * textHt;
@@ -635,12 +602,8 @@ void BpDocument::composeFireShapeDiagram( void )
                     // ellipse height is half the figure space;
                     // otherwise it can use the entire figure space
                     // since it doesn't have to rotate around the origin
-                    ellipseHt = ( maxLeng < 0.00001 )
-                        ? 0.0
-                        : 0.5 * figHt * leng[datum] / maxLeng;
-                    ellipseWd = ( leng[datum] < 0.00001 )
-                        ? 0.0
-                        : ellipseHt * l_width[datum] / leng[datum];
+                    ellipseHt = geometry.m_ellipseHt[datum];
+                    ellipseWd = geometry.m_ellipseWd[datum];
 
                     // Draw the fire coordinate system
                     // If vSurfaceFireMaxDirFromNorth is an output variable,
@@ -694,24 +657,13 @@ void BpDocument::composeFireShapeDiagram( void )
                     //}
                     if ( surfaceModuleActive )
                     {
+                        deg = geometry.m_windDeg[datum];
                         if ( windDirInput )
                         {
-                            deg = wind[datum];
                             qStr1 = *(windVar->m_label);
                         }
                         else if ( windDirUpslope )
                         {
-                            if ( degreesUpslope )
-                            {
-                                deg = 0;
-                            }
-                            else if ( degreesNorth )
-                            {
-                                if ( ( deg = aspect[datum] - 180 ) < 0. )
-                                {
-                                    deg += 360.;
-                                }
-                            }
                             qStr1 = windVector;
                         }
                         yPos = top[pane] + figTop + 0.10 * figHt;
@@ -808,12 +760,7 @@ void BpDocument::composeFireShapeDiagram( void )
                         // Draw the upslope vector if using compass coordinate system
                         if ( aspectVar )
                         {
-                            deg = ( aspect )
-                                  ? aspect[datum]
-                                  : 180.;
-                            deg += ( deg < 180 )
-                                   ? 180.
-                                   : -180. ;
+                            deg = geometry.m_slopeDeg[datum];
                             yPos = top[pane] + figTop + 0.20 * figHt;
                             m_composer->font( legendFont );
                             m_composer->pen( slopePen );
@@ -852,9 +799,7 @@ void BpDocument::composeFireShapeDiagram( void )
 
                     // Upper-left corner of the unrotated fire ellipse
                     xPos = x0[pane] - 0.5 * ellipseWd;
-                    yPos = ( leng[datum] < 0.00001 )
-                        ? y0[pane]
-                        : y0[pane] - ( ellipseHt * head[datum] / leng[datum] );
+                    yPos = y0[pane] - geometry.m_ellipseDy[datum];
 
                     // Draw the fire ellipse rotated about the origin
                     m_composer->pen( perimPen );
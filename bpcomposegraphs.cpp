@@ -46,9 +46,6 @@ const int graphMaxBars  = 255;
 //! Maximum number of lines per graph.
 const int graphMaxLines = 255;
 
-//! Maximum number of points calculated per graph line.
-const int graphMaxSteps = 100;
-
 //------------------------------------------------------------------------------
 /*! \brief Determines the minimum and maximum data point Y values
  *  of all bars of a bar graph.
@@ -240,13 +237,16 @@ void BpDocument::composeBarGraph( int yid, EqVar *xVar, EqVar *yVar,
  *                      If FALSE, displays bar graphs.
  *  \param showDialogs  If TRUE, the Run Dialog and possibly the Graph Limits
  *              Dialog will be shown.  This is set FALSE if -auto is specified.
+ *  \param yParmsList   Y axle parameters already determined by graphYParms()
+ *              (which is then not called), or NULL.
  *
- *  Called only by BpDocument::runWorksheet().
+ *  Called only by BpDocument::composePending().
  *
  *  \return TRUE if all the graphs are composed, FALSE if not.
  */
 
-bool BpDocument::composeGraphs( bool lineGraphs, bool showDialogs )
+bool BpDocument::composeGraphs( bool lineGraphs, bool showDialogs,
+        QPtrList<GraphAxleParms> *yParmsList )
 {
 
     // Bar graph settings
@@ -273,71 +273,12 @@ bool BpDocument::composeGraphs( bool lineGraphs, bool showDialogs )
     EqVar *zVar = m_eqTree->m_rangeVar[1];
     EqVar *yVar = 0;
 
-    //--------------------------------------------------------------------------
-    // 2: Determine nice axis parameters for the x- and all the y-variables.
-    //--------------------------------------------------------------------------
-
-    // Initialize the Y axle for each graph to a nice range
-    QPtrList<GraphAxleParms> *yParmsList = new QPtrList<GraphAxleParms>();
-    yParmsList->setAutoDelete( true );
+    // Determine (and let the user change) the y axle parameters.
+    QPtrList<GraphAxleParms> *yList = ( yParmsList )
+        ? yParmsList
+        : graphYParms( lineGraphs, showDialogs );
     GraphAxleParms *yParms = 0;
     int yid;
-    for ( yid = 0;
-          yid < tableVars();
-          yid++ )
-    {
-        yVar = tableVar( yid );
-        yParms = 0;
-        // The yVar must be continuous.
-        if ( yVar->isContinuous() )
-        {
-            // Get Y range
-            if ( lineGraphs )
-            {
-                graphYMinMax( yid, min, max );
-            }
-            else
-            {
-                barYMinMax( yid, min, max );
-            }
-            // Determine and store nice axis parameters
-            tics = 11;
-            yParms = new GraphAxleParms( min, max, tics );
-            checkmem( __FILE__, __LINE__, yParms, "GraphAxleParms yParms", 1 );
-            yParmsList->append( yParms );
-            // If bar graph, or line graphs must start at origin
-            if ( min > 0. )
-            {
-                if ( ! lineGraphs
-                    || property()->boolean( "graphYOriginAtZero" ) )
-                {
-                    yParms->useOrigin();
-                }
-            }
-            // If min and max are the same, make them different
-            if ( min == max )
-            {
-                yParms->setAxle( min-1., max+1., 3 );
-            }
-        }
-    }
-
-    //--------------------------------------------------------------------------
-    // 1: Allow the user to change the axle parameters.
-    //--------------------------------------------------------------------------
-
-    if ( showDialogs
-      && property()->boolean( "graphYUserRange" ) )
-    {
-        GraphLimitsDialog *dialog =
-            new GraphLimitsDialog( this, yParmsList, "graphLimitsDialog" );
-        checkmem( __FILE__, __LINE__, dialog, "GraphLimitsDialog dialog", 1 );
-        if ( dialog->exec() == QDialog::Accepted )
-        {
-            dialog->store();
-        }
-        delete dialog;  dialog = 0;
-    }
 
     //--------------------------------------------------------------------------
     // 3: Draw each graph.
@@ -364,7 +305,7 @@ bool BpDocument::composeGraphs( bool lineGraphs, bool showDialogs )
 
     // Loop for each output variable: one graph is composed per output variable.
     bool result = true;
-    for ( yid = 0, yParms = yParmsList->first();
+    for ( yid = 0, yParms = yList->first();
           yid < tableVars();
           yid++ )
     {
@@ -404,13 +345,16 @@ bool BpDocument::composeGraphs( bool lineGraphs, bool showDialogs )
                 result = false;
                 break;
             }
-            yParms = yParmsList->next();
+            yParms = yList->next();
         }
     }
     // Cleanup and return.
     delete progress;    progress = 0;
     delete xParms;      xParms = 0;
-    delete yParmsList;  yParmsList = 0;
+    if ( ! yParmsList )
+    {
+        delete yList;   yList = 0;
+    }
     return( result );
 }
 
@@ -517,6 +461,12 @@ void BpDocument::composeGraphBasics( Graph *g,
 		subTitle += fireDir;
 		str = subTitle.latin1();
 	}
+    // Sweep slices show the fixed values of the other range variables
+    if ( ! m_eqTree->m_tableSlice.isEmpty() )
+    {
+        subTitle += ( subTitle.length() > 0 ) ? "\n" : "";
+        subTitle += m_eqTree->m_tableSlice;
+    }
 	g->setSubTitle( subTitle, subTitleFont, subTitleColor );
 
 	// Use portrait orientation (assuming screen output, not printer).
@@ -837,13 +787,15 @@ void BpDocument::composeLineGraph( int yid, EqVar *xVar, EqVar *yVar,
     // Initialize graph and variables
     Graph      g;
     GraphLine *line[graphMaxLines];
-    double     l_x[graphMaxSteps];
-    double     l_y[graphMaxSteps];
     int        curves = ( tableCols() < graphMaxLines )
                   ? ( tableCols() )
                   : ( graphMaxLines );
     int        points = tableRows();
     int        vStep  = tableCols() * tableVars();
+    // Adaptive graph runs may have any number of irregularly spaced points
+    double    *l_x = new double[ 2 * points ];
+    checkmem( __FILE__, __LINE__, l_x, "double l_x", 2 * points );
+    double    *l_y = l_x + points;
 
     // Loop for each zVar family curve value in this graph (or at least once!).
     // Note that zVar count is in tableCols(), e.g. each column stores a curve,
@@ -1035,6 +987,7 @@ void BpDocument::composeLineGraph( int yid, EqVar *xVar, EqVar *yVar,
 
     // Be polite and stop the composer.
     m_composer->end();
+    delete[] l_x;
     delete[] color;
     return;
 }
@@ -1096,6 +1049,96 @@ void BpDocument::graphYMinMax( int yid, double &yMin, double &yMax )
     return;
 }
 
+//------------------------------------------------------------------------------
+/*! \brief Determines nice y axle parameters for each continuous output
+ *  variable's graph, and allows the user to change them.
+ *
+ *  \param lineGraphs   If TRUE, for line graphs; if FALSE, for bar graphs.
+ *  \param showDialogs  If TRUE, the Graph Limits Dialog is displayed if the
+ *                      "graphYUserRange" property is TRUE.
+ *
+ *  Uses the EqTree's current run tables, so it is called at run time for
+ *  graphs whose composition is deferred (see composeGraphsLater()).
+ *
+ *  \return Pointer to a new list of GraphAxleParms, one per continuous
+ *  output variable, which the caller must delete.
+ */
+
+QPtrList<GraphAxleParms> *BpDocument::graphYParms( bool lineGraphs,
+        bool showDialogs )
+{
+    double min, max;
+    int tics;
+
+    //--------------------------------------------------------------------------
+    // 2: Determine nice axis parameters for the x- and all the y-variables.
+    //--------------------------------------------------------------------------
+
+    // Initialize the Y axle for each graph to a nice range
+    QPtrList<GraphAxleParms> *yParmsList = new QPtrList<GraphAxleParms>();
+    yParmsList->setAutoDelete( true );
+    GraphAxleParms *yParms = 0;
+    EqVar *yVar = 0;
+    int yid;
+    for ( yid = 0;
+          yid < tableVars();
+          yid++ )
+    {
+        yVar = tableVar( yid );
+        yParms = 0;
+        // The yVar must be continuous.
+        if ( yVar->isContinuous() )
+        {
+            // Get Y range
+            if ( lineGraphs )
+            {
+                graphYMinMax( yid, min, max );
+            }
+            else
+            {
+                barYMinMax( yid, min, max );
+            }
+            // Determine and store nice axis parameters
+            tics = 11;
+            yParms = new GraphAxleParms( min, max, tics );
+            checkmem( __FILE__, __LINE__, yParms, "GraphAxleParms yParms", 1 );
+            yParmsList->append( yParms );
+            // If bar graph, or line graphs must start at origin
+            if ( min > 0. )
+            {
+                if ( ! lineGraphs
+                    || property()->boolean( "graphYOriginAtZero" ) )
+                {
+                    yParms->useOrigin();
+                }
+            }
+            // If min and max are the same, make them different
+            if ( min == max )
+            {
+                yParms->setAxle( min-1., max+1., 3 );
+            }
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    // 1: Allow the user to change the axle parameters.
+    //--------------------------------------------------------------------------
+
+    if ( showDialogs
+      && property()->boolean( "graphYUserRange" ) )
+    {
+        GraphLimitsDialog *dialog =
+            new GraphLimitsDialog( this, yParmsList, "graphLimitsDialog" );
+        checkmem( __FILE__, __LINE__, dialog, "GraphLimitsDialog dialog", 1 );
+        if ( dialog->exec() == QDialog::Accepted )
+        {
+            dialog->store();
+        }
+        delete dialog;  dialog = 0;
+    }
+    return( yParmsList );
+}
+
 //------------------------------------------------------------------------------
 //  End of bpcomposegraphs.cpp
 //------------------------------------------------------------------------------
@@ -33,6 +33,7 @@
 #include "graphline.h"
 #include "graphmarker.h"
 #include "property.h"
+#include "xeqresultstore.h"
 #include "xeqtree.h"
 
 // Standard include files
@@ -71,8 +72,8 @@ void BpDocument::composeFireCharacteristicsDiagram( void )
 
     // Open the result file
     QString resultFile = m_eqTree->m_resultFile;
-    FILE *fptr = 0;
-    if ( ! ( fptr = fopen( resultFile.latin1(), "r" ) ) )
+    EqResultStore store;
+    if ( ! store.open( resultFile ) )
     // This code block should never be executed!
     {
         QString text("");
@@ -97,38 +98,24 @@ void BpDocument::composeFireCharacteristicsDiagram( void )
         rosName = "vSurfaceFireSpreadAtVector";
     }
     // Read and store the ros and hpua values
-    char   buffer[1024], varName[128], varUnits[128];
-    int    row, col, cell;
-    double value;
+    int    cell;
     double rosMax = 0.0;
     double hpuaMax = 0.0;
-    while ( fgets( buffer, sizeof(buffer), fptr ) )
+    store.column( hpuaName, hpua );
+    store.column( rosName, ros );
+    for ( cell = 0;
+          cell < cells;
+          cell++ )
     {
-        if ( strncmp( buffer, "CELL", 4 ) == 0 )
+        if ( hpua[ cell ] > hpuaMax )
         {
-            if ( strstr( buffer, hpuaName ) )
-            {
-                sscanf( buffer, "CELL %d %d %s cont %lf %s",
-                    &row, &col, varName, &value, varUnits );
-                cell = ( col - 1 ) + ( cols * ( row - 1) );
-                if ( ( hpua[ cell ] = value ) > hpuaMax )
-                {
-                    hpuaMax = value;
-                }
-            }
-            else if ( strstr( buffer, rosName ) )
-            {
-                sscanf( buffer, "CELL %d %d %s cont %lf %s",
-                    &row, &col, varName, &value, varUnits );
-                cell = ( col - 1 ) + ( cols * ( row - 1) );
-                if ( ( ros[ cell ] = value ) > rosMax )
-                {
-                    rosMax = value;
-                }
-            }
+            hpuaMax = hpua[ cell ];
+        }
+        if ( ros[ cell ] > rosMax )
+        {
+            rosMax = ros[ cell ];
         }
     }
-    fclose( fptr );
 
     // Get variable pointers
     EqVar *hpuaVar = m_eqTree->m_varDict->find( "vSurfaceFireHeatPerUnitArea" );
@@ -0,0 +1,362 @@
+//------------------------------------------------------------------------------
+/*! \file bpcomposepending.cpp
+ *  \version BehavePlus6
+ *  \author Copyright (C) 2002-2018 by Collin D. Bevins.  All rights reserved.
+ *
+ *  \brief BpDocument deferred results page composition methods.
+ *
+ *  runWorksheet() records the results sections as BpPageTasks, whose pages
+ *  are composed only as they are shown, printed, or listed in the table of
+ *  contents, and ahead of time by composeAhead() while the user is idle.
+ *
+ *  Additional BehavePlusDocument method definitions are in:
+ *      - bpdocument.cpp
+ *      - bpcomposedoc.cpp
+ *      - bpcomposegraphs.cpp
+ *      - bpcomposepage.cpp
+ *      - bpcomposetable3.cpp
+ */
+
+// Custom include files
+#include "appfilesystem.h"
+#include "appmessage.h"
+#include "bpdocument.h"
+#include "graphaxle.h"
+#include "property.h"
+#include "xeqtree.h"
+#include "xeqvar.h"
+
+// Qt include files
+#include <qtimer.h>
+
+// Standard include files
+#include <stdio.h>
+
+//------------------------------------------------------------------------------
+/*! \brief Next BpPageTask result and trace file id, unique to this process.
+ */
+
+static int PageTaskFileId = 100;
+
+//------------------------------------------------------------------------------
+/*! \brief BpPageTask constructor.
+ */
+
+BpPageTask::BpPageTask( void ) :
+    m_type(0),
+    m_vid(0),
+    m_rowVar(0),
+    m_colVar(0),
+    m_lineGraphs(true),
+    m_needsRun(false),
+    m_run(0),
+    m_yParmsList(0),
+    m_resultFile(""),
+    m_traceFile(""),
+    m_removeFiles(false)
+{
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief BpPageTask destructor.
+ *
+ *  Releases the graph y axles and removes the diagram result and trace
+ *  files the task took over from the run.
+ */
+
+BpPageTask::~BpPageTask( void )
+{
+    delete m_yParmsList;    m_yParmsList = 0;
+    if ( m_removeFiles )
+    {
+        if ( ! m_resultFile.isEmpty() )
+        {
+            remove( m_resultFile.latin1() );
+        }
+        if ( ! m_traceFile.isEmpty() )
+        {
+            remove( m_traceFile.latin1() );
+        }
+    }
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Slot called by the #m_pageTimer when the application is idle to
+ *  compose the next pending results page section.
+ *
+ *  Composes one section per call and re-arms the timer until the
+ *  \a appComposeAheadPages property number of pages beyond the current
+ *  page have been composed, so user events are processed between sections.
+ */
+
+void BpDocument::composeAhead( void )
+{
+    if ( m_pageHold || m_pageComposing || m_pageTasks->isEmpty() )
+    {
+        return;
+    }
+    int ahead = property()->integer( "appComposeAheadPages" );
+    if ( m_pages >= m_page + ahead )
+    {
+        return;
+    }
+    composePending( m_pages + 1 );
+    if ( ! m_pageTasks->isEmpty() && m_pages < m_page + ahead )
+    {
+        m_pageTimer->start( 0, true );
+    }
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Records runWorksheet()'s diagrams to be composed later.
+ *
+ *  The diagrams read the run's result and trace files, so the diagram
+ *  section takes them over under names of its own.  They are removed with
+ *  the section if the "appDeleteRunLogFile" property is TRUE.  If a file
+ *  cannot be renamed, the diagrams are composed now instead.
+ *
+ *  Called only by BpDocument::runWorksheet().
+ */
+
+void BpDocument::composeDiagramsLater( void )
+{
+    QString resultFile(""), traceFile("");
+    if ( ! m_eqTree->m_resultFile.isEmpty() )
+    {
+        resultFile = appFileSystem()->tempFilePath( PageTaskFileId++ );
+        if ( rename( m_eqTree->m_resultFile.latin1(),
+                resultFile.latin1() ) != 0 )
+        {
+            composeDiagrams();
+            return;
+        }
+    }
+    if ( ! m_eqTree->m_traceFile.isEmpty() )
+    {
+        traceFile = appFileSystem()->tempFilePath( PageTaskFileId++ );
+        if ( rename( m_eqTree->m_traceFile.latin1(),
+                traceFile.latin1() ) != 0 )
+        {
+            traceFile = "";
+        }
+    }
+    pageTaskAdd( PageTaskDiagrams );
+    BpPageTask *task = m_pageTasks->getLast();
+    task->m_resultFile  = resultFile;
+    task->m_traceFile   = traceFile;
+    task->m_removeFiles = property()->boolean( "appDeleteRunLogFile" );
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Records runWorksheet()'s graphs to be composed later.
+ *
+ *  If the Graph Limits Dialog is to be displayed, it is displayed now while
+ *  the run is fresh, and the graph section keeps the y axles it returns.
+ *
+ *  \param lineGraphs   If TRUE, displays line graphs.
+ *                      If FALSE, displays bar graphs.
+ *  \param showDialogs  If TRUE, the Graph Limits Dialog may be shown.
+ *
+ *  Called only by BpDocument::runWorksheet().
+ */
+
+void BpDocument::composeGraphsLater( bool lineGraphs, bool showDialogs )
+{
+    pageTaskAdd( PageTaskGraphs, 0, 0, 0, lineGraphs );
+    if ( showDialogs
+      && property()->boolean( "graphYUserRange" ) )
+    {
+        m_pageTasks->getLast()->m_yParmsList =
+            graphYParms( lineGraphs, showDialogs );
+    }
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Composes pending results page sections, in the order they were
+ *  recorded, until page \a thruPage exists.
+ *
+ *  Each section's run tables are swapped into the EqTree while it is
+ *  composed and swapped back out afterwards, so the EqTree's current run
+ *  tables (if any) are undisturbed.  The run tables are released once the
+ *  last section has been composed.
+ *
+ *  Re-implemented from Document::composePending().
+ *
+ *  \param thruPage Last page number that must be composed,
+ *                  or -1 if all pages must be composed.
+ *
+ *  \return Number of pages in the Document.
+ */
+
+int BpDocument::composePending( int thruPage )
+{
+    // Sections start new pages, which call back here
+    if ( m_pageComposing || m_pageTasks->isEmpty() )
+    {
+        return( m_pages );
+    }
+    m_pageComposing = true;
+    BpPageTask *task;
+    while ( ( thruPage < 0 || m_pages < thruPage )
+         && ( task = m_pageTasks->getFirst() ) )
+    {
+        if ( task->m_run )
+        {
+            m_eqTree->runSwap( task->m_run );
+        }
+        if ( task->m_type == PageTaskTable3 )
+        {
+            composeTable3( task->m_vid, task->m_rowVar, task->m_colVar );
+        }
+        else if ( task->m_type == PageTaskGraphs )
+        {
+            composeGraphs( task->m_lineGraphs, false, task->m_yParmsList );
+        }
+        else if ( task->m_type == PageTaskDiagrams )
+        {
+            // The diagrams read the run files the section took over
+            QString resultFile = m_eqTree->m_resultFile;
+            QString traceFile  = m_eqTree->m_traceFile;
+            m_eqTree->m_resultFile = task->m_resultFile;
+            m_eqTree->m_traceFile  = task->m_traceFile;
+            composeDiagrams();
+            m_eqTree->m_resultFile = resultFile;
+            m_eqTree->m_traceFile  = traceFile;
+        }
+        else if ( task->m_type == PageTaskDocumentation )
+        {
+            composeDocumentation();
+        }
+        if ( task->m_run )
+        {
+            m_eqTree->runSwap( task->m_run );
+        }
+        m_pageTasks->removeFirst();
+    }
+    if ( m_pageTasks->isEmpty() )
+    {
+        m_pageRuns->clear();
+    }
+    m_pageComposing = false;
+    return( m_pages );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Gives all pending sections that use the EqTree's current run
+ *  tables their own copy of them.
+ *
+ *  Must be called before the EqTree's run tables are cleaned or replaced
+ *  by another EqTree::runTable().
+ *
+ *  Called only by BpDocument::runWorksheet().
+ */
+
+void BpDocument::pageRunClose( void )
+{
+    if ( ! m_pageRunUsed )
+    {
+        return;
+    }
+    EqTreeRun *run = m_eqTree->runDetach();
+    m_pageRuns->append( run );
+    BpPageTask *task;
+    for ( task = m_pageTasks->first();
+          task;
+          task = m_pageTasks->next() )
+    {
+        if ( task->m_needsRun && ! task->m_run )
+        {
+            task->m_run = run;
+        }
+    }
+    m_pageRunUsed = false;
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Records a results page section to be composed later.
+ *
+ *  \param type         BpDocument::PageTaskType.
+ *  \param vid          Output table variable index (PageTaskTable3 only).
+ *  \param rowVar       Table row variable (PageTaskTable3 only).
+ *  \param colVar       Table column variable (PageTaskTable3 only).
+ *  \param lineGraphs   Line or bar graphs (PageTaskGraphs only).
+ *
+ *  Called by BpDocument::composeDiagramsLater(), composeGraphsLater(),
+ *  composeTable3(), and runWorksheet().
+ */
+
+void BpDocument::pageTaskAdd( int type, int vid, EqVar *rowVar,
+        EqVar *colVar, bool lineGraphs )
+{
+    BpPageTask *task = new BpPageTask();
+    checkmem( __FILE__, __LINE__, task, "BpPageTask task", 1 );
+    task->m_type       = type;
+    task->m_vid        = vid;
+    task->m_rowVar     = rowVar;
+    task->m_colVar     = colVar;
+    task->m_lineGraphs = lineGraphs;
+    task->m_needsRun   = ( type != PageTaskDocumentation );
+    m_pageTasks->append( task );
+    if ( task->m_needsRun )
+    {
+        m_pageRunUsed = true;
+    }
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Discards all pending results page sections and their run tables.
+ */
+
+void BpDocument::pageTasksClear( void )
+{
+    m_pageTimer->stop();
+    m_pageTasks->clear();
+    m_pageRuns->clear();
+    m_pageRunUsed = false;
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Determines if any results page sections have not yet been
+ *  composed.
+ *
+ *  Re-implemented from Document::pagesPending().
+ *
+ *  \return TRUE if composePending() has sections to compose.
+ */
+
+bool BpDocument::pagesPending( void ) const
+{
+    return( ! m_pageTasks->isEmpty() );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Removes all the Composer files created for this Document
+ *  starting at \a fromPageNumber.
+ *
+ *  Re-implemented from Document::removeComposerFiles() to also discard any
+ *  pending results page sections, since they would have followed the
+ *  removed pages.
+ *
+ *  \param fromPageNumber Number of the first page to be removed (the first
+ *  page is page 1, NOT PAGE 0).
+ */
+
+void BpDocument::removeComposerFiles( int fromPageNumber )
+{
+    pageTasksClear();
+    Document::removeComposerFiles( fromPageNumber );
+    return;
+}
+
+//------------------------------------------------------------------------------
+//  End of bpcomposepending.cpp
+//------------------------------------------------------------------------------
+
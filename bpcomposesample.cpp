@@ -0,0 +1,471 @@
+//------------------------------------------------------------------------------
+/*! \file bpcomposesample.cpp
+ *  \version BehavePlus6
+ *  \author Copyright (C) 2002-2018 by Collin D. Bevins.  All rights reserved.
+ *
+ *  \brief BpDocument uncertainty (sampled input) results composer.
+ *
+ *  Additional BehavePlusDocument method definitions are in:
+ *      - bpdocument.cpp
+ *      - bpcomposegraphs.cpp
+ *      - bpcomposepage.cpp
+ *      - bpcomposetable1.cpp
+ *      - bpcomposetable2.cpp
+ *      - bpcomposetable3.cpp
+ *      - bpcomposeworksheet.cpp
+ */
+
+// Custom include files
+#include "appmessage.h"
+#include "apptranslator.h"
+#include "bpdocument.h"
+#include "composer.h"
+#include "docdevicesize.h"
+#include "docpagesize.h"
+#include "property.h"
+#include "xeqcalc.h"
+#include "xeqsample.h"
+#include "xeqtree.h"
+#include "xeqvar.h"
+#include "xeqvaritem.h"
+
+// Qt include files
+#include <qbrush.h>
+#include <qfontmetrics.h>
+#include <qpen.h>
+
+//------------------------------------------------------------------------------
+/*! \brief Composes the uncertainty results of an EqSample run.
+ *
+ *  The page lists each uncertain input and its distribution, the mean,
+ *  standard deviation, and 5th, 25th, 50th, 75th, and 95th percentiles of
+ *  each continuous output, the relative frequency of each discrete output
+ *  item, the probability of being within prescription, and a histogram of
+ *  each continuous output.
+ *
+ *  \param sample Pointer to the completed EqSample.
+ *
+ *  Called only by BpDocument::runSample().
+ */
+
+void BpDocument::composeSample( EqSample *sample )
+{
+    // START THE STANDARD PREAMBLE USED BY ALL TABLE COMPOSITION FUNCTIONS.
+    // WIN98 requires that we actually create a font here and use it for
+    // font metrics rather than using the widget's font.
+    QFont subTitleFont( property()->string( "tableSubtitleFontFamily" ),
+                    property()->integer( "tableSubtitleFontSize" ) );
+    QPen subTitlePen( property()->color( "tableSubtitleFontColor" ) );
+    QFontMetrics subTitleMetrics( subTitleFont );
+
+    QFont textFont( property()->string( "tableTextFontFamily" ),
+                    property()->integer( "tableTextFontSize" ) );
+    QPen textPen( property()->color( "tableTextFontColor" ) );
+    QFontMetrics textMetrics( textFont );
+
+    QFont titleFont( property()->string( "tableTitleFontFamily" ),
+                    property()->integer( "tableTitleFontSize" ) );
+    QPen titlePen( property()->color( "tableTitleFontColor" ) );
+    QFontMetrics titleMetrics( titleFont );
+
+    QFont valueFont( property()->string( "tableValueFontFamily" ),
+                    property()->integer( "tableValueFontSize" ) );
+    QPen valuePen( property()->color( "tableValueFontColor" ) );
+    QFontMetrics valueMetrics( valueFont );
+
+    // Store pixel resolution into local variables.
+    double yppi = m_screenSize->m_yppi;
+    double xppi = m_screenSize->m_xppi;
+    double subTitleHt, textHt, titleHt, valueHt;
+    subTitleHt = ( subTitleMetrics.lineSpacing()  + m_screenSize->m_padHt ) / yppi;
+    textHt  = ( textMetrics.lineSpacing()  + m_screenSize->m_padHt ) / yppi;
+    titleHt = ( titleMetrics.lineSpacing() + m_screenSize->m_padHt ) / yppi;
+    valueHt = ( valueMetrics.lineSpacing() + m_screenSize->m_padHt ) / yppi;
+    // END THE STANDARD PREAMBLE USED BY ALL TABLE COMPOSITION FUNCTIONS
+
+    QBrush barBrush( property()->color( "graphBarColor" ), Qt::SolidPattern );
+    QPen axlePen( property()->color( "graphAxleColor" ) );
+
+    QString results(""), qStr("");
+    translate( results, "BpDocument:Sample:Results" );
+
+    // The statistics columns
+    enum { Stats = 7 };
+    static const double Prob[Stats-2] = { 0.05, 0.25, 0.50, 0.75, 0.95 };
+    static const char *StatKey[Stats] =
+    {
+        "BpDocument:Sample:Mean",
+        "BpDocument:Sample:StdDev",
+        "BpDocument:Sample:P05",
+        "BpDocument:Sample:P25",
+        "BpDocument:Sample:P50",
+        "BpDocument:Sample:P75",
+        "BpDocument:Sample:P95"
+    };
+
+    // Determine the name and statistic column widths.
+    int nameWdPixels = 0;
+    int statWdPixels = 0;
+    int len, vid, in, stat;
+    EqVar *varPtr;
+    for ( in = 0;
+          in < sample->inputs();
+          in++ )
+    {
+        len = textMetrics.width( *(sample->inputVar( in )->m_label) );
+        if ( len > nameWdPixels )
+        {
+            nameWdPixels = len;
+        }
+    }
+    for ( vid = 0;
+          vid < sample->outVars();
+          vid++ )
+    {
+        varPtr = sample->outVar( vid );
+        if ( varPtr->isDiagram() )
+        {
+            continue;
+        }
+        len = textMetrics.width( *(varPtr->m_label) );
+        if ( len > nameWdPixels )
+        {
+            nameWdPixels = len;
+        }
+        if ( varPtr->isContinuous() )
+        {
+            for ( stat = 0;
+                  stat < Stats;
+                  stat++ )
+            {
+                double v = ( stat == 0 ) ? sample->mean( vid )
+                         : ( stat == 1 ) ? sample->stdDev( vid )
+                         : sample->quantile( vid, Prob[stat-2] );
+                qStr.sprintf( "%1.*f", varPtr->m_displayDecimals, v );
+                len = valueMetrics.width( qStr );
+                if ( len > statWdPixels )
+                {
+                    statWdPixels = len;
+                }
+            }
+        }
+    }
+    for ( stat = 0;
+          stat < Stats;
+          stat++ )
+    {
+        translate( qStr, StatKey[stat] );
+        len = textMetrics.width( qStr );
+        if ( len > statWdPixels )
+        {
+            statWdPixels = len;
+        }
+    }
+    // Add padding for differences in screen and printer font sizes
+    nameWdPixels += textMetrics.width( "WM" );
+    statWdPixels += valueMetrics.width( "WM" );
+    // If the names are too wide for the page, reduce the name field width.
+    if ( nameWdPixels + Stats * statWdPixels > m_screenSize->m_bodyWd )
+    {
+        nameWdPixels = m_screenSize->m_bodyWd - Stats * statWdPixels;
+    }
+    double nameWd = (double) nameWdPixels / xppi;
+    double statWd = (double) statWdPixels / xppi;
+    double nameColX = m_pageSize->m_marginLeft;
+    double statColX = nameColX + nameWd;
+    double restWd = m_pageSize->m_bodyWd - nameWd;
+
+    // Open the composer and start with a new page.
+    startNewPage( results, TocListOut );
+    double yPos = m_pageSize->m_marginTop + titleHt;
+
+    // Print the table header.
+    m_composer->font( titleFont );                  // use tableTitleFont
+    m_composer->pen( titlePen );                    // use tableTitleFontColor
+    qStr = m_eqTree->m_eqCalc->docDescriptionStore().stripWhiteSpace();
+    m_composer->text(
+        m_pageSize->m_marginLeft, yPos,             // start at UL corner
+        m_pageSize->m_bodyWd, titleHt,              // width and height
+        Qt::AlignVCenter|Qt::AlignCenter,           // center alignment
+        qStr );                                     // display description
+    yPos += titleHt;
+
+    // Display the sampling design as the subtitle
+    translate( qStr, ( sample->latinHypercube() )
+        ? "BpDocument:Sample:LatinHypercube"
+        : "BpDocument:Sample:MonteCarlo",
+        QString( "%1" ).arg( sample->samples() ) );
+    m_composer->font( subTitleFont );               // use tableSubtitleFont
+    m_composer->pen( subTitlePen );                 // use tableSubtitleFontColor
+    m_composer->text(
+        m_pageSize->m_marginLeft, yPos,             // start at UL corner
+        m_pageSize->m_bodyWd, subTitleHt,           // width and height
+        Qt::AlignVCenter|Qt::AlignCenter,           // center alignment
+        qStr );                                     // display design
+    yPos += 2. * subTitleHt;
+
+    // Draw each uncertain input and its distribution.
+    m_composer->font( titleFont );                  // use tableTitleFont
+    m_composer->pen( titlePen );                    // use tableTitleFontColor
+    translate( qStr, "BpDocument:Sample:Inputs" );
+    m_composer->text(
+        nameColX,   yPos,                           // start at UL corner
+        m_pageSize->m_bodyWd, titleHt,              // width and height
+        Qt::AlignVCenter|Qt::AlignLeft,             // left justified
+        qStr );                                     // display header
+    yPos += titleHt;
+    for ( in = 0;
+          in < sample->inputs();
+          in++ )
+    {
+        if ( yPos + textHt > m_pageSize->m_bodyEnd )
+        {
+            startNewPage( results, TocBlank );
+            yPos = m_pageSize->m_marginTop;
+        }
+        varPtr = sample->inputVar( in );
+        m_composer->font( textFont );               // use tableTextFont
+        m_composer->pen( textPen );                 // use tableTextFontColor
+        m_composer->text(
+            nameColX,   yPos,                       // start at UL corner
+            nameWd,     textHt,                     // width and height
+            Qt::AlignVCenter|Qt::AlignLeft,         // left justified
+            *(varPtr->m_label) );                   // display label text
+        qStr = sample->distText( in );
+        if ( varPtr->isContinuous() )
+        {
+            qStr += " " + varPtr->displayUnits();
+        }
+        m_composer->font( valueFont );              // use tableValueFont
+        m_composer->pen( valuePen );                // use tableValueFontColor
+        m_composer->text(
+            statColX,   yPos,                       // start at UL corner
+            restWd,     valueHt,                    // width and height
+            Qt::AlignVCenter|Qt::AlignLeft,         // left justified
+            qStr );                                 // display distribution
+        yPos += textHt;
+    }
+    yPos += textHt;
+
+    // Draw the output statistics header.
+    if ( yPos + 2. * titleHt > m_pageSize->m_bodyEnd )
+    {
+        startNewPage( results, TocBlank );
+        yPos = m_pageSize->m_marginTop;
+    }
+    m_composer->font( titleFont );                  // use tableTitleFont
+    m_composer->pen( titlePen );                    // use tableTitleFontColor
+    translate( qStr, "BpDocument:Sample:Outputs" );
+    m_composer->text(
+        nameColX,   yPos,                           // start at UL corner
+        nameWd,     titleHt,                        // width and height
+        Qt::AlignVCenter|Qt::AlignLeft,             // left justified
+        qStr );                                     // display header
+    m_composer->font( textFont );                   // use tableTextFont
+    m_composer->pen( textPen );                     // use tableTextFontColor
+    for ( stat = 0;
+          stat < Stats;
+          stat++ )
+    {
+        translate( qStr, StatKey[stat] );
+        m_composer->text(
+            statColX + stat * statWd, yPos,         // start at UL corner
+            statWd,     titleHt,                    // width and height
+            Qt::AlignVCenter|Qt::AlignRight,        // right justified
+            qStr );                                 // display header
+    }
+    yPos += titleHt;
+
+    // Draw each output variable's statistics on its own line.
+    for ( vid = 0;
+          vid < sample->outVars();
+          vid++ )
+    {
+        varPtr = sample->outVar( vid );
+        if ( varPtr->isDiagram() )
+        {
+            continue;
+        }
+        if ( yPos + textHt > m_pageSize->m_bodyEnd )
+        {
+            startNewPage( results, TocBlank );
+            yPos = m_pageSize->m_marginTop;
+        }
+        m_composer->font( textFont );               // use tableTextFont
+        m_composer->pen( textPen );                 // use tableTextFontColor
+        qStr = *(varPtr->m_label);
+        if ( varPtr->isContinuous() && ! varPtr->displayUnits().isEmpty() )
+        {
+            qStr += " (" + varPtr->displayUnits() + ")";
+        }
+        m_composer->text(
+            nameColX,   yPos,                       // start at UL corner
+            nameWd,     textHt,                     // width and height
+            Qt::AlignVCenter|Qt::AlignLeft,         // left justified
+            qStr );                                 // display label text
+        m_composer->font( valueFont );              // use tableValueFont
+        m_composer->pen( valuePen );                // use tableValueFontColor
+        if ( varPtr->isContinuous() )
+        {
+            for ( stat = 0;
+                  stat < Stats;
+                  stat++ )
+            {
+                double v = ( stat == 0 ) ? sample->mean( vid )
+                         : ( stat == 1 ) ? sample->stdDev( vid )
+                         : sample->quantile( vid, Prob[stat-2] );
+                qStr.sprintf( "%1.*f", varPtr->m_displayDecimals, v );
+                m_composer->text(
+                    statColX + stat * statWd, yPos, // start at UL corner
+                    statWd,     valueHt,            // width and height
+                    Qt::AlignVCenter|Qt::AlignRight,// right justified
+                    qStr );                         // display value text
+            }
+        }
+        // Discrete outputs show the relative frequency of each item.
+        else if ( varPtr->isDiscrete() )
+        {
+            QString item("");
+            qStr = "";
+            int first = 0;
+            for ( int rank = 1;
+                  rank <= sample->samples();
+                  rank++ )
+            {
+                if ( rank < sample->samples()
+                  && sample->value( vid, rank ) == sample->value( vid, first ) )
+                {
+                    continue;
+                }
+                item.sprintf( "%s %1.0f%%",
+                    varPtr->m_itemList->itemName(
+                        (int) sample->value( vid, first ) ).latin1(),
+                    100. * (double) ( rank - first )
+                        / (double) sample->samples() );
+                qStr += ( first ) ? ", " + item : item;
+                first = rank;
+            }
+            m_composer->text(
+                statColX,   yPos,                   // start at UL corner
+                restWd,     valueHt,                // width and height
+                Qt::AlignVCenter|Qt::AlignLeft,     // left justified
+                qStr );                             // display frequencies
+        }
+        yPos += textHt;
+    }
+
+    // Write the prescription probability
+    if ( sample->rxActive() )
+    {
+        yPos += textHt;
+        if ( yPos + textHt > m_pageSize->m_bodyEnd )
+        {
+            startNewPage( results, TocBlank );
+            yPos = m_pageSize->m_marginTop;
+        }
+        m_composer->font( textFont );               // use tableTextFont
+        m_composer->pen( textPen );                 // use tableTextFontColor
+        translate( qStr, "BpDocument:Sample:RxProbability" );
+        m_composer->text(
+            nameColX,   yPos,                       // start at UL corner
+            nameWd,     textHt,                     // width and height
+            Qt::AlignVCenter|Qt::AlignLeft,         // left justified
+            qStr );                                 // display label text
+        qStr.sprintf( "%1.1f%%", 100. * sample->inRxProbability() );
+        m_composer->font( valueFont );              // use tableValueFont
+        m_composer->pen( valuePen );                // use tableValueFontColor
+        m_composer->text(
+            statColX,   yPos,                       // start at UL corner
+            statWd,     valueHt,                    // width and height
+            Qt::AlignVCenter|Qt::AlignRight,        // right justified
+            qStr );                                 // display probability
+        yPos += textHt;
+    }
+
+    // Draw a histogram of each continuous output variable.
+    int bins = property()->integer( "uncertaintyBins" );
+    if ( bins < 2 )
+    {
+        bins = 2;
+    }
+    int *count = new int[ bins ];
+    checkmem( __FILE__, __LINE__, count, "int count", bins );
+    double histHt = 1.5;
+    double histWd = 0.75 * m_pageSize->m_bodyWd;
+    double histX  = m_pageSize->m_marginLeft
+                  + 0.5 * ( m_pageSize->m_bodyWd - histWd );
+    double binWd  = histWd / (double) bins;
+    double lo, hi;
+    for ( vid = 0;
+          vid < sample->outVars();
+          vid++ )
+    {
+        varPtr = sample->outVar( vid );
+        if ( ! varPtr->isContinuous() )
+        {
+            continue;
+        }
+        yPos += textHt;
+        if ( yPos + titleHt + histHt + textHt > m_pageSize->m_bodyEnd )
+        {
+            startNewPage( results, TocBlank );
+            yPos = m_pageSize->m_marginTop;
+        }
+        int maxCount = sample->histogram( vid, bins, count, &lo, &hi );
+        // Histogram title
+        m_composer->font( textFont );               // use tableTextFont
+        m_composer->pen( textPen );                 // use tableTextFontColor
+        qStr = *(varPtr->m_label);
+        if ( ! varPtr->displayUnits().isEmpty() )
+        {
+            qStr += " (" + varPtr->displayUnits() + ")";
+        }
+        m_composer->text(
+            histX,      yPos,                       // start at UL corner
+            histWd,     titleHt,                    // width and height
+            Qt::AlignVCenter|Qt::AlignCenter,       // centered
+            qStr );                                 // display label text
+        yPos += titleHt;
+        // Bars
+        for ( int bin = 0;
+              bin < bins && maxCount > 0;
+              bin++ )
+        {
+            double barHt = histHt * (double) count[bin] / (double) maxCount;
+            if ( barHt > 0. )
+            {
+                m_composer->fill( histX + bin * binWd, yPos + histHt - barHt,
+                    binWd, barHt, barBrush );
+            }
+        }
+        // Axle and limits
+        m_composer->pen( axlePen );
+        m_composer->line( histX, yPos + histHt, histX + histWd, yPos + histHt );
+        yPos += histHt;
+        m_composer->font( valueFont );              // use tableValueFont
+        m_composer->pen( valuePen );                // use tableValueFontColor
+        qStr.sprintf( "%1.*f", varPtr->m_displayDecimals, lo );
+        m_composer->text(
+            histX,      yPos,                       // start at UL corner
+            0.5 * histWd, valueHt,                  // width and height
+            Qt::AlignVCenter|Qt::AlignLeft,         // left justified
+            qStr );                                 // display minimum
+        qStr.sprintf( "%1.*f", varPtr->m_displayDecimals, hi );
+        m_composer->text(
+            histX + 0.5 * histWd, yPos,             // start at UL corner
+            0.5 * histWd, valueHt,                  // width and height
+            Qt::AlignVCenter|Qt::AlignRight,        // right justified
+            qStr );                                 // display maximum
+        yPos += valueHt;
+    }
+    delete[] count;     count = 0;
+
+    // Be polite and stop the composer.
+    m_composer->end();
+    return;
+}
+
+//------------------------------------------------------------------------------
+//  End of bpcomposesample.cpp
+//------------------------------------------------------------------------------
+
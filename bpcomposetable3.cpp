@@ -28,6 +28,7 @@
 #include "docpagesize.h"
 #include "property.h"
 #include "xeqcalc.h"
+#include "xeqtableexport.h"
 #include "xeqtree.h"
 #include "xeqvar.h"
 #include "xeqvaritem.h"
@@ -35,6 +36,7 @@
 // Qt include files
 #include <qfontmetrics.h>
 #include <qpen.h>
+#include <qstatusbar.h>
 
 //------------------------------------------------------------------------------
 /*! \brief Composes all the fire behavior output tables for
@@ -42,7 +44,10 @@
  *  range case 5: ZERO continuous and TWO  discrete range variables, or
  *  range case 6: ONE  continuous and ONE  discrete range variable.
  *
- *  Calls composeTable3( int, EqVar*, EqVar* ) for each output table variable.
+ *  Records a PageTaskTable3 for each output table variable, so that
+ *  composePending() calls composeTable3( int, EqVar*, EqVar* ) only when
+ *  the variable's pages are first needed.  The export files are written
+ *  immediately.
  *
  *  \param rowVar  Pointer to the table's row EqVar.
  *  \param colVar  Pointer to the table's column EqVar.
@@ -56,16 +61,30 @@ void BpDocument::composeTable3( EqVar *rowVar, EqVar *colVar )
     {
         if ( tableVar(vid)->isDiscrete() || tableVar(vid)->isContinuous() )
         {
+            // Each variable's pages are composed when first needed
             if ( ! tableVar(vid)->isDiagram() )
             {
-                composeTable3( vid, rowVar, colVar );
+                pageTaskAdd( PageTaskTable3, vid, rowVar, colVar );
             }
         }
     }
 
-    // Write the spreadsheet file
-    composeTable3Spreadsheet( rowVar, colVar );
-    composeTable3Html( rowVar, colVar );
+    // Write the export files from the tables spooled during the run
+    composeTable3Spreadsheet();
+    composeTable3Html();
+    composeTable3Columnar();
+
+    // Report the export throughput
+    EqTableExport *exporter = m_eqTree->m_tableExport;
+    if ( exporter )
+    {
+        QString text("");
+        translate( text, "BpDocument:Export:Throughput",
+            QString( "%1" ).arg( (double) exporter->bytes() / 1048576., 0, 'f', 2 ),
+            QString( "%1" ).arg( exporter->seconds(), 0, 'f', 3 ),
+            QString( "%1" ).arg( exporter->throughput(), 0, 'f', 1 ) );
+        appWindow()->statusBar()->message( text, 10000 );
+    }
     return;
 }
 
@@ -130,8 +149,13 @@ void BpDocument::composeTable3( int vid, EqVar *rowVar, EqVar *colVar )
     // END THE STANDARD PREAMBLE USED BY ALL TABLE COMPOSITION FUNCTIONS.
 
     // Determine the number of rows we can display on a page.
+    // (Sweep slices have an extra line for their fixed range variables.)
+    double sliceHt = ( m_eqTree->m_tableSlice.isEmpty() )
+                   ? 0.
+                   : textHt;
     int rowsPerPage = (int)
-        ( ( m_pageSize->m_bodyHt - 5. * titleHt - 4. * textHt ) / rowHt );
+        ( ( m_pageSize->m_bodyHt - 5. * titleHt - 4. * textHt - sliceHt )
+        / rowHt );
 
     // Number of pages the table requires to accomodate all the rows.
     int pagesLong = 1 + (int) ( tableRows() / rowsPerPage );
@@ -383,6 +407,18 @@ void BpDocument::composeTable3( int vid, EqVar *rowVar, EqVar *colVar )
 					qStr );                             // display description
 				yPos += textHt;
 			}
+            // Display the fixed values of a sweep slice's other range vars
+            if ( ! m_eqTree->m_tableSlice.isEmpty() )
+            {
+                m_composer->font( textFont );
+                m_composer->pen( subTitlePen );
+                m_composer->text(
+                    m_pageSize->m_marginLeft, yPos,
+                    m_pageSize->m_bodyWd, textHt,
+                    Qt::AlignVCenter|Qt::AlignCenter,
+                    m_eqTree->m_tableSlice );
+                yPos += textHt;
+            }
             // Display the table title::variable
             m_composer->font( subTitleFont );       // use tableSubtitleFont
             m_composer->pen( subTitlePen );         // use tableSubtitleFontColor
@@ -674,292 +710,84 @@ void BpDocument::composeTable3( int vid, EqVar *rowVar, EqVar *colVar )
 }
 
 //------------------------------------------------------------------------------
-/*! \brief Composes the fire behavior two-way output tables.
- *
- *  Tables are constructed for the following range cases:
- *  - range case 4: TWO  continuous and ZERO discrete range variables,
- *  - range case 5: ZERO continuous and TWO  discrete range variables, or
- *  - range case 6: ONE  continuous and ONE  discrete range variable.
- *
- *  \param vid Index of the table's value variable.
- *  \param rowVar Pointer to the table's row EqVar .
- *  \param colVar Pointer to the table's column EqVar .
+/*! \brief Writes the two-way output tables spooled by the EqTableExport
+ *  into the compressed columnar file "exportColumnarFile".
  */
 
-void BpDocument::composeTable3Html( EqVar *rowVar, EqVar *colVar )
+void BpDocument::composeTable3Columnar( void )
 {
-    // Attempt to open the html file
-    QString fileName = appFileSystem()->composerPath()
-        + "/" + property()->string( "exportHtmlFile" );
-    FILE *fptr = 0;
-    if ( ! ( fptr = fopen( fileName, "w" ) ) )
+    EqTableExport *exporter = m_eqTree->m_tableExport;
+    if ( ! exporter
+      || ! property()->boolean( "exportColumnar" ) )
     {
         return;
     }
-
-    // Write the header
-    composeTableHtmlHeader( fptr );
-
-    // Loop for each output variable
-    for ( int vid = 0; vid < tableVars(); vid++ )
+    // Attempt to open the columnar file
+    QString fileName = appFileSystem()->composerPath()
+        + "/" + property()->string( "exportColumnarFile" );
+    FILE *fptr = 0;
+    if ( ! ( fptr = fopen( fileName, "wb" ) ) )
     {
-        if ( ( tableVar(vid)->isDiscrete() || tableVar(vid)->isContinuous() )
-          && ! tableVar(vid)->isDiagram() )
-        {
-            composeTable3Html( fptr, vid, rowVar, colVar );
-        }
+        return;
     }
-
-    // Write the footer
-    composeTableHtmlFooter( fptr );
-
-    // Close the file and return
+    exporter->writeColumnar( fptr );
     fclose( fptr );
     return;
 }
 
 //------------------------------------------------------------------------------
-/*! \brief Composes the fire behavior two-way output tab-delimited spreadsheet.
+/*! \brief Writes the two-way output tables spooled by the EqTableExport
+ *  into the HTML file "exportHtmlFile".
  *
  *  Tables are constructed for the following range cases:
  *  - range case 4: TWO  continuous and ZERO discrete range variables,
  *  - range case 5: ZERO continuous and TWO  discrete range variables, or
  *  - range case 6: ONE  continuous and ONE  discrete range variable.
- *
- *  \param vid Index of the table's value variable.
- *  \param rowVar Pointer to the table's row EqVar .
- *  \param colVar Pointer to the table's column EqVar .
  */
 
-void BpDocument::composeTable3Html( FILE *fptr, int vid,
-    EqVar *rowVar, EqVar *colVar )
+void BpDocument::composeTable3Html( void )
 {
-    EqVar *outVar = tableVar(vid);
-    int iid;
-
-    // Prescription shading?
-    bool doRx = property()->boolean( "tableShading" );
-    bool doBlank = property()->boolean( "tableShadingBlank" );
-
-    QString text = "";
-    if ( outVar->isContinuous() )
+    EqTableExport *exporter = m_eqTree->m_tableExport;
+    if ( ! exporter )
     {
-        text = "(" + outVar->displayUnits() + ")";
-    }
-	QString qStr = m_eqTree->m_eqCalc->getSubtitle();
-	QString subTitle = "";
-	if ( qStr.length() > 0 )
-	{
-		subTitle = "  <h3 class=\"bp2subhead\"><b>" + qStr + "</b></h3>\n";
-	}
-    fprintf( fptr,
-        "<!-- Begin 2-Way Output Table for %s -->\n"	// Title (display var label)
-        "<p class=\"bp2\">\n%s"			// SURFACE subtitle
-        "  <h3 class=\"bp2\">Results for: %s %s</h3>\n"	// Display variable label and units
-        "  <table cellpadding=\"5\" cellspacing=\"2\" border=\"0\">\n",
-        (*(outVar->m_label)).latin1(),
- 		subTitle.latin1(),
-        (*(outVar->m_label)).latin1(),
-        text.latin1()
-    );
-
-    // First column headers
-    fprintf( fptr,
-        "    <tr>\n"
-        "      <td class=\"bp2hdr\" align=\"center\">\n"
-        "        %s\n"
-        "      </td>\n",
-        (*(rowVar->m_hdr0)).latin1()
-    );
-    fprintf( fptr,
-        "      <td class=\"bp2hdr\" colspan=\"%d\" align=\"center\">\n"
-        "        %s\n"
-        "      </td>\n"
-        "    </tr>\n",
-        tableCols(),
-        (*(colVar->m_label)).latin1()
-    );
-
-    // Second column header
-    fprintf( fptr,
-        "    <tr>\n"
-        "      <td class=\"bp2hdr\" align=\"center\">\n"
-        "        %s\n"
-        "      </td>\n",
-        (*(rowVar->m_hdr1)).latin1()
-    );
-    text = "";
-    if ( colVar->isContinuous() )
-    {
-        text = colVar->displayUnits();
-    }
-    fprintf( fptr,
-        "      <td class=\"bp2hdr\" colspan=\"%d\" align=\"center\">\n"
-        "        %s\n"
-        "      </td>\n"
-        "    </tr>\n",
-        tableCols(),
-        text.latin1()
-    );
-
-    // Third column header
-    // Row variable's units
-    text = "";
-    if ( rowVar->isContinuous() )
-    {
-        text = rowVar->displayUnits();
+        return;
     }
-    fprintf( fptr,
-        "    <tr>\n"
-        "      <td class=\"bp2hdr\" align=\"center\">\n"
-        "        %s\n"
-        "      </td>\n",
-        text.latin1()
-    );
-    // Column variable values
-    int row, col;
-    for ( col = 0; col < tableCols(); col++ )
+    // Attempt to open the html file
+    QString fileName = appFileSystem()->composerPath()
+        + "/" + property()->string( "exportHtmlFile" );
+    FILE *fptr = 0;
+    if ( ! ( fptr = fopen( fileName, "w" ) ) )
     {
-        if ( colVar->isDiscrete() )
-        {
-            iid = (int) tableCol( col );
-            text = colVar->m_itemList->itemName( iid );
-        }
-        else if ( colVar->isContinuous() )
-        {
-			// CDB DECIMALS MOD
-			if ( false )
-			{
-				text.sprintf( " %1.*f",	colVar->m_displayDecimals, tableCol( col ) );
-			}
-			else
-			{
-				text.sprintf( " %1.*f", m_colDecimals, tableCol( col ) );
-			}
-        }
-        fprintf( fptr,
-            "      <td class=\"bp2hdr\" align=\"center\">\n"
-            "        %s\n"
-            "      </td>\n",
-            text.latin1()
-        );
+        return;
     }
-    fprintf( fptr, "    </tr>\n" );
 
-    // Table body
-    int out = vid;
-    for ( row = 0; row < tableRows(); row++ )
-    {
-        // Row value is in the first column
-        if ( rowVar->isDiscrete() )
-        {
-            iid = (int) tableRow( row );
-            text = rowVar->m_itemList->itemName( iid );
-        }
-        else if ( rowVar->isContinuous() )
-        {
-			// CDB DECIMALS MOD
-			if ( false )
-			{
-				text.sprintf( "%1.*f", rowVar->m_displayDecimals, tableRow( row ) );
-			}
-			else
-			{
-				text.sprintf( "%1.*f", m_rowDecimals, tableRow( row ) );
-			}
-        }
-        fprintf( fptr,
-            "    <tr>\n"
-            "      <td class=\"bp2hdr\" align=\"center\">\n"
-            "        %s\n"
-            "      </td>\n",
-            text.latin1()
-        );
-
-        // Remaining columns
-        for ( col = 0; col < tableCols(); col++ )
-        {
-            if ( outVar->isDiscrete() )
-            {
-                iid = (int) tableVal( out );
-                text = outVar->m_itemList->itemName( iid );
-            }
-            else if ( outVar->isContinuous() )
-            {
-                text.sprintf( "%1.*f",
-                    outVar->m_displayDecimals, tableVal( out ) );
-            }
-            // Display the output value.
-            if ( doRx )
-            {
-                int cell = col + row * tableCols();
-                if ( tableInRx( cell ) )
-                {
-                    fprintf( fptr,
-                        "      <td class=\"bp2row%din\" align=\"center\">\n"
-                        "        %s\n"
-                        "      </td>\n",
-                        row%2, text.latin1()
-                    );
-                }
-                else if ( doBlank )
-                {
-                    fprintf( fptr,
-                        "      <td class=\"bp2row%dout\" align=\"center\">\n"
-                        "        &nbsp;\n"
-                        "      </td>\n",
-                        row%2
-                    );
-                }
-                else
-                {
-                    fprintf( fptr,
-                        "      <td class=\"bp2row%dout\" align=\"center\">\n"
-                        "        %s\n"
-                        "      </td>\n",
-                        row%2, text.latin1()
-                    );
-                }
-            }
-            else
-            {
-                fprintf( fptr,
-                    "      <td  class=\"bp2row%d\" align=\"center\">\n"
-                    "        %s\n"
-                    "      </td>\n",
-                    row%2, text.latin1()
-                );
-            }
-            out += tableVars();
-        }   // Next table column
-        fprintf( fptr, "    </tr>\n" );
-    } // Next table row
+    // Write the header, every output variable's table, and the footer
+    composeTableHtmlHeader( fptr );
+    exporter->writeHtml( fptr );
+    composeTableHtmlFooter( fptr );
 
-    // End of the table for this variable
-    fprintf( fptr,
-        "  </table>\n"
-        "</p>\n"
-        "<!-- End 2-Way Output Table for %s -->\n\n",
-        (*(outVar->m_label)).latin1()
-    );
+    // Close the file and return
+    fclose( fptr );
     return;
 }
 
 //------------------------------------------------------------------------------
-/*! \brief Composes the fire behavior two-way output tab-delimited spreadsheet.
+/*! \brief Writes the two-way output tables spooled by the EqTableExport
+ *  into the tab-delimited spreadsheet file "exportSpreadsheetFile".
  *
  *  Tables are constructed for the following range cases:
  *  - range case 4: TWO  continuous and ZERO discrete range variables,
  *  - range case 5: ZERO continuous and TWO  discrete range variables, or
  *  - range case 6: ONE  continuous and ONE  discrete range variable.
- *
- *  \param vid Index of the table's value variable.
- *  \param rowVar Pointer to the table's row EqVar .
- *  \param colVar Pointer to the table's column EqVar .
  */
 
-void BpDocument::composeTable3Spreadsheet( EqVar *rowVar, EqVar *colVar )
+void BpDocument::composeTable3Spreadsheet( void )
 {
+    EqTableExport *exporter = m_eqTree->m_tableExport;
+    if ( ! exporter )
+    {
+        return;
+    }
     // Attempt to open the spreadsheet file
     QString fileName = appFileSystem()->composerPath()
         + "/" + property()->string( "exportSpreadsheetFile" );
@@ -981,130 +809,14 @@ void BpDocument::composeTable3Spreadsheet( EqVar *rowVar, EqVar *colVar )
         m_runTime.left(17).latin1(),
         m_runTime.right(8).latin1() );
 
-    // Loop for each output variable
-    for ( int vid = 0; vid < tableVars(); vid++ )
-    {
-        if ( ( tableVar(vid)->isDiscrete() || tableVar(vid)->isContinuous() )
-          && ! tableVar(vid)->isDiagram() )
-        {
-            composeTable3Spreadsheet( fptr, vid, rowVar, colVar );
-        }
-    }
+    // Every output variable's table
+    exporter->writeSpreadsheet( fptr );
 
     // Close the file and return
     fclose( fptr );
     return;
 }
 
-//------------------------------------------------------------------------------
-/*! \brief Composes the fire behavior two-way output tab-delimited spreadsheet.
- *
- *  Tables are constructed for the following range cases:
- *  - range case 4: TWO  continuous and ZERO discrete range variables,
- *  - range case 5: ZERO continuous and TWO  discrete range variables, or
- *  - range case 6: ONE  continuous and ONE  discrete range variable.
- *
- *  \param vid Index of the table's value variable.
- *  \param rowVar Pointer to the table's row EqVar .
- *  \param colVar Pointer to the table's column EqVar .
- */
-
-void BpDocument::composeTable3Spreadsheet( FILE *fptr, int vid,
-    EqVar *rowVar, EqVar *colVar )
-{
-    EqVar *outVar = tableVar(vid);
-    QString qStr;
-    int iid;
-    // Two blank lines between tables
-    fprintf( fptr, "\n\n" );
-    fprintf( fptr, "%s\t%s\n",
-        (*(outVar->m_label)).latin1(),
-        ( outVar->isContinuous() ) ? outVar->displayUnits().latin1() : "" );
-    fprintf( fptr, "%s\t%s\n",
-        (*(rowVar->m_label)).latin1(),
-        ( rowVar->isContinuous() ) ? rowVar->displayUnits().latin1() : "" );
-    fprintf( fptr, "%s\t%s\n",
-        (*(colVar->m_label)).latin1(),
-        ( colVar->isContinuous() ) ? colVar->displayUnits().latin1() : "" );
-
-    // First column header row
-    fprintf( fptr, "\n" );
-    fprintf( fptr, "%s\t \t%s\t%s\n",
-        (*(rowVar->m_hdr0)).latin1(),
-        (*(colVar->m_hdr0)).latin1(),
-        (*(colVar->m_hdr1)).latin1() );
-
-    // Second column header row
-    fprintf( fptr, "%s", (*(rowVar->m_hdr1)).latin1() );
-    int row, col;
-    for ( col = 0; col < tableCols(); col++ )
-    {
-        if ( colVar->isDiscrete() )
-        {
-            iid = (int) tableCol( col );
-            qStr = colVar->m_itemList->itemName( iid );
-        }
-        else if ( colVar->isContinuous() )
-        {
-			// CDB DECIMALS MOD
-			if ( false )
-			{
-				qStr.sprintf( " %1.*f",	colVar->m_displayDecimals, tableCol( col ) );
-			}
-			else
-			{
-				qStr.sprintf( " %1.*f", m_colDecimals, tableCol( col ) );
-			}
-        }
-        fprintf( fptr, "\t%s", qStr.latin1() );
-    }
-    fprintf( fptr, "\n" );
-
-    // Table body
-    int out = vid;
-    for ( row = 0; row < tableRows(); row++ )
-    {
-        // Row value is in the first column
-        if ( rowVar->isDiscrete() )
-        {
-            iid = (int) tableRow( row );
-            qStr = rowVar->m_itemList->itemName( iid );
-        }
-        else if ( rowVar->isContinuous() )
-        {
-			// CDB DECIMALS MOD
-			if ( false )
-			{
-				qStr.sprintf( "%1.*f", rowVar->m_displayDecimals, tableRow( row ) );
-			}
-			else
-			{
-				qStr.sprintf( "%1.*f", m_rowDecimals, tableRow( row ) );
-			}
-        }
-        fprintf( fptr, "%s", qStr.latin1() );
-        // Remaining columns
-        for ( col = 0; col < tableCols(); col++ )
-        {
-            if ( outVar->isDiscrete() )
-            {
-                iid = (int) tableVal( out );
-                qStr = outVar->m_itemList->itemName( iid );
-            }
-            else if ( outVar->isContinuous() )
-            {
-                qStr.sprintf( "%1.*f",
-                    outVar->m_displayDecimals, tableVal( out ) );
-            }
-            fprintf( fptr, "\t%s", qStr.latin1() );
-            out += tableVars();
-        }   // Next table column
-        fprintf( fptr, "\n" );
-    } // Next table row
-    return;
-}
-
 //------------------------------------------------------------------------------
 //  End of bpcomposetable3.cpp
 //------------------------------------------------------------------------------
-
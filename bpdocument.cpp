@@ -51,6 +51,14 @@
 #include "rxvar.h"
 #include "xeqapp.h"
 #include "xeqcalc.h"
+#include "xeqdiskcache.h"
+#include "xeqgoalseek.h"
+#include "xeqresultcache.h"
+#include "xeqrxwindow.h"
+#include "xeqsample.h"
+#include "xeqsensitivity.h"
+#include "xeqstream.h"
+#include "xeqsweep.h"
 #include "xeqtree.h"
 #include "xeqvar.h"
 
@@ -64,6 +72,7 @@
 #include <qmultilineedit.h>
 #include <qpopupmenu.h>
 #include <qpushbutton.h>
+#include <qtimer.h>
 
 //------------------------------------------------------------------------------
 /*! \brief BpDocument class constructor.
@@ -117,7 +126,13 @@ BpDocument::BpDocument( QWorkspace *workspace, int docId, EqApp *eqApp,
     m_notesX(0),
     m_notesY(0),
     m_notesWd(0),
-    m_notesHt(0)
+    m_notesHt(0),
+    m_pageTasks(0),
+    m_pageRuns(0),
+    m_pageTimer(0),
+    m_pageComposing(false),
+    m_pageHold(false),
+    m_pageRunUsed(false)
 {
     // Popup context menu must be created here because it is declared a
     // pure virtual method in Document.
@@ -229,6 +244,18 @@ BpDocument::BpDocument( QWorkspace *workspace, int docId, EqApp *eqApp,
     Q_CHECK_PTR( m_notes );
     m_notes->setTextFormat( Qt::PlainText );
 
+    // Create the deferred results page lists and background timer.
+    m_pageTasks = new QPtrList<BpPageTask>();
+    checkmem( __FILE__, __LINE__, m_pageTasks, "QPtrList<BpPageTask> m_pageTasks", 1 );
+    m_pageTasks->setAutoDelete( true );
+    m_pageRuns = new QPtrList<EqTreeRun>();
+    checkmem( __FILE__, __LINE__, m_pageRuns, "QPtrList<EqTreeRun> m_pageRuns", 1 );
+    m_pageRuns->setAutoDelete( true );
+    m_pageTimer = new QTimer( this, "m_pageTimer" );
+    checkmem( __FILE__, __LINE__, m_pageTimer, "QTimer m_pageTimer", 1 );
+    connect( m_pageTimer, SIGNAL( timeout() ),
+             this,        SLOT( composeAhead() ) );
+
     // Uncomment the next line to generate a blank.bpw from program defaults.
     //saveAsWorksheetFile( "blank.bpw" );
     return;
@@ -258,6 +285,9 @@ BpDocument::~BpDocument( void )
         delete m_rxMinEntry[rx];    m_rxMinEntry[rx] = 0;
         delete m_rxMaxEntry[rx];    m_rxMaxEntry[rx] = 0;
     }
+    delete m_pageTimer;     m_pageTimer = 0;
+    delete m_pageTasks;     m_pageTasks = 0;
+    delete m_pageRuns;      m_pageRuns = 0;
     m_eqApp->m_eqTreeList->remove( m_eqTree );
     m_eqTree = 0;
     delete m_btn[0];        m_btn[0] = 0;
@@ -1287,7 +1317,8 @@ bool BpDocument::print( void )
     // unvalidated change to a field AND has results pages,
     // in which case the changed field is not printed correctly,
     // for to do so would blow away the results pages.
-    if ( m_worksheetEdited || m_pages == m_worksheetPages )
+    if ( m_worksheetEdited
+      || ( m_pages == m_worksheetPages && ! pagesPending() ) )
     {
         // These statements are equivalent to calling regenerateWorksheet()
         // but avoid the unnecessary overhead of re-creating the EqTree.
@@ -1557,7 +1588,18 @@ void BpDocument::run( bool showRunDialog )
     int page = m_page;
     QString resultFile = appFileSystem()->tempFilePath( 1 );
     QString traceFile = appFileSystem()->tempFilePath( 2 );
-    if ( runWorksheet( traceFile, resultFile, showRunDialog ) )
+    // Surface fire spread profiles are written alongside the result file.
+    m_eqTree->m_profileFile = "";
+    if ( property()->boolean( "exportSpreadProfile" ) )
+    {
+        m_eqTree->m_profileFile = appFileSystem()->composerPath()
+            + "/" + property()->string( "exportSpreadProfileFile" );
+    }
+    m_pageHold = true;
+    bool ok = runWorksheet( traceFile, resultFile, showRunDialog );
+    m_pageHold = false;
+    m_eqTree->m_profileFile = "";
+    if ( ok )
     {
         page = m_worksheetPages + 1;
     }
@@ -1574,6 +1616,352 @@ void BpDocument::run( bool showRunDialog )
     return;
 }
 
+//------------------------------------------------------------------------------
+/*! \brief Solves every table cell for the input value at which an output
+ *  reaches a target value.
+ *
+ *  If the "goalSeekActive" property is TRUE, an EqGoalSeek searches the
+ *  "goalSeekInput" variable's range (or the "goalSeekMinimum" through
+ *  "goalSeekMaximum" range) for the value at which the "goalSeekOutput"
+ *  variable reaches "goalSeekTarget", and writes the solution for each
+ *  table cell to the "goalSeekResultFile".  If no result file is named, it
+ *  is written beside the worksheet file with "GoalSeek" appended to its
+ *  base name.
+ *
+ *  Called only by BpDocument::runWorksheet().
+ *
+ *  \return TRUE on success, FALSE on failure or if the user cancelled.
+ */
+
+bool BpDocument::runGoalSeek( void )
+{
+    QString resultFile = property()->string( "goalSeekResultFile" );
+    QString text("");
+    if ( resultFile.isEmpty() )
+    {
+        QFileInfo fi( m_absPathName );
+        resultFile = fi.dirPath( true ) + "/" + m_baseName + "GoalSeek.csv";
+    }
+    m_eqTree->rangeCase();
+    EqGoalSeek goalSeek( m_eqTree );
+    if ( ! goalSeek.run(
+            property()->string( "goalSeekInput" ),
+            property()->string( "goalSeekOutput" ),
+            property()->string( "goalSeekTarget" ),
+            property()->string( "goalSeekMinimum" ),
+            property()->string( "goalSeekMaximum" ),
+            property()->real( "goalSeekTolerance" ),
+            resultFile ) )
+    {
+        if ( ! goalSeek.error().isEmpty() )
+        {
+            error( goalSeek.error() );
+        }
+        m_eqTree->runClean();
+        return( false );
+    }
+    setRunTime();
+    regenerateWorksheet();
+    translate( text, "BpDocument:GoalSeek:Done",
+        QString( "%1" ).arg( goalSeek.solved() ),
+        QString( "%1" ).arg( goalSeek.cells() ), resultFile );
+    info( text );
+    m_eqTree->runClean();
+    return( true );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Finds the region of the worksheet's continuous row and column
+ *  input ranges that is within all the active output prescriptions.
+ *
+ *  If the "rxWindowActive" property is TRUE, an EqRxWindow bisects the
+ *  region spanned by the row and column values (up to "rxWindowDepth"
+ *  times) only where it holds part of the window boundary, and writes the
+ *  boxes it accepts to the "rxWindowResultFile".  If no result file is
+ *  named, it is written beside the worksheet file with "RxWindow" appended
+ *  to its base name.
+ *
+ *  Called only by BpDocument::runWorksheet().
+ *
+ *  \return TRUE on success, FALSE on failure or if the user cancelled.
+ */
+
+bool BpDocument::runRxWindow( void )
+{
+    QString resultFile = property()->string( "rxWindowResultFile" );
+    QString text("");
+    if ( resultFile.isEmpty() )
+    {
+        QFileInfo fi( m_absPathName );
+        resultFile = fi.dirPath( true ) + "/" + m_baseName + "RxWindow.csv";
+    }
+    m_eqTree->rangeCase();
+    EqRxWindow window( m_eqTree );
+    if ( ! window.run( property()->integer( "rxWindowDepth" ), resultFile ) )
+    {
+        if ( ! window.error().isEmpty() )
+        {
+            error( window.error() );
+        }
+        m_eqTree->runClean();
+        return( false );
+    }
+    setRunTime();
+    regenerateWorksheet();
+    translate( text, "BpDocument:RxWindow:Done",
+        QString( "%1" ).arg( window.evaluations() ),
+        QString( "%1" ).arg( window.denseEvaluations() ),
+        QString( "%1" ).arg( 100. * window.insideFraction(), 0, 'f', 1 ),
+        QString( "%1" ).arg( 100. * window.boundaryFraction(), 0, 'f', 1 ),
+        resultFile );
+    info( text );
+    m_eqTree->runClean();
+    return( true );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Computes and displays the uncertainty results for a worksheet whose
+ *  range variables describe uncertain inputs.
+ *
+ *  If the "uncertaintyActive" property is TRUE, the entered values of each
+ *  range variable describe an input distribution (see EqSample), which is
+ *  sampled "uncertaintySamples" times with either a Latin hypercube
+ *  ("uncertaintyLatinHypercube") or a Monte Carlo design.
+ *  The quantiles and histograms of the output variables and the probability
+ *  of being within prescription are then composed on a single results page.
+ *
+ *  Called only by BpDocument::runWorksheet().
+ *
+ *  \return TRUE on success, FALSE on failure or if the user cancelled.
+ */
+
+bool BpDocument::runSample( void )
+{
+    EqSample sample( m_eqTree );
+    if ( ! sample.run( property()->integer( "uncertaintySamples" ),
+            property()->boolean( "uncertaintyLatinHypercube" ),
+            property()->boolean( "uncertaintyNormal" ),
+            property()->integer( "uncertaintySeed" ) ) )
+    {
+        m_eqTree->runClean();
+        return( false );
+    }
+    setRunTime();
+    regenerateWorksheet();
+    composeSample( &sample );
+
+    // Display discrete variables
+    if ( property()->boolean( "worksheetShowUsedChoices" ) )
+    {
+        pageTaskAdd( PageTaskDocumentation );
+    }
+    m_eqTree->runClean();
+    return( true );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Determines how sensitive every continuous output is to every
+ *  continuous input in each table cell.
+ *
+ *  If the "sensitivityActive" property is TRUE, an EqSensitivity writes
+ *  each cell's output derivatives and elasticities to the
+ *  "sensitivityResultFile".  If no result file is named, it is written
+ *  beside the worksheet file with "Sensitivity" appended to its base name.
+ *
+ *  Called only by BpDocument::runWorksheet().
+ *
+ *  \return TRUE on success, FALSE on failure or if the user cancelled.
+ */
+
+bool BpDocument::runSensitivity( void )
+{
+    QString resultFile = property()->string( "sensitivityResultFile" );
+    QString text("");
+    if ( resultFile.isEmpty() )
+    {
+        QFileInfo fi( m_absPathName );
+        resultFile = fi.dirPath( true ) + "/" + m_baseName + "Sensitivity.csv";
+    }
+    m_eqTree->rangeCase();
+    EqSensitivity sensitivity( m_eqTree );
+    if ( ! sensitivity.run( property()->real( "sensitivityStep" ),
+            resultFile ) )
+    {
+        if ( ! sensitivity.error().isEmpty() )
+        {
+            error( sensitivity.error() );
+        }
+        m_eqTree->runClean();
+        return( false );
+    }
+    setRunTime();
+    regenerateWorksheet();
+    translate( text, "BpDocument:Sensitivity:Done",
+        QString( "%1" ).arg( sensitivity.outVars() ),
+        QString( "%1" ).arg( sensitivity.inVars() ),
+        QString( "%1" ).arg( sensitivity.cells() ), resultFile,
+        QString( "%1" ).arg( sensitivity.flagged() ),
+        QString( "%1" ).arg( sensitivity.propagated() ) );
+    info( text );
+    m_eqTree->runClean();
+    return( true );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Runs the worksheet for every record of a weather stream file.
+ *
+ *  If the "weatherStreamActive" property is TRUE, an EqStream reads each
+ *  record of the "weatherStreamFile" comma-separated weather stream, sets
+ *  its values into the worksheet's input variables, and appends the output
+ *  variables to the "weatherStreamResultFile" as each record is run.  If
+ *  no result file is named, it is written beside the weather stream file
+ *  with "Results" appended to its base name.
+ *
+ *  Called only by BpDocument::runWorksheet().
+ *
+ *  \return TRUE on success, FALSE on failure or if the user cancelled.
+ */
+
+bool BpDocument::runStream( void )
+{
+    QString streamFile = property()->string( "weatherStreamFile" );
+    QString resultFile = property()->string( "weatherStreamResultFile" );
+    QString text("");
+    if ( streamFile.isEmpty() )
+    {
+        translate( text, "BpDocument:Stream:NoFile" );
+        error( text );
+        return( false );
+    }
+    if ( resultFile.isEmpty() )
+    {
+        QFileInfo fi( streamFile );
+        resultFile = fi.dirPath( true ) + "/" + fi.baseName() + "Results.csv";
+    }
+    EqStream stream( m_eqTree );
+    if ( ! stream.run( streamFile, resultFile ) )
+    {
+        if ( ! stream.error().isEmpty() )
+        {
+            error( stream.error() );
+        }
+        m_eqTree->runClean();
+        return( false );
+    }
+    setRunTime();
+    regenerateWorksheet();
+    translate( text, "BpDocument:Stream:Done",
+        QString( "%1" ).arg( stream.records() ), resultFile );
+    info( text );
+    m_eqTree->runClean();
+    return( true );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Computes and displays results for a worksheet with more than two
+ *  range variables.
+ *
+ *  If the "tableSweepActive" property is TRUE, an EqSweep evaluates every
+ *  combination of the range variable values.  The results are sliced into a
+ *  two-way table (and, if the first or second range variable is
+ *  continuous, a set of line graphs) for every combination of the values
+ *  of the third and subsequent range variables, which are shown beneath
+ *  each table and graph title.
+ *
+ *  Called only by BpDocument::runWorksheet().
+ *
+ *  \return TRUE on success, FALSE on failure or if the user cancelled.
+ */
+
+bool BpDocument::runSweep( void )
+{
+    // Calculate every combination of the range variables
+    EqSweep sweep( m_eqTree );
+    if ( ! sweep.run( appFileSystem()->tempFilePath( 3 ) ) )
+    {
+        m_eqTree->runClean();
+        return( false );
+    }
+    setRunTime();
+    regenerateWorksheet();
+
+    // Tables use the first two range variables as rows and columns,
+    // while graphs use the first continuous one as the x variable.
+    int xDim = -1;
+    int zDim = -1;
+    if ( sweep.dimVar( 0 )->isContinuous() )
+    {
+        xDim = 0;
+        zDim = 1;
+    }
+    else if ( sweep.dimVar( 1 )->isContinuous() )
+    {
+        xDim = 1;
+        zDim = 0;
+    }
+    bool doTables = property()->boolean( "tableActive" );
+    bool doGraphs = property()->boolean( "graphActive" ) && xDim >= 0;
+    // Line graphs need increasing x values
+    int dim, i;
+    for ( i = 1;
+          doGraphs && i < sweep.dimValues( xDim );
+          i++ )
+    {
+        if ( sweep.dimValue( xDim, i ) <= sweep.dimValue( xDim, i-1 ) )
+        {
+            doGraphs = false;
+        }
+    }
+    // Compose a slice for each combination of the remaining range variables
+    int *index = new int[ sweep.dims() ];
+    checkmem( __FILE__, __LINE__, index, "int index", sweep.dims() );
+    for ( dim = 0;
+          dim < sweep.dims();
+          dim++ )
+    {
+        index[dim] = 0;
+    }
+    bool more = true;
+    while ( more )
+    {
+        if ( doTables )
+        {
+            sweep.slice( 0, 1, index );
+            composeTable3( m_eqTree->m_rangeVar[0], m_eqTree->m_rangeVar[1] );
+            pageRunClose();
+        }
+        if ( doGraphs )
+        {
+            sweep.slice( xDim, zDim, index );
+            composeGraphsLater( true, false );
+            pageRunClose();
+        }
+        // Step to the next combination
+        more = false;
+        for ( dim = sweep.dims() - 1;
+              dim >= 2;
+              dim-- )
+        {
+            if ( ++index[dim] < sweep.dimValues( dim ) )
+            {
+                more = true;
+                break;
+            }
+            index[dim] = 0;
+        }
+    }
+    delete[] index; index = 0;
+
+    // Display discrete variables
+    if ( property()->boolean( "worksheetShowUsedChoices" ) )
+    {
+        pageTaskAdd( PageTaskDocumentation );
+    }
+    pageRunClose();
+    m_eqTree->runClean();
+    return( true );
+}
+
 //------------------------------------------------------------------------------
 /*! \brief Computes and displays results for the current worksheet.
  *
@@ -1598,6 +1986,52 @@ bool BpDocument::runWorksheet( const QString &traceFile,
     {
         return( false );
     }
+    // Results of any previous run are no longer valid.
+    m_eqTree->m_resultCache->clear();
+    // Table cells may be kept on disk for reuse by later runs.
+    if ( property()->boolean( "resultCacheActive" ) )
+    {
+        m_eqTree->m_diskCache->setFile(
+            appFileSystem()->composerPath( "ResultCache.bin" ),
+            property()->integer( "resultCacheMaxEntries" ),
+            appWindow()->m_release );
+    }
+    else
+    {
+        m_eqTree->m_diskCache->setFile( "", 0, 0 );
+    }
+
+    // The worksheet may be run for every record of a weather stream.
+    if ( property()->boolean( "weatherStreamActive" ) )
+    {
+        return( runStream() );
+    }
+    // The worksheet's table cells may be solved for an input value.
+    if ( property()->boolean( "goalSeekActive" ) )
+    {
+        return( runGoalSeek() );
+    }
+    // The row and column ranges may be searched for a prescription window.
+    if ( property()->boolean( "rxWindowActive" ) )
+    {
+        return( runRxWindow() );
+    }
+    // The outputs may be differentiated with respect to the inputs.
+    if ( property()->boolean( "sensitivityActive" ) )
+    {
+        return( runSensitivity() );
+    }
+    // Range variables may describe uncertain inputs to be sampled.
+    if ( m_eqTree->m_rangeVars > 0
+      && property()->boolean( "uncertaintyActive" ) )
+    {
+        return( runSample() );
+    }
+    // More than two range variables is an N-dimensional sweep.
+    if ( m_eqTree->m_rangeVars > 2 )
+    {
+        return( runSweep() );
+    }
     // Determine the range case.
     m_eqTree->rangeCase();
 
@@ -1614,12 +2048,15 @@ bool BpDocument::runWorksheet( const QString &traceFile,
         regenerateWorksheet();
         // Compose the results table.
         composeTable1();
-        composeDiagrams();
+        composeDiagramsLater();
         if ( property()->boolean( "worksheetShowUsedChoices" ) )
         {
-            composeDocumentation();
+            pageTaskAdd( PageTaskDocumentation );
         }
+        // Keep the run tables needed by deferred pages and free the rest.
+        pageRunClose();
         m_eqTree->runClean();
+        m_eqTree->m_resultCache->clear();
         return( true );
     }
 
@@ -1683,7 +2120,7 @@ bool BpDocument::runWorksheet( const QString &traceFile,
         // m_eqTree->m_eqCalc->weightedSpread( this, true, true );
 
         // Finally, draw any requested figures.
-        composeDiagrams();
+        composeDiagramsLater();
     }
 	// V5.0.5 - Always generate the HTML run input table for later export
 	else
@@ -1710,7 +2147,9 @@ bool BpDocument::runWorksheet( const QString &traceFile,
         // Case 2: 1 continuous and 0 discrete range variables.
         if ( m_eqTree->m_rangeCase == 2 )
         {
-            // Calculate the graph values.
+            // Calculate the graph values; deferred table pages keep
+            // their own copy of the table run.
+            pageRunClose();
             if ( m_eqTree->runTable( "", "", true ) )
             {
                 // Compose the worksheet if it hasn't already been composed.
@@ -1721,7 +2160,7 @@ bool BpDocument::runWorksheet( const QString &traceFile,
                     drawWorksheet = false;
                 }
                 // Compose the graph.
-                composeGraphs( true, showRunDialog );
+                composeGraphsLater( true, showRunDialog );
             }
         }
         // Case 3: 0 continuous and 1 discrete range variables.
@@ -1739,12 +2178,14 @@ bool BpDocument::runWorksheet( const QString &traceFile,
                     drawWorksheet = false;
                 }
                 // Compose the graph.
-                composeGraphs( false, showRunDialog );
+                composeGraphsLater( false, showRunDialog );
             }
         }
         // Case 4: 2 continuous and 0 discrete range variables.
         else if ( m_eqTree->m_rangeCase == 4 )
         {
+            // Deferred table pages keep their own copy of the table run.
+            pageRunClose();
             // Either continuous variable may be the graph x or z variables.
             if ( property()->boolean( "graphXVar1" ) && tableVarsSwapped
               || property()->boolean( "graphXVar2" ) && ! tableVarsSwapped )
@@ -1765,7 +2206,7 @@ bool BpDocument::runWorksheet( const QString &traceFile,
                     drawWorksheet = false;
                 }
                 // Compose the graph.
-                composeGraphs( true, showRunDialog );
+                composeGraphsLater( true, showRunDialog );
             }
         }
         // Case 5: 0 continuous and 2 discrete range variables.
@@ -1784,6 +2225,8 @@ bool BpDocument::runWorksheet( const QString &traceFile,
         // Case 6: 1 continuous and 1 discrete range variables.
         else if ( m_eqTree->m_rangeCase == 6 )
         {
+            // Deferred table pages keep their own copy of the table run.
+            pageRunClose();
             // The continuous variable MUST be the graph x variable
             // and the discrete variable MUST be the graph z variable.
             if ( m_eqTree->m_rangeVar[0]->isDiscrete() )
@@ -1804,7 +2247,7 @@ bool BpDocument::runWorksheet( const QString &traceFile,
                     drawWorksheet = false;
                 }
                 // Compose the graph.
-                composeGraphs( true, showRunDialog );
+                composeGraphsLater( true, showRunDialog );
             }
         }
     }
@@ -1812,11 +2255,13 @@ bool BpDocument::runWorksheet( const QString &traceFile,
     // Display discrete variables
     if ( property()->boolean( "worksheetShowUsedChoices" ) )
     {
-        composeDocumentation();
+        pageTaskAdd( PageTaskDocumentation );
     }
 
-    // Free the EqTree run resources.
+    // Keep the run tables needed by deferred pages and free the rest.
+    pageRunClose();
     m_eqTree->runClean();
+    m_eqTree->m_resultCache->clear();
     return( true );
 }
 
@@ -1932,7 +2377,11 @@ void BpDocument::showPage( int pageNumber )
     // moved to end of the method 
 	//m_doValidation = true;
 
-    // Results pages may have been trimmed!
+    // Compose any deferred pages; results pages may have been trimmed!
+    if ( pageNumber > m_pages )
+    {
+        composePending( pageNumber );
+    }
     if ( pageNumber > m_pages )
     {
         pageNumber = m_pages;
@@ -2105,10 +2554,16 @@ void BpDocument::showPage( int pageNumber )
     // Complete the tab order
     //setTabOrder( prevWidget, m_entry.at(0) );
 
-    // Show the composed page in the scrollview and return.
+    // Show the composed page in the scrollview.
     Document::showPage( pageNumber );
     m_entry.at(m_focusEntry)->setFocus();
 	m_doValidation = true;
+
+    // Compose the next few deferred pages while the user reads this one.
+    if ( ! m_pageTasks->isEmpty() )
+    {
+        m_pageTimer->start( 0, true );
+    }
     return;
 }
 
@@ -2350,7 +2805,8 @@ int BpDocument::tableVars( void ) const
  *  EqVar::m_stores, then calls EqTree->validate() to verify that:
  *      -# entry text is valid,
  *      -# all required inputs are present,
- *      -# there are no more than two range variables, and
+ *      -# there are no more than two range variables (unless the
+ *         "tableSweepActive" or "uncertaintyActive" property is set), and
  *      -# EqCalc::validate() passes all cross-validation tests.
  *
  *  If the validation fails for an input variable, the focus is repositioned
@@ -2408,8 +2864,14 @@ bool BpDocument::validateWorksheet( void )
 
     // Validate the entries
     // Note that EqTree->validateInputs() calls EqCalc->validateInputs().
+    // Sweeps may have more than two range variables.
+    int maxRangeVars = ( property()->boolean( "tableSweepActive" )
+                      || property()->boolean( "uncertaintyActive" ) )
+                     ? m_eqTree->m_maxRangeVars
+                     : 2;
     int result, badLid, badPos, badLeng;
-    if ( ( result = m_eqTree->validateInputs( &badLid, &badPos, &badLeng ) ) < 0 )
+    if ( ( result = m_eqTree->validateInputs( &badLid, &badPos, &badLeng,
+            maxRangeVars ) ) < 0 )
     {
         // Invalid entry
         if ( result == -1 )
@@ -19,12 +19,15 @@
 #include <qmainwindow.h>
 #include <qmemarray.h>
 #include <qpixmap.h>
+#include <qptrlist.h>
 
 class AppWindow;
 class Composer;
 class BpDocEntry;
 class EqApp;
+class EqSample;
 class EqTree;
+class EqTreeRun;
 class Graph;
 class GraphAxleParms;
 class PropertyDict;
@@ -34,8 +37,35 @@ class QLabel;
 class QLineEdit;
 class QPushButton;
 class QTextEdit;
+class QTimer;
 class QWorkspace;
 
+//------------------------------------------------------------------------------
+/*! \struct BpPageTask bpdocument.h
+ *
+ *  \brief A results page section recorded by BpDocument::runWorksheet()
+ *  whose pages are not composed until they are first shown, printed, or
+ *  pre-composed in the background.
+ */
+
+struct BpPageTask
+{
+    BpPageTask( void ) ;
+    ~BpPageTask( void ) ;
+
+    int        m_type;          //!< BpDocument::PageTaskType
+    int        m_vid;           //!< Output table variable index
+    EqVar     *m_rowVar;        //!< Table row variable
+    EqVar     *m_colVar;        //!< Table column variable
+    bool       m_lineGraphs;    //!< Line graphs (TRUE) or bar graphs (FALSE)
+    bool       m_needsRun;      //!< TRUE if the section uses the run tables
+    EqTreeRun *m_run;           //!< Run tables, or NULL for the current run
+    QPtrList<GraphAxleParms> *m_yParmsList; //!< Graph y axles, or NULL
+    QString    m_resultFile;    //!< Diagram result file owned by the task
+    QString    m_traceFile;     //!< Diagram trace file owned by the task
+    bool       m_removeFiles;   //!< TRUE if the task removes its files
+};
+
 //------------------------------------------------------------------------------
 /*! \class BpDocument bpdocument.h
  *
@@ -100,6 +130,15 @@ class BpDocument : public Document
 // Enable signals and slots on this class
     Q_OBJECT
 
+//! Enumerates the deferred results page section types.
+enum PageTaskType
+{
+    PageTaskTable3=1,           //!< composeTable3() for one output variable
+    PageTaskGraphs=2,           //!< composeGraphs()
+    PageTaskDocumentation=3,    //!< composeDocumentation()
+    PageTaskDiagrams=4          //!< composeDiagrams()
+};
+
 //! Enumerates the available context menu options.
 enum ContextMenuOption
 {
@@ -122,12 +161,14 @@ public:
     virtual void clear( bool showRunDialog=true ) ;
     virtual void composeDocumentation( void ) ;
     virtual void composeGuideButtonPixmap( int wd, int ht ) ;
-    virtual bool composeGraphs( bool lineGraphs, bool showDialogs ) ;
+    virtual bool composeGraphs( bool lineGraphs, bool showDialogs,
+                    QPtrList<GraphAxleParms> *yParmsList=0 ) ;
     virtual void composeLogo( double x0, double y0,
                     double wd, double ht, int penWd ) ;
     virtual void composeTable1( void ) ;
     virtual void composeTable2( EqVar *rowVar) ;
     virtual void composeTable3( EqVar *rowVar, EqVar *colVar ) ;
+    virtual int  composePending( int thruPage ) ;
     virtual void configure( void ) ;
     virtual void configureAppearance( void ) ;
     virtual void configureFuelModels( void ) ;
@@ -136,8 +177,10 @@ public:
     virtual void configureUnits( const QString &unitsSet ) ;
     virtual void maintenance( void ) ;
     virtual bool open( const QString &fileName, const QString &fileType ) ;
+    virtual bool pagesPending( void ) const ;
     virtual bool print( void ) ;
     virtual bool printPS( int fromPage, int thruPage ) ;
+    virtual void removeComposerFiles( int fromPageNumber=1 ) ;
     virtual void reset( bool showRunDialog=true ) ;
     virtual void run( bool showRunDialog=true ) ;
     virtual void setFocus( void ) ;
@@ -174,6 +217,7 @@ public slots:
 
 // Protected slots.
 protected slots:
+    virtual void composeAhead( void ) ;
     virtual void contextMenuActivated( int id ) ;
     virtual void guideClicked( int id );
     virtual void fuelClicked( void ) ;
@@ -203,6 +247,9 @@ private:
                 GraphAxleParms *xParms, GraphAxleParms *yParms ) ;
     void    composeContainDiagram( void ) ;
     void    composeDiagrams( void ) ;
+    void    composeDiagramsLater( void ) ;
+    void    composeGraphsLater( bool lineGraphs, bool showDialogs ) ;
+    void    composeSample( EqSample *sample ) ;
     void    composeFireCharacteristicsDiagram( void ) ;
     void    composeFireShapeDiagram( void ) ;
     void    composeFireMaxDirDiagram( void ) ;
@@ -220,17 +267,28 @@ private:
     void    composeTable1Spreadsheet( void ) ;
     void    composeTable2Html( EqVar *rowVar ) ;
     void    composeTable2Spreadsheet( EqVar *rowVar ) ;
-    void    composeTable3Html( EqVar *rowVar, EqVar *colVar );
-    void    composeTable3Html( FILE *fptr, int vid, EqVar *rowVar, EqVar *colVar ) ;
-    void    composeTable3Spreadsheet( EqVar *rowVar, EqVar *colVar ) ;
-    void    composeTable3Spreadsheet( FILE *fptr, int vid, EqVar *rowVar, EqVar *colVar );
+    void    composeTable3Columnar( void ) ;
+    void    composeTable3Html( void ) ;
+    void    composeTable3Spreadsheet( void ) ;
     void    composeTable3( int vid, EqVar *rowVar, EqVar *colVar ) ;
     void    graphYMinMax( int yid, double &yMin, double &yMax ) ;
+    QPtrList<GraphAxleParms> *graphYParms( bool lineGraphs,
+                bool showDialogs ) ;
     void    grayInputs( void ) ;
     int     headerWidth( EqVar *varPtr, const QFontMetrics &fm ) ;
     void    loadNotes( void ) ;
     double  newWorksheetPage( double lineHt, TocType=TocInput ) ;
+    void    pageRunClose( void ) ;
+    void    pageTaskAdd( int type, int vid=0, EqVar *rowVar=0,
+                EqVar *colVar=0, bool lineGraphs=true ) ;
+    void    pageTasksClear( void ) ;
+    bool    runGoalSeek( void ) ;
     void    runOptions( QString* runOpt, int& nOptions ) ;
+    bool    runRxWindow( void ) ;
+    bool    runSample( void ) ;
+    bool    runSensitivity( void ) ;
+    bool    runStream( void ) ;
+    bool    runSweep( void ) ;
     bool    runWorksheet( const QString &traceFile, const QString &resultFile,
                 bool showRunDialog=true ) ;
     void    saveAsFuelModelExportFile( const QString &fileType ) ;
@@ -365,6 +423,25 @@ public:
     //@}
 	int m_colDecimals;
 	int m_rowDecimals;
+
+    /*! \name Deferred Results Page Member Data
+     *  \brief Results page sections recorded by runWorksheet() and composed
+     *  by composePending() or composeAhead().
+     */
+    //@{
+    //! List of results page sections not yet composed.
+    QPtrList<BpPageTask>   *m_pageTasks;
+    //! List of run tables owned by the m_pageTasks.
+    QPtrList<EqTreeRun>    *m_pageRuns;
+    //! Single-shot timer that drives composeAhead().
+    QTimer                 *m_pageTimer;
+    //! TRUE while composePending() is composing a section.
+    bool                    m_pageComposing;
+    //! TRUE while runWorksheet() is running, which suspends composeAhead().
+    bool                    m_pageHold;
+    //! TRUE if a m_pageTasks entry needs the EqTree's current run tables.
+    bool                    m_pageRunUsed;
+    //@}
 };
 
 #endif
@@ -1176,7 +1176,7 @@ void BpDocument::saveAsWorksheetFile( const QString &fileName )
 void BpDocument::saveResults( const QString &fileType )
 {
     // There must be results
-    if ( m_pages == m_worksheetPages )
+    if ( m_pages == m_worksheetPages && m_pageTasks->isEmpty() )
     {
         QString errMsg("");
         translate( errMsg, "Menu:File:Export:Results:NoResults" );
@@ -22,6 +22,7 @@
 #include "docdevicesize.h"
 #include "docpagesize.h"
 #include "doctabs.h"
+#include "ephemeris.h"
 #include "globalposition.h"
 #include "property.h"
 
@@ -175,6 +176,9 @@ void CalendarDocument::composeCalendar( DateTime *dt, GlobalPosition *gp )
         align, qStr );                      // Center lat-lon
     yPos += 2*numberHt;
 
+    // All sun and moon times come from the location's year ephemeris.
+    Ephemeris *eph = Ephemeris::find( *gp, dt->year() );
+
     // Determine the requested display elements.
     bool doSunTimes  = m_prop->boolean( "calCalendarSunTimes" );
     bool doMoonPhase = m_prop->boolean( "calCalendarMoonPhase" );
@@ -222,9 +226,8 @@ void CalendarDocument::composeCalendar( DateTime *dt, GlobalPosition *gp )
               period <= 14;
               period++ )
         {
-            int l_year = dt->year();
             // First new moon.
-            moonDate[0].newMoon( dt->year(), period, *gp );
+            moonDate[0].set( eph->newMoon( period ) );
             newMoon0 = moonDate[0].julianDate();
             // We're done if we got into the next year.
             if ( moonDate[0].year() > dt->year() )
@@ -238,7 +241,7 @@ void CalendarDocument::composeCalendar( DateTime *dt, GlobalPosition *gp )
                 break;
             }
             // Next new moon.
-            moonDate[4].newMoon( l_year, period+1, *gp );
+            moonDate[4].set( eph->newMoon( period+1 ) );
             newMoon1 = moonDate[4].julianDate();
             // Interpolate and store phases between the two new moons.
             qtr1Moon = newMoon0 + 0.25 * ( newMoon1 - newMoon0 );
@@ -312,7 +315,7 @@ void CalendarDocument::composeCalendar( DateTime *dt, GlobalPosition *gp )
         {
             // Sunrise time.
             date.set( dt->year(), dt->month(), day );
-            date.sunRise( *gp );
+            date.riseSet( CDT_SunRise, *eph );
             if ( date.flag() == CDT_Invisible )
             {
                 translate( qStr, "CalendarDoc:RiseSet:Below-" );
@@ -330,7 +333,7 @@ void CalendarDocument::composeCalendar( DateTime *dt, GlobalPosition *gp )
 
             // Sunset time.
             date.set( dt->year(), dt->month(), day );
-            date.sunSet( *gp );
+            date.riseSet( CDT_SunSet, *eph );
             if ( date.flag() == CDT_Invisible )
             {
                 translate( qStr2, "CalendarDoc:RiseSet:Below" );
@@ -360,7 +363,7 @@ void CalendarDocument::composeCalendar( DateTime *dt, GlobalPosition *gp )
         {
             // Moonrise
             date.set( dt->year(), dt->month(), day );
-            date.moonRise( *gp );
+            date.riseSet( CDT_MoonRise, *eph );
             if ( date.flag() == CDT_NeverRises )
             {
                 translate( qStr, "CalendarDoc:RiseSet:Never-" );
@@ -382,7 +385,7 @@ void CalendarDocument::composeCalendar( DateTime *dt, GlobalPosition *gp )
 
             // Moonset
             date.set( dt->year(), dt->month(), day );
-            date.moonSet( *gp );
+            date.riseSet( CDT_MoonSet, *eph );
             if ( date.flag() == CDT_NeverSets )
             {
                 translate( qStr, "CalendarDoc:RiseSet:Never-" );
@@ -698,6 +701,9 @@ void CalendarDocument::composeChart( DateTime *dt, GlobalPosition *gp )
     }
     yPos += textHt;
 
+    // All sun and moon times come from the location's year ephemeris.
+    Ephemeris *eph = Ephemeris::find( *gp, dt->year() );
+
     // Write a row for each day of the month.
     m_composer->font( valueFont );                  // use calValueFont
     m_composer->pen( valuePen );                    // use calValueFontColor
@@ -734,7 +740,7 @@ void CalendarDocument::composeChart( DateTime *dt, GlobalPosition *gp )
         if ( doSunRise )
         {
             date.set( dt->year(), dt->month(), day );
-            date.sunRise( *gp );
+            date.riseSet( CDT_SunRise, *eph );
             // If the sun is always below the horizon...
             if ( date.flag() == CDT_Invisible )
             {
@@ -762,7 +768,7 @@ void CalendarDocument::composeChart( DateTime *dt, GlobalPosition *gp )
         if ( doSunSet )
         {
             date.set( dt->year(), dt->month(), day );
-            date.sunSet( *gp );
+            date.riseSet( CDT_SunSet, *eph );
             // If the sun stays below the horizon...
             if ( date.flag() == CDT_Invisible )
             {
@@ -790,7 +796,7 @@ void CalendarDocument::composeChart( DateTime *dt, GlobalPosition *gp )
         if ( doMoonRise )
         {
             date.set( dt->year(), dt->month(), day );
-            date.moonRise( *gp );
+            date.riseSet( CDT_MoonRise, *eph );
             // If the moon never rises...
             if ( date.flag() == CDT_NeverRises )
             {
@@ -823,7 +829,7 @@ void CalendarDocument::composeChart( DateTime *dt, GlobalPosition *gp )
         if ( doMoonSet )
         {
             date.set( dt->year(), dt->month(), day );
-            date.moonSet( *gp );
+            date.riseSet( CDT_MoonSet, *eph );
             // If the moon never sets...
             if ( date.flag() == CDT_NeverSets )
             {
@@ -856,7 +862,7 @@ void CalendarDocument::composeChart( DateTime *dt, GlobalPosition *gp )
         if ( doCivilDawn )
         {
             date.set( dt->year(), dt->month(), day );
-            date.civilDawn( *gp );
+            date.riseSet( CDT_CivilDawn, *eph );
             // If it stays light all day...
             if ( date.flag() == CDT_Light )
             {
@@ -884,7 +890,7 @@ void CalendarDocument::composeChart( DateTime *dt, GlobalPosition *gp )
         if ( doCivilDusk )
         {
             date.set( dt->year(), dt->month(), day );
-            date.civilDusk( *gp );
+            date.riseSet( CDT_CivilDusk, *eph );
             // If it is light all day...
             if ( date.flag() == CDT_Light )
             {
@@ -1307,14 +1313,14 @@ void CalendarDocument::composeSeasons( DateTime *dt, GlobalPosition *gp )
     m_composer->pen( valuePen );
 
     // Draw one new, 1st quarter, full, and 3rd quarter moon cycle per row.
+    Ephemeris *eph = Ephemeris::find( *gp, year );
     double newMoon0, newMoon1, fullMoon, qtr1Moon, qtr3Moon;
     for ( int period = 0;
           period <= 14;
           period++ )
     {
-        int l_year = year;
         // First new moon.
-        date[0].newMoon( year, period, *gp );
+        date[0].set( eph->newMoon( period ) );
         newMoon0 = date[0].julianDate();
         // Are we done with this year?
         if ( date[0].year() > year )
@@ -1322,7 +1328,7 @@ void CalendarDocument::composeSeasons( DateTime *dt, GlobalPosition *gp )
             break;
         }
         // Next new moon.
-        date[4].newMoon( l_year, period+1, *gp );
+        date[4].set( eph->newMoon( period+1 ) );
         newMoon1 = date[4].julianDate();
         // Interpolate and store the moon phases.
         qtr1Moon = newMoon0 + 0.25 * ( newMoon1 - newMoon0 );
@@ -59,6 +59,7 @@ static double cs( double degrees ) ;
 static void CDT_ImproveMoon( double *t0, double *b ) ;
 static void CDT_MiniMoon( double t, double *ra, double *dec ) ;
 static void CDT_MiniSun( double t, double *ra, double *dec ) ;
+static int CDT_RiseSetHorizon( int event, double *sinh0 ) ;
 static double sn( double degrees ) ;
 
 /*----------------------------------------------------------------------------*/
@@ -1025,76 +1026,128 @@ int CDT_QuadraticRoots(
 int CDT_RiseSet( int event, double jdate, double lon, double lat,
             double gmtDiff, double *hours )
 {
-    double amjd, sinh0;
-    double y_minus, y_0, y_plus;
-    double xe, ye, zero1, zero2, utset, utrise, sphi, cphi, hour;
-    int doRise, doSet, above, rise, sett, nz, flag, jd;
+    double amjd, sinh0, sphi, cphi, sineAlt[25];
+    int jd, hour;
 
+    /* Ignore events that have no rise or set */
+    if ( ! CDT_RiseSetHorizon( event, &sinh0 ) )
+    {
+        return( CDT_None );
+    }
     /* Strip time from the Julian date. */
     jd = (int) ( jdate - 2400000.5 );
     /* Convert to modified JD adjusted for time zone difference to GMT */
     amjd = (double) jd - gmtDiff / 24.;
 
-    /* Determine the parameters for this type of event */
-    doRise = 0;
-    doSet = 0;
-    flag = CDT_None;
+    /* Sample the sine of the altitude at each hour from 0h to 24h */
+    sphi = sn( lat );
+    cphi = cs( lat );
+    for ( hour = 0;
+          hour <= 24;
+          hour++ )
+    {
+        sineAlt[hour] = CDT_SineAltitude( event, amjd, (double) hour, lon,
+            cphi, sphi );
+    }
+    return( CDT_RiseSetSearch( event, sineAlt, hours ) );
+}
+
+/*----------------------------------------------------------------------------*/
+/*! \brief Determines the altitude at which an event's rise or set occurs.
+ *
+ *  \param event   One of the #CDT_Event rise or set enumerations.
+ *  \param *sinh0  Returned sine of the event's horizon altitude.
+ *
+ *  \retval 1 if \a event is a rise or dawn event.
+ *  \retval 2 if \a event is a set or dusk event.
+ *  \retval 0 if \a event has no rise or set.
+ *  \internal
+ */
+
+static int CDT_RiseSetHorizon( int event, double *sinh0 )
+{
     switch ( event )
     {
         /* Sunrise at h = -50' */
         case CDT_SunRise:
-            sinh0 = sn( -50.0/60.0 );
-            doRise = 1;
-            break;
+            *sinh0 = sn( -50.0/60.0 );
+            return( 1 );
         case CDT_SunSet:
-            sinh0 = sn( -50.0/60.0 );
-            doSet = 1;
-            break;
+            *sinh0 = sn( -50.0/60.0 );
+            return( 2 );
         /* Moonrise at h = +8' */
         case CDT_MoonRise:
-            sinh0 = sn( 8.0/60.0 );
-            doRise = 1;
-            break;
+            *sinh0 = sn( 8.0/60.0 );
+            return( 1 );
         case CDT_MoonSet:
-            sinh0 = sn( 8.0/60.0 );
-            doSet = 1;
-            break;
+            *sinh0 = sn( 8.0/60.0 );
+            return( 2 );
         /* Civil twilight occurs at -6 degrees */
         case CDT_CivilDawn:
-            sinh0 = sn( -6.0 );
-            doRise = 1;
-            break;
+            *sinh0 = sn( -6.0 );
+            return( 1 );
         case CDT_CivilDusk:
-            sinh0 = sn( -6.0 );
-            doSet = 1;
-            break;
+            *sinh0 = sn( -6.0 );
+            return( 2 );
         /* Nautical twilight occurs at -12 degrees */
         case CDT_NauticalDawn:
-            sinh0 = sn( -12.0 );
-            doRise = 1;
-            break;
+            *sinh0 = sn( -12.0 );
+            return( 1 );
         case CDT_NauticalDusk:
-            sinh0 = sn( -12.0 );
-            doSet = 1;
-            break;
+            *sinh0 = sn( -12.0 );
+            return( 2 );
         /* Astronomical twilight occurs at -18 degrees */
         case CDT_AstronomicalDawn:
-            sinh0 = sn( -18.0 );
-            doRise = 1;
-            break;
+            *sinh0 = sn( -18.0 );
+            return( 1 );
         case CDT_AstronomicalDusk:
-            sinh0 = sn( -18.0 );
-            doSet = 1;
-            break;
-        default:
-            return( flag );
+            *sinh0 = sn( -18.0 );
+            return( 2 );
     }
+    return( 0 );
+}
+
+/*----------------------------------------------------------------------------*/
+/*! \brief Determines the rise or set time of the sun, moon, dawn, or dusk
+ *  from a day's hourly sine altitudes of the sun or moon.
+ *
+ *  This is the hourly quadratic interpolation search of CDT_RiseSet(),
+ *  separated so that a single set of sine altitudes can be searched for
+ *  every sun event (rise, set, and each twilight) of a day.  The sine
+ *  altitudes may be from CDT_SineAltitude() or CDT_SunMoonSineAltitude().
+ *
+ *  From Montenbruch and Pfleger, pages 51-54.
+ *
+ *  \param event    One of the #CDT_Event rise or set enumerations
+ *                  (see CDT_RiseSet()).
+ *  \param sineAlt  Array of 25 sines of the sun or moon altitude at local
+ *                  hours 0 through 24 of the day.
+ *  \param *hours   Returned decimal hours of the event.
+ *
+ *  \return One of the #CDT_Flag enumerations as described by CDT_RiseSet().
+ */
+
+int CDT_RiseSetSearch( int event, const double *sineAlt, double *hours )
+{
+    double sinh0, y_minus, y_0, y_plus;
+    double xe, ye, zero1, zero2, utset, utrise, hour;
+    int doRise, doSet, above, rise, sett, nz, flag, ih;
+
+    /* Determine the parameters for this type of event */
+    flag = CDT_None;
+    ih = CDT_RiseSetHorizon( event, &sinh0 );
+    if ( ! ih )
+    {
+        return( flag );
+    }
+    doRise = ( ih == 1 );
+    doSet  = ( ih == 2 );
 
     /* Start */
-    sphi = sn( lat );
-    cphi = cs( lat );
+    utrise = utset = 0.0;
+    ih = 1;
     hour = 1.0;
-    y_minus = CDT_SineAltitude( event, amjd, hour-1.0, lon, cphi, sphi) - sinh0;
+    y_minus = sineAlt[0] - sinh0;
     above = (y_minus > 0.);
     rise = 0;
     sett = 0;
@@ -1102,10 +1155,8 @@ int CDT_RiseSet( int event, double jdate, double lon, double lat,
     /* Loop over search intervals from [0h-2h] to [22h-24h] */
     do
     {
-        y_0    = CDT_SineAltitude( event, amjd, hour,     lon, cphi, sphi )
-               - sinh0;
-        y_plus = CDT_SineAltitude( event, amjd, hour+1.0, lon, cphi, sphi )
-               - sinh0;
+        y_0    = sineAlt[ih] - sinh0;
+        y_plus = sineAlt[ih+1] - sinh0;
         nz = CDT_QuadraticRoots( y_minus, y_0, y_plus, &xe, &ye, &zero1, &zero2 );
         if ( nz == 0 )
         {
@@ -1145,6 +1196,7 @@ int CDT_RiseSet( int event, double jdate, double lon, double lat,
         /* Prepare for next interval */
         y_minus = y_plus;
         hour += 2.0;
+        ih += 2;
     } while ( hour < 24.5 );
 
     /* Store results */
@@ -1406,6 +1458,41 @@ double CDT_SolsticeGMT( int event, int year )
     return( a[i] + b1[i]*year + b2[i]*y*y + b3[i]*y*y*y );
 }
 
+/*----------------------------------------------------------------------------*/
+/*! \brief Determines the sines of the altitudes of both the sun and the moon.
+ *
+ *  Equivalent to calling CDT_SineAltitude() once for the sun and once for
+ *  the moon, but the time and local mean sidereal time are only derived
+ *  once.  Used to sample a whole year of hourly altitudes for the sun and
+ *  moon rise, set, and twilight searches of CDT_RiseSetSearch().
+ *
+ *  From Montenbruck and Pfleger, page 52.
+ *
+ *  \param mjd       Modified Julian date.
+ *  \param lambda    Longitude in degrees (west of Greenwich is positive).
+ *  \param cphi      Cosine of the latitude
+ *  \param sphi      Sine of the latitude
+ *  \param *sunSine  Returned sine of the altitude of the sun.
+ *  \param *moonSine Returned sine of the altitude of the moon.
+ */
+
+void CDT_SunMoonSineAltitude( double mjd, double lambda, double cphi,
+    double sphi, double *sunSine, double *moonSine )
+{
+    double ra, dec, t, lmst, tau;
+    t = (mjd - 51544.5) / 36525.0;
+    lmst = CDT_LocalMeanSiderealTime( mjd, lambda );
+    /* Sun */
+    CDT_MiniSun( t, &ra, &dec );
+    tau = 15.0 * ( lmst - ra );
+    *sunSine = sphi * sn(dec) + cphi * cs(dec) * cs(tau);
+    /* Moon */
+    CDT_MiniMoon( t, &ra, &dec );
+    tau = 15.0 * ( lmst - ra );
+    *moonSine = sphi * sn(dec) + cphi * cs(dec) * cs(tau);
+    return;
+}
+
 /*----------------------------------------------------------------------------*/
 /*! \brief Determines the position of the sun in the sky.
  *
@@ -136,6 +136,9 @@ EXTERN double   CDT_NewMoonGMT( int year, int period ) ;
 EXTERN int      CDT_RiseSet( int event, double jdate, double lon, double lat,
                     double gmtDiff, double *hours ) ;
 
+EXTERN int      CDT_RiseSetSearch( int event, const double *sineAlt,
+                    double *hours ) ;
+
 EXTERN int      CDT_QuadraticRoots( double y_minus, double y_0, double y_plus,
                     double *xe, double *ye, double *zero1, double *zero2 ) ;
 
@@ -145,6 +148,10 @@ EXTERN double   CDT_SineAltitude( int event, double mjd0, double hour,
 EXTERN double   CDT_SolarAngle( double slope, double aspect, double altitude,
                     double azimuth ) ;
 
+EXTERN void     CDT_SunMoonSineAltitude( double mjd, double lambda,
+                    double cphi, double sphi, double *sunSine,
+                    double *moonSine ) ;
+
 EXTERN void     CDT_SunPosition( double jdate, double lon, double lat,
                     double gmtDiff, double *altitude, double *azimuth ) ;
 
@@ -7,6 +7,7 @@
  */
 
 // Custom include files
+#include "appmessage.h"
 #include "composer.h"
 #include "graph.h"
 #include "platform.h"
@@ -21,7 +22,161 @@
 #include <qpalette.h>
 #include <qpen.h>
 #include <qpixmap.h>
+#include <qpixmapcache.h>
 #include <qprinter.h>
+#include <qptrvector.h>
+
+// Standard include files
+#include <string.h>
+
+//------------------------------------------------------------------------------
+/*! \brief Composer file identification and version.
+ */
+
+static const QString ComposerMagic( "BehavePlusComposer" );
+static const int ComposerVersion = 2;
+
+//------------------------------------------------------------------------------
+/*! \brief Minimum QPixmapCache size (Kb) needed to hold several screen pages.
+ */
+
+static const int ComposerPixmapCacheKb = 32768;
+
+//------------------------------------------------------------------------------
+/*! \brief Serial number of the most recently recorded page.
+ *  Used in the QPixmapCache key so recomposed pages are never confused
+ *  with their previous pixmaps.
+ */
+
+static int ComposerSerial = 0;
+
+//------------------------------------------------------------------------------
+/*! \enum ComposerOp
+ *  \brief Display list opcodes.  Each is followed by its packed arguments
+ *  (doubles, ints, and table indices) in the order noted.
+ */
+
+enum ComposerOp
+{
+    OpAtxt=1,           //!< x y w h align string
+    OpBrush=2,          //!< brush
+    OpEllipse=3,        //!< x y w h
+    OpFill=4,           //!< x y w h brush
+    OpFont=5,           //!< font
+    OpGraph=6,          //!< x y w h graph
+    OpLine=7,           //!< x0 y0 x1 y1
+    OpPen=8,            //!< pen
+    OpPie=9,            //!< x y w h angle angleLength
+    OpPixmap=10,        //!< pixmap x y w h
+    OpPrinterOn=11,     //!< on
+    OpRect=12,          //!< x y w h
+    OpRoundRect=13,     //!< x y w h r
+    OpRestore=14,       //!<
+    OpRotate=15,        //!< deg
+    OpRotateEllipse=16, //!< rx ry x y w h deg
+    OpRotateLine=17,    //!< rx ry x1 y1 x2 y2 deg
+    OpRotateText=18,    //!< x y w h deg string
+    OpSave=19,          //!<
+    OpScreenOn=20,      //!< on
+    OpText=21,          //!< x y string
+    OpTranslate=22,     //!< x y
+    OpWrapText=23       //!< x y w h string
+};
+
+//------------------------------------------------------------------------------
+/*! \struct ComposerPage
+ *  \brief A single page's resident display list and its object tables.
+ */
+
+struct ComposerPage
+{
+    QByteArray m_ops;                   //!< Opcodes and packed arguments
+    uint       m_opsLen;                //!< Bytes used in m_ops
+    int        m_serial;                //!< Unique composition serial number
+    QPtrVector<QString>    m_str;       //!< String table
+    QPtrVector<QFont>      m_font;      //!< Font table
+    QPtrVector<QPen>       m_pen;       //!< Pen table
+    QPtrVector<QBrush>     m_brush;     //!< Brush table
+    QPtrVector<QPixmap>    m_pixmap;    //!< Pixmap table
+    QPtrVector<QByteArray> m_graph;     //!< Serialized Graph table
+
+    ComposerPage( void ) :
+        m_ops(),
+        m_opsLen(0),
+        m_serial(++ComposerSerial)
+    {
+        m_str.setAutoDelete( true );
+        m_font.setAutoDelete( true );
+        m_pen.setAutoDelete( true );
+        m_brush.setAutoDelete( true );
+        m_pixmap.setAutoDelete( true );
+        m_graph.setAutoDelete( true );
+    }
+};
+
+//------------------------------------------------------------------------------
+/*! \brief Appends \a item to the \a vec table, growing it as needed.
+ *
+ *  \return Index of the item within the table.
+ */
+
+template<class T> static int appendItem( QPtrVector<T> &vec, T *item )
+{
+    uint n = vec.count();
+    if ( n >= vec.size() )
+    {
+        vec.resize( ( n < 8 ) ? 16 : 2 * n );
+    }
+    vec.insert( n, item );
+    return( (int) n );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Finds \a item in the \a vec table, or appends a copy of it.
+ *  Pages use only a handful of different fonts, pens, and brushes.
+ *
+ *  \return Index of the item within the table.
+ */
+
+template<class T> static int findItem( QPtrVector<T> &vec, const T &item )
+{
+    for ( int i = (int) vec.count() - 1;
+          i >= 0;
+          i-- )
+    {
+        if ( *vec.at( i ) == item )
+        {
+            return( i );
+        }
+    }
+    T *copy = new T( item );
+    checkmem( __FILE__, __LINE__, copy, "Composer table item", 1 );
+    return( appendItem( vec, copy ) );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Reads a packed int from the display list and advances \a p.
+ */
+
+static inline int getInt( const char *&p )
+{
+    int value;
+    memcpy( &value, p, sizeof(int) );
+    p += sizeof(int);
+    return( value );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Reads a packed double from the display list and advances \a p.
+ */
+
+static inline double getDouble( const char *&p )
+{
+    double value;
+    memcpy( &value, p, sizeof(double) );
+    p += sizeof(double);
+    return( value );
+}
 
 //------------------------------------------------------------------------------
 /*! \brief Composer default constructor.
@@ -31,8 +186,18 @@ Composer::Composer() :
     m_file(""),
     m_stream(),
     m_xppi(72.0),
-    m_yppi(72.0)
+    m_yppi(72.0),
+    m_page(0),
+    m_pageDict(0),
+    m_strDict(0)
 {
+    m_pageDict = new QDict<ComposerPage>( 101 );
+    checkmem( __FILE__, __LINE__, m_pageDict, "QDict<ComposerPage> m_pageDict", 1 );
+    m_pageDict->setAutoDelete( true );
+    if ( QPixmapCache::cacheLimit() < ComposerPixmapCacheKb )
+    {
+        QPixmapCache::setCacheLimit( ComposerPixmapCacheKb );
+    }
     return;
 }
 
@@ -44,13 +209,74 @@ Composer::~Composer( void )
 {
     if ( m_file.isOpen() )
     {
-        m_file.close();
+        end();
     }
+    delete m_strDict;   m_strDict = 0;
+    delete m_pageDict;  m_pageDict = 0;
     return;
 }
 
+//------------------------------------------------------------------------------
+/*! \brief Adds a brush to the current page's brush table.
+ *
+ *  \return Index of the brush within the table.
+ */
+
+int Composer::addBrush( const QBrush &brush )
+{
+    return( findItem( m_page->m_brush, brush ) );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Adds a font to the current page's font table.
+ *
+ *  \return Index of the font within the table.
+ */
+
+int Composer::addFont( const QFont &font )
+{
+    return( findItem( m_page->m_font, font ) );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Adds a pen to the current page's pen table.
+ *
+ *  \return Index of the pen within the table.
+ */
+
+int Composer::addPen( const QPen &pen )
+{
+    return( findItem( m_page->m_pen, pen ) );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Adds a string to the current page's string table.
+ *  Repeated labels and headers are stored only once.
+ *
+ *  \return Index of the string within the table.
+ */
+
+int Composer::addString( const QString &str )
+{
+    int *id = m_strDict->find( str );
+    if ( id )
+    {
+        return( *id );
+    }
+    QString *copy = new QString( str );
+    checkmem( __FILE__, __LINE__, copy, "QString copy", 1 );
+    int n = appendItem( m_page->m_str, copy );
+    id = new int( n );
+    checkmem( __FILE__, __LINE__, id, "int id", 1 );
+    m_strDict->insert( str, id );
+    return( n );
+}
+
 //------------------------------------------------------------------------------
 /*! \brief Opens a composer file for writing.
+ *
+ *  A new resident display list is started for the page, replacing any
+ *  previous display list recorded under the same file name.
  *
  *  \param fileName Full path name to the output composer file.
  *
@@ -73,13 +299,25 @@ bool Composer::begin( const QString &fileName )
         return( false );
     }
 
-    // Set the text stream device to this file and clear total pages.
+    // Set the data stream device to this file.
     m_stream.setDevice( &m_file );
+
+    // Start a new resident display list for this page.
+    m_page = new ComposerPage();
+    checkmem( __FILE__, __LINE__, m_page, "ComposerPage m_page", 1 );
+    m_pageDict->replace( fileName, m_page );
+    delete m_strDict;
+    m_strDict = new QDict<int>( 257 );
+    checkmem( __FILE__, __LINE__, m_strDict, "QDict<int> m_strDict", 1 );
+    m_strDict->setAutoDelete( true );
     return( true );
 }
 
 //------------------------------------------------------------------------------
-/*! \brief Closes a composer file when finished writing.
+/*! \brief Finishes recording the page display list and writes it to the
+ *  composer file.
+ *
+ *  The display list remains resident for use by paint().
  *
  *  \retval TRUE if the file was open and then closed.
  *  \retval FALSE if the file was already closed.
@@ -87,12 +325,54 @@ bool Composer::begin( const QString &fileName )
 
 bool Composer::end( void )
 {
-    if ( m_file.isOpen() )
+    if ( ! m_file.isOpen() )
+    {
+        return( false );
+    }
+    if ( m_page && m_file.isWritable() )
     {
-        m_file.close();
-        return( true );
+        // Trim the display list to its final size.
+        m_page->m_ops.resize( m_page->m_opsLen );
+
+        // Write the tables and the display list.
+        uint i;
+        m_stream << ComposerMagic << (Q_INT32) ComposerVersion;
+        m_stream << (Q_INT32) m_page->m_str.count();
+        for ( i = 0; i < m_page->m_str.count(); i++ )
+        {
+            m_stream << *m_page->m_str.at( i );
+        }
+        m_stream << (Q_INT32) m_page->m_font.count();
+        for ( i = 0; i < m_page->m_font.count(); i++ )
+        {
+            m_stream << *m_page->m_font.at( i );
+        }
+        m_stream << (Q_INT32) m_page->m_pen.count();
+        for ( i = 0; i < m_page->m_pen.count(); i++ )
+        {
+            m_stream << *m_page->m_pen.at( i );
+        }
+        m_stream << (Q_INT32) m_page->m_brush.count();
+        for ( i = 0; i < m_page->m_brush.count(); i++ )
+        {
+            m_stream << *m_page->m_brush.at( i );
+        }
+        m_stream << (Q_INT32) m_page->m_pixmap.count();
+        for ( i = 0; i < m_page->m_pixmap.count(); i++ )
+        {
+            m_stream << *m_page->m_pixmap.at( i );
+        }
+        m_stream << (Q_INT32) m_page->m_graph.count();
+        for ( i = 0; i < m_page->m_graph.count(); i++ )
+        {
+            m_stream << *m_page->m_graph.at( i );
+        }
+        m_stream << m_page->m_ops;
     }
-    return( false );
+    m_page = 0;
+    delete m_strDict;   m_strDict = 0;
+    m_file.close();
+    return( true );
 }
 
 //------------------------------------------------------------------------------
@@ -123,7 +403,8 @@ void Composer::makeFileName( int docId, int pageNo, QString &composerFile )
 
 void Composer::brush( const QBrush &brush )
 {
-    m_stream << QString("brush") << brush;
+    putOp( OpBrush );
+    putInt( addBrush( brush ) );
 }
 
 //------------------------------------------------------------------------------
@@ -135,7 +416,8 @@ void Composer::brush( const QBrush &brush )
 
 void Composer::ellipse( double x, double y, double w, double h )
 {
-    m_stream << QString("ellipse") << x << y << w << h;
+    putOp( OpEllipse );
+    putDouble( x ); putDouble( y ); putDouble( w ); putDouble( h );
 }
 
 //------------------------------------------------------------------------------
@@ -154,7 +436,9 @@ void Composer::ellipse( double x, double y, double w, double h )
 void Composer::fill( double x, double y, double w, double h,
     const QBrush &brush  )
 {
-    m_stream << QString("fill") << x <<  y << w << h << brush;
+    putOp( OpFill );
+    putDouble( x ); putDouble( y ); putDouble( w ); putDouble( h );
+    putInt( addBrush( brush ) );
 }
 
 //------------------------------------------------------------------------------
@@ -165,7 +449,8 @@ void Composer::fill( double x, double y, double w, double h,
 
 void Composer::font( const QFont &font )
 {
-    m_stream << QString("font") << font;
+    putOp( OpFont );
+    putInt( addFont( font ) );
 }
 
 //------------------------------------------------------------------------------
@@ -179,7 +464,13 @@ void Composer::font( const QFont &font )
 void Composer::graph( const Graph &graph, double x, double y, double w,
     double h )
 {
-    m_stream << QString("graph") << x << y << w << h << graph;
+    QByteArray *bytes = new QByteArray();
+    checkmem( __FILE__, __LINE__, bytes, "QByteArray bytes", 1 );
+    QDataStream stream( *bytes, IO_WriteOnly );
+    stream << graph;
+    putOp( OpGraph );
+    putDouble( x ); putDouble( y ); putDouble( w ); putDouble( h );
+    putInt( appendItem( m_page->m_graph, bytes ) );
 }
 
 //------------------------------------------------------------------------------
@@ -192,7 +483,8 @@ void Composer::graph( const Graph &graph, double x, double y, double w,
 
 void Composer::line( double x0, double y0, double x1, double y1 )
 {
-    m_stream << QString("line") << x0 << y0 << x1 << y1;
+    putOp( OpLine );
+    putDouble( x0 ); putDouble( y0 ); putDouble( x1 ); putDouble( y1 );
 }
 
 //------------------------------------------------------------------------------
@@ -203,7 +495,8 @@ void Composer::line( double x0, double y0, double x1, double y1 )
 
 void Composer::pen ( const QPen &pen )
 {
-    m_stream << QString("pen") << pen;
+    putOp( OpPen );
+    putInt( addPen( pen ) );
 }
 
 //------------------------------------------------------------------------------
@@ -223,7 +516,9 @@ void Composer::pen ( const QPen &pen )
 
 void Composer::pie( double x, double y, double w, double h, int a, int l )
 {
-    m_stream << QString("pie") << x << y << w << h << a << l;
+    putOp( OpPie );
+    putDouble( x ); putDouble( y ); putDouble( w ); putDouble( h );
+    putInt( a ); putInt( l );
 }
 
 //------------------------------------------------------------------------------
@@ -237,7 +532,11 @@ void Composer::pie( double x, double y, double w, double h, int a, int l )
 void Composer::pixmap( const QPixmap &pixmap, double x, double y, double w,
     double h )
 {
-    m_stream << QString("pixmap") << pixmap << x << y << w << h;
+    QPixmap *copy = new QPixmap( pixmap );
+    checkmem( __FILE__, __LINE__, copy, "QPixmap copy", 1 );
+    putOp( OpPixmap );
+    putInt( appendItem( m_page->m_pixmap, copy ) );
+    putDouble( x ); putDouble( y ); putDouble( w ); putDouble( h );
 }
 
 //------------------------------------------------------------------------------
@@ -249,7 +548,8 @@ void Composer::pixmap( const QPixmap &pixmap, double x, double y, double w,
 
 void Composer::printerOn ( bool on )
 {
-    m_stream << QString("printerOn") << ( on ? 1 : 0 );
+    putOp( OpPrinterOn );
+    putInt( on ? 1 : 0 );
 }
 
 //------------------------------------------------------------------------------
@@ -267,11 +567,14 @@ void Composer::rect( double x, double y, double w, double h, double r )
 {
     if ( r < 0.01 )
     {
-        m_stream << QString("rect") << x << y << w << h;
+        putOp( OpRect );
+        putDouble( x ); putDouble( y ); putDouble( w ); putDouble( h );
     }
     else
     {
-        m_stream << QString("roundrect") << x << y << w << h << r;
+        putOp( OpRoundRect );
+        putDouble( x ); putDouble( y ); putDouble( w ); putDouble( h );
+        putDouble( r );
     }
 }
 
@@ -282,7 +585,7 @@ void Composer::rect( double x, double y, double w, double h, double r )
 
 void Composer::restore( void )
 {
-    m_stream << QString("restore");
+    putOp( OpRestore );
 }
 
 //------------------------------------------------------------------------------
@@ -293,7 +596,8 @@ void Composer::restore( void )
 
 void Composer::rotate( double d )
 {
-    m_stream << QString("rotate") << d;
+    putOp( OpRotate );
+    putDouble( d );
 }
 
 //------------------------------------------------------------------------------
@@ -308,7 +612,10 @@ void Composer::rotate( double d )
 void Composer::rotateEllipse( double rx, double ry, double x, double y,
     double w, double h, double d )
 {
-    m_stream << QString("rotateEllipse") << rx << ry << x << y << w << h << d;
+    putOp( OpRotateEllipse );
+    putDouble( rx ); putDouble( ry );
+    putDouble( x ); putDouble( y ); putDouble( w ); putDouble( h );
+    putDouble( d );
 }
 
 //------------------------------------------------------------------------------
@@ -323,7 +630,10 @@ void Composer::rotateEllipse( double rx, double ry, double x, double y,
 void Composer::rotateLine( double rx, double ry, double x1, double y1,
     double x2, double y2, double d )
 {
-    m_stream << QString("rotateLine") << rx << ry << x1 << y1 << x2 << y2 << d;
+    putOp( OpRotateLine );
+    putDouble( rx ); putDouble( ry );
+    putDouble( x1 ); putDouble( y1 ); putDouble( x2 ); putDouble( y2 );
+    putDouble( d );
 }
 
 //------------------------------------------------------------------------------
@@ -340,7 +650,10 @@ void Composer::rotateLine( double rx, double ry, double x1, double y1,
 void Composer::rotateText( double x, double y, double w, double h, double d,
     const QString &text )
 {
-    m_stream << QString("rotateText") << x << y << w << h << d << text;
+    putOp( OpRotateText );
+    putDouble( x ); putDouble( y ); putDouble( w ); putDouble( h );
+    putDouble( d );
+    putInt( addString( text ) );
 }
 
 //------------------------------------------------------------------------------
@@ -350,7 +663,7 @@ void Composer::rotateText( double x, double y, double w, double h, double d,
 
 void Composer::save( void )
 {
-    m_stream << QString("save");
+    putOp( OpSave );
 }
 
 //------------------------------------------------------------------------------
@@ -362,7 +675,8 @@ void Composer::save( void )
 
 void Composer::screenOn ( bool on )
 {
-    m_stream << QString("screenOn") << ( on ? 1 : 0 );
+    putOp( OpScreenOn );
+    putInt( on ? 1 : 0 );
 }
 
 //------------------------------------------------------------------------------
@@ -378,7 +692,10 @@ void Composer::screenOn ( bool on )
 void Composer::text( double x, double y, double w, double h, int f,
     const QString &text )
 {
-    m_stream << QString("atxt") << x << y << w << h << f << text;
+    putOp( OpAtxt );
+    putDouble( x ); putDouble( y ); putDouble( w ); putDouble( h );
+    putInt( f );
+    putInt( addString( text ) );
 }
 
 //------------------------------------------------------------------------------
@@ -393,7 +710,9 @@ void Composer::text( double x, double y, double w, double h, int f,
 
 void Composer::text( double x, double y, const QString &text )
 {
-    m_stream << QString("text") << x << y << text;
+    putOp( OpText );
+    putDouble( x ); putDouble( y );
+    putInt( addString( text ) );
 }
 
 //------------------------------------------------------------------------------
@@ -404,7 +723,8 @@ void Composer::text( double x, double y, const QString &text )
 
 void Composer::translate( double x, double y )
 {
-    m_stream << QString("translate") << x << y;
+    putOp( OpTranslate );
+    putDouble( x ); putDouble( y );
 }
 
 //------------------------------------------------------------------------------
@@ -420,21 +740,113 @@ void Composer::translate( double x, double y )
 void Composer::wraptext( double x, double y, double w, double h,
         const QString &text )
 {
-    m_stream << QString( "wraptext" ) << x << y << w << h << text;
+    putOp( OpWrapText );
+    putDouble( x ); putDouble( y ); putDouble( w ); putDouble( h );
+    putInt( addString( text ) );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Reads a composer file written by end() into a new resident page.
+ *
+ *  Only needed for pages that are no longer resident (e.g., composed by
+ *  another Composer instance).
+ *
+ *  \param fileName Full path name of the composer file.
+ *
+ *  \return Pointer to the resident page, or NULL if the file could not be
+ *  opened or is not a composer file of the current version.
+ */
+
+ComposerPage *Composer::load( const QString &fileName )
+{
+    QFile file( fileName );
+    if ( ! file.open( IO_ReadOnly ) )
+    {
+        return( 0 );
+    }
+    QDataStream stream( &file );
+    QString magic;
+    Q_INT32 version, n;
+    stream >> magic >> version;
+    if ( magic != ComposerMagic || version != ComposerVersion )
+    {
+        file.close();
+        return( 0 );
+    }
+    ComposerPage *page = new ComposerPage();
+    checkmem( __FILE__, __LINE__, page, "ComposerPage page", 1 );
+    int i;
+    stream >> n;
+    for ( i = 0; i < n; i++ )
+    {
+        QString *item = new QString();
+        checkmem( __FILE__, __LINE__, item, "QString item", 1 );
+        stream >> *item;
+        appendItem( page->m_str, item );
+    }
+    stream >> n;
+    for ( i = 0; i < n; i++ )
+    {
+        QFont *item = new QFont();
+        checkmem( __FILE__, __LINE__, item, "QFont item", 1 );
+        stream >> *item;
+        appendItem( page->m_font, item );
+    }
+    stream >> n;
+    for ( i = 0; i < n; i++ )
+    {
+        QPen *item = new QPen();
+        checkmem( __FILE__, __LINE__, item, "QPen item", 1 );
+        stream >> *item;
+        appendItem( page->m_pen, item );
+    }
+    stream >> n;
+    for ( i = 0; i < n; i++ )
+    {
+        QBrush *item = new QBrush();
+        checkmem( __FILE__, __LINE__, item, "QBrush item", 1 );
+        stream >> *item;
+        appendItem( page->m_brush, item );
+    }
+    stream >> n;
+    for ( i = 0; i < n; i++ )
+    {
+        QPixmap *item = new QPixmap();
+        checkmem( __FILE__, __LINE__, item, "QPixmap item", 1 );
+        stream >> *item;
+        appendItem( page->m_pixmap, item );
+    }
+    stream >> n;
+    for ( i = 0; i < n; i++ )
+    {
+        QByteArray *item = new QByteArray();
+        checkmem( __FILE__, __LINE__, item, "QByteArray item", 1 );
+        stream >> *item;
+        appendItem( page->m_graph, item );
+    }
+    stream >> page->m_ops;
+    page->m_opsLen = page->m_ops.size();
+    file.close();
+    m_pageDict->replace( fileName, page );
+    return( page );
 }
 
 //------------------------------------------------------------------------------
 /*! \brief Executes the composer commands from \a fileName onto the
  *  \a devicePtr QPaintDevice using the specified resolution and scale.
  *
+ *  The page's resident display list is executed directly.  If the device
+ *  is a QPixmap and the page has already been painted at this resolution
+ *  and font scale, the cached pixmap is simply copied to the device.
+ *
  *  \param fileName Full path name of the composer file.
  *  \param devicePtr Pointer to the QPaintDevice to be drawn on.
  *  \param xppi, yppi Device pixels-per-inch resolution.
  *  \param fontScale Font scaling factor.
  *  \param toPrinter TRUE if output is to printer
  *
- *  \retval TRUE if able to open the composer file and execute the commands.
- *  \retval FALSE if unable to open the composer file.
+ *  \retval TRUE if able to find the page and execute the commands.
+ *  \retval FALSE if unable to find or load the page.
  */
 
 bool Composer::paint( const QString  &fileName, QPaintDevice *devicePtr,
@@ -445,13 +857,31 @@ bool Composer::paint( const QString  &fileName, QPaintDevice *devicePtr,
     {
         end();
     }
-    // Open the composition file in read mode.
-    m_file.setName( fileName );
-    if ( ! m_file.open( IO_ReadOnly ) )
+    // Find the resident page, or load it from its composer file.
+    ComposerPage *page = m_pageDict->find( fileName );
+    if ( ! page && ! ( page = load( fileName ) ) )
     {
         return( false );
     }
-    m_stream.setDevice( & m_file );
+
+    // Screen pixmaps are cached by page, resolution, and font scale.
+    bool useCache = ( ! toPrinter
+        && devicePtr->devType() == QInternal::Pixmap );
+    QString key("");
+    if ( useCache )
+    {
+        key.sprintf( "Composer:%d:%g:%g:%g",
+            page->m_serial, xppi, yppi, fontScale );
+        QPixmap *pixmapPtr = (QPixmap *) devicePtr;
+        QPixmap cached;
+        if ( QPixmapCache::find( key, cached )
+          && cached.width() == pixmapPtr->width()
+          && cached.height() == pixmapPtr->height() )
+        {
+            *pixmapPtr = cached;
+            return( true );
+        }
+    }
 
     // Create a local painter.
     QPainter painter;
@@ -467,103 +897,119 @@ bool Composer::paint( const QString  &fileName, QPaintDevice *devicePtr,
     bool toScreen = ! toPrinter;
 
     // Local input variables.
-    QString cmd;
     double  x, y, w, h, x1, y1, r, rx, ry, deg;
-    int     align, angle, angleLength;
-    QBrush  brush;
-    QFont   font;
-    QPen    pen;
-    QString text;
-
-    // Read each command line from the composition file.
-    while ( ! m_stream.eof() )
-    {
-        // Read the next command.
-        m_stream >> cmd;
+    int     align, angle, angleLength, id;
+    bool    on;
 
-        // Execute the command.
-        if ( cmd == "atxt" )
-        {
-            m_stream >> x >> y >> w >> h >> align >> text;
-            painter.drawText( xPix(x), yPix(y), xPix(w), yPix(h), align, text );
-        }
-        else if ( cmd == "brush" )
+    // Execute each display list command.
+    const char *p = page->m_ops.data();
+    const char *last = p + page->m_opsLen;
+    while ( p < last )
+    {
+        int op = (unsigned char) *p++;
+        on = ( toScreen && screenOn ) || ( toPrinter && printerOn );
+        switch ( op )
         {
-            m_stream >> brush;
-            if ( ( toScreen && screenOn ) || (toPrinter && printerOn ) )
+        case OpAtxt:
+            x = getDouble( p ); y = getDouble( p );
+            w = getDouble( p ); h = getDouble( p );
+            align = getInt( p );
+            id = getInt( p );
+            painter.drawText( xPix(x), yPix(y), xPix(w), yPix(h), align,
+                *page->m_str.at( id ) );
+            break;
+
+        case OpBrush:
+            id = getInt( p );
+            if ( on )
             {
-                painter.setBrush( brush );
+                painter.setBrush( *page->m_brush.at( id ) );
             }
-        }
-        else if ( cmd == "ellipse" )
-        {
-            m_stream >> x >> y >> w >> h;
-            if ( ( toScreen && screenOn ) || (toPrinter && printerOn ) )
+            break;
+
+        case OpEllipse:
+            x = getDouble( p ); y = getDouble( p );
+            w = getDouble( p ); h = getDouble( p );
+            if ( on )
             {
                 painter.drawEllipse( xPix(x), yPix(y), xPix(w), yPix(h) );
             }
-        }
-        else if ( cmd == "fill" )
-        {
-            m_stream >> x >> y >> w >> h >> brush;
-            if ( ( toScreen && screenOn ) || (toPrinter && printerOn ) )
-            {
-                painter.fillRect( xPix(x), yPix(y), xPix(w), yPix(h), brush );
-            }
-        }
-        else if ( cmd == "font" )
-        {
-            m_stream >> font;
-            // The passed xppi and yppi already account for drawing scale,
-            // but all screen fonts must still be rescaled!
-            if ( devicePtr->devType() != QInternal::Printer )
+            break;
+
+        case OpFill:
+            x = getDouble( p ); y = getDouble( p );
+            w = getDouble( p ); h = getDouble( p );
+            id = getInt( p );
+            if ( on )
             {
-                font.setPointSize( (int)
-                    ( 0.1 + fontScale * (double) font.pointSize() ) );
+                painter.fillRect( xPix(x), yPix(y), xPix(w), yPix(h),
+                    *page->m_brush.at( id ) );
             }
-            if ( ( toScreen && screenOn ) || (toPrinter && printerOn ) )
+            break;
+
+        case OpFont:
+            id = getInt( p );
+            if ( on )
             {
+                // The passed xppi and yppi already account for drawing scale,
+                // but all screen fonts must still be rescaled!
+                QFont font( *page->m_font.at( id ) );
+                if ( devicePtr->devType() != QInternal::Printer )
+                {
+                    font.setPointSize( (int)
+                        ( 0.1 + fontScale * (double) font.pointSize() ) );
+                }
                 painter.setFont( font );
             }
-        }
-        else if ( cmd == "graph" )
-        {
-            if ( ( toScreen && screenOn ) || (toPrinter && printerOn ) )
+            break;
+
+        case OpGraph:
+            x = getDouble( p ); y = getDouble( p );
+            w = getDouble( p ); h = getDouble( p );
+            id = getInt( p );
+            if ( on )
             {
-                paintGraph( &painter, fontScale );
+                paintGraph( &painter, fontScale, x, y, w, h,
+                    *page->m_graph.at( id ) );
             }
-        }
-        else if ( cmd == "line" )
-        {
-            m_stream >> x >> y >> x1 >> y1;
-            if ( ( toScreen && screenOn ) || (toPrinter && printerOn ) )
+            break;
+
+        case OpLine:
+            x = getDouble( p ); y = getDouble( p );
+            x1 = getDouble( p ); y1 = getDouble( p );
+            if ( on )
             {
                 painter.drawLine( xPix(x), yPix(y), xPix(x1), yPix(y1) );
             }
-        }
-        else if ( cmd == "pen" )
-        {
-            m_stream >> pen;
-            if ( ( toScreen && screenOn ) || (toPrinter && printerOn ) )
+            break;
+
+        case OpPen:
+            id = getInt( p );
+            if ( on )
             {
-                painter.setPen( pen );
+                painter.setPen( *page->m_pen.at( id ) );
             }
-        }
-        else if ( cmd == "pie" )
-        {
-            m_stream >> x >> y >> w >> h >> angle >> angleLength;
-            if ( ( toScreen && screenOn ) || (toPrinter && printerOn ) )
+            break;
+
+        case OpPie:
+            x = getDouble( p ); y = getDouble( p );
+            w = getDouble( p ); h = getDouble( p );
+            angle = getInt( p );
+            angleLength = getInt( p );
+            if ( on )
             {
                 painter.drawPie( xPix(x), yPix(y), xPix(w), yPix(h),
                 angle, angleLength );
             }
-        }
-        else if ( cmd == "pixmap" )
-        {
-            QPixmap pixmap;
-            m_stream >> pixmap >> x >> y >> w >> h;
-            if ( ( toScreen && screenOn ) || (toPrinter && printerOn ) )
+            break;
+
+        case OpPixmap:
+            id = getInt( p );
+            x = getDouble( p ); y = getDouble( p );
+            w = getDouble( p ); h = getDouble( p );
+            if ( on )
             {
+                const QPixmap &pixmap = *page->m_pixmap.at( id );
                 double xscale = w * xppi / pixmap.width();
                 double yscale = h * yppi / pixmap.height();
                 QWMatrix matrix = painter.worldMatrix();
@@ -572,23 +1018,26 @@ bool Composer::paint( const QString  &fileName, QPaintDevice *devicePtr,
                     pixmap );
                 painter.setWorldMatrix( matrix );
             }
-        }
-        else if ( cmd == "printerOn" )
-        {
-            m_stream >> printerOn;
-        }
-        else if ( cmd == "rect" )
-        {
-            m_stream >> x >> y >> w >> h;
-            if ( ( toScreen && screenOn ) || (toPrinter && printerOn ) )
+            break;
+
+        case OpPrinterOn:
+            printerOn = getInt( p );
+            break;
+
+        case OpRect:
+            x = getDouble( p ); y = getDouble( p );
+            w = getDouble( p ); h = getDouble( p );
+            if ( on )
             {
                 painter.drawRect( xPix(x), yPix(y), xPix(w), yPix(h) );
             }
-        }
-        else if ( cmd == "roundrect" )
-        {
-            m_stream >> x >> y >> w >> h >> r;
-            if ( ( toScreen && screenOn ) || (toPrinter && printerOn ) )
+            break;
+
+        case OpRoundRect:
+            x = getDouble( p ); y = getDouble( p );
+            w = getDouble( p ); h = getDouble( p );
+            r = getDouble( p );
+            if ( on )
             {
                 int x1 = xPix(x);
                 int y1 = yPix(y);
@@ -606,23 +1055,26 @@ bool Composer::paint( const QString  &fileName, QPaintDevice *devicePtr,
                 painter.drawArc( x1, y2-2*ry, 2*rx, 2*ry, 16*180, len ); // ll
                 painter.drawArc( x2-2*rx, y2-2*ry, 2*rx, 2*ry, 16*270, len );
             }
-        }
-        else if ( cmd == "restore" )
-        {
+            break;
+
+        case OpRestore:
             painter.restore();
-        }
-        else if ( cmd == "rotate" )
-        {
-            m_stream >> deg;
-            if ( ( toScreen && screenOn ) || (toPrinter && printerOn ) )
+            break;
+
+        case OpRotate:
+            deg = getDouble( p );
+            if ( on )
             {
                 painter.rotate( deg );
             }
-        }
-        else if ( cmd == "rotateEllipse" )
-        {
-            m_stream >> rx >> ry >> x >> y >> w >> h >> deg;
-            if ( ( toScreen && screenOn ) || (toPrinter && printerOn ) )
+            break;
+
+        case OpRotateEllipse:
+            rx = getDouble( p ); ry = getDouble( p );
+            x = getDouble( p ); y = getDouble( p );
+            w = getDouble( p ); h = getDouble( p );
+            deg = getDouble( p );
+            if ( on )
             {
                 painter.save();
                 painter.translate( xPix(rx), yPix(ry) );
@@ -631,11 +1083,14 @@ bool Composer::paint( const QString  &fileName, QPaintDevice *devicePtr,
                     xPix(w), xPix(h) );
                 painter.restore();
             }
-        }
-        else if ( cmd == "rotateLine" )
-        {
-            m_stream >> rx >> ry >> x >> y >> x1 >> y1 >> deg;
-            if ( ( toScreen && screenOn ) || (toPrinter && printerOn ) )
+            break;
+
+        case OpRotateLine:
+            rx = getDouble( p ); ry = getDouble( p );
+            x = getDouble( p ); y = getDouble( p );
+            x1 = getDouble( p ); y1 = getDouble( p );
+            deg = getDouble( p );
+            if ( on )
             {
                 painter.save();
                 painter.translate( xPix(rx), yPix(ry) );
@@ -644,65 +1099,76 @@ bool Composer::paint( const QString  &fileName, QPaintDevice *devicePtr,
                     xPix(x1-rx), xPix(y1-ry) );
                 painter.restore();
             }
-        }
-        else if ( cmd == "rotateText" )
-        {
-            m_stream >> x >> y >> w >> h >> deg >> text;
-            if ( ( toScreen && screenOn ) || (toPrinter && printerOn ) )
+            break;
+
+        case OpRotateText:
+            x = getDouble( p ); y = getDouble( p );
+            w = getDouble( p ); h = getDouble( p );
+            deg = getDouble( p );
+            id = getInt( p );
+            if ( on )
             {
                 painter.save();
                 painter.translate( xPix(x), yPix(y) );
                 painter.rotate( deg );
                 painter.drawText( 0, 0, xPix(w), xPix(h),
-                    Qt::AlignHCenter|Qt::AlignVCenter, text );
+                    Qt::AlignHCenter|Qt::AlignVCenter, *page->m_str.at( id ) );
                 painter.restore();
             }
-        }
-        else if ( cmd == "save" )
-        {
+            break;
+
+        case OpSave:
             painter.save();
-        }
-        else if ( cmd == "screenOn" )
-        {
-            m_stream >> screenOn;
-        }
-        else if ( cmd == "text" )
-        {
-            m_stream >> x >> y >> text;
-            if ( ( toScreen && screenOn ) || (toPrinter && printerOn ) )
+            break;
+
+        case OpScreenOn:
+            screenOn = getInt( p );
+            break;
+
+        case OpText:
+            x = getDouble( p ); y = getDouble( p );
+            id = getInt( p );
+            if ( on )
             {
-                painter.drawText( xPix(x), yPix(y), text );
+                painter.drawText( xPix(x), yPix(y), *page->m_str.at( id ) );
             }
-        }
-        else if ( cmd == "translate" )
-        {
-            m_stream >> x >> y;
-            if ( ( toScreen && screenOn ) || (toPrinter && printerOn ) )
+            break;
+
+        case OpTranslate:
+            x = getDouble( p ); y = getDouble( p );
+            if ( on )
             {
                 painter.translate( xPix(x), yPix(y) );
             }
-        }
-        else if ( cmd == "wraptext" )
-        {
-            m_stream >> x >> y >> w >> h >> text;
-            if ( ( toScreen && screenOn ) || (toPrinter && printerOn ) )
+            break;
+
+        case OpWrapText:
+            x = getDouble( p ); y = getDouble( p );
+            w = getDouble( p ); h = getDouble( p );
+            id = getInt( p );
+            if ( on )
             {
                 painter.drawText( xPix(x), yPix(y), xPix(w), yPix(h),
-                    Qt::WordBreak, text );
+                    Qt::WordBreak, *page->m_str.at( id ) );
             }
-        }
-        // Simply skip unknown commands for now.
-        else
-        {
+            break;
+
+        // The remainder of a corrupt display list cannot be decoded.
+        default:
             qDebug( QString(
-                "Composer::paint() - unknown command %1 from %2." )
-                .arg( cmd ).arg( fileName ) );
+                "Composer::paint() - unknown opcode %1 from %2." )
+                .arg( op ).arg( fileName ) );
+            p = last;
+            break;
         }
     }
 
     // Clean up and return.
-    m_file.close();
     painter.end();
+    if ( useCache )
+    {
+        QPixmapCache::insert( key, *((QPixmap *) devicePtr) );
+    }
     return( true );
 }
 
@@ -711,16 +1177,21 @@ bool Composer::paint( const QString  &fileName, QPaintDevice *devicePtr,
  *
  *  \param painterPtr Pointer to the QPainter in use.
  *  \param fontScale Font scale factor passed to paint().
+ *  \param marginLeft, marginTop Graph's upper left corner on the page (in).
+ *  \param bodyWd, bodyHt Graph body width and height (in).
+ *  \param bytes The serialized Graph.
  *
  *  This function is only called by paint().
  */
 
-void Composer::paintGraph( QPainter *painterPtr, double fontScale )
+void Composer::paintGraph( QPainter *painterPtr, double fontScale,
+    double marginLeft, double marginTop, double bodyWd, double bodyHt,
+    const QByteArray &bytes )
 {
-    // Read the rest of the Graph parameters from the composer file.
+    // Read the Graph parameters from the page's graph table.
     Graph graph;
-    double marginLeft, marginTop, bodyWd, bodyHt;
-    m_stream >> marginLeft >> marginTop >> bodyWd >> bodyHt >> graph;
+    QDataStream stream( bytes, IO_ReadOnly );
+    stream >> graph;
 
     // Set graph area on page.
     int x0 = (int) (marginLeft * m_xppi );
@@ -747,6 +1218,71 @@ void Composer::paintGraph( QPainter *painterPtr, double fontScale )
     return;
 }
 
+//------------------------------------------------------------------------------
+/*! \brief Appends \a bytes of \a data to the current page's display list,
+ *  doubling the display list buffer as needed.
+ */
+
+void Composer::put( const void *data, int bytes )
+{
+    uint need = m_page->m_opsLen + bytes;
+    if ( need > m_page->m_ops.size() )
+    {
+        uint size = ( m_page->m_ops.size() < 4096 )
+                  ? 4096 : 2 * m_page->m_ops.size();
+        m_page->m_ops.resize( ( size > need ) ? size : need );
+    }
+    memcpy( m_page->m_ops.data() + m_page->m_opsLen, data, bytes );
+    m_page->m_opsLen = need;
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Appends a packed double argument to the display list.
+ */
+
+void Composer::putDouble( double value )
+{
+    put( &value, sizeof(double) );
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Appends a packed int argument to the display list.
+ */
+
+void Composer::putInt( int value )
+{
+    put( &value, sizeof(int) );
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Appends a one byte ComposerOp to the display list.
+ */
+
+void Composer::putOp( int op )
+{
+    unsigned char byte = (unsigned char) op;
+    put( &byte, 1 );
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Releases the resident display list for \a fileName.
+ *
+ *  Called by Document::removeComposerFiles() when the page file is removed.
+ *  Its cached pixmaps simply age out of the QPixmapCache.
+ *
+ *  \param fileName Full path name of the composer file.
+ */
+
+void Composer::remove( const QString &fileName )
+{
+    m_pageDict->remove( fileName );
+    return;
+}
+
 //------------------------------------------------------------------------------
 /*! \brief Determines the x-pixel corresponding to the passed inches.
  *
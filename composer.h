@@ -14,9 +14,11 @@
 
 // Forward class references
 class Graph;
+struct ComposerPage;
 
 // Qt class references
 #include <qdatastream.h>
+#include <qdict.h>
 #include <qfile.h>
 class QBrush;
 class QColorGroup;
@@ -70,6 +72,17 @@ class QString;
  *  method with the name of the composer file to be executed and a pointer
  *  to the QPaintDevice, which can be a QPicture, QPixmap, QPrinter, or
  *  QWidget (e.g., screen).
+ *
+ *  Each page is recorded as a binary display list of one byte opcodes
+ *  followed by their packed arguments.  Text, fonts, pens, brushes,
+ *  pixmaps, and graphs are stored once in per-page tables and referenced
+ *  by index.  The display list stays resident in memory after end(), so
+ *  paint() does no file I/O and no command string parsing.  The composer
+ *  file is still written by end() so that a page that is no longer
+ *  resident can be reloaded.  Pages painted onto a QPixmap (i.e., the
+ *  screen) are also kept in the QPixmapCache keyed by the page's
+ *  composition, the device resolution, and the font scale, so scrolling
+ *  back to a page at the same zoom is just a pixmap copy.
  */
 
 class Composer
@@ -83,6 +96,7 @@ public:
     bool begin( const QString &fileName ) ;
     bool end( void ) ;
     void makeFileName( int docId, int pageNo, QString &composerFile ) ;
+    void remove( const QString &fileName ) ;
 
     // Functions that record Composer commands.
     void brush( const QBrush &brush ) ;
@@ -124,7 +138,17 @@ public:
 
 // Private methods
 private:
-    void paintGraph( QPainter *p, double fontScale ) ;
+    int  addBrush( const QBrush &brush ) ;
+    int  addFont( const QFont &font ) ;
+    int  addPen( const QPen &pen ) ;
+    int  addString( const QString &str ) ;
+    ComposerPage *load( const QString &fileName ) ;
+    void paintGraph( QPainter *p, double fontScale, double x, double y,
+            double w, double h, const QByteArray &graph ) ;
+    void put( const void *data, int bytes ) ;
+    void putDouble( double value ) ;
+    void putInt( int value ) ;
+    void putOp( int op ) ;
     int  xPix( double inches ) const ;
     int  yPix( double inches ) const ;
 
@@ -134,6 +158,9 @@ public:
     QDataStream m_stream;   //!< Composer file input-output data stream
     double      m_xppi;     //!< Current paint() x pixels per inch
     double      m_yppi;     //!< Current paint() y pixels per inch
+    ComposerPage *m_page;   //!< Page currently being recorded
+    QDict<ComposerPage> *m_pageDict;    //!< Resident pages by file name
+    QDict<int> *m_strDict;  //!< String table lookup while recording
 };
 
 #endif
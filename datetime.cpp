@@ -12,6 +12,7 @@
 // Custom include files
 #include "cdtlib.h"
 #include "datetime.h"
+#include "ephemeris.h"
 #include "globalposition.h"
 
 // Standard include files
@@ -363,7 +364,25 @@ bool DateTime::calculateSunTime( int event, const GlobalPosition &gp )
     double hours = 0.0;
     int flag = CDT_RiseSet( (int) event, m_jdate, gp.longitude(),
         gp.latitude(), gp.gmtDiff(), &hours );
+    return( storeSunTime( event, flag, hours ) );
+}
 
+//------------------------------------------------------------------------------
+/*! \brief Stores a rise or set time for the current DateTime #m_year,
+ *  #m_month, and #m_day values.
+ *
+ *  Called by calculateSunTime() and riseSet().
+ *
+ *  \param event One of the #CDT_Event rise or set enumeration values.
+ *  \param flag  The #CDT_Flag of the event.
+ *  \param hours Local decimal hours of the event.
+ *
+ *  \return TRUE if the resulting DateTime is valid,
+ *  FALSE if the resulting DateTime is invalid.
+ */
+
+bool DateTime::storeSunTime( int event, int flag, double hours )
+{
     // Add the event time to the Julian date
     m_jdate += ( hours / 24. );
 
@@ -1299,6 +1318,36 @@ bool DateTime::nauticalDusk( const GlobalPosition &gp )
     return( calculateSunTime( CDT_NauticalDusk, gp ) );
 }
 
+//------------------------------------------------------------------------------
+/*! \brief Determines the time of a sun or moon rise, set, or twilight event
+ *  for the current DateTime #m_year, #m_month, and #m_day from a precomputed
+ *  Ephemeris.
+ *
+ *  Same as calling sunRise(), sunSet(), moonRise(), moonSet(), or one of the
+ *  dawn or dusk methods with the Ephemeris GlobalPosition, but without
+ *  searching for the event.  If the DateTime is not in the Ephemeris year,
+ *  the event is calculated by calculateSunTime().
+ *
+ *  \param event One of the #CDT_Event enumeration values #CDT_SunRise
+ *  through #CDT_AstronomicalDusk.
+ *  \param ephemeris Reference to an Ephemeris for the location.
+ *
+ *  \return TRUE if the resulting DateTime is valid,
+ *  FALSE if the resulting DateTime is invalid.
+ *  The invalid data member can be determined from the flag() return code.
+ */
+
+bool DateTime::riseSet( int event, const Ephemeris &ephemeris )
+{
+    if ( m_year != ephemeris.year() )
+    {
+        return( calculateSunTime( event, ephemeris.position() ) );
+    }
+    double hours = 0.0;
+    int flag = ephemeris.riseSet( event, dayOfYear(), &hours );
+    return( storeSunTime( event, flag, hours ) );
+}
+
 //------------------------------------------------------------------------------
 /*! \brief Determines the date and time of the \a year's \a period new moon at
  *  the GlobalPosition and stores the result in the DateTime.
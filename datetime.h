@@ -16,6 +16,7 @@
 #define _DATETIME_H_ 1
 
 // Forward class references
+class Ephemeris;
 class GlobalPosition;
 #include <stdio.h>
 
@@ -105,6 +106,7 @@ public:
     bool        moonSet( const GlobalPosition &gp ) ;
     bool        nauticalDawn( const GlobalPosition &gp ) ;
     bool        nauticalDusk( const GlobalPosition &gp ) ;
+    bool        riseSet( int event, const Ephemeris &ephemeris ) ;
     bool        sunRise( const GlobalPosition &gp ) ;
     bool        sunSet( const GlobalPosition &gp ) ;
 
@@ -131,6 +133,7 @@ private:
     double      calculateJulianDate( void ) ;
     bool        calculateSolstice( int i, const GlobalPosition &gp ) ;
     bool        calculateSunTime( int event, const GlobalPosition &gp ) ;
+    bool        storeSunTime( int event, int flag, double hours ) ;
 
 //  Protected data members
 protected:
@@ -256,6 +256,44 @@ void Document::composeLogo( double x0, double y0, double wd, double ht,
     return;
 }
 
+//------------------------------------------------------------------------------
+/*! \brief Composes any pages that were recorded but not yet composed,
+ *  through page \a thruPage.
+ *
+ *  This is the default virtual method for the Document abstract class,
+ *  whose pages are always composed as soon as they are started, so it
+ *  does nothing.  Derived classes that defer page composition must
+ *  re-implement it.
+ *
+ *  Called by the navigation, printing, and table of contents methods
+ *  before they access pages beyond #m_pages, and by startNewPage() so
+ *  that deferred pages always precede any newly started page.
+ *
+ *  \param thruPage Last page number that must be composed,
+ *                  or -1 if all pages must be composed.
+ *
+ *  \return Number of pages in the Document.
+ */
+
+int Document::composePending( int /* thruPage */ )
+{
+    return( m_pages );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Determines if any recorded pages have not yet been composed.
+ *
+ *  This is the default virtual method for the Document abstract class,
+ *  which never defers pages.
+ *
+ *  \return TRUE if composePending() has pages beyond #m_pages to compose.
+ */
+
+bool Document::pagesPending( void ) const
+{
+    return( false );
+}
+
 //------------------------------------------------------------------------------
 /*! \brief Composes the page background and decoration.
  *
@@ -488,6 +526,8 @@ void Document::contentsMenuActivated( int pageNumber )
 
 void Document::contentsMenuRebuild( QPopupMenu *contentsMenu )
 {
+    // The contents must list every page
+    composePending( -1 );
     contentsMenu->clear();
     // If not oo many pages, show them in a standard popup menu
     if ( m_tocList->count() < 20 )
@@ -743,7 +783,7 @@ void Document::pageFirst( void )
 
 void Document::pageLast( void )
 {
-    showPage( m_pages );
+    showPage( composePending( -1 ) );
     return;
 }
 
@@ -759,6 +799,10 @@ void Document::pageLast( void )
 
 void Document::pageNext( void )
 {
+    if ( m_page >= m_pages )
+    {
+        composePending( m_page + 1 );
+    }
     if ( m_page < m_pages )
     {
         showPage( m_page + 1 );
@@ -833,14 +877,20 @@ int Document::pageWdPixels( void ) const
 
 bool Document::print( void )
 {
+    // Deferred pages are composed only through the last page printed,
+    // so their number is not yet known and any page may be requested.
+    bool pending = pagesPending();
+
     // Display the print dialog and return if OK not pressed.
     Printer printer;
     printer.setCreator( "BehavePlus6" );
     printer.setDocName( "BehavePlus6" );
     printer.setColorMode( QPrinter::Color );
-    printer.setPrintRange( QPrinter::PageRange );
+    printer.setPrintRange( ( pending )
+        ? ( QPrinter::AllPages )
+        : ( QPrinter::PageRange ) );
     printer.setFromTo( 1, m_pages );
-    printer.setMinMax( 1, m_pages );
+    printer.setMinMax( 1, ( pending ) ? 9999 : m_pages );
     printer.setNumCopies( 1 );
     printer.setOrientation( QPrinter::Portrait );
     printer.setPageOrder( QPrinter::FirstPageFirst );
@@ -862,9 +912,15 @@ bool Document::print( void )
     // signifies 'print the whole document'."
     int fromPage = printer.fromPage();
     int toPage = printer.toPage();
-    if ( ! fromPage && ! toPage )
+    if ( ( ! fromPage && ! toPage )
+      || printer.printRange() == QPrinter::AllPages )
     {
         fromPage = 1;
+        toPage = composePending( -1 );
+    }
+    // Compose any deferred pages through the last page printed.
+    else if ( composePending( toPage ) < toPage )
+    {
         toPage = m_pages;
     }
     // First page first
@@ -918,7 +974,8 @@ bool Document::print( void )
 
 bool Document::printPS( int fromPage, int thruPage )
 {
-    // Constrain number of pages.
+    // Compose and constrain number of pages.
+    composePending( thruPage );
     if ( thruPage > m_pages )
     {
         thruPage = m_pages;
@@ -986,7 +1043,9 @@ void Document::removeComposerFiles( int fromPageNumber )
           i <= m_pages;
           i++ )
     {
-        QFile::remove( appFileSystem()->composerFilePath( m_docId, i ) );
+        QString composerFile = appFileSystem()->composerFilePath( m_docId, i );
+        m_composer->remove( composerFile );
+        QFile::remove( composerFile );
     }
     return;
 }
@@ -1184,6 +1243,9 @@ void Document::showPage( int pageNumber )
 
 void Document::startNewPage( const QString &tocName, TocType tocType )
 {
+    // Any deferred pages must precede this one
+    composePending( -1 );
+
     // Increment the page counter
     m_pages++;
 
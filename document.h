@@ -98,6 +98,7 @@ public:
     virtual void clear( bool showRunDialog=true ) = 0 ;
     virtual void composeLogo( double x0, double y0, double wd, double ht,
             int penWd ) = 0;
+    virtual int  composePending( int thruPage ) ;
     virtual void configure( void ) = 0;
     virtual void configureAppearance( void ) = 0;
     virtual void configureFuelModels( void ) = 0;
@@ -114,6 +115,7 @@ public:
     virtual bool open( const QString &fileName, const QString &fileType ) = 0;
     void pageFirst( void ) ;
     void pageLast( void ) ;
+    virtual bool pagesPending( void ) const ;
     void pageNext( void ) ;
     void pagePrev( void ) ;
     int  pageHtPixels( void ) const ;
@@ -0,0 +1,289 @@
+//------------------------------------------------------------------------------
+/*! \file ephemeris.cpp
+ *  \version BehavePlus6
+ *  \author Copyright (C) 2002-2018 by Collin D. Bevins.  All rights reserved.
+ *
+ *  \brief Year-long sun and moon ephemeris class methods.
+ */
+
+// Custom include files
+#include "appmessage.h"
+#include "cdtlib.h"
+#include "ephemeris.h"
+
+// Standard include files
+#include <math.h>
+
+// Most recently used ephemerides retained by Ephemeris::find()
+static Ephemeris *EphemerisCache[EphemerisCacheSize] =
+    { 0, 0, 0, 0, 0, 0, 0, 0 };
+
+//------------------------------------------------------------------------------
+/*! \brief Ephemeris constructor.
+ *
+ *  Calculates every sun and moon rise, set, and twilight event for each day
+ *  of the \a year, and the year's new moons.
+ *
+ *  \param gp   Reference to the GlobalPosition of the observer.
+ *  \param year Julian-Gregorian calendar year (-4712 or later).
+ */
+
+Ephemeris::Ephemeris( const GlobalPosition &gp, int year ) :
+    m_gp(),
+    m_year(year),
+    m_days(0),
+    m_flag(0),
+    m_hours(0)
+{
+    m_gp = gp;
+    m_days = CDT_DaysInYear( m_year );
+    m_flag = new int[ m_days * EphemerisEvents ];
+    checkmem( __FILE__, __LINE__, m_flag, "int m_flag",
+        m_days * EphemerisEvents );
+    m_hours = new double[ m_days * EphemerisEvents ];
+    checkmem( __FILE__, __LINE__, m_hours, "double m_hours",
+        m_days * EphemerisEvents );
+    calculate();
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Ephemeris destructor.
+ */
+
+Ephemeris::~Ephemeris( void )
+{
+    delete[] m_flag;    m_flag = 0;
+    delete[] m_hours;   m_hours = 0;
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Calculates every event of every day of the year.
+ *
+ *  The sines of the sun and moon altitudes are sampled at each hour of the
+ *  year from local midnight of January 1 through local midnight of
+ *  December 31, and each day's 25 samples (its midnight to the following
+ *  midnight) are searched for its rise, set, and twilight events exactly
+ *  as CDT_RiseSet() would.
+ *
+ *  Called only by the constructor.
+ */
+
+void Ephemeris::calculate( void )
+{
+    // Sample the sun and moon altitudes once for every hour of the year
+    int samples = 24 * m_days + 1;
+    double *sunSine = new double[ samples ];
+    checkmem( __FILE__, __LINE__, sunSine, "double sunSine", samples );
+    double *moonSine = new double[ samples ];
+    checkmem( __FILE__, __LINE__, moonSine, "double moonSine", samples );
+
+    double lon  = m_gp.longitude();
+    double gmt  = m_gp.gmtDiff();
+    double sphi = sin( 0.0174532925199433 * m_gp.latitude() );
+    double cphi = cos( 0.0174532925199433 * m_gp.latitude() );
+    int mjd0 = (int) ( CDT_JulianDate( m_year, 1, 1, 0, 0, 0, 0 )
+             - 2400000.5 );
+    int day, hour, sample;
+    for ( day = 0;
+          day <= m_days;
+          day++ )
+    {
+        // Same local midnight as CDT_RiseSet() for this day
+        double amjd = (double) ( mjd0 + day ) - gmt / 24.;
+        for ( hour = 0;
+              hour < 24;
+              hour++ )
+        {
+            sample = 24 * day + hour;
+            if ( sample >= samples )
+            {
+                break;
+            }
+            CDT_SunMoonSineAltitude( amjd + (double) hour / 24.0, lon,
+                cphi, sphi, &sunSine[sample], &moonSine[sample] );
+        }
+    }
+
+    // Search each day's samples for each of its events
+    int event, id;
+    for ( day = 0;
+          day < m_days;
+          day++ )
+    {
+        for ( event = CDT_SunRise;
+              event < CDT_SunRise + EphemerisEvents;
+              event++ )
+        {
+            const double *sineAlt =
+                ( event == CDT_MoonRise || event == CDT_MoonSet )
+                ? &moonSine[24*day]
+                : &sunSine[24*day];
+            id = day * EphemerisEvents + event - CDT_SunRise;
+            m_hours[id] = 0.0;
+            m_flag[id] = CDT_RiseSetSearch( event, sineAlt, &m_hours[id] );
+        }
+    }
+    delete[] sunSine;
+    delete[] moonSine;
+
+    // Store the local Julian date of each new moon period
+    for ( int period = 0;
+          period < EphemerisLunations;
+          period++ )
+    {
+        m_newMoon[period] = CDT_NewMoonGMT( m_year, period ) + gmt / 24.;
+    }
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Access to the number of days in the ephemeris year.
+ *
+ *  \return Number of days in the ephemeris year.
+ */
+
+int Ephemeris::days( void ) const
+{
+    return( m_days );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Finds or calculates the Ephemeris for the location and year.
+ *
+ *  The #EphemerisCacheSize most recently used ephemerides are retained,
+ *  so repeated calls for the same location and year are free.
+ *
+ *  \param gp   Reference to the GlobalPosition of the observer.
+ *  \param year Julian-Gregorian calendar year (-4712 or later).
+ *
+ *  \return Pointer to the Ephemeris, which is owned by the cache and must
+ *  not be deleted by the caller.
+ */
+
+Ephemeris *Ephemeris::find( const GlobalPosition &gp, int year )
+{
+    // Move a cached ephemeris to the front
+    int id;
+    Ephemeris *eph = 0;
+    for ( id = 0;
+          id < EphemerisCacheSize;
+          id++ )
+    {
+        if ( EphemerisCache[id] && EphemerisCache[id]->matches( gp, year ) )
+        {
+            eph = EphemerisCache[id];
+            break;
+        }
+    }
+    // Otherwise calculate it and drop the least recently used one
+    if ( ! eph )
+    {
+        id = EphemerisCacheSize - 1;
+        delete EphemerisCache[id];
+        eph = new Ephemeris( gp, year );
+        checkmem( __FILE__, __LINE__, eph, "Ephemeris eph", 1 );
+    }
+    for ( ;
+          id > 0;
+          id-- )
+    {
+        EphemerisCache[id] = EphemerisCache[id-1];
+    }
+    EphemerisCache[0] = eph;
+    return( eph );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Determines if the ephemeris is for the location and year.
+ *
+ *  \param gp   Reference to the GlobalPosition of the observer.
+ *  \param year Julian-Gregorian calendar year.
+ *
+ *  \return TRUE if the ephemeris is for the location and year.
+ */
+
+bool Ephemeris::matches( const GlobalPosition &gp, int year ) const
+{
+    return( m_year == year
+         && m_gp.longitude() == gp.longitude()
+         && m_gp.latitude() == gp.latitude()
+         && m_gp.gmtDiff() == gp.gmtDiff() );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Access to the local Julian date of a new moon of the year.
+ *
+ *  Same as DateTime::newMoon( year, period, gp ).
+ *
+ *  \param period New moon of the year (1 == first new moon, 0 == last new
+ *  moon of the previous year), 0 through #EphemerisLunations - 1.
+ *
+ *  \return Local Julian date of the new moon.
+ */
+
+double Ephemeris::newMoon( int period ) const
+{
+    if ( period < 0 || period >= EphemerisLunations )
+    {
+        return( CDT_NewMoonGMT( m_year, period ) + m_gp.gmtDiff() / 24. );
+    }
+    return( m_newMoon[period] );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Access to the location of the ephemeris.
+ *
+ *  \return Reference to the ephemeris GlobalPosition.
+ */
+
+const GlobalPosition &Ephemeris::position( void ) const
+{
+    return( m_gp );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Access to a rise, set, or twilight event of a day.
+ *
+ *  \param event     One of the #CDT_Event rise or set enumerations
+ *                   (#CDT_SunRise through #CDT_AstronomicalDusk).
+ *  \param dayOfYear Day of the ephemeris year (1 == January 1).
+ *  \param *hours    Returned local decimal hours of the event.
+ *
+ *  \return The #CDT_Flag of the event as returned by CDT_RiseSet(),
+ *  or #CDT_None if the \a event or \a dayOfYear is out of range.
+ */
+
+int Ephemeris::riseSet( int event, int dayOfYear, double *hours ) const
+{
+    if ( event < CDT_SunRise
+      || event >= CDT_SunRise + EphemerisEvents
+      || dayOfYear < 1
+      || dayOfYear > m_days )
+    {
+        return( CDT_None );
+    }
+    int id = ( dayOfYear - 1 ) * EphemerisEvents + event - CDT_SunRise;
+    if ( m_flag[id] == CDT_Rises || m_flag[id] == CDT_Sets )
+    {
+        *hours = m_hours[id];
+    }
+    return( m_flag[id] );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Access to the ephemeris year.
+ *
+ *  \return Julian-Gregorian calendar year of the ephemeris.
+ */
+
+int Ephemeris::year( void ) const
+{
+    return( m_year );
+}
+
+//------------------------------------------------------------------------------
+//  End of ephemeris.cpp
+//------------------------------------------------------------------------------
+
@@ -0,0 +1,78 @@
+//------------------------------------------------------------------------------
+/*! \file ephemeris.h
+ *  \version BehavePlus6
+ *  \author Copyright (C) 2002-2018 by Collin D. Bevins.  All rights reserved.
+ *
+ *  \brief Year-long sun and moon ephemeris class declaration.
+ */
+
+#ifndef _EPHEMERIS_H_
+/*! \def _EPHEMERIS_H_
+ *  \brief Prevents redundant includes.
+ */
+#define _EPHEMERIS_H_ 1
+
+// Custom include files
+#include "globalposition.h"
+
+//------------------------------------------------------------------------------
+/*! \enum EphemerisSize
+ *  \brief Ephemeris table dimensions.
+ */
+
+enum EphemerisSize
+{
+    EphemerisEvents    = 10,    //!< CDT_SunRise through CDT_AstronomicalDusk
+    EphemerisLunations = 17,    //!< New moon periods 0 through 16
+    EphemerisCacheSize = 8      //!< Ephemerides retained by find()
+};
+
+//------------------------------------------------------------------------------
+/*! \class Ephemeris ephemeris.h
+ *
+ *  \brief Holds a full year of sun and moon rise, set, and twilight times
+ *  and the year's new moons for a GlobalPosition.
+ *
+ *  The events are found from hourly sun and moon altitude samples, and
+ *  find() retains the ephemerides of the most recently used locations and
+ *  years.
+ *
+ *  \sa DateTime::riseSet()
+ */
+
+class Ephemeris
+{
+// Public methods
+public:
+    Ephemeris( const GlobalPosition &gp, int year ) ;
+    ~Ephemeris( void ) ;
+
+    int     days( void ) const ;
+    bool    matches( const GlobalPosition &gp, int year ) const ;
+    double  newMoon( int period ) const ;
+    const GlobalPosition &position( void ) const ;
+    int     riseSet( int event, int dayOfYear, double *hours ) const ;
+    int     year( void ) const ;
+
+    static Ephemeris *find( const GlobalPosition &gp, int year ) ;
+
+// Protected methods
+protected:
+    void    calculate( void ) ;
+
+// Protected data members
+protected:
+    GlobalPosition m_gp;        //!< Location of the ephemeris
+    int     m_year;             //!< Julian-Gregorian calendar year
+    int     m_days;             //!< Number of days in #m_year
+    int    *m_flag;             //!< #CDT_Flag of each day's events
+    double *m_hours;            //!< Local decimal hour of each day's events
+    double  m_newMoon[EphemerisLunations]; //!< Local Julian date of each new moon
+};
+
+#endif
+
+//------------------------------------------------------------------------------
+//  End of ephemeris.h
+//------------------------------------------------------------------------------
+
@@ -0,0 +1,163 @@
+//------------------------------------------------------------------------------
+/*! \file fuelbedcache.cpp
+ *  \version BehavePlus6
+ *  \author Copyright (C) 2002-2018 by Collin D. Bevins.  All rights reserved.
+ *
+ *  \brief Moisture-independent surface fuel bed intermediate cache class
+ *  methods.
+ */
+
+// Custom include files
+#include "appmessage.h"
+#include "Bp6SurfaceFire.h"
+#include "fuelbedcache.h"
+
+//------------------------------------------------------------------------------
+/*! \brief Continues a 32-bit FNV-1a hash over a block of bytes.
+ *
+ *  \param h        Hash so far.
+ *  \param data     Address of the bytes.
+ *  \param bytes    Number of bytes.
+ *
+ *  \return Updated hash.
+ */
+
+static unsigned long FuelBedCache_Hash( unsigned long h, const void *data,
+        int bytes )
+{
+    const unsigned char *b = (const unsigned char *) data;
+    for ( int i = 0;
+          i < bytes;
+          i++ )
+    {
+        h = ( ( h ^ b[i] ) * 16777619UL ) & 0xffffffffUL;
+    }
+    return( h );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief FuelBedCache constructor.
+ */
+
+FuelBedCache::FuelBedCache( void ) :
+    m_dict(0),
+    m_hits(0),
+    m_misses(0)
+{
+    m_dict = new QDict<Bp6SurfaceFire>( FuelBedCachePrime, true );
+    Q_CHECK_PTR( m_dict );
+    m_dict->setAutoDelete( true );
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief FuelBedCache destructor.
+ */
+
+FuelBedCache::~FuelBedCache( void )
+{
+    delete m_dict;  m_dict = 0;
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Deletes all the cached fuel beds.
+ */
+
+void FuelBedCache::clear( void )
+{
+    m_dict->clear();
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Access to the number of cached fuel beds.
+ *
+ *  \return Number of cached fuel beds.
+ */
+
+int FuelBedCache::entries( void ) const
+{
+    return( m_dict->count() );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Access to the number of fuel beds restored from the cache.
+ *
+ *  \return Number of cache hits.
+ */
+
+int FuelBedCache::hits( void ) const
+{
+    return( m_hits );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Access to the number of fuel beds calculated and cached.
+ *
+ *  \return Number of cache misses.
+ */
+
+int FuelBedCache::misses( void ) const
+{
+    return( m_misses );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Sets the fuel of a Bp6SurfaceFire, restoring its fuel bed
+ *  intermediates from the cache if the same fuel has been seen before.
+ *
+ *  Takes the same fuel arguments as Bp6SurfaceFire::setFuel(), and leaves
+ *  \a fire in the same state.
+ *
+ *  \param fire Pointer to the Bp6SurfaceFire whose fuel is set.
+ */
+
+void FuelBedCache::setFuel( Bp6SurfaceFire *fire, double depth,
+        double deadMext, int particles, int *life, double *load,
+        double *savr, double *heat, double *dens, double *stot,
+        double *seff )
+{
+    // Hash the fuel inputs
+    unsigned long h = 2166136261UL;
+    h = FuelBedCache_Hash( h, &depth, sizeof(depth) );
+    h = FuelBedCache_Hash( h, &deadMext, sizeof(deadMext) );
+    h = FuelBedCache_Hash( h, &particles, sizeof(particles) );
+    h = FuelBedCache_Hash( h, life, particles * sizeof(int) );
+    h = FuelBedCache_Hash( h, load, particles * sizeof(double) );
+    h = FuelBedCache_Hash( h, savr, particles * sizeof(double) );
+    h = FuelBedCache_Hash( h, heat, particles * sizeof(double) );
+    h = FuelBedCache_Hash( h, dens, particles * sizeof(double) );
+    h = FuelBedCache_Hash( h, stot, particles * sizeof(double) );
+    h = FuelBedCache_Hash( h, seff, particles * sizeof(double) );
+    QString key = QString::number( h, 16 );
+
+    // Restore a previously calculated fuel bed
+    Bp6SurfaceFire *bed = m_dict->find( key );
+    if ( bed
+      && bed->isSameFuel( depth, deadMext, particles, life, load, savr, heat,
+            dens, stot, seff ) )
+    {
+        fire->copyFuel( *bed );
+        m_hits++;
+        return;
+    }
+    // Otherwise calculate it and keep a copy
+    fire->setFuel( depth, deadMext, particles, life, load, savr, heat, dens,
+        stot, seff );
+    m_misses++;
+    if ( (int) m_dict->count() >= FuelBedCacheMaxEntries )
+    {
+        m_dict->clear();
+    }
+    bed = new Bp6SurfaceFire();
+    checkmem( __FILE__, __LINE__, bed, "Bp6SurfaceFire bed", 1 );
+    bed->copyFuel( *fire );
+    m_dict->replace( key, bed );
+    return;
+}
+
+//------------------------------------------------------------------------------
+//  End of fuelbedcache.cpp
+//------------------------------------------------------------------------------
+
@@ -0,0 +1,76 @@
+//------------------------------------------------------------------------------
+/*! \file fuelbedcache.h
+ *  \version BehavePlus6
+ *  \author Copyright (C) 2002-2018 by Collin D. Bevins.  All rights reserved.
+ *
+ *  \brief Moisture-independent surface fuel bed intermediate cache class
+ *  definitions.
+ */
+
+#ifndef _FUELBEDCACHE_H_
+/*! \def _FUELBEDCACHE_H_
+ *  \brief Prevent redundant includes.
+ */
+#define _FUELBEDCACHE_H_ 1
+
+// Custom class references
+template <class Real> class Bp6SurfaceFireT;
+typedef Bp6SurfaceFireT<double> Bp6SurfaceFire;
+
+// Qt class references
+#include <qdict.h>
+
+//------------------------------------------------------------------------------
+/*! \enum FuelBedCacheSize
+ *  \brief FuelBedCache limits.
+ */
+
+enum FuelBedCacheSize
+{
+    FuelBedCachePrime = 211,        //!< Dictionary size (a prime number)
+    FuelBedCacheMaxEntries = 1024   //!< Maximum number of cached fuel beds
+};
+
+//------------------------------------------------------------------------------
+/*! \class FuelBedCache fuelbedcache.h
+ *
+ *  \brief Keeps the moisture-independent intermediates of every fuel bed
+ *  the application has seen, so switching back to a fuel bed restores them
+ *  by copy rather than recalculating them.
+ *
+ *  Each cached fuel bed is a Bp6SurfaceFire whose fuel has been set.  They
+ *  are keyed by a hash of the fuel inputs, and a hit is confirmed by
+ *  comparing every input, so a custom fuel model, an edited fuel model, or
+ *  a dynamic fuel model whose herbaceous load transfer depends upon the
+ *  live herbaceous moisture all find (only) their own fuel bed.  When the
+ *  cache is full it is emptied and refilled as fuel beds are used.
+ */
+
+class FuelBedCache
+{
+// Public methods
+public:
+    FuelBedCache( void ) ;
+    ~FuelBedCache( void ) ;
+
+    void clear( void ) ;
+    int  entries( void ) const ;
+    int  hits( void ) const ;
+    int  misses( void ) const ;
+    void setFuel( Bp6SurfaceFire *fire, double depth, double deadMext,
+                int particles, int *life, double *load, double *savr,
+                double *heat, double *dens, double *stot, double *seff ) ;
+
+// Protected data members
+protected:
+    QDict<Bp6SurfaceFire> *m_dict;  //!< Cached fuel beds by fuel hash
+    int m_hits;                     //!< Number of fuel beds restored
+    int m_misses;                   //!< Number of fuel beds calculated
+};
+
+#endif
+
+//------------------------------------------------------------------------------
+//  End of fuelbedcache.h
+//------------------------------------------------------------------------------
+
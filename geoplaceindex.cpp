@@ -0,0 +1,873 @@
+//------------------------------------------------------------------------------
+/*! \file geoplaceindex.cpp
+ *  \version BehavePlus6
+ *  \author Copyright (C) 2002-2018 by Collin D. Bevins.  All rights reserved.
+ *
+ *  \brief Indexed geographic place name catalog class methods.
+ */
+
+// Custom include files
+#include "appmessage.h"
+#include "geoplaceindex.h"
+#include "platform.h"
+
+// Qt include files
+#include <qdatetime.h>
+#include <qdir.h>
+#include <qfileinfo.h>
+
+// Standard include files
+#include <algorithm>
+#include <ctype.h>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+// Index file layout
+static const char GeoIndexMagic[8] = { 'B', 'P', 'G', 'E', 'O', 'I', 'X', 0 };
+static const int  GeoIndexVersion = 1;
+static const int  GeoLineSize     = 136;    // Fixed width *.geo line length
+static const int  GeoNameSize     = 50;     // Place name field width
+static const int  GeoFileNameSize = 64;     // *.geo base name field width
+static const int  GeoGridLats     = 180;    // One degree grid rows
+static const int  GeoGridLons     = 360;    // One degree grid columns
+static const int  GeoNoCoord      = -2147483647; // Place has no lat-lon
+
+//------------------------------------------------------------------------------
+/*! \struct GeoIndexHeader
+ *  \brief Fixed size header at the start of the place index file.
+ */
+
+struct GeoIndexHeader
+{
+    char m_magic[8];            //!< GeoIndexMagic
+    int  m_version;             //!< GeoIndexVersion
+    int  m_files;               //!< Number of *.geo files
+    int  m_places;              //!< Number of places in all files
+    int  m_cells;               //!< Number of grid cells
+    int  m_bytes;               //!< Total index file bytes
+    int  m_pad;                 //!< Keeps the file table 8 byte aligned
+};
+
+//------------------------------------------------------------------------------
+/*! \struct GeoIndexFile
+ *  \brief Place index file table entry for a single *.geo file.
+ */
+
+struct GeoIndexFile
+{
+    char m_name[GeoFileNameSize]; //!< File base name (without ".geo")
+    unsigned int m_mtime;       //!< File last modified time_t
+    int  m_size;                //!< File size in bytes
+    int  m_first;               //!< Id of the file's first place
+    int  m_count;               //!< Number of places in the file
+};
+
+//------------------------------------------------------------------------------
+/*! \struct GeoNameLess
+ *  \brief Case-insensitive place name ordering used to sort the name index.
+ */
+
+struct GeoNameLess
+{
+    const char *m_line;
+    GeoNameLess( const char *line ) : m_line(line) {}
+    bool operator()( int a, int b ) const
+    {
+        const unsigned char *pa =
+            (const unsigned char *) m_line + a * GeoLineSize;
+        const unsigned char *pb =
+            (const unsigned char *) m_line + b * GeoLineSize;
+        for ( int i = 0;
+              i < GeoNameSize;
+              i++ )
+        {
+            int ca = toupper( pa[i] );
+            int cb = toupper( pb[i] );
+            if ( ca != cb )
+            {
+                return( ca < cb );
+            }
+        }
+        return( a < b );
+    }
+};
+
+//------------------------------------------------------------------------------
+/*! \struct GeoDistanceLess
+ *  \brief Nearest place candidate ordering by distance, then by place id.
+ */
+
+struct GeoDistanceLess
+{
+    const double *m_dist;
+    const int *m_id;
+    GeoDistanceLess( const double *dist, const int *id ) :
+        m_dist(dist), m_id(id) {}
+    bool operator()( int a, int b ) const
+    {
+        if ( m_dist[a] != m_dist[b] )
+        {
+            return( m_dist[a] < m_dist[b] );
+        }
+        return( m_id[a] < m_id[b] );
+    }
+};
+
+//------------------------------------------------------------------------------
+/*! \brief Decodes a fixed width latitude ("DDMMSSN") or longitude
+ *  ("DDDMMSSW") field into signed arc seconds.
+ *
+ *  \param str      Pointer to the field.
+ *  \param digits   Number of degree digits (2 for latitude, 3 for longitude).
+ *  \param negative Hemisphere character that makes the value negative.
+ *
+ *  \return Signed arc seconds, or GeoNoCoord if the field is blank or
+ *  malformed.
+ */
+
+static int GeoArcSeconds( const char *str, int digits, char negative )
+{
+    int value[3] = { 0, 0, 0 };
+    int width[3] = { digits, 2, 2 };
+    int pos = 0;
+    for ( int part = 0;
+          part < 3;
+          part++ )
+    {
+        for ( int i = 0;
+              i < width[part];
+              i++, pos++ )
+        {
+            if ( ! isdigit( (unsigned char) str[pos] ) )
+            {
+                return( GeoNoCoord );
+            }
+            value[part] = 10 * value[part] + ( str[pos] - '0' );
+        }
+    }
+    int seconds = 3600 * value[0] + 60 * value[1] + value[2];
+    if ( str[pos] == negative )
+    {
+        return( -seconds );
+    }
+    else if ( isalpha( (unsigned char) str[pos] ) )
+    {
+        return( seconds );
+    }
+    return( GeoNoCoord );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Determines the grid cell containing a position.
+ *
+ *  \param lat Latitude in degrees (north is positive).
+ *  \param lon Longitude in degrees (west is positive).
+ *
+ *  \return Grid cell index.
+ */
+
+static int GeoGridCell( double lat, double lon )
+{
+    int row = (int) floor( lat + 90. );
+    int col = (int) floor( lon + 180. );
+    row = ( row < 0 ) ? 0 : ( ( row >= GeoGridLats ) ? GeoGridLats - 1 : row );
+    col = ( col < 0 ) ? 0 : ( ( col >= GeoGridLons ) ? GeoGridLons - 1 : col );
+    return( row * GeoGridLons + col );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief GeoPlaceIndex constructor.
+ *
+ *  The index is not available until refresh() has been called.
+ *
+ *  \param geoPath   Full path name of the GeoFolder (with trailing
+ *                   separator).
+ *  \param indexFile Full path name of the index file to read and write.
+ */
+
+GeoPlaceIndex::GeoPlaceIndex( const QString &geoPath,
+        const QString &indexFile ) :
+    m_geoPath(geoPath),
+    m_indexFile(indexFile),
+    m_data(),
+    m_mapData(0),
+    m_mapBytes(0),
+    m_mapHandle(0),
+    m_header(0),
+    m_file(0),
+    m_line(0),
+    m_byName(0),
+    m_coord(0),
+    m_cellStart(0),
+    m_byCell(0)
+{
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief GeoPlaceIndex destructor.
+ */
+
+GeoPlaceIndex::~GeoPlaceIndex( void )
+{
+    unmap();
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Builds the index from the *.geo files and writes it to the index
+ *  file.
+ *
+ *  The index remains usable even if the index file cannot be written.
+ *
+ *  \return TRUE if the index was built.
+ */
+
+bool GeoPlaceIndex::build( void )
+{
+    // The index file cannot be rewritten while it is mapped
+    unmap();
+    m_data.resize( 0 );
+    m_header = 0;
+    QDir dir( m_geoPath, "*.geo", QDir::Name, QDir::Files );
+    const QFileInfoList *files = dir.entryInfoList();
+    int nFiles = ( files ) ? files->count() : 0;
+
+    // Read every line of every file into the place lines array
+    QMemArray<GeoIndexFile> table( nFiles > 0 ? nFiles : 1 );
+    QMemArray<char> lines( 50000 * GeoLineSize );
+    int places = 0;
+    char buffer[512];
+    int id = 0;
+    if ( files )
+    {
+        QFileInfoListIterator it( *files );
+        QFileInfo *fi;
+        for ( ;
+              ( fi = it.current() ) != 0;
+              ++it, id++ )
+        {
+            GeoIndexFile *gf = &table[id];
+            memset( gf, 0, sizeof(GeoIndexFile) );
+            strncpy( gf->m_name, fi->baseName().latin1(), GeoFileNameSize-1 );
+            gf->m_mtime = fi->lastModified().toTime_t();
+            gf->m_size  = (int) fi->size();
+            gf->m_first = places;
+            FILE *fptr = fopen( fi->filePath().latin1(), "r" );
+            if ( ! fptr )
+            {
+                continue;
+            }
+            while ( fgets( buffer, sizeof(buffer), fptr ) )
+            {
+                int len = strlen( buffer );
+                while ( len > 0
+                     && ( buffer[len-1] == '\n' || buffer[len-1] == '\r' ) )
+                {
+                    len--;
+                }
+                if ( len == 0 )
+                {
+                    continue;
+                }
+                if ( (uint) ( ( places + 1 ) * GeoLineSize ) > lines.size() )
+                {
+                    lines.resize( 2 * lines.size() );
+                }
+                char *line = lines.data() + places * GeoLineSize;
+                memset( line, ' ', GeoLineSize );
+                memcpy( line, buffer,
+                    ( len < GeoLineSize ) ? len : GeoLineSize );
+                places++;
+            }
+            fclose( fptr );
+            gf->m_count = places - gf->m_first;
+        }
+    }
+
+    // Allocate the index in its file layout
+    int cells = GeoGridLats * GeoGridLons;
+    int bytes = sizeof(GeoIndexHeader)
+              + nFiles * sizeof(GeoIndexFile)
+              + places * GeoLineSize
+              + places * sizeof(int)
+              + 2 * places * sizeof(int)
+              + ( cells + 1 ) * sizeof(int)
+              + places * sizeof(int);
+    m_data.resize( bytes );
+    memset( m_data.data(), 0, bytes );
+    GeoIndexHeader *header = (GeoIndexHeader *) m_data.data();
+    memcpy( header->m_magic, GeoIndexMagic, sizeof(GeoIndexMagic) );
+    header->m_version = GeoIndexVersion;
+    header->m_files   = nFiles;
+    header->m_places  = places;
+    header->m_cells   = cells;
+    header->m_bytes   = bytes;
+    char *ptr = m_data.data() + sizeof(GeoIndexHeader);
+    if ( nFiles > 0 )
+    {
+        memcpy( ptr, table.data(), nFiles * sizeof(GeoIndexFile) );
+    }
+    ptr += nFiles * sizeof(GeoIndexFile);
+    char *line = ptr;
+    memcpy( line, lines.data(), places * GeoLineSize );
+    ptr += places * GeoLineSize;
+    int *byName = (int *) ptr;
+    ptr += places * sizeof(int);
+    int *coord = (int *) ptr;
+    ptr += 2 * places * sizeof(int);
+    int *cellStart = (int *) ptr;
+    ptr += ( cells + 1 ) * sizeof(int);
+    int *byCell = (int *) ptr;
+
+    // Name index
+    for ( id = 0;
+          id < places;
+          id++ )
+    {
+        byName[id] = id;
+    }
+    std::sort( byName, byName + places, GeoNameLess( line ) );
+
+    // Coordinates and grid cell counts
+    QMemArray<int> cellOf( places > 0 ? places : 1 );
+    for ( id = 0;
+          id < places;
+          id++ )
+    {
+        const char *str = line + id * GeoLineSize;
+        int lat = GeoArcSeconds( str + 110, 2, 'S' );
+        int lon = GeoArcSeconds( str + 117, 3, 'E' );
+        if ( lat == GeoNoCoord || lon == GeoNoCoord )
+        {
+            lat = lon = GeoNoCoord;
+            cellOf[id] = -1;
+        }
+        else
+        {
+            cellOf[id] = GeoGridCell( lat / 3600., lon / 3600. );
+            cellStart[ cellOf[id] + 1 ]++;
+        }
+        coord[2*id]   = lat;
+        coord[2*id+1] = lon;
+    }
+    // Grid cell offsets and place ids by cell
+    int cell;
+    for ( cell = 0;
+          cell < cells;
+          cell++ )
+    {
+        cellStart[cell+1] += cellStart[cell];
+    }
+    QMemArray<int> fill( cells );
+    for ( cell = 0;
+          cell < cells;
+          cell++ )
+    {
+        fill[cell] = cellStart[cell];
+    }
+    for ( id = 0;
+          id < places;
+          id++ )
+    {
+        if ( cellOf[id] >= 0 )
+        {
+            byCell[ fill[ cellOf[id] ]++ ] = id;
+        }
+    }
+    map( m_data.data(), m_data.size() );
+
+    // Save the index for next time; an unwritable workspace is not an error
+    FILE *fptr = fopen( m_indexFile.latin1(), "wb" );
+    if ( fptr )
+    {
+        bool ok = ( fwrite( m_data.data(), 1, bytes, fptr ) == (size_t) bytes );
+        fclose( fptr );
+        if ( ! ok )
+        {
+            remove( m_indexFile.latin1() );
+        }
+    }
+    return( m_header != 0 );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Finds the range of places in a catalog (*.geo file).
+ *
+ *  \param catalogName Catalog (*.geo file base) name.
+ *  \param first       Returned id of the catalog's first place.
+ *
+ *  \return Number of places in the catalog, or -1 if there is no such
+ *  catalog.
+ */
+
+int GeoPlaceIndex::catalog( const QString &catalogName, int *first ) const
+{
+    if ( ! m_header )
+    {
+        return( -1 );
+    }
+    for ( int id = 0;
+          id < m_header->m_files;
+          id++ )
+    {
+        if ( catalogName == m_file[id].m_name )
+        {
+            *first = m_file[id].m_first;
+            return( m_file[id].m_count );
+        }
+    }
+    return( -1 );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Compares a place name with a name prefix.
+ *
+ *  \param id     Place id.
+ *  \param prefix Upper case name prefix.
+ *  \param length Number of characters in \a prefix.
+ *
+ *  \return -1, 0, or 1 if the place name is less than, begins with, or is
+ *  greater than the \a prefix.
+ */
+
+int GeoPlaceIndex::compareName( int id, const char *prefix, int length ) const
+{
+    const unsigned char *name =
+        (const unsigned char *) m_line + id * GeoLineSize;
+    for ( int i = 0;
+          i < length;
+          i++ )
+    {
+        int c = toupper( name[i] );
+        int p = (unsigned char) prefix[i];
+        if ( c != p )
+        {
+            return( ( c < p ) ? -1 : 1 );
+        }
+    }
+    return( 0 );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Access to the number of indexed places.
+ *
+ *  \return Number of indexed places.
+ */
+
+int GeoPlaceIndex::count( void ) const
+{
+    return( m_header ? m_header->m_places : 0 );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Decodes the latitude ("DDMMSSN") and longitude ("DDDMMSSW") text
+ *  of a place record, as returned by field(), into decimal degrees.
+ *
+ *  \param lat    Latitude text.
+ *  \param lon    Longitude text.
+ *  \param latDeg Returned latitude in degrees (north is positive).
+ *  \param lonDeg Returned longitude in degrees (west is positive).
+ *
+ *  \return TRUE if both were decoded.
+ */
+
+bool GeoPlaceIndex::decode( const QString &lat, const QString &lon,
+        double *latDeg, double *lonDeg )
+{
+    char latStr[8], lonStr[9];
+    memset( latStr, ' ', sizeof(latStr) );
+    memset( lonStr, ' ', sizeof(lonStr) );
+    const char *latin = lat.latin1();
+    if ( latin )
+    {
+        strncpy( latStr, latin, sizeof(latStr) );
+    }
+    latin = lon.latin1();
+    if ( latin )
+    {
+        strncpy( lonStr, latin, sizeof(lonStr) );
+    }
+    int latSec = GeoArcSeconds( latStr, 2, 'S' );
+    int lonSec = GeoArcSeconds( lonStr, 3, 'E' );
+    if ( latSec == GeoNoCoord || lonSec == GeoNoCoord )
+    {
+        return( false );
+    }
+    *latDeg = latSec / 3600.;
+    *lonDeg = lonSec / 3600.;
+    return( true );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Access to a field of a place record.
+ *
+ *  \param id    Place id.
+ *  \param field One of the #GeoPlaceField enumerations.
+ *
+ *  \return The field's text with surrounding white space removed.
+ */
+
+QString GeoPlaceIndex::field( int id, int field ) const
+{
+    static const int Offset[GeoPlaceFields] =
+        {  93, 61,  0, 51, 117, 110, 126, 132 };
+    static const int Width[GeoPlaceFields] =
+        {  16, 31, 50,  9,   8,   7,   5,   4 };
+    if ( ! m_header || id < 0 || id >= m_header->m_places
+      || field < 0 || field >= GeoPlaceFields )
+    {
+        return( QString( "" ) );
+    }
+    return( QString::fromLatin1( m_line + id * GeoLineSize + Offset[field],
+        Width[field] ).stripWhiteSpace() );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Finds all the places, in all catalogs, whose name begins with
+ *  \a prefix (ignoring case), in name order.
+ *
+ *  \param prefix Place name prefix.
+ *  \param ids    Returned array of place ids.
+ *  \param maxIds Maximum number of place ids to return.
+ *
+ *  \return Number of place ids returned in \a ids.
+ */
+
+int GeoPlaceIndex::findName( const QString &prefix, QMemArray<int> &ids,
+        int maxIds ) const
+{
+    ids.resize( 0 );
+    if ( ! m_header || maxIds <= 0 )
+    {
+        return( 0 );
+    }
+    // Upper case the prefix just as the names were compared when sorted
+    QString str = prefix.stripWhiteSpace();
+    char key[GeoNameSize+1];
+    int length = 0;
+    const char *latin = str.latin1();
+    while ( length < GeoNameSize && latin && latin[length] )
+    {
+        key[length] = (char) toupper( (unsigned char) latin[length] );
+        length++;
+    }
+    // Binary search for the first place name with the prefix
+    int lo = 0;
+    int hi = m_header->m_places;
+    while ( lo < hi )
+    {
+        int mid = ( lo + hi ) / 2;
+        if ( compareName( m_byName[mid], key, length ) < 0 )
+        {
+            lo = mid + 1;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+    int n = 0;
+    ids.resize( maxIds );
+    for ( ;
+          lo < m_header->m_places && n < maxIds
+          && compareName( m_byName[lo], key, length ) == 0;
+          lo++ )
+    {
+        ids[n++] = m_byName[lo];
+    }
+    ids.resize( n );
+    return( n );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Determines if the index is current with the GeoFolder's *.geo
+ *  files.
+ *
+ *  \return TRUE if the index exists and the same *.geo files exist with
+ *  the same modification times and sizes.
+ */
+
+bool GeoPlaceIndex::isCurrent( void ) const
+{
+    if ( ! m_header )
+    {
+        return( false );
+    }
+    QDir dir( m_geoPath, "*.geo", QDir::Name, QDir::Files );
+    const QFileInfoList *files = dir.entryInfoList();
+    int nFiles = ( files ) ? files->count() : 0;
+    if ( nFiles != m_header->m_files )
+    {
+        return( false );
+    }
+    if ( files )
+    {
+        QFileInfoListIterator it( *files );
+        QFileInfo *fi;
+        for ( int id = 0;
+              ( fi = it.current() ) != 0;
+              ++it, id++ )
+        {
+            if ( fi->baseName() != m_file[id].m_name
+              || fi->lastModified().toTime_t() != m_file[id].m_mtime
+              || (int) fi->size() != m_file[id].m_size )
+            {
+                return( false );
+            }
+        }
+    }
+    return( true );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Memory-maps the index file.
+ *
+ *  \return TRUE if the index file was mapped and is a valid index.
+ */
+
+bool GeoPlaceIndex::load( void )
+{
+    unmap();
+    m_data.resize( 0 );
+    m_header = 0;
+    m_mapData = platformMapFile( m_indexFile, &m_mapBytes, &m_mapHandle );
+    if ( ! m_mapData )
+    {
+        return( false );
+    }
+    if ( ! map( m_mapData, m_mapBytes ) )
+    {
+        unmap();
+        return( false );
+    }
+    return( true );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Validates an index and sets the section pointers into it.
+ *
+ *  \param data  Index contents, either #m_data or the mapped index file.
+ *  \param bytes Size of \a data in bytes.
+ *
+ *  \return TRUE if \a data holds a valid index.
+ */
+
+bool GeoPlaceIndex::map( const char *data, unsigned long bytes )
+{
+    m_header = 0;
+    if ( bytes < sizeof(GeoIndexHeader) )
+    {
+        return( false );
+    }
+    const GeoIndexHeader *header = (const GeoIndexHeader *) data;
+    if ( memcmp( header->m_magic, GeoIndexMagic, sizeof(GeoIndexMagic) )
+      || header->m_version != GeoIndexVersion
+      || header->m_bytes != (int) bytes
+      || header->m_cells != GeoGridLats * GeoGridLons
+      || header->m_files < 0
+      || header->m_places < 0 )
+    {
+        return( false );
+    }
+    int places = header->m_places;
+    const char *ptr = data + sizeof(GeoIndexHeader);
+    m_file = (const GeoIndexFile *) ptr;
+    ptr += header->m_files * sizeof(GeoIndexFile);
+    m_line = ptr;
+    ptr += places * GeoLineSize;
+    m_byName = (const int *) ptr;
+    ptr += places * sizeof(int);
+    m_coord = (const int *) ptr;
+    ptr += 2 * places * sizeof(int);
+    m_cellStart = (const int *) ptr;
+    ptr += ( header->m_cells + 1 ) * sizeof(int);
+    m_byCell = (const int *) ptr;
+    ptr += places * sizeof(int);
+    if ( ptr != data + bytes )
+    {
+        return( false );
+    }
+    m_header = header;
+    return( true );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Finds the places nearest a position, nearest first.
+ *
+ *  Grid cells are visited in rings of increasing size around the position's
+ *  cell until no unvisited cell can contain a place nearer than the
+ *  \a maxIds nearest place found so far.
+ *
+ *  \param lat    Latitude in degrees (north is positive).
+ *  \param lon    Longitude in degrees (west is positive, as GlobalPosition).
+ *  \param ids    Returned array of place ids.
+ *  \param maxIds Maximum number of place ids to return.
+ *
+ *  \return Number of place ids returned in \a ids.
+ */
+
+int GeoPlaceIndex::nearest( double lat, double lon, QMemArray<int> &ids,
+        int maxIds ) const
+{
+    ids.resize( 0 );
+    if ( ! m_header || maxIds <= 0 )
+    {
+        return( 0 );
+    }
+    // Distances are in degrees of latitude
+    double coslat = cos( 0.0174532925199433 * lat );
+    int cell0 = GeoGridCell( lat, lon );
+    int row0 = cell0 / GeoGridLons;
+    int col0 = cell0 % GeoGridLons;
+    QMemArray<int> candId( 256 );
+    QMemArray<double> candDist( 256 );
+    int n = 0;
+    double worst = 0.;
+    for ( int ring = 0;
+          ring < GeoGridLons / 2;
+          ring++ )
+    {
+        for ( int dr = -ring;
+              dr <= ring;
+              dr++ )
+        {
+            int row = row0 + dr;
+            if ( row < 0 || row >= GeoGridLats )
+            {
+                continue;
+            }
+            // Only the ring's perimeter cells are new
+            int step = ( dr == -ring || dr == ring ) ? 1 : 2 * ring;
+            for ( int dc = -ring;
+                  dc <= ring;
+                  dc += step )
+            {
+                int col = ( col0 + dc + GeoGridLons ) % GeoGridLons;
+                int cell = row * GeoGridLons + col;
+                for ( int k = m_cellStart[cell];
+                      k < m_cellStart[cell+1];
+                      k++ )
+                {
+                    int id = m_byCell[k];
+                    double dlat = lat - m_coord[2*id] / 3600.;
+                    double dlon = fabs( lon - m_coord[2*id+1] / 3600. );
+                    if ( dlon > 180. )
+                    {
+                        dlon = 360. - dlon;
+                    }
+                    dlon *= coslat;
+                    if ( (uint) n >= candId.size() )
+                    {
+                        candId.resize( 2 * candId.size() );
+                        candDist.resize( 2 * candDist.size() );
+                    }
+                    candId[n] = id;
+                    candDist[n] = sqrt( dlat * dlat + dlon * dlon );
+                    n++;
+                }
+            }
+        }
+        // Stop once the next ring cannot hold anything nearer
+        if ( n >= maxIds )
+        {
+            QMemArray<double> sorted( n );
+            memcpy( sorted.data(), candDist.data(), n * sizeof(double) );
+            std::nth_element( sorted.data(), sorted.data() + maxIds - 1,
+                sorted.data() + n );
+            worst = sorted[maxIds-1];
+            if ( ring * coslat > worst )
+            {
+                break;
+            }
+        }
+    }
+    // Sort the candidates by distance and return the nearest
+    QMemArray<int> order( n > 0 ? n : 1 );
+    int i;
+    for ( i = 0;
+          i < n;
+          i++ )
+    {
+        order[i] = i;
+    }
+    std::sort( order.data(), order.data() + n,
+        GeoDistanceLess( candDist.data(), candId.data() ) );
+    if ( n > maxIds )
+    {
+        n = maxIds;
+    }
+    ids.resize( n );
+    for ( i = 0;
+          i < n;
+          i++ )
+    {
+        ids[i] = candId[ order[i] ];
+    }
+    return( n );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Access to a place's position.
+ *
+ *  \param id   Place id.
+ *  \param lat  Returned latitude in degrees (north is positive).
+ *  \param lon  Returned longitude in degrees (west is positive).
+ *
+ *  \return TRUE if the place has a position.
+ */
+
+bool GeoPlaceIndex::position( int id, double *lat, double *lon ) const
+{
+    if ( ! m_header || id < 0 || id >= m_header->m_places
+      || m_coord[2*id] == GeoNoCoord )
+    {
+        return( false );
+    }
+    *lat = m_coord[2*id] / 3600.;
+    *lon = m_coord[2*id+1] / 3600.;
+    return( true );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Makes sure the index is current, reading the index file or
+ *  rebuilding the index only if necessary.
+ *
+ *  \return TRUE if the index is available.
+ */
+
+bool GeoPlaceIndex::refresh( void )
+{
+    if ( isCurrent() )
+    {
+        return( true );
+    }
+    if ( load() && isCurrent() )
+    {
+        return( true );
+    }
+    return( build() );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Unmaps the index file, if it is mapped.
+ */
+
+void GeoPlaceIndex::unmap( void )
+{
+    if ( m_mapData )
+    {
+        platformUnmapFile( m_mapData, m_mapBytes, m_mapHandle );
+        m_header = 0;
+    }
+    m_mapData = 0;
+    m_mapBytes = 0;
+    m_mapHandle = 0;
+    return;
+}
+
+//------------------------------------------------------------------------------
+//  End of geoplaceindex.cpp
+//------------------------------------------------------------------------------
+
@@ -0,0 +1,115 @@
+//------------------------------------------------------------------------------
+/*! \file geoplaceindex.h
+ *  \version BehavePlus6
+ *  \author Copyright (C) 2002-2018 by Collin D. Bevins.  All rights reserved.
+ *
+ *  \brief Indexed geographic place name catalog class declaration.
+ */
+
+#ifndef _GEOPLACEINDEX_H_
+/*! \def _GEOPLACEINDEX_H_
+ *  \brief Prevent redundant includes.
+ */
+#define _GEOPLACEINDEX_H_ 1
+
+// Qt include files
+#include <qmemarray.h>
+#include <qstring.h>
+
+//------------------------------------------------------------------------------
+/*! \enum GeoPlaceField
+ *  \brief Fields of a geographic place record, in GeoPlaceDialog column order.
+ */
+
+enum GeoPlaceField
+{
+    GeoPlaceState  = 0,     //!< State, province, or country
+    GeoPlaceCounty = 1,     //!< County, district, or region
+    GeoPlaceName   = 2,     //!< Geographic place name
+    GeoPlaceType   = 3,     //!< Geographic feature type
+    GeoPlaceLon    = 4,     //!< Longitude as "DDDMMSSW"
+    GeoPlaceLat    = 5,     //!< Latitude as "DDMMSSN"
+    GeoPlaceElev   = 6,     //!< Elevation
+    GeoPlaceGmt    = 7,     //!< GMT hour difference
+    GeoPlaceFields = 8      //!< Number of fields
+};
+
+// Index file sections (defined in geoplaceindex.cpp)
+struct GeoIndexHeader;
+struct GeoIndexFile;
+
+//------------------------------------------------------------------------------
+/*! \class GeoPlaceIndex geoplaceindex.h
+ *
+ *  \brief Name and location index of every place in the GeoFolder's
+ *  fixed-width *.geo place name files.
+ *
+ *  The index is saved to a binary file, memory-mapped by platformMapFile(),
+ *  and rebuilt whenever a *.geo file is added, removed, or changed.
+ *
+ *  The index file is laid out as (all values in native byte order):
+ *      -# a GeoIndexHeader,
+ *      -# one GeoIndexFile per *.geo file with its name, modification time,
+ *         size, and range of place records,
+ *      -# every place's fixed-width text line, padded to #GeoLineSize,
+ *      -# the place ids sorted by case-insensitive place name, so any
+ *         name prefix is found by binary search (a flattened prefix trie),
+ *      -# each place's latitude and longitude in signed arc seconds,
+ *      -# a one degree latitude-longitude grid of place ids, as the
+ *         starting offset of each grid cell followed by the place ids
+ *         sorted by cell, so nearest place searches only visit the cells
+ *         surrounding a position.
+ */
+
+class GeoPlaceIndex
+{
+// Public methods
+public:
+    GeoPlaceIndex( const QString &geoPath, const QString &indexFile ) ;
+    ~GeoPlaceIndex( void ) ;
+
+    int     catalog( const QString &catalogName, int *first ) const ;
+    int     count( void ) const ;
+    QString field( int id, int field ) const ;
+    int     findName( const QString &prefix, QMemArray<int> &ids,
+                int maxIds ) const ;
+    bool    isCurrent( void ) const ;
+    int     nearest( double lat, double lon, QMemArray<int> &ids,
+                int maxIds ) const ;
+    bool    position( int id, double *lat, double *lon ) const ;
+    bool    refresh( void ) ;
+
+    static bool decode( const QString &lat, const QString &lon,
+                double *latDeg, double *lonDeg ) ;
+
+// Protected methods
+protected:
+    bool    build( void ) ;
+    int     compareName( int id, const char *prefix, int length ) const ;
+    bool    load( void ) ;
+    bool    map( const char *data, unsigned long bytes ) ;
+    void    unmap( void ) ;
+
+// Protected data members
+protected:
+    QString m_geoPath;          //!< GeoFolder full path name
+    QString m_indexFile;        //!< Index file full path name
+    QMemArray<char> m_data;     //!< Newly built index contents
+    const char *m_mapData;      //!< Mapped index file contents, or 0
+    unsigned long m_mapBytes;   //!< Mapped index file size
+    void       *m_mapHandle;    //!< Platform index file mapping handle
+    const GeoIndexHeader *m_header; //!< Index header within the index
+    const GeoIndexFile *m_file; //!< Index file table within the index
+    const char *m_line;         //!< Place text lines within the index
+    const int  *m_byName;       //!< Place ids by name within the index
+    const int  *m_coord;        //!< Place lat-lon seconds within the index
+    const int  *m_cellStart;    //!< Grid cell offsets within the index
+    const int  *m_byCell;       //!< Place ids by grid cell within the index
+};
+
+#endif
+
+//------------------------------------------------------------------------------
+//  End of geoplaceindex.h
+//------------------------------------------------------------------------------
+
@@ -0,0 +1,590 @@
+//------------------------------------------------------------------------------
+/*! \file landscapegrid.cpp
+ *  \version BehavePlus6
+ *  \author Copyright (C) 2002-2018 by Collin D. Bevins.  All rights reserved.
+ *
+ *  \brief Landscape raster grid file class methods.
+ */
+
+// Custom include files
+#include "appmessage.h"
+#include "apptranslator.h"
+#include "landscapegrid.h"
+#include "platform.h"
+
+// Standard include files
+#include <ctype.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+//------------------------------------------------------------------------------
+/*! \brief Determines if the host stores numbers least significant byte first.
+ *
+ *  \return TRUE if the host is little-endian.
+ */
+
+static bool LandscapeGrid_HostIsLsb( void )
+{
+    unsigned short one = 1;
+    return( *( (unsigned char *) &one ) == 1 );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Reverses the byte order of an array of 4-byte floats.
+ *
+ *  \param buffer   Array of floats.
+ *  \param n        Number of floats in the array.
+ */
+
+static void LandscapeGrid_Swap( float *buffer, int n )
+{
+    unsigned char *b = (unsigned char *) buffer;
+    unsigned char tmp;
+    for ( int i = 0;
+          i < n;
+          i++, b += 4 )
+    {
+        tmp = b[0]; b[0] = b[3]; b[3] = tmp;
+        tmp = b[1]; b[1] = b[2]; b[2] = tmp;
+    }
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Returns the name of a binary grid's header file.
+ *
+ *  \param fileName Binary grid (*.flt) file name.
+ *
+ *  \return Header (*.hdr) file name.
+ */
+
+static QString LandscapeGrid_HeaderName( const QString &fileName )
+{
+    int dot = fileName.findRev( '.' );
+    return( ( ( dot > 0 ) ? fileName.left( dot ) : fileName ) + ".hdr" );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief LandscapeGrid default constructor.
+ */
+
+LandscapeGrid::LandscapeGrid( void ) :
+    m_fileName(""),
+    m_error(""),
+    m_fptr(0),
+    m_buffer(0),
+    m_mapData(0),
+    m_mapBytes(0),
+    m_mapHandle(0),
+    m_format(LandscapeGridAscii),
+    m_cols(0),
+    m_rows(0),
+    m_row(0),
+    m_xll(0.),
+    m_yll(0.),
+    m_cellSize(0.),
+    m_noData(-9999.),
+    m_center(false),
+    m_swap(false)
+{
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief LandscapeGrid destructor.
+ */
+
+LandscapeGrid::~LandscapeGrid( void )
+{
+    close();
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Access to the grid cell size.
+ *
+ *  \return Cell size in the grid's coordinate units.
+ */
+
+double LandscapeGrid::cellSize( void ) const
+{
+    return( m_cellSize );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Closes the grid file if it is open.
+ */
+
+void LandscapeGrid::close( void )
+{
+    if ( m_fptr )
+    {
+        fclose( m_fptr );
+        m_fptr = 0;
+    }
+    if ( m_mapData )
+    {
+        platformUnmapFile( m_mapData, m_mapBytes, m_mapHandle );
+        m_mapData = 0;
+        m_mapBytes = 0;
+        m_mapHandle = 0;
+    }
+    delete[] m_buffer;  m_buffer = 0;
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Access to the number of grid columns.
+ *
+ *  \return Number of grid columns.
+ */
+
+int LandscapeGrid::cols( void ) const
+{
+    return( m_cols );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Access to the description of the last error.
+ *
+ *  \return Description of the last error, or an empty string.
+ */
+
+const QString &LandscapeGrid::error( void ) const
+{
+    return( m_error );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Access to the grid file name.
+ *
+ *  \return Grid file name.
+ */
+
+const QString &LandscapeGrid::fileName( void ) const
+{
+    return( m_fileName );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Access to the grid file format.
+ *
+ *  \return LandscapeGridFormat.
+ */
+
+int LandscapeGrid::format( void ) const
+{
+    return( m_format );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Determines a grid file's format from its name.
+ *
+ *  \param fileName Grid file name.
+ *
+ *  \return LandscapeGridBinary for *.flt files, otherwise LandscapeGridAscii.
+ */
+
+int LandscapeGrid::formatOf( const QString &fileName )
+{
+    return( fileName.lower().endsWith( ".flt" )
+        ? LandscapeGridBinary
+        : LandscapeGridAscii );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Determines if a value is the grid's no data value.
+ *
+ *  \param value Grid value.
+ *
+ *  \return TRUE if \a value is the no data value.
+ */
+
+bool LandscapeGrid::isNoData( double value ) const
+{
+    return( value == m_noData );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Access to the grid's no data value.
+ *
+ *  \return No data value.
+ */
+
+double LandscapeGrid::noData( void ) const
+{
+    return( m_noData );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Opens a grid file and reads its header, ready for readRow().
+ *
+ *  \param fileName Grid file name; *.flt files are binary, all others ASCII.
+ *
+ *  \return TRUE on success, FALSE on failure (see error()).
+ */
+
+bool LandscapeGrid::openRead( const QString &fileName )
+{
+    close();
+    m_fileName = fileName;
+    m_format = formatOf( fileName );
+    m_error = "";
+    m_row = 0;
+    if ( m_format == LandscapeGridBinary )
+    {
+        QString hdrName = LandscapeGrid_HeaderName( fileName );
+        FILE *hdr = fopen( hdrName.latin1(), "r" );
+        if ( ! hdr )
+        {
+            translate( m_error, "LandscapeGrid:OpenError", hdrName );
+            return( false );
+        }
+        bool ok = readHeader( hdr, true );
+        fclose( hdr );
+        if ( ! ok )
+        {
+            return( false );
+        }
+        m_buffer = new float[ m_cols ];
+        checkmem( __FILE__, __LINE__, m_buffer, "float m_buffer", m_cols );
+        // Map the whole file, or fall back to reading it if it cannot be
+        m_mapData = platformMapFile( fileName, &m_mapBytes, &m_mapHandle );
+        if ( m_mapData )
+        {
+            if ( m_mapBytes
+                < (unsigned long) m_rows * m_cols * sizeof(float) )
+            {
+                translate( m_error, "LandscapeGrid:ShortFile", fileName,
+                    QString::number( (int) ( m_mapBytes
+                        / ( m_cols * sizeof(float) ) ) + 1 ) );
+                close();
+                return( false );
+            }
+            return( true );
+        }
+    }
+    if ( ! ( m_fptr = fopen( fileName.latin1(), "rb" ) ) )
+    {
+        translate( m_error, "LandscapeGrid:OpenError", fileName );
+        return( false );
+    }
+    if ( m_format == LandscapeGridAscii
+      && ! readHeader( m_fptr, false ) )
+    {
+        close();
+        return( false );
+    }
+    return( true );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Creates a grid file with the same geometry, format, and no data
+ *  value as another grid, ready for writeRow().
+ *
+ *  \param fileName Grid file name.
+ *  \param like     Grid whose geometry is copied.
+ *
+ *  \return TRUE on success, FALSE on failure (see error()).
+ */
+
+bool LandscapeGrid::openWrite( const QString &fileName,
+        const LandscapeGrid &like )
+{
+    close();
+    m_fileName = fileName;
+    m_format   = formatOf( fileName );
+    m_error    = "";
+    m_row      = 0;
+    m_cols     = like.m_cols;
+    m_rows     = like.m_rows;
+    m_xll      = like.m_xll;
+    m_yll      = like.m_yll;
+    m_cellSize = like.m_cellSize;
+    m_noData   = like.m_noData;
+    m_center   = like.m_center;
+    m_swap     = false;
+    if ( m_format == LandscapeGridBinary )
+    {
+        QString hdrName = LandscapeGrid_HeaderName( fileName );
+        FILE *hdr = fopen( hdrName.latin1(), "w" );
+        if ( ! hdr )
+        {
+            translate( m_error, "LandscapeGrid:CreateError", hdrName );
+            return( false );
+        }
+        writeHeader( hdr, true );
+        fclose( hdr );
+        m_buffer = new float[ m_cols ];
+        checkmem( __FILE__, __LINE__, m_buffer, "float m_buffer", m_cols );
+    }
+    if ( ! ( m_fptr = fopen( fileName.latin1(),
+            ( m_format == LandscapeGridBinary ) ? "wb" : "w" ) ) )
+    {
+        translate( m_error, "LandscapeGrid:CreateError", fileName );
+        return( false );
+    }
+    if ( m_format == LandscapeGridAscii )
+    {
+        writeHeader( m_fptr, false );
+    }
+    return( true );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Reads a grid header.
+ *
+ *  ASCII grid headers end at the first token that is not a header key, and
+ *  the file is left positioned at that token.
+ *
+ *  \param fptr     Open header (or ASCII grid) file stream.
+ *  \param binary   TRUE if this is a binary grid's *.hdr file.
+ *
+ *  \return TRUE on success, FALSE on failure (see error()).
+ */
+
+bool LandscapeGrid::readHeader( FILE *fptr, bool binary )
+{
+    char key[64], value[64];
+    m_cols = m_rows = 0;
+    m_cellSize = 0.;
+    m_noData = -9999.;
+    m_swap = false;
+    while ( true )
+    {
+        long pos = ftell( fptr );
+        if ( fscanf( fptr, "%63s", key ) != 1 )
+        {
+            break;
+        }
+        if ( ! isalpha( (unsigned char) key[0] ) )
+        {
+            fseek( fptr, pos, SEEK_SET );
+            break;
+        }
+        if ( fscanf( fptr, "%63s", value ) != 1 )
+        {
+            break;
+        }
+        QString k = QString( key ).lower();
+        if ( k == "ncols" )
+        {
+            m_cols = atoi( value );
+        }
+        else if ( k == "nrows" )
+        {
+            m_rows = atoi( value );
+        }
+        else if ( k == "xllcorner" || k == "xllcenter" )
+        {
+            m_xll = atof( value );
+            m_center = ( k == "xllcenter" );
+        }
+        else if ( k == "yllcorner" || k == "yllcenter" )
+        {
+            m_yll = atof( value );
+        }
+        else if ( k == "cellsize" )
+        {
+            m_cellSize = atof( value );
+        }
+        else if ( k == "nodata_value" )
+        {
+            m_noData = atof( value );
+        }
+        else if ( k == "byteorder" )
+        {
+            bool lsb = ( QString( value ).upper() == "LSBFIRST" );
+            m_swap = ( lsb != LandscapeGrid_HostIsLsb() );
+        }
+    }
+    if ( m_cols < 1 || m_rows < 1 || m_cellSize <= 0. )
+    {
+        translate( m_error, "LandscapeGrid:BadHeader",
+            binary ? LandscapeGrid_HeaderName( m_fileName ) : m_fileName );
+        return( false );
+    }
+    return( true );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Reads the next row of grid values.
+ *
+ *  \param row  Array of cols() values to receive the row.
+ *
+ *  \return TRUE on success, FALSE on failure (see error()).
+ */
+
+bool LandscapeGrid::readRow( double *row )
+{
+    if ( ( ! m_fptr && ! m_mapData ) || m_row >= m_rows )
+    {
+        translate( m_error, "LandscapeGrid:ShortFile", m_fileName,
+            QString::number( m_row + 1 ) );
+        return( false );
+    }
+    int col;
+    if ( m_format == LandscapeGridBinary )
+    {
+        // Mapped rows are copied, since the map is read-only and may need
+        // byte swapping
+        if ( m_mapData )
+        {
+            memcpy( m_buffer,
+                m_mapData + (unsigned long) m_row * m_cols * sizeof(float),
+                m_cols * sizeof(float) );
+        }
+        else if ( fread( m_buffer, sizeof(float), m_cols, m_fptr )
+            != (size_t) m_cols )
+        {
+            translate( m_error, "LandscapeGrid:ShortFile", m_fileName,
+                QString::number( m_row + 1 ) );
+            return( false );
+        }
+        if ( m_swap )
+        {
+            LandscapeGrid_Swap( m_buffer, m_cols );
+        }
+        for ( col = 0;
+              col < m_cols;
+              col++ )
+        {
+            row[col] = (double) m_buffer[col];
+        }
+    }
+    else
+    {
+        for ( col = 0;
+              col < m_cols;
+              col++ )
+        {
+            if ( fscanf( m_fptr, "%lf", &row[col] ) != 1 )
+            {
+                translate( m_error, "LandscapeGrid:ShortFile", m_fileName,
+                    QString::number( m_row + 1 ) );
+                return( false );
+            }
+        }
+    }
+    m_row++;
+    return( true );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Access to the number of grid rows.
+ *
+ *  \return Number of grid rows.
+ */
+
+int LandscapeGrid::rows( void ) const
+{
+    return( m_rows );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Determines if another grid covers exactly the same cells.
+ *
+ *  \param other Another grid.
+ *
+ *  \return TRUE if both grids have the same dimensions, origin, and cell size.
+ */
+
+bool LandscapeGrid::sameGeometry( const LandscapeGrid &other ) const
+{
+    double tol = 0.001 * m_cellSize;
+    return( m_cols == other.m_cols
+         && m_rows == other.m_rows
+         && fabs( m_cellSize - other.m_cellSize ) < tol
+         && fabs( m_xll - other.m_xll ) < tol
+         && fabs( m_yll - other.m_yll ) < tol );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Writes a grid header.
+ *
+ *  \param fptr     Open header (or ASCII grid) file stream.
+ *  \param binary   TRUE if this is a binary grid's *.hdr file.
+ *
+ *  \return TRUE on success.
+ */
+
+bool LandscapeGrid::writeHeader( FILE *fptr, bool binary )
+{
+    fprintf( fptr, "ncols         %d\n", m_cols );
+    fprintf( fptr, "nrows         %d\n", m_rows );
+    fprintf( fptr, "%s     %.6f\n",
+        m_center ? "xllcenter" : "xllcorner", m_xll );
+    fprintf( fptr, "%s     %.6f\n",
+        m_center ? "yllcenter" : "yllcorner", m_yll );
+    fprintf( fptr, "cellsize      %.6f\n", m_cellSize );
+    fprintf( fptr, "NODATA_value  %g\n", m_noData );
+    if ( binary )
+    {
+        fprintf( fptr, "byteorder     %s\n",
+            LandscapeGrid_HostIsLsb() ? "LSBFIRST" : "MSBFIRST" );
+    }
+    return( true );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Writes the next row of grid values.
+ *
+ *  \param row      Array of cols() values.
+ *  \param decimals Number of decimals written to ASCII grids.
+ *
+ *  \return TRUE on success, FALSE on failure (see error()).
+ */
+
+bool LandscapeGrid::writeRow( const double *row, int decimals )
+{
+    if ( ! m_fptr || m_row >= m_rows )
+    {
+        translate( m_error, "LandscapeGrid:WriteError", m_fileName );
+        return( false );
+    }
+    int col;
+    bool ok = true;
+    if ( m_format == LandscapeGridBinary )
+    {
+        for ( col = 0;
+              col < m_cols;
+              col++ )
+        {
+            m_buffer[col] = (float) row[col];
+        }
+        ok = ( fwrite( m_buffer, sizeof(float), m_cols, m_fptr )
+            == (size_t) m_cols );
+    }
+    else
+    {
+        for ( col = 0;
+              col < m_cols;
+              col++ )
+        {
+            if ( isNoData( row[col] ) )
+            {
+                fprintf( m_fptr, "%g%c", row[col],
+                    ( col == m_cols - 1 ) ? '\n' : ' ' );
+            }
+            else
+            {
+                fprintf( m_fptr, "%.*f%c", decimals, row[col],
+                    ( col == m_cols - 1 ) ? '\n' : ' ' );
+            }
+        }
+        ok = ! ferror( m_fptr );
+    }
+    if ( ! ok )
+    {
+        translate( m_error, "LandscapeGrid:WriteError", m_fileName );
+        return( false );
+    }
+    m_row++;
+    return( true );
+}
+
+//------------------------------------------------------------------------------
+//  End of landscapegrid.cpp
+//------------------------------------------------------------------------------
+
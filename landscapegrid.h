@@ -0,0 +1,105 @@
+//------------------------------------------------------------------------------
+/*! \file landscapegrid.h
+ *  \version BehavePlus6
+ *  \author Copyright (C) 2002-2018 by Collin D. Bevins.  All rights reserved.
+ *
+ *  \brief Landscape raster grid file class definitions.
+ */
+
+#ifndef _LANDSCAPEGRID_H_
+/*! \def _LANDSCAPEGRID_H_
+ *  \brief Prevent redundant includes.
+ */
+#define _LANDSCAPEGRID_H_ 1
+
+// Qt class references
+#include <qstring.h>
+
+// Standard include files
+#include <stdio.h>
+
+//------------------------------------------------------------------------------
+/*! \enum LandscapeGridFormat
+ *  \brief Landscape grid file formats.
+ */
+
+enum LandscapeGridFormat
+{
+    LandscapeGridAscii=0,   //!< ESRI ASCII grid (.asc)
+    LandscapeGridBinary=1   //!< ESRI binary float grid (.flt with .hdr)
+};
+
+//------------------------------------------------------------------------------
+/*! \class LandscapeGrid landscapegrid.h
+ *
+ *  \brief Reads or writes one landscape raster grid file a row at a time.
+ *
+ *  Two common raster interchange formats are supported:
+ *  \arg ESRI ASCII grids (*.asc), with the ncols, nrows, xllcorner (or
+ *      xllcenter), yllcorner (or yllcenter), cellsize, and optional
+ *      NODATA_value header lines followed by the values, and
+ *  \arg ESRI binary float grids (*.flt), whose 4-byte float values are
+ *      described by the same header keys, plus byteorder, in an adjacent
+ *      *.hdr file.
+ *
+ *  Rows are read and written in file order (north to south), so a grid of
+ *  any size may be processed in a band of rows at a time.  Binary grids
+ *  being read are memory-mapped via platformMapFile() where possible.
+ */
+
+class LandscapeGrid
+{
+// Public methods
+public:
+    LandscapeGrid( void ) ;
+    ~LandscapeGrid( void ) ;
+
+    double  cellSize( void ) const ;
+    void    close( void ) ;
+    int     cols( void ) const ;
+    const QString &error( void ) const ;
+    const QString &fileName( void ) const ;
+    int     format( void ) const ;
+    bool    isNoData( double value ) const ;
+    double  noData( void ) const ;
+    bool    openRead( const QString &fileName ) ;
+    bool    openWrite( const QString &fileName, const LandscapeGrid &like ) ;
+    bool    readRow( double *row ) ;
+    int     rows( void ) const ;
+    bool    sameGeometry( const LandscapeGrid &other ) const ;
+    bool    writeRow( const double *row, int decimals ) ;
+
+    static int formatOf( const QString &fileName ) ;
+
+// Protected methods
+protected:
+    bool    readHeader( FILE *fptr, bool binary ) ;
+    bool    writeHeader( FILE *fptr, bool binary ) ;
+
+// Protected data members
+protected:
+    QString     m_fileName;     //!< Grid file name
+    QString     m_error;        //!< Description of the last error
+    FILE       *m_fptr;         //!< Open grid file stream
+    float      *m_buffer;       //!< Binary row buffer
+    const char *m_mapData;      //!< Mapped binary grid file, or 0
+    unsigned long m_mapBytes;   //!< Mapped binary grid file size
+    void       *m_mapHandle;    //!< Platform grid file mapping handle
+    int         m_format;       //!< LandscapeGridFormat
+    int         m_cols;         //!< Number of columns
+    int         m_rows;         //!< Number of rows
+    int         m_row;          //!< Next row to read or write
+    double      m_xll;          //!< Lower left x coordinate
+    double      m_yll;          //!< Lower left y coordinate
+    double      m_cellSize;     //!< Cell size (coordinate units)
+    double      m_noData;       //!< No data value
+    bool        m_center;       //!< TRUE if xll/yll are cell centers
+    bool        m_swap;         //!< TRUE if binary bytes must be swapped
+};
+
+#endif
+
+//------------------------------------------------------------------------------
+//  End of landscapegrid.h
+//------------------------------------------------------------------------------
+
@@ -0,0 +1,893 @@
+//------------------------------------------------------------------------------
+/*! \file landscaperun.cpp
+ *  \version BehavePlus6
+ *  \author Copyright (C) 2002-2018 by Collin D. Bevins.  All rights reserved.
+ *
+ *  \brief Landscape raster fire behavior run class methods.
+ */
+
+// Custom include files
+#include "appmessage.h"
+#include "appproperty.h"
+#include "apptranslator.h"
+#include "fuelmodel.h"
+#include "landscaperun.h"
+#include "xfblib.h"
+
+// Qt include files
+#include <qfileinfo.h>
+
+// Standard include files
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+//------------------------------------------------------------------------------
+/*! \brief Control file input layer keys, in LandscapeRunInput order.
+ */
+
+static const char *LandscapeRun_InputKey[LandscapeInputs] =
+{
+    "fuel", "slope", "aspect", "cover", "height", "base", "density",
+    "mois1", "mois10", "mois100", "moisHerb", "moisWood", "foliar",
+    "windSpeed", "windDir"
+};
+
+//------------------------------------------------------------------------------
+/*! \brief Control file output layer keys, in LandscapeRunOutput order.
+ */
+
+static const char *LandscapeRun_OutputKey[LandscapeOutputs] =
+{
+    "ros", "fli", "flame", "fireType"
+};
+
+//------------------------------------------------------------------------------
+/*! \brief Determines a dead fuel particle's moisture from its size class,
+ *  using the same thresholds as EqCalc::FuelMoisTimeLag().
+ *
+ *  \param savr Particle surface area-to-volume ratio (ft2/ft3).
+ *  \param m1   Dead 1-h fuel moisture (fraction).
+ *  \param m10  Dead 10-h fuel moisture (fraction).
+ *  \param m100 Dead 100-h fuel moisture (fraction).
+ *
+ *  \return Particle moisture (fraction).  Since there is no 1000-h moisture
+ *  layer, the 100-h moisture is used for particles larger than 100-h fuel.
+ */
+
+static double LandscapeRun_DeadMois( double savr, double m1, double m10,
+        double m100 )
+{
+    if ( savr > 192. )
+    {
+        return( m1 );
+    }
+    else if ( savr > 48. )
+    {
+        return( m10 );
+    }
+    return( m100 );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief LandscapeRun constructor.
+ *
+ *  \param fuelModelList Pointer to the application's FuelModelList.
+ */
+
+LandscapeRun::LandscapeRun( FuelModelList *fuelModelList ) :
+    m_fuelModelList(fuelModelList),
+    m_error(""),
+    m_cols(0),
+    m_rows(0),
+    m_bandRows(0),
+    m_tileRows(LandscapeRunTileRows),
+    m_tileCols(LandscapeRunTileCols),
+    m_hashSize(0),
+    m_threads(LandscapeRunThreads),
+    m_decimals(2),
+    m_evaluations(0),
+    m_noData(-9999.),
+    m_windLimit(appProperty()->boolean( "surfaceConfWindLimitApplied" ))
+{
+    int i;
+    for ( i = 0;
+          i < LandscapeInputs;
+          i++ )
+    {
+        m_inFile[i]  = "";
+        m_inValue[i] = 0.;
+        m_inGiven[i] = false;
+        m_inGrid[i]  = 0;
+        m_inBand[i]  = 0;
+    }
+    // Foliar moisture defaults to BehavePlus' usual 100%
+    m_inValue[LandscapeFoliar] = 100.;
+    for ( i = 0;
+          i < LandscapeOutputs;
+          i++ )
+    {
+        m_outFile[i] = "";
+        m_outGrid[i] = 0;
+        m_outBand[i] = 0;
+    }
+    memset( m_fuel, 0, sizeof(m_fuel) );
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief LandscapeRun destructor.
+ */
+
+LandscapeRun::~LandscapeRun( void )
+{
+    close();
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Access to the number of landscape cells.
+ *
+ *  \return Number of landscape cells.
+ */
+
+int LandscapeRun::cells( void ) const
+{
+    return( m_rows * m_cols );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Closes all the grids and releases the band buffers.
+ */
+
+void LandscapeRun::close( void )
+{
+    int i;
+    for ( i = 0;
+          i < LandscapeInputs;
+          i++ )
+    {
+        delete m_inGrid[i];     m_inGrid[i] = 0;
+        delete[] m_inBand[i];   m_inBand[i] = 0;
+    }
+    for ( i = 0;
+          i < LandscapeOutputs;
+          i++ )
+    {
+        delete m_outGrid[i];    m_outGrid[i] = 0;
+        delete[] m_outBand[i];  m_outBand[i] = 0;
+    }
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Runs the surface and crown fire models for one cell of the
+ *  current band and stores its outputs.
+ *
+ *  Called from the worker threads, so it may only read the inputs and fuel
+ *  parameters and write this cell's outputs.
+ *
+ *  \param cell     Cell index within the current band.
+ *  \param surface  Pointer to the calling thread's surface fire model.
+ *  \param crown    Pointer to the calling thread's crown fire model.
+ */
+
+void LandscapeRun::computeCell( int cell, Bp6SurfaceFire *surface,
+        Bp6CrownFire *crown )
+{
+    // Cells with any no data input, or an undefined fuel model, get no data
+    int layer;
+    for ( layer = 0;
+          layer < LandscapeInputs;
+          layer++ )
+    {
+        if ( m_inGrid[layer]
+          && m_inGrid[layer]->isNoData( m_inBand[layer][cell] ) )
+        {
+            break;
+        }
+    }
+    int fuel = (int) ( input( LandscapeFuel, cell ) + 0.5 );
+    if ( layer < LandscapeInputs
+      || fuel < 0
+      || fuel >= LandscapeRunMaxFuel
+      || ! m_fuel[fuel].m_valid )
+    {
+        for ( int out = 0;
+              out < LandscapeOutputs;
+              out++ )
+        {
+            m_outBand[out][cell] = m_noData;
+        }
+        return;
+    }
+    const LandscapeFuelParms *fm = &m_fuel[fuel];
+    m_outBand[LandscapeRos][cell]      = 0.;
+    m_outBand[LandscapeFli][cell]      = 0.;
+    m_outBand[LandscapeFlame][cell]    = 0.;
+    m_outBand[LandscapeFireType][cell] = 0.;
+
+    // Non-burnable fuel models have no fire
+    double loadHerb = fm->m_loadHerb;
+    if ( fm->m_load1 + fm->m_load10 + fm->m_load100 + loadHerb
+        + fm->m_loadWood < 1.0e-07 )
+    {
+        return;
+    }
+    // Fuel moistures as fractions
+    double m1     = 0.01 * input( LandscapeMois1, cell );
+    double m10    = 0.01 * input( LandscapeMois10, cell );
+    double m100   = 0.01 * input( LandscapeMois100, cell );
+    double mHerb  = 0.01 * input( LandscapeMoisHerb, cell );
+    double mWood  = 0.01 * input( LandscapeMoisWood, cell );
+
+    // Dynamic fuel models transfer cured herb load to the dead herb particle
+    double loadDeadHerb = 0.;
+    if ( fm->m_dynamic )
+    {
+        loadDeadHerb = loadHerb
+            * surface->calcHerbaceousFuelLoadCuredFraction( mHerb );
+        loadHerb -= loadDeadHerb;
+    }
+    // Fuel particles as per EqCalc::FuelBedParms()
+    int    life[6] = { 0, 0, 0, 1, 2, 0 };
+    double load[6] = { fm->m_load1, fm->m_load10, fm->m_load100,
+                       loadHerb, fm->m_loadWood, loadDeadHerb };
+    double savr[6] = { fm->m_savr1, 109., 30.,
+                       fm->m_savrHerb, fm->m_savrWood, fm->m_savrHerb };
+    double heat[6] = { fm->m_heatDead, fm->m_heatDead, fm->m_heatDead,
+                       fm->m_heatLive, fm->m_heatLive, fm->m_heatDead };
+    double dens[6] = { 32., 32., 32., 32., 32., 32. };
+    double stot[6] = { .0555, .0555, .0555, .0555, .0555, .0555 };
+    double seff[6] = { .01, .01, .01, .01, .01, .01 };
+    double mois[6];
+    int i;
+    for ( i = 0;
+          i < 6;
+          i++ )
+    {
+        mois[i] = ( life[i] == 1 ) ? mHerb
+                : ( life[i] == 2 ) ? mWood
+                : LandscapeRun_DeadMois( savr[i], m1, m10, m100 );
+    }
+    surface->setFuel( fm->m_depth, fm->m_mext, 6, life, load, savr, heat,
+        dens, stot, seff );
+    surface->setMoisture( mois );
+
+    // Wind adjustment by canopy sheltering or fuel bed depth
+    double cover  = 0.01 * input( LandscapeCover, cell );
+    double height = input( LandscapeHeight, cell );
+    double base   = input( LandscapeBase, cell );
+    double ratio  = ( height > 0. ) ? ( height - base ) / height : 0.;
+    double fraction;
+    int method;
+    double waf = FBL_WindAdjustmentFactor( cover, height, ratio, fm->m_depth,
+        &fraction, &method );
+    double wind20 = input( LandscapeWindSpeed, cell );
+
+    // Wind vector (toward) direction with respect to upslope
+    double aspect = input( LandscapeAspect, cell );
+    double windFromUpslope = fmod( input( LandscapeWindDir, cell ) - aspect
+        + 720., 360. );
+    double slope = tan( input( LandscapeSlope, cell ) * M_PI / 180. );
+    surface->setSite( slope, aspect, 88. * wind20 * waf, windFromUpslope,
+        m_windLimit );
+    m_outBand[LandscapeRos][cell]   = surface->getSpreadRateAtHead();
+    m_outBand[LandscapeFli][cell]   = surface->getFirelineIntensityAtHead();
+    m_outBand[LandscapeFlame][cell] = surface->getFlameLengthAtHead();
+
+    // Crown fire where there is a canopy
+    double density = input( LandscapeDensity, cell );
+    if ( cover > 0. && height > 0. && density > 0. )
+    {
+        double cmois[4] = { m1, m10, m100, mWood };
+        crown->setMoisture( cmois );
+        crown->setWindSpeedAt20FtFpm( 88. * wind20 );
+        crown->setCanopy( height, base, density,
+            0.01 * input( LandscapeFoliar, cell ) );
+        crown->setSurfaceFire( surface );
+        m_outBand[LandscapeRos][cell]      = crown->getFinalFireRos();
+        m_outBand[LandscapeFli][cell]      = crown->getFinalFireFli();
+        m_outBand[LandscapeFlame][cell]    = crown->getFinalFireFlame();
+        m_outBand[LandscapeFireType][cell] = crown->getFinalFireType();
+    }
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Computes every cell of one tile of the current band, evaluating
+ *  each distinct set of grid inputs only once.
+ *
+ *  \param tile     Tile index within the current band.
+ *  \param hash     Calling thread's hash table of m_hashSize cell indices.
+ *  \param surface  Pointer to the calling thread's surface fire model.
+ *  \param crown    Pointer to the calling thread's crown fire model.
+ *
+ *  \return Number of cells actually evaluated.
+ */
+
+int LandscapeRun::computeTile( int tile, int *hash, Bp6SurfaceFire *surface,
+        Bp6CrownFire *crown )
+{
+    int col0 = tile * m_tileCols;
+    int col1 = col0 + m_tileCols;
+    if ( col1 > m_cols )
+    {
+        col1 = m_cols;
+    }
+    memset( hash, 0xff, m_hashSize * sizeof(int) );
+    unsigned int mask = (unsigned int) m_hashSize - 1;
+    int evaluations = 0;
+    for ( int row = 0;
+          row < m_bandRows;
+          row++ )
+    {
+        for ( int col = col0;
+              col < col1;
+              col++ )
+        {
+            // FNV-1a hash of this cell's grid input values
+            int cell = row * m_cols + col;
+            unsigned int h = 2166136261U;
+            for ( int layer = 0;
+                  layer < LandscapeInputs;
+                  layer++ )
+            {
+                if ( m_inBand[layer] )
+                {
+                    const unsigned char *b =
+                        (const unsigned char *) &m_inBand[layer][cell];
+                    for ( unsigned int k = 0;
+                          k < sizeof(double);
+                          k++ )
+                    {
+                        h = ( h ^ b[k] ) * 16777619U;
+                    }
+                }
+            }
+            unsigned int slot = h & mask;
+            while ( hash[slot] >= 0 && ! sameInputs( hash[slot], cell ) )
+            {
+                slot = ( slot + 1 ) & mask;
+            }
+            // Reuse the outputs of an earlier cell with the same inputs
+            if ( hash[slot] >= 0 )
+            {
+                for ( int out = 0;
+                      out < LandscapeOutputs;
+                      out++ )
+                {
+                    m_outBand[out][cell] = m_outBand[out][hash[slot]];
+                }
+            }
+            else
+            {
+                hash[slot] = cell;
+                computeCell( cell, surface, crown );
+                evaluations++;
+            }
+        }
+    }
+    return( evaluations );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Access to the last error message.
+ *
+ *  \return Description of the last error, or an empty string.
+ */
+
+const QString &LandscapeRun::error( void ) const
+{
+    return( m_error );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Access to the number of cells actually evaluated by the last run().
+ *
+ *  \return Number of cells evaluated (the rest reused a neighbor's results).
+ */
+
+int LandscapeRun::evaluations( void ) const
+{
+    return( m_evaluations );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Access to a cell's input value.
+ *
+ *  \param layer    LandscapeRunInput layer.
+ *  \param cell     Cell index within the current band.
+ *
+ *  \return The layer's grid value for the cell, or its constant value.
+ */
+
+double LandscapeRun::input( int layer, int cell ) const
+{
+    return( m_inBand[layer] ? m_inBand[layer][cell] : m_inValue[layer] );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Reads a landscape run control file.
+ *
+ *  \param controlFile Name of the control file.
+ *
+ *  \return TRUE on success, FALSE on failure (see error()).
+ */
+
+bool LandscapeRun::load( const QString &controlFile )
+{
+    FILE *fptr = fopen( controlFile.latin1(), "r" );
+    if ( ! fptr )
+    {
+        translate( m_error, "LandscapeRun:OpenError", controlFile );
+        return( false );
+    }
+    QString dirName = QFileInfo( controlFile ).dirPath( true );
+    char buffer[1024];
+    int line = 0;
+    bool ok = true;
+    while ( ok && fgets( buffer, sizeof(buffer), fptr ) )
+    {
+        line++;
+        char *hash = strchr( buffer, '#' );
+        if ( hash )
+        {
+            *hash = '\0';
+        }
+        QString text = QString( buffer ).simplifyWhiteSpace();
+        if ( text.isEmpty() )
+        {
+            continue;
+        }
+        int space = text.find( ' ' );
+        QString key = ( space > 0 ) ? text.left( space ) : text;
+        QString value = ( space > 0 )
+            ? text.mid( space ).stripWhiteSpace()
+            : QString( "" );
+        if ( value.isEmpty() )
+        {
+            translate( m_error, "LandscapeRun:MissingValue", controlFile,
+                QString::number( line ), key );
+            ok = false;
+            break;
+        }
+        // Resolve relative file names
+        QString fileName = value;
+        if ( QFileInfo( value ).isRelative() )
+        {
+            fileName = dirName + "/" + value;
+        }
+        int i;
+        for ( i = 0;
+              i < LandscapeInputs;
+              i++ )
+        {
+            if ( key.lower() == QString( LandscapeRun_InputKey[i] ).lower() )
+            {
+                bool isNumber;
+                double number = value.toDouble( &isNumber );
+                m_inGiven[i] = true;
+                m_inValue[i] = isNumber ? number : 0.;
+                m_inFile[i] = isNumber ? QString( "" ) : fileName;
+                break;
+            }
+        }
+        if ( i < LandscapeInputs )
+        {
+            continue;
+        }
+        for ( i = 0;
+              i < LandscapeOutputs;
+              i++ )
+        {
+            if ( key.lower() == QString( LandscapeRun_OutputKey[i] ).lower() )
+            {
+                m_outFile[i] = fileName;
+                break;
+            }
+        }
+        if ( i < LandscapeOutputs )
+        {
+            continue;
+        }
+        if ( key.lower() == "tilerows" )
+        {
+            m_tileRows = ( value.toInt() < 1 ) ? 1 : value.toInt();
+        }
+        else if ( key.lower() == "tilecols" )
+        {
+            m_tileCols = ( value.toInt() < 1 ) ? 1 : value.toInt();
+        }
+        else if ( key.lower() == "threads" )
+        {
+            m_threads = value.toInt();
+            m_threads = ( m_threads < 1 ) ? 1 : m_threads;
+            m_threads = ( m_threads > LandscapeRunMaxThreads )
+                      ? LandscapeRunMaxThreads
+                      : m_threads;
+        }
+        else if ( key.lower() == "decimals" )
+        {
+            m_decimals = ( value.toInt() < 0 ) ? 0 : value.toInt();
+        }
+        else if ( key.lower() == "windlimit" )
+        {
+            if ( value.lower() == "true" || value.lower() == "yes"
+              || value == "1" )
+            {
+                m_windLimit = true;
+            }
+            else if ( value.lower() == "false" || value.lower() == "no"
+                   || value == "0" )
+            {
+                m_windLimit = false;
+            }
+            else
+            {
+                translate( m_error, "LandscapeRun:BadValue", controlFile,
+                    QString::number( line ), key, value );
+                ok = false;
+            }
+        }
+        else
+        {
+            translate( m_error, "LandscapeRun:UnknownKey", controlFile,
+                QString::number( line ), key );
+            ok = false;
+        }
+    }
+    fclose( fptr );
+    return( ok );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Opens all the input and output grids, allocates the band buffers,
+ *  and copies the fuel model parameters.
+ *
+ *  \return TRUE on success, FALSE on failure (see error()).
+ */
+
+bool LandscapeRun::open( void )
+{
+    // The fuel model, moisture, and wind inputs must be specified
+    int layer;
+    for ( layer = 0;
+          layer < LandscapeInputs;
+          layer++ )
+    {
+        if ( ! m_inGiven[layer]
+          && ( layer == LandscapeFuel
+            || layer == LandscapeMois1
+            || layer == LandscapeMois10
+            || layer == LandscapeMois100
+            || layer == LandscapeMoisHerb
+            || layer == LandscapeMoisWood
+            || layer == LandscapeWindSpeed ) )
+        {
+            translate( m_error, "LandscapeRun:MissingInput",
+                LandscapeRun_InputKey[layer] );
+            return( false );
+        }
+    }
+    int out;
+    for ( out = 0;
+          out < LandscapeOutputs;
+          out++ )
+    {
+        if ( ! m_outFile[out].isEmpty() )
+        {
+            break;
+        }
+    }
+    if ( out == LandscapeOutputs )
+    {
+        translate( m_error, "LandscapeRun:NoOutput" );
+        return( false );
+    }
+    // Open the input grids and check their geometry against the first one
+    LandscapeGrid *first = 0;
+    for ( layer = 0;
+          layer < LandscapeInputs;
+          layer++ )
+    {
+        if ( m_inFile[layer].isEmpty() )
+        {
+            continue;
+        }
+        m_inGrid[layer] = new LandscapeGrid();
+        checkmem( __FILE__, __LINE__, m_inGrid[layer], "LandscapeGrid grid",
+            1 );
+        if ( ! m_inGrid[layer]->openRead( m_inFile[layer] ) )
+        {
+            m_error = m_inGrid[layer]->error();
+            return( false );
+        }
+        if ( ! first )
+        {
+            first = m_inGrid[layer];
+        }
+        else if ( ! first->sameGeometry( *m_inGrid[layer] ) )
+        {
+            translate( m_error, "LandscapeRun:Geometry", m_inFile[layer],
+                first->fileName() );
+            return( false );
+        }
+    }
+    if ( ! first )
+    {
+        translate( m_error, "LandscapeRun:NoGrid" );
+        return( false );
+    }
+    m_cols   = first->cols();
+    m_rows   = first->rows();
+    m_noData = first->noData();
+    int bandCells = m_tileRows * m_cols;
+    for ( layer = 0;
+          layer < LandscapeInputs;
+          layer++ )
+    {
+        if ( m_inGrid[layer] )
+        {
+            m_inBand[layer] = new double[ bandCells ];
+            checkmem( __FILE__, __LINE__, m_inBand[layer], "double band",
+                bandCells );
+        }
+    }
+    // Create the output grids
+    for ( out = 0;
+          out < LandscapeOutputs;
+          out++ )
+    {
+        m_outBand[out] = new double[ bandCells ];
+        checkmem( __FILE__, __LINE__, m_outBand[out], "double band",
+            bandCells );
+        if ( m_outFile[out].isEmpty() )
+        {
+            continue;
+        }
+        m_outGrid[out] = new LandscapeGrid();
+        checkmem( __FILE__, __LINE__, m_outGrid[out], "LandscapeGrid grid",
+            1 );
+        if ( ! m_outGrid[out]->openWrite( m_outFile[out], *first ) )
+        {
+            m_error = m_outGrid[out]->error();
+            return( false );
+        }
+    }
+    // Each tile's hash table is at least twice the tile size
+    for ( m_hashSize = 64;
+          m_hashSize < 2 * m_tileRows * m_tileCols;
+          m_hashSize *= 2 )
+    {
+        ;
+    }
+    // Copy the fuel parameters so the worker threads avoid the FuelModels
+    memset( m_fuel, 0, sizeof(m_fuel) );
+    FuelModel *fm;
+    for ( fm = m_fuelModelList->first();
+          fm;
+          fm = m_fuelModelList->next() )
+    {
+        if ( fm->m_number < 0 || fm->m_number >= LandscapeRunMaxFuel )
+        {
+            continue;
+        }
+        LandscapeFuelParms *lf = &m_fuel[fm->m_number];
+        lf->m_valid    = true;
+        lf->m_dynamic  = fm->isDynamic();
+        lf->m_depth    = fm->m_depth;
+        lf->m_mext     = fm->m_mext;
+        lf->m_heatDead = fm->m_heatDead;
+        lf->m_heatLive = fm->m_heatLive;
+        lf->m_load1    = fm->m_load1;
+        lf->m_load10   = fm->m_load10;
+        lf->m_load100  = fm->m_load100;
+        lf->m_loadHerb = fm->m_loadHerb;
+        lf->m_loadWood = fm->m_loadWood;
+        lf->m_savr1    = fm->m_savr1;
+        lf->m_savrHerb = fm->m_savrHerb;
+        lf->m_savrWood = fm->m_savrWood;
+    }
+    return( true );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Runs the landscape a band of rows at a time, dividing each band's
+ *  tiles among the worker threads, and writes the output grids.
+ *
+ *  \return TRUE on success, FALSE on failure (see error()).
+ */
+
+bool LandscapeRun::run( void )
+{
+    m_evaluations = 0;
+    if ( ! open() )
+    {
+        close();
+        return( false );
+    }
+    int tiles = ( m_cols + m_tileCols - 1 ) / m_tileCols;
+    int threads = ( m_threads > tiles ) ? tiles : m_threads;
+    LandscapeWorker *worker = new LandscapeWorker[ threads ];
+    checkmem( __FILE__, __LINE__, worker, "LandscapeWorker worker", threads );
+    int id;
+    for ( id = 0;
+          id < threads;
+          id++ )
+    {
+        worker[id].m_hash = new int[ m_hashSize ];
+        checkmem( __FILE__, __LINE__, worker[id].m_hash, "int m_hash",
+            m_hashSize );
+    }
+    bool ok = true;
+    int layer, out, row;
+    for ( int row0 = 0;
+          ok && row0 < m_rows;
+          row0 += m_tileRows )
+    {
+        m_bandRows = ( row0 + m_tileRows > m_rows )
+                   ? m_rows - row0
+                   : m_tileRows;
+        // Read the band from each input grid
+        for ( layer = 0;
+              ok && layer < LandscapeInputs;
+              layer++ )
+        {
+            for ( row = 0;
+                  m_inGrid[layer] && row < m_bandRows;
+                  row++ )
+            {
+                if ( ! m_inGrid[layer]->readRow(
+                        m_inBand[layer] + row * m_cols ) )
+                {
+                    m_error = m_inGrid[layer]->error();
+                    ok = false;
+                    break;
+                }
+            }
+        }
+        if ( ! ok )
+        {
+            break;
+        }
+        // Compute the band's tiles, on this thread if there is only one
+        if ( threads == 1 )
+        {
+            worker[0].setRange( this, 0, tiles );
+            worker[0].run();
+        }
+        else
+        {
+            for ( id = 0;
+                  id < threads;
+                  id++ )
+            {
+                worker[id].setRange( this, ( id * tiles ) / threads,
+                    ( ( id + 1 ) * tiles ) / threads );
+                worker[id].start();
+            }
+            for ( id = 0;
+                  id < threads;
+                  id++ )
+            {
+                worker[id].wait();
+            }
+        }
+        // Write the band to each output grid
+        for ( out = 0;
+              ok && out < LandscapeOutputs;
+              out++ )
+        {
+            for ( row = 0;
+                  m_outGrid[out] && row < m_bandRows;
+                  row++ )
+            {
+                if ( ! m_outGrid[out]->writeRow(
+                        m_outBand[out] + row * m_cols,
+                        ( out == LandscapeFireType ) ? 0 : m_decimals ) )
+                {
+                    m_error = m_outGrid[out]->error();
+                    ok = false;
+                    break;
+                }
+            }
+        }
+    }
+    for ( id = 0;
+          id < threads;
+          id++ )
+    {
+        m_evaluations += worker[id].m_evaluations;
+    }
+    delete[] worker;    worker = 0;
+    close();
+    return( ok );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Determines if two cells of the current band have the same inputs.
+ *
+ *  \param cell1 Cell index within the current band.
+ *  \param cell2 Cell index within the current band.
+ *
+ *  \return TRUE if every input grid has the same value for both cells.
+ */
+
+bool LandscapeRun::sameInputs( int cell1, int cell2 ) const
+{
+    for ( int layer = 0;
+          layer < LandscapeInputs;
+          layer++ )
+    {
+        if ( m_inBand[layer]
+          && m_inBand[layer][cell1] != m_inBand[layer][cell2] )
+        {
+            return( false );
+        }
+    }
+    return( true );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief LandscapeWorker default constructor.
+ */
+
+LandscapeWorker::LandscapeWorker( void ) :
+    QThread(),
+    m_run(0),
+    m_hash(0),
+    m_first(0),
+    m_last(0),
+    m_evaluations(0)
+{
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief LandscapeWorker destructor.
+ */
+
+LandscapeWorker::~LandscapeWorker( void )
+{
+    delete[] m_hash;    m_hash = 0;
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Computes this thread's range of tiles of the current band.
+ */
+
+void LandscapeWorker::run( void )
+{
+    for ( int tile = m_first;
+          tile < m_last;
+          tile++ )
+    {
+        m_evaluations += m_run->computeTile( tile, m_hash, &m_surface,
+            &m_crown );
+    }
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Sets the range of tiles computed by this thread.
+ *
+ *  \param landscapeRun Pointer to the landscape being run.
+ *  \param first        First tile computed by this thread.
+ *  \param last         One past the last tile computed by this thread.
+ */
+
+void LandscapeWorker::setRange( LandscapeRun *landscapeRun, int first,
+        int last )
+{
+    m_run   = landscapeRun;
+    m_first = first;
+    m_last  = last;
+    return;
+}
+
+//------------------------------------------------------------------------------
+//  End of landscaperun.cpp
+//------------------------------------------------------------------------------
+
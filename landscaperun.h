@@ -0,0 +1,217 @@
+//------------------------------------------------------------------------------
+/*! \file landscaperun.h
+ *  \version BehavePlus6
+ *  \author Copyright (C) 2002-2018 by Collin D. Bevins.  All rights reserved.
+ *
+ *  \brief Landscape raster fire behavior run class definitions.
+ */
+
+#ifndef _LANDSCAPERUN_H_
+/*! \def _LANDSCAPERUN_H_
+ *  \brief Prevent redundant includes.
+ */
+#define _LANDSCAPERUN_H_ 1
+
+// Custom class references
+#include "Bp6CrownFire.h"
+#include "landscapegrid.h"
+class FuelModelList;
+
+// Qt include files
+#include <qstring.h>
+#include <qthread.h>
+
+//------------------------------------------------------------------------------
+/*! \enum LandscapeRunInput
+ *  \brief Landscape run input layers.
+ */
+
+enum LandscapeRunInput
+{
+    LandscapeFuel=0,        //!< Fuel model number
+    LandscapeSlope=1,       //!< Slope steepness (degrees)
+    LandscapeAspect=2,      //!< Aspect (degrees clockwise from north)
+    LandscapeCover=3,       //!< Canopy cover (%)
+    LandscapeHeight=4,      //!< Canopy height (ft)
+    LandscapeBase=5,        //!< Canopy base height (ft)
+    LandscapeDensity=6,     //!< Canopy bulk density (lb/ft3)
+    LandscapeMois1=7,       //!< Dead 1-h fuel moisture (%)
+    LandscapeMois10=8,      //!< Dead 10-h fuel moisture (%)
+    LandscapeMois100=9,     //!< Dead 100-h fuel moisture (%)
+    LandscapeMoisHerb=10,   //!< Live herbaceous fuel moisture (%)
+    LandscapeMoisWood=11,   //!< Live woody fuel moisture (%)
+    LandscapeFoliar=12,     //!< Canopy foliar moisture (%)
+    LandscapeWindSpeed=13,  //!< 20-ft wind speed (mi/h)
+    LandscapeWindDir=14,    //!< Wind direction (degrees from north, source)
+    LandscapeInputs=15      //!< Number of input layers
+};
+
+//------------------------------------------------------------------------------
+/*! \enum LandscapeRunOutput
+ *  \brief Landscape run output layers.
+ */
+
+enum LandscapeRunOutput
+{
+    LandscapeRos=0,         //!< Final fire spread rate (ft/min)
+    LandscapeFli=1,         //!< Final fireline intensity (Btu/ft/s)
+    LandscapeFlame=2,       //!< Final flame length (ft)
+    LandscapeFireType=3,    //!< 0=surface, 1=torching, 2=conditional, 3=crown
+    LandscapeOutputs=4      //!< Number of output layers
+};
+
+//------------------------------------------------------------------------------
+/*! \enum LandscapeRunSize
+ *  \brief LandscapeRun limits and defaults.
+ */
+
+enum LandscapeRunSize
+{
+    LandscapeRunThreads = 4,        //!< Default number of worker threads
+    LandscapeRunMaxThreads = 32,    //!< Maximum number of worker threads
+    LandscapeRunTileRows = 64,      //!< Default rows per tile (and band)
+    LandscapeRunTileCols = 256,     //!< Default columns per tile
+    LandscapeRunMaxFuel = 256       //!< One past the largest fuel model number
+};
+
+//------------------------------------------------------------------------------
+/*! \struct LandscapeFuelParms landscaperun.h
+ *
+ *  \brief Fuel model parameters copied from a FuelModel before the worker
+ *  threads start, so the threads never touch the FuelModelList's QStrings.
+ */
+
+struct LandscapeFuelParms
+{
+    bool    m_valid;        //!< TRUE if the fuel model number is defined
+    bool    m_dynamic;      //!< TRUE if herb load is transferred to dead
+    double  m_depth;        //!< Fuel bed depth (ft)
+    double  m_mext;         //!< Dead fuel extinction moisture (fraction)
+    double  m_heatDead;     //!< Dead fuel heat of combustion (Btu/lb)
+    double  m_heatLive;     //!< Live fuel heat of combustion (Btu/lb)
+    double  m_load1;        //!< Dead 1-h fuel load (lb/ft2)
+    double  m_load10;       //!< Dead 10-h fuel load (lb/ft2)
+    double  m_load100;      //!< Dead 100-h fuel load (lb/ft2)
+    double  m_loadHerb;     //!< Live herb fuel load (lb/ft2)
+    double  m_loadWood;     //!< Live wood fuel load (lb/ft2)
+    double  m_savr1;        //!< Dead 1-h surface area-to-volume ratio
+    double  m_savrHerb;     //!< Live herb surface area-to-volume ratio
+    double  m_savrWood;     //!< Live wood surface area-to-volume ratio
+};
+
+//------------------------------------------------------------------------------
+/*! \class LandscapeRun landscaperun.h
+ *
+ *  \brief Runs the surface and crown fire models for every cell of a
+ *  landscape of fuel, terrain, canopy, moisture, and wind raster grids.
+ *
+ *  run() reads a control file of "key value" lines (with '#' comments),
+ *  where each input key (fuel, slope, aspect, cover, height, base, density,
+ *  mois1, mois10, mois100, moisHerb, moisWood, foliar, windSpeed, windDir)
+ *  names either a grid file or a constant value, each output key (ros,
+ *  fli, flame, fireType) names a grid file to be written, and the optional
+ *  tileRows, tileCols, threads, and decimals keys tune the run.  The
+ *  optional windLimit key (yes or no) applies the surface fire wind speed
+ *  limit, and defaults to the surfaceConfWindLimitApplied property.
+ *  Relative file names are relative to the control file's folder.
+ *
+ *  The grids are streamed a band of tileRows rows at a time, and each band
+ *  is cut into tiles of tileCols columns that are divided among worker
+ *  threads.
+ *
+ *  Any cell that has a no data value in any input grid, or whose fuel
+ *  model number is not defined, gets the no data value in every output
+ *  grid.  All the input grids must have the same geometry, and the output
+ *  grids get that geometry and the first input grid's no data value.
+ */
+
+class LandscapeRun
+{
+// Public methods
+public:
+    LandscapeRun( FuelModelList *fuelModelList ) ;
+    ~LandscapeRun( void ) ;
+
+    int     cells( void ) const ;
+    int     evaluations( void ) const ;
+    const QString &error( void ) const ;
+    bool    load( const QString &controlFile ) ;
+    bool    run( void ) ;
+
+// Protected methods
+protected:
+    void    close( void ) ;
+    void    computeCell( int cell, Bp6SurfaceFire *surface,
+                Bp6CrownFire *crown ) ;
+    int     computeTile( int tile, int *hash, Bp6SurfaceFire *surface,
+                Bp6CrownFire *crown ) ;
+    double  input( int layer, int cell ) const ;
+    bool    open( void ) ;
+    bool    sameInputs( int cell1, int cell2 ) const ;
+
+    friend class LandscapeWorker;
+
+// Protected data members
+protected:
+    FuelModelList *m_fuelModelList;         //!< Ptr to the fuel model list
+    QString     m_error;                    //!< Description of the last error
+    QString     m_inFile[LandscapeInputs];  //!< Input grid file names
+    double      m_inValue[LandscapeInputs]; //!< Input constant values
+    bool        m_inGiven[LandscapeInputs]; //!< TRUE if input was specified
+    LandscapeGrid *m_inGrid[LandscapeInputs];   //!< Input grids (or 0)
+    double     *m_inBand[LandscapeInputs];  //!< Input grid band values (or 0)
+    QString     m_outFile[LandscapeOutputs];//!< Output grid file names
+    LandscapeGrid *m_outGrid[LandscapeOutputs]; //!< Output grids (or 0)
+    double     *m_outBand[LandscapeOutputs];//!< Output grid band values
+    LandscapeFuelParms m_fuel[LandscapeRunMaxFuel];//!< Fuel model parameters
+    int         m_cols;         //!< Number of landscape columns
+    int         m_rows;         //!< Number of landscape rows
+    int         m_bandRows;     //!< Number of rows in the current band
+    int         m_tileRows;     //!< Number of rows per tile (and band)
+    int         m_tileCols;     //!< Number of columns per tile
+    int         m_hashSize;     //!< Tile hash table size (a power of 2)
+    int         m_threads;      //!< Maximum number of worker threads
+    int         m_decimals;     //!< Decimals written to ASCII output grids
+    int         m_evaluations;  //!< Number of cells actually evaluated
+    double      m_noData;       //!< Output no data value
+    bool        m_windLimit;    //!< TRUE if the wind speed limit is applied
+};
+
+//------------------------------------------------------------------------------
+/*! \class LandscapeWorker landscaperun.h
+ *
+ *  \brief Worker thread that computes a contiguous range of the tiles of a
+ *  LandscapeRun's current band.  Used only by LandscapeRun::run().
+ */
+
+class LandscapeWorker : public QThread
+{
+// Public methods
+public:
+    LandscapeWorker( void ) ;
+    ~LandscapeWorker( void ) ;
+    void setRange( LandscapeRun *landscapeRun, int first, int last ) ;
+
+// Protected methods
+protected:
+    virtual void run( void ) ;
+
+// Protected data members
+protected:
+    LandscapeRun   *m_run;      //!< Pointer to the landscape being run
+    int            *m_hash;     //!< This thread's tile hash table
+    int             m_first;    //!< First tile computed by this thread
+    int             m_last;     //!< One past the last tile computed
+    int             m_evaluations;  //!< Cells evaluated by this thread
+    Bp6SurfaceFire  m_surface;  //!< This thread's surface fire model
+    Bp6CrownFire    m_crown;    //!< This thread's crown fire model
+
+    friend class LandscapeRun;
+};
+
+#endif
+
+//------------------------------------------------------------------------------
+//  End of landscaperun.h
+//------------------------------------------------------------------------------
+
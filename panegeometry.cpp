@@ -0,0 +1,250 @@
+//------------------------------------------------------------------------------
+/*! \file panegeometry.cpp
+ *  \version BehavePlus6
+ *  \author Copyright (C) 2002-2018 by Collin D. Bevins.  All rights reserved.
+ *
+ *  \brief Parallel diagram pane geometry class methods.
+ */
+
+// Custom include files
+#include "appmessage.h"
+#include "panegeometry.h"
+
+//------------------------------------------------------------------------------
+/*! \brief PaneGeometry default constructor.
+ */
+
+PaneGeometry::PaneGeometry( void )
+{
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief PaneGeometry virtual destructor.
+ */
+
+PaneGeometry::~PaneGeometry( void )
+{
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Computes the geometry of every pane, dividing the panes into
+ *  contiguous ranges among up to \a threads worker threads.
+ *
+ *  Returns only after all the panes have been computed.  Fewer threads
+ *  are used if there are less than #PaneGeometryMinData panes per thread,
+ *  and small diagrams are computed on the calling thread.
+ *
+ *  \param panes   Number of panes (compute() is called for 0 to panes-1).
+ *  \param threads Maximum number of worker threads.
+ */
+
+void PaneGeometry::run( int panes, int threads )
+{
+    if ( threads > panes / PaneGeometryMinData )
+    {
+        threads = panes / PaneGeometryMinData;
+    }
+    // Small diagrams aren't worth starting any threads
+    if ( threads <= 1 )
+    {
+        for ( int pane = 0;
+              pane < panes;
+              pane++ )
+        {
+            compute( pane );
+        }
+        return;
+    }
+    // Start a thread for each range of panes
+    PaneGeometryWorker *worker = new PaneGeometryWorker[ threads ];
+    checkmem( __FILE__, __LINE__, worker, "PaneGeometryWorker worker",
+        threads );
+    int id;
+    for ( id = 0;
+          id < threads;
+          id++ )
+    {
+        worker[id].setRange( this, ( id * panes ) / threads,
+            ( ( id + 1 ) * panes ) / threads );
+        worker[id].start();
+    }
+    // Wait for them all to finish
+    for ( id = 0;
+          id < threads;
+          id++ )
+    {
+        worker[id].wait();
+    }
+    delete[] worker;    worker = 0;
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief FireDiagramGeometry default constructor.
+ */
+
+FireDiagramGeometry::FireDiagramGeometry( void ) :
+    PaneGeometry(),
+    m_leng(0),
+    m_width(0),
+    m_head(0),
+    m_wind(0),
+    m_aspect(0),
+    m_maxLeng(0.),
+    m_figHt(0.),
+    m_degreesNorth(false),
+    m_degreesUpslope(false),
+    m_windDirInput(false),
+    m_windDirUpslope(false),
+    m_ellipseHt(0),
+    m_ellipseWd(0),
+    m_ellipseDy(0),
+    m_windDeg(0),
+    m_slopeDeg(0)
+{
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief FireDiagramGeometry destructor.
+ */
+
+FireDiagramGeometry::~FireDiagramGeometry( void )
+{
+    delete[] m_ellipseHt;   m_ellipseHt = 0;
+    delete[] m_ellipseWd;   m_ellipseWd = 0;
+    delete[] m_ellipseDy;   m_ellipseDy = 0;
+    delete[] m_windDeg;     m_windDeg = 0;
+    delete[] m_slopeDeg;    m_slopeDeg = 0;
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Allocates the output arrays for \a panes panes.
+ *
+ *  \param panes Number of diagram panes.
+ */
+
+void FireDiagramGeometry::allocate( int panes )
+{
+    m_ellipseHt = new double[ panes ];
+    checkmem( __FILE__, __LINE__, m_ellipseHt, "double m_ellipseHt", panes );
+    m_ellipseWd = new double[ panes ];
+    checkmem( __FILE__, __LINE__, m_ellipseWd, "double m_ellipseWd", panes );
+    m_ellipseDy = new double[ panes ];
+    checkmem( __FILE__, __LINE__, m_ellipseDy, "double m_ellipseDy", panes );
+    m_windDeg = new double[ panes ];
+    checkmem( __FILE__, __LINE__, m_windDeg, "double m_windDeg", panes );
+    m_slopeDeg = new double[ panes ];
+    checkmem( __FILE__, __LINE__, m_slopeDeg, "double m_slopeDeg", panes );
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Computes one pane's fire ellipse and vector directions.
+ *
+ *  \param pane Pane (table cell) index.
+ */
+
+void FireDiagramGeometry::compute( int pane )
+{
+    // Determine ellipse dimensions
+    m_ellipseHt[pane] = m_ellipseWd[pane] = m_ellipseDy[pane] = 0.;
+    if ( m_leng )
+    {
+        m_ellipseHt[pane] = ( m_maxLeng < 0.00001 )
+            ? 0.0
+            : 0.5 * m_figHt * m_leng[pane] / m_maxLeng;
+        m_ellipseWd[pane] = ( m_leng[pane] < 0.00001 )
+            ? 0.0
+            : m_ellipseHt[pane] * m_width[pane] / m_leng[pane];
+        m_ellipseDy[pane] = ( m_leng[pane] < 0.00001 )
+            ? 0.0
+            : m_ellipseHt[pane] * m_head[pane] / m_leng[pane];
+    }
+    // Wind flow direction vector
+    double deg = 0.;
+    if ( m_windDirInput && m_wind )
+    {
+        deg = m_wind[pane];
+    }
+    else if ( m_windDirUpslope )
+    {
+        if ( m_degreesUpslope )
+        {
+            deg = 0;
+        }
+        else if ( m_degreesNorth && m_aspect )
+        {
+            if ( ( deg = m_aspect[pane] - 180 ) < 0. )
+            {
+                deg += 360.;
+            }
+        }
+    }
+    m_windDeg[pane] = deg;
+
+    // Upslope vector
+    deg = ( m_aspect )
+          ? m_aspect[pane]
+          : 180.;
+    deg += ( deg < 180 )
+           ? 180.
+           : -180. ;
+    m_slopeDeg[pane] = deg;
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief PaneGeometryWorker default constructor.
+ */
+
+PaneGeometryWorker::PaneGeometryWorker( void ) :
+    QThread(),
+    m_geometry(0),
+    m_first(0),
+    m_last(0)
+{
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Computes the worker's range of panes.
+ *
+ *  Called by QThread::start() on the worker thread.
+ */
+
+void PaneGeometryWorker::run( void )
+{
+    for ( int pane = m_first;
+          pane < m_last;
+          pane++ )
+    {
+        m_geometry->compute( pane );
+    }
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Sets the range of panes to be computed by the worker.
+ *
+ *  \param geometry Pointer to the PaneGeometry being computed.
+ *  \param first    First pane to compute.
+ *  \param last     One past the last pane to compute.
+ */
+
+void PaneGeometryWorker::setRange( PaneGeometry *geometry, int first,
+        int last )
+{
+    m_geometry = geometry;
+    m_first = first;
+    m_last = last;
+    return;
+}
+
+//------------------------------------------------------------------------------
+//  End of panegeometry.cpp
+//------------------------------------------------------------------------------
+
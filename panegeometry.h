@@ -0,0 +1,135 @@
+//------------------------------------------------------------------------------
+/*! \file panegeometry.h
+ *  \version BehavePlus6
+ *  \author Copyright (C) 2002-2018 by Collin D. Bevins.  All rights reserved.
+ *
+ *  \brief Parallel diagram pane geometry class declarations.
+ */
+
+#ifndef _PANEGEOMETRY_H_
+/*! \def _PANEGEOMETRY_H_
+ *  \brief Prevent redundant includes.
+ */
+#define _PANEGEOMETRY_H_ 1
+
+// Qt include files
+#include <qthread.h>
+
+//------------------------------------------------------------------------------
+/*! \enum PaneGeometrySize
+ *  \brief PaneGeometry worker thread limits.
+ */
+
+enum PaneGeometrySize
+{
+    PaneGeometryThreads = 4,    //!< Maximum number of worker threads
+    PaneGeometryMinData = 16    //!< Minimum number of panes per worker thread
+};
+
+//------------------------------------------------------------------------------
+/*! \class PaneGeometry panegeometry.h
+ *
+ *  \brief Abstract base class for computing the geometry of every pane of
+ *  a multi-pane diagram in parallel worker threads.
+ *
+ *  run() divides the panes (table cells) among worker threads; the diagram
+ *  composer then writes them to the Composer on the main thread.
+ *
+ *  The derived class compute() method is called once for each pane, in no
+ *  particular order and from any thread, and must only read its inputs and
+ *  write that pane's own results.  It must not use any QPainter, QString,
+ *  property, or translator, none of which are thread safe in Qt 3.
+ */
+
+class PaneGeometry
+{
+// Public methods
+public:
+    PaneGeometry( void ) ;
+    virtual ~PaneGeometry( void ) ;
+
+    void run( int panes, int threads=PaneGeometryThreads ) ;
+
+// Protected methods
+protected:
+    virtual void compute( int pane ) = 0 ;
+
+    friend class PaneGeometryWorker;
+};
+
+//------------------------------------------------------------------------------
+/*! \class FireDiagramGeometry panegeometry.h
+ *
+ *  \brief Computes the fire ellipse dimensions and the wind and upslope
+ *  vector directions of every fire shape or fire direction diagram pane.
+ *
+ *  The caller sets the input arrays and flags, calls allocate() and run(),
+ *  and then reads each pane's results from the output arrays.  Any input
+ *  array that isn't used by the diagram may be left null.
+ */
+
+class FireDiagramGeometry : public PaneGeometry
+{
+// Public methods
+public:
+    FireDiagramGeometry( void ) ;
+    virtual ~FireDiagramGeometry( void ) ;
+    void allocate( int panes ) ;
+
+// Protected methods
+protected:
+    virtual void compute( int pane ) ;
+
+// Public data members
+public:
+    // Inputs
+    const double *m_leng;       //!< Fire length (or 0 if no ellipse)
+    const double *m_width;      //!< Fire width
+    const double *m_head;       //!< Fire distance at head
+    const double *m_wind;       //!< Wind direction (if m_windDirInput)
+    const double *m_aspect;     //!< Aspect (if m_degreesNorth)
+    double  m_maxLeng;          //!< Maximum fire length of all panes
+    double  m_figHt;            //!< Figure height (inches)
+    bool    m_degreesNorth;     //!< Directions are wrt north
+    bool    m_degreesUpslope;   //!< Directions are wrt upslope
+    bool    m_windDirInput;     //!< Wind direction is an input
+    bool    m_windDirUpslope;   //!< Wind is upslope
+    // Outputs
+    double *m_ellipseHt;        //!< Fire ellipse height (inches)
+    double *m_ellipseWd;        //!< Fire ellipse width (inches)
+    double *m_ellipseDy;        //!< Fire ellipse top above the origin (inches)
+    double *m_windDeg;          //!< Wind vector rotation (degrees)
+    double *m_slopeDeg;         //!< Upslope vector rotation (degrees)
+};
+
+//------------------------------------------------------------------------------
+/*! \class PaneGeometryWorker panegeometry.h
+ *
+ *  \brief Worker thread that computes a contiguous range of a PaneGeometry's
+ *  panes.  Used only by PaneGeometry::run().
+ */
+
+class PaneGeometryWorker : public QThread
+{
+// Public methods
+public:
+    PaneGeometryWorker( void ) ;
+    void setRange( PaneGeometry *geometry, int first, int last ) ;
+
+// Protected methods
+protected:
+    virtual void run( void ) ;
+
+// Protected data members
+protected:
+    PaneGeometry *m_geometry;   //!< Pointer to the geometry being computed
+    int m_first;                //!< First pane computed by this thread
+    int m_last;                 //!< One past the last pane computed
+};
+
+#endif
+
+//------------------------------------------------------------------------------
+//  End of panegeometry.h
+//------------------------------------------------------------------------------
+
@@ -20,7 +20,10 @@
 #include <qstring.h>
 
 // *nix include files
+#include <fcntl.h>
 #include <stdlib.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <unistd.h>
 
 //------------------------------------------------------------------------------
@@ -123,6 +126,43 @@ QString platformGetWindowsInstallPath( void )
     return( "Linux" );
 }
 
+//------------------------------------------------------------------------------
+/*! \brief Maps an entire file read-only into memory.
+ *
+ *  \param fileName Full path name of the file to map.
+ *  \param bytes    Returned file size in bytes.
+ *  \param handle   Returned handle to pass to platformUnmapFile().
+ *
+ *  \return Pointer to the mapped file contents, or 0 if the file could not
+ *  be opened or mapped, or is empty.
+ */
+
+const char *platformMapFile( const QString &fileName, unsigned long *bytes,
+        void **handle )
+{
+    *bytes = 0;
+    *handle = 0;
+    int fd = open( fileName.latin1(), O_RDONLY );
+    if ( fd < 0 )
+    {
+        return( 0 );
+    }
+    struct stat st;
+    void *data = MAP_FAILED;
+    if ( fstat( fd, &st ) == 0 && st.st_size > 0 )
+    {
+        data = mmap( 0, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+    }
+    // The mapping remains valid after the file is closed
+    close( fd );
+    if ( data == MAP_FAILED )
+    {
+        return( 0 );
+    }
+    *bytes = (unsigned long) st.st_size;
+    return( (const char *) data );
+}
+
 //------------------------------------------------------------------------------
 /*! \brief Displays the Linux version of Program WinHelp
  *
@@ -165,6 +205,23 @@ void platformShowHelpBrowserIndex( const QString & )
     return;
 }
 
+//------------------------------------------------------------------------------
+/*! \brief Unmaps a file mapped by platformMapFile().
+ *
+ *  \param data   Pointer returned by platformMapFile() (may be 0).
+ *  \param bytes  File size returned by platformMapFile().
+ *  \param handle Handle returned by platformMapFile().
+ */
+
+void platformUnmapFile( const char *data, unsigned long bytes, void * )
+{
+    if ( data )
+    {
+        munmap( (void *) data, bytes );
+    }
+    return;
+}
+
 //------------------------------------------------------------------------------
 //  End of platform-linux.cpp
 //------------------------------------------------------------------------------
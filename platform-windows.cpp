@@ -185,6 +185,53 @@ QString platformGetWindowsRegString( HKEY key, const char *subKey )
     return( s );
 }
 
+//------------------------------------------------------------------------------
+/*! \brief Maps an entire file read-only into memory.
+ *
+ *  \param fileName Full path name of the file to map.
+ *  \param bytes    Returned file size in bytes.
+ *  \param handle   Returned file mapping handle to pass to
+ *                  platformUnmapFile().
+ *
+ *  \return Pointer to the mapped file contents, or 0 if the file could not
+ *  be opened or mapped, or is empty.
+ */
+
+const char *platformMapFile( const QString &fileName, unsigned long *bytes,
+        void **handle )
+{
+    *bytes = 0;
+    *handle = 0;
+    HANDLE file = CreateFileA( fileName.latin1(), GENERIC_READ,
+        FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL );
+    if ( file == INVALID_HANDLE_VALUE )
+    {
+        return( 0 );
+    }
+    DWORD sizeHigh = 0;
+    DWORD sizeLow = GetFileSize( file, &sizeHigh );
+    HANDLE mapping = NULL;
+    if ( sizeLow != INVALID_FILE_SIZE && sizeLow > 0 && sizeHigh == 0 )
+    {
+        mapping = CreateFileMappingA( file, NULL, PAGE_READONLY, 0, 0, NULL );
+    }
+    // The mapping keeps the file open until it is closed
+    CloseHandle( file );
+    if ( mapping == NULL )
+    {
+        return( 0 );
+    }
+    void *data = MapViewOfFile( mapping, FILE_MAP_READ, 0, 0, 0 );
+    if ( ! data )
+    {
+        CloseHandle( mapping );
+        return( 0 );
+    }
+    *bytes = (unsigned long) sizeLow;
+    *handle = (void *) mapping;
+    return( (const char *) data );
+}
+
 //------------------------------------------------------------------------------
 /*! \brief Displays the Program WinHelp
  *
@@ -262,6 +309,24 @@ void platformShowHelpBrowserIndex( const QString &helpFile )
     return;
 }
 
+//------------------------------------------------------------------------------
+/*! \brief Unmaps a file mapped by platformMapFile().
+ *
+ *  \param data   Pointer returned by platformMapFile() (may be 0).
+ *  \param bytes  File size returned by platformMapFile().
+ *  \param handle File mapping handle returned by platformMapFile().
+ */
+
+void platformUnmapFile( const char *data, unsigned long, void *handle )
+{
+    if ( data )
+    {
+        UnmapViewOfFile( (LPCVOID) data );
+        CloseHandle( (HANDLE) handle );
+    }
+    return;
+}
+
 //------------------------------------------------------------------------------
 //  End of platform-windows.cpp
 //------------------------------------------------------------------------------
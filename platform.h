@@ -22,8 +22,12 @@ char   *platformGetExePath( bool withProgramName=true ) ;
 QString platformGetOs( void ) ;
 int     platformGetPid( void ) ;
 QString platformGetWindowsInstallPath( void ) ;
+const char *platformMapFile( const QString &fileName, unsigned long *bytes,
+            void **handle ) ;
 void    platformShowHelp( const QString &helpFile ) ;
 void    platformShowHelpBrowserIndex( const QString &helpFile ) ;
+void    platformUnmapFile( const char *data, unsigned long bytes,
+            void *handle ) ;
 
 #endif
 
@@ -0,0 +1,293 @@
+//------------------------------------------------------------------------------
+/*! \file solargrid.cpp
+ *  \version BehavePlus6
+ *  \author Copyright (C) 2002-2018 by Collin D. Bevins.  All rights reserved.
+ *
+ *  \brief Hourly slope-aspect solar radiation grid class methods.
+ */
+
+// Custom include files
+#include "appmessage.h"
+#include "cdtlib.h"
+#include "solargrid.h"
+#include "xfblib.h"
+
+// Standard include files
+#include <math.h>
+
+// Degrees-to-radians conversion factor (same as cdtlib.c)
+static const double SolarGridRadians = 0.0174532925199433;
+
+//------------------------------------------------------------------------------
+/*! \brief SolarGrid constructor.
+ *
+ *  Calculates the radiation fraction for each hour and each slope-aspect
+ *  combination.  The arguments are the same as for CDT_SolarRadiation().
+ *
+ *  \param gp       Reference to the GlobalPosition of the site.
+ *  \param elev     Site elevation, as passed to CDT_SolarRadiation().
+ *  \param jdate    Local Julian date-time of the first hour.
+ *  \param hours    Number of hours.
+ *  \param slope    Array of \a slopes terrain slopes in degrees.
+ *  \param slopes   Number of terrain slopes.
+ *  \param aspect   Array of \a aspects terrain aspects (downslope direction
+ *                  in degrees clockwise from north).
+ *  \param aspects  Number of terrain aspects.
+ *  \param atmTransparency     Atmospheric transparency coefficient [0.6-0.8].
+ *  \param cloudTransmittance  Cloud transmittance factor [0..1].
+ *  \param canopyTransmittance Canopy transmittance factor [0..1].
+ */
+
+SolarGrid::SolarGrid( const GlobalPosition &gp, double elev, double jdate,
+        int hours, const double *slope, int slopes, const double *aspect,
+        int aspects, double atmTransparency, double cloudTransmittance,
+        double canopyTransmittance ) :
+    m_gp(),
+    m_elev(elev),
+    m_jdate(jdate),
+    m_hours(hours),
+    m_slopes(slopes),
+    m_aspects(aspects),
+    m_atm(atmTransparency),
+    m_cloud(cloudTransmittance),
+    m_canopy(canopyTransmittance),
+    m_radiation(0)
+{
+    m_gp = gp;
+    int cells = m_hours * m_slopes * m_aspects;
+    m_radiation = new double[ cells ];
+    checkmem( __FILE__, __LINE__, m_radiation, "double m_radiation", cells );
+    calculate( slope, aspect );
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief SolarGrid destructor.
+ */
+
+SolarGrid::~SolarGrid( void )
+{
+    delete[] m_radiation;   m_radiation = 0;
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Access to the number of aspects in the grid.
+ *
+ *  \return Number of aspects in the grid.
+ */
+
+int SolarGrid::aspects( void ) const
+{
+    return( m_aspects );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Calculates the radiation fraction of every cell for every hour.
+ *
+ *  CDT_SolarRadiation() returns the sine of the solar angle to the slope,
+ *  which is the dot product of the unit vector toward the sun and the slope
+ *  normal.  Each slope-aspect cell's normal is converted to its vertical,
+ *  northerly, and easterly direction cosines just once, and each hour's sun
+ *  direction cosines and air mass attenuation just once, leaving only the
+ *  dot product for each cell and hour.
+ *
+ *  Called only by the constructor.
+ *
+ *  \param slope    Array of #m_slopes terrain slopes in degrees.
+ *  \param aspect   Array of #m_aspects terrain aspects in degrees.
+ */
+
+void SolarGrid::calculate( const double *slope, const double *aspect )
+{
+    // Direction cosines of each slope-aspect cell's normal
+    int cells = m_slopes * m_aspects;
+    double *up = new double[ 3 * cells ];
+    checkmem( __FILE__, __LINE__, up, "double up", 3 * cells );
+    double *north = up + cells;
+    double *east  = north + cells;
+    int s, a, cell;
+    for ( s = 0;
+          s < m_slopes;
+          s++ )
+    {
+        double cosSlope = cos( SolarGridRadians * slope[s] );
+        double sinSlope = sin( SolarGridRadians * slope[s] );
+        for ( a = 0;
+              a < m_aspects;
+              a++ )
+        {
+            cell = s * m_aspects + a;
+            up[cell]    = cosSlope;
+            north[cell] = sinSlope * cos( SolarGridRadians * aspect[a] );
+            east[cell]  = sinSlope * sin( SolarGridRadians * aspect[a] );
+        }
+    }
+
+    // Air mass elevation factor (from MTCLIM, as in CDT_SolarRadiation())
+    double elevFactor = exp( -0.0001467 * ( m_elev / 3.2808 ) );
+    double transmit = m_cloud * m_canopy;
+    double alt, azim;
+    for ( int hour = 0;
+          hour < m_hours;
+          hour++ )
+    {
+        double *rad = m_radiation + hour * cells;
+        // Locate the sun just once for all the cells
+        CDT_SunPosition( jdate( hour ), m_gp.longitude(), m_gp.latitude(),
+            m_gp.gmtDiff(), &alt, &azim );
+        if ( alt <= 0.0 )
+        {
+            for ( cell = 0;
+                  cell < cells;
+                  cell++ )
+            {
+                rad[cell] = 0.0;
+            }
+            continue;
+        }
+        double sinAlt = sin( SolarGridRadians * alt );
+        double cosAlt = cos( SolarGridRadians * alt );
+        double sunUp    = sinAlt;
+        double sunNorth = cosAlt * cos( SolarGridRadians * azim );
+        double sunEast  = cosAlt * sin( SolarGridRadians * azim );
+        double beam = pow( m_atm, elevFactor / sinAlt ) * transmit;
+        // Dot product of the sun and slope normal for each cell
+        for ( cell = 0;
+              cell < cells;
+              cell++ )
+        {
+            double sine = sunUp * up[cell]
+                        + sunNorth * north[cell]
+                        + sunEast * east[cell];
+            rad[cell] = ( sine < 0.0 )
+                      ? 0.0
+                      : beam * sine;
+        }
+    }
+    delete[] up;
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Determines the fuel temperature of a cell for an hour using
+ *  FBL_SurfaceFuelTemperature(), the FuelTemp algorithm.
+ *
+ *  \param hour           Hour index (0 == first hour).
+ *  \param slope          Slope index.
+ *  \param aspect         Aspect index.
+ *  \param airTemperature Air temperature at the hour (oF).
+ *
+ *  \return Fuel temperature (oF).
+ */
+
+double SolarGrid::fuelTemperature( int hour, int slope, int aspect,
+        double airTemperature ) const
+{
+    return( FBL_SurfaceFuelTemperature( airTemperature,
+        sunShade( hour, slope, aspect ) ) );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Access to all the radiation fractions of an hour.
+ *
+ *  \param hour Hour index (0 == first hour).
+ *
+ *  \return Pointer to the hour's slopes() x aspects() radiation fractions,
+ *  stored by slope and then aspect, or 0 if \a hour is out of range.
+ */
+
+const double *SolarGrid::hourGrid( int hour ) const
+{
+    if ( hour < 0 || hour >= m_hours )
+    {
+        return( 0 );
+    }
+    return( m_radiation + hour * m_slopes * m_aspects );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Access to the number of hours in the grid.
+ *
+ *  \return Number of hours in the grid.
+ */
+
+int SolarGrid::hours( void ) const
+{
+    return( m_hours );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Access to the local Julian date-time of an hour.
+ *
+ *  \param hour Hour index (0 == first hour).
+ *
+ *  \return Local Julian date-time of the hour.
+ */
+
+double SolarGrid::jdate( int hour ) const
+{
+    return( m_jdate + (double) hour / 24. );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Access to the radiation fraction of a cell for an hour.
+ *
+ *  \param hour   Hour index (0 == first hour).
+ *  \param slope  Slope index.
+ *  \param aspect Aspect index.
+ *
+ *  \return Proportion of the solar radiation constant arriving at the
+ *  forest floor [0..1], as returned by CDT_SolarRadiation().
+ */
+
+double SolarGrid::radiation( int hour, int slope, int aspect ) const
+{
+    if ( hour < 0 || hour >= m_hours
+      || slope < 0 || slope >= m_slopes
+      || aspect < 0 || aspect >= m_aspects )
+    {
+        return( 0.0 );
+    }
+    return( m_radiation[ ( hour * m_slopes + slope ) * m_aspects + aspect ] );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Access to the number of slopes in the grid.
+ *
+ *  \return Number of slopes in the grid.
+ */
+
+int SolarGrid::slopes( void ) const
+{
+    return( m_slopes );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Determines the fraction of the sun shaded from the fuel.
+ *
+ *  Fuel on a sunlit cell is shaded only by the clouds and canopy; fuel is
+ *  fully shaded when the sun is below the horizon or the slope is
+ *  self-shaded.  This is the sun shade input to FuelTemp, and a value of
+ *  0.5 or more is "Shaded" for the fine dead fuel moisture correction.
+ *
+ *  \param hour   Hour index (0 == first hour).
+ *  \param slope  Slope index.
+ *  \param aspect Aspect index.
+ *
+ *  \return Fraction of the sun shaded from the fuel [0..1].
+ */
+
+double SolarGrid::sunShade( int hour, int slope, int aspect ) const
+{
+    if ( radiation( hour, slope, aspect ) > 0.0 )
+    {
+        return( 1.0 - m_cloud * m_canopy );
+    }
+    return( 1.0 );
+}
+
+//------------------------------------------------------------------------------
+//  End of solargrid.cpp
+//------------------------------------------------------------------------------
+
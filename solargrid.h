@@ -0,0 +1,78 @@
+//------------------------------------------------------------------------------
+/*! \file solargrid.h
+ *  \version BehavePlus6
+ *  \author Copyright (C) 2002-2018 by Collin D. Bevins.  All rights reserved.
+ *
+ *  \brief Hourly slope-aspect solar radiation grid class declaration.
+ */
+
+#ifndef _SOLARGRID_H_
+/*! \def _SOLARGRID_H_
+ *  \brief Prevents redundant includes.
+ */
+#define _SOLARGRID_H_ 1
+
+// Custom include files
+#include "globalposition.h"
+
+//------------------------------------------------------------------------------
+/*! \class SolarGrid solargrid.h
+ *
+ *  \brief Holds the proportion of the solar radiation constant arriving at
+ *  the forest floor for every hour of a period and every combination of a
+ *  set of terrain slopes and aspects.
+ *
+ *  The values are the same as CDT_SolarRadiation() returns for each cell
+ *  and hour.
+ *
+ *  Each hour's values are stored contiguously by slope and then aspect,
+ *  so an hourly grid may be handed to other code with hourGrid().  The
+ *  sunShade() and fuelTemperature() methods derive the FuelTemp inputs and
+ *  results, and the shading classes used by fine dead fuel moisture, for
+ *  each cell and hour.
+ */
+
+class SolarGrid
+{
+// Public methods
+public:
+    SolarGrid( const GlobalPosition &gp, double elev, double jdate, int hours,
+        const double *slope, int slopes, const double *aspect, int aspects,
+        double atmTransparency, double cloudTransmittance,
+        double canopyTransmittance ) ;
+    ~SolarGrid( void ) ;
+
+    int     aspects( void ) const ;
+    double  fuelTemperature( int hour, int slope, int aspect,
+                double airTemperature ) const ;
+    const double *hourGrid( int hour ) const ;
+    int     hours( void ) const ;
+    double  jdate( int hour ) const ;
+    double  radiation( int hour, int slope, int aspect ) const ;
+    int     slopes( void ) const ;
+    double  sunShade( int hour, int slope, int aspect ) const ;
+
+// Protected methods
+protected:
+    void    calculate( const double *slope, const double *aspect ) ;
+
+// Protected data members
+protected:
+    GlobalPosition m_gp;        //!< Location of the grid
+    double  m_elev;             //!< Site elevation (m)
+    double  m_jdate;            //!< Local Julian date-time of the first hour
+    int     m_hours;            //!< Number of hours
+    int     m_slopes;           //!< Number of slopes
+    int     m_aspects;          //!< Number of aspects
+    double  m_atm;              //!< Atmospheric transparency coefficient
+    double  m_cloud;            //!< Cloud transmittance factor [0..1]
+    double  m_canopy;           //!< Canopy transmittance factor [0..1]
+    double *m_radiation;        //!< Radiation fraction by hour, slope, aspect
+};
+
+#endif
+
+//------------------------------------------------------------------------------
+//  End of solargrid.h
+//------------------------------------------------------------------------------
+
@@ -8,9 +8,11 @@
 
 // Custom include files
 #include "appfilesystem.h"
+#include "appgeoplaceindex.h"
 #include "appmessage.h"
 #include "apptranslator.h"
 #include "datetime.h"
+#include "geoplaceindex.h"
 #include "globalposition.h"
 #include "property.h"
 #include "sundialog.h"
@@ -24,6 +26,7 @@
 #include <qfileinfo.h>
 #include <qframe.h>
 #include <qfontmetrics.h>
+#include <qhbox.h>
 #include <qlabel.h>
 #include <qlayout.h>
 #include <qlineedit.h>
@@ -31,7 +34,7 @@
 #include <qpopupmenu.h>
 #include <qpushbutton.h>
 #include <qspinbox.h>
-#include <qtextstream.h>
+#include <qtimer.h>
 
 // Standard include files
 #include <stdio.h>
@@ -840,19 +843,40 @@ GeoPlaceDialog::GeoPlaceDialog( const QString &catalogName,
     m_place(""),
     m_state(""),
     m_type(""),
+    m_findBox(0),
+    m_findLabel(0),
+    m_findLineEdit(0),
+    m_index(0),
+    m_first(0),
+    m_count(0),
+    m_nearLat(0.),
+    m_nearLon(0.),
     m_listView(0),
     m_contextMenu(0),
     m_lvi(0)
 {
     QString text("");
-    // Open the file
-    QFile file( fileName );
-    if ( ! file.open( IO_ReadOnly ) )
+    // Find the catalog's places in the place index
+    m_index = appGeoPlaceIndex();
+    m_count = m_index->catalog( m_catalog, &m_first );
+    if ( m_count < 0 )
     {
         translate( text, "GeoPlaceDialog:NoOpen", fileName );
         error( text );
         return;
     }
+    // Add the place name search box to the mainFrame mainLayout
+    m_findBox = new QHBox( m_page->m_contentFrame, "m_findBox" );
+    Q_CHECK_PTR( m_findBox );
+    m_findBox->setSpacing( 6 );
+    translate( text, "GeoPlaceDialog:Find" );
+    m_findLabel = new QLabel( text, m_findBox, "m_findLabel" );
+    Q_CHECK_PTR( m_findLabel );
+    m_findLineEdit = new QLineEdit( m_findBox, "m_findLineEdit" );
+    Q_CHECK_PTR( m_findLineEdit );
+    connect( m_findLineEdit, SIGNAL( textChanged( const QString & ) ),
+             this,           SLOT(   findChanged( const QString & ) ) );
+
     // Add the listview to the mainFrame mainLayout
     m_listView = new QListView( m_page->m_contentFrame, "m_listView" );
     Q_CHECK_PTR( m_listView );
@@ -868,7 +892,7 @@ GeoPlaceDialog::GeoPlaceDialog( const QString &catalogName,
         "GeoPlaceDialog:Gmt"
     };
     for ( int col = 0;
-          col < 8;
+          col < GeoPlaceFields;
           col++ )
     {
         translate( text, headerKey[col] );
@@ -885,25 +909,9 @@ GeoPlaceDialog::GeoPlaceDialog( const QString &catalogName,
     connect( m_listView, SIGNAL( doubleClicked( QListViewItem * ) ),
              this,       SLOT(   doubleClicked( QListViewItem * ) ) );
 
-    QTextStream textStream( &file );
-    QString qstr, place;
-    while ( ! textStream.eof() )
-    {
-        qstr = textStream.readLine();
-        // Make a new list item for this file
-        QListViewItem *item = new QListViewItem( m_listView );
-        Q_CHECK_PTR( item );
-        item->setText( 0, qstr.mid(  93, 16 ).stripWhiteSpace() ); // state
-        item->setText( 1, qstr.mid(  61, 31 ).stripWhiteSpace() ); // county
-        item->setText( 2, qstr.mid(   0, 50 ).stripWhiteSpace() ); // place
-        item->setText( 3, qstr.mid(  51,  9 ).stripWhiteSpace() ); // type
-        item->setText( 4, qstr.mid( 117,  8 ).stripWhiteSpace() ); // lon
-        item->setText( 5, qstr.mid( 110,  7 ).stripWhiteSpace() ); // lat
-        item->setText( 6, qstr.mid( 126,  5 ).stripWhiteSpace() ); // elev
-        item->setText( 7, qstr.mid( 132,  4 ).stripWhiteSpace() ); // GMT diff
-        item->setSelectable( true );
-    }
-    file.close();
+    // Display the catalog's places
+    listCatalog();
+    m_findLineEdit->setFocus();
 
     // Allow right click to invoke the context menu
     connect(
@@ -926,6 +934,29 @@ GeoPlaceDialog::GeoPlaceDialog( const QString &catalogName,
 GeoPlaceDialog::~GeoPlaceDialog( void )
 {
     delete m_listView;      m_listView = 0;
+    delete m_findLineEdit;  m_findLineEdit = 0;
+    delete m_findLabel;     m_findLabel = 0;
+    delete m_findBox;       m_findBox = 0;
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Adds a place from the place index to the list view.
+ *
+ *  \param id Place index id.
+ */
+
+void GeoPlaceDialog::addPlace( int id )
+{
+    QListViewItem *item = new QListViewItem( m_listView );
+    Q_CHECK_PTR( item );
+    for ( int col = 0;
+          col < GeoPlaceFields;
+          col++ )
+    {
+        item->setText( col, m_index->field( id, col ) );
+    }
+    item->setSelectable( true );
     return;
 }
 
@@ -950,6 +981,16 @@ void GeoPlaceDialog::contextMenuActivated( int id )
     {
         printListView( m_listView );
     }
+    else if ( id == ContextNearby )
+    {
+        // The list is refilled after the right click has been handled,
+        // since the clicked item is deleted when the list is cleared
+        if ( GeoPlaceIndex::decode( m_lvi->text( GeoPlaceLat ),
+                m_lvi->text( GeoPlaceLon ), &m_nearLat, &m_nearLon ) )
+        {
+            QTimer::singleShot( 0, this, SLOT( listNearby() ) );
+        }
+    }
     return;
 }
 
@@ -971,6 +1012,71 @@ void GeoPlaceDialog::doubleClicked( QListViewItem *lvi )
     return;
 }
 
+//------------------------------------------------------------------------------
+/*! \brief Place name search box callback slot.
+ *
+ *  Lists every place in every catalog whose name begins with the \a text,
+ *  or the dialog's catalog if the \a text is empty.
+ */
+
+void GeoPlaceDialog::findChanged( const QString &text )
+{
+    if ( text.stripWhiteSpace().isEmpty() )
+    {
+        listCatalog();
+        return;
+    }
+    QMemArray<int> ids;
+    m_index->findName( text, ids, 500 );
+    m_listView->clear();
+    m_listView->setSorting( 2, true );    // Sort on place name ascending
+    for ( int i = 0;
+          i < (int) ids.size();
+          i++ )
+    {
+        addPlace( ids[i] );
+    }
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Lists all the places in the dialog's catalog.
+ */
+
+void GeoPlaceDialog::listCatalog( void )
+{
+    m_listView->clear();
+    m_listView->setSorting( 0, true );    // Sort on column 0 ascending
+    for ( int id = m_first;
+          id < m_first + m_count;
+          id++ )
+    {
+        addPlace( id );
+    }
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Lists the places in all catalogs nearest to the position
+ *  selected by the "Show nearby places" context menu, nearest first.
+ */
+
+void GeoPlaceDialog::listNearby( void )
+{
+    QMemArray<int> ids;
+    m_index->nearest( m_nearLat, m_nearLon, ids, 100 );
+    m_listView->clear();
+    m_listView->setSorting( -1 );         // Keep the order of distance
+    // QListView inserts each new item at the top of an unsorted list
+    for ( int i = (int) ids.size() - 1;
+          i >= 0;
+          i-- )
+    {
+        addPlace( ids[i] );
+    }
+    return;
+}
+
 //------------------------------------------------------------------------------
 /*! \brief Lists or selects the item.
  */
@@ -994,6 +1100,14 @@ void GeoPlaceDialog::rightButtonClicked( QListViewItem *lvi,
         m_contextMenu->setItemParameter( mid, ContextSelect );
     }
 
+    if ( lvi )
+    {
+        translate( text, "GeoPlaceDialog:ContextMenu:Nearby" );
+        mid = m_contextMenu->insertItem( text,
+                this, SLOT( contextMenuActivated( int ) ) );
+        m_contextMenu->setItemParameter( mid, ContextNearby );
+    }
+
     translate( text, "GeoCatalogDialog:ContextMenu:PrintVisible" );
     mid = m_contextMenu->insertItem( text,
             this, SLOT( contextMenuActivated( int ) ) );
@@ -15,11 +15,13 @@
 // Forward class references
 #include "appdialog.h"
 class DateTime;
+class GeoPlaceIndex;
 class GlobalPosition;
 class PropertyDict;
 class QCheckBox;
 class QComboBox;
 class QGridLayout;
+class QHBox;
 class QLineEdit;
 class QListView;
 class QListViewItem;
@@ -170,7 +172,8 @@ enum ContextMenuOption
 {
     ContextSelect=0,
     ContextPrintVisibleView=1,
-    ContextPrintEntireView=2
+    ContextPrintEntireView=2,
+    ContextNearby=3
 };
 
 // Public methods
@@ -179,10 +182,17 @@ public:
         QWidget *widget, const char *name="geoPlaceDialog" ) ;
     ~GeoPlaceDialog( void ) ;
 
+// Protected methods
+protected:
+    void addPlace( int id ) ;
+    void listCatalog( void ) ;
+
 // Protected slots
 protected slots:
     void contextMenuActivated( int id ) ;
     void doubleClicked( QListViewItem *lvi ) ;
+    void findChanged( const QString &text ) ;
+    void listNearby( void ) ;
     void rightButtonClicked( QListViewItem *lvi, const QPoint &p, int column ) ;
     void store( void );
 
@@ -197,6 +207,14 @@ public:
     QString         m_place;        //!< Current select place name
     QString         m_state;        //!< Current selection state/provence/country
     QString         m_type;         //!< Current select geographic feature type
+    QHBox          *m_findBox;      //!< Pointer to the name search box
+    QLabel         *m_findLabel;    //!< Pointer to the name search label
+    QLineEdit      *m_findLineEdit; //!< Pointer to the name search entry
+    GeoPlaceIndex  *m_index;        //!< Pointer to the shared place index
+    int             m_first;        //!< Id of the catalog's first place
+    int             m_count;        //!< Number of places in the catalog
+    double          m_nearLat;      //!< Latitude of nearby places list
+    double          m_nearLon;      //!< Longitude (west +) of nearby places
     QListView      *m_listView;     //!< Pointer to the selection list
     QPopupMenu     *m_contextMenu;  //!< Pointer to listview context menu
     QListViewItem  *m_lvi;          //!< Pointer to context menu listview item
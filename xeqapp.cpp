@@ -7,6 +7,8 @@
  */
 
 // Custom include files
+#include "appfuelbedcache.h"
+#include "appgeoplaceindex.h"
 #include "appmessage.h"
 #include "appproperty.h"
 #include "appsiunits.h"
@@ -107,6 +109,10 @@ EqApp::EqApp( const QString &fileName ) :
         .arg( m_translatePrime ) );
     appTranslatorCreate( m_translatePrime );
 
+    // Create the application-wide, shared fuel bed intermediate cache
+    log( "    Creating fuel bed cache ...\n" );
+    appFuelBedCacheCreate();
+
     // Create the function name lookup dictionary
     log( QString( "    Creating function dictionary with %1 slots...\n" )
         .arg( m_functionPrime ) );
@@ -263,6 +269,8 @@ EqApp::~EqApp( void )
     delete   m_languageList;        m_languageList = 0;
     delete   m_eqFileList;          m_eqFileList = 0;
     delete   m_eqTreeList;          m_eqTreeList = 0;
+    appFuelBedCacheDelete();
+    appGeoPlaceIndexDelete();
     appTranslatorDelete();
     appPropertyDelete();
     appSiUnitsDelete();
@@ -30,6 +30,8 @@
 
 // Custom include files
 #include "Bp6Globals.h"
+#include "Bp6Dual.h"
+#include "appfuelbedcache.h"
 #include "appmessage.h"
 #include "appproperty.h"
 #include "appsiunits.h"
@@ -44,11 +46,13 @@
 #include "property.h"
 #include "xeqcalc.h"
 #include "xeqvar.h"
+#include "xeqtrace.h"
 #include "xeqtree.h"
 #include "xfblib.h"
 
 #include "Algorithms/Fofem6BarkThickness.h"
 #include "Algorithms/Fofem6Mortality.h"
+#include "Algorithms/Fofem6Species.h"
 #include "SemFireCrownFirebrandProcessor.h"
 
 // Qt include files
@@ -60,7 +64,6 @@
 #include <math.h>
 
 static const int MaxParts = 10;
-static char Margin[] = { "        " };
 
 //------------------------------------------------------------------------------
 /*! \brief Convenience routine to get a pointer to the FuelModel
@@ -334,93 +337,32 @@ void EqCalc::ContainFF( void )
 		vContainYMax->update( sim->m_yMax );
 
 		// Log results
-		if( m_log )
+		if( EQTRACE_ON( m_trace ) )
 		{
 			int outputs = 14 + sim->m_left->m_step + 1;
-			fprintf( m_log, "%sbegin proc ContainFF() 5 %d\n", Margin, outputs );
-			fprintf( m_log, "%s  i vContainReportSpread %g %d %s\n", Margin,
-				vContainReportSpread->m_displayValue,
-				vContainReportSpread->m_displayDecimals,
-				vContainReportSpread->m_displayUnits.latin1() );
-			fprintf( m_log, "%s  i vContainReportSize %g %d %s\n", Margin,
-				vContainReportSize->m_displayValue,
-				vContainReportSize->m_displayDecimals,
-				vContainReportSize->m_displayUnits.latin1() );
-			fprintf( m_log, "%s  i vContainReportRatio %g %d %s\n", Margin,
-				vContainReportRatio->m_displayValue,
-				vContainReportRatio->m_displayDecimals,
-				vContainReportRatio->m_displayUnits.latin1() );
-			fprintf( m_log, "%s  i vContainAttackTactic %d %d %s\n", Margin,
-				vContainAttackTactic->activeItemDataIndex(),
-				0,
-				vContainAttackTactic->activeItemName().latin1() );
-			fprintf( m_log, "%s  i vContainAttackDist %g %d %s\n", Margin,
-				vContainAttackDist->m_displayValue,
-				vContainAttackDist->m_displayDecimals,
-				vContainAttackDist->m_displayUnits.latin1() );
-
-			fprintf( m_log, "%s  o vContainAttackSize %g %d %s\n", Margin,
-				vContainAttackSize->m_displayValue,
-				vContainAttackSize->m_displayDecimals,
-				vContainAttackSize->m_displayUnits.latin1() );
-			fprintf( m_log, "%s  o vContainAttackPerimeter %g %d %s\n", Margin,
-				vContainAttackPerimeter->m_displayValue,
-				vContainAttackPerimeter->m_displayDecimals,
-				vContainAttackPerimeter->m_displayUnits.latin1() );
-			fprintf( m_log, "%s  o vContainStatus %d %d %s\n", Margin,
-				vContainStatus->activeItemDataIndex(),
-				0,
-				vContainStatus->activeItemName().latin1() );
-			fprintf( m_log, "%s  o vContainTime %g %d %s\n", Margin,
-				vContainTime->m_displayValue,
-				vContainTime->m_displayDecimals,
-				vContainTime->m_displayUnits.latin1() );
-			fprintf( m_log, "%s  o vContainSize %g %d %s\n", Margin,
-				vContainSize->m_displayValue,
-				vContainSize->m_displayDecimals,
-				vContainSize->m_displayUnits.latin1() );
-			fprintf( m_log, "%s  o vContainLine %g %d %s\n", Margin,
-				vContainLine->m_displayValue,
-				vContainLine->m_displayDecimals,
-				vContainLine->m_displayUnits.latin1() );
-			fprintf( m_log, "%s  o vContainResourcesUsed %g %d ratio\n", Margin,
-				vContainResourcesUsed->m_displayValue,
-				vContainResourcesUsed->m_displayDecimals );
-			fprintf( m_log, "%s  o vContainCost %g %d %s\n", Margin,
-				vContainCost->m_displayValue,
-				vContainCost->m_displayDecimals,
-				vContainCost->m_displayUnits.latin1() );
-			fprintf( m_log, "%s  o vContainAttackBack %g %d %s\n", Margin,
-				vContainAttackBack->m_displayValue,
-				vContainAttackBack->m_displayDecimals,
-				vContainAttackBack->m_displayUnits.latin1() );
-			fprintf( m_log, "%s  o vContainAttackHead %g %d %s\n", Margin,
-				vContainAttackHead->m_displayValue,
-				vContainAttackHead->m_displayDecimals,
-				vContainAttackHead->m_displayUnits.latin1() );
-			fprintf( m_log, "%s  o vContainReportBack %g %d %s\n", Margin,
-				vContainReportBack->m_displayValue,
-				vContainReportBack->m_displayDecimals,
-				vContainReportBack->m_displayUnits.latin1() );
-			fprintf( m_log, "%s  o vContainReportHead %g %d %s\n", Margin,
-				vContainReportHead->m_displayValue,
-				vContainReportHead->m_displayDecimals,
-				vContainReportHead->m_displayUnits.latin1() );
-			fprintf( m_log, "%s  o vContainXMin %g %d %s\n", Margin,
-				vContainXMin->m_displayValue,
-				vContainXMin->m_displayDecimals,
-				vContainXMin->m_displayUnits.latin1() );
-			fprintf( m_log, "%s  o vContainXMax %g %d %s\n", Margin,
-				vContainXMax->m_displayValue,
-				vContainXMax->m_displayDecimals,
-				vContainXMax->m_displayUnits.latin1() );
-			fprintf( m_log, "%s  o vContainYMax %g %d %s\n", Margin,
-				vContainYMax->m_displayValue,
-				vContainYMax->m_displayDecimals,
-				vContainYMax->m_displayUnits.latin1() );
-			fprintf( m_log, "%s  o vContainPoints %g %d ratio\n", Margin,
-				vContainPoints->m_displayValue,
-				vContainPoints->m_displayDecimals );
+			m_trace->proc( "ContainFF", 5, outputs );
+			m_trace->display( 'i', vContainReportSpread );
+			m_trace->display( 'i', vContainReportSize );
+			m_trace->display( 'i', vContainReportRatio );
+			m_trace->itemZero( 'i', vContainAttackTactic );
+			m_trace->display( 'i', vContainAttackDist );
+
+			m_trace->display( 'o', vContainAttackSize );
+			m_trace->display( 'o', vContainAttackPerimeter );
+			m_trace->itemZero( 'o', vContainStatus );
+			m_trace->display( 'o', vContainTime );
+			m_trace->display( 'o', vContainSize );
+			m_trace->display( 'o', vContainLine );
+			m_trace->ratio( 'o', vContainResourcesUsed );
+			m_trace->display( 'o', vContainCost );
+			m_trace->display( 'o', vContainAttackBack );
+			m_trace->display( 'o', vContainAttackHead );
+			m_trace->display( 'o', vContainReportBack );
+			m_trace->display( 'o', vContainReportHead );
+			m_trace->display( 'o', vContainXMin );
+			m_trace->display( 'o', vContainXMax );
+			m_trace->display( 'o', vContainYMax );
+			m_trace->ratio( 'o', vContainPoints );
 			// The coordinates need to be converted from chains to display units
 			double factor, offset;
 			appSiUnits()->conversionFactorOffset( vContainXMax->m_nativeUnits,
@@ -429,8 +371,7 @@ void EqCalc::ContainFF( void )
 				  pt <= sim->m_left->m_step;
 				  pt++ )
 			{
-				fprintf( m_log, " %s      %f %f\n", Margin,
-					offset + factor * sim->m_x[pt],
+				m_trace->point( offset + factor * sim->m_x[pt],
 					offset + factor * sim->m_y[pt] );
 			}
 		}
@@ -523,93 +464,32 @@ void EqCalc::ContainFF( void )
 		vContainYMax->update( sim->m_yMax );
 
 		// Log results
-		if( m_log )
+		if( EQTRACE_ON( m_trace ) )
 		{
 			int outputs = 14 + sim->m_left->m_step + 1;
-			fprintf( m_log, "%sbegin proc ContainFF() 5 %d\n", Margin, outputs );
-			fprintf( m_log, "%s  i vContainReportSpread %g %d %s\n", Margin,
-				vContainReportSpread->m_displayValue,
-				vContainReportSpread->m_displayDecimals,
-				vContainReportSpread->m_displayUnits.latin1() );
-			fprintf( m_log, "%s  i vContainReportSize %g %d %s\n", Margin,
-				vContainReportSize->m_displayValue,
-				vContainReportSize->m_displayDecimals,
-				vContainReportSize->m_displayUnits.latin1() );
-			fprintf( m_log, "%s  i vContainReportRatio %g %d %s\n", Margin,
-				vContainReportRatio->m_displayValue,
-				vContainReportRatio->m_displayDecimals,
-				vContainReportRatio->m_displayUnits.latin1() );
-			fprintf( m_log, "%s  i vContainAttackTactic %d %d %s\n", Margin,
-				vContainAttackTactic->activeItemDataIndex(),
-				0,
-				vContainAttackTactic->activeItemName().latin1() );
-			fprintf( m_log, "%s  i vContainAttackDist %g %d %s\n", Margin,
-				vContainAttackDist->m_displayValue,
-				vContainAttackDist->m_displayDecimals,
-				vContainAttackDist->m_displayUnits.latin1() );
-
-			fprintf( m_log, "%s  o vContainAttackSize %g %d %s\n", Margin,
-				vContainAttackSize->m_displayValue,
-				vContainAttackSize->m_displayDecimals,
-				vContainAttackSize->m_displayUnits.latin1() );
-			fprintf( m_log, "%s  o vContainAttackPerimeter %g %d %s\n", Margin,
-				vContainAttackPerimeter->m_displayValue,
-				vContainAttackPerimeter->m_displayDecimals,
-				vContainAttackPerimeter->m_displayUnits.latin1() );
-			fprintf( m_log, "%s  o vContainStatus %d %d %s\n", Margin,
-				vContainStatus->activeItemDataIndex(),
-				0,
-				vContainStatus->activeItemName().latin1() );
-			fprintf( m_log, "%s  o vContainTime %g %d %s\n", Margin,
-				vContainTime->m_displayValue,
-				vContainTime->m_displayDecimals,
-				vContainTime->m_displayUnits.latin1() );
-			fprintf( m_log, "%s  o vContainSize %g %d %s\n", Margin,
-				vContainSize->m_displayValue,
-				vContainSize->m_displayDecimals,
-				vContainSize->m_displayUnits.latin1() );
-			fprintf( m_log, "%s  o vContainLine %g %d %s\n", Margin,
-				vContainLine->m_displayValue,
-				vContainLine->m_displayDecimals,
-				vContainLine->m_displayUnits.latin1() );
-			fprintf( m_log, "%s  o vContainResourcesUsed %g %d ratio\n", Margin,
-				vContainResourcesUsed->m_displayValue,
-				vContainResourcesUsed->m_displayDecimals );
-			fprintf( m_log, "%s  o vContainCost %g %d %s\n", Margin,
-				vContainCost->m_displayValue,
-				vContainCost->m_displayDecimals,
-				vContainCost->m_displayUnits.latin1() );
-			fprintf( m_log, "%s  o vContainAttackBack %g %d %s\n", Margin,
-				vContainAttackBack->m_displayValue,
-				vContainAttackBack->m_displayDecimals,
-				vContainAttackBack->m_displayUnits.latin1() );
-			fprintf( m_log, "%s  o vContainAttackHead %g %d %s\n", Margin,
-				vContainAttackHead->m_displayValue,
-				vContainAttackHead->m_displayDecimals,
-				vContainAttackHead->m_displayUnits.latin1() );
-			fprintf( m_log, "%s  o vContainReportBack %g %d %s\n", Margin,
-				vContainReportBack->m_displayValue,
-				vContainReportBack->m_displayDecimals,
-				vContainReportBack->m_displayUnits.latin1() );
-			fprintf( m_log, "%s  o vContainReportHead %g %d %s\n", Margin,
-				vContainReportHead->m_displayValue,
-				vContainReportHead->m_displayDecimals,
-				vContainReportHead->m_displayUnits.latin1() );
-			fprintf( m_log, "%s  o vContainXMin %g %d %s\n", Margin,
-				vContainXMin->m_displayValue,
-				vContainXMin->m_displayDecimals,
-				vContainXMin->m_displayUnits.latin1() );
-			fprintf( m_log, "%s  o vContainXMax %g %d %s\n", Margin,
-				vContainXMax->m_displayValue,
-				vContainXMax->m_displayDecimals,
-				vContainXMax->m_displayUnits.latin1() );
-			fprintf( m_log, "%s  o vContainYMax %g %d %s\n", Margin,
-				vContainYMax->m_displayValue,
-				vContainYMax->m_displayDecimals,
-				vContainYMax->m_displayUnits.latin1() );
-			fprintf( m_log, "%s  o vContainPoints %g %d ratio\n", Margin,
-				vContainPoints->m_displayValue,
-				vContainPoints->m_displayDecimals );
+			m_trace->proc( "ContainFF", 5, outputs );
+			m_trace->display( 'i', vContainReportSpread );
+			m_trace->display( 'i', vContainReportSize );
+			m_trace->display( 'i', vContainReportRatio );
+			m_trace->itemZero( 'i', vContainAttackTactic );
+			m_trace->display( 'i', vContainAttackDist );
+
+			m_trace->display( 'o', vContainAttackSize );
+			m_trace->display( 'o', vContainAttackPerimeter );
+			m_trace->itemZero( 'o', vContainStatus );
+			m_trace->display( 'o', vContainTime );
+			m_trace->display( 'o', vContainSize );
+			m_trace->display( 'o', vContainLine );
+			m_trace->ratio( 'o', vContainResourcesUsed );
+			m_trace->display( 'o', vContainCost );
+			m_trace->display( 'o', vContainAttackBack );
+			m_trace->display( 'o', vContainAttackHead );
+			m_trace->display( 'o', vContainReportBack );
+			m_trace->display( 'o', vContainReportHead );
+			m_trace->display( 'o', vContainXMin );
+			m_trace->display( 'o', vContainXMax );
+			m_trace->display( 'o', vContainYMax );
+			m_trace->ratio( 'o', vContainPoints );
 			// The coordinates need to be converted from chains to display units
 			double factor, offset;
 			appSiUnits()->conversionFactorOffset( vContainXMax->m_nativeUnits,
@@ -618,8 +498,7 @@ void EqCalc::ContainFF( void )
 				  pt <= sim->m_left->m_step;
 				  pt++ )
 			{
-				fprintf( m_log, " %s      %f %f\n", Margin,
-					offset + factor * sim->m_x[pt],
+				m_trace->point( offset + factor * sim->m_x[pt],
 					offset + factor * sim->m_y[pt] );
 			}
 		}
@@ -647,15 +526,11 @@ void EqCalc::ContainFFReportRatio( void )
     // Store results
     vContainReportRatio->update( ratio );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc ContainFFReportRatio() 1 1\n", Margin );
-        fprintf( m_log, "%s  i vSurfaceFireArea %g %s\n", Margin,
-            vSurfaceFireLengthToWidth->m_nativeValue,
-            vSurfaceFireLengthToWidth->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vContainReportRatio %g %s\n", Margin,
-            vContainReportRatio->m_nativeValue,
-            vContainReportRatio->m_nativeUnits.latin1() );
+        m_trace->proc( "ContainFFReportRatio", 1, 1 );
+        m_trace->var( 'i', vSurfaceFireLengthToWidth, "vSurfaceFireArea" );
+        m_trace->var( 'o', vContainReportRatio );
     }
     return;
 }
@@ -677,15 +552,11 @@ void EqCalc::ContainFFReportSize( void )
     // Store results
     vContainReportSize->update( acres );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc ContainFFReportSize() 1 1\n", Margin );
-        fprintf( m_log, "%s  i vSurfaceFireArea %g %s\n", Margin,
-            vSurfaceFireArea->m_nativeValue,
-            vSurfaceFireArea->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vContainReportSize %g %s\n", Margin,
-            vContainReportSize->m_nativeValue,
-            vContainReportSize->m_nativeUnits.latin1() );
+        m_trace->proc( "ContainFFReportSize", 1, 1 );
+        m_trace->var( 'i', vSurfaceFireArea );
+        m_trace->var( 'o', vContainReportSize );
     }
     return;
 }
@@ -708,15 +579,11 @@ void EqCalc::ContainFFReportSpread( void )
     // Store results
     vContainReportSpread->update( fpm * 60. / 66. );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc ContainFFReportSpread() 1 1\n", Margin );
-        fprintf( m_log, "%s  i vSurfaceFireSpreadAtHead %g %s\n", Margin,
-            vSurfaceFireSpreadAtHead->m_nativeValue,
-            vSurfaceFireSpreadAtHead->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vContainReportSpread %g %s\n", Margin,
-            vContainReportSpread->m_nativeValue,
-            vContainReportSpread->m_nativeUnits.latin1() );
+        m_trace->proc( "ContainFFReportSpread", 1, 1 );
+        m_trace->var( 'i', vSurfaceFireSpreadAtHead );
+        m_trace->var( 'o', vContainReportSpread );
     }
     return;
 }
@@ -874,93 +741,32 @@ void EqCalc::ContainFFSingle( void )
 		vContainYMax->update( sim->m_yMax );
 
 		// Log results
-		if( m_log )
+		if( EQTRACE_ON( m_trace ) )
 		{
 			int outputs = 14 + sim->m_left->m_step + 1;
-			fprintf( m_log, "%sbegin proc ContainFF() 5 %d\n", Margin, outputs );
-			fprintf( m_log, "%s  i vContainReportSpread %g %d %s\n", Margin,
-				vContainReportSpread->m_displayValue,
-				vContainReportSpread->m_displayDecimals,
-				vContainReportSpread->m_displayUnits.latin1() );
-			fprintf( m_log, "%s  i vContainReportSize %g %d %s\n", Margin,
-				vContainReportSize->m_displayValue,
-				vContainReportSize->m_displayDecimals,
-				vContainReportSize->m_displayUnits.latin1() );
-			fprintf( m_log, "%s  i vContainReportRatio %g %d %s\n", Margin,
-				vContainReportRatio->m_displayValue,
-				vContainReportRatio->m_displayDecimals,
-				vContainReportRatio->m_displayUnits.latin1() );
-			fprintf( m_log, "%s  i vContainAttackTactic %d %d %s\n", Margin,
-				vContainAttackTactic->activeItemDataIndex(),
-				0,
-				vContainAttackTactic->activeItemName().latin1() );
-			fprintf( m_log, "%s  i vContainAttackDist %g %d %s\n", Margin,
-				vContainAttackDist->m_displayValue,
-				vContainAttackDist->m_displayDecimals,
-				vContainAttackDist->m_displayUnits.latin1() );
-
-			fprintf( m_log, "%s  o vContainAttackSize %g %d %s\n", Margin,
-				vContainAttackSize->m_displayValue,
-				vContainAttackSize->m_displayDecimals,
-				vContainAttackSize->m_displayUnits.latin1() );
-			fprintf( m_log, "%s  o vContainAttackPerimeter %g %d %s\n", Margin,
-				vContainAttackPerimeter->m_displayValue,
-				vContainAttackPerimeter->m_displayDecimals,
-				vContainAttackPerimeter->m_displayUnits.latin1() );
-			fprintf( m_log, "%s  o vContainStatus %d %d %s\n", Margin,
-				vContainStatus->activeItemDataIndex(),
-				0,
-				vContainStatus->activeItemName().latin1() );
-			fprintf( m_log, "%s  o vContainTime %g %d %s\n", Margin,
-				vContainTime->m_displayValue,
-				vContainTime->m_displayDecimals,
-				vContainTime->m_displayUnits.latin1() );
-			fprintf( m_log, "%s  o vContainSize %g %d %s\n", Margin,
-				vContainSize->m_displayValue,
-				vContainSize->m_displayDecimals,
-				vContainSize->m_displayUnits.latin1() );
-			fprintf( m_log, "%s  o vContainLine %g %d %s\n", Margin,
-				vContainLine->m_displayValue,
-				vContainLine->m_displayDecimals,
-				vContainLine->m_displayUnits.latin1() );
-			fprintf( m_log, "%s  o vContainResourcesUsed %g %d ratio\n", Margin,
-				vContainResourcesUsed->m_displayValue,
-				vContainResourcesUsed->m_displayDecimals );
-			fprintf( m_log, "%s  o vContainCost %g %d %s\n", Margin,
-				vContainCost->m_displayValue,
-				vContainCost->m_displayDecimals,
-				vContainCost->m_displayUnits.latin1() );
-			fprintf( m_log, "%s  o vContainAttackBack %g %d %s\n", Margin,
-				vContainAttackBack->m_displayValue,
-				vContainAttackBack->m_displayDecimals,
-				vContainAttackBack->m_displayUnits.latin1() );
-			fprintf( m_log, "%s  o vContainAttackHead %g %d %s\n", Margin,
-				vContainAttackHead->m_displayValue,
-				vContainAttackHead->m_displayDecimals,
-				vContainAttackHead->m_displayUnits.latin1() );
-			fprintf( m_log, "%s  o vContainReportBack %g %d %s\n", Margin,
-				vContainReportBack->m_displayValue,
-				vContainReportBack->m_displayDecimals,
-				vContainReportBack->m_displayUnits.latin1() );
-			fprintf( m_log, "%s  o vContainReportHead %g %d %s\n", Margin,
-				vContainReportHead->m_displayValue,
-				vContainReportHead->m_displayDecimals,
-				vContainReportHead->m_displayUnits.latin1() );
-			fprintf( m_log, "%s  o vContainXMin %g %d %s\n", Margin,
-				vContainXMin->m_displayValue,
-				vContainXMin->m_displayDecimals,
-				vContainXMin->m_displayUnits.latin1() );
-			fprintf( m_log, "%s  o vContainXMax %g %d %s\n", Margin,
-				vContainXMax->m_displayValue,
-				vContainXMax->m_displayDecimals,
-				vContainXMax->m_displayUnits.latin1() );
-			fprintf( m_log, "%s  o vContainYMax %g %d %s\n", Margin,
-				vContainYMax->m_displayValue,
-				vContainYMax->m_displayDecimals,
-				vContainYMax->m_displayUnits.latin1() );
-			fprintf( m_log, "%s  o vContainPoints %g %d ratio\n", Margin,
-				vContainPoints->m_displayValue,
-				vContainPoints->m_displayDecimals );
+			m_trace->proc( "ContainFF", 5, outputs );
+			m_trace->display( 'i', vContainReportSpread );
+			m_trace->display( 'i', vContainReportSize );
+			m_trace->display( 'i', vContainReportRatio );
+			m_trace->itemZero( 'i', vContainAttackTactic );
+			m_trace->display( 'i', vContainAttackDist );
+
+			m_trace->display( 'o', vContainAttackSize );
+			m_trace->display( 'o', vContainAttackPerimeter );
+			m_trace->itemZero( 'o', vContainStatus );
+			m_trace->display( 'o', vContainTime );
+			m_trace->display( 'o', vContainSize );
+			m_trace->display( 'o', vContainLine );
+			m_trace->ratio( 'o', vContainResourcesUsed );
+			m_trace->display( 'o', vContainCost );
+			m_trace->display( 'o', vContainAttackBack );
+			m_trace->display( 'o', vContainAttackHead );
+			m_trace->display( 'o', vContainReportBack );
+			m_trace->display( 'o', vContainReportHead );
+			m_trace->display( 'o', vContainXMin );
+			m_trace->display( 'o', vContainXMax );
+			m_trace->display( 'o', vContainYMax );
+			m_trace->ratio( 'o', vContainPoints );
 			// The coordinates need to be converted from chains to display units
 			double factor, offset;
 			appSiUnits()->conversionFactorOffset( vContainXMax->m_nativeUnits,
@@ -969,8 +775,7 @@ void EqCalc::ContainFFSingle( void )
 				  pt <= sim->m_left->m_step;
 				  pt++ )
 			{
-				fprintf( m_log, " %s      %f %f\n", Margin,
-					offset + factor * sim->m_x[pt],
+				m_trace->point( offset + factor * sim->m_x[pt],
 					offset + factor * sim->m_y[pt] );
 			}
 		}
@@ -1051,93 +856,32 @@ void EqCalc::ContainFFSingle( void )
 		vContainYMax->update( sim->m_yMax );
 
 		// Log results
-		if( m_log )
+		if( EQTRACE_ON( m_trace ) )
 		{
 			int outputs = 14 + sim->m_left->m_step + 1;
-			fprintf( m_log, "%sbegin proc ContainFF() 5 %d\n", Margin, outputs );
-			fprintf( m_log, "%s  i vContainReportSpread %g %d %s\n", Margin,
-				vContainReportSpread->m_displayValue,
-				vContainReportSpread->m_displayDecimals,
-				vContainReportSpread->m_displayUnits.latin1() );
-			fprintf( m_log, "%s  i vContainReportSize %g %d %s\n", Margin,
-				vContainReportSize->m_displayValue,
-				vContainReportSize->m_displayDecimals,
-				vContainReportSize->m_displayUnits.latin1() );
-			fprintf( m_log, "%s  i vContainReportRatio %g %d %s\n", Margin,
-				vContainReportRatio->m_displayValue,
-				vContainReportRatio->m_displayDecimals,
-				vContainReportRatio->m_displayUnits.latin1() );
-			fprintf( m_log, "%s  i vContainAttackTactic %d %d %s\n", Margin,
-				vContainAttackTactic->activeItemDataIndex(),
-				0,
-				vContainAttackTactic->activeItemName().latin1() );
-			fprintf( m_log, "%s  i vContainAttackDist %g %d %s\n", Margin,
-				vContainAttackDist->m_displayValue,
-				vContainAttackDist->m_displayDecimals,
-				vContainAttackDist->m_displayUnits.latin1() );
-
-			fprintf( m_log, "%s  o vContainAttackSize %g %d %s\n", Margin,
-				vContainAttackSize->m_displayValue,
-				vContainAttackSize->m_displayDecimals,
-				vContainAttackSize->m_displayUnits.latin1() );
-			fprintf( m_log, "%s  o vContainAttackPerimeter %g %d %s\n", Margin,
-				vContainAttackPerimeter->m_displayValue,
-				vContainAttackPerimeter->m_displayDecimals,
-				vContainAttackPerimeter->m_displayUnits.latin1() );
-			fprintf( m_log, "%s  o vContainStatus %d %d %s\n", Margin,
-				vContainStatus->activeItemDataIndex(),
-				0,
-				vContainStatus->activeItemName().latin1() );
-			fprintf( m_log, "%s  o vContainTime %g %d %s\n", Margin,
-				vContainTime->m_displayValue,
-				vContainTime->m_displayDecimals,
-				vContainTime->m_displayUnits.latin1() );
-			fprintf( m_log, "%s  o vContainSize %g %d %s\n", Margin,
-				vContainSize->m_displayValue,
-				vContainSize->m_displayDecimals,
-				vContainSize->m_displayUnits.latin1() );
-			fprintf( m_log, "%s  o vContainLine %g %d %s\n", Margin,
-				vContainLine->m_displayValue,
-				vContainLine->m_displayDecimals,
-				vContainLine->m_displayUnits.latin1() );
-			fprintf( m_log, "%s  o vContainResourcesUsed %g %d ratio\n", Margin,
-				vContainResourcesUsed->m_displayValue,
-				vContainResourcesUsed->m_displayDecimals );
-			fprintf( m_log, "%s  o vContainCost %g %d %s\n", Margin,
-				vContainCost->m_displayValue,
-				vContainCost->m_displayDecimals,
-				vContainCost->m_displayUnits.latin1() );
-			fprintf( m_log, "%s  o vContainAttackBack %g %d %s\n", Margin,
-				vContainAttackBack->m_displayValue,
-				vContainAttackBack->m_displayDecimals,
-				vContainAttackBack->m_displayUnits.latin1() );
-			fprintf( m_log, "%s  o vContainAttackHead %g %d %s\n", Margin,
-				vContainAttackHead->m_displayValue,
-				vContainAttackHead->m_displayDecimals,
-				vContainAttackHead->m_displayUnits.latin1() );
-			fprintf( m_log, "%s  o vContainReportBack %g %d %s\n", Margin,
-				vContainReportBack->m_displayValue,
-				vContainReportBack->m_displayDecimals,
-				vContainReportBack->m_displayUnits.latin1() );
-			fprintf( m_log, "%s  o vContainReportHead %g %d %s\n", Margin,
-				vContainReportHead->m_displayValue,
-				vContainReportHead->m_displayDecimals,
-				vContainReportHead->m_displayUnits.latin1() );
-			fprintf( m_log, "%s  o vContainXMin %g %d %s\n", Margin,
-				vContainXMin->m_displayValue,
-				vContainXMin->m_displayDecimals,
-				vContainXMin->m_displayUnits.latin1() );
-			fprintf( m_log, "%s  o vContainXMax %g %d %s\n", Margin,
-				vContainXMax->m_displayValue,
-				vContainXMax->m_displayDecimals,
-				vContainXMax->m_displayUnits.latin1() );
-			fprintf( m_log, "%s  o vContainYMax %g %d %s\n", Margin,
-				vContainYMax->m_displayValue,
-				vContainYMax->m_displayDecimals,
-				vContainYMax->m_displayUnits.latin1() );
-			fprintf( m_log, "%s  o vContainPoints %g %d ratio\n", Margin,
-				vContainPoints->m_displayValue,
-				vContainPoints->m_displayDecimals );
+			m_trace->proc( "ContainFF", 5, outputs );
+			m_trace->display( 'i', vContainReportSpread );
+			m_trace->display( 'i', vContainReportSize );
+			m_trace->display( 'i', vContainReportRatio );
+			m_trace->itemZero( 'i', vContainAttackTactic );
+			m_trace->display( 'i', vContainAttackDist );
+
+			m_trace->display( 'o', vContainAttackSize );
+			m_trace->display( 'o', vContainAttackPerimeter );
+			m_trace->itemZero( 'o', vContainStatus );
+			m_trace->display( 'o', vContainTime );
+			m_trace->display( 'o', vContainSize );
+			m_trace->display( 'o', vContainLine );
+			m_trace->ratio( 'o', vContainResourcesUsed );
+			m_trace->display( 'o', vContainCost );
+			m_trace->display( 'o', vContainAttackBack );
+			m_trace->display( 'o', vContainAttackHead );
+			m_trace->display( 'o', vContainReportBack );
+			m_trace->display( 'o', vContainReportHead );
+			m_trace->display( 'o', vContainXMin );
+			m_trace->display( 'o', vContainXMax );
+			m_trace->display( 'o', vContainYMax );
+			m_trace->ratio( 'o', vContainPoints );
 			// The coordinates need to be converted from chains to display units
 			double factor, offset;
 			appSiUnits()->conversionFactorOffset( vContainXMax->m_nativeUnits,
@@ -1146,8 +890,7 @@ void EqCalc::ContainFFSingle( void )
 				  pt <= sim->m_left->m_step;
 				  pt++ )
 			{
-				fprintf( m_log, " %s      %f %f\n", Margin,
-					offset + factor * sim->m_x[pt],
+				m_trace->point( offset + factor * sim->m_x[pt],
 					offset + factor * sim->m_y[pt] );
 			}
 		}
@@ -1179,18 +922,12 @@ void EqCalc::FireArea( void )
     // Store results
     vSurfaceFireArea->update( acres );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc FireArea() 2 1\n", Margin );
-        fprintf( m_log, "%s  i vSurfaceFireLengDist %g %s\n", Margin,
-            vSurfaceFireLengDist->m_nativeValue,
-            vSurfaceFireLengDist->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFireWidthDist %g %s\n", Margin,
-            vSurfaceFireWidthDist->m_nativeValue,
-            vSurfaceFireWidthDist->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFireArea %g %s\n", Margin,
-            vSurfaceFireArea->m_nativeValue,
-            vSurfaceFireArea->m_nativeUnits.latin1() );
+        m_trace->proc( "FireArea", 2, 1 );
+        m_trace->var( 'i', vSurfaceFireLengDist );
+        m_trace->var( 'i', vSurfaceFireWidthDist );
+        m_trace->var( 'o', vSurfaceFireArea );
     }
     return;
 }
@@ -1216,30 +953,23 @@ void EqCalc::FireCharacteristicsDiagram( void )
     vSurfaceFireCharacteristicsDiagram->update( x );
 
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc FireCharacteristicsDiagram() 3 1\n", Margin );
+        m_trace->proc( "FireCharacteristicsDiagram", 3, 1 );
         //fprintf( stderr, "%sbegin proc FireCharacteristicsDiagram() 3 1\n", Margin );
-        fprintf( m_log, "%s  i vSurfaceFireSpreadAtHead %g %s\n", Margin,
-            vSurfaceFireSpreadAtHead->m_nativeValue,
-            vSurfaceFireSpreadAtHead->m_nativeUnits.latin1() );
+        m_trace->var( 'i', vSurfaceFireSpreadAtHead );
         //fprintf( stderr, "%s  i vSurfaceFireSpreadAtHead %g %s\n", Margin,
         //      vSurfaceFireSpreadAtHead->m_nativeValue,
         //    vSurfaceFireSpreadAtHead->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFireSpreadAtVector %g %s\n", Margin,
-            vSurfaceFireSpreadAtVector->m_nativeValue,
-               vSurfaceFireSpreadAtVector->m_nativeUnits.latin1() );
+        m_trace->var( 'i', vSurfaceFireSpreadAtVector );
         //fprintf( stderr, "%s  i vSurfaceFireSpreadAtVector %g %s\n", Margin,
         //      vSurfaceFireSpreadAtVector->m_nativeValue,
         //    vSurfaceFireSpreadAtVector->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFireHeatPerUnitArea %g %s\n", Margin,
-            vSurfaceFireHeatPerUnitArea->m_nativeValue,
-            vSurfaceFireHeatPerUnitArea->m_nativeUnits.latin1() );
+        m_trace->var( 'i', vSurfaceFireHeatPerUnitArea );
         //fprintf( stderr, "%s  i vSurfaceFireHeatPerUnitArea %g %s\n", Margin,
         //      vSurfaceFireHeatPerUnitArea->m_nativeValue,
         //    vSurfaceFireHeatPerUnitArea->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFireCharacteristicsDiagram %g\n", Margin,
-            vSurfaceFireCharacteristicsDiagram->m_nativeValue );
+        m_trace->varValue( 'o', vSurfaceFireCharacteristicsDiagram );
         //fprintf( stderr, "%s  o vSurfaceFireCharacteristicsDiagram %g\n", Margin,
         //    vSurfaceFireCharacteristicsDiagram->m_nativeValue );
     }
@@ -1267,18 +997,12 @@ void EqCalc::FireDistAtBack( void )
     // Store results
     vSurfaceFireDistAtBack->update( dist );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc FireDistAtBack() 2 1\n", Margin );
-        fprintf( m_log, "%s  i vSurfaceFireSpreadAtBack %g %s\n", Margin,
-            vSurfaceFireSpreadAtBack->m_nativeValue,
-            vSurfaceFireSpreadAtBack->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFireElapsedTime %g %s\n", Margin,
-            vSurfaceFireElapsedTime->m_nativeValue,
-            vSurfaceFireElapsedTime->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFireDistAtBack %g %s\n", Margin,
-            vSurfaceFireDistAtBack->m_nativeValue,
-            vSurfaceFireDistAtBack->m_nativeUnits.latin1() );
+        m_trace->proc( "FireDistAtBack", 2, 1 );
+        m_trace->var( 'i', vSurfaceFireSpreadAtBack );
+        m_trace->var( 'i', vSurfaceFireElapsedTime );
+        m_trace->var( 'o', vSurfaceFireDistAtBack );
     }
     return;
 }
@@ -1303,18 +1027,12 @@ void EqCalc::FireDistAtBeta( void )
     // Store results
     vSurfaceFireDistAtBeta->update( dist );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc FireDistAtBeta() 2 1\n", Margin );
-        fprintf( m_log, "%s  i vSurfaceFireSpreadAtBeta %g %s\n", Margin,
-            vSurfaceFireSpreadAtBeta->m_nativeValue,
-            vSurfaceFireSpreadAtBeta->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFireElapsedTime %g %s\n", Margin,
-            vSurfaceFireElapsedTime->m_nativeValue,
-            vSurfaceFireElapsedTime->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFireDistAtBeta %g %s\n", Margin,
-            vSurfaceFireDistAtBeta->m_nativeValue,
-            vSurfaceFireDistAtBeta->m_nativeUnits.latin1() );
+        m_trace->proc( "FireDistAtBeta", 2, 1 );
+        m_trace->var( 'i', vSurfaceFireSpreadAtBeta );
+        m_trace->var( 'i', vSurfaceFireElapsedTime );
+        m_trace->var( 'o', vSurfaceFireDistAtBeta );
     }
     return;
 }
@@ -1340,18 +1058,12 @@ void EqCalc::FireDistAtFlank( void )
     // Store results
     vSurfaceFireDistAtFlank->update( dist );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc FireDistAtFlank() 2 1\n", Margin );
-        fprintf( m_log, "%s  i vSurfaceFireSpreadAtFlank %g %s\n", Margin,
-            vSurfaceFireSpreadAtFlank->m_nativeValue,
-            vSurfaceFireSpreadAtFlank->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFireElapsedTime %g %s\n", Margin,
-            vSurfaceFireElapsedTime->m_nativeValue,
-            vSurfaceFireElapsedTime->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFireDistAtFlank %g %s\n", Margin,
-            vSurfaceFireDistAtFlank->m_nativeValue,
-            vSurfaceFireDistAtFlank->m_nativeUnits.latin1() );
+        m_trace->proc( "FireDistAtFlank", 2, 1 );
+        m_trace->var( 'i', vSurfaceFireSpreadAtFlank );
+        m_trace->var( 'i', vSurfaceFireElapsedTime );
+        m_trace->var( 'o', vSurfaceFireDistAtFlank );
     }
     return;
 }
@@ -1377,18 +1089,12 @@ void EqCalc::FireDistAtHead( void )
     // Store results
     vSurfaceFireDistAtHead->update( dist );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc FireDistAtHead() 2 1\n", Margin );
-        fprintf( m_log, "%s  i vSurfaceFireSpreadAtHead %g %s\n", Margin,
-            vSurfaceFireSpreadAtHead->m_nativeValue,
-            vSurfaceFireSpreadAtHead->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFireElapsedTime %g %s\n", Margin,
-            vSurfaceFireElapsedTime->m_nativeValue,
-            vSurfaceFireElapsedTime->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFireDistAtHead %g %s\n", Margin,
-            vSurfaceFireDistAtHead->m_nativeValue,
-            vSurfaceFireDistAtHead->m_nativeUnits.latin1() );
+        m_trace->proc( "FireDistAtHead", 2, 1 );
+        m_trace->var( 'i', vSurfaceFireSpreadAtHead );
+        m_trace->var( 'i', vSurfaceFireElapsedTime );
+        m_trace->var( 'o', vSurfaceFireDistAtHead );
     }
     return;
 }
@@ -1414,18 +1120,12 @@ void EqCalc::FireDistAtPsi( void )
     // Store results
     vSurfaceFireDistAtPsi->update( dist );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc FireDistAtPsi() 2 1\n", Margin );
-        fprintf( m_log, "%s  i vSurfaceFireSpreadAtPsi %g %s\n", Margin,
-            vSurfaceFireSpreadAtPsi->m_nativeValue,
-            vSurfaceFireSpreadAtPsi->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFireElapsedTime %g %s\n", Margin,
-            vSurfaceFireElapsedTime->m_nativeValue,
-            vSurfaceFireElapsedTime->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFireDistAtPsi %g %s\n", Margin,
-            vSurfaceFireDistAtPsi->m_nativeValue,
-            vSurfaceFireDistAtPsi->m_nativeUnits.latin1() );
+        m_trace->proc( "FireDistAtPsi", 2, 1 );
+        m_trace->var( 'i', vSurfaceFireSpreadAtPsi );
+        m_trace->var( 'i', vSurfaceFireElapsedTime );
+        m_trace->var( 'o', vSurfaceFireDistAtPsi );
     }
     return;
 }
@@ -1451,18 +1151,12 @@ void EqCalc::FireDistAtVector( void )
     // Store results
     vSurfaceFireDistAtVector->update( dist );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc FireDistAtVector() 2 1\n", Margin );
-        fprintf( m_log, "%s  i vSurfaceFireSpreadAtVector %g %s\n", Margin,
-            vSurfaceFireSpreadAtVector->m_nativeValue,
-            vSurfaceFireSpreadAtVector->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFireElapsedTime %g %s\n", Margin,
-            vSurfaceFireElapsedTime->m_nativeValue,
-            vSurfaceFireElapsedTime->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFireDistAtVector %g %s\n", Margin,
-            vSurfaceFireDistAtVector->m_nativeValue,
-            vSurfaceFireDistAtVector->m_nativeUnits.latin1() );
+        m_trace->proc( "FireDistAtVector", 2, 1 );
+        m_trace->var( 'i', vSurfaceFireSpreadAtVector );
+        m_trace->var( 'i', vSurfaceFireElapsedTime );
+        m_trace->var( 'o', vSurfaceFireDistAtVector );
     }
     return;
 }
@@ -1486,15 +1180,11 @@ void EqCalc::FireEccentricity ( void )
     // Store results
     vSurfaceFireEccentricity->update( ec );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc FireEccentricity() 1 1\n", Margin );
-        fprintf( m_log, "%s  i vSurfaceFireLengthToWidth %g %s\n", Margin,
-            vSurfaceFireLengthToWidth->m_nativeValue,
-            vSurfaceFireLengthToWidth->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFireEccentricity %g %s\n", Margin,
-            vSurfaceFireEccentricity->m_nativeValue,
-            vSurfaceFireEccentricity->m_nativeUnits.latin1() );
+        m_trace->proc( "FireEccentricity", 1, 1 );
+        m_trace->var( 'i', vSurfaceFireLengthToWidth );
+        m_trace->var( 'o', vSurfaceFireEccentricity );
     }
     return;
 }
@@ -1518,15 +1208,11 @@ void EqCalc::FireEllipseF ( void )
     // Store results
     vSurfaceFireEllipseF->update( f );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc FireEllipseF() 1 1\n", Margin );
-        fprintf( m_log, "%s  i vSurfaceFireLengDist %g %s\n", Margin,
-            vSurfaceFireLengDist->m_nativeValue,
-            vSurfaceFireLengDist->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFireEllipseF %g %s\n", Margin,
-            vSurfaceFireEllipseF->m_nativeValue,
-            vSurfaceFireEllipseF->m_nativeUnits.latin1() );
+        m_trace->proc( "FireEllipseF", 1, 1 );
+        m_trace->var( 'i', vSurfaceFireLengDist );
+        m_trace->var( 'o', vSurfaceFireEllipseF );
     }
     return;
 }
@@ -1552,18 +1238,12 @@ void EqCalc::FireEllipseG ( void )
     // Store results
     vSurfaceFireEllipseG->update( g );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc FireEllipseG() 2 1\n", Margin );
-        fprintf( m_log, "%s  i vSurfaceFireLengDist %g %s\n", Margin,
-            vSurfaceFireLengDist->m_nativeValue,
-            vSurfaceFireLengDist->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFireDistAtBack %g %s\n", Margin,
-            vSurfaceFireDistAtBack->m_nativeValue,
-            vSurfaceFireDistAtBack->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFireEllipseG %g %s\n", Margin,
-            vSurfaceFireEllipseG->m_nativeValue,
-            vSurfaceFireEllipseG->m_nativeUnits.latin1() );
+        m_trace->proc( "FireEllipseG", 2, 1 );
+        m_trace->var( 'i', vSurfaceFireLengDist );
+        m_trace->var( 'i', vSurfaceFireDistAtBack );
+        m_trace->var( 'o', vSurfaceFireEllipseG );
     }
     return;
 }
@@ -1587,15 +1267,11 @@ void EqCalc::FireEllipseH ( void )
     // Store results
     vSurfaceFireEllipseH->update( h );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc FireEllipseH() 1 1\n", Margin );
-        fprintf( m_log, "%s  i vSurfaceFireWidthDist %g %s\n", Margin,
-            vSurfaceFireWidthDist->m_nativeValue,
-            vSurfaceFireWidthDist->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFireEllipseH %g %s\n", Margin,
-            vSurfaceFireEllipseH->m_nativeValue,
-            vSurfaceFireEllipseH->m_nativeUnits.latin1() );
+        m_trace->proc( "FireEllipseH", 1, 1 );
+        m_trace->var( 'i', vSurfaceFireWidthDist );
+        m_trace->var( 'o', vSurfaceFireEllipseH );
     }
     return;
 }
@@ -1626,18 +1302,12 @@ void EqCalc::FireEffWindAtVector( void )
     // Store results
     vSurfaceFireEffWindAtVector->update( effWind );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc FireEffWindAtVector() 2 1\n", Margin );
-        fprintf( m_log, "%s  i vSurfaceFireNoWindRate %g %s\n", Margin,
-            vSurfaceFireNoWindRate->m_nativeValue,
-            vSurfaceFireNoWindRate->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFireSpreadAtVector %g %s\n", Margin,
-            vSurfaceFireSpreadAtVector->m_nativeValue,
-            vSurfaceFireSpreadAtVector->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFireEffWindAtVector %g %s\n", Margin,
-            vSurfaceFireEffWindAtVector->m_nativeValue,
-            vSurfaceFireEffWindAtVector->m_nativeUnits.latin1() );
+        m_trace->proc( "FireEffWindAtVector", 2, 1 );
+        m_trace->var( 'i', vSurfaceFireNoWindRate );
+        m_trace->var( 'i', vSurfaceFireSpreadAtVector );
+        m_trace->var( 'o', vSurfaceFireEffWindAtVector );
     }
     return;
 }
@@ -1662,18 +1332,12 @@ void EqCalc::FireFlameHtAtVector( void )
     // Store results
     vSurfaceFireFlameHtAtVector->update( fh );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc FireFlameHtAtVector() 2 1\n", Margin );
-        fprintf( m_log, "%s  i vSurfaceFireFlameLengAtVector %g %s\n", Margin,
-            vSurfaceFireFlameLengAtVector->m_nativeValue,
-            vSurfaceFireFlameLengAtVector->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFireFlameAngleAtVector %g %s\n", Margin,
-            vSurfaceFireFlameAngleAtVector->m_nativeValue,
-            vSurfaceFireFlameAngleAtVector->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFireFlameHtAtVector %g %s\n", Margin,
-            vSurfaceFireFlameHtAtVector->m_nativeValue,
-            vSurfaceFireFlameHtAtVector->m_nativeUnits.latin1() );
+        m_trace->proc( "FireFlameHtAtVector", 2, 1 );
+        m_trace->var( 'i', vSurfaceFireFlameLengAtVector );
+        m_trace->var( 'i', vSurfaceFireFlameAngleAtVector );
+        m_trace->var( 'o', vSurfaceFireFlameHtAtVector );
     }
     return;
 }
@@ -1697,15 +1361,11 @@ void EqCalc::FireFlameLengAtBeta( void )
     // Store results
     vSurfaceFireFlameLengAtBeta->update( fl );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc FireFlameLengAtBeta() 1 1\n", Margin );
-        fprintf( m_log, "%s  i vSurfaceFireLineIntAtBeta %g %s\n", Margin,
-            vSurfaceFireLineIntAtBeta->m_nativeValue,
-            vSurfaceFireLineIntAtBeta->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFireFlameLengAtBeta %g %s\n", Margin,
-            vSurfaceFireFlameLengAtBeta->m_nativeValue,
-            vSurfaceFireFlameLengAtBeta->m_nativeUnits.latin1() );
+        m_trace->proc( "FireFlameLengAtBeta", 1, 1 );
+        m_trace->var( 'i', vSurfaceFireLineIntAtBeta );
+        m_trace->var( 'o', vSurfaceFireFlameLengAtBeta );
     }
     return;
 }
@@ -1729,15 +1389,11 @@ void EqCalc::FireFlameLengAtHead( void )
     // Store results
     vSurfaceFireFlameLengAtHead->update( fl );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc FireFlameLengAtHead() 1 1\n", Margin );
-        fprintf( m_log, "%s  i vSurfaceFireLineIntAtHead %g %s\n", Margin,
-            vSurfaceFireLineIntAtHead->m_nativeValue,
-            vSurfaceFireLineIntAtHead->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFireFlameLengAtHead %g %s\n", Margin,
-            vSurfaceFireFlameLengAtHead->m_nativeValue,
-            vSurfaceFireFlameLengAtHead->m_nativeUnits.latin1() );
+        m_trace->proc( "FireFlameLengAtHead", 1, 1 );
+        m_trace->var( 'i', vSurfaceFireLineIntAtHead );
+        m_trace->var( 'o', vSurfaceFireFlameLengAtHead );
     }
     return;
 }
@@ -1761,15 +1417,11 @@ void EqCalc::FireFlameLengAtPsi( void )
     // Store results
     vSurfaceFireFlameLengAtPsi->update( fl );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc FireFlameLengAtPsi() 1 1\n", Margin );
-        fprintf( m_log, "%s  i vSurfaceFireLineIntAtPsi %g %s\n", Margin,
-            vSurfaceFireLineIntAtPsi->m_nativeValue,
-            vSurfaceFireLineIntAtPsi->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFireFlameLengAtPsi %g %s\n", Margin,
-            vSurfaceFireFlameLengAtPsi->m_nativeValue,
-            vSurfaceFireFlameLengAtPsi->m_nativeUnits.latin1() );
+        m_trace->proc( "FireFlameLengAtPsi", 1, 1 );
+        m_trace->var( 'i', vSurfaceFireLineIntAtPsi );
+        m_trace->var( 'o', vSurfaceFireFlameLengAtPsi );
     }
     return;
 }
@@ -1793,15 +1445,11 @@ void EqCalc::FireFlameLengAtVector( void )
     // Store results
     vSurfaceFireFlameLengAtVector->update( fl );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc FireFlameLengAtVector() 1 1\n", Margin );
-        fprintf( m_log, "%s  i vSurfaceFireLineIntAtVector %g %s\n", Margin,
-            vSurfaceFireLineIntAtVector->m_nativeValue,
-            vSurfaceFireLineIntAtVector->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFireFlameLengAtVector %g %s\n", Margin,
-            vSurfaceFireFlameLengAtVector->m_nativeValue,
-            vSurfaceFireFlameLengAtVector->m_nativeUnits.latin1() );
+        m_trace->proc( "FireFlameLengAtVector", 1, 1 );
+        m_trace->var( 'i', vSurfaceFireLineIntAtVector );
+        m_trace->var( 'o', vSurfaceFireFlameLengAtVector );
     }
     return;
 }
@@ -1827,18 +1475,12 @@ void EqCalc::FireHeatPerUnitArea( void )
     // Store results
     vSurfaceFireHeatPerUnitArea->update( hpua );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc FireHeatPerUnitArea() 2 1\n", Margin );
-        fprintf( m_log, "%s  i vSurfaceFireReactionInt %g %s\n", Margin,
-            vSurfaceFireReactionInt->m_nativeValue,
-            vSurfaceFireReactionInt->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFireResidenceTime %g %s\n", Margin,
-            vSurfaceFireResidenceTime->m_nativeValue,
-            vSurfaceFireResidenceTime->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFireHeatPerUnitArea %g %s\n", Margin,
-            vSurfaceFireHeatPerUnitArea->m_nativeValue,
-            vSurfaceFireHeatPerUnitArea->m_nativeUnits.latin1() );
+        m_trace->proc( "FireHeatPerUnitArea", 2, 1 );
+        m_trace->var( 'i', vSurfaceFireReactionInt );
+        m_trace->var( 'i', vSurfaceFireResidenceTime );
+        m_trace->var( 'o', vSurfaceFireHeatPerUnitArea );
     }
     return;
 }
@@ -1864,18 +1506,12 @@ void EqCalc::FireHeatSource( void )
     // Store results
     vSurfaceFireHeatSource->update( source );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc FireHeatSource() 2 1\n", Margin );
-        fprintf( m_log, "%s  i vSurfaceFireSpreadAtHead %g %s\n", Margin,
-            vSurfaceFireSpreadAtHead->m_nativeValue,
-            vSurfaceFireSpreadAtHead->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFuelBedHeatSink %g %s\n", Margin,
-            vSurfaceFuelBedHeatSink->m_nativeValue,
-            vSurfaceFuelBedHeatSink->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFireHeatSource %g %s\n", Margin,
-            vSurfaceFireHeatSource->m_nativeValue,
-            vSurfaceFireHeatSource->m_nativeUnits.latin1() );
+        m_trace->proc( "FireHeatSource", 2, 1 );
+        m_trace->var( 'i', vSurfaceFireSpreadAtHead );
+        m_trace->var( 'i', vSurfaceFuelBedHeatSink );
+        m_trace->var( 'o', vSurfaceFireHeatSource );
     }
     return;
 }
@@ -1901,18 +1537,12 @@ void EqCalc::FireLengDist( void )
     // Store results
     vSurfaceFireLengDist->update( ld );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc FireLengDist() 2 1\n", Margin );
-        fprintf( m_log, "%s  i vSurfaceFireDistAtBack %g %s\n", Margin,
-            vSurfaceFireDistAtBack->m_nativeValue,
-            vSurfaceFireDistAtBack->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFireDistAtHead %g %s\n", Margin,
-            vSurfaceFireDistAtHead->m_nativeValue,
-            vSurfaceFireDistAtHead->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFireLengDist %g %s\n", Margin,
-            vSurfaceFireLengDist->m_nativeValue,
-            vSurfaceFireLengDist->m_nativeUnits.latin1() );
+        m_trace->proc( "FireLengDist", 2, 1 );
+        m_trace->var( 'i', vSurfaceFireDistAtBack );
+        m_trace->var( 'i', vSurfaceFireDistAtHead );
+        m_trace->var( 'o', vSurfaceFireLengDist );
     }
     return;
 }
@@ -1938,18 +1568,12 @@ void EqCalc::FireLengMapDist( void )
     // Store results
     vSurfaceFireLengMapDist->update( md );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc FireLengMapDist() 2 1\n", Margin );
-        fprintf( m_log, "%s  i vSurfaceFireLengDist %g %s\n", Margin,
-            vSurfaceFireLengDist->m_nativeValue,
-            vSurfaceFireLengDist->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vMapScale %g %s\n", Margin,
-            vMapScale->m_nativeValue,
-            vMapScale->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFireLengMapDist %g %s\n", Margin,
-            vSurfaceFireLengMapDist->m_nativeValue,
-            vSurfaceFireLengMapDist->m_nativeUnits.latin1() );
+        m_trace->proc( "FireLengMapDist", 2, 1 );
+        m_trace->var( 'i', vSurfaceFireLengDist );
+        m_trace->var( 'i', vMapScale );
+        m_trace->var( 'o', vSurfaceFireLengMapDist );
     }
     return;
 }
@@ -1973,15 +1597,11 @@ void EqCalc::FireLengthToWidth( void )
     // Store results
     vSurfaceFireLengthToWidth->update( lwRatio );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc FireLengthToWidth() 1 1\n", Margin );
-        fprintf( m_log, "%s  i vSurfaceFireEffWindAtHead %g %s\n", Margin,
-            vSurfaceFireEffWindAtHead->m_nativeValue,
-            vSurfaceFireEffWindAtHead->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFireLengthToWidth %g %s\n", Margin,
-            vSurfaceFireLengthToWidth->m_nativeValue,
-            vSurfaceFireLengthToWidth->m_nativeUnits.latin1() );
+        m_trace->proc( "FireLengthToWidth", 1, 1 );
+        m_trace->var( 'i', vSurfaceFireEffWindAtHead );
+        m_trace->var( 'o', vSurfaceFireLengthToWidth );
     }
     return;
 }
@@ -2009,21 +1629,13 @@ void EqCalc::FireLineIntAtBeta( void )
     // Store results
     vSurfaceFireLineIntAtBeta->update( fli );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc FireLineIntAtBeta() 3 1\n", Margin );
-        fprintf( m_log, "%s  i vSurfaceFireSpreadAtBeta %g %s\n", Margin,
-            vSurfaceFireSpreadAtBeta->m_nativeValue,
-            vSurfaceFireSpreadAtBeta->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFireResidenceTime %g %s\n", Margin,
-            vSurfaceFireResidenceTime->m_nativeValue,
-            vSurfaceFireResidenceTime->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFireReactionInt %g %s\n", Margin,
-            vSurfaceFireReactionInt->m_nativeValue,
-            vSurfaceFireReactionInt->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFireLineIntAtBeta %g %s\n", Margin,
-            vSurfaceFireLineIntAtBeta->m_nativeValue,
-            vSurfaceFireLineIntAtBeta->m_nativeUnits.latin1() );
+        m_trace->proc( "FireLineIntAtBeta", 3, 1 );
+        m_trace->var( 'i', vSurfaceFireSpreadAtBeta );
+        m_trace->var( 'i', vSurfaceFireResidenceTime );
+        m_trace->var( 'i', vSurfaceFireReactionInt );
+        m_trace->var( 'o', vSurfaceFireLineIntAtBeta );
     }
     return;
 }
@@ -2051,21 +1663,13 @@ void EqCalc::FireLineIntAtHead( void )
     // Store results
     vSurfaceFireLineIntAtHead->update( fli );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc FireLineIntAtHead() 3 1\n", Margin );
-        fprintf( m_log, "%s  i vSurfaceFireSpreadAtHead %g %s\n", Margin,
-            vSurfaceFireSpreadAtHead->m_nativeValue,
-            vSurfaceFireSpreadAtHead->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFireResidenceTime %g %s\n", Margin,
-            vSurfaceFireResidenceTime->m_nativeValue,
-            vSurfaceFireResidenceTime->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFireReactionInt %g %s\n", Margin,
-            vSurfaceFireReactionInt->m_nativeValue,
-            vSurfaceFireReactionInt->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFireLineIntAtHead %g %s\n", Margin,
-            vSurfaceFireLineIntAtHead->m_nativeValue,
-            vSurfaceFireLineIntAtHead->m_nativeUnits.latin1() );
+        m_trace->proc( "FireLineIntAtHead", 3, 1 );
+        m_trace->var( 'i', vSurfaceFireSpreadAtHead );
+        m_trace->var( 'i', vSurfaceFireResidenceTime );
+        m_trace->var( 'i', vSurfaceFireReactionInt );
+        m_trace->var( 'o', vSurfaceFireLineIntAtHead );
     }
     return;
 }
@@ -2093,21 +1697,13 @@ void EqCalc::FireLineIntAtPsi( void )
     // Store results
     vSurfaceFireLineIntAtPsi->update( fli );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc FireLineIntAtPsi() 3 1\n", Margin );
-        fprintf( m_log, "%s  i vSurfaceFireSpreadAtPsi %g %s\n", Margin,
-            vSurfaceFireSpreadAtPsi->m_nativeValue,
-            vSurfaceFireSpreadAtPsi->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFireResidenceTime %g %s\n", Margin,
-            vSurfaceFireResidenceTime->m_nativeValue,
-            vSurfaceFireResidenceTime->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFireReactionInt %g %s\n", Margin,
-            vSurfaceFireReactionInt->m_nativeValue,
-            vSurfaceFireReactionInt->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFireLineIntAtPsi %g %s\n", Margin,
-            vSurfaceFireLineIntAtPsi->m_nativeValue,
-            vSurfaceFireLineIntAtPsi->m_nativeUnits.latin1() );
+        m_trace->proc( "FireLineIntAtPsi", 3, 1 );
+        m_trace->var( 'i', vSurfaceFireSpreadAtPsi );
+        m_trace->var( 'i', vSurfaceFireResidenceTime );
+        m_trace->var( 'i', vSurfaceFireReactionInt );
+        m_trace->var( 'o', vSurfaceFireLineIntAtPsi );
     }
     return;
 }
@@ -2135,21 +1731,13 @@ void EqCalc::FireLineIntAtVectorFromBeta( void )
     // Store results
     vSurfaceFireLineIntAtVector->update( fli );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc FireLineIntAtVectorFromBeta() 3 1\n", Margin );
-        fprintf( m_log, "%s  i vSurfaceFireSpreadAtBeta %g %s\n", Margin,
-            vSurfaceFireSpreadAtBeta->m_nativeValue,
-            vSurfaceFireSpreadAtBeta->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFireResidenceTime %g %s\n", Margin,
-            vSurfaceFireResidenceTime->m_nativeValue,
-            vSurfaceFireResidenceTime->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFireReactionInt %g %s\n", Margin,
-            vSurfaceFireReactionInt->m_nativeValue,
-            vSurfaceFireReactionInt->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFireLineIntAtVector %g %s\n", Margin,
-            vSurfaceFireLineIntAtVector->m_nativeValue,
-            vSurfaceFireLineIntAtVector->m_nativeUnits.latin1() );
+        m_trace->proc( "FireLineIntAtVectorFromBeta", 3, 1 );
+        m_trace->var( 'i', vSurfaceFireSpreadAtBeta );
+        m_trace->var( 'i', vSurfaceFireResidenceTime );
+        m_trace->var( 'i', vSurfaceFireReactionInt );
+        m_trace->var( 'o', vSurfaceFireLineIntAtVector );
     }
     return;
 }
@@ -2177,21 +1765,13 @@ void EqCalc::FireLineIntAtVectorFromPsi( void )
     // Store results
     vSurfaceFireLineIntAtVector->update( fli );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc FireLineIntAtVectorFromPsi() 3 1\n", Margin );
-        fprintf( m_log, "%s  i vSurfaceFireSpreadAtPsi %g %s\n", Margin,
-            vSurfaceFireSpreadAtPsi->m_nativeValue,
-            vSurfaceFireSpreadAtPsi->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFireResidenceTime %g %s\n", Margin,
-            vSurfaceFireResidenceTime->m_nativeValue,
-            vSurfaceFireResidenceTime->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFireReactionInt %g %s\n", Margin,
-            vSurfaceFireReactionInt->m_nativeValue,
-            vSurfaceFireReactionInt->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFireLineIntAtVector %g %s\n", Margin,
-            vSurfaceFireLineIntAtVector->m_nativeValue,
-            vSurfaceFireLineIntAtVector->m_nativeUnits.latin1() );
+        m_trace->proc( "FireLineIntAtVectorFromPsi", 3, 1 );
+        m_trace->var( 'i', vSurfaceFireSpreadAtPsi );
+        m_trace->var( 'i', vSurfaceFireResidenceTime );
+        m_trace->var( 'i', vSurfaceFireReactionInt );
+        m_trace->var( 'o', vSurfaceFireLineIntAtVector );
     }
     return;
 }
@@ -2217,18 +1797,12 @@ void EqCalc::FireMapDistAtBack( void )
     // Store results
     vSurfaceFireMapDistAtBack->update( md );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc FireMapDistAtBack() 2 1\n", Margin );
-        fprintf( m_log, "%s  i vSurfaceFireDistAtBack %g %s\n", Margin,
-            vSurfaceFireDistAtBack->m_nativeValue,
-            vSurfaceFireDistAtBack->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vMapScale %g %s\n", Margin,
-            vMapScale->m_nativeValue,
-            vMapScale->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFireMapDistAtBack %g %s\n", Margin,
-            vSurfaceFireMapDistAtBack->m_nativeValue,
-            vSurfaceFireMapDistAtBack->m_nativeUnits.latin1() );
+        m_trace->proc( "FireMapDistAtBack", 2, 1 );
+        m_trace->var( 'i', vSurfaceFireDistAtBack );
+        m_trace->var( 'i', vMapScale );
+        m_trace->var( 'o', vSurfaceFireMapDistAtBack );
     }
     return;
 }
@@ -2254,18 +1828,12 @@ void EqCalc::FireMapDistAtBeta( void )
     // Store results
     vSurfaceFireMapDistAtBeta->update( md );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc FireMapDistAtBeta() 2 1\n", Margin );
-        fprintf( m_log, "%s  i vSurfaceFireDistAtBeta %g %s\n", Margin,
-            vSurfaceFireDistAtBeta->m_nativeValue,
-            vSurfaceFireDistAtBeta->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vMapScale %g %s\n", Margin,
-            vMapScale->m_nativeValue,
-            vMapScale->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFireMapDistAtBeta %g %s\n", Margin,
-            vSurfaceFireMapDistAtBeta->m_nativeValue,
-            vSurfaceFireMapDistAtBeta->m_nativeUnits.latin1() );
+        m_trace->proc( "FireMapDistAtBeta", 2, 1 );
+        m_trace->var( 'i', vSurfaceFireDistAtBeta );
+        m_trace->var( 'i', vMapScale );
+        m_trace->var( 'o', vSurfaceFireMapDistAtBeta );
     }
     return;
 }
@@ -2291,18 +1859,12 @@ void EqCalc::FireMapDistAtFlank( void )
     // Store results
     vSurfaceFireMapDistAtFlank->update( md );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc FireMapDistAtFlank() 2 1\n", Margin );
-        fprintf( m_log, "%s  i vSurfaceFireDistAtFlank %g %s\n", Margin,
-            vSurfaceFireDistAtFlank->m_nativeValue,
-            vSurfaceFireDistAtFlank->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vMapScale %g %s\n", Margin,
-            vMapScale->m_nativeValue,
-            vMapScale->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFireMapDistAtFlank %g %s\n", Margin,
-            vSurfaceFireMapDistAtFlank->m_nativeValue,
-            vSurfaceFireMapDistAtFlank->m_nativeUnits.latin1() );
+        m_trace->proc( "FireMapDistAtFlank", 2, 1 );
+        m_trace->var( 'i', vSurfaceFireDistAtFlank );
+        m_trace->var( 'i', vMapScale );
+        m_trace->var( 'o', vSurfaceFireMapDistAtFlank );
     }
     return;
 }
@@ -2328,18 +1890,12 @@ void EqCalc::FireMapDistAtHead( void )
     // Store results
     vSurfaceFireMapDistAtHead->update( md );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc FireMapDistAtHead() 2 1\n", Margin );
-        fprintf( m_log, "%s  i vSurfaceFireDistAtHead %g %s\n", Margin,
-            vSurfaceFireDistAtHead->m_nativeValue,
-            vSurfaceFireDistAtHead->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vMapScale %g %s\n", Margin,
-            vMapScale->m_nativeValue,
-            vMapScale->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFireMapDistAtHead %g %s\n", Margin,
-            vSurfaceFireMapDistAtHead->m_nativeValue,
-            vSurfaceFireMapDistAtHead->m_nativeUnits.latin1() );
+        m_trace->proc( "FireMapDistAtHead", 2, 1 );
+        m_trace->var( 'i', vSurfaceFireDistAtHead );
+        m_trace->var( 'i', vMapScale );
+        m_trace->var( 'o', vSurfaceFireMapDistAtHead );
     }
     return;
 }
@@ -2365,18 +1921,12 @@ void EqCalc::FireMapDistAtPsi( void )
     // Store results
     vSurfaceFireMapDistAtPsi->update( md );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc FireMapDistAtPsi() 2 1\n", Margin );
-        fprintf( m_log, "%s  i vSurfaceFireDistAtPsi %g %s\n", Margin,
-            vSurfaceFireDistAtPsi->m_nativeValue,
-            vSurfaceFireDistAtPsi->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vMapScale %g %s\n", Margin,
-            vMapScale->m_nativeValue,
-            vMapScale->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFireMapDistAtPsi %g %s\n", Margin,
-            vSurfaceFireMapDistAtPsi->m_nativeValue,
-            vSurfaceFireMapDistAtPsi->m_nativeUnits.latin1() );
+        m_trace->proc( "FireMapDistAtPsi", 2, 1 );
+        m_trace->var( 'i', vSurfaceFireDistAtPsi );
+        m_trace->var( 'i', vMapScale );
+        m_trace->var( 'o', vSurfaceFireMapDistAtPsi );
     }
     return;
 }
@@ -2402,18 +1952,12 @@ void EqCalc::FireMapDistAtVector( void )
     // Store results
     vSurfaceFireMapDistAtVector->update( md );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc FireMapDistAtVector() 2 1\n", Margin );
-        fprintf( m_log, "%s  i vSurfaceFireDistAtVector %g %s\n", Margin,
-            vSurfaceFireDistAtVector->m_nativeValue,
-            vSurfaceFireDistAtVector->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vMapScale %g %s\n", Margin,
-            vMapScale->m_nativeValue,
-            vMapScale->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFireMapDistAtVector %g %s\n", Margin,
-            vSurfaceFireMapDistAtVector->m_nativeValue,
-            vSurfaceFireMapDistAtVector->m_nativeUnits.latin1() );
+        m_trace->proc( "FireMapDistAtVector", 2, 1 );
+        m_trace->var( 'i', vSurfaceFireDistAtVector );
+        m_trace->var( 'i', vMapScale );
+        m_trace->var( 'o', vSurfaceFireMapDistAtVector );
     }
     return;
 }
@@ -2442,37 +1986,16 @@ void EqCalc::FireMaxDirDiagram( void )
     // Store results
     vSurfaceFireMaxDirDiagram->update( x );
     // Log results
-    if( m_log )
-    {
-        fprintf( m_log, "%sbegin proc FireMaxDirDiagram() 3 1\n",
-            Margin );
-        fprintf( m_log, "%s  i vSurfaceFireMaxDirFromUpslope %g %d %s\n", Margin,
-            vSurfaceFireMaxDirFromUpslope->m_displayValue,
-            vSurfaceFireMaxDirFromUpslope->m_displayDecimals,
-            vSurfaceFireMaxDirFromUpslope->m_displayUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFireMaxDirFromNorth %g %d %s\n", Margin,
-            vSurfaceFireMaxDirFromNorth->m_displayValue,
-            vSurfaceFireMaxDirFromNorth->m_displayDecimals,
-            vSurfaceFireMaxDirFromNorth->m_displayUnits.latin1() );
-        fprintf( m_log, "%s  i vWindDirFromUpslope %g %d %s\n", Margin,
-            vWindDirFromUpslope->m_displayValue,
-            vWindDirFromUpslope->m_displayDecimals,
-            vWindDirFromUpslope->m_displayUnits.latin1() );
-        fprintf( m_log, "%s  i vWindDirFromNorth %g %d %s\n", Margin,
-            vWindDirFromNorth->m_displayValue,
-            vWindDirFromNorth->m_displayDecimals,
-            vWindDirFromNorth->m_displayUnits.latin1() );
-        fprintf( m_log, "%s  i vSiteAspectDirFromNorth %g %d %s\n", Margin,
-            vSiteAspectDirFromNorth->m_displayValue,
-            vSiteAspectDirFromNorth->m_displayDecimals,
-            vSiteAspectDirFromNorth->m_displayUnits.latin1() );
-        fprintf( m_log, "%s  i vSiteUpslopeDirFromNorth %g %d %s\n", Margin,
-            vSiteUpslopeDirFromNorth->m_displayValue,
-            vSiteUpslopeDirFromNorth->m_displayDecimals,
-            vSiteUpslopeDirFromNorth->m_displayUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFireMaxDirDiagram %g %s\n", Margin,
-            vSurfaceFireMaxDirDiagram->m_nativeValue,
-            vSurfaceFireMaxDirDiagram->m_nativeUnits.latin1() );
+    if( EQTRACE_ON( m_trace ) )
+    {
+        m_trace->proc( "FireMaxDirDiagram", 3, 1 );
+        m_trace->display( 'i', vSurfaceFireMaxDirFromUpslope );
+        m_trace->display( 'i', vSurfaceFireMaxDirFromNorth );
+        m_trace->display( 'i', vWindDirFromUpslope );
+        m_trace->display( 'i', vWindDirFromNorth );
+        m_trace->display( 'i', vSiteAspectDirFromNorth );
+        m_trace->display( 'i', vSiteUpslopeDirFromNorth );
+        m_trace->var( 'o', vSurfaceFireMaxDirDiagram );
     }
     return;
 }
@@ -2510,18 +2033,12 @@ void EqCalc::FireMaxDirFromNorth( void )
     // Store results
     vSurfaceFireMaxDirFromNorth->update( dd );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc FireMaxcDirFromNorth() 2 1\n", Margin );
-        fprintf( m_log, "%s  i vSiteUpslopeDirFromNorth %g %s\n", Margin,
-            vSiteUpslopeDirFromNorth->m_nativeValue,
-            vSiteUpslopeDirFromNorth->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFireMaxDirFromUpslope %g %s\n", Margin,
-            vSurfaceFireMaxDirFromUpslope->m_nativeValue,
-            vSurfaceFireMaxDirFromUpslope->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFireMaxDirFromNorth %g %s\n", Margin,
-            vSurfaceFireMaxDirFromNorth->m_nativeValue,
-            vSurfaceFireMaxDirFromNorth->m_nativeUnits.latin1() );
+        m_trace->proc( "FireMaxcDirFromNorth", 2, 1 );
+        m_trace->var( 'i', vSiteUpslopeDirFromNorth );
+        m_trace->var( 'i', vSurfaceFireMaxDirFromUpslope );
+        m_trace->var( 'o', vSurfaceFireMaxDirFromNorth );
     }
     return;
 }
@@ -2550,21 +2067,13 @@ void EqCalc::FireNoWindRate ( void )
     // Store results
     vSurfaceFireNoWindRate->update( ros0 );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc FireNoWindRate() 3 1\n", Margin );
-        fprintf( m_log, "%s  i vSurfaceFuelBedHeatSink %g %s\n", Margin,
-            vSurfaceFuelBedHeatSink->m_nativeValue,
-            vSurfaceFuelBedHeatSink->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFireReactionInt %g %s\n", Margin,
-            vSurfaceFireReactionInt->m_nativeValue,
-            vSurfaceFireReactionInt->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFirePropagatingFlux %g %s\n", Margin,
-            vSurfaceFirePropagatingFlux->m_nativeValue,
-            vSurfaceFirePropagatingFlux->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFireNoWindRate %g %s\n", Margin,
-            vSurfaceFireNoWindRate->m_nativeValue,
-            vSurfaceFireNoWindRate->m_nativeUnits.latin1() );
+        m_trace->proc( "FireNoWindRate", 3, 1 );
+        m_trace->var( 'i', vSurfaceFuelBedHeatSink );
+        m_trace->var( 'i', vSurfaceFireReactionInt );
+        m_trace->var( 'i', vSurfaceFirePropagatingFlux );
+        m_trace->var( 'o', vSurfaceFireNoWindRate );
     }
     return;
 }
@@ -2590,18 +2099,12 @@ void EqCalc::FirePerimeter( void )
     // Store results
     vSurfaceFirePerimeter->update( perim );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc FirePerimeter() 2 1\n", Margin );
-        fprintf( m_log, "%s  i vSurfaceFireLengDist %g %s\n", Margin,
-            vSurfaceFireLengDist->m_nativeValue,
-            vSurfaceFireLengDist->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFireWidthDist %g %s\n", Margin,
-            vSurfaceFireWidthDist->m_nativeValue,
-            vSurfaceFireWidthDist->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFirePerimeter %g %s\n", Margin,
-            vSurfaceFirePerimeter->m_nativeValue,
-            vSurfaceFirePerimeter->m_nativeUnits.latin1() );
+        m_trace->proc( "FirePerimeter", 2, 1 );
+        m_trace->var( 'i', vSurfaceFireLengDist );
+        m_trace->var( 'i', vSurfaceFireWidthDist );
+        m_trace->var( 'o', vSurfaceFirePerimeter );
     }
     return;
 }
@@ -2627,18 +2130,12 @@ void EqCalc::FirePropagatingFlux( void )
     // Store results
     vSurfaceFirePropagatingFlux->update( propFlux );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc FirePropagatingFlux() 2 1\n", Margin );
-        fprintf( m_log, "%s  i vSurfaceFuelBedPackingRatio %g %s\n", Margin,
-            vSurfaceFuelBedPackingRatio->m_nativeValue,
-            vSurfaceFuelBedPackingRatio->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFuelBedSigma %g %s\n", Margin,
-            vSurfaceFuelBedSigma->m_nativeValue,
-            vSurfaceFuelBedSigma->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFirePropagatingFlux %g %s\n", Margin,
-            vSurfaceFirePropagatingFlux->m_nativeValue,
-            vSurfaceFirePropagatingFlux->m_nativeUnits.latin1() );
+        m_trace->proc( "FirePropagatingFlux", 2, 1 );
+        m_trace->var( 'i', vSurfaceFuelBedPackingRatio );
+        m_trace->var( 'i', vSurfaceFuelBedSigma );
+        m_trace->var( 'o', vSurfaceFirePropagatingFlux );
     }
     return;
 }
@@ -2682,24 +2179,14 @@ void EqCalc::FireReactionInt( void )
     vSurfaceFireReactionIntLive->update( rxIntLive );
 
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc FireReactionIntensity() 4 1\n", Margin );
-        fprintf( m_log, "%s  i vSurfaceFuelBedMextDead %g %s\n", Margin,
-            vSurfaceFuelBedMextDead->m_nativeValue,
-            vSurfaceFuelBedMextDead->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFuelBedMoisDead %g %s\n", Margin,
-            vSurfaceFuelBedMoisDead->m_nativeValue,
-            vSurfaceFuelBedMoisDead->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFuelBedMextLive %g %s\n", Margin,
-            vSurfaceFuelBedMextLive->m_nativeValue,
-            vSurfaceFuelBedMextLive->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFuelBedMoisLive %g %s\n", Margin,
-            vSurfaceFuelBedMoisLive->m_nativeValue,
-            vSurfaceFuelBedMoisLive->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFireReactionInt %g %s\n", Margin,
-            vSurfaceFireReactionInt->m_nativeValue,
-            vSurfaceFireReactionInt->m_nativeUnits.latin1() );
+        m_trace->proc( "FireReactionIntensity", 4, 1 );
+        m_trace->var( 'i', vSurfaceFuelBedMextDead );
+        m_trace->var( 'i', vSurfaceFuelBedMoisDead );
+        m_trace->var( 'i', vSurfaceFuelBedMextLive );
+        m_trace->var( 'i', vSurfaceFuelBedMoisLive );
+        m_trace->var( 'o', vSurfaceFireReactionInt );
     }
     return;
 }
@@ -2723,15 +2210,11 @@ void EqCalc::FireResidenceTime( void )
     // Store results
     vSurfaceFireResidenceTime->update( rt );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc FireResidenceTime() 2 1\n", Margin );
-        fprintf( m_log, "%s  i vSurfaceFuelBedSigma %g %s\n", Margin,
-            vSurfaceFuelBedSigma->m_nativeValue,
-            vSurfaceFuelBedSigma->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFireResidenceTime %g %s\n", Margin,
-            vSurfaceFireResidenceTime->m_nativeValue,
-            vSurfaceFireResidenceTime->m_nativeUnits.latin1() );
+        m_trace->proc( "FireResidenceTime", 2, 1 );
+        m_trace->var( 'i', vSurfaceFuelBedSigma );
+        m_trace->var( 'o', vSurfaceFireResidenceTime );
     }
     return;
 }
@@ -2764,21 +2247,13 @@ void EqCalc::FireScorchHtFromFlameLengAtVector( void )
     // Store results
     vSurfaceFireScorchHtAtVector->update( scorchHt );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc FireScorchHtAtVector() 3 1\n", Margin );
-        fprintf( m_log, "%s  i vWthrAirTemp %g %s\n", Margin,
-            vWthrAirTemp->m_nativeValue,
-            vWthrAirTemp->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vWindSpeedAtMidflame %g %s\n", Margin,
-            vWindSpeedAtMidflame->m_nativeValue,
-            vWindSpeedAtMidflame->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFireFlameLengAtVector %g %s\n", Margin,
-            vSurfaceFireFlameLengAtVector->m_nativeValue,
-            vSurfaceFireFlameLengAtVector->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFireScorchHtAtVector %g %s\n", Margin,
-            vSurfaceFireScorchHtAtVector->m_nativeValue,
-            vSurfaceFireScorchHtAtVector->m_nativeUnits.latin1() );
+        m_trace->proc( "FireScorchHtAtVector", 3, 1 );
+        m_trace->var( 'i', vWthrAirTemp );
+        m_trace->var( 'i', vWindSpeedAtMidflame );
+        m_trace->var( 'i', vSurfaceFireFlameLengAtVector );
+        m_trace->var( 'o', vSurfaceFireScorchHtAtVector );
     }
     return;
 }
@@ -2807,21 +2282,13 @@ void EqCalc::FireScorchHtFromFliAtVector( void )
     // Store results
     vSurfaceFireScorchHtAtVector->update( scorchHt );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc FireScorchHtAtVector() 3 1\n", Margin );
-        fprintf( m_log, "%s  i vWthrAirTemp %g %s\n", Margin,
-            vWthrAirTemp->m_nativeValue,
-            vWthrAirTemp->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vWindSpeedAtMidflame %g %s\n", Margin,
-            vWindSpeedAtMidflame->m_nativeValue,
-            vWindSpeedAtMidflame->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFireLineIntAtVector %g %s\n", Margin,
-            vSurfaceFireLineIntAtVector->m_nativeValue,
-            vSurfaceFireLineIntAtVector->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFireScorchHtAtVector %g %s\n", Margin,
-            vSurfaceFireScorchHtAtVector->m_nativeValue,
-            vSurfaceFireScorchHtAtVector->m_nativeUnits.latin1() );
+        m_trace->proc( "FireScorchHtAtVector", 3, 1 );
+        m_trace->var( 'i', vWthrAirTemp );
+        m_trace->var( 'i', vWindSpeedAtMidflame );
+        m_trace->var( 'i', vSurfaceFireLineIntAtVector );
+        m_trace->var( 'o', vSurfaceFireScorchHtAtVector );
     }
     return;
 }
@@ -2858,60 +2325,22 @@ void EqCalc::FireShapeDiagram( void )
     // Log results
     // The DISPLAY values, decimals, and units are printed so they can
     // annotate the diagram.
-    if( m_log )
-    {
-        fprintf( m_log, "%sbegin proc FireShapeDiagram() 8 1\n", Margin );
-        fprintf( m_log, "%s  i vSurfaceFireLengDist %g %d %s\n", Margin,
-            vSurfaceFireLengDist->m_displayValue,
-            vSurfaceFireLengDist->m_displayDecimals,
-            vSurfaceFireLengDist->m_displayUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFireWidthDist %g %d %s\n", Margin,
-            vSurfaceFireWidthDist->m_displayValue,
-            vSurfaceFireWidthDist->m_displayDecimals,
-            vSurfaceFireWidthDist->m_displayUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFireArea %g %d %s\n", Margin,
-            vSurfaceFireArea->m_displayValue,
-            vSurfaceFireArea->m_displayDecimals,
-            vSurfaceFireArea->m_displayUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFirePerimeter %g %d %s\n", Margin,
-            vSurfaceFirePerimeter->m_displayValue,
-            vSurfaceFirePerimeter->m_displayDecimals,
-            vSurfaceFirePerimeter->m_displayUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFireElapsedTime %g %d %s\n", Margin,
-            vSurfaceFireElapsedTime->m_displayValue,
-            vSurfaceFireElapsedTime->m_displayDecimals,
-            vSurfaceFireElapsedTime->m_displayUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFireDistAtHead %g %d %s\n", Margin,
-            vSurfaceFireDistAtHead->m_displayValue,
-            vSurfaceFireDistAtHead->m_displayDecimals,
-            vSurfaceFireDistAtHead->m_displayUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFireDistAtBack %g %d %s\n", Margin,
-            vSurfaceFireDistAtBack->m_displayValue,
-            vSurfaceFireDistAtBack->m_displayDecimals,
-            vSurfaceFireDistAtBack->m_displayUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFireMaxDirFromUpslope %g %d %s\n", Margin,
-            vSurfaceFireMaxDirFromUpslope->m_displayValue,
-            vSurfaceFireMaxDirFromUpslope->m_displayDecimals,
-            vSurfaceFireMaxDirFromUpslope->m_displayUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFireMaxDirFromNorth %g %d %s\n", Margin,
-            vSurfaceFireMaxDirFromNorth->m_displayValue,
-            vSurfaceFireMaxDirFromNorth->m_displayDecimals,
-            vSurfaceFireMaxDirFromNorth->m_displayUnits.latin1() );
-        fprintf( m_log, "%s  i vWindDirFromUpslope %g %d %s\n", Margin,
-            vWindDirFromUpslope->m_displayValue,
-            vWindDirFromUpslope->m_displayDecimals,
-            vWindDirFromUpslope->m_displayUnits.latin1() );
-        fprintf( m_log, "%s  i vWindDirFromNorth %g %d %s\n", Margin,
-            vWindDirFromNorth->m_displayValue,
-            vWindDirFromNorth->m_displayDecimals,
-            vWindDirFromNorth->m_displayUnits.latin1() );
-        fprintf( m_log, "%s  i vSiteAspectDirFromNorth %g %d %s\n", Margin,
-            vSiteAspectDirFromNorth->m_displayValue,
-            vSiteAspectDirFromNorth->m_displayDecimals,
-            vSiteAspectDirFromNorth->m_displayUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFireShapeDiagram %g %s\n", Margin,
-            vSurfaceFireShapeDiagram->m_nativeValue,
-            vSurfaceFireShapeDiagram->m_nativeUnits.latin1() );
+    if( EQTRACE_ON( m_trace ) )
+    {
+        m_trace->proc( "FireShapeDiagram", 8, 1 );
+        m_trace->display( 'i', vSurfaceFireLengDist );
+        m_trace->display( 'i', vSurfaceFireWidthDist );
+        m_trace->display( 'i', vSurfaceFireArea );
+        m_trace->display( 'i', vSurfaceFirePerimeter );
+        m_trace->display( 'i', vSurfaceFireElapsedTime );
+        m_trace->display( 'i', vSurfaceFireDistAtHead );
+        m_trace->display( 'i', vSurfaceFireDistAtBack );
+        m_trace->display( 'i', vSurfaceFireMaxDirFromUpslope );
+        m_trace->display( 'i', vSurfaceFireMaxDirFromNorth );
+        m_trace->display( 'i', vWindDirFromUpslope );
+        m_trace->display( 'i', vWindDirFromNorth );
+        m_trace->display( 'i', vSiteAspectDirFromNorth );
+        m_trace->var( 'o', vSurfaceFireShapeDiagram );
     }
     return;
 }
@@ -2938,18 +2367,12 @@ void EqCalc::FireSpreadAtBack( void )
     vSurfaceFireSpreadAtBack->update( rosBacking );
     // Log results
 
-	if( m_log )
+	if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc FireSpreadAtBack() 2 1\n", Margin );
-        fprintf( m_log, "%s  i vSurfaceFireEccentricity %g %s\n", Margin,
-            vSurfaceFireEccentricity->m_nativeValue,
-            vSurfaceFireEccentricity->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFireSpreadAtHead %g %s\n", Margin,
-            vSurfaceFireSpreadAtHead->m_nativeValue,
-            vSurfaceFireSpreadAtHead->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFireSpreadAtBack %g %s\n", Margin,
-            vSurfaceFireSpreadAtBack->m_nativeValue,
-            vSurfaceFireSpreadAtBack->m_nativeUnits.latin1() );
+        m_trace->proc( "FireSpreadAtBack", 2, 1 );
+        m_trace->var( 'i', vSurfaceFireEccentricity );
+        m_trace->var( 'i', vSurfaceFireSpreadAtHead );
+        m_trace->var( 'o', vSurfaceFireSpreadAtBack );
     }
     return;
 }
@@ -2976,21 +2399,13 @@ void EqCalc::FireSpreadAtBeta( void )
     // Store results
     vSurfaceFireSpreadAtBeta->update( rosVec );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc FireSpreadAtBeta() 3 1\n", Margin );
-        fprintf( m_log, "%s  i vSurfaceFireEccentricity %g %s\n", Margin,
-            vSurfaceFireEccentricity->m_nativeValue,
-            vSurfaceFireEccentricity->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFireSpreadAtHead %g %s\n", Margin,
-            vSurfaceFireSpreadAtHead->m_nativeValue,
-            vSurfaceFireSpreadAtHead->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFireVectorBeta %g %s\n", Margin,
-            vSurfaceFireVectorBeta->m_nativeValue,
-            vSurfaceFireVectorBeta->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFireSpreadAtBeta %g %s\n", Margin,
-            vSurfaceFireSpreadAtBeta->m_nativeValue,
-            vSurfaceFireSpreadAtBeta->m_nativeUnits.latin1() );
+        m_trace->proc( "FireSpreadAtBeta", 3, 1 );
+        m_trace->var( 'i', vSurfaceFireEccentricity );
+        m_trace->var( 'i', vSurfaceFireSpreadAtHead );
+        m_trace->var( 'i', vSurfaceFireVectorBeta );
+        m_trace->var( 'o', vSurfaceFireSpreadAtBeta );
     }
     return;
 }
@@ -3018,21 +2433,13 @@ void EqCalc::FireSpreadAtFlank( void )
     // Store results
     vSurfaceFireSpreadAtFlank->update( flank );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc FireSpreadAtFlank() 3 1\n", Margin );
-        fprintf( m_log, "%s  i vSurfaceFireLengthToWidth %g %s\n", Margin,
-            vSurfaceFireLengthToWidth->m_nativeValue,
-            vSurfaceFireLengthToWidth->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFireSpreadAtBack %g %s\n", Margin,
-            vSurfaceFireSpreadAtBack->m_nativeValue,
-            vSurfaceFireSpreadAtBack->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFireSpreadAtHead %g %s\n", Margin,
-            vSurfaceFireSpreadAtHead->m_nativeValue,
-            vSurfaceFireSpreadAtHead->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFireSpreadAtFlank %g %s\n", Margin,
-            vSurfaceFireSpreadAtFlank->m_nativeValue,
-            vSurfaceFireSpreadAtFlank->m_nativeUnits.latin1() );
+        m_trace->proc( "FireSpreadAtFlank", 3, 1 );
+        m_trace->var( 'i', vSurfaceFireLengthToWidth );
+        m_trace->var( 'i', vSurfaceFireSpreadAtBack );
+        m_trace->var( 'i', vSurfaceFireSpreadAtHead );
+        m_trace->var( 'o', vSurfaceFireSpreadAtFlank );
     }
     return;
 }
@@ -3112,43 +2519,21 @@ void EqCalc::FireSpreadAtHead( void )
     vSurfaceFireSlopeFactor->update( slopeFactor );
 
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc FireSpreadAtHead() 5 7\n", Margin );
-        fprintf( m_log, "%s  i vSurfaceFireNoWindRate %g %s\n", Margin,
-            vSurfaceFireNoWindRate->m_nativeValue,
-            vSurfaceFireNoWindRate->m_nativeUnits.latin1() );
+        m_trace->proc( "FireSpreadAtHead", 5, 7 );
+        m_trace->var( 'i', vSurfaceFireNoWindRate );
 		logInput( vSurfaceFireReactionInt );
-        fprintf( m_log, "%s  i vSiteSlopeFraction %g %s\n", Margin,
-            vSiteSlopeFraction->m_nativeValue,
-            vSiteSlopeFraction->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vWindDirFromUpslope %g %s\n", Margin,
-            vWindDirFromUpslope->m_nativeValue,
-            vWindDirFromUpslope->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vWindSpeedAtMidflame %g %s\n", Margin,
-            vWindSpeedAtMidflame->m_nativeValue,
-            vWindSpeedAtMidflame->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFireSpreadAtHead %g %s\n", Margin,
-            vSurfaceFireSpreadAtHead->m_nativeValue,
-            vSurfaceFireSpreadAtHead->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFireMaxDirFromUpslope %g %s\n", Margin,
-            vSurfaceFireMaxDirFromUpslope->m_nativeValue,
-            vSurfaceFireMaxDirFromUpslope->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFireEffWindAtHead %g %s\n", Margin,
-            vSurfaceFireEffWindAtHead->m_nativeValue,
-            vSurfaceFireEffWindAtHead->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFireWindSpeedLimit %g %s\n", Margin,
-            vSurfaceFireWindSpeedLimit->m_nativeValue,
-            vSurfaceFireWindSpeedLimit->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFireWindSpeedFlag %g %s\n", Margin,
-            vSurfaceFireWindSpeedFlag->m_nativeValue,
-            vSurfaceFireWindSpeedFlag->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFireWindFactor %g %s\n", Margin,
-            vSurfaceFireWindFactor->m_nativeValue,
-            vSurfaceFireWindFactor->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFireSlopeFactor %g %s\n", Margin,
-            vSurfaceFireSlopeFactor->m_nativeValue,
-            vSurfaceFireSlopeFactor->m_nativeUnits.latin1() );
+        m_trace->var( 'i', vSiteSlopeFraction );
+        m_trace->var( 'i', vWindDirFromUpslope );
+        m_trace->var( 'i', vWindSpeedAtMidflame );
+        m_trace->var( 'o', vSurfaceFireSpreadAtHead );
+        m_trace->var( 'o', vSurfaceFireMaxDirFromUpslope );
+        m_trace->var( 'o', vSurfaceFireEffWindAtHead );
+        m_trace->var( 'o', vSurfaceFireWindSpeedLimit );
+        m_trace->var( 'o', vSurfaceFireWindSpeedFlag );
+        m_trace->var( 'o', vSurfaceFireWindFactor );
+        m_trace->var( 'o', vSurfaceFireSlopeFactor );
     }
     return;
 }
@@ -3200,27 +2585,16 @@ void EqCalc::FireSpreadAtPsi( void )
     // Store results
     vSurfaceFireSpreadAtPsi->update( rosVec );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc FireSpreadAtPsi() 5 1\n", Margin );
-         fprintf( m_log, "%s  i vSurfaceFireEllipseF %g %s\n", Margin,
-            f, // vSurfaceFireEllipseF->m_nativeValue,
-            vSurfaceFireEllipseF->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFireEllipseG %g %s\n", Margin,
-            g, // vSurfaceFireEllipseG->m_nativeValue,
-            vSurfaceFireEllipseG->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFireEllipseH %g %s\n", Margin,
-            h, // vSurfaceFireEllipseH->m_nativeValue,
-            vSurfaceFireEllipseH->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFireElaspedTime %g %s\n", Margin,
-            t, // vSurfaceFireElapsedTime->m_nativeValue,
-            vSurfaceFireElapsedTime->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFireVectorPsi %g %s\n", Margin,
-            vSurfaceFireVectorPsi->m_nativeValue,
-            vSurfaceFireVectorPsi->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFireSpreadAtPsi %g %s\n", Margin,
-            vSurfaceFireSpreadAtPsi->m_nativeValue,
-            vSurfaceFireSpreadAtPsi->m_nativeUnits.latin1() );
+        m_trace->proc( "FireSpreadAtPsi", 5, 1 );
+        m_trace->value( 'i', vSurfaceFireEllipseF, f );
+        m_trace->value( 'i', vSurfaceFireEllipseG, g );
+        m_trace->value( 'i', vSurfaceFireEllipseH, h );
+        m_trace->value( 'i', vSurfaceFireElapsedTime, t,
+            "vSurfaceFireElaspedTime" );
+        m_trace->var( 'i', vSurfaceFireVectorPsi );
+        m_trace->var( 'o', vSurfaceFireSpreadAtPsi );
     }
     return;
 }
@@ -3247,21 +2621,13 @@ void EqCalc::FireSpreadAtVectorFromBeta( void )
     // Store results
     vSurfaceFireSpreadAtVector->update( rosVec );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc FireSpreadAtVectorFromBeta() 3 1\n", Margin );
-        fprintf( m_log, "%s  i vSurfaceFireEccentricity %g %s\n", Margin,
-            vSurfaceFireEccentricity->m_nativeValue,
-            vSurfaceFireEccentricity->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFireSpreadAtHead %g %s\n", Margin,
-            vSurfaceFireSpreadAtHead->m_nativeValue,
-            vSurfaceFireSpreadAtHead->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFireVectorBeta %g %s\n", Margin,
-            vSurfaceFireVectorBeta->m_nativeValue,
-            vSurfaceFireVectorBeta->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFireSpreadAtVector %g %s\n", Margin,
-            vSurfaceFireSpreadAtVector->m_nativeValue,
-            vSurfaceFireSpreadAtVector->m_nativeUnits.latin1() );
+        m_trace->proc( "FireSpreadAtVectorFromBeta", 3, 1 );
+        m_trace->var( 'i', vSurfaceFireEccentricity );
+        m_trace->var( 'i', vSurfaceFireSpreadAtHead );
+        m_trace->var( 'i', vSurfaceFireVectorBeta );
+        m_trace->var( 'o', vSurfaceFireSpreadAtVector );
     }
     return;
 }
@@ -3313,27 +2679,16 @@ void EqCalc::FireSpreadAtVectorFromPsi( void )
     // Store results
     vSurfaceFireSpreadAtVector->update( rosVec );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc FireSpreadAtVectorFromPsi() 5 1\n", Margin );
-         fprintf( m_log, "%s  i vSurfaceFireEllipseF %g %s\n", Margin,
-            f, // vSurfaceFireEllipseF->m_nativeValue,
-            vSurfaceFireEllipseF->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFireEllipseG %g %s\n", Margin,
-            g, // vSurfaceFireEllipseG->m_nativeValue,
-            vSurfaceFireEllipseG->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFireEllipseH %g %s\n", Margin,
-            h, // vSurfaceFireEllipseH->m_nativeValue,
-            vSurfaceFireEllipseH->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFireElaspedTime %g %s\n", Margin,
-            t, // vSurfaceFireElapsedTime->m_nativeValue,
-            vSurfaceFireElapsedTime->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFireVectorPsi %g %s\n", Margin,
-            vSurfaceFireVectorPsi->m_nativeValue,
-            vSurfaceFireVectorPsi->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFireSpreadAtVector %g %s\n", Margin,
-            vSurfaceFireSpreadAtVector->m_nativeValue,
-            vSurfaceFireSpreadAtVector->m_nativeUnits.latin1() );
+        m_trace->proc( "FireSpreadAtVectorFromPsi", 5, 1 );
+        m_trace->value( 'i', vSurfaceFireEllipseF, f );
+        m_trace->value( 'i', vSurfaceFireEllipseG, g );
+        m_trace->value( 'i', vSurfaceFireEllipseH, h );
+        m_trace->value( 'i', vSurfaceFireElapsedTime, t,
+            "vSurfaceFireElaspedTime" );
+        m_trace->var( 'i', vSurfaceFireVectorPsi );
+        m_trace->var( 'o', vSurfaceFireSpreadAtVector );
     }
     return;
 }
@@ -3363,24 +2718,14 @@ void EqCalc::FireVectorBetaFromTheta ( void )
     // Store results
     vSurfaceFireVectorBeta->update( beta );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc FireVectorBetaFromTheta() 4 1\n", Margin );
-        fprintf( m_log, "%s  i vSurfaceFireEllipseF %g %s\n", Margin,
-            vSurfaceFireEllipseF->m_nativeValue,
-            vSurfaceFireEllipseF->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFireEllipseG %g %s\n", Margin,
-            vSurfaceFireEllipseG->m_nativeValue,
-            vSurfaceFireEllipseG->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFireEllipseH %g %s\n", Margin,
-            vSurfaceFireEllipseH->m_nativeValue,
-            vSurfaceFireEllipseH->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFireVectorTheta %g %s\n", Margin,
-            vSurfaceFireVectorTheta->m_nativeValue,
-            vSurfaceFireVectorTheta->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFireVectorBeta %g %s\n", Margin,
-            vSurfaceFireVectorBeta->m_nativeValue,
-            vSurfaceFireVectorBeta->m_nativeUnits.latin1() );
+        m_trace->proc( "FireVectorBetaFromTheta", 4, 1 );
+        m_trace->var( 'i', vSurfaceFireEllipseF );
+        m_trace->var( 'i', vSurfaceFireEllipseG );
+        m_trace->var( 'i', vSurfaceFireEllipseH );
+        m_trace->var( 'i', vSurfaceFireVectorTheta );
+        m_trace->var( 'o', vSurfaceFireVectorBeta );
     }
     return;
 }
@@ -3406,18 +2751,12 @@ void EqCalc::FireVectorBetaFromUpslope( void )
     vSurfaceFireVectorBeta->update( beta );
     // Log results
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc FireVectorBetaFromUpslope() 2 1\n", Margin );
-        fprintf( m_log, "%s  i vSurfaceFireMaxDirFromUpslope %g %s\n", Margin,
-            vSurfaceFireMaxDirFromUpslope->m_nativeValue,
-            vSurfaceFireMaxDirFromUpslope->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFireVectorDirFromUpslope %g %s\n", Margin,
-            vSurfaceFireVectorDirFromUpslope->m_nativeValue,
-            vSurfaceFireVectorDirFromUpslope->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFireVectorBeta %g %s\n", Margin,
-            vSurfaceFireVectorBeta->m_nativeValue,
-            vSurfaceFireVectorBeta->m_nativeUnits.latin1() );
+        m_trace->proc( "FireVectorBetaFromUpslope", 2, 1 );
+        m_trace->var( 'i', vSurfaceFireMaxDirFromUpslope );
+        m_trace->var( 'i', vSurfaceFireVectorDirFromUpslope );
+        m_trace->var( 'o', vSurfaceFireVectorBeta );
     }
     return;
 }
@@ -3441,15 +2780,11 @@ void EqCalc::FireVectorDirFromNorth( void )
     // Store results
     vSurfaceFireVectorDirFromNorth->update( fd );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc FireVectorDirFromNorth() 1 1\n", Margin );
-        fprintf( m_log, "%s  i vSurfaceFireVectorDirFromCompass %d %s\n", Margin,
-            vSurfaceFireVectorDirFromCompass->activeItemDataIndex(),
-            vSurfaceFireVectorDirFromCompass->activeItemName().latin1() );
-        fprintf( m_log, "%s  o vSurfaceFireVectorDirFromNorth %g %s\n", Margin,
-            vSurfaceFireVectorDirFromNorth->m_nativeValue,
-            vSurfaceFireVectorDirFromNorth->m_nativeUnits.latin1() );
+        m_trace->proc( "FireVectorDirFromNorth", 1, 1 );
+        m_trace->item( 'i', vSurfaceFireVectorDirFromCompass );
+        m_trace->var( 'o', vSurfaceFireVectorDirFromNorth );
     }
     return;
 }
@@ -3479,18 +2814,12 @@ void EqCalc::FireVectorDirFromUpslope( void )
     // Store results
     vSurfaceFireVectorDirFromUpslope->update( dd );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc FireVectorDirFromUpslope() 2 1\n", Margin );
-        fprintf( m_log, "%s  i vSiteUpslopeDirFromNorth %g %s\n", Margin,
-            vSiteUpslopeDirFromNorth->m_nativeValue,
-            vSiteUpslopeDirFromNorth->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFireVectorDirFromNorth %g %s\n", Margin,
-            vSurfaceFireVectorDirFromNorth->m_nativeValue,
-            vSurfaceFireVectorDirFromNorth->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFireVectorDirFromUpslope %g %s\n", Margin,
-            vSurfaceFireVectorDirFromUpslope->m_nativeValue,
-            vSurfaceFireVectorDirFromUpslope->m_nativeUnits.latin1() );
+        m_trace->proc( "FireVectorDirFromUpslope", 2, 1 );
+        m_trace->var( 'i', vSiteUpslopeDirFromNorth );
+        m_trace->var( 'i', vSurfaceFireVectorDirFromNorth );
+        m_trace->var( 'o', vSurfaceFireVectorDirFromUpslope );
     }
     return;
 }
@@ -3520,21 +2849,13 @@ void EqCalc::FireVectorPsiFromTheta ( void )
     // Store results
     vSurfaceFireVectorPsi->update( psi );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc FireVectorPsiFromTheta() 3 1\n", Margin );
-        fprintf( m_log, "%s  i vSurfaceFireEllipseF %g %s\n", Margin,
-            vSurfaceFireEllipseF->m_nativeValue,
-            vSurfaceFireEllipseF->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFireEllipseH %g %s\n", Margin,
-            vSurfaceFireEllipseH->m_nativeValue,
-            vSurfaceFireEllipseH->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFireVectorTheta %g %s\n", Margin,
-            vSurfaceFireVectorTheta->m_nativeValue,
-            vSurfaceFireVectorTheta->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFireVectorPsi %g %s\n", Margin,
-            vSurfaceFireVectorPsi->m_nativeValue,
-            vSurfaceFireVectorPsi->m_nativeUnits.latin1() );
+        m_trace->proc( "FireVectorPsiFromTheta", 3, 1 );
+        m_trace->var( 'i', vSurfaceFireEllipseF );
+        m_trace->var( 'i', vSurfaceFireEllipseH );
+        m_trace->var( 'i', vSurfaceFireVectorTheta );
+        m_trace->var( 'o', vSurfaceFireVectorPsi );
     }
     return;
 }
@@ -3560,18 +2881,12 @@ void EqCalc::FireVectorPsiFromUpslope( void )
     vSurfaceFireVectorPsi->update( psi );
     // Log results
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc FireVectorPsiFromUpslope() 2 1\n", Margin );
-        fprintf( m_log, "%s  i vSurfaceFireMaxDirFromUpslope %g %s\n", Margin,
-            vSurfaceFireMaxDirFromUpslope->m_nativeValue,
-            vSurfaceFireMaxDirFromUpslope->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFireVectorDirFromUpslope %g %s\n", Margin,
-            vSurfaceFireVectorDirFromUpslope->m_nativeValue,
-            vSurfaceFireVectorDirFromUpslope->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFireVectorPsi %g %s\n", Margin,
-            vSurfaceFireVectorPsi->m_nativeValue,
-            vSurfaceFireVectorPsi->m_nativeUnits.latin1() );
+        m_trace->proc( "FireVectorPsiFromUpslope", 2, 1 );
+        m_trace->var( 'i', vSurfaceFireMaxDirFromUpslope );
+        m_trace->var( 'i', vSurfaceFireVectorDirFromUpslope );
+        m_trace->var( 'o', vSurfaceFireVectorPsi );
     }
     return;
 }
@@ -3601,24 +2916,14 @@ void EqCalc::FireVectorThetaFromBeta ( void )
     // Store results
     vSurfaceFireVectorTheta->update( theta );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc FireVectorThetaFromBeta() 4 1\n", Margin );
-        fprintf( m_log, "%s  i vSurfaceFireEllipseF %g %s\n", Margin,
-            vSurfaceFireEllipseF->m_nativeValue,
-            vSurfaceFireEllipseF->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFireEllipseG %g %s\n", Margin,
-            vSurfaceFireEllipseG->m_nativeValue,
-            vSurfaceFireEllipseG->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFireEllipseH %g %s\n", Margin,
-            vSurfaceFireEllipseH->m_nativeValue,
-            vSurfaceFireEllipseH->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFireVectorBeta %g %s\n", Margin,
-            vSurfaceFireVectorBeta->m_nativeValue,
-            vSurfaceFireVectorBeta->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFireVectorTheta %g %s\n", Margin,
-            vSurfaceFireVectorTheta->m_nativeValue,
-            vSurfaceFireVectorTheta->m_nativeUnits.latin1() );
+        m_trace->proc( "FireVectorThetaFromBeta", 4, 1 );
+        m_trace->var( 'i', vSurfaceFireEllipseF );
+        m_trace->var( 'i', vSurfaceFireEllipseG );
+        m_trace->var( 'i', vSurfaceFireEllipseH );
+        m_trace->var( 'i', vSurfaceFireVectorBeta );
+        m_trace->var( 'o', vSurfaceFireVectorTheta );
     }
     return;
 }
@@ -3646,21 +2951,13 @@ void EqCalc::FireVectorThetaFromPsi ( void )
     // Store results
     vSurfaceFireVectorTheta->update( theta );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc FireVectorThetaFromPsi() 3 1\n", Margin );
-        fprintf( m_log, "%s  i vSurfaceFireEllipseF %g %s\n", Margin,
-            vSurfaceFireEllipseF->m_nativeValue,
-            vSurfaceFireEllipseF->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFireEllipseH %g %s\n", Margin,
-            vSurfaceFireEllipseH->m_nativeValue,
-            vSurfaceFireEllipseH->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFireVectorPsi %g %s\n", Margin,
-            vSurfaceFireVectorPsi->m_nativeValue,
-            vSurfaceFireVectorPsi->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFireVectorTheta %g %s\n", Margin,
-            vSurfaceFireVectorTheta->m_nativeValue,
-            vSurfaceFireVectorTheta->m_nativeUnits.latin1() );
+        m_trace->proc( "FireVectorThetaFromPsi", 3, 1 );
+        m_trace->var( 'i', vSurfaceFireEllipseF );
+        m_trace->var( 'i', vSurfaceFireEllipseH );
+        m_trace->var( 'i', vSurfaceFireVectorPsi );
+        m_trace->var( 'o', vSurfaceFireVectorTheta );
     }
     return;
 }
@@ -3686,18 +2983,12 @@ void EqCalc::FireWidthDist( void )
     // Store results
     vSurfaceFireWidthDist->update( wd );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc FireWidthDist() 2 1\n", Margin );
-        fprintf( m_log, "%s  i vSurfaceFireLengDist %g %s\n", Margin,
-            vSurfaceFireLengDist->m_nativeValue,
-            vSurfaceFireLengDist->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFireLengthToWidth %g %s\n", Margin,
-            vSurfaceFireLengthToWidth->m_nativeValue,
-            vSurfaceFireLengthToWidth->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFireWidthDist %g %s\n", Margin,
-            vSurfaceFireWidthDist->m_nativeValue,
-            vSurfaceFireWidthDist->m_nativeUnits.latin1() );
+        m_trace->proc( "FireWidthDist", 2, 1 );
+        m_trace->var( 'i', vSurfaceFireLengDist );
+        m_trace->var( 'i', vSurfaceFireLengthToWidth );
+        m_trace->var( 'o', vSurfaceFireWidthDist );
     }
     return;
 }
@@ -3723,18 +3014,12 @@ void EqCalc::FireWidthMapDist( void )
     // Store results
     vSurfaceFireWidthMapDist->update( md );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc FireWidthMapDist() 2 1\n", Margin );
-        fprintf( m_log, "%s  i vSurfaceFireWidthDist %g %s\n", Margin,
-            vSurfaceFireWidthDist->m_nativeValue,
-            vSurfaceFireWidthDist->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vMapScale %g %s\n", Margin,
-            vMapScale->m_nativeValue,
-            vMapScale->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFireWidthMapDist %g %s\n", Margin,
-            vSurfaceFireWidthMapDist->m_nativeValue,
-            vSurfaceFireWidthMapDist->m_nativeUnits.latin1() );
+        m_trace->proc( "FireWidthMapDist", 2, 1 );
+        m_trace->var( 'i', vSurfaceFireWidthDist );
+        m_trace->var( 'i', vMapScale );
+        m_trace->var( 'o', vSurfaceFireWidthMapDist );
     }
     return;
 }
@@ -3784,45 +3069,21 @@ void EqCalc::FuelAspenModel( void )
     vSurfaceFuelAspenSavrLiveWoody->update( savrLiveWoody );
 
     // Log results
-    if( m_log )
-    {
-        fprintf( m_log, "%sbegin proc FuelAspenModel() 2 10\n", Margin );
-        fprintf( m_log, "%s  i vSurfaceFuelAspenCuring %g %s\n", Margin,
-            vSurfaceFuelAspenCuring->m_nativeValue,
-            vSurfaceFuelAspenCuring->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFuelAspenType %d %s\n", Margin,
-            vSurfaceFuelAspenType->activeItemDataIndex(),
-            vSurfaceFuelAspenType->activeItemName().latin1() );
-        fprintf( m_log, "%s  o vSurfaceFuelBedDepth %g %s\n", Margin,
-            vSurfaceFuelBedDepth->m_nativeValue,
-            vSurfaceFuelBedDepth->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFuelBedMextDead %g %s\n", Margin,
-            vSurfaceFuelBedMextDead->m_nativeValue,
-            vSurfaceFuelBedMextDead->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFuelAspenLoadDead1 %g %s\n", Margin,
-            vSurfaceFuelAspenLoadDead1->m_nativeValue,
-            vSurfaceFuelAspenLoadDead1->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFuelAspenLoadDead10 %g %s\n", Margin,
-            vSurfaceFuelAspenLoadDead10->m_nativeValue,
-            vSurfaceFuelAspenLoadDead10->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFuelAspenLoadLiveHerb %g %s\n", Margin,
-            vSurfaceFuelAspenLoadLiveHerb->m_nativeValue,
-            vSurfaceFuelAspenLoadLiveHerb->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFuelAspenLoadLiveWoody %g %s\n", Margin,
-            vSurfaceFuelAspenLoadLiveWoody->m_nativeValue,
-            vSurfaceFuelAspenLoadLiveWoody->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFuelAspenSavrDead1 %g %s\n", Margin,
-            vSurfaceFuelAspenSavrDead1->m_nativeValue,
-            vSurfaceFuelAspenSavrDead1->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFuelAspenSavrDead10 %g %s\n", Margin,
-            vSurfaceFuelAspenSavrDead10->m_nativeValue,
-            vSurfaceFuelAspenSavrDead10->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFuelAspenSavrLiveHerb %g %s\n", Margin,
-            vSurfaceFuelAspenSavrLiveHerb->m_nativeValue,
-            vSurfaceFuelAspenSavrLiveHerb->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFuelAspenSavrLiveWoody %g %s\n", Margin,
-            vSurfaceFuelAspenSavrLiveWoody->m_nativeValue,
-            vSurfaceFuelAspenSavrLiveWoody->m_nativeUnits.latin1() );
+    if( EQTRACE_ON( m_trace ) )
+    {
+        m_trace->proc( "FuelAspenModel", 2, 10 );
+        m_trace->var( 'i', vSurfaceFuelAspenCuring );
+        m_trace->item( 'i', vSurfaceFuelAspenType );
+        m_trace->var( 'o', vSurfaceFuelBedDepth );
+        m_trace->var( 'o', vSurfaceFuelBedMextDead );
+        m_trace->var( 'o', vSurfaceFuelAspenLoadDead1 );
+        m_trace->var( 'o', vSurfaceFuelAspenLoadDead10 );
+        m_trace->var( 'o', vSurfaceFuelAspenLoadLiveHerb );
+        m_trace->var( 'o', vSurfaceFuelAspenLoadLiveWoody );
+        m_trace->var( 'o', vSurfaceFuelAspenSavrDead1 );
+        m_trace->var( 'o', vSurfaceFuelAspenSavrDead10 );
+        m_trace->var( 'o', vSurfaceFuelAspenSavrLiveHerb );
+        m_trace->var( 'o', vSurfaceFuelAspenSavrLiveWoody );
     }
     return;
 }
@@ -3879,9 +3140,9 @@ void EqCalc::FuelAspenParms( void )
     vSurfaceFuelSavr[2]->update( vSurfaceFuelAspenSavrLiveHerb->m_nativeValue );
     vSurfaceFuelSavr[3]->update( vSurfaceFuelAspenSavrLiveWoody->m_nativeValue );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc FuelAspenParms() 0 0\n", Margin );
+        m_trace->proc( "FuelAspenParms", 0, 0 );
     }
     return;
 }
@@ -3943,27 +3204,15 @@ void EqCalc::FuelBedHeatSink( void )
     vSurfaceFuelBedHeatSink->update( rbQig );
 
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc FuelBedHeatSink() 2 4\n", Margin );
-        fprintf( m_log, "%s  i vSurfaceFuelBedBulkDensity %g %s\n", Margin,
-            vSurfaceFuelBedBulkDensity->m_nativeValue,
-            vSurfaceFuelBedBulkDensity->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFuelBedMextDead %g %s\n", Margin,
-            vSurfaceFuelBedMextDead->m_nativeValue,
-            vSurfaceFuelBedMextDead->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFuelBedHeatSink %g %s\n", Margin,
-            vSurfaceFuelBedHeatSink->m_nativeValue,
-            vSurfaceFuelBedHeatSink->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFuelBedMoisLive %g %s\n", Margin,
-            vSurfaceFuelBedMoisLive->m_nativeValue,
-            vSurfaceFuelBedMoisLive->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFuelBedMextLive %g %s\n", Margin,
-            vSurfaceFuelBedMextLive->m_nativeValue,
-            vSurfaceFuelBedMextLive->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFuelBedMoisDead %g %s\n", Margin,
-            vSurfaceFuelBedMoisDead->m_nativeValue,
-            vSurfaceFuelBedMoisDead->m_nativeUnits.latin1() );
+        m_trace->proc( "FuelBedHeatSink", 2, 4 );
+        m_trace->var( 'i', vSurfaceFuelBedBulkDensity );
+        m_trace->var( 'i', vSurfaceFuelBedMextDead );
+        m_trace->var( 'o', vSurfaceFuelBedHeatSink );
+        m_trace->var( 'o', vSurfaceFuelBedMoisLive );
+        m_trace->var( 'o', vSurfaceFuelBedMextLive );
+        m_trace->var( 'o', vSurfaceFuelBedMoisDead );
     }
     return;
 }
@@ -4074,7 +3323,9 @@ void EqCalc::FuelBedIntermediates ( void )
         &bulkDensity, &packingRatio, &betaRatio, &windB, &windK );
     //double betaOpt = packingRatio / betaRatio;
 #elif INCLUDE_V6_CODE
-	m_Bp6SurfaceFire->setFuel( depth, deadMext, MaxParts,
+	// Fuel beds seen before (e.g., previous fuel model table rows, or either
+	// fuel of a two-fuel-model run) are restored from the shared cache.
+	appFuelBedCache()->setFuel( m_Bp6SurfaceFire, depth, deadMext, MaxParts,
         life, load, savr, heat, dens, stot, seff );
 	sigma = m_Bp6SurfaceFire->getSigma();
 	bulkDensity = m_Bp6SurfaceFire->getBulkDensity();
@@ -4095,12 +3346,10 @@ void EqCalc::FuelBedIntermediates ( void )
 //  vSurfaceFuelBedModel->activeItemName().latin1(),
 //  sigma, bulkDensity, packingRatio, betaOpt, betaRatio );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc FuelBedIntermediates() 3 12\n", Margin );
-        fprintf( m_log, "%s  i vSurfaceFuelLoadTransferEq %d %s\n", Margin,
-            vSurfaceFuelLoadTransferEq->activeItemDataIndex(),
-            vSurfaceFuelLoadTransferEq->activeItemName().latin1() );
+        m_trace->proc( "FuelBedIntermediates", 3, 12 );
+        m_trace->item( 'i', vSurfaceFuelLoadTransferEq );
         logInput( vSurfaceFuelBedDepth );
         logInput( vSurfaceFuelBedMextDead );
 		logOutput( vSurfaceFireWindFactorB );
@@ -4201,51 +3450,23 @@ void EqCalc::FuelBedModel( void )
         'f', vSurfaceFuelSavrLiveWood->m_displayDecimals );
 
     // Log results
-    if( m_log )
-    {
-        fprintf( m_log, "%sbegin proc FuelBedModel() 1 13\n", Margin );
-        fprintf( m_log, "%s  i vSurfaceFuelBedModel %d %s\n", Margin,
-            vSurfaceFuelBedModel->activeItemDataIndex(),
-            vSurfaceFuelBedModel->activeItemName().latin1() );
-        fprintf( m_log, "%s  o vSurfaceFuelLoadTransferEq %d %s\n", Margin,
-            vSurfaceFuelLoadTransferEq->activeItemDataIndex(),
-            vSurfaceFuelLoadTransferEq->activeItemName().latin1() );
-        fprintf( m_log, "%s  o vSurfaceFuelBedDepth %g %s\n", Margin,
-            vSurfaceFuelBedDepth->m_nativeValue,
-            vSurfaceFuelBedDepth->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFuelBedMextDead %g %s\n", Margin,
-            vSurfaceFuelBedMextDead->m_nativeValue,
-            vSurfaceFuelBedMextDead->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFuelHeatDead %g %s\n", Margin,
-            vSurfaceFuelHeatDead->m_nativeValue,
-            vSurfaceFuelHeatDead->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFuelHeatLive %g %s\n", Margin,
-            vSurfaceFuelHeatLive->m_nativeValue,
-            vSurfaceFuelHeatLive->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFuelLoadDead1 %g %s\n", Margin,
-            vSurfaceFuelLoadDead1->m_nativeValue,
-            vSurfaceFuelLoadDead1->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFuelLoadDead10 %g %s\n", Margin,
-            vSurfaceFuelLoadDead10->m_nativeValue,
-            vSurfaceFuelLoadDead10->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFuelLoadDead100 %g %s\n", Margin,
-            vSurfaceFuelLoadDead100->m_nativeValue,
-            vSurfaceFuelLoadDead100->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFuelLoadLiveHerb %g %s\n", Margin,
-            vSurfaceFuelLoadLiveHerb->m_nativeValue,
-            vSurfaceFuelLoadLiveHerb->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFuelLoadLiveWood %g %s\n", Margin,
-            vSurfaceFuelLoadLiveWood->m_nativeValue,
-            vSurfaceFuelLoadLiveWood->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFuelSavrDead1 %g %s\n", Margin,
-            vSurfaceFuelSavrDead1->m_nativeValue,
-            vSurfaceFuelSavrDead1->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFuelSavrLiveHerb %g %s\n", Margin,
-            vSurfaceFuelSavrLiveHerb->m_nativeValue,
-            vSurfaceFuelSavrLiveHerb->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFuelSavrLiveWood %g %s\n", Margin,
-            vSurfaceFuelSavrLiveWood->m_nativeValue,
-            vSurfaceFuelSavrLiveWood->m_nativeUnits.latin1() );
+    if( EQTRACE_ON( m_trace ) )
+    {
+        m_trace->proc( "FuelBedModel", 1, 13 );
+        m_trace->item( 'i', vSurfaceFuelBedModel );
+        m_trace->item( 'o', vSurfaceFuelLoadTransferEq );
+        m_trace->var( 'o', vSurfaceFuelBedDepth );
+        m_trace->var( 'o', vSurfaceFuelBedMextDead );
+        m_trace->var( 'o', vSurfaceFuelHeatDead );
+        m_trace->var( 'o', vSurfaceFuelHeatLive );
+        m_trace->var( 'o', vSurfaceFuelLoadDead1 );
+        m_trace->var( 'o', vSurfaceFuelLoadDead10 );
+        m_trace->var( 'o', vSurfaceFuelLoadDead100 );
+        m_trace->var( 'o', vSurfaceFuelLoadLiveHerb );
+        m_trace->var( 'o', vSurfaceFuelLoadLiveWood );
+        m_trace->var( 'o', vSurfaceFuelSavrDead1 );
+        m_trace->var( 'o', vSurfaceFuelSavrLiveHerb );
+        m_trace->var( 'o', vSurfaceFuelSavrLiveWood );
     }
     return;
 }
@@ -4325,12 +3546,130 @@ void EqCalc::FuelBedParms( void )
     vSurfaceFuelSavr[4]->update( vSurfaceFuelSavrLiveWood->m_nativeValue );
     vSurfaceFuelSavr[5]->update( vSurfaceFuelSavrLiveHerb->m_nativeValue );
     // Log results
-    if( m_log )
-    {
-        fprintf( m_log, "%sbegin proc FuelBedParms() 0 0\n", Margin );
-    }
-    return;
-}
+    if( EQTRACE_ON( m_trace ) )
+    {
+        m_trace->proc( "FuelBedParms", 0, 0 );
+    }
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \class FuelBedWeightedInput
+ *
+ *  \brief Configuration and site inputs shared by both fuel models of a
+ *  FuelBedWeighted() call, read once before either fuel bed is burned.
+ */
+
+class FuelBedWeightedInput
+{
+public:
+    bool   m_windAdjCalc;       //!< Wind adjustment factor is from the canopy
+    bool   m_midflameInput;     //!< Midflame wind speed is an input
+    bool   m_windLimit;         //!< Apply the maximum reliable wind speed
+    bool   m_betaVector;        //!< Spread vector is beta (from the ignition point)
+    bool   m_psiFli;            //!< Vector fireline intensity is from the psi spread rate
+    bool   m_psiRos;            //!< Vector spread rate is from the psi spread rate
+    bool   m_psiFixed;          //!< Psi is head, back, or flank (m_psi)
+    bool   m_psiFromUpslope;    //!< Psi is from the fire front vector direction
+    double m_psi;               //!< Fixed psi (degrees)
+    double m_moisDead1;         //!< Dead 1-h fuel moisture (fraction)
+    double m_moisDead10;        //!< Dead 10-h fuel moisture (fraction)
+    double m_moisDead100;       //!< Dead 100-h fuel moisture (fraction)
+    double m_moisDead1000;      //!< Dead 1000-h fuel moisture (fraction)
+    double m_moisLiveHerb;      //!< Live herbaceous fuel moisture (fraction)
+    double m_moisLiveWood;      //!< Live woody fuel moisture (fraction)
+    double m_canopyCover;       //!< Canopy cover (fraction)
+    double m_canopyHt;          //!< Canopy height (ft)
+    double m_crownRatio;        //!< Crown ratio (fraction)
+    double m_waf;               //!< Input wind adjustment factor (fraction)
+    double m_windAt20Ft;        //!< 20-ft wind speed (mi/h)
+    double m_windAtMidflame;    //!< Input midflame wind speed (mi/h)
+    double m_windDir;           //!< Wind direction from upslope (degrees)
+    double m_slope;             //!< Slope steepness (rise/reach)
+    double m_aspect;            //!< Aspect (degrees from north)
+    double m_vectorDir;         //!< Vector direction from upslope (degrees)
+    double m_elapsed;           //!< Elapsed time (min)
+};
+
+//------------------------------------------------------------------------------
+/*! \class FuelBedWeightedFire
+ *
+ *  \brief Every intermediate of a single fuel bed's surface fire, named
+ *  after and derived exactly as the EqVar each EqCalc function would store.
+ */
+
+class FuelBedWeightedFire
+{
+public:
+    int    m_transferEq;        //!< Load transfer equation item index
+    int    m_life[MaxParts];    //!< Particle life category
+    double m_dens[MaxParts];    //!< Particle density (lb/ft3)
+    double m_heat[MaxParts];    //!< Particle heat of combustion (Btu/lb)
+    double m_load[MaxParts];    //!< Particle load before transfer (lb/ft2)
+    double m_savr[MaxParts];    //!< Particle surface area-to-volume ratio (ft2/ft3)
+    double m_stot[MaxParts];    //!< Particle total mineral content (fraction)
+    double m_seff[MaxParts];    //!< Particle effective mineral content (fraction)
+    double m_mois[MaxParts];    //!< Particle moisture (fraction)
+    double m_transferFraction;  //!< vSurfaceFuelLoadTransferFraction
+    double m_deadFraction;      //!< vSurfaceFuelBedDeadFraction
+    double m_loadDead;          //!< vSurfaceFuelLoadDead
+    double m_loadDeadHerb;      //!< vSurfaceFuelLoadDeadHerb
+    double m_loadLive;          //!< vSurfaceFuelLoadLive
+    double m_loadUndeadHerb;    //!< vSurfaceFuelLoadUndeadHerb
+    double m_windB;             //!< vSurfaceFireWindFactorB
+    double m_windK;             //!< vSurfaceFireWindFactorK
+    double m_betaRatio;         //!< vSurfaceFuelBedBetaRatio
+    double m_bulkDensity;       //!< vSurfaceFuelBedBulkDensity
+    double m_packingRatio;      //!< vSurfaceFuelBedPackingRatio
+    double m_sigma;             //!< vSurfaceFuelBedSigma
+    double m_moisDead;          //!< vSurfaceFuelBedMoisDead
+    double m_moisLive;          //!< vSurfaceFuelBedMoisLive
+    double m_mextLive;          //!< vSurfaceFuelBedMextLive
+    double m_heatSink;          //!< vSurfaceFuelBedHeatSink
+    double m_propFlux;          //!< vSurfaceFirePropagatingFlux
+    double m_rxInt;             //!< vSurfaceFireReactionInt
+    double m_rxIntDead;         //!< vSurfaceFireReactionIntDead
+    double m_rxIntLive;         //!< vSurfaceFireReactionIntLive
+    double m_ros0;              //!< vSurfaceFireNoWindRate
+    double m_waf;               //!< vWindAdjFactor
+    int    m_wafMethod;         //!< vWindAdjMethod
+    double m_crownFraction;     //!< vTreeCanopyCrownFraction
+    double m_wmf;               //!< vWindSpeedAtMidflame
+    double m_rosHead;           //!< vSurfaceFireSpreadAtHead
+    double m_dirMax;            //!< vSurfaceFireMaxDirFromUpslope
+    double m_effWind;           //!< vSurfaceFireEffWindAtHead
+    double m_maxWind;           //!< vSurfaceFireWindSpeedLimit
+    int    m_windLimit;         //!< vSurfaceFireWindSpeedFlag
+    double m_windFactor;        //!< vSurfaceFireWindFactor
+    double m_slopeFactor;       //!< vSurfaceFireSlopeFactor
+    double m_distHead;          //!< vSurfaceFireDistAtHead
+    double m_lwRatio;           //!< vSurfaceFireLengthToWidth
+    double m_eccent;            //!< vSurfaceFireEccentricity
+    double m_beta;              //!< vSurfaceFireVectorBeta
+    double m_psi;               //!< vSurfaceFireVectorPsi
+    double m_theta;             //!< vSurfaceFireVectorTheta
+    double m_rosVector;         //!< vSurfaceFireSpreadAtVector
+    double m_rosBeta;           //!< vSurfaceFireSpreadAtBeta
+    double m_rosBack;           //!< vSurfaceFireSpreadAtBack
+    double m_distBack;          //!< vSurfaceFireDistAtBack
+    double m_lengDist;          //!< vSurfaceFireLengDist
+    double m_f;                 //!< vSurfaceFireEllipseF
+    double m_g;                 //!< vSurfaceFireEllipseG
+    double m_h;                 //!< vSurfaceFireEllipseH
+    double m_widthDist;         //!< vSurfaceFireWidthDist
+    double m_rosPsi;            //!< vSurfaceFireSpreadAtPsi
+    double m_resTime;           //!< vSurfaceFireResidenceTime
+    double m_fliVector;         //!< vSurfaceFireLineIntAtVector
+    double m_hpua;              //!< vSurfaceFireHeatPerUnitArea
+    double m_fliHead;           //!< vSurfaceFireLineIntAtHead
+    double m_fliBeta;           //!< vSurfaceFireLineIntAtBeta
+    double m_fliPsi;            //!< vSurfaceFireLineIntAtPsi
+    double m_flHead;            //!< vSurfaceFireFlameLengAtHead
+    double m_flVector;          //!< vSurfaceFireFlameLengAtVector
+    double m_flBeta;            //!< vSurfaceFireFlameLengAtBeta
+    double m_flPsi;             //!< vSurfaceFireFlameLengAtPsi
+    double m_effWindVector;     //!< vSurfaceFireEffWindAtVector
+};
 
 //------------------------------------------------------------------------------
 /*! \brief FuelBedWeighted
@@ -4365,6 +3704,13 @@ void EqCalc::FuelBedParms( void )
  *      vSurfaceFuelMoisLiveWood (fraction)
  *      vSurfaceFuelLoadTransferFraction (fraction)
  *      vSurfaceFireVectorDirFromUpslope (deg)
+ *
+ *  Notes
+ *      Each fuel bed is burned by FuelBedWeightedBed(), which derives every
+ *      intermediate in local variables with the same fire behavior calls the
+ *      individual EqCalc functions make.  The second fuel model's
+ *      intermediates are then stored just once with FuelBedWeightedStore().
+ *      Traced runs also store and log each fuel bed's steps as it is burned.
  */
 
 void EqCalc::FuelBedWeighted( void )
@@ -4386,6 +3732,102 @@ void EqCalc::FuelBedWeighted( void )
     // Determine individual fuel model outputs
     //----------------------------------------
 
+    FuelBedWeightedFire fire[2];
+
+    // Moisture and 20-ft wind speed are the same for both fuel models
+    if ( prop->boolean( "surfaceConfMoisLifeCat" ) )
+    {
+        FuelMoisLifeClass();
+    }
+    else if ( prop->boolean( "surfaceConfMoisDeadHerbWood" ) )
+    {
+        FuelMoisDeadHerbWood();
+    }
+    else if ( prop->boolean( "surfaceConfMoisScenario" ) )
+    {
+        FuelMoisScenarioModel();
+    }
+    if ( prop->boolean( "surfaceConfWindSpeedAt10M" )
+      || prop->boolean( "surfaceConfWindSpeedAt10MCalc" ) )
+    {
+        WindSpeedAt20Ft();
+    }
+
+    FuelBedWeightedInput in;
+    in.m_windAdjCalc = prop->boolean( "surfaceConfWindSpeedAt10MCalc" )
+                    || prop->boolean( "surfaceConfWindSpeedAt20FtCalc" );
+    in.m_midflameInput = prop->boolean( "surfaceConfWindSpeedAtMidflame" );
+    in.m_windLimit = prop->boolean( "surfaceConfWindLimitApplied" )
+                  && ! prop->boolean( "surfaceConfFuelAspen" );
+    in.m_betaVector = prop->boolean( "surfaceConfSpreadDirPointSourcePsi" )
+                   || prop->boolean( "surfaceConfSpreadDirPointSourceBeta" );
+    in.m_psiFli = in.m_betaVector
+                ? prop->boolean( "surfaceConfSpreadDirPointSourcePsi" )
+                : true;
+    in.m_psiRos = ! in.m_betaVector;
+    in.m_psiFixed = true;
+    in.m_psiFromUpslope = false;
+    in.m_psi = 0.;
+    if ( prop->boolean( "surfaceConfSpreadDirHead" ) )
+    {
+        in.m_psi = 0.;
+    }
+    else if ( prop->boolean( "surfaceConfSpreadDirBack" ) )
+    {
+        in.m_psi = 180.;
+    }
+    else if ( prop->boolean( "surfaceConfSpreadDirFlank" ) )
+    {
+        in.m_psi = 90.;
+    }
+    else
+    {
+        in.m_psiFixed = false;
+        in.m_psiFromUpslope = prop->boolean( "surfaceConfSpreadDirFireFront" );
+    }
+    in.m_moisDead1      = vSurfaceFuelMoisDead1->m_nativeValue;
+    in.m_moisDead10     = vSurfaceFuelMoisDead10->m_nativeValue;
+    in.m_moisDead100    = vSurfaceFuelMoisDead100->m_nativeValue;
+    in.m_moisDead1000   = vSurfaceFuelMoisDead1000->m_nativeValue;
+    in.m_moisLiveHerb   = vSurfaceFuelMoisLiveHerb->m_nativeValue;
+    in.m_moisLiveWood   = vSurfaceFuelMoisLiveWood->m_nativeValue;
+    in.m_canopyCover    = vTreeCanopyCover->m_nativeValue;
+    in.m_canopyHt       = vTreeCoverHt->m_nativeValue;
+    in.m_crownRatio     = vTreeCrownRatio->m_nativeValue;
+    in.m_waf            = vWindAdjFactor->m_nativeValue;
+    in.m_windAt20Ft     = vWindSpeedAt20Ft->m_nativeValue;
+    in.m_windAtMidflame = vWindSpeedAtMidflame->m_nativeValue;
+    in.m_windDir        = vWindDirFromUpslope->m_nativeValue;
+    in.m_slope          = vSiteSlopeFraction->m_nativeValue;
+    in.m_aspect         = vSiteAspectDirFromNorth->m_nativeValue;
+    in.m_vectorDir      = vSurfaceFireVectorDirFromUpslope->m_nativeValue;
+    in.m_elapsed        = vSurfaceFireElapsedTime->m_nativeValue;
+
+    // The load transfer equation item index of each fuel model
+    for ( int i=0; i<2; i++ )
+    {
+        vSurfaceFuelLoadTransferEq->updateItem( fm[i]->m_transfer );
+        fire[i].m_transferEq = vSurfaceFuelLoadTransferEq->activeItemDataIndex();
+    }
+
+    // Psi-based vectors of each fuel model are oriented on the fire
+    // ellipse left by the fuel model (or the run) before it
+    FuelBedWeightedFire prev;
+    prev.m_psi = vSurfaceFireVectorPsi->m_nativeValue;
+    prev.m_f   = vSurfaceFireEllipseF->m_nativeValue;
+    prev.m_g   = vSurfaceFireEllipseG->m_nativeValue;
+    prev.m_h   = vSurfaceFireEllipseH->m_nativeValue;
+
+    // Each fuel bed burns in its own Bp6SurfaceFire,
+    // leaving the secondary fuel bed in m_Bp6SurfaceFire
+    FuelBedWeightedBed( fm[0], m_Bp6SurfaceFire1, &in, &prev, &fire[0] );
+    FuelBedWeightedBed( fm[1], m_Bp6SurfaceFire, &in, &fire[0], &fire[1] );
+    if ( ! EQTRACE_ON( m_trace ) )
+    {
+        // Traced runs have already stored each fuel bed as it burned
+        FuelBedWeightedStore( fm[1], &in, &fire[1] );
+    }
+
     // Intermediate outputs for each fuel model
     double rosh[2], rosv[2];	// ros at head and vector
 	double flih[2], fliv[2];	// fireline intensity at head and vector
@@ -4398,416 +3840,23 @@ void EqCalc::FuelBedWeighted( void )
 	int    wsf[2];				// wind speed flag
 	for ( int i=0; i<2; i++ )
     {
-		rosh[i] = rosv[i] = flih[i] = fliv[i] = flh[i] = flv[i] = flw[i] = 0.;
-		ewsh[i] = ewsv[i] = rxi[i] = hua[i] = mxd[i] = waf[i] = wmf[i] =wsl[i] = wsf[i] = 0.;
-	}
-
-    // Calculate fire outputs for each fuel model
-    for ( int i=0; i<2; i++ )
-    {
-        // Load the 13 fuel attributes into the equation tree's fuel model
-        // This replaces the call to FuelBedModel() which normally updates these variables
-        vSurfaceFuelBedDepth->update( fm[i]->m_depth );
-        vSurfaceFuelBedMextDead->update( fm[i]->m_mext );
-        vSurfaceFuelHeatDead->update( fm[i]->m_heatDead );
-        vSurfaceFuelHeatLive->update( fm[i]->m_heatLive );
-        vSurfaceFuelLoadDead1->update( fm[i]->m_load1 );
-        vSurfaceFuelLoadDead10->update( fm[i]->m_load10 );
-        vSurfaceFuelLoadDead100->update( fm[i]->m_load100 );
-        vSurfaceFuelLoadLiveHerb->update( fm[i]->m_loadHerb );
-        vSurfaceFuelLoadLiveWood->update( fm[i]->m_loadWood );
-        vSurfaceFuelSavrDead1->update( fm[i]->m_savr1 );
-        vSurfaceFuelSavrLiveHerb->update( fm[i]->m_savrHerb );
-        vSurfaceFuelSavrLiveWood->update( fm[i]->m_savrWood );
-		vSurfaceFuelLoadTransferEq->updateItem( fm[i]->m_transfer );
-
-        // Load the equation tree's fuel model into fuel parameter arrays
-        FuelBedParms();
-
-        // Load life class moistures into the equation tree time-lag classes
-        if ( prop->boolean( "surfaceConfMoisLifeCat" ) )
-        {
-            FuelMoisLifeClass();		// vSurfaceFuelMoisLifeDead, vSurfaceFuelMoisLifeLive
-        }
-        // Load dead category and live class moistures into the equation tree time-lag classes
-        else if ( prop->boolean( "surfaceConfMoisDeadHerbWood" ) )
-        {
-            FuelMoisDeadHerbWood();		// vSurfaceFuelMoisLifeDead, vSurfaceFuelMoisLiveHerb, vSurfaceFuelMoisLiveWood
-        }
-        // or load moisture scenario into the equation tree time-lag classes
-        else if ( prop->boolean( "surfaceConfMoisScenario" ) )
-        {
-            FuelMoisScenarioModel();
-        }
-        // Load equation tree time-lag classes into the fuel parameter array
-        // begin proc FuelMoisTimeLag() 14 8
-        //  i vSurfaceFuelMoisDead1
-        //  i vSurfaceFuelMoisDead10
-        //  i vSurfaceFuelMoisDead100
-        //  i vSurfaceFuelMoisDead1000
-        //  i vSurfaceFuelMoisLiveHerb
-        //  i vSurfaceFuelMoisLiveWood
-        //  i vSurfaceFuelLife[0..9] 
-        //  i vSurfaceFuelSavr[0..9]
-        //  o vSurfaceFuelMois[0..9]
-        FuelMoisTimeLag();
-
-		// Perform dynamic fuel loading adjustments
-        // begin proc FuelLoadTransferFraction() 2 6
-		//  i vSurfaceFuelMoisLiveHerb
-        //  o vSurfaceFuelLoadTransferFraction
-		FuelLoadTransferFraction();
-
-        // begin proc FuelBedIntermediates() 3 11
-		//  i vSurfaceFuelLoadTransferEq
-        //  i vSurfaceFuelBedDepth
-        //  i vSurfaceFuelBedMextDead
-        //  o vSurfaceFuelBedBetaRatio
-        //  o vSurfaceFuelBedBulkDensity
-        //  o vSurfaceFuelBedPackingRatio
-        //  o vSurfaceFuelBedSigma
-        //  o vSurfaceFuelLoadTransferFraction ?? TODO CHECK THIS!!
-        //  o vSurfaceFuelLoadDeadHerb
-        //  o vSurfaceFuelLoadUndeadHerb
-        //  o vSurfaceFuelLoadDead
-        //  o vSurfaceFuelLoadLive
-        //  o vSurfaceFuelBedDeadFraction
-        //  o vSurfaceFuelBedLiveFraction
-        FuelBedIntermediates();
-
-        // begin proc FuelBedHeatSink() 2 4
-        //  i vSurfaceFuelBedBulkDensity
-        //  i vSurfaceFuelBedMextDead
-        //  o vSurfaceFuelBedHeatSink
-        //  o vSurfaceFuelBedMoisLive
-        //  o vSurfaceFuelBedMextLive
-        //  o vSurfaceFuelBedMoisDead
-        FuelBedHeatSink();
-
-        // begin proc FirePropagatingFlux() 2 1
-        //  i vSurfaceFuelBedPackingRatio
-        //  i vSurfaceFuelBedSigma
-        //  o vSurfaceFirePropagatingFlux
-        FirePropagatingFlux();
-
-        // begin proc FireReactionIntensity() 4 1
-		//  i vSurfaceFuelBedMextDead
-        //  i vSurfaceFuelBedMoisDead
-        //  i vSurfaceFuelBedMextLive
-        //  i vSurfaceFuelBedMoisLive
-        //  o vSurfaceFireReactionInt
-        FireReactionInt();
-        rxi[i] = vSurfaceFireReactionInt->m_nativeValue;
-
-		// begin proc FireNoWindRate() 3 1
-        //  i vSurfaceFuelBedHeatSink
-        //  i vSurfaceFireReactionInt
-        //  i vSurfaceFirePropagatingFlux
-        //  o vSurfaceFireNoWindRate
-        FireNoWindRate();
-
-		// If necessary, calculate wind adjustment factor from canopy and fuel parameters
-		if ( prop->boolean( "surfaceConfWindSpeedAt10MCalc" )
-		  || prop->boolean( "surfaceConfWindSpeedAt20FtCalc" ) )
-		{
-			WindAdjFactor();
-		}
-		waf[i] = vWindAdjFactor->m_nativeValue;
-
-		// If necessary, calculate 20-ft wind speed from 10-m wind speed
-		if ( prop->boolean( "surfaceConfWindSpeedAt10M" )
-		  || prop->boolean( "surfaceConfWindSpeedAt10MCalc" ) )
-		{
-			WindSpeedAt20Ft();
-		}
-
-		// If necessary, calculate midflame wind speed from 20-ft wind speed and wind adj factor
-		if ( ! prop->boolean( "surfaceConfWindSpeedAtMidflame" ) )
-		{
-			WindSpeedAtMidflame();
-		}
-		wmf[i] = vWindSpeedAtMidflame->m_nativeValue;
-
-        // begin proc FireSpreadAtHead() 4 5
-        //  i vSurfaceFireNoWindRate
-        //  i vSiteSlopeFraction
-        //  i vWindDirFromUpslope
-        //  i vWindSpeedAtMidflame
-        //  o vSurfaceFireSpreadAtHead
-        //  o vSurfaceFireMaxDirFromUpslope
-        //  o vSurfaceFireEffWindAtHead
-        //  o vSurfaceFireWindSpeedLimit
-        //  o vSurfaceFireWindSpeedFlag
-        //  o vSurfaceFireWindFactor
-        //  o vSurfaceFireWindFactorB
-        //  o vSurfaceFireWindFactorK
-        //  o vSurfaceFireSlopeFactor
-        FireSpreadAtHead();
-        rosh[i] = vSurfaceFireSpreadAtHead->m_nativeValue;
-        mxd[i]  = vSurfaceFireMaxDirFromUpslope->m_nativeValue;
-        ewsh[i] = vSurfaceFireEffWindAtHead->m_nativeValue;
-        wsl[i]  = vSurfaceFireWindSpeedLimit->m_nativeValue;
+        rosh[i] = fire[i].m_rosHead;
+        rosv[i] = fire[i].m_rosVector;
+        flih[i] = fire[i].m_fliHead;
+        fliv[i] = fire[i].m_fliVector;
+        flh[i]  = fire[i].m_flHead;
+        flv[i]  = fire[i].m_flVector;
+        ewsh[i] = fire[i].m_effWind;
+        ewsv[i] = fire[i].m_effWindVector;
+        flw[i]  = fire[i].m_lwRatio;
+        rxi[i]  = fire[i].m_rxInt;
+        hua[i]  = fire[i].m_hpua;
+        mxd[i]  = fire[i].m_dirMax;
+        waf[i]  = fire[i].m_waf;
+        wmf[i]  = fire[i].m_wmf;
+        wsl[i]  = fire[i].m_maxWind;
 		wsf[i]  = ( wmf[i] > wsl[i] ) ? 1 : 0;
-
-        // begin proc FireDistAtHead() 2 1
-		//  i vSurfaceFireSpreadAtHead
-        //  i vSurfaceFireElapsedTime
-        //  o vSurfaceFireDistAtHead
-		FireDistAtHead();
-
-        // begin proc FireLengthToWidth() 1 1
-		//  i vSurfaceFireEffWindAtHead
-        //  o vSurfaceFireLengthToWidth
-        FireLengthToWidth();
-		flw[i] = vSurfaceFireLengthToWidth->m_nativeValue;
-
-        // begin proc FireEccentricity() 1 1
-        //  i vSurfaceFireLengthToWidth
-        //  o vSurfaceFireEccentricity
-        FireEccentricity();
-
-		// Calculate beta and psi vectors
-		bool psi_fli = true;
-		bool psi_ros = true;
-		bool beta_vector = prop->boolean( "surfaceConfSpreadDirPointSourcePsi" )
-		  || prop->boolean( "surfaceConfSpreadDirPointSourceBeta" );
-
-		if ( beta_vector )
-		{
-			// The upslope direction IS beta
-			// begin proc FireVectorBetaFromUpslope() 2 1
-			//  i vSurfaceFireMaxDirFromUpslope
-			//  i vSurfaceFireVectorDirFromUpslope
-			//  o vSurfaceFireVectorBeta
-			FireVectorBetaFromUpslope();
-
-			psi_ros = false;
-			psi_fli = prop->boolean( "surfaceConfSpreadDirPointSourcePsi" );
-		}
-		else	// Psi-based directions
-		{
-			if ( prop->boolean( "surfaceConfSpreadDirHead" ) )
-			{
- 				vSurfaceFireVectorPsi->update( 0. );
-			}
-			else if ( prop->boolean( "surfaceConfSpreadDirBack" ) )
-			{
- 				vSurfaceFireVectorPsi->update( 180. );
-			}
-			else if ( prop->boolean( "surfaceConfSpreadDirFlank" ) )
-			{
-	 			vSurfaceFireVectorPsi->update( 90. );
-			}
-			else if ( prop->boolean( "surfaceConfSpreadDirFireFront" ) )
-			{
-		        // begin proc FireVectorPsiFromUpslope() 2 1
-				//  i vSurfaceFireMaxDirFromUpslope
-				//  i vSurfaceFireVectorDirFromUpslope
-				//  o vSurfaceFireVectorPsi
-				FireVectorPsiFromUpslope();
-			}
-
-			// begin proc FireVectorThetaFromPsi() 3 1
-			//  i vSurfaceFireEllipseF
-			//  i vSurfaceFireEllipseH
-			//  i vSurfaceFireVectorPsi
-			//  o vSurfaceFireVectorTheta
-			FireVectorThetaFromPsi();
-
-			// begin proc FireVectorBetaFromTheta() 4 1
-			//  i vSurfaceFireEllipseF
-			//  i vSurfaceFireEllipseG
-			//  i vSurfaceFireEllipseH
-			//  i vSurfaceFireVectorTheta
-			//  o vSurfaceFireVectorBeta
-			FireVectorBetaFromTheta();
-		}
-
-		// begin proc FireSpreadAtVectorFromBeta() 3 1
-		//  i vSurfaceFireEccentricity
-		//  i vSurfaceFireSpreadAtHead
-		//  i vSurfaceFireVectorBeta
-		//  o vSurfaceFireSpreadAtVector
-		FireSpreadAtVectorFromBeta();
-        rosv[i] = vSurfaceFireSpreadAtVector->m_nativeValue;
-
-		// Calculate the fire spread from ignition point (BETA)
-		// begin proc FireSpreadAtBeta() 3 1
-        //  i vSurfaceFireEccentricity
-        //  i vSurfaceFireSpreadAtHead
-        //  i vSurfaceFireVectorBeta
-        //  o vSurfaceFireSpreadAtBeta
-		FireSpreadAtBeta();
-
-        // begin proc FireSpreadAtBack() 2 1
-        //  i vSurfaceFireEccentricity
-        //  i vSurfaceFireSpreadAtHead
-        //  o vSurfaceFireSpreadAtBack
-		FireSpreadAtBack();
-
-        // begin proc FireDistAtBack() 2 1
-        //  i vSurfaceFireSpreadAtBack
-        //  i vSurfaceFireElapsedTime
-        //  o vSurfaceFireDistAtBack
-		FireDistAtBack();
-
-        // begin proc FireLengDist() 2 1
-        //  i vSurfaceFireDistAtBack
-        //  i vSurfaceFireDistAtHead
-        //  o vSurfaceFireLengDist
-		FireLengDist();
-
-        // begin proc FireEllipseF() 1 1
-        //  i vSurfaceFireLengDist
-        //  o vSurfaceFireEllipseF
-		FireEllipseF();
-
-        // begin proc FireEllipseG() 2 1
-        //  i vSurfaceFireLengDist
-        //  i vSurfaceFireDistAtBack
-        //  o vSurfaceFireEllipseG
-		FireEllipseG();
-
-        // begin proc FireWidthDist() 2 1
-        //  i vSurfaceFireLengDist
-        //  i vSurfaceFireLengthToWidth
-        //  o vSurfaceFireWidthDist
-		FireWidthDist();
-
-        // begin proc FireEllipseH() 1 1
-        //  i vSurfaceFireWidthDist
-        //  o vSurfaceFireEllipseH
-		FireEllipseH();
-
-		// If using Beta vectors, need to derive Psi
-		if ( beta_vector )
-		{
-			// begin proc FireVectorThetaFromBeta() 4 1
-			//  i vSurfaceFireEllipseF
-			//  i vSurfaceFireEllipseG
-			//  i vSurfaceFireEllipseH
-			//  i vSurfaceFireVectorBeta
-			//  o vSurfaceFireVectorTheta
-			FireVectorThetaFromBeta();
-
-			// begin proc FireVectorPsiFromTheta() 3 1
-			//  i vSurfaceFireEllipseF
-			//  i vSurfaceFireEllipseH
-			//  i vSurfaceFireVectorTheta
-			//  o vSurfaceFireVectorPsi
-			FireVectorPsiFromTheta();
-		}
-		else
-		{
-		}
-
-        //begin proc FireSpreadAtPsi() 4 1
-        //  i vSurfaceFireEllipseF
-        //  i vSurfaceFireEllipseG
-        //  i vSurfaceFireEllipseH
-        //  i vSurfaceFireElaspedTime
-		//  i vSurfaceFireVectorPsi
-        //  o vSurfaceFireSpreadAtPsi
-		FireSpreadAtPsi();
-
-		// Calculate and store fire spread at vector based upon confiuration
-		if ( psi_ros )
-		{
-			// begin proc FireSpreadAtVectorFromPsi() 4 1
-		    //  i vSurfaceFireEllipseF
-			//  i vSurfaceFireEllipseG
-			//  i vSurfaceFireEllipseH
-	        //  i vSurfaceFireElaspedTime
-		    //  o vSurfaceFireSpreadAtVector
-			FireSpreadAtVectorFromPsi();
-	        rosv[i] = vSurfaceFireSpreadAtVector->m_nativeValue;
-		}
-
-        // Calculate fire residence time for FLI computations
-        //  i vSurfaceFuelBedSigma
-        //  o vSurfaceFireResidenceTime
-        FireResidenceTime();
-
-        // Calculate and store the fireline intensity at the requested vector
-		if ( psi_fli )
-		{
-			//begin proc FireLineIntAtVectorFromPsi() 3 1
-			//  i vSurfaceFireSpreadAtPsi
-			//  i vSurfaceFireResidenceTime
-			//  i vSurfaceFireReactionInt
-			//  o vSurfaceFireLineIntAtVector
-			FireLineIntAtVectorFromPsi();
-	        fliv[i] = vSurfaceFireLineIntAtVector->m_nativeValue;
-			//FireLineIntAtPsi();
-			//fliv[i] = vSurfaceFireLineIntAtPsi->m_nativeValue;
-		}
-		else
-		{
-
-			// begin proc FireLineIntAtVectorFromBeta() 3 1
-			//  i vSurfaceFireSpreadAtBeta
-			//  i vSurfaceFireResidenceTime
-			//  i vSurfaceFireReactionInt
-			//  o vSurfaceFireLineIntAtVector
-			FireLineIntAtVectorFromBeta();
-	        fliv[i] = vSurfaceFireLineIntAtVector->m_nativeValue;
-			// FireLineIntAtBeta();
-			// fliv[i] = vSurfaceFireLineIntAtBeta->m_nativeValue;
-		}
-
-        // Calculate and store vSurfaceFireHeatPerUnitArea
-        // begin proc FireHeatPerUnitArea() 2 1
-        //  i vSurfaceFireReactionInt
-        //  i vSurfaceFireResidenceTime
-        //  o vSurfaceFireHeatPerUnitArea
-        FireHeatPerUnitArea();
-        hua[i] = vSurfaceFireHeatPerUnitArea->m_nativeValue;
-
-		// Calculate vSurfaceFireLineIntAtHead
-        FireLineIntAtHead();
-        flih[i] = vSurfaceFireLineIntAtHead->m_nativeValue;
-
-		// Calculate beta and psi spread, fireline intensity, and flame length
-        // begin proc FireLineIntAtBeta() 3 1
-        //  i vSurfaceFireSpreadAtBeta
-        //  i vSurfaceFireResidenceTime
-        //  i vSurfaceFireReactionInt
-        //  o vSurfaceFireLineIntAtBeta
-		FireLineIntAtBeta();
-
-        //begin proc FireLineIntAtPsi() 3 1
-        //  i vSurfaceFireSpreadAtPsi
-        //  i vSurfaceFireResidenceTime
-        //  i vSurfaceFireReactionInt
-        //  o vSurfaceFireLineIntAtPsi
-		FireLineIntAtPsi();
-
-        // Calculate vSurfaceFireFlameLengAtHead
-        FireFlameLengAtHead();
-        flh[i] = vSurfaceFireFlameLengAtHead->m_nativeValue;
-
-        // begin proc FireFlameLengAtVector() 1 1
-        //  i vSurfaceFireLineIntAtVector
-        //  o vSurfaceFireFlameLengAtVector
-        FireFlameLengAtVector();
-        flv[i] = vSurfaceFireFlameLengAtVector->m_nativeValue;
-
-        // begin proc FireFlameLengAtBeta() 1 1
-        //  i vSurfaceFireLineIntAtBeta
-        //  o vSurfaceFireFlameLengAtBeta
-		FireFlameLengAtBeta();
-
-        // begin proc FireFlameLengAtPsi() 1 1
-        //  i vSurfaceFireLineIntAtPsi
-        //  o vSurfaceFireFlameLengAtPsi
-		FireFlameLengAtPsi();
-
-        // Calculate vSurfaceFireEffWindAtVector
-		// DO WE NEED THIS ANYMORE??
-        FireEffWindAtVector();
-        ewsv[i] = vSurfaceFireEffWindAtVector->m_nativeValue;
-    }
-
+	}
     //------------------------------------------------
     // Determine and store combined fuel model outputs
     //------------------------------------------------
@@ -4923,68 +3972,792 @@ void EqCalc::FuelBedWeighted( void )
     // Log results
     //------------
 
-    if( m_log )
-    {
-        fprintf( m_log, "%sbegin proc FuelBedWeighted() 6 13\n", Margin );
-        fprintf( m_log, "%s  i vSurfaceFuelBedModel1 %d %s\n", Margin,
-            vSurfaceFuelBedModel1->activeItemDataIndex(),
-            vSurfaceFuelBedModel1->activeItemName().latin1() );
-        fprintf( m_log, "%s  i vSurfaceFuelBedModel2 %d %s\n", Margin,
-            vSurfaceFuelBedModel2->activeItemDataIndex(),
-            vSurfaceFuelBedModel2->activeItemName().latin1() );
-        fprintf( m_log, "%s  i vSurfaceFuelBedCoverage1 %g %s\n", Margin,
-            vSurfaceFuelBedCoverage1->m_nativeValue,
-            vSurfaceFuelBedCoverage1->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSiteSlopeFraction %g %s\n", Margin,
-            vSiteSlopeFraction->m_nativeValue,
-            vSiteSlopeFraction->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vWindDirFromUpslope %g %s\n", Margin,
-            vWindDirFromUpslope->m_nativeValue,
-            vWindDirFromUpslope->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vWindSpeedAtMidflame %g %s\n", Margin,
-            vWindSpeedAtMidflame->m_nativeValue,
-            vWindSpeedAtMidflame->m_nativeUnits.latin1() );
-
-        fprintf( m_log, "%s  o vSurfaceFireReactionInt %g %s\n", Margin,
-            vSurfaceFireReactionInt->m_nativeValue,
-            vSurfaceFireReactionInt->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFireSpreadAtHead %g %s\n", Margin,
-            vSurfaceFireSpreadAtHead->m_nativeValue,
-            vSurfaceFireSpreadAtHead->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFireSpreadAtVector %g %s\n", Margin,
-            vSurfaceFireSpreadAtVector->m_nativeValue,
-            vSurfaceFireSpreadAtVector->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFireMaxDirFromUpslope %g %s\n", Margin,
-            vSurfaceFireMaxDirFromUpslope->m_nativeValue,
-            vSurfaceFireMaxDirFromUpslope->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFireEffWindAtHead %g %s\n", Margin,
-            vSurfaceFireEffWindAtHead->m_nativeValue,
-            vSurfaceFireEffWindAtHead->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFireEffWindAtVector %g %s\n", Margin,
-            vSurfaceFireEffWindAtVector->m_nativeValue,
-            vSurfaceFireEffWindAtVector->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFireWindSpeedLimit %g %s\n", Margin,
-            vSurfaceFireWindSpeedLimit->m_nativeValue,
-            vSurfaceFireWindSpeedLimit->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFireWindSpeedFlag %g %s\n", Margin,
-            vSurfaceFireWindSpeedFlag->m_nativeValue,
-            vSurfaceFireWindSpeedFlag->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFireHeatPerUnitArea %g %s\n", Margin,
-            vSurfaceFireHeatPerUnitArea->m_nativeValue,
-            vSurfaceFireHeatPerUnitArea->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFireLineIntAtHead %g %s\n", Margin,
-            vSurfaceFireLineIntAtHead->m_nativeValue,
-            vSurfaceFireLineIntAtHead->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFireLineIntAtVector %g %s\n", Margin,
-            vSurfaceFireLineIntAtVector->m_nativeValue,
-            vSurfaceFireLineIntAtVector->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFireFlameLengAtHead %g %s\n", Margin,
-            vSurfaceFireFlameLengAtHead->m_nativeValue,
-            vSurfaceFireFlameLengAtHead->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFireFlameLengAtVector %g %s\n", Margin,
-            vSurfaceFireFlameLengAtVector->m_nativeValue,
-            vSurfaceFireFlameLengAtVector->m_nativeUnits.latin1() );
+    if( EQTRACE_ON( m_trace ) )
+    {
+        m_trace->proc( "FuelBedWeighted", 6, 13 );
+        m_trace->item( 'i', vSurfaceFuelBedModel1 );
+        m_trace->item( 'i', vSurfaceFuelBedModel2 );
+        m_trace->var( 'i', vSurfaceFuelBedCoverage1 );
+        m_trace->var( 'i', vSiteSlopeFraction );
+        m_trace->var( 'i', vWindDirFromUpslope );
+        m_trace->var( 'i', vWindSpeedAtMidflame );
+
+        m_trace->var( 'o', vSurfaceFireReactionInt );
+        m_trace->var( 'o', vSurfaceFireSpreadAtHead );
+        m_trace->var( 'o', vSurfaceFireSpreadAtVector );
+        m_trace->var( 'o', vSurfaceFireMaxDirFromUpslope );
+        m_trace->var( 'o', vSurfaceFireEffWindAtHead );
+        m_trace->var( 'o', vSurfaceFireEffWindAtVector );
+        m_trace->var( 'o', vSurfaceFireWindSpeedLimit );
+        m_trace->var( 'o', vSurfaceFireWindSpeedFlag );
+        m_trace->var( 'o', vSurfaceFireHeatPerUnitArea );
+        m_trace->var( 'o', vSurfaceFireLineIntAtHead );
+        m_trace->var( 'o', vSurfaceFireLineIntAtVector );
+        m_trace->var( 'o', vSurfaceFireFlameLengAtHead );
+        m_trace->var( 'o', vSurfaceFireFlameLengAtVector );
+    }
+    return;
+}
+//------------------------------------------------------------------------------
+/*! \brief Burns a single fuel bed of a FuelBedWeighted() call without
+ *  touching any EqVar (unless traced).
+ *
+ *  Each step makes the same fire behavior calls in the same order as the
+ *  EqCalc function named in its comment, so \a fire holds exactly the
+ *  values those functions would store.  Psi-based vectors are oriented on
+ *  the fire ellipse of \a prev, as the individual functions would read it
+ *  from the ellipse EqVars.  Under V5 code the fuel bed state is kept by
+ *  the xfblib, so the fuel beds must be burned one after the other.
+ *  Traced runs also store the fuel bed and log its steps.
+ *
+ *  \param fm   Fuel model to burn.
+ *  \param bp6  Bp6SurfaceFire that burns the fuel bed (V6 code only).
+ *  \param in   Configuration and inputs shared by both fuel models.
+ *  \param prev Fire whose ellipse and psi orient psi-based vectors.
+ *  \param fire Returns the fuel bed's intermediates; its m_transferEq
+ *              must already be set.
+ */
+
+void EqCalc::FuelBedWeightedBed( FuelModel *fm, Bp6SurfaceFire *bp6,
+        const FuelBedWeightedInput *in, const FuelBedWeightedFire *prev,
+        FuelBedWeightedFire *fire )
+{
+    // FuelBedParms()
+    int p;
+    for ( p=0; p<MaxParts; p++ )
+    {
+        fire->m_dens[p] = 32.;
+        fire->m_heat[p] = 8000.;
+        fire->m_life[p] = 0;
+        fire->m_load[p] = 0.0;
+        fire->m_savr[p] = 1.;
+        fire->m_stot[p] = 0.0555;
+        fire->m_seff[p] = 0.0100;
+    }
+    fire->m_life[3] = 1;    // live herb
+    fire->m_life[4] = 2;    // live wood
+    fire->m_load[0] = fm->m_load1;
+    fire->m_load[1] = fm->m_load10;
+    fire->m_load[2] = fm->m_load100;
+    fire->m_load[3] = fm->m_loadHerb;
+    fire->m_load[4] = fm->m_loadWood;
+    fire->m_heat[0] = fm->m_heatDead;
+    fire->m_heat[1] = fm->m_heatDead;
+    fire->m_heat[2] = fm->m_heatDead;
+    fire->m_heat[3] = fm->m_heatLive;
+    fire->m_heat[4] = fm->m_heatLive;
+    fire->m_heat[5] = fm->m_heatDead;
+    fire->m_savr[0] = fm->m_savr1;
+    fire->m_savr[1] = 109.0;
+    fire->m_savr[2] = 30.0;
+    fire->m_savr[3] = fm->m_savrHerb;
+    fire->m_savr[4] = fm->m_savrWood;
+    fire->m_savr[5] = fm->m_savrHerb;
+
+    // FuelMoisTimeLag()
+    for ( p=0; p<MaxParts; p++ )
+    {
+        if ( fire->m_life[p] == FuelLifeType_LiveHerb )
+        {
+            fire->m_mois[p] = in->m_moisLiveHerb;
+        }
+        else if ( fire->m_life[p] == FuelLifeType_LiveWood )
+        {
+            fire->m_mois[p] = in->m_moisLiveWood;
+        }
+        else if ( fire->m_life[p] == FuelLifeType_DeadLitter )
+        {
+            fire->m_mois[p] = in->m_moisDead100;
+        }
+        else if ( fire->m_savr[p] > 192. )
+        {
+            fire->m_mois[p] = in->m_moisDead1;
+        }
+        else if ( fire->m_savr[p] > 48. )
+        {
+            fire->m_mois[p] = in->m_moisDead10;
+        }
+        else if ( fire->m_savr[p] > 16. )
+        {
+            fire->m_mois[p] = in->m_moisDead100;
+        }
+        else
+        {
+            fire->m_mois[p] = in->m_moisDead1000;
+        }
+    }
+
+    // FuelLoadTransferFraction()
+    fire->m_transferFraction = ( fire->m_transferEq != 0 )
+        ? FBL_HerbaceousFuelLoadCuredFraction( in->m_moisLiveHerb )
+        : 0.0;
+
+    // FuelBedIntermediates()
+    double load[MaxParts];
+    double deadLoad = 0.;
+    double liveLoad = 0.;
+    for ( p=0; p<MaxParts; p++ )
+    {
+        load[p] = fire->m_load[p];
+        if ( fire->m_life[p] == 0 || fire->m_life[p] == 3 )
+        {
+            deadLoad += load[p];
+        }
+        else
+        {
+            liveLoad += load[p];
+        }
+    }
+    double fraction = ( fire->m_transferEq ) ? fire->m_transferFraction : 0.0;
+    int LiveHerb = 3;
+    int DeadHerb = 5;
+    if ( fraction > 0.00001 )
+    {
+        load[DeadHerb] = fraction * load[LiveHerb];
+        load[LiveHerb] -= load[DeadHerb];
+        deadLoad += load[DeadHerb];
+        liveLoad -= load[DeadHerb];
+    }
+    double totalLoad = deadLoad + liveLoad;
+    fire->m_deadFraction = ( totalLoad < SMIDGEN )
+                         ? ( 0. )
+                         : ( deadLoad / totalLoad );
+    fire->m_loadDead       = deadLoad;
+    fire->m_loadDeadHerb   = load[DeadHerb];
+    fire->m_loadLive       = liveLoad;
+    fire->m_loadUndeadHerb = load[LiveHerb];
+    fire->m_bulkDensity  = 0.;
+    fire->m_packingRatio = 0.;
+    fire->m_betaRatio    = 0.;
+    fire->m_windB        = 0.;
+    fire->m_windK        = 0.;
+    fire->m_sigma        = 0.;
+#ifdef INCLUDE_V5_CODE
+    fire->m_sigma = FBL_SurfaceFuelBedIntermediates( fm->m_depth, fm->m_mext,
+        MaxParts, fire->m_life, load, fire->m_savr, fire->m_heat,
+        fire->m_dens, fire->m_stot, fire->m_seff, &fire->m_bulkDensity,
+        &fire->m_packingRatio, &fire->m_betaRatio, &fire->m_windB,
+        &fire->m_windK );
+#elif INCLUDE_V6_CODE
+	appFuelBedCache()->setFuel( bp6, fm->m_depth, fm->m_mext, MaxParts,
+        fire->m_life, load, fire->m_savr, fire->m_heat, fire->m_dens,
+        fire->m_stot, fire->m_seff );
+	fire->m_sigma        = bp6->getSigma();
+	fire->m_bulkDensity  = bp6->getBulkDensity();
+	fire->m_packingRatio = bp6->getPackingRatio();
+	fire->m_betaRatio    = bp6->getBetaRatio();
+	fire->m_windB        = bp6->getWindB();
+	fire->m_windK        = bp6->getWindK();
+#endif
+
+    // FuelBedHeatSink()
+    double mois[MaxParts];
+    for ( p=0; p<MaxParts; p++ )
+    {
+        mois[p] = fire->m_mois[p];
+    }
+    fire->m_moisDead = 0.;
+    fire->m_moisLive = 0.;
+    fire->m_mextLive = 0.;
+#ifdef INCLUDE_V5_CODE
+    fire->m_heatSink = FBL_SurfaceFuelBedHeatSink( fire->m_bulkDensity,
+        fm->m_mext, mois, &fire->m_moisDead, &fire->m_moisLive,
+        &fire->m_mextLive );
+#elif INCLUDE_V6_CODE
+	bp6->setMoisture( mois, 0. );
+	fire->m_moisDead = bp6->getDeadMois();
+	fire->m_moisLive = bp6->getLiveMois();
+	fire->m_mextLive = bp6->getLiveMextApplied();
+	fire->m_heatSink = bp6->getRbQig();
+#endif
+
+    // FirePropagatingFlux(), FireReactionInt(), and FireNoWindRate()
+    fire->m_propFlux = FBL_SurfaceFirePropagatingFlux( fire->m_packingRatio,
+        fire->m_sigma );
+#ifdef INCLUDE_V5_CODE
+    fire->m_rxIntDead = 0.0;
+    fire->m_rxIntLive = 0.0;
+    fire->m_rxInt = FBL_SurfaceFireReactionIntensity( fire->m_moisDead,
+        fm->m_mext, fire->m_moisLive, fire->m_mextLive,
+        &fire->m_rxIntDead, &fire->m_rxIntLive );
+#elif INCLUDE_V6_CODE
+	fire->m_rxInt     = bp6->getTotalRxInt();
+	fire->m_rxIntDead = bp6->getDeadRxInt();
+	fire->m_rxIntLive = bp6->getLiveRxInt();
+#endif
+    fire->m_ros0 = FBL_SurfaceFireNoWindNoSlopeSpreadRate( fire->m_rxInt,
+        fire->m_propFlux, fire->m_heatSink );
+
+    // WindAdjFactor() and WindSpeedAtMidflame()
+    fire->m_waf = in->m_waf;
+    fire->m_wafMethod = 0;
+    fire->m_crownFraction = 0.0;
+    if ( in->m_windAdjCalc )
+    {
+        fire->m_waf = FBL_WindAdjustmentFactor( in->m_canopyCover,
+            in->m_canopyHt, in->m_crownRatio, fm->m_depth,
+            &fire->m_crownFraction, &fire->m_wafMethod );
+    }
+    fire->m_wmf = ( in->m_midflameInput )
+                ? in->m_windAtMidflame
+                : in->m_windAt20Ft * fire->m_waf;
+
+    // FireSpreadAtHead()
+    fire->m_dirMax      = 0.;
+    fire->m_effWind     = 0.;
+    fire->m_maxWind     = 0.;
+    fire->m_windFactor  = 0.;
+    fire->m_slopeFactor = 0.;
+    fire->m_windLimit   = 0;
+#ifdef INCLUDE_V5_CODE
+    fire->m_rosHead = FBL_SurfaceFireForwardSpreadRate( fire->m_ros0,
+        fire->m_rxInt, in->m_slope, fire->m_wmf, in->m_windDir,
+        &fire->m_dirMax, &fire->m_effWind, &fire->m_maxWind,
+        &fire->m_windLimit, &fire->m_windFactor, &fire->m_slopeFactor,
+        in->m_windLimit );
+#elif INCLUDE_V6_CODE
+	bp6->setSite( in->m_slope, in->m_aspect, 88.*fire->m_wmf, in->m_windDir,
+        in->m_windLimit );
+	fire->m_rosHead     = bp6->getSpreadRateAtHead();
+	fire->m_dirMax      = bp6->getHeadDirFromUpslope();
+	fire->m_effWind     = bp6->getEffectiveWindSpeed() / 88.;
+	fire->m_maxWind     = bp6->getWindSpeedLimit() / 88.;
+	fire->m_windLimit   = bp6->getWindLimitExceeded() ? 1 : 0;
+	fire->m_windFactor  = bp6->getWindFactor();
+	fire->m_slopeFactor = bp6->getSlopeFactor();
+#endif
+
+    // FireDistAtHead(), FireLengthToWidth(), and FireEccentricity()
+    fire->m_distHead = fire->m_rosHead * in->m_elapsed;
+    fire->m_lwRatio  = FBL_SurfaceFireLengthToWidthRatio( fire->m_effWind );
+    fire->m_eccent   = FBL_SurfaceFireEccentricity( fire->m_lwRatio );
+
+    // FireVectorBetaFromUpslope(), or the psi direction followed by
+    // FireVectorThetaFromPsi() and FireVectorBetaFromTheta()
+    fire->m_psi   = prev->m_psi;
+    fire->m_theta = 0.;
+    if ( in->m_betaVector )
+    {
+        fire->m_beta = FBL_SurfaceFireVectorBeta( fire->m_dirMax,
+            in->m_vectorDir );
+    }
+    else
+    {
+        if ( in->m_psiFixed )
+        {
+            fire->m_psi = in->m_psi;
+        }
+        else if ( in->m_psiFromUpslope )
+        {
+            fire->m_psi = FBL_SurfaceFireVectorBeta( fire->m_dirMax,
+                in->m_vectorDir );
+        }
+        fire->m_theta = FBL_SurfaceFireEllipseThetaFromPsiDegrees(
+            prev->m_f, prev->m_h, fire->m_psi );
+        fire->m_beta = FBL_SurfaceFireEllipseBetaFromThetaDegrees(
+            prev->m_f, prev->m_g, prev->m_h, fire->m_theta );
+    }
+
+    // FireSpreadAtVectorFromBeta() and FireSpreadAtBeta()
+    fire->m_rosBeta = FBL_SurfaceFireSpreadRateAtBeta( fire->m_rosHead,
+        fire->m_eccent, fire->m_beta );
+    fire->m_rosVector = fire->m_rosBeta;
+
+    // FireSpreadAtBack() through FireEllipseH()
+    fire->m_rosBack   = FBL_SurfaceFireBackingSpreadRate( fire->m_rosHead,
+        fire->m_eccent );
+    fire->m_distBack  = fire->m_rosBack * in->m_elapsed;
+    fire->m_lengDist  = fire->m_distBack + fire->m_distHead;
+    fire->m_f         = FBL_SurfaceFireEllipseF( fire->m_lengDist );
+    fire->m_g         = FBL_SurfaceFireEllipseG( fire->m_lengDist,
+        fire->m_distBack );
+    fire->m_widthDist = FBL_SurfaceFireWidth( fire->m_lengDist,
+        fire->m_lwRatio );
+    fire->m_h         = FBL_SurfaceFireEllipseH( fire->m_widthDist );
+
+    // FireVectorThetaFromBeta() and FireVectorPsiFromTheta()
+    if ( in->m_betaVector )
+    {
+        fire->m_theta = FBL_SurfaceFireEllipseThetaFromBetaDegrees(
+            fire->m_f, fire->m_g, fire->m_h, fire->m_beta );
+        fire->m_psi = FBL_SurfaceFireEllipsePsiFromThetaDegrees(
+            fire->m_f, fire->m_h, fire->m_theta );
+    }
+
+    // FireSpreadAtPsi() and FireSpreadAtVectorFromPsi()
+    double length = fire->m_rosHead + fire->m_rosBack;
+    double width  = length / fire->m_lwRatio;
+    fire->m_rosPsi = FBL_SurfaceFireExpansionRateAtPsi(
+        FBL_SurfaceFireEllipseF( length ),
+        FBL_SurfaceFireEllipseG( length, fire->m_rosBack ),
+        FBL_SurfaceFireEllipseH( width ), 1.0, fire->m_psi );
+    if ( in->m_psiRos )
+    {
+        fire->m_rosVector = fire->m_rosPsi;
+    }
+
+    // FireResidenceTime() through FireFlameLengAtPsi()
+    fire->m_resTime   = FBL_SurfaceFireResidenceTime( fire->m_sigma );
+    fire->m_fliVector = FBL_SurfaceFireFirelineIntensity(
+        ( in->m_psiFli ) ? fire->m_rosPsi : fire->m_rosBeta,
+        fire->m_rxInt, fire->m_resTime );
+    fire->m_hpua      = FBL_SurfaceFireHeatPerUnitArea( fire->m_rxInt,
+        fire->m_resTime );
+    fire->m_fliHead   = FBL_SurfaceFireFirelineIntensity( fire->m_rosHead,
+        fire->m_rxInt, fire->m_resTime );
+    fire->m_fliBeta   = FBL_SurfaceFireFirelineIntensity( fire->m_rosBeta,
+        fire->m_rxInt, fire->m_resTime );
+    fire->m_fliPsi    = FBL_SurfaceFireFirelineIntensity( fire->m_rosPsi,
+        fire->m_rxInt, fire->m_resTime );
+    fire->m_flHead    = FBL_SurfaceFireFlameLength( fire->m_fliHead );
+    fire->m_flVector  = FBL_SurfaceFireFlameLength( fire->m_fliVector );
+    fire->m_flBeta    = FBL_SurfaceFireFlameLength( fire->m_fliBeta );
+    fire->m_flPsi     = FBL_SurfaceFireFlameLength( fire->m_fliPsi );
+
+    // FireEffWindAtVector()
+#ifdef INCLUDE_V5_CODE
+    fire->m_effWindVector = FBL_SurfaceFireEffectiveWindSpeedAtVector(
+        fire->m_ros0, fire->m_rosVector );
+#elif INCLUDE_V6_CODE
+	fire->m_effWindVector = bp6->getEffectiveWindSpeedAtVector(
+        fire->m_rosVector );
+#endif
+
+    // Traced runs leave each fuel bed in the EqVars, just as the individual
+    // EqCalc functions would, and log the steps those functions would log
+    if( EQTRACE_ON( m_trace ) )
+    {
+        FuelBedWeightedStore( fm, in, fire );
+        FuelBedWeightedTrace( in, prev, fire );
+    }
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Stores the intermediates of FuelBedWeightedBed() into the
+ *  EqVars the individual EqCalc functions would have left them in.
+ *
+ *  \param fm   Fuel model that was burned.
+ *  \param in   Configuration and inputs shared by both fuel models.
+ *  \param fire Fuel bed intermediates to store.
+ */
+
+void EqCalc::FuelBedWeightedStore( FuelModel *fm,
+        const FuelBedWeightedInput *in, const FuelBedWeightedFire *fire )
+{
+    // Fuel model
+    vSurfaceFuelBedDepth->update( fm->m_depth );
+    vSurfaceFuelBedMextDead->update( fm->m_mext );
+    vSurfaceFuelHeatDead->update( fm->m_heatDead );
+    vSurfaceFuelHeatLive->update( fm->m_heatLive );
+    vSurfaceFuelLoadDead1->update( fm->m_load1 );
+    vSurfaceFuelLoadDead10->update( fm->m_load10 );
+    vSurfaceFuelLoadDead100->update( fm->m_load100 );
+    vSurfaceFuelLoadLiveHerb->update( fm->m_loadHerb );
+    vSurfaceFuelLoadLiveWood->update( fm->m_loadWood );
+    vSurfaceFuelSavrDead1->update( fm->m_savr1 );
+    vSurfaceFuelSavrLiveHerb->update( fm->m_savrHerb );
+    vSurfaceFuelSavrLiveWood->update( fm->m_savrWood );
+    vSurfaceFuelLoadTransferEq->updateItem( fm->m_transfer );
+
+    // Fuel particles
+    for ( int p=0; p<MaxParts; p++ )
+    {
+        vSurfaceFuelDens[p]->update( fire->m_dens[p] );
+        vSurfaceFuelHeat[p]->update( fire->m_heat[p] );
+        vSurfaceFuelLife[p]->updateItem( fire->m_life[p] );
+        vSurfaceFuelLoad[p]->update( fire->m_load[p] );
+        vSurfaceFuelSavr[p]->update( fire->m_savr[p] );
+        vSurfaceFuelStot[p]->update( fire->m_stot[p] );
+        vSurfaceFuelSeff[p]->update( fire->m_seff[p] );
+        vSurfaceFuelMois[p]->update( fire->m_mois[p] );
     }
+    vSurfaceFuelLoadTransferFraction->update( fire->m_transferFraction );
+    vSurfaceFuelLoadTransferFraction->m_store.setNum(
+        vSurfaceFuelLoadTransferFraction->m_displayValue,
+        'f', vSurfaceFuelLoadTransferFraction->m_displayDecimals );
+
+    // Fuel bed
+    vSurfaceFuelBedDeadFraction->update( fire->m_deadFraction );
+    vSurfaceFuelBedLiveFraction->update( 1. - fire->m_deadFraction );
+    vSurfaceFuelLoadDead->update( fire->m_loadDead );
+    vSurfaceFuelLoadDeadHerb->update( fire->m_loadDeadHerb );
+    vSurfaceFuelLoadLive->update( fire->m_loadLive );
+    vSurfaceFuelLoadUndeadHerb->update( fire->m_loadUndeadHerb );
+    vSurfaceFireWindFactorB->update( fire->m_windB );
+    vSurfaceFireWindFactorK->update( fire->m_windK );
+    vSurfaceFuelBedBetaRatio->update( fire->m_betaRatio );
+    vSurfaceFuelBedBulkDensity->update( fire->m_bulkDensity );
+    vSurfaceFuelBedPackingRatio->update( fire->m_packingRatio );
+    vSurfaceFuelBedSigma->update( fire->m_sigma );
+    vSurfaceFuelBedMoisDead->update( fire->m_moisDead );
+    vSurfaceFuelBedMoisLive->update( fire->m_moisLive );
+    vSurfaceFuelBedMextLive->update( fire->m_mextLive );
+    vSurfaceFuelBedHeatSink->update( fire->m_heatSink );
+    vSurfaceFirePropagatingFlux->update( fire->m_propFlux );
+    vSurfaceFireReactionInt->update( fire->m_rxInt );
+    vSurfaceFireReactionIntDead->update( fire->m_rxIntDead );
+    vSurfaceFireReactionIntLive->update( fire->m_rxIntLive );
+    vSurfaceFireNoWindRate->update( fire->m_ros0 );
+
+    // Wind
+    if ( in->m_windAdjCalc )
+    {
+        vWindAdjFactor->update( fire->m_waf );
+        vWindAdjMethod->updateItem( fire->m_wafMethod );
+        vTreeCanopyCrownFraction->update( fire->m_crownFraction );
+    }
+    if ( ! in->m_midflameInput )
+    {
+        vWindSpeedAtMidflame->update( fire->m_wmf );
+    }
+
+    // Fire
+    vSurfaceFireSpreadAtHead->update( fire->m_rosHead );
+    vSurfaceFireMaxDirFromUpslope->update( fire->m_dirMax );
+    vSurfaceFireEffWindAtHead->update( fire->m_effWind );
+    vSurfaceFireWindSpeedLimit->update( fire->m_maxWind );
+    vSurfaceFireWindSpeedFlag->updateItem( fire->m_windLimit );
+    vSurfaceFireWindFactor->update( fire->m_windFactor );
+    vSurfaceFireSlopeFactor->update( fire->m_slopeFactor );
+    vSurfaceFireDistAtHead->update( fire->m_distHead );
+    vSurfaceFireLengthToWidth->update( fire->m_lwRatio );
+    vSurfaceFireEccentricity->update( fire->m_eccent );
+    vSurfaceFireVectorBeta->update( fire->m_beta );
+    vSurfaceFireVectorPsi->update( fire->m_psi );
+    vSurfaceFireVectorTheta->update( fire->m_theta );
+    vSurfaceFireSpreadAtVector->update( fire->m_rosVector );
+    vSurfaceFireSpreadAtBeta->update( fire->m_rosBeta );
+    vSurfaceFireSpreadAtBack->update( fire->m_rosBack );
+    vSurfaceFireDistAtBack->update( fire->m_distBack );
+    vSurfaceFireLengDist->update( fire->m_lengDist );
+    vSurfaceFireEllipseF->update( fire->m_f );
+    vSurfaceFireEllipseG->update( fire->m_g );
+    vSurfaceFireWidthDist->update( fire->m_widthDist );
+    vSurfaceFireEllipseH->update( fire->m_h );
+    vSurfaceFireSpreadAtPsi->update( fire->m_rosPsi );
+    vSurfaceFireResidenceTime->update( fire->m_resTime );
+    vSurfaceFireLineIntAtVector->update( fire->m_fliVector );
+    vSurfaceFireHeatPerUnitArea->update( fire->m_hpua );
+    vSurfaceFireLineIntAtHead->update( fire->m_fliHead );
+    vSurfaceFireLineIntAtBeta->update( fire->m_fliBeta );
+    vSurfaceFireLineIntAtPsi->update( fire->m_fliPsi );
+    vSurfaceFireFlameLengAtHead->update( fire->m_flHead );
+    vSurfaceFireFlameLengAtVector->update( fire->m_flVector );
+    vSurfaceFireFlameLengAtBeta->update( fire->m_flBeta );
+    vSurfaceFireFlameLengAtPsi->update( fire->m_flPsi );
+    vSurfaceFireEffWindAtVector->update( fire->m_effWindVector );
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Logs the steps of a FuelBedWeightedBed() call just as the
+ *  individual EqCalc functions named in FuelBedWeightedBed() would.
+ *
+ *  The fuel bed must already be stored by FuelBedWeightedStore(), so only
+ *  the few EqVars that are overwritten by a later step are logged from
+ *  \a prev or \a fire rather than from the EqVar.
+ *
+ *  \param in   Configuration and inputs shared by both fuel models.
+ *  \param prev Fire whose ellipse and psi oriented psi-based vectors.
+ *  \param fire Fuel bed intermediates to log.
+ */
+
+void EqCalc::FuelBedWeightedTrace( const FuelBedWeightedInput *in,
+        const FuelBedWeightedFire *prev, const FuelBedWeightedFire *fire )
+{
+    int p;
+    m_trace->proc( "FuelBedParms", 0, 0 );
+
+    m_trace->proc( "FuelMoisTimeLag", 6+MaxParts, MaxParts );
+    m_trace->var( 'i', vSurfaceFuelMoisDead1 );
+    m_trace->var( 'i', vSurfaceFuelMoisDead10 );
+    m_trace->var( 'i', vSurfaceFuelMoisDead100 );
+    m_trace->var( 'i', vSurfaceFuelMoisDead1000 );
+    m_trace->var( 'i', vSurfaceFuelMoisLiveHerb );
+    m_trace->var( 'i', vSurfaceFuelMoisLiveWood );
+    for ( p=0; p<MaxParts; p++ )
+    {
+        m_trace->var( 'i', vSurfaceFuelLife[p] );
+        m_trace->var( 'i', vSurfaceFuelSavr[p] );
+    }
+    for ( p=0; p<MaxParts; p++ )
+    {
+        m_trace->var( 'o', vSurfaceFuelMois[p] );
+    }
+
+    m_trace->proc( "FuelLoadTransferFraction", 2, 6 );
+    m_trace->var( 'i', vSurfaceFuelMoisLiveHerb );
+    m_trace->var( 'o', vSurfaceFuelLoadTransferFraction );
+
+    m_trace->proc( "FuelBedIntermediates", 3, 12 );
+    m_trace->item( 'i', vSurfaceFuelLoadTransferEq );
+    m_trace->var( 'i', vSurfaceFuelBedDepth );
+    m_trace->var( 'i', vSurfaceFuelBedMextDead );
+    m_trace->var( 'o', vSurfaceFireWindFactorB );
+    m_trace->var( 'o', vSurfaceFireWindFactorK );
+    m_trace->var( 'o', vSurfaceFuelBedBetaRatio );
+    m_trace->var( 'o', vSurfaceFuelBedBulkDensity );
+    m_trace->var( 'o', vSurfaceFuelBedDeadFraction );
+    m_trace->var( 'o', vSurfaceFuelBedLiveFraction );
+    m_trace->var( 'o', vSurfaceFuelBedPackingRatio );
+    m_trace->var( 'o', vSurfaceFuelBedSigma );
+    m_trace->var( 'o', vSurfaceFuelLoadDead );
+    m_trace->var( 'o', vSurfaceFuelLoadDeadHerb );
+    m_trace->var( 'o', vSurfaceFuelLoadLive );
+    m_trace->var( 'o', vSurfaceFuelLoadUndeadHerb );
+
+    m_trace->proc( "FuelBedHeatSink", 2, 4 );
+    m_trace->var( 'i', vSurfaceFuelBedBulkDensity );
+    m_trace->var( 'i', vSurfaceFuelBedMextDead );
+    m_trace->var( 'o', vSurfaceFuelBedHeatSink );
+    m_trace->var( 'o', vSurfaceFuelBedMoisLive );
+    m_trace->var( 'o', vSurfaceFuelBedMextLive );
+    m_trace->var( 'o', vSurfaceFuelBedMoisDead );
+
+    m_trace->proc( "FirePropagatingFlux", 2, 1 );
+    m_trace->var( 'i', vSurfaceFuelBedPackingRatio );
+    m_trace->var( 'i', vSurfaceFuelBedSigma );
+    m_trace->var( 'o', vSurfaceFirePropagatingFlux );
+
+    m_trace->proc( "FireReactionIntensity", 4, 1 );
+    m_trace->var( 'i', vSurfaceFuelBedMextDead );
+    m_trace->var( 'i', vSurfaceFuelBedMoisDead );
+    m_trace->var( 'i', vSurfaceFuelBedMextLive );
+    m_trace->var( 'i', vSurfaceFuelBedMoisLive );
+    m_trace->var( 'o', vSurfaceFireReactionInt );
+
+    m_trace->proc( "FireNoWindRate", 3, 1 );
+    m_trace->var( 'i', vSurfaceFuelBedHeatSink );
+    m_trace->var( 'i', vSurfaceFireReactionInt );
+    m_trace->var( 'i', vSurfaceFirePropagatingFlux );
+    m_trace->var( 'o', vSurfaceFireNoWindRate );
+
+    if ( in->m_windAdjCalc )
+    {
+        m_trace->proc( "WindAdjFactor", 4, 1 );
+        m_trace->itemUnits( 'i', vTreeCanopyCover );
+        m_trace->itemUnits( 'i', vTreeCoverHt );
+        m_trace->itemUnits( 'i', vTreeCrownRatio );
+        m_trace->itemUnits( 'i', vSurfaceFuelBedDepth );
+        m_trace->itemUnits( 'o', vWindAdjFactor );
+        m_trace->item( 'o', vWindAdjMethod );
+        m_trace->itemUnits( 'o', vTreeCanopyCrownFraction );
+    }
+    if ( ! in->m_midflameInput )
+    {
+        m_trace->proc( "WindSpeedAtMidflame", 2, 1 );
+        m_trace->var( 'i', vWindSpeedAt20Ft );
+        m_trace->var( 'i', vWindAdjFactor );
+        m_trace->var( 'o', vWindSpeedAtMidflame );
+    }
+
+    m_trace->proc( "FireSpreadAtHead", 5, 7 );
+    m_trace->var( 'i', vSurfaceFireNoWindRate );
+    m_trace->var( 'i', vSurfaceFireReactionInt );
+    m_trace->var( 'i', vSiteSlopeFraction );
+    m_trace->var( 'i', vWindDirFromUpslope );
+    m_trace->var( 'i', vWindSpeedAtMidflame );
+    m_trace->var( 'o', vSurfaceFireSpreadAtHead );
+    m_trace->var( 'o', vSurfaceFireMaxDirFromUpslope );
+    m_trace->var( 'o', vSurfaceFireEffWindAtHead );
+    m_trace->var( 'o', vSurfaceFireWindSpeedLimit );
+    m_trace->var( 'o', vSurfaceFireWindSpeedFlag );
+    m_trace->var( 'o', vSurfaceFireWindFactor );
+    m_trace->var( 'o', vSurfaceFireSlopeFactor );
+
+    m_trace->proc( "FireDistAtHead", 2, 1 );
+    m_trace->var( 'i', vSurfaceFireSpreadAtHead );
+    m_trace->var( 'i', vSurfaceFireElapsedTime );
+    m_trace->var( 'o', vSurfaceFireDistAtHead );
+
+    m_trace->proc( "FireLengthToWidth", 1, 1 );
+    m_trace->var( 'i', vSurfaceFireEffWindAtHead );
+    m_trace->var( 'o', vSurfaceFireLengthToWidth );
+
+    m_trace->proc( "FireEccentricity", 1, 1 );
+    m_trace->var( 'i', vSurfaceFireLengthToWidth );
+    m_trace->var( 'o', vSurfaceFireEccentricity );
+
+    // Psi-based vectors were oriented on the previous fire's ellipse
+    if ( in->m_betaVector )
+    {
+        m_trace->proc( "FireVectorBetaFromUpslope", 2, 1 );
+        m_trace->var( 'i', vSurfaceFireMaxDirFromUpslope );
+        m_trace->var( 'i', vSurfaceFireVectorDirFromUpslope );
+        m_trace->var( 'o', vSurfaceFireVectorBeta );
+    }
+    else
+    {
+        if ( ! in->m_psiFixed && in->m_psiFromUpslope )
+        {
+            m_trace->proc( "FireVectorPsiFromUpslope", 2, 1 );
+            m_trace->var( 'i', vSurfaceFireMaxDirFromUpslope );
+            m_trace->var( 'i', vSurfaceFireVectorDirFromUpslope );
+            m_trace->var( 'o', vSurfaceFireVectorPsi );
+        }
+        m_trace->proc( "FireVectorThetaFromPsi", 3, 1 );
+        m_trace->value( 'i', vSurfaceFireEllipseF, prev->m_f );
+        m_trace->value( 'i', vSurfaceFireEllipseH, prev->m_h );
+        m_trace->var( 'i', vSurfaceFireVectorPsi );
+        m_trace->var( 'o', vSurfaceFireVectorTheta );
+
+        m_trace->proc( "FireVectorBetaFromTheta", 4, 1 );
+        m_trace->value( 'i', vSurfaceFireEllipseF, prev->m_f );
+        m_trace->value( 'i', vSurfaceFireEllipseG, prev->m_g );
+        m_trace->value( 'i', vSurfaceFireEllipseH, prev->m_h );
+        m_trace->var( 'i', vSurfaceFireVectorTheta );
+        m_trace->var( 'o', vSurfaceFireVectorBeta );
+    }
+
+    m_trace->proc( "FireSpreadAtVectorFromBeta", 3, 1 );
+    m_trace->var( 'i', vSurfaceFireEccentricity );
+    m_trace->var( 'i', vSurfaceFireSpreadAtHead );
+    m_trace->var( 'i', vSurfaceFireVectorBeta );
+    m_trace->value( 'o', vSurfaceFireSpreadAtVector, fire->m_rosBeta );
+
+    m_trace->proc( "FireSpreadAtBeta", 3, 1 );
+    m_trace->var( 'i', vSurfaceFireEccentricity );
+    m_trace->var( 'i', vSurfaceFireSpreadAtHead );
+    m_trace->var( 'i', vSurfaceFireVectorBeta );
+    m_trace->var( 'o', vSurfaceFireSpreadAtBeta );
+
+    m_trace->proc( "FireSpreadAtBack", 2, 1 );
+    m_trace->var( 'i', vSurfaceFireEccentricity );
+    m_trace->var( 'i', vSurfaceFireSpreadAtHead );
+    m_trace->var( 'o', vSurfaceFireSpreadAtBack );
+
+    m_trace->proc( "FireDistAtBack", 2, 1 );
+    m_trace->var( 'i', vSurfaceFireSpreadAtBack );
+    m_trace->var( 'i', vSurfaceFireElapsedTime );
+    m_trace->var( 'o', vSurfaceFireDistAtBack );
+
+    m_trace->proc( "FireLengDist", 2, 1 );
+    m_trace->var( 'i', vSurfaceFireDistAtBack );
+    m_trace->var( 'i', vSurfaceFireDistAtHead );
+    m_trace->var( 'o', vSurfaceFireLengDist );
+
+    m_trace->proc( "FireEllipseF", 1, 1 );
+    m_trace->var( 'i', vSurfaceFireLengDist );
+    m_trace->var( 'o', vSurfaceFireEllipseF );
+
+    m_trace->proc( "FireEllipseG", 2, 1 );
+    m_trace->var( 'i', vSurfaceFireLengDist );
+    m_trace->var( 'i', vSurfaceFireDistAtBack );
+    m_trace->var( 'o', vSurfaceFireEllipseG );
+
+    m_trace->proc( "FireWidthDist", 2, 1 );
+    m_trace->var( 'i', vSurfaceFireLengDist );
+    m_trace->var( 'i', vSurfaceFireLengthToWidth );
+    m_trace->var( 'o', vSurfaceFireWidthDist );
+
+    m_trace->proc( "FireEllipseH", 1, 1 );
+    m_trace->var( 'i', vSurfaceFireWidthDist );
+    m_trace->var( 'o', vSurfaceFireEllipseH );
+
+    if ( in->m_betaVector )
+    {
+        m_trace->proc( "FireVectorThetaFromBeta", 4, 1 );
+        m_trace->var( 'i', vSurfaceFireEllipseF );
+        m_trace->var( 'i', vSurfaceFireEllipseG );
+        m_trace->var( 'i', vSurfaceFireEllipseH );
+        m_trace->var( 'i', vSurfaceFireVectorBeta );
+        m_trace->var( 'o', vSurfaceFireVectorTheta );
+
+        m_trace->proc( "FireVectorPsiFromTheta", 3, 1 );
+        m_trace->var( 'i', vSurfaceFireEllipseF );
+        m_trace->var( 'i', vSurfaceFireEllipseH );
+        m_trace->var( 'i', vSurfaceFireVectorTheta );
+        m_trace->var( 'o', vSurfaceFireVectorPsi );
+    }
+
+    // The psi spread rate is from the unit (1 minute) spread ellipse
+    double length = fire->m_rosHead + fire->m_rosBack;
+    double width  = length / fire->m_lwRatio;
+    double f = FBL_SurfaceFireEllipseF( length );
+    double g = FBL_SurfaceFireEllipseG( length, fire->m_rosBack );
+    double h = FBL_SurfaceFireEllipseH( width );
+    m_trace->proc( "FireSpreadAtPsi", 5, 1 );
+    m_trace->value( 'i', vSurfaceFireEllipseF, f );
+    m_trace->value( 'i', vSurfaceFireEllipseG, g );
+    m_trace->value( 'i', vSurfaceFireEllipseH, h );
+    m_trace->value( 'i', vSurfaceFireElapsedTime, 1.0,
+        "vSurfaceFireElaspedTime" );
+    m_trace->var( 'i', vSurfaceFireVectorPsi );
+    m_trace->var( 'o', vSurfaceFireSpreadAtPsi );
+    if ( in->m_psiRos )
+    {
+        m_trace->proc( "FireSpreadAtVectorFromPsi", 5, 1 );
+        m_trace->value( 'i', vSurfaceFireEllipseF, f );
+        m_trace->value( 'i', vSurfaceFireEllipseG, g );
+        m_trace->value( 'i', vSurfaceFireEllipseH, h );
+        m_trace->value( 'i', vSurfaceFireElapsedTime, 1.0,
+            "vSurfaceFireElaspedTime" );
+        m_trace->var( 'i', vSurfaceFireVectorPsi );
+        m_trace->var( 'o', vSurfaceFireSpreadAtVector );
+    }
+
+    m_trace->proc( "FireResidenceTime", 2, 1 );
+    m_trace->var( 'i', vSurfaceFuelBedSigma );
+    m_trace->var( 'o', vSurfaceFireResidenceTime );
+
+    if ( in->m_psiFli )
+    {
+        m_trace->proc( "FireLineIntAtVectorFromPsi", 3, 1 );
+        m_trace->var( 'i', vSurfaceFireSpreadAtPsi );
+    }
+    else
+    {
+        m_trace->proc( "FireLineIntAtVectorFromBeta", 3, 1 );
+        m_trace->var( 'i', vSurfaceFireSpreadAtBeta );
+    }
+    m_trace->var( 'i', vSurfaceFireResidenceTime );
+    m_trace->var( 'i', vSurfaceFireReactionInt );
+    m_trace->var( 'o', vSurfaceFireLineIntAtVector );
+
+    m_trace->proc( "FireHeatPerUnitArea", 2, 1 );
+    m_trace->var( 'i', vSurfaceFireReactionInt );
+    m_trace->var( 'i', vSurfaceFireResidenceTime );
+    m_trace->var( 'o', vSurfaceFireHeatPerUnitArea );
+
+    m_trace->proc( "FireLineIntAtHead", 3, 1 );
+    m_trace->var( 'i', vSurfaceFireSpreadAtHead );
+    m_trace->var( 'i', vSurfaceFireResidenceTime );
+    m_trace->var( 'i', vSurfaceFireReactionInt );
+    m_trace->var( 'o', vSurfaceFireLineIntAtHead );
+
+    m_trace->proc( "FireLineIntAtBeta", 3, 1 );
+    m_trace->var( 'i', vSurfaceFireSpreadAtBeta );
+    m_trace->var( 'i', vSurfaceFireResidenceTime );
+    m_trace->var( 'i', vSurfaceFireReactionInt );
+    m_trace->var( 'o', vSurfaceFireLineIntAtBeta );
+
+    m_trace->proc( "FireLineIntAtPsi", 3, 1 );
+    m_trace->var( 'i', vSurfaceFireSpreadAtPsi );
+    m_trace->var( 'i', vSurfaceFireResidenceTime );
+    m_trace->var( 'i', vSurfaceFireReactionInt );
+    m_trace->var( 'o', vSurfaceFireLineIntAtPsi );
+
+    m_trace->proc( "FireFlameLengAtHead", 1, 1 );
+    m_trace->var( 'i', vSurfaceFireLineIntAtHead );
+    m_trace->var( 'o', vSurfaceFireFlameLengAtHead );
+
+    m_trace->proc( "FireFlameLengAtVector", 1, 1 );
+    m_trace->var( 'i', vSurfaceFireLineIntAtVector );
+    m_trace->var( 'o', vSurfaceFireFlameLengAtVector );
+
+    m_trace->proc( "FireFlameLengAtBeta", 1, 1 );
+    m_trace->var( 'i', vSurfaceFireLineIntAtBeta );
+    m_trace->var( 'o', vSurfaceFireFlameLengAtBeta );
+
+    m_trace->proc( "FireFlameLengAtPsi", 1, 1 );
+    m_trace->var( 'i', vSurfaceFireLineIntAtPsi );
+    m_trace->var( 'o', vSurfaceFireFlameLengAtPsi );
+
+    m_trace->proc( "FireEffWindAtVector", 2, 1 );
+    m_trace->var( 'i', vSurfaceFireNoWindRate );
+    m_trace->var( 'i', vSurfaceFireSpreadAtVector );
+    m_trace->var( 'o', vSurfaceFireEffWindAtVector );
     return;
 }
 //------------------------------------------------------------------------------
@@ -5008,18 +4781,12 @@ void EqCalc::FuelChaparralAgeFromDepthType( void )
     vSurfaceFuelChaparralAge->update( age );
 
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc FuelChaparralAgeFromDepthType() 2 1\n", Margin );
-        fprintf( m_log, "%s  i vSurfaceFuelChaparralDepth %g %s\n", Margin,
-            vSurfaceFuelChaparralDepth->m_nativeValue,
-            vSurfaceFuelChaparralDepth->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFuelChaparralType %d %s\n", Margin,
-            vSurfaceFuelChaparralType->activeItemDataIndex(),
-            vSurfaceFuelChaparralType->activeItemName().latin1() );
-		fprintf( m_log, "%s  o vSurfaceFuelChaparralAge %g %s\n", Margin,
-            vSurfaceFuelChaparralAge->m_nativeValue,
-            vSurfaceFuelChaparralAge->m_nativeUnits.latin1() );
+        m_trace->proc( "FuelChaparralAgeFromDepthType", 2, 1 );
+        m_trace->var( 'i', vSurfaceFuelChaparralDepth );
+        m_trace->item( 'i', vSurfaceFuelChaparralType );
+		m_trace->var( 'o', vSurfaceFuelChaparralAge );
 	}
 	return;
 }
@@ -5041,15 +4808,11 @@ void EqCalc::FuelChaparralDeadFuelFractionFromAge( void )
     // Update
     vSurfaceFuelChaparralDeadFuelFraction->update( fraction );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc FuelChaparralDeadFuelFractionFromAge() 1 1\n", Margin );
-		fprintf( m_log, "%s  1 vSurfaceFuelChaparralAge %g %s\n", Margin,
-            vSurfaceFuelChaparralAge->m_nativeValue,
-            vSurfaceFuelChaparralAge->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFuelChaparralDeadFuelFraction %g %s\n", Margin,
-            vSurfaceFuelChaparralDeadFuelFraction->m_nativeValue,
-            vSurfaceFuelChaparralDeadFuelFraction->m_nativeUnits.latin1() );
+        m_trace->proc( "FuelChaparralDeadFuelFractionFromAge", 1, 1 );
+		m_trace->var( '1', vSurfaceFuelChaparralAge );
+        m_trace->var( 'o', vSurfaceFuelChaparralDeadFuelFraction );
 	}
 	return;
 }
@@ -5073,18 +4836,12 @@ void EqCalc::FuelChaparralDepthFromAge( void )
     // Update
     vSurfaceFuelChaparralDepth->update( depth );
     // Log results
-    if( m_log )
-    {
-        fprintf( m_log, "%sbegin proc FuelChaparralDepthFromAge() 2 1\n", Margin );
-		fprintf( m_log, "%s  1 vSurfaceFuelChaparralAge %g %s\n", Margin,
-            vSurfaceFuelChaparralAge->m_nativeValue,
-            vSurfaceFuelChaparralAge->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFuelChaparralType %d %s\n", Margin,
-            vSurfaceFuelChaparralType->activeItemDataIndex(),
-            vSurfaceFuelChaparralType->activeItemName().latin1() );
-        fprintf( m_log, "%s  o vSurfaceFuelChaparralDepth %g %s\n", Margin,
-            vSurfaceFuelChaparralDepth->m_nativeValue,
-            vSurfaceFuelChaparralDepth->m_nativeUnits.latin1() );
+    if( EQTRACE_ON( m_trace ) )
+    {
+        m_trace->proc( "FuelChaparralDepthFromAge", 2, 1 );
+		m_trace->var( '1', vSurfaceFuelChaparralAge );
+        m_trace->item( 'i', vSurfaceFuelChaparralType );
+        m_trace->var( 'o', vSurfaceFuelChaparralDepth );
 	}
 	return;
 }
@@ -5108,18 +4865,12 @@ void EqCalc::FuelChaparralLoadTotalFromAgeType( void )
     // Update
     vSurfaceFuelChaparralLoadTotal->update( load );
     // Log results
-    if( m_log )
-    {
-        fprintf( m_log, "%sbegin proc FuelChaparralLoadTotalFromAgeType() 2 1\n", Margin );
-		fprintf( m_log, "%s  1 vSurfaceFuelChaparralAge %g %s\n", Margin,
-            vSurfaceFuelChaparralAge->m_nativeValue,
-            vSurfaceFuelChaparralAge->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFuelChaparralType %d %s\n", Margin,
-            vSurfaceFuelChaparralType->activeItemDataIndex(),
-            vSurfaceFuelChaparralType->activeItemName().latin1() );
-        fprintf( m_log, "%s  o vSurfaceFuelChaparralLoadTotal %g %s\n", Margin,
-            vSurfaceFuelChaparralLoadTotal->m_nativeValue,
-            vSurfaceFuelChaparralLoadTotal->m_nativeUnits.latin1() );
+    if( EQTRACE_ON( m_trace ) )
+    {
+        m_trace->proc( "FuelChaparralLoadTotalFromAgeType", 2, 1 );
+		m_trace->var( '1', vSurfaceFuelChaparralAge );
+        m_trace->item( 'i', vSurfaceFuelChaparralType );
+        m_trace->var( 'o', vSurfaceFuelChaparralLoadTotal );
 	}
 	return;
 }
@@ -5181,42 +4932,20 @@ void EqCalc::FuelChaparralModel( void )
     vSurfaceFuelChaparralLoadLiveLeaf->update( loadLiveLeaf );
 
     // Log results
-    if( m_log )
-    {
-        fprintf( m_log, "%sbegin proc FuelChaparralModel() 2 11\n", Margin );
-        fprintf( m_log, "%s  i vSurfaceFuelChaparralDeadFuelFraction %g %s\n", Margin,
-            vSurfaceFuelChaparralDeadFuelFraction->m_nativeValue,
-            vSurfaceFuelChaparralDeadFuelFraction->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFuelChaparralLoadTotal %g %s\n", Margin,
-            vSurfaceFuelChaparralLoadTotal->m_nativeValue,
-            vSurfaceFuelChaparralLoadTotal->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFuelChaparralLoadDead1 %g %s\n", Margin,
-            vSurfaceFuelChaparralLoadDead1->m_nativeValue,
-            vSurfaceFuelChaparralLoadDead1->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFuelChaparralLoadDead2 %g %s\n", Margin,
-            vSurfaceFuelChaparralLoadDead2->m_nativeValue,
-            vSurfaceFuelChaparralLoadDead2->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFuelChaparralLoadDead3 %g %s\n", Margin,
-            vSurfaceFuelChaparralLoadDead3->m_nativeValue,
-            vSurfaceFuelChaparralLoadDead3->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFuelChaparralLoadDead4 %g %s\n", Margin,
-            vSurfaceFuelChaparralLoadDead4->m_nativeValue,
-            vSurfaceFuelChaparralLoadDead4->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFuelChaparralLoadLiveLeaf %g %s\n", Margin,
-            vSurfaceFuelChaparralLoadLiveLeaf->m_nativeValue,
-            vSurfaceFuelChaparralLoadLiveLeaf->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFuelChaparralLoadLive1 %g %s\n", Margin,
-            vSurfaceFuelChaparralLoadLive1->m_nativeValue,
-            vSurfaceFuelChaparralLoadLive1->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFuelChaparralLoadLive2 %g %s\n", Margin,
-            vSurfaceFuelChaparralLoadLive2->m_nativeValue,
-            vSurfaceFuelChaparralLoadLive2->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFuelChaparralLoadLive3 %g %s\n", Margin,
-            vSurfaceFuelChaparralLoadLive3->m_nativeValue,
-            vSurfaceFuelChaparralLoadLive3->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFuelChaparralLoadLive4 %g %s\n", Margin,
-            vSurfaceFuelChaparralLoadLive4->m_nativeValue,
-            vSurfaceFuelChaparralLoadLive4->m_nativeUnits.latin1() );
+    if( EQTRACE_ON( m_trace ) )
+    {
+        m_trace->proc( "FuelChaparralModel", 2, 11 );
+        m_trace->var( 'i', vSurfaceFuelChaparralDeadFuelFraction );
+        m_trace->var( 'i', vSurfaceFuelChaparralLoadTotal );
+        m_trace->var( 'o', vSurfaceFuelChaparralLoadDead1 );
+        m_trace->var( 'o', vSurfaceFuelChaparralLoadDead2 );
+        m_trace->var( 'o', vSurfaceFuelChaparralLoadDead3 );
+        m_trace->var( 'o', vSurfaceFuelChaparralLoadDead4 );
+        m_trace->var( 'o', vSurfaceFuelChaparralLoadLiveLeaf );
+        m_trace->var( 'o', vSurfaceFuelChaparralLoadLive1 );
+        m_trace->var( 'o', vSurfaceFuelChaparralLoadLive2 );
+        m_trace->var( 'o', vSurfaceFuelChaparralLoadLive3 );
+        m_trace->var( 'o', vSurfaceFuelChaparralLoadLive4 );
     }
     return;
 }
@@ -5309,9 +5038,9 @@ void EqCalc::FuelChaparralParms( void )
     vSurfaceFuelHeat[8]->update( 9500. ); // Live stem
 
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc FuelChaparralParms() 0 0\n", Margin );
+        m_trace->proc( "FuelChaparralParms", 0, 0 );
     }
     return;
 }
@@ -5351,15 +5080,11 @@ void EqCalc::FuelLoadTransferFraction( void )
         'f', vSurfaceFuelLoadTransferFraction->m_displayDecimals );
 
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc FuelLoadTransferFraction() 2 6\n", Margin );
-        fprintf( m_log, "%s  i vSurfaceFuelMoisLiveHerb %g %s\n", Margin,
-            vSurfaceFuelMoisLiveHerb->m_nativeValue,
-            vSurfaceFuelMoisLiveHerb->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFuelLoadTransferFraction %g %s\n", Margin,
-            vSurfaceFuelLoadTransferFraction->m_nativeValue,
-            vSurfaceFuelLoadTransferFraction->m_nativeUnits.latin1() );
+        m_trace->proc( "FuelLoadTransferFraction", 2, 6 );
+        m_trace->var( 'i', vSurfaceFuelMoisLiveHerb );
+        m_trace->var( 'o', vSurfaceFuelLoadTransferFraction );
     }
     return;
 }
@@ -5403,24 +5128,14 @@ void EqCalc::FuelMoisDeadHerbWood( void )
         'f', vSurfaceFuelMoisDead1000->m_displayDecimals );
 
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc FuelMoisDeadHerbWood() 1 4\n", Margin );
-        fprintf( m_log, "%s  i vSurfaceFuelMoisLifeDead %g %s\n", Margin,
-            vSurfaceFuelMoisLifeDead->m_nativeValue,
-            vSurfaceFuelMoisLifeDead->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFuelMoisDead1 %g %s\n", Margin,
-            vSurfaceFuelMoisDead1->m_nativeValue,
-            vSurfaceFuelMoisDead1->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFuelMoisDead10 %g %s\n", Margin,
-            vSurfaceFuelMoisDead10->m_nativeValue,
-            vSurfaceFuelMoisDead10->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFuelMoisDead100 %g %s\n", Margin,
-            vSurfaceFuelMoisDead100->m_nativeValue,
-            vSurfaceFuelMoisDead100->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFuelMoisDead1000 %g %s\n", Margin,
-            vSurfaceFuelMoisDead1000->m_nativeValue,
-            vSurfaceFuelMoisDead1000->m_nativeUnits.latin1() );
+        m_trace->proc( "FuelMoisDeadHerbWood", 1, 4 );
+        m_trace->var( 'i', vSurfaceFuelMoisLifeDead );
+        m_trace->var( 'o', vSurfaceFuelMoisDead1 );
+        m_trace->var( 'o', vSurfaceFuelMoisDead10 );
+        m_trace->var( 'o', vSurfaceFuelMoisDead100 );
+        m_trace->var( 'o', vSurfaceFuelMoisDead1000 );
     }
     return;
 }
@@ -5475,33 +5190,17 @@ void EqCalc::FuelMoisLifeClass( void )
         'f', vSurfaceFuelMoisLiveWood->m_displayDecimals );
 
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc FuelMoisLifeClass() 2 6\n", Margin );
-        fprintf( m_log, "%s  i vSurfaceFuelMoisLifeDead %g %s\n", Margin,
-            vSurfaceFuelMoisLifeDead->m_nativeValue,
-            vSurfaceFuelMoisLifeDead->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFuelMoisLifeLive %g %s\n", Margin,
-            vSurfaceFuelMoisLifeLive->m_nativeValue,
-            vSurfaceFuelMoisLifeLive->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFuelMoisDead1 %g %s\n", Margin,
-            vSurfaceFuelMoisDead1->m_nativeValue,
-            vSurfaceFuelMoisDead1->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFuelMoisDead10 %g %s\n", Margin,
-            vSurfaceFuelMoisDead10->m_nativeValue,
-            vSurfaceFuelMoisDead10->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFuelMoisDead100 %g %s\n", Margin,
-            vSurfaceFuelMoisDead100->m_nativeValue,
-            vSurfaceFuelMoisDead100->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFuelMoisDead1000 %g %s\n", Margin,
-            vSurfaceFuelMoisDead1000->m_nativeValue,
-            vSurfaceFuelMoisDead1000->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFuelMoisLiveHerb %g %s\n", Margin,
-            vSurfaceFuelMoisLiveHerb->m_nativeValue,
-            vSurfaceFuelMoisLiveHerb->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFuelMoisLiveWood %g %s\n", Margin,
-            vSurfaceFuelMoisLiveWood->m_nativeValue,
-            vSurfaceFuelMoisLiveWood->m_nativeUnits.latin1() );
+        m_trace->proc( "FuelMoisLifeClass", 2, 6 );
+        m_trace->var( 'i', vSurfaceFuelMoisLifeDead );
+        m_trace->var( 'i', vSurfaceFuelMoisLifeLive );
+        m_trace->var( 'o', vSurfaceFuelMoisDead1 );
+        m_trace->var( 'o', vSurfaceFuelMoisDead10 );
+        m_trace->var( 'o', vSurfaceFuelMoisDead100 );
+        m_trace->var( 'o', vSurfaceFuelMoisDead1000 );
+        m_trace->var( 'o', vSurfaceFuelMoisLiveHerb );
+        m_trace->var( 'o', vSurfaceFuelMoisLiveWood );
     }
     return;
 }
@@ -5568,29 +5267,17 @@ void EqCalc::FuelMoisScenarioModel( void )
         'f', vSurfaceFuelMoisLiveWood->m_displayDecimals );
 
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc FuelMoisScenarioModel1 6\n", Margin );
-        fprintf( m_log, "%s  i vSurfaceFuelMoisScenario %s\n", Margin,
-            name.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFuelMoisDead1 %g %s\n", Margin,
-            vSurfaceFuelMoisDead1->m_nativeValue,
-            vSurfaceFuelMoisDead1->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFuelMoisDead10 %g %s\n", Margin,
-            vSurfaceFuelMoisDead10->m_nativeValue,
-            vSurfaceFuelMoisDead10->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFuelMoisDead100 %g %s\n", Margin,
-            vSurfaceFuelMoisDead100->m_nativeValue,
-            vSurfaceFuelMoisDead100->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFuelMoisDead1000 %g %s\n", Margin,
-            vSurfaceFuelMoisDead1000->m_nativeValue,
-            vSurfaceFuelMoisDead1000->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFuelMoisLiveHerb %g %s\n", Margin,
-            vSurfaceFuelMoisLiveHerb->m_nativeValue,
-            vSurfaceFuelMoisLiveHerb->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFuelMoisLiveWood %g %s\n", Margin,
-            vSurfaceFuelMoisLiveWood->m_nativeValue,
-            vSurfaceFuelMoisLiveWood->m_nativeUnits.latin1() );
+        m_trace->proc( "FuelMoisScenarioModel", 1, 6,
+            "FuelMoisScenarioModel1 6" );
+        m_trace->itemName( 'i', vSurfaceFuelMoisScenario );
+        m_trace->var( 'o', vSurfaceFuelMoisDead1 );
+        m_trace->var( 'o', vSurfaceFuelMoisDead10 );
+        m_trace->var( 'o', vSurfaceFuelMoisDead100 );
+        m_trace->var( 'o', vSurfaceFuelMoisDead1000 );
+        m_trace->var( 'o', vSurfaceFuelMoisLiveHerb );
+        m_trace->var( 'o', vSurfaceFuelMoisLiveWood );
     }
     return;
 }
@@ -5661,42 +5348,23 @@ void EqCalc::FuelMoisTimeLag( void )
         vSurfaceFuelMois[i]->update( mois );
     }
     // Log results
-    if( m_log )
-    {
-        fprintf( m_log, "%sbegin proc FuelMoisTimeLag() %d %d\n", Margin,
-            6+MaxParts, MaxParts );
-        fprintf( m_log, "%s  i vSurfaceFuelMoisDead1 %g %s\n", Margin,
-            vSurfaceFuelMoisDead1->m_nativeValue,
-            vSurfaceFuelMoisDead1->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFuelMoisDead10 %g %s\n", Margin,
-            vSurfaceFuelMoisDead10->m_nativeValue,
-            vSurfaceFuelMoisDead10->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFuelMoisDead100 %g %s\n", Margin,
-            vSurfaceFuelMoisDead100->m_nativeValue,
-            vSurfaceFuelMoisDead100->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFuelMoisDead1000 %g %s\n", Margin,
-            vSurfaceFuelMoisDead1000->m_nativeValue,
-            vSurfaceFuelMoisDead1000->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFuelMoisLiveHerb %g %s\n", Margin,
-            vSurfaceFuelMoisLiveHerb->m_nativeValue,
-            vSurfaceFuelMoisLiveHerb->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFuelMoisLiveWood %g %s\n", Margin,
-            vSurfaceFuelMoisLiveWood->m_nativeValue,
-            vSurfaceFuelMoisLiveWood->m_nativeUnits.latin1() );
+    if( EQTRACE_ON( m_trace ) )
+    {
+        m_trace->proc( "FuelMoisTimeLag", 6+MaxParts, MaxParts );
+        m_trace->var( 'i', vSurfaceFuelMoisDead1 );
+        m_trace->var( 'i', vSurfaceFuelMoisDead10 );
+        m_trace->var( 'i', vSurfaceFuelMoisDead100 );
+        m_trace->var( 'i', vSurfaceFuelMoisDead1000 );
+        m_trace->var( 'i', vSurfaceFuelMoisLiveHerb );
+        m_trace->var( 'i', vSurfaceFuelMoisLiveWood );
         for ( i = 0; i < MaxParts; i++ )
         {
-            fprintf( m_log, "%s  i vSurfaceFuelLife%d %g %s\n", Margin, i,
-                vSurfaceFuelLife[i]->m_nativeValue,
-                vSurfaceFuelLife[i]->m_nativeUnits.latin1() );
-            fprintf( m_log, "%s  i vSurfaceFuelSavr%d %g %s\n", Margin, i,
-                vSurfaceFuelSavr[i]->m_nativeValue,
-                vSurfaceFuelSavr[i]->m_nativeUnits.latin1() );
+            m_trace->var( 'i', vSurfaceFuelLife[i] );
+            m_trace->var( 'i', vSurfaceFuelSavr[i] );
         }
         for ( i = 0; i < MaxParts; i++ )
         {
-            fprintf( m_log, "%s  o vSurfaceFuelMois%d %g %s\n", Margin, i,
-                vSurfaceFuelMois[i]->m_nativeValue,
-                vSurfaceFuelMois[i]->m_nativeUnits.latin1() );
+            m_trace->var( 'o', vSurfaceFuelMois[i] );
         }
     }
     return;
@@ -5751,45 +5419,21 @@ void EqCalc::FuelPalmettoModel( void )
     vSurfaceFuelPalmettoLoadLiveFoliage->update( livef );
 
     // Log results
-    if( m_log )
-    {
-        fprintf( m_log, "%sbegin proc FuelPalmettoModel() 4 8\n", Margin );
-        fprintf( m_log, "%s  i vSurfaceFuelPalmettoAge %g %s\n", Margin,
-            vSurfaceFuelPalmettoAge->m_nativeValue,
-            vSurfaceFuelPalmettoAge->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFuelPalmettoCover %g %s\n", Margin,
-            vSurfaceFuelPalmettoCover->m_nativeValue,
-            vSurfaceFuelPalmettoCover->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFuelPalmettoHeight %g %s\n", Margin,
-            vSurfaceFuelPalmettoHeight->m_nativeValue,
-            vSurfaceFuelPalmettoHeight->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFuelPalmettoOverstoryBasalArea %g %s\n", Margin,
-            vSurfaceFuelPalmettoOverstoryBasalArea->m_nativeValue,
-            vSurfaceFuelPalmettoOverstoryBasalArea->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFuelPalmettoLoadDead1 %g %s\n", Margin,
-            vSurfaceFuelPalmettoLoadDead1->m_nativeValue,
-            vSurfaceFuelPalmettoLoadDead1->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFuelPalmettoLoadDead10 %g %s\n", Margin,
-            vSurfaceFuelPalmettoLoadDead10->m_nativeValue,
-            vSurfaceFuelPalmettoLoadDead10->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFuelPalmettoLoadDeadFoliage %g %s\n", Margin,
-            vSurfaceFuelPalmettoLoadDeadFoliage->m_nativeValue,
-            vSurfaceFuelPalmettoLoadDeadFoliage->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFuelPalmettoLoadLitter %g %s\n", Margin,
-            vSurfaceFuelPalmettoLoadLitter->m_nativeValue,
-            vSurfaceFuelPalmettoLoadLitter->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFuelPalmettoLoadLive1 %g %s\n", Margin,
-            vSurfaceFuelPalmettoLoadLive1->m_nativeValue,
-            vSurfaceFuelPalmettoLoadLive1->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFuelPalmettoLoadLive10 %g %s\n", Margin,
-            vSurfaceFuelPalmettoLoadLive10->m_nativeValue,
-            vSurfaceFuelPalmettoLoadLive10->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFuelPalmettoLoadLiveFoliage %g %s\n", Margin,
-            vSurfaceFuelPalmettoLoadLiveFoliage->m_nativeValue,
-            vSurfaceFuelPalmettoLoadLiveFoliage->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFuelBedDepth %g %s\n", Margin,
-            vSurfaceFuelBedDepth->m_nativeValue,
-            vSurfaceFuelBedDepth->m_nativeUnits.latin1() );
+    if( EQTRACE_ON( m_trace ) )
+    {
+        m_trace->proc( "FuelPalmettoModel", 4, 8 );
+        m_trace->var( 'i', vSurfaceFuelPalmettoAge );
+        m_trace->var( 'i', vSurfaceFuelPalmettoCover );
+        m_trace->var( 'i', vSurfaceFuelPalmettoHeight );
+        m_trace->var( 'i', vSurfaceFuelPalmettoOverstoryBasalArea );
+        m_trace->var( 'o', vSurfaceFuelPalmettoLoadDead1 );
+        m_trace->var( 'o', vSurfaceFuelPalmettoLoadDead10 );
+        m_trace->var( 'o', vSurfaceFuelPalmettoLoadDeadFoliage );
+        m_trace->var( 'o', vSurfaceFuelPalmettoLoadLitter );
+        m_trace->var( 'o', vSurfaceFuelPalmettoLoadLive1 );
+        m_trace->var( 'o', vSurfaceFuelPalmettoLoadLive10 );
+        m_trace->var( 'o', vSurfaceFuelPalmettoLoadLiveFoliage );
+        m_trace->var( 'o', vSurfaceFuelBedDepth );
     }
     return;
 }
@@ -5872,9 +5516,9 @@ void EqCalc::FuelPalmettoParms( void )
     vSurfaceFuelSeff[5]->update( 0.015 );
     vSurfaceFuelSeff[6]->update( 0.010 );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc FuelPalmettoParms() 0 0\n", Margin );
+        m_trace->proc( "FuelPalmettoParms", 0, 0 );
     }
     return;
 }
@@ -5900,18 +5544,12 @@ void EqCalc::FuelTemp( void )
     // Store results
     vSurfaceFuelTemp->update( fuelTemp );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc FuelTemp() 2 1\n", Margin );
-        fprintf( m_log, "%s  i vWthrAirTemp %g %s\n", Margin,
-            vWthrAirTemp->m_nativeValue,
-            vWthrAirTemp->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSiteSunShading %g %s\n", Margin,
-            vSiteSunShading->m_nativeValue,
-            vSiteSunShading->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSurfaceFuelTemp %g %s\n", Margin,
-            vSurfaceFuelTemp->m_nativeValue,
-            vSurfaceFuelTemp->m_nativeUnits.latin1() );
+        m_trace->proc( "FuelTemp", 2, 1 );
+        m_trace->var( 'i', vWthrAirTemp );
+        m_trace->var( 'i', vSiteSunShading );
+        m_trace->var( 'o', vSurfaceFuelTemp );
     }
     return;
 }
@@ -5933,15 +5571,11 @@ void EqCalc::IgnitionFirebrandFuelMoisFromDead1Hr( void )
     // Store results
     vIgnitionFirebrandFuelMois->update( fm );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc IgnitionFirebrandFuelMoisFromDead1Hr() 1 1\n", Margin );
-        fprintf( m_log, "%s  i vSurfaceFuelMoisDead1 %g %s\n", Margin,
-            vSurfaceFuelMoisDead1->m_nativeValue,
-            vSurfaceFuelMoisDead1->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vIgnitionFirebrandFuelMois %g %s\n", Margin,
-            vIgnitionFirebrandFuelMois->m_nativeValue,
-            vIgnitionFirebrandFuelMois->m_nativeUnits.latin1() );
+        m_trace->proc( "IgnitionFirebrandFuelMoisFromDead1Hr", 1, 1 );
+        m_trace->var( 'i', vSurfaceFuelMoisDead1 );
+        m_trace->var( 'o', vIgnitionFirebrandFuelMois );
     }
     return;
 }
@@ -5967,18 +5601,12 @@ void EqCalc::IgnitionFirebrandProb( void )
     // Store results
     vIgnitionFirebrandProb->update( prob );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc IgnitionFirebrandProb() 2 1\n", Margin );
-        fprintf( m_log, "%s  i vSurfaceFuelTemp %g %s\n", Margin,
-            vSurfaceFuelTemp->m_nativeValue,
-            vSurfaceFuelTemp->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vIgnitionFirebrandFuelMois %g %s\n", Margin,
-            vIgnitionFirebrandFuelMois->m_nativeValue,
-            vIgnitionFirebrandFuelMois->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vIgnitionFirebrandProb %g %s\n", Margin,
-            vIgnitionFirebrandProb->m_nativeValue,
-            vIgnitionFirebrandProb->m_nativeUnits.latin1() );
+        m_trace->proc( "IgnitionFirebrandProb", 2, 1 );
+        m_trace->var( 'i', vSurfaceFuelTemp );
+        m_trace->var( 'i', vIgnitionFirebrandFuelMois );
+        m_trace->var( 'o', vIgnitionFirebrandProb );
     }
     return;
 }
@@ -6000,15 +5628,11 @@ void EqCalc::IgnitionLightningFuelMoisFromDead100Hr( void )
     // Store results
     vIgnitionLightningFuelMois->update( fm );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc IgnitionLightningFuelMoisFromDead100Hr() 1 1\n", Margin );
-        fprintf( m_log, "%s  i vSurfaceFuelMoisDead100 %g %s\n", Margin,
-            vSurfaceFuelMoisDead100->m_nativeValue,
-            vSurfaceFuelMoisDead100->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vIgnitionLightningFuelMois %g %s\n", Margin,
-            vIgnitionLightningFuelMois->m_nativeValue,
-            vIgnitionLightningFuelMois->m_nativeUnits.latin1() );
+        m_trace->proc( "IgnitionLightningFuelMoisFromDead100Hr", 1, 1 );
+        m_trace->var( 'i', vSurfaceFuelMoisDead100 );
+        m_trace->var( 'o', vIgnitionLightningFuelMois );
     }
     return;
 }
@@ -6039,24 +5663,14 @@ void EqCalc::IgnitionLightningProb( void )
     // Store results
     vIgnitionLightningProb->update( prob );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc IgnitionLightningProb() 4 1\n", Margin );
-        fprintf( m_log, "%s  i vIgnitionLightningFuelType %d %s\n", Margin,
-            vIgnitionLightningFuelType->activeItemDataIndex(),
-            vIgnitionLightningFuelType->activeItemName().latin1() );
-        fprintf( m_log, "%s  i vIgnitionLightningDuffDepth %g %s\n", Margin,
-            vIgnitionLightningDuffDepth->m_nativeValue,
-            vIgnitionLightningDuffDepth->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vIgnitionLightningFuelMois %g %s\n", Margin,
-            vIgnitionLightningFuelMois->m_nativeValue,
-            vIgnitionLightningFuelMois->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vWthrLightningStrikeType %d %s\n", Margin,
-            vWthrLightningStrikeType->activeItemDataIndex(),
-            vWthrLightningStrikeType->activeItemName().latin1() );
-        fprintf( m_log, "%s  o vIgnitionLightningProb %g %s\n", Margin,
-            vIgnitionLightningProb->m_nativeValue,
-            vIgnitionLightningProb->m_nativeUnits.latin1() );
+        m_trace->proc( "IgnitionLightningProb", 4, 1 );
+        m_trace->item( 'i', vIgnitionLightningFuelType );
+        m_trace->var( 'i', vIgnitionLightningDuffDepth );
+        m_trace->var( 'i', vIgnitionLightningFuelMois );
+        m_trace->item( 'i', vWthrLightningStrikeType );
+        m_trace->var( 'o', vIgnitionLightningProb );
     }
     return;
 }
@@ -6082,15 +5696,11 @@ void EqCalc::MapScale( void )
     // Store results
     vMapScale->update( scale );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc MapScale() 2 1\n", Margin );
-        fprintf( m_log, "%s  i vMapFraction %g %s\n", Margin,
-            vMapFraction->m_nativeValue,
-            vMapFraction->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vMapScale %g %s\n", Margin,
-            vMapScale->m_nativeValue,
-            vMapScale->m_nativeUnits.latin1() );
+        m_trace->proc( "MapScale", 2, 1 );
+        m_trace->var( 'i', vMapFraction );
+        m_trace->var( 'o', vMapScale );
     }
     return;
 }
@@ -6128,30 +5738,16 @@ void EqCalc::MapSlope( void )
     vSiteSlopeRise->update( riseFt );
     vSiteSlopeReach->update( reachFt );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc MapSlope() 4 3\n", Margin );
-        fprintf( m_log, "%s  i vMapFraction %g %s\n", Margin,
-            vMapFraction->m_nativeValue,
-            vMapFraction->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vMapDist %g %s\n", Margin,
-            vMapDist->m_nativeValue,
-            vMapDist->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vMapContourCount %g %s\n", Margin,
-            vMapContourCount->m_nativeValue,
-            vMapContourCount->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vMapContourInterval %g %s\n", Margin,
-            vMapContourInterval->m_nativeValue,
-            vMapContourInterval->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSiteSlopeDegrees %g %s\n", Margin,
-            vSiteSlopeDegrees->m_nativeValue,
-            vSiteSlopeDegrees->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSiteSlopeRise %g %s\n", Margin,
-            vSiteSlopeRise->m_nativeValue,
-            vSiteSlopeRise->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSiteSlopeReach %g %s\n", Margin,
-            vSiteSlopeReach->m_nativeValue,
-            vSiteSlopeReach->m_nativeUnits.latin1() );
+        m_trace->proc( "MapSlope", 4, 3 );
+        m_trace->var( 'i', vMapFraction );
+        m_trace->var( 'i', vMapDist );
+        m_trace->var( 'i', vMapContourCount );
+        m_trace->var( 'i', vMapContourInterval );
+        m_trace->var( 'o', vSiteSlopeDegrees );
+        m_trace->var( 'o', vSiteSlopeRise );
+        m_trace->var( 'o', vSiteSlopeReach );
     }
     return;
 }
@@ -6192,36 +5788,18 @@ void EqCalc::SafetyZoneRadius( void )
     vSafetyZoneLength->update(length );
     vSafetyZoneSizeSquare->update( square );
     // Log results
-    if( m_log )
-    {
-        fprintf( m_log, "%sbegin proc SafetyZoneAtVector() 5 4\n", Margin );
-        fprintf( m_log, "%s  i vSafetyZoneSepDist %g %s\n", Margin,
-            vSafetyZoneSepDist->m_nativeValue,
-            vSafetyZoneSepDist->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSafetyZoneEquipmentArea %g %s\n", Margin,
-            vSafetyZoneEquipmentArea->m_nativeValue,
-            vSafetyZoneEquipmentArea->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSafetyZoneEquipmentNumber %g %s\n", Margin,
-            vSafetyZoneEquipmentNumber->m_nativeValue,
-            vSafetyZoneEquipmentNumber->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSafetyZonePersonnelArea %g %s\n", Margin,
-            vSafetyZonePersonnelArea->m_nativeValue,
-            vSafetyZonePersonnelArea->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSafetyZonePersonnelNumber %g %s\n", Margin,
-            vSafetyZonePersonnelNumber->m_nativeValue,
-            vSafetyZonePersonnelNumber->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSafetyZoneLength %g %s\n", Margin,
-            vSafetyZoneLength->m_nativeValue,
-            vSafetyZoneLength->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSafetyZoneRadius %g %s\n", Margin,
-            vSafetyZoneRadius->m_nativeValue,
-            vSafetyZoneRadius->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSafetyZoneSize %g %s\n", Margin,
-            vSafetyZoneSize->m_nativeValue,
-            vSafetyZoneSize->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSafetyZoneSizeSquare %g %s\n", Margin,
-            vSafetyZoneSizeSquare->m_nativeValue,
-            vSafetyZoneSizeSquare->m_nativeUnits.latin1() );
+    if( EQTRACE_ON( m_trace ) )
+    {
+        m_trace->proc( "SafetyZoneAtVector", 5, 4 );
+        m_trace->var( 'i', vSafetyZoneSepDist );
+        m_trace->var( 'i', vSafetyZoneEquipmentArea );
+        m_trace->var( 'i', vSafetyZoneEquipmentNumber );
+        m_trace->var( 'i', vSafetyZonePersonnelArea );
+        m_trace->var( 'i', vSafetyZonePersonnelNumber );
+        m_trace->var( 'o', vSafetyZoneLength );
+        m_trace->var( 'o', vSafetyZoneRadius );
+        m_trace->var( 'o', vSafetyZoneSize );
+        m_trace->var( 'o', vSafetyZoneSizeSquare );
     }
     return;
 }
@@ -6245,19 +5823,192 @@ void EqCalc::SafetyZoneSepDist( void )
     // Store results
     vSafetyZoneSepDist->update( sepDist );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc SafetyZoneSepDist() 1 1\n", Margin );
-        fprintf( m_log, "%s  i vSurfaceFireFlameLengAtHead %g %s\n", Margin,
-            vSurfaceFireFlameLengAtHead->m_nativeValue,
-            vSurfaceFireFlameLengAtHead->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSafetyZoneSepDist %g %s\n", Margin,
-            vSafetyZoneSepDist->m_nativeValue,
-            vSafetyZoneSepDist->m_nativeUnits.latin1() );
+        m_trace->proc( "SafetyZoneSepDist", 1, 1 );
+        m_trace->var( 'i', vSurfaceFireFlameLengAtHead );
+        m_trace->var( 'o', vSafetyZoneSepDist );
     }
     return;
 }
 
+//------------------------------------------------------------------------------
+/*! \brief Indices of the fire model inputs in the SensitivityFireVars()
+ *  array.
+ */
+enum
+{
+    SensFireDepth = 0,
+    SensFireMext,
+    SensFirePart,                                   // 7 per particle slot
+    SensFireSlope = SensFirePart + 7 * MaxParts,
+    SensFireAspect,
+    SensFireWind,
+    SensFireWindDir,
+    SensCrownMois1,
+    SensCrownMois10,
+    SensCrownMois100,
+    SensCrownMoisWood,
+    SensCrownWind,
+    SensFireVars
+};
+
+//------------------------------------------------------------------------------
+/*! \brief SensitivityFire
+ *      Sets up the Bp6Dual surface and crown fires of the table cell just
+ *      calculated, with the fire model inputs \a x (native units, in the
+ *      order of SensitivityFireVars()) carrying their derivatives.
+ *
+ *  Not an EqFun; called only by EqSensitivity::run().  The surface fire is
+ *  set up as by SpreadProfileFire(), and the crown fire as by
+ *  V6CrownFireActiveSpreadRate().
+ */
+
+void EqCalc::SensitivityFire( Bp6SurfaceFireT<Bp6Dual> *fire,
+        Bp6CrownFireT<Bp6Dual> *crown, const Bp6Dual *x )
+{
+    Bp6Dual dens[MaxParts], heat[MaxParts], load[MaxParts], savr[MaxParts];
+    Bp6Dual seff[MaxParts], stot[MaxParts], mois[MaxParts];
+    int     life[MaxParts];
+    for ( int p=0; p<MaxParts; p++ )
+    {
+        const Bp6Dual *part = x + SensFirePart + 7 * p;
+        life[p] = vSurfaceFuelLife[p]->activeItemDataIndex();
+        load[p] = part[0];
+        savr[p] = part[1];
+        heat[p] = part[2];
+        dens[p] = part[3];
+        stot[p] = part[4];
+        seff[p] = part[5];
+        mois[p] = part[6];
+    }
+    PropertyDict *prop = m_eqTree->m_propDict;
+    bool applyWindLimit = prop->boolean( "surfaceConfWindLimitApplied" )
+                     && ! prop->boolean( "surfaceConfFuelAspen" );
+    fire->setFuel( x[SensFireDepth], x[SensFireMext], MaxParts,
+        life, load, savr, heat, dens, stot, seff );
+    fire->setMoisture( mois );
+    fire->setSite( x[SensFireSlope], x[SensFireAspect], 88. * x[SensFireWind],
+        x[SensFireWindDir], applyWindLimit );
+
+    Bp6Dual crownMois[4];
+    crownMois[0] = x[SensCrownMois1];
+    crownMois[1] = x[SensCrownMois10];
+    crownMois[2] = x[SensCrownMois100];
+    crownMois[3] = x[SensCrownMoisWood];
+    crown->setMoisture( crownMois );
+    crown->setWindSpeedAt20FtFpm( 88. * x[SensCrownWind] );
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief SensitivityFireOutput
+ *      Gets the value and derivatives of an output variable from the
+ *      Bp6Dual fires set up by SensitivityFire().
+ *
+ *  \param var   Pointer to the output variable.
+ *  \param fire  Pointer to the Bp6Dual surface fire.
+ *  \param crown Pointer to the Bp6Dual crown fire.
+ *  \param value Returns the output value in native units.
+ *
+ *  \return TRUE if \a var is calculated by the active fire model function
+ *  from these inputs, FALSE if its derivatives must be found otherwise.
+ */
+
+bool EqCalc::SensitivityFireOutput( EqVar *var, Bp6SurfaceFireT<Bp6Dual> *fire,
+        Bp6CrownFireT<Bp6Dual> *crown, Bp6Dual *value )
+{
+    // Surface fire outputs of single fuel model runs
+    if ( m_eqTree->m_propDict->boolean( "surfaceModuleActive" )
+      && fSurfaceFireSpreadAtHead->m_active )
+    {
+        if ( var == vSurfaceFireSpreadAtHead )
+        {
+            *value = fire->getSpreadRateAtHead();
+            return( true );
+        }
+        if ( var == vSurfaceFireLineIntAtHead )
+        {
+            *value = fire->getFirelineIntensityAtHead();
+            return( true );
+        }
+        if ( var == vSurfaceFireFlameLengAtHead )
+        {
+            *value = fire->getFlameLengthAtHead();
+            return( true );
+        }
+        if ( var == vSurfaceFireHeatPerUnitArea )
+        {
+            *value = fire->getHeatPerUnitArea();
+            return( true );
+        }
+        if ( var == vSurfaceFireReactionInt )
+        {
+            *value = fire->getTotalRxInt();
+            return( true );
+        }
+        if ( var == vSurfaceFireEffWindAtHead )
+        {
+            *value = fire->getEffectiveWindSpeed() / 88.;
+            return( true );
+        }
+    }
+    // Crown fire outputs
+    if ( fCrownFireActiveSpreadRate->m_active
+      && var == vCrownFireActiveSpreadRate )
+    {
+        *value = crown->getActiveCrownFireRos();
+        return( true );
+    }
+    return( false );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief SensitivityFireVars
+ *      Gets the variables whose native values are the SensitivityFire()
+ *      inputs.
+ *
+ *  \param var Array to fill with the variable pointers, or NULL.
+ *
+ *  \return Number of variables (the size \a var must be).
+ */
+
+int EqCalc::SensitivityFireVars( EqVar **var )
+{
+    if ( ! var )
+    {
+        return( SensFireVars );
+    }
+    var[SensFireDepth] = vSurfaceFuelBedDepth;
+    var[SensFireMext]  = vSurfaceFuelBedMextDead;
+    for ( int p=0; p<MaxParts; p++ )
+    {
+        EqVar **part = var + SensFirePart + 7 * p;
+        part[0] = vSurfaceFuelLoad[p];
+        part[1] = vSurfaceFuelSavr[p];
+        part[2] = vSurfaceFuelHeat[p];
+        part[3] = vSurfaceFuelDens[p];
+        part[4] = vSurfaceFuelStot[p];
+        part[5] = vSurfaceFuelSeff[p];
+        part[6] = vSurfaceFuelMois[p];
+    }
+    // Fuel load transfer as applied by FuelBedIntermediates()
+    int LiveHerb = 3;
+    int DeadHerb = 5;
+    var[SensFirePart + 7 * LiveHerb] = vSurfaceFuelLoadUndeadHerb;
+    var[SensFirePart + 7 * DeadHerb] = vSurfaceFuelLoadDeadHerb;
+    var[SensFireSlope]     = vSiteSlopeFraction;
+    var[SensFireAspect]    = vSiteAspectDirFromNorth;
+    var[SensFireWind]      = vWindSpeedAtMidflame;
+    var[SensFireWindDir]   = vWindDirFromUpslope;
+    var[SensCrownMois1]    = vSurfaceFuelMoisDead1;
+    var[SensCrownMois10]   = vSurfaceFuelMoisDead10;
+    var[SensCrownMois100]  = vSurfaceFuelMoisDead100;
+    var[SensCrownMoisWood] = vSurfaceFuelMoisLiveWood;
+    var[SensCrownWind]     = vWindSpeedAt20Ft;
+    return( SensFireVars );
+}
+
 //------------------------------------------------------------------------------
 /*! \brief SiteAspectDirFromNorth
  *
@@ -6277,15 +6028,11 @@ void EqCalc::SiteAspectDirFromNorth( void )
     // Store results
     vSiteAspectDirFromNorth->update( deg );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc SiteAspectDirFromNorth() 1 1\n", Margin );
-        fprintf( m_log, "%s  i vSiteAspectDirFromCompass %d %s\n", Margin,
-            vSiteAspectDirFromCompass->activeItemDataIndex(),
-            vSiteAspectDirFromCompass->activeItemName().latin1() );
-        fprintf( m_log, "%s  o vSiteAspectDirFromNorth %g %s\n", Margin,
-            vSiteAspectDirFromNorth->m_nativeValue,
-            vSiteAspectDirFromNorth->m_nativeUnits.latin1() );
+        m_trace->proc( "SiteAspectDirFromNorth", 1, 1 );
+        m_trace->item( 'i', vSiteAspectDirFromCompass );
+        m_trace->var( 'o', vSiteAspectDirFromNorth );
     }
     return;
 }
@@ -6313,18 +6060,12 @@ void EqCalc::SiteRidgeToValleyDist( void )
     // Store results
     vSiteRidgeToValleyDist->update( mi );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc SiteRidgeToValleyDist() 2 1\n", Margin );
-        fprintf( m_log, "%s  i vSiteRidgeToValleyMapDist %g %s\n", Margin,
-            vSiteRidgeToValleyMapDist->m_nativeValue,
-            vSiteRidgeToValleyMapDist->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vMapScale %g %s\n", Margin,
-            vMapScale->m_nativeValue,
-            vMapScale->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSiteRidgeToValleyDist %g %s\n", Margin,
-            vSiteRidgeToValleyDist->m_nativeValue,
-            vSiteRidgeToValleyDist->m_nativeUnits.latin1() );
+        m_trace->proc( "SiteRidgeToValleyDist", 2, 1 );
+        m_trace->var( 'i', vSiteRidgeToValleyMapDist );
+        m_trace->var( 'i', vMapScale );
+        m_trace->var( 'o', vSiteRidgeToValleyDist );
     }
     return;
 }
@@ -6348,15 +6089,11 @@ void EqCalc::SiteSlopeFraction ( void )
     // Store results
     vSiteSlopeFraction->update( f );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc SiteSlopeFraction() 1 1\n", Margin );
-        fprintf( m_log, "%s  i vSiteSlopeDegrees %g %s\n", Margin,
-            vSiteSlopeDegrees->m_nativeValue,
-            vSiteSlopeDegrees->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSiteSlopeFraction %g %s\n", Margin,
-            vSiteSlopeFraction->m_nativeValue,
-            vSiteSlopeFraction->m_nativeUnits.latin1() );
+        m_trace->proc( "SiteSlopeFraction", 1, 1 );
+        m_trace->var( 'i', vSiteSlopeDegrees );
+        m_trace->var( 'o', vSiteSlopeFraction );
     }
     return;
 }
@@ -6382,15 +6119,11 @@ void EqCalc::SiteUpslopeDirFromNorth( void )
     // Store results
     vSiteUpslopeDirFromNorth->update( upslope );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc SiteUpslopeDirFromNorth() 1 1\n", Margin );
-        fprintf( m_log, "%s  i vSiteAspectDirFromNorth %g %s\n", Margin,
-            vSiteAspectDirFromNorth->m_nativeValue,
-            vSiteAspectDirFromNorth->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSiteUpslopeDirFromNorth %g %s\n", Margin,
-            vSiteUpslopeDirFromNorth->m_nativeValue,
-            vSiteUpslopeDirFromNorth->m_nativeUnits.latin1() );
+        m_trace->proc( "SiteUpslopeDirFromNorth", 1, 1 );
+        m_trace->var( 'i', vSiteAspectDirFromNorth );
+        m_trace->var( 'o', vSiteUpslopeDirFromNorth );
     }
     return;
 }
@@ -6458,42 +6191,21 @@ void EqCalc::SpotDistActiveCrown( void )
 	delete processor;
 
     // Log results
-    if( m_log )
-    {
-        fprintf( m_log, "%sbegin proc SpotDistActiveCrown() 7 4\n", Margin );
-        fprintf( m_log, "%s  i vTreeCoverHt %g %s\n", Margin,
-            vTreeCoverHt->m_nativeValue,
-            vTreeCoverHt->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSpotEmberDiamAtSurface %g %s\n", Margin,
-            vSpotEmberDiamAtSurface->m_nativeValue,
-            vSpotEmberDiamAtSurface->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vCrownFireActiveFireLintInt %g %s\n", Margin,
-            vCrownFireActiveFireLineInt->m_nativeValue,
-            vCrownFireActiveFireLineInt->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vWindSpeedAt20Ft %g %s\n", Margin,
-            vWindSpeedAt20Ft->m_nativeValue,
-            vWindSpeedAt20Ft->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSiteRidgeToValleyElev %g %s\n", Margin,
-            vSiteRidgeToValleyElev->m_nativeValue,
-            vSiteRidgeToValleyElev->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSiteRidgeToValleyDist %g %s\n", Margin,
-            vSiteRidgeToValleyDist->m_nativeValue,
-            vSiteRidgeToValleyDist->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSpotFireSource %d %s\n", Margin,
-            vSpotFireSource->activeItemDataIndex(),
-            vSpotFireSource->activeItemName().latin1() );
-        fprintf( m_log, "%s  o vSpotDistActiveCrown %g %s\n", Margin,
-            vSpotDistActiveCrown->m_nativeValue,
-            vSpotDistActiveCrown->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSpotFlameHtActiveCrown %g %s\n", Margin,
-            vSpotFlameHtActiveCrown->m_nativeValue,
-            vSpotFlameHtActiveCrown->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSpotFirebrandHtActiveCrown %g %s\n", Margin,
-            vSpotFirebrandHtActiveCrown->m_nativeValue,
-            vSpotFirebrandHtActiveCrown->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSpotFlatDistActiveCrown %g %s\n", Margin,
-            vSpotFlatDistActiveCrown->m_nativeValue,
-            vSpotFlatDistActiveCrown->m_nativeUnits.latin1() );
+    if( EQTRACE_ON( m_trace ) )
+    {
+        m_trace->proc( "SpotDistActiveCrown", 7, 4 );
+        m_trace->var( 'i', vTreeCoverHt );
+        m_trace->var( 'i', vSpotEmberDiamAtSurface );
+        m_trace->var( 'i', vCrownFireActiveFireLineInt,
+            "vCrownFireActiveFireLintInt" );
+        m_trace->var( 'i', vWindSpeedAt20Ft );
+        m_trace->var( 'i', vSiteRidgeToValleyElev );
+        m_trace->var( 'i', vSiteRidgeToValleyDist );
+        m_trace->item( 'i', vSpotFireSource );
+        m_trace->var( 'o', vSpotDistActiveCrown );
+        m_trace->var( 'o', vSpotFlameHtActiveCrown );
+        m_trace->var( 'o', vSpotFirebrandHtActiveCrown );
+        m_trace->var( 'o', vSpotFlatDistActiveCrown );
     }
     return;
 }
@@ -6538,42 +6250,20 @@ void EqCalc::SpotDistBurningPile( void )
     vSpotFirebrandHtBurningPile->update( firebrandHt );
     vSpotFlatDistBurningPile->update( flatDist );
     // Log results
-    if( m_log )
-    {
-        fprintf( m_log, "%sbegin proc SpotDistBurningPile() 7 4\n", Margin );
-        fprintf( m_log, "%s  i vSurfaceFireFlameHtPile %g %s\n", Margin,
-            vSurfaceFireFlameHtPile->m_nativeValue,
-            vSurfaceFireFlameHtPile->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSiteRidgeToValleyDist %g %s\n", Margin,
-            vSiteRidgeToValleyDist->m_nativeValue,
-            vSiteRidgeToValleyDist->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSiteRidgeToValleyElev %g %s\n", Margin,
-            vSiteRidgeToValleyElev->m_nativeValue,
-            vSiteRidgeToValleyElev->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vTreeCoverHtDownwind %g %s\n", Margin,
-            vTreeCoverHtDownwind->m_nativeValue,
-            vTreeCoverHtDownwind->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vTreeCanopyCoverDownwind %d %s\n", Margin,
-            vTreeCanopyCoverDownwind->activeItemDataIndex(),
-            vTreeCanopyCoverDownwind->activeItemName().latin1() );
-        fprintf( m_log, "%s  i vWindSpeedAt20Ft %g %s\n", Margin,
-            vWindSpeedAt20Ft->m_nativeValue,
-            vWindSpeedAt20Ft->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSpotFireSource %d %s\n", Margin,
-            vSpotFireSource->activeItemDataIndex(),
-            vSpotFireSource->activeItemName().latin1() );
-        fprintf( m_log, "%s  o vSpotDistBurningPile %g %s\n", Margin,
-            vSpotDistBurningPile->m_nativeValue,
-            vSpotDistBurningPile->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSpotCoverHtBurningPile %g %s\n", Margin,
-            vSpotCoverHtBurningPile->m_nativeValue,
-            vSpotCoverHtBurningPile->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSpotFirebrandHtBurningPile %g %s\n", Margin,
-            vSpotFirebrandHtBurningPile->m_nativeValue,
-            vSpotFirebrandHtBurningPile->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSpotFlatDistBurningPile %g %s\n", Margin,
-            vSpotFlatDistBurningPile->m_nativeValue,
-            vSpotFlatDistBurningPile->m_nativeUnits.latin1() );
+    if( EQTRACE_ON( m_trace ) )
+    {
+        m_trace->proc( "SpotDistBurningPile", 7, 4 );
+        m_trace->var( 'i', vSurfaceFireFlameHtPile );
+        m_trace->var( 'i', vSiteRidgeToValleyDist );
+        m_trace->var( 'i', vSiteRidgeToValleyElev );
+        m_trace->var( 'i', vTreeCoverHtDownwind );
+        m_trace->item( 'i', vTreeCanopyCoverDownwind );
+        m_trace->var( 'i', vWindSpeedAt20Ft );
+        m_trace->item( 'i', vSpotFireSource );
+        m_trace->var( 'o', vSpotDistBurningPile );
+        m_trace->var( 'o', vSpotCoverHtBurningPile );
+        m_trace->var( 'o', vSpotFirebrandHtBurningPile );
+        m_trace->var( 'o', vSpotFlatDistBurningPile );
     }
     return;
 }
@@ -6620,45 +6310,21 @@ void EqCalc::SpotDistSurfaceFire( void )
     vSpotFirebrandHtSurfaceFire->update( firebrandHt );
     vSpotFlatDistSurfaceFire->update( flatDist );
     // Log results
-    if( m_log )
-    {
-        fprintf( m_log, "%sbegin proc SpotDistSurfaceFire() 7 5\n", Margin );
-        fprintf( m_log, "%s  i vSurfaceFireFlameLengAtHead %g %s\n", Margin,
-            vSurfaceFireFlameLengAtHead->m_nativeValue,
-            vSurfaceFireFlameLengAtHead->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSiteRidgeToValleyDist %g %s\n", Margin,
-            vSiteRidgeToValleyDist->m_nativeValue,
-            vSiteRidgeToValleyDist->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSiteRidgeToValleyElev %g %s\n", Margin,
-            vSiteRidgeToValleyElev->m_nativeValue,
-            vSiteRidgeToValleyElev->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vTreeCoverHtDownwind %g %s\n", Margin,
-            vTreeCoverHtDownwind->m_nativeValue,
-            vTreeCoverHtDownwind->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vTreeCanopyCoverDownwind %d %s\n", Margin,
-            vTreeCanopyCoverDownwind->activeItemDataIndex(),
-            vTreeCanopyCoverDownwind->activeItemName().latin1() );
-        fprintf( m_log, "%s  i vWindSpeedAt20Ft %g %s\n", Margin,
-            vWindSpeedAt20Ft->m_nativeValue,
-            vWindSpeedAt20Ft->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSpotFireSource %d %s\n", Margin,
-            vSpotFireSource->activeItemDataIndex(),
-            vSpotFireSource->activeItemName().latin1() );
-        fprintf( m_log, "%s  o vSpotDistSurfaceFire %g %s\n", Margin,
-            vSpotDistSurfaceFire->m_nativeValue,
-            vSpotDistSurfaceFire->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSpotCoverHtSurfaceFire %g %s\n", Margin,
-            vSpotCoverHtSurfaceFire->m_nativeValue,
-            vSpotCoverHtSurfaceFire->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSpotFirebrandDriftSurfaceFire %g %s\n", Margin,
-            vSpotFirebrandDriftSurfaceFire->m_nativeValue,
-            vSpotFirebrandDriftSurfaceFire->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSpotFirebrandHtSurfaceFire %g %s\n", Margin,
-            vSpotFirebrandHtSurfaceFire->m_nativeValue,
-            vSpotFirebrandHtSurfaceFire->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSpotFlatDistSurfaceFire %g %s\n", Margin,
-            vSpotFlatDistSurfaceFire->m_nativeValue,
-            vSpotFlatDistSurfaceFire->m_nativeUnits.latin1() );
+    if( EQTRACE_ON( m_trace ) )
+    {
+        m_trace->proc( "SpotDistSurfaceFire", 7, 5 );
+        m_trace->var( 'i', vSurfaceFireFlameLengAtHead );
+        m_trace->var( 'i', vSiteRidgeToValleyDist );
+        m_trace->var( 'i', vSiteRidgeToValleyElev );
+        m_trace->var( 'i', vTreeCoverHtDownwind );
+        m_trace->item( 'i', vTreeCanopyCoverDownwind );
+        m_trace->var( 'i', vWindSpeedAt20Ft );
+        m_trace->item( 'i', vSpotFireSource );
+        m_trace->var( 'o', vSpotDistSurfaceFire );
+        m_trace->var( 'o', vSpotCoverHtSurfaceFire );
+        m_trace->var( 'o', vSpotFirebrandDriftSurfaceFire );
+        m_trace->var( 'o', vSpotFirebrandHtSurfaceFire );
+        m_trace->var( 'o', vSpotFlatDistSurfaceFire );
     }
     return;
 }
@@ -6724,60 +6390,26 @@ void EqCalc::SpotDistTorchingTrees( void )
     vSpotFlameRatioTorchingTrees->update( flameRatio );
     vSpotFlatDistTorchingTrees->update( flatDist );
     // Log results
-    if( m_log )
-    {
-        fprintf( m_log, "%sbegin proc SpotDistTorchingTrees() 10 7\n", Margin );
-        fprintf( m_log, "%s  i vSiteRidgeToValleyDist %g %s\n", Margin,
-            vSiteRidgeToValleyDist->m_nativeValue,
-            vSiteRidgeToValleyDist->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSiteRidgeToValleyElev %g %s\n", Margin,
-            vSiteRidgeToValleyElev->m_nativeValue,
-            vSiteRidgeToValleyElev->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSpotFireSource %d %s\n", Margin,
-            vSpotFireSource->activeItemDataIndex(),
-            vSpotFireSource->activeItemName().latin1() );
-        fprintf( m_log, "%s  i vSpotTorchingTrees %g %s\n", Margin,
-            vSpotTorchingTrees->m_nativeValue,
-            vSpotTorchingTrees->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vTreeCoverHtDownwind %g %s\n", Margin,
-            vTreeCoverHtDownwind->m_nativeValue,
-            vTreeCoverHtDownwind->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vTreeCanopyCoverDownwind %d %s\n", Margin,
-            vTreeCanopyCoverDownwind->activeItemDataIndex(),
-            vTreeCanopyCoverDownwind->activeItemName().latin1() );
-        fprintf( m_log, "%s  i vTreeHt %g %s\n", Margin,
-            vTreeHt->m_nativeValue,
-            vTreeHt->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vTreeDbh %g %s\n", Margin,
-            vTreeDbh->m_nativeValue,
-            vTreeDbh->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vTreeSpeciesSpot %d %s\n", Margin,
-            vTreeSpeciesSpot->activeItemDataIndex(),
-            vTreeSpeciesSpot->activeItemName().latin1() );
-        fprintf( m_log, "%s  i vWindSpeedAt20Ft %g %s\n", Margin,
-            vWindSpeedAt20Ft->m_nativeValue,
-            vWindSpeedAt20Ft->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSpotDistTorchingTrees %g %s\n", Margin,
-            vSpotDistTorchingTrees->m_nativeValue,
-            vSpotDistTorchingTrees->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSpotCoverHtTorchingTrees %g %s\n", Margin,
-            vSpotCoverHtTorchingTrees->m_nativeValue,
-            vSpotCoverHtTorchingTrees->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSpotFirebrandHtTorchingTrees %g %s\n", Margin,
-            vSpotFirebrandHtTorchingTrees->m_nativeValue,
-            vSpotFirebrandHtTorchingTrees->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSpotFlameDurTorchingTrees %g %s\n", Margin,
-            vSpotFlameDurTorchingTrees->m_nativeValue,
-            vSpotFlameDurTorchingTrees->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSpotFlameHtTorchingTrees %g %s\n", Margin,
-            vSpotFlameHtTorchingTrees->m_nativeValue,
-            vSpotFlameHtTorchingTrees->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSpotFlameRatioTorchingTrees %g %s\n", Margin,
-            vSpotFlameRatioTorchingTrees->m_nativeValue,
-            vSpotFlameRatioTorchingTrees->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSpotFlatDistTorchingTrees %g %s\n", Margin,
-            vSpotFlatDistTorchingTrees->m_nativeValue,
-            vSpotFlatDistTorchingTrees->m_nativeUnits.latin1() );
+    if( EQTRACE_ON( m_trace ) )
+    {
+        m_trace->proc( "SpotDistTorchingTrees", 10, 7 );
+        m_trace->var( 'i', vSiteRidgeToValleyDist );
+        m_trace->var( 'i', vSiteRidgeToValleyElev );
+        m_trace->item( 'i', vSpotFireSource );
+        m_trace->var( 'i', vSpotTorchingTrees );
+        m_trace->var( 'i', vTreeCoverHtDownwind );
+        m_trace->item( 'i', vTreeCanopyCoverDownwind );
+        m_trace->var( 'i', vTreeHt );
+        m_trace->var( 'i', vTreeDbh );
+        m_trace->item( 'i', vTreeSpeciesSpot );
+        m_trace->var( 'i', vWindSpeedAt20Ft );
+        m_trace->var( 'o', vSpotDistTorchingTrees );
+        m_trace->var( 'o', vSpotCoverHtTorchingTrees );
+        m_trace->var( 'o', vSpotFirebrandHtTorchingTrees );
+        m_trace->var( 'o', vSpotFlameDurTorchingTrees );
+        m_trace->var( 'o', vSpotFlameHtTorchingTrees );
+        m_trace->var( 'o', vSpotFlameRatioTorchingTrees );
+        m_trace->var( 'o', vSpotFlatDistTorchingTrees );
     }
     return;
 }
@@ -6803,18 +6435,12 @@ void EqCalc::SpotMapDistActiveCrown( void )
     // Store results
     vSpotMapDistActiveCrown->update( md );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc SpotMapDistActiveCrown() 2 1\n", Margin );
-        fprintf( m_log, "%s  i vSpotDistActiveCrown %g %s\n", Margin,
-            vSpotDistActiveCrown->m_nativeValue,
-            vSpotDistActiveCrown->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vMapScale %g %s\n", Margin,
-            vMapScale->m_nativeValue,
-            vMapScale->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSpotMapDistActiveCrown %g %s\n", Margin,
-            vSpotMapDistActiveCrown->m_nativeValue,
-            vSpotMapDistActiveCrown->m_nativeUnits.latin1() );
+        m_trace->proc( "SpotMapDistActiveCrown", 2, 1 );
+        m_trace->var( 'i', vSpotDistActiveCrown );
+        m_trace->var( 'i', vMapScale );
+        m_trace->var( 'o', vSpotMapDistActiveCrown );
     }
     return;
 }
@@ -6839,18 +6465,12 @@ void EqCalc::SpotMapDistBurningPile( void )
     // Store results
     vSpotMapDistBurningPile->update( md );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc SpotMapDistBurningPile() 2 1\n", Margin );
-        fprintf( m_log, "%s  i vSpotDistBurningPile %g %s\n", Margin,
-            vSpotDistBurningPile->m_nativeValue,
-            vSpotDistBurningPile->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vMapScale %g %s\n", Margin,
-            vMapScale->m_nativeValue,
-            vMapScale->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSpotMapDistBurningPile %g %s\n", Margin,
-            vSpotMapDistBurningPile->m_nativeValue,
-            vSpotMapDistBurningPile->m_nativeUnits.latin1() );
+        m_trace->proc( "SpotMapDistBurningPile", 2, 1 );
+        m_trace->var( 'i', vSpotDistBurningPile );
+        m_trace->var( 'i', vMapScale );
+        m_trace->var( 'o', vSpotMapDistBurningPile );
     }
     return;
 }
@@ -6876,18 +6496,12 @@ void EqCalc::SpotMapDistSurfaceFire( void )
     // Store results
     vSpotMapDistSurfaceFire->update( md );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc SpotMapDistSurfaceFire() 2 1\n", Margin );
-        fprintf( m_log, "%s  i vSpotDistSurfaceFire %g %s\n", Margin,
-            vSpotDistSurfaceFire->m_nativeValue,
-            vSpotDistSurfaceFire->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vMapScale %g %s\n", Margin,
-            vMapScale->m_nativeValue,
-            vMapScale->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSpotMapDistSurfaceFire %g %s\n", Margin,
-            vSpotMapDistSurfaceFire->m_nativeValue,
-            vSpotMapDistSurfaceFire->m_nativeUnits.latin1() );
+        m_trace->proc( "SpotMapDistSurfaceFire", 2, 1 );
+        m_trace->var( 'i', vSpotDistSurfaceFire );
+        m_trace->var( 'i', vMapScale );
+        m_trace->var( 'o', vSpotMapDistSurfaceFire );
     }
     return;
 }
@@ -6913,19 +6527,83 @@ void EqCalc::SpotMapDistTorchingTrees( void )
     // Store results
     vSpotMapDistTorchingTrees->update( md );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
+    {
+        m_trace->proc( "SpotMapDistTorchingTree", 2, 1 );
+        m_trace->var( 'i', vSpotDistTorchingTrees );
+        m_trace->var( 'i', vMapScale );
+        m_trace->var( 'o', vSpotMapDistTorchingTrees );
+    }
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief SpreadProfileFire
+ *      Sets up \a fire with the fuel, moisture, and site of the table cell
+ *      just calculated, so its spread profiles may be exported.
+ *
+ *  Not an EqFun; called only by EqTree::runTable() after a single fuel
+ *  model cell has calculated fSurfaceFireSpreadAtHead.  The transferred
+ *  herb loads are taken from FuelBedIntermediates().
+ *
+ *  Independent Variables (Inputs)
+ *      vSurfaceFuelBedDepth (ft)
+ *      vSurfaceFuelBedMextDead (lb/lb)
+ *      vSurfaceFuelDens# (lbs/ft3)
+ *      vSurfaceFuelHeat# (Btu/lb)
+ *      vSurfaceFuelLife# (category)
+ *      vSurfaceFuelLoad# (lbs/ft2)
+ *      vSurfaceFuelLoadDeadHerb (lbs/ft2)
+ *      vSurfaceFuelLoadUndeadHerb (lbs/ft2)
+ *      vSurfaceFuelMois# (fraction)
+ *      vSurfaceFuelSavr# (ft2/ft3)
+ *      vSurfaceFuelSeff# (fraction)
+ *      vSurfaceFuelStot# (fraction)
+ *      vSiteAspectDirFromNorth (degrees)
+ *      vSiteSlopeFraction (rise/reach)
+ *      vWindDirFromUpslope (degrees)
+ *      vWindSpeedAtMidflame (mi/h)
+ */
+
+void EqCalc::SpreadProfileFire( Bp6SurfaceFire *fire )
+{
+    // Access current input values
+    double dens[MaxParts], heat[MaxParts], load[MaxParts], savr[MaxParts];
+    double seff[MaxParts], stot[MaxParts], mois[MaxParts];
+    int    life[MaxParts];
+    for ( int p=0; p<MaxParts; p++ )
     {
-        fprintf( m_log, "%sbegin proc SpotMapDistTorchingTree() 2 1\n", Margin );
-        fprintf( m_log, "%s  i vSpotDistTorchingTrees %g %s\n", Margin,
-            vSpotDistTorchingTrees->m_nativeValue,
-            vSpotDistTorchingTrees->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vMapScale %g %s\n", Margin,
-            vMapScale->m_nativeValue,
-            vMapScale->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vSpotMapDistTorchingTrees %g %s\n", Margin,
-            vSpotMapDistTorchingTrees->m_nativeValue,
-            vSpotMapDistTorchingTrees->m_nativeUnits.latin1() );
+        dens[p] = vSurfaceFuelDens[p]->m_nativeValue;
+        heat[p] = vSurfaceFuelHeat[p]->m_nativeValue;
+        life[p] = vSurfaceFuelLife[p]->activeItemDataIndex();
+        load[p] = vSurfaceFuelLoad[p]->m_nativeValue;
+        savr[p] = vSurfaceFuelSavr[p]->m_nativeValue;
+        seff[p] = vSurfaceFuelSeff[p]->m_nativeValue;
+        stot[p] = vSurfaceFuelStot[p]->m_nativeValue;
+        mois[p] = vSurfaceFuelMois[p]->m_nativeValue;
     }
+    // Fuel load transfer as applied by FuelBedIntermediates()
+    int LiveHerb = 3;
+    int DeadHerb = 5;
+    load[LiveHerb] = vSurfaceFuelLoadUndeadHerb->m_nativeValue;
+    load[DeadHerb] = vSurfaceFuelLoadDeadHerb->m_nativeValue;
+    double depth    = vSurfaceFuelBedDepth->m_nativeValue;
+    double deadMext = vSurfaceFuelBedMextDead->m_nativeValue;
+
+    // Site, with the wind limit as applied by FireSpreadAtHead()
+    double slope     = vSiteSlopeFraction->m_nativeValue;
+    double aspect    = vSiteAspectDirFromNorth->m_nativeValue;
+    double windSpeed = vWindSpeedAtMidflame->m_nativeValue;
+    double windDir   = vWindDirFromUpslope->m_nativeValue;
+    PropertyDict *prop = m_eqTree->m_propDict;
+    bool applyWindLimit = prop->boolean( "surfaceConfWindLimitApplied" )
+                     && ! prop->boolean( "surfaceConfFuelAspen" );
+
+    // Set up the fire
+    fire->setFuel( depth, deadMext, MaxParts,
+        life, load, savr, heat, dens, stot, seff );
+    fire->setMoisture( mois );
+    fire->setSite( slope, aspect, 88.*windSpeed, windDir, applyWindLimit );
     return;
 }
 
@@ -6961,15 +6639,11 @@ void EqCalc::TimeJulianDate( void )
     // Store results
     vTimeJulianDate->update( mjd );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc TimeJulianDate() 1 1\n", Margin );
-        fprintf( m_log, "%s  i vTimeIntegerDate %g %s\n", Margin,
-            vTimeIntegerDate->m_nativeValue,
-            vTimeIntegerDate->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vTimeJulianDate %g %s\n", Margin,
-            vTimeJulianDate->m_nativeValue,
-            vTimeJulianDate->m_nativeUnits.latin1() );
+        m_trace->proc( "TimeJulianDate", 1, 1 );
+        m_trace->var( 'i', vTimeIntegerDate );
+        m_trace->var( 'o', vTimeJulianDate );
     }
     return;
 }
@@ -6995,18 +6669,12 @@ void EqCalc::TreeBarkThicknessBehave( void )
     // Store results
     vTreeBarkThickness->update( bt );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc TreeBarkThickness() 2 1\n", Margin );
-        fprintf( m_log, "%s  i vTreeDbh %g %s\n", Margin,
-            vTreeDbh->m_nativeValue,
-            vTreeDbh->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vTreeSpecies %d %s\n", Margin,
-            vTreeSpecies->activeItemDataIndex(),
-            vTreeSpecies->activeItemName().latin1() );
-        fprintf( m_log, "%s  o vTreeBarkThickness %g %s\n", Margin,
-            vTreeBarkThickness->m_nativeValue,
-            vTreeBarkThickness->m_nativeUnits.latin1() );
+        m_trace->proc( "TreeBarkThickness", 2, 1 );
+        m_trace->var( 'i', vTreeDbh );
+        m_trace->item( 'i', vTreeSpecies );
+        m_trace->var( 'o', vTreeBarkThickness );
     }
     return;
 }
@@ -7037,18 +6705,12 @@ void EqCalc::TreeBarkThicknessFofem( void )
     // Store results
     vTreeBarkThickness->update( bt );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc TreeBarkThickness() 2 1\n", Margin );
-        fprintf( m_log, "%s  i vTreeDbh %g %s\n", Margin,
-            vTreeDbh->m_nativeValue,
-            vTreeDbh->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vTreeSpecies %d %s\n", Margin,
-            vTreeSpecies->activeItemDataIndex(),
-            vTreeSpecies->activeItemName().latin1() );
-        fprintf( m_log, "%s  o vTreeBarkThickness %g %s\n", Margin,
-            vTreeBarkThickness->m_nativeValue,
-            vTreeBarkThickness->m_nativeUnits.latin1() );
+        m_trace->proc( "TreeBarkThickness", 2, 1 );
+        m_trace->var( 'i', vTreeDbh );
+        m_trace->item( 'i', vTreeSpecies );
+        m_trace->var( 'o', vTreeBarkThickness );
     }
     return;
 }
@@ -7066,7 +6728,7 @@ void EqCalc::TreeBarkThicknessFofem( void )
 void EqCalc::TreeBarkThicknessFofem6( void )
 {
     // Access current input values
-    const char* spp = vTreeSpecies->activeItemName().latin1();
+    int    spp = treeSpeciesFofem6();
     double dbh = vTreeDbh->m_nativeValue;
     // Calculate results
     // The mortality model always limits dbh lower bound to 1.0 inch.
@@ -7074,26 +6736,57 @@ void EqCalc::TreeBarkThicknessFofem6( void )
     {
         dbh = 1.0;
     }
-	double bt = Fofem6BarkThickness::barkThickness( spp, dbh );
+	int    eq = Fofem6Species::getBarkEquationIndexAt( spp );
+	double bt = ( eq < 0 ) ? 0. : Fofem6BarkThickness::barkThickness( eq, dbh );
     // Store results
     vTreeBarkThickness->update( bt );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc TreeBarkThickness() 2 1\n", Margin );
-        fprintf( m_log, "%s  i vTreeDbh %g %s\n", Margin,
-            vTreeDbh->m_nativeValue,
-            vTreeDbh->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vTreeSpecies %d %s\n", Margin,
-            vTreeSpecies->activeItemDataIndex(),
-            vTreeSpecies->activeItemName().latin1() );
-        fprintf( m_log, "%s  o vTreeBarkThickness %g %s\n", Margin,
-            vTreeBarkThickness->m_nativeValue,
-            vTreeBarkThickness->m_nativeUnits.latin1() );
+        m_trace->proc( "TreeBarkThickness", 2, 1 );
+        m_trace->var( 'i', vTreeDbh );
+        m_trace->item( 'i', vTreeSpecies );
+        m_trace->var( 'o', vTreeBarkThickness );
     }
     return;
 }
 
+//------------------------------------------------------------------------------
+/*! \brief Returns the Fofem6Species index of the current vTreeSpecies item.
+ *
+ *  Each item's species code is resolved only the first time the item is
+ *  used, so the tree functions never look up a species by its code.
+ *
+ *  \return Fofem6Species index, or -1 if the item is not a FOFEM v6 species.
+ */
+
+int EqCalc::treeSpeciesFofem6( void )
+{
+    int item = vTreeSpecies->activeItemDataIndex();
+    if ( item < 0 )
+    {
+        return( -1 );
+    }
+    int size = (int) m_treeSpeciesFofem6.size();
+    if ( item >= size )
+    {
+        m_treeSpeciesFofem6.resize( item + 1 );
+        for ( int i = size;
+              i <= item;
+              i++ )
+        {
+            m_treeSpeciesFofem6[i] = -2;
+        }
+    }
+    if ( m_treeSpeciesFofem6[item] == -2 )
+    {
+        QString spp = vTreeSpecies->activeItemName().upper();
+        m_treeSpeciesFofem6[item] =
+            Fofem6Species::getFofem6SpeciesIndex( spp.latin1() );
+    }
+    return( m_treeSpeciesFofem6[item] );
+}
+
 //------------------------------------------------------------------------------
 /*! \brief TreeCrownBaseHt
  *
@@ -7115,18 +6808,12 @@ void EqCalc::TreeCrownBaseHt( void )
     // Store results
     vTreeCrownBaseHt->update( bh );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc TreeCrownBaseHt() 2 1\n", Margin );
-        fprintf( m_log, "%s  i vTreeCrownRatio %g %s\n", Margin,
-            vTreeCrownRatio->m_nativeValue,
-            vTreeCrownRatio->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vTreeHt %g %s\n", Margin,
-            vTreeHt->m_nativeValue,
-            vTreeHt->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vTreeCrownBaseHt %g %s\n", Margin,
-            vTreeCrownBaseHt->m_nativeValue,
-            vTreeCrownBaseHt->m_nativeUnits.latin1() );
+        m_trace->proc( "TreeCrownBaseHt", 2, 1 );
+        m_trace->var( 'i', vTreeCrownRatio );
+        m_trace->var( 'i', vTreeHt );
+        m_trace->var( 'o', vTreeCrownBaseHt );
     }
     return;
 }
@@ -7152,18 +6839,12 @@ void EqCalc::TreeCrownRatio( void )
     // Store results
     vTreeCrownRatio->update( cr );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc TreeCrownRatio() 2 1\n", Margin );
-        fprintf( m_log, "%s  i vTreeCrownBaseHt %g %s\n", Margin,
-            vTreeCrownBaseHt->m_nativeValue,
-            vTreeCrownBaseHt->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vTreeCoverHt %g %s\n", Margin,
-            vTreeCoverHt->m_nativeValue,
-            vTreeCoverHt->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vTreeCrownRatio %g %s\n", Margin,
-            vTreeCrownRatio->m_nativeValue,
-            vTreeCrownRatio->m_nativeUnits.latin1() );
+        m_trace->proc( "TreeCrownRatio", 2, 1 );
+        m_trace->var( 'i', vTreeCrownBaseHt );
+        m_trace->var( 'i', vTreeCoverHt );
+        m_trace->var( 'o', vTreeCrownRatio );
     }
     return;
 }
@@ -7197,27 +6878,15 @@ void EqCalc::TreeCrownVolScorchedAtVector( void )
     vTreeCrownLengFractionScorchedAtVector->update( scorchFrac );
     vTreeCrownVolScorchedAtVector->update( scorchVol );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc TreeCrownVolScorchedAtVector() 3 3\n", Margin );
-        fprintf( m_log, "%s  i vSurfaceFireScorchHtAtVector %g %s\n", Margin,
-            vSurfaceFireScorchHtAtVector->m_nativeValue,
-            vSurfaceFireScorchHtAtVector->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vTreeCrownRatio %g %s\n", Margin,
-            vTreeCrownRatio->m_nativeValue,
-            vTreeCrownRatio->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vTreeCoverHt %g %s\n", Margin,
-            vTreeCoverHt->m_nativeValue,
-            vTreeCoverHt->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vTreeCrownVolScorchedAtVector %g %s\n", Margin,
-            vTreeCrownVolScorchedAtVector->m_nativeValue,
-            vTreeCrownVolScorchedAtVector->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vTreeCrownLengFractionScorchedAtVector %g %s\n", Margin,
-            vTreeCrownLengFractionScorchedAtVector->m_nativeValue,
-            vTreeCrownLengFractionScorchedAtVector->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vTreeCrownLengScorchedAtVector %g %s\n", Margin,
-            vTreeCrownLengScorchedAtVector->m_nativeValue,
-            vTreeCrownLengScorchedAtVector->m_nativeUnits.latin1() );
+        m_trace->proc( "TreeCrownVolScorchedAtVector", 3, 3 );
+        m_trace->var( 'i', vSurfaceFireScorchHtAtVector );
+        m_trace->var( 'i', vTreeCrownRatio );
+        m_trace->var( 'i', vTreeCoverHt );
+        m_trace->var( 'o', vTreeCrownVolScorchedAtVector );
+        m_trace->var( 'o', vTreeCrownLengFractionScorchedAtVector );
+        m_trace->var( 'o', vTreeCrownLengScorchedAtVector );
     }
     return;
 }
@@ -7243,18 +6912,12 @@ void EqCalc::TreeMortalityCountAtVector( void )
     // Store results
     vTreeMortalityCountAtVector->update( mc );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc TreeMortalityCountAtVector() 2 1\n", Margin );
-        fprintf( m_log, "%s  i vTreeMortalityRateAtVector %g %s\n", Margin,
-            vTreeMortalityRateAtVector->m_nativeValue,
-            vTreeMortalityRateAtVector->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vTreeCount %g %s\n", Margin,
-            vTreeCount->m_nativeValue,
-            vTreeCount->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vTreeMortalityCountAtVector %g %s\n", Margin,
-            vTreeMortalityCountAtVector->m_nativeValue,
-            vTreeMortalityCountAtVector->m_nativeUnits.latin1() );
+        m_trace->proc( "TreeMortalityCountAtVector", 2, 1 );
+        m_trace->var( 'i', vTreeMortalityRateAtVector );
+        m_trace->var( 'i', vTreeCount );
+        m_trace->var( 'o', vTreeMortalityCountAtVector );
     }
     return;
 }
@@ -7282,21 +6945,13 @@ void EqCalc::TreeMortalityRateAspenAtVector( void )
     // Store results
     vTreeMortalityRateAspenAtVector->update( mr );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc TreeMortalityRateAspenAtVector() 3 1\n", Margin );
-        fprintf( m_log, "%s  i vTreeDbh %g %s\n", Margin,
-            vTreeDbh->m_nativeValue,
-            vTreeDbh->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFireSeverityAspen %d %s\n", Margin,
-            vSurfaceFireSeverityAspen->activeItemDataIndex(),
-            vSurfaceFireSeverityAspen->activeItemName().latin1() );
-        fprintf( m_log, "%s  i vSurfaceFireFlameLengAtVector %g %s\n", Margin,
-            vSurfaceFireFlameLengAtVector->m_nativeValue,
-            vSurfaceFireFlameLengAtVector->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vTreeMortalityRateAspenAtVector %g %s\n", Margin,
-            vTreeMortalityRateAspenAtVector->m_nativeValue,
-            vTreeMortalityRateAspenAtVector->m_nativeUnits.latin1() );
+        m_trace->proc( "TreeMortalityRateAspenAtVector", 3, 1 );
+        m_trace->var( 'i', vTreeDbh );
+        m_trace->item( 'i', vSurfaceFireSeverityAspen );
+        m_trace->var( 'i', vSurfaceFireFlameLengAtVector );
+        m_trace->var( 'o', vTreeMortalityRateAspenAtVector );
     }
     return;
 }
@@ -7325,21 +6980,13 @@ void EqCalc::TreeMortalityRateBehaveAtVector( void )
     // Store results
     vTreeMortalityRateAtVector->update( mr );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc TreeMortalityRateBehaveAtVector() 3 1\n", Margin );
-        fprintf( m_log, "%s  i vTreeBarkThickness %g %s\n", Margin,
-            vTreeBarkThickness->m_nativeValue,
-            vTreeBarkThickness->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vTreeCrownVolScorchedAtVector %g %s\n", Margin,
-            vTreeCrownVolScorchedAtVector->m_nativeValue,
-            vTreeCrownVolScorchedAtVector->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFireScorchHtAtVector %g %s\n", Margin,
-            vSurfaceFireScorchHtAtVector->m_nativeValue,
-            vSurfaceFireScorchHtAtVector->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vTreeMortalityRateAtVector %g %s\n", Margin,
-            vTreeMortalityRateAtVector->m_nativeValue,
-            vTreeMortalityRateAtVector->m_nativeUnits.latin1() );
+        m_trace->proc( "TreeMortalityRateBehaveAtVector", 3, 1 );
+        m_trace->var( 'i', vTreeBarkThickness );
+        m_trace->var( 'i', vTreeCrownVolScorchedAtVector );
+        m_trace->var( 'i', vSurfaceFireScorchHtAtVector );
+        m_trace->var( 'o', vTreeMortalityRateAtVector );
     }
     return;
 }
@@ -7374,24 +7021,14 @@ void EqCalc::TreeMortalityRateFofemAtVector( void )
     // Store results
     vTreeMortalityRateAtVector->update( mr );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc TreeMortalityRateFofemAtVector() 4 1\n", Margin );
-        fprintf( m_log, "%s  i vTreeSpecies %d %s\n", Margin,
-            vTreeSpecies->activeItemDataIndex(),
-            vTreeSpecies->activeItemName().latin1() );
-        fprintf( m_log, "%s  i vTreeBarkThickness %g %s\n", Margin,
-            vTreeBarkThickness->m_nativeValue,
-            vTreeBarkThickness->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vTreeCrownVolScorchedAtVector %g %s\n", Margin,
-            vTreeCrownVolScorchedAtVector->m_nativeValue,
-            vTreeCrownVolScorchedAtVector->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFireScorchHtAtVector %g %s\n", Margin,
-            vSurfaceFireScorchHtAtVector->m_nativeValue,
-            vSurfaceFireScorchHtAtVector->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vTreeMortalityRateAtVector %g %s\n", Margin,
-            vTreeMortalityRateAtVector->m_nativeValue,
-            vTreeMortalityRateAtVector->m_nativeUnits.latin1() );
+        m_trace->proc( "TreeMortalityRateFofemAtVector", 4, 1 );
+        m_trace->item( 'i', vTreeSpecies );
+        m_trace->var( 'i', vTreeBarkThickness );
+        m_trace->var( 'i', vTreeCrownVolScorchedAtVector );
+        m_trace->var( 'i', vSurfaceFireScorchHtAtVector );
+        m_trace->var( 'o', vTreeMortalityRateAtVector );
     }
     return;
 }
@@ -7429,24 +7066,14 @@ void EqCalc::TreeMortalityRateFofem2AtVector( void )
     // Store results
     vTreeMortalityRateAtVector->update( mr );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc TreeMortalityRateFofem2AtVector() 4 1\n", Margin );
-        fprintf( m_log, "%s  i vTreeSpeciesMortality %d %s\n", Margin,
-            vTreeSpeciesMortality->activeItemDataIndex(),
-            vTreeSpeciesMortality->activeItemName().latin1() );
-        fprintf( m_log, "%s  i vTreeBarkThickness %g %s\n", Margin,
-            vTreeBarkThickness->m_nativeValue,
-            vTreeBarkThickness->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vTreeCrownVolScorchedAtVector %g %s\n", Margin,
-            vTreeCrownVolScorchedAtVector->m_nativeValue,
-            vTreeCrownVolScorchedAtVector->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFireScorchHtAtVector %g %s\n", Margin,
-            vSurfaceFireScorchHtAtVector->m_nativeValue,
-            vSurfaceFireScorchHtAtVector->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vTreeMortalityRateAtVector %g %s\n", Margin,
-            vTreeMortalityRateAtVector->m_nativeValue,
-            vTreeMortalityRateAtVector->m_nativeUnits.latin1() );
+        m_trace->proc( "TreeMortalityRateFofem2AtVector", 4, 1 );
+        m_trace->item( 'i', vTreeSpeciesMortality );
+        m_trace->var( 'i', vTreeBarkThickness );
+        m_trace->var( 'i', vTreeCrownVolScorchedAtVector );
+        m_trace->var( 'i', vSurfaceFireScorchHtAtVector );
+        m_trace->var( 'o', vTreeMortalityRateAtVector );
     }
     return;
 }
@@ -7469,42 +7096,30 @@ void EqCalc::TreeMortalityRateFofem2AtVector( void )
 void EqCalc::TreeMortalityRateFofem6AtVector( void )
 {
     // Access current input values
-    const char* spp = vTreeSpecies->activeItemName().latin1();
+    int    spp = treeSpeciesFofem6();
     double dbh = vTreeDbh->m_nativeValue;						/* inches */
 	double cls = vTreeCrownLengFractionScorchedAtVector->m_nativeValue;	/* fraction */
     double cvs = vTreeCrownVolScorchedAtVector->m_nativeValue;	/* fraction */
     double brk = vTreeBarkThickness->m_nativeValue;				/* inches */
     double sht = vSurfaceFireScorchHtAtVector->m_nativeValue;	/* ft */
 
-	double mr = Fofem6Mortality::mortalityRate( spp, dbh, brk, sht, cls, cvs );
+	int    eq = Fofem6Species::getMortalityEquationIndexAt( spp );
+	double mr = ( eq < 0 ) ? 0.
+              : Fofem6Mortality::mortalityRate( eq, dbh, brk, sht, cls, cvs );
 
     // Store results
     vTreeMortalityRateAtVector->update( mr );
     // Log results
-    if( m_log )
-    {
-        fprintf( m_log, "%sbegin proc TreeMortalityRateFofem6AtVector() 6 1\n", Margin );
-        fprintf( m_log, "%s  i vTreeSpecies %d %s\n", Margin,
-            vTreeSpecies->activeItemDataIndex(),
-            vTreeSpecies->activeItemName().latin1() );
-        fprintf( m_log, "%s  i vTreeDbh %g %s\n", Margin,
-            vTreeDbh->m_nativeValue,
-            vTreeDbh->m_nativeUnits.latin1() );
-		fprintf( m_log, "%s  i vTreeBarkThickness %g %s\n", Margin,
-            vTreeBarkThickness->m_nativeValue,
-            vTreeBarkThickness->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vTreeCrownVolScorchedAtVector %g %s\n", Margin,
-            vTreeCrownVolScorchedAtVector->m_nativeValue,
-            vTreeCrownVolScorchedAtVector->m_nativeUnits.latin1() );
-		fprintf( m_log, "%s  i vTreeCrownLengFractionScorchedAtVector %g %s\n", Margin,
-            vTreeCrownLengFractionScorchedAtVector->m_nativeValue,
-            vTreeCrownLengFractionScorchedAtVector->m_nativeUnits.latin1() );
- 		fprintf( m_log, "%s  i vSurfaceFireScorchHtAtVector %g %s\n", Margin,
-            vSurfaceFireScorchHtAtVector->m_nativeValue,
-            vSurfaceFireScorchHtAtVector->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vTreeMortalityRateAtVector %g %s\n", Margin,
-            vTreeMortalityRateAtVector->m_nativeValue,
-            vTreeMortalityRateAtVector->m_nativeUnits.latin1() );
+    if( EQTRACE_ON( m_trace ) )
+    {
+        m_trace->proc( "TreeMortalityRateFofem6AtVector", 6, 1 );
+        m_trace->item( 'i', vTreeSpecies );
+        m_trace->var( 'i', vTreeDbh );
+		m_trace->var( 'i', vTreeBarkThickness );
+        m_trace->var( 'i', vTreeCrownVolScorchedAtVector );
+		m_trace->var( 'i', vTreeCrownLengFractionScorchedAtVector );
+ 		m_trace->var( 'i', vSurfaceFireScorchHtAtVector );
+        m_trace->var( 'o', vTreeMortalityRateAtVector );
     }
     return;
 }
@@ -7561,30 +7176,16 @@ void EqCalc::TreeMortalityRateFofemHoodAtVector( void )
     // Store results
     vTreeMortalityRateAtVector->update( mr );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc TreeMortalityRateFofemHoodAtVector() 6 1\n", Margin );
-        fprintf( m_log, "%s  i vTreeSpecies %d %s\n", Margin,
-            vTreeSpecies->activeItemDataIndex(),
-            vTreeSpecies->activeItemName().latin1() );
-        fprintf( m_log, "%s  i vTreeDbh %g %s\n", Margin,
-            vTreeDbh->m_nativeValue,
-            vTreeDbh->m_nativeUnits.latin1() );
-		fprintf( m_log, "%s  i vTreeBarkThickness %g %s\n", Margin,
-            vTreeBarkThickness->m_nativeValue,
-            vTreeBarkThickness->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vTreeCrownVolScorchedAtVector %g %s\n", Margin,
-            vTreeCrownVolScorchedAtVector->m_nativeValue,
-            vTreeCrownVolScorchedAtVector->m_nativeUnits.latin1() );
-		fprintf( m_log, "%s  i vTreeCrownLengFractionScorchedAtVector %g %s\n", Margin,
-            vTreeCrownLengFractionScorchedAtVector->m_nativeValue,
-            vTreeCrownLengFractionScorchedAtVector->m_nativeUnits.latin1() );
- 		fprintf( m_log, "%s  i vSurfaceFireScorchHtAtVector %g %s\n", Margin,
-            vSurfaceFireScorchHtAtVector->m_nativeValue,
-            vSurfaceFireScorchHtAtVector->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vTreeMortalityRateAtVector %g %s\n", Margin,
-            vTreeMortalityRateAtVector->m_nativeValue,
-            vTreeMortalityRateAtVector->m_nativeUnits.latin1() );
+        m_trace->proc( "TreeMortalityRateFofemHoodAtVector", 6, 1 );
+        m_trace->item( 'i', vTreeSpecies );
+        m_trace->var( 'i', vTreeDbh );
+		m_trace->var( 'i', vTreeBarkThickness );
+        m_trace->var( 'i', vTreeCrownVolScorchedAtVector );
+		m_trace->var( 'i', vTreeCrownLengFractionScorchedAtVector );
+ 		m_trace->var( 'i', vSurfaceFireScorchHtAtVector );
+        m_trace->var( 'o', vTreeMortalityRateAtVector );
     }
     return;
 }
@@ -7620,30 +7221,16 @@ void EqCalc::WindAdjFactor( void )
     vWindAdjMethod->updateItem( method );
     vTreeCanopyCrownFraction->update( fraction );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc WindAdjFactor() 4 1\n", Margin );
-        fprintf( m_log, "%s  i vTreeCanopyCover %d %s\n", Margin,
-            vTreeCanopyCover->activeItemDataIndex(),
-            vTreeCanopyCover->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vTreeCoverHt %d %s\n", Margin,
-            vTreeCoverHt->activeItemDataIndex(),
-            vTreeCoverHt->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vTreeCrownRatio %d %s\n", Margin,
-            vTreeCrownRatio->activeItemDataIndex(),
-            vTreeCrownRatio->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSurfaceFuelBedDepth %d %s\n", Margin,
-            vSurfaceFuelBedDepth->activeItemDataIndex(),
-            vSurfaceFuelBedDepth->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vWindAdjFactor %d %s\n", Margin,
-            vWindAdjFactor->activeItemDataIndex(),
-            vWindAdjFactor->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vWindAdjMethod %d %s\n", Margin,
-            vWindAdjMethod->activeItemDataIndex(),
-            vWindAdjMethod->activeItemName().latin1() );
-        fprintf( m_log, "%s  o vTreeCanopyCrownFraction %d %s\n", Margin,
-            vTreeCanopyCrownFraction->activeItemDataIndex(),
-            vTreeCanopyCrownFraction->m_nativeUnits.latin1() );
+        m_trace->proc( "WindAdjFactor", 4, 1 );
+        m_trace->itemUnits( 'i', vTreeCanopyCover );
+        m_trace->itemUnits( 'i', vTreeCoverHt );
+        m_trace->itemUnits( 'i', vTreeCrownRatio );
+        m_trace->itemUnits( 'i', vSurfaceFuelBedDepth );
+        m_trace->itemUnits( 'o', vWindAdjFactor );
+        m_trace->item( 'o', vWindAdjMethod );
+        m_trace->itemUnits( 'o', vTreeCanopyCrownFraction );
     }
     return;
 }
@@ -7667,15 +7254,11 @@ void EqCalc::WindDirFromNorth( void )
     // Store results
     vWindDirFromNorth->update( dd );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc WindDirFromNorth() 1 1\n", Margin );
-        fprintf( m_log, "%s  i vWindDirFromCompass %d %s\n", Margin,
-            vWindDirFromCompass->activeItemDataIndex(),
-            vWindDirFromCompass->activeItemName().latin1() );
-        fprintf( m_log, "%s  o vWindDirFromNorth %g %s\n", Margin,
-            vWindDirFromNorth->m_nativeValue,
-            vWindDirFromNorth->m_nativeUnits.latin1() );
+        m_trace->proc( "WindDirFromNorth", 1, 1 );
+        m_trace->item( 'i', vWindDirFromCompass );
+        m_trace->var( 'o', vWindDirFromNorth );
     }
     return;
 }
@@ -7715,18 +7298,12 @@ void EqCalc::WindDirFromUpslope( void )
     // Store results
     vWindDirFromUpslope->update( dd );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc WindDirFromUpslope() 2 1\n", Margin );
-        fprintf( m_log, "%s  i vSiteUpslopeDirFromNorth %g %s\n", Margin,
-            vSiteUpslopeDirFromNorth->m_nativeValue,
-            vSiteUpslopeDirFromNorth->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vWindDirFromNorth %g %s\n", Margin,
-            vWindDirFromNorth->m_nativeValue,
-            vWindDirFromNorth->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vWindDirFromUpslope %g %s\n", Margin,
-            vWindDirFromUpslope->m_nativeValue,
-            vWindDirFromUpslope->m_nativeUnits.latin1() );
+        m_trace->proc( "WindDirFromUpslope", 2, 1 );
+        m_trace->var( 'i', vSiteUpslopeDirFromNorth );
+        m_trace->var( 'i', vWindDirFromNorth );
+        m_trace->var( 'o', vWindDirFromUpslope );
     }
     return;
 }
@@ -7750,15 +7327,11 @@ void EqCalc::WindSpeedAt20Ft ( void )
     // Store results
     vWindSpeedAt20Ft->update( w20ft );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc WindSpeedAt20Ft() 1 1\n", Margin );
-        fprintf( m_log, "%s  i vWindSpeedAt10M %g %s\n", Margin,
-            vWindSpeedAt10M->m_nativeValue,
-            vWindSpeedAt10M->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vWindSpeedAt20Ft %g %s\n", Margin,
-            vWindSpeedAt20Ft->m_nativeValue,
-            vWindSpeedAt20Ft->m_nativeUnits.latin1() );
+        m_trace->proc( "WindSpeedAt20Ft", 1, 1 );
+        m_trace->var( 'i', vWindSpeedAt10M );
+        m_trace->var( 'o', vWindSpeedAt20Ft );
     }
     return;
 }
@@ -7784,18 +7357,12 @@ void EqCalc::WindSpeedAtMidflame ( void )
     // Store results
     vWindSpeedAtMidflame->update( wm );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc WindSpeedAtMidflame() 2 1\n", Margin );
-        fprintf( m_log, "%s  i vWindSpeedAt20Ft %g %s\n", Margin,
-            vWindSpeedAt20Ft->m_nativeValue,
-            vWindSpeedAt20Ft->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vWindAdjFactor %g %s\n", Margin,
-            vWindAdjFactor->m_nativeValue,
-            vWindAdjFactor->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vWindSpeedAtMidflame %g %s\n", Margin,
-            vWindSpeedAtMidflame->m_nativeValue,
-            vWindSpeedAtMidflame->m_nativeUnits.latin1() );
+        m_trace->proc( "WindSpeedAtMidflame", 2, 1 );
+        m_trace->var( 'i', vWindSpeedAt20Ft );
+        m_trace->var( 'i', vWindAdjFactor );
+        m_trace->var( 'o', vWindSpeedAtMidflame );
     }
     return;
 }
@@ -7826,18 +7393,12 @@ void EqCalc::WthrCumulusBaseHt( void )
     // Store results
     vWthrCumulusBaseHt->update( ht );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc WthrCumulusBaseHt() 2 1\n", Margin );
-        fprintf( m_log, "%s  i vWthrAirTemp %g %s\n", Margin,
-            vWthrAirTemp->m_nativeValue,
-            vWthrAirTemp->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vWthrDewPointTemp %g %s\n", Margin,
-            vWthrDewPointTemp->m_nativeValue,
-            vWthrDewPointTemp->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vWthrCumulusBaseHt %g %s\n", Margin,
-            vWthrCumulusBaseHt->m_nativeValue,
-            vWthrCumulusBaseHt->m_nativeUnits.latin1() );
+        m_trace->proc( "WthrCumulusBaseHt", 2, 1 );
+        m_trace->var( 'i', vWthrAirTemp );
+        m_trace->var( 'i', vWthrDewPointTemp );
+        m_trace->var( 'o', vWthrCumulusBaseHt );
     }
     return;
 }
@@ -7865,21 +7426,13 @@ void EqCalc::WthrDewPointTemp( void )
     // Store results
     vWthrDewPointTemp->update( dewpoint );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc WthrDewPointTemp() 3 1\n", Margin );
-        fprintf( m_log, "%s  i vWthrAirTemp %g %s\n", Margin,
-            vWthrAirTemp->m_nativeValue,
-            vWthrAirTemp->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vWthrWetBulbTemp %g %s\n", Margin,
-            vWthrWetBulbTemp->m_nativeValue,
-            vWthrWetBulbTemp->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vSiteElevation %g %s\n", Margin,
-            vSiteElevation->m_nativeValue,
-            vSiteElevation->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vWthrDewPointTemp %g %s\n", Margin,
-            vWthrDewPointTemp->m_nativeValue,
-            vWthrDewPointTemp->m_nativeUnits.latin1() );
+        m_trace->proc( "WthrDewPointTemp", 3, 1 );
+        m_trace->var( 'i', vWthrAirTemp );
+        m_trace->var( 'i', vWthrWetBulbTemp );
+        m_trace->var( 'i', vSiteElevation );
+        m_trace->var( 'o', vWthrDewPointTemp );
     }
     return;
 }
@@ -7906,18 +7459,12 @@ void EqCalc::WthrHeatIndex( void )
     // Store results
     vWthrHeatIndex->update( hi );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc WthrHeatIndex() 2 1\n", Margin );
-        fprintf( m_log, "%s  i vWthrAirTemp %g %s\n", Margin,
-            vWthrAirTemp->m_nativeValue,
-            vWthrAirTemp->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vWthrRelativeHumidity %g %s\n", Margin,
-            vWthrRelativeHumidity->m_nativeValue,
-            vWthrRelativeHumidity->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vWthrHeatIndex %g %s\n", Margin,
-            vWthrHeatIndex->m_nativeValue,
-            vWthrHeatIndex->m_nativeUnits.latin1() );
+        m_trace->proc( "WthrHeatIndex", 2, 1 );
+        m_trace->var( 'i', vWthrAirTemp );
+        m_trace->var( 'i', vWthrRelativeHumidity );
+        m_trace->var( 'o', vWthrHeatIndex );
     }
     return;
 }
@@ -7943,18 +7490,12 @@ void EqCalc::WthrRelativeHumidity( void )
     // Store results
     vWthrRelativeHumidity->update( rh );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc WthrRelativeHumidity() 2 1\n", Margin );
-        fprintf( m_log, "%s  i vWthrAirTemp %g %s\n", Margin,
-            vWthrAirTemp->m_nativeValue,
-            vWthrAirTemp->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vWthrDewPointTemp %g %s\n", Margin,
-            vWthrDewPointTemp->m_nativeValue,
-            vWthrDewPointTemp->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vWthrRelativeHumidity %g %s\n", Margin,
-            vWthrRelativeHumidity->m_nativeValue,
-            vWthrRelativeHumidity->m_nativeUnits.latin1() );
+        m_trace->proc( "WthrRelativeHumidity", 2, 1 );
+        m_trace->var( 'i', vWthrAirTemp );
+        m_trace->var( 'i', vWthrDewPointTemp );
+        m_trace->var( 'o', vWthrRelativeHumidity );
     }
     return;
 }
@@ -7981,18 +7522,12 @@ void EqCalc::WthrSummerSimmerIndex( void )
     // Store results
     vWthrSummerSimmerIndex->update( ssi );
     // Log results
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "%sbegin proc WthrSummerSimmerIndex() 2 1\n", Margin );
-        fprintf( m_log, "%s  i vWthrAirTemp %g %s\n", Margin,
-            vWthrAirTemp->m_nativeValue,
-            vWthrAirTemp->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vWthrRelativeHumidity %g %s\n", Margin,
-            vWthrRelativeHumidity->m_nativeValue,
-            vWthrRelativeHumidity->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vWthrSummerSimmerIndex %g %s\n", Margin,
-            vWthrSummerSimmerIndex->m_nativeValue,
-            vWthrSummerSimmerIndex->m_nativeUnits.latin1() );
+        m_trace->proc( "WthrSummerSimmerIndex", 2, 1 );
+        m_trace->var( 'i', vWthrAirTemp );
+        m_trace->var( 'i', vWthrRelativeHumidity );
+        m_trace->var( 'o', vWthrSummerSimmerIndex );
     }
     return;
 }
@@ -8018,18 +7553,12 @@ void EqCalc::WthrWindChillTemp( void )
     // Store results
     vWthrWindChillTemp->update( wc );
     // Log results
-    if( m_log )
-    {
-        fprintf( m_log, "%sbegin proc WthrWindChill() 2 1\n", Margin );
-        fprintf( m_log, "%s  i vWthrAirTemp %g %s\n", Margin,
-            vWthrAirTemp->m_nativeValue,
-            vWthrAirTemp->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  i vWindSpeedAtMidflame %g %s\n", Margin,
-            vWindSpeedAtMidflame->m_nativeValue,
-            vWindSpeedAtMidflame->m_nativeUnits.latin1() );
-        fprintf( m_log, "%s  o vWthrWindChillTemp %g %s\n", Margin,
-            vWthrWindChillTemp->m_nativeValue,
-            vWthrWindChillTemp->m_nativeUnits.latin1() );
+    if( EQTRACE_ON( m_trace ) )
+    {
+        m_trace->proc( "WthrWindChill", 2, 1 );
+        m_trace->var( 'i', vWthrAirTemp );
+        m_trace->var( 'i', vWindSpeedAtMidflame );
+        m_trace->var( 'o', vWthrWindChillTemp );
     }
     return;
 }
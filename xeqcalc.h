@@ -14,10 +14,14 @@
 #include "Bp6Globals.h"
 
 // Custom class references
+class Bp6Dual;
 class BpDocument;
 class EqFun;
+class EqTrace;
 class EqTree;
 class EqVar;
+class FuelBedWeightedFire;
+class FuelBedWeightedInput;
 class FuelModel;
 class PropertyDict;
 
@@ -25,6 +29,7 @@ class PropertyDict;
 #include "Bp6CrownFire.h"
 
 // Qt include files
+#include <qmemarray.h>
 #include <qstring.h>
 
 // Standard include files
@@ -83,7 +88,7 @@ public:
 // Public data
 public:
     EqTree *m_eqTree;   //!< Pointer to the parent EqTree
-    FILE   *m_log;      //!< Log file stream pointer
+    EqTrace *m_trace;   //!< Run trace, or NULL if not tracing
 
 // Declare all EqVar pointers here.
     EqVar *vContainAttackBack;
@@ -711,6 +716,13 @@ public:
     void FuelBedModel( void );
     void FuelBedParms( void );
     void FuelBedWeighted( void );
+    void FuelBedWeightedBed( FuelModel *fm, Bp6SurfaceFire *bp6,
+            const FuelBedWeightedInput *in, const FuelBedWeightedFire *prev,
+            FuelBedWeightedFire *fire );
+    void FuelBedWeightedStore( FuelModel *fm, const FuelBedWeightedInput *in,
+            const FuelBedWeightedFire *fire );
+    void FuelBedWeightedTrace( const FuelBedWeightedInput *in,
+            const FuelBedWeightedFire *prev, const FuelBedWeightedFire *fire );
     void FuelChaparralAgeFromDepthType( void );
     void FuelChaparralDeadFuelFractionFromAge( void );
     void FuelChaparralDepthFromAge( void );
@@ -733,6 +745,11 @@ public:
     void MapSlope( void );
     void SafetyZoneRadius( void );
     void SafetyZoneSepDist( void );
+    void SensitivityFire( Bp6SurfaceFireT<Bp6Dual> *fire,
+            Bp6CrownFireT<Bp6Dual> *crown, const Bp6Dual *x );
+    bool SensitivityFireOutput( EqVar *var, Bp6SurfaceFireT<Bp6Dual> *fire,
+            Bp6CrownFireT<Bp6Dual> *crown, Bp6Dual *value );
+    int  SensitivityFireVars( EqVar **var );
     void SiteAspectDirFromNorth( void );
     void SiteRidgeToValleyDist( void );
     void SiteSlopeFraction( void );
@@ -745,6 +762,7 @@ public:
     void SpotMapDistBurningPile( void );
     void SpotMapDistSurfaceFire( void );
     void SpotMapDistTorchingTrees( void );
+    void SpreadProfileFire( Bp6SurfaceFire *fire );
     void TimeJulianDate( void );
     void TreeBarkThicknessBehave( void ) ;          //!< Depricated, historical
     void TreeBarkThicknessFofem( void );			//!> Deprecated, historical
@@ -819,12 +837,17 @@ public:
 	void logOutputItem( EqVar *var );
 	double fetch( EqVar *var );
 	void store( EqVar *var, double value );
+	int  treeSpeciesFofem6( void );
 
 	Bp6CrownFire*   m_Bp6CrownFire;
 	Bp6SurfaceFire* m_Bp6SurfaceFire;
+	//! Primary fuel model of two fuel model runs (the secondary uses m_Bp6SurfaceFire)
+	Bp6SurfaceFire* m_Bp6SurfaceFire1;
 	double m_canopyRbQig;
 	double m_canopyRxInt;
 	double m_canopySlopeFactor;
+	//! Fofem6Species index of each vTreeSpecies item (-2 if not yet resolved)
+	QMemArray<int> m_treeSpeciesFofem6;
 };
 
 #endif
@@ -42,6 +42,7 @@
 #include "property.h"
 #include "xeqcalc.h"
 #include "xeqvar.h"
+#include "xeqtrace.h"
 #include "xeqtree.h"
 #include "xfblib.h"
 
@@ -63,9 +64,10 @@
 
 EqCalc::EqCalc( EqTree *eqTree ) :
     m_eqTree(eqTree),
-    m_log(0)
+    m_trace(0)
 {
 	m_Bp6SurfaceFire		= new Bp6SurfaceFire();
+	m_Bp6SurfaceFire1		= new Bp6SurfaceFire();
 	m_Bp6CrownFire			= new Bp6CrownFire();
 
     vContainAttackBack       = m_eqTree->getVarPtr( "vContainAttackBack" );
@@ -712,43 +714,33 @@ bool EqCalc::closeEnough( const char* what, double v5, double v6, double delta )
 
 void EqCalc::logMethod( char* methodName, int numInputs, int numOutputs )
 {
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "        begin proc %s() %d %d\n",
-			methodName, numInputs, numOutputs );
+        m_trace->proc( methodName, numInputs, numOutputs );
 	}
 }
 
 void EqCalc::logInput( EqVar *var )
 {
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "          i %s %g %s\n",
-			var->m_name,
-			var->m_nativeValue,
-			var->m_nativeUnits.latin1() );
+        m_trace->var( 'i', var );
 	}
 }
 
 void EqCalc::logOutput( EqVar *var )
 {
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "          o %s %g %s\n",
-			var->m_name,
-			var->m_nativeValue,
-			var->m_nativeUnits.latin1() );
+        m_trace->var( 'o', var );
 	}
 }
 
 void EqCalc::logOutputItem( EqVar *var )
 {
-    if( m_log )
+    if( EQTRACE_ON( m_trace ) )
     {
-        fprintf( m_log, "          o %s %d %s\n",
-			var->m_name,
-			var->m_nativeValue,
-			var->m_nativeUnits.latin1() );
+        m_trace->itemUnits( 'o', var );
 	}
 }
 
@@ -0,0 +1,895 @@
+//------------------------------------------------------------------------------
+/*! \file xeqdiskcache.cpp
+ *  \version BehavePlus6
+ *  \author Copyright (C) 2002-2018 by Collin D. Bevins.  All rights reserved.
+ *
+ *  \brief EqTree persistent table cell result cache class methods.
+ */
+
+// Custom include files
+#include "appmessage.h"
+#include "fuelmodel.h"
+#include "moisscenario.h"
+#include "property.h"
+#include "rxvar.h"
+#include "xeqdiskcache.h"
+#include "xeqtree.h"
+#include "xeqvar.h"
+
+// Standard include files
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+//------------------------------------------------------------------------------
+/*! \brief Cache file magic string (including its terminating NUL).
+ */
+
+static const char EqDiskCache_Magic[8] = "BPCACHE";
+
+//------------------------------------------------------------------------------
+/*! \brief Cache file format version.
+ */
+
+static const int EqDiskCache_Version = 2;
+
+//------------------------------------------------------------------------------
+/*! \brief Largest configuration or cell input key accepted from a cache file.
+ */
+
+static const int EqDiskCache_MaxBytes = 0x1000000;
+
+//------------------------------------------------------------------------------
+/*! \brief Grows a byte array to hold at least \a need bytes, keeping its
+ *  first \a used bytes.
+ *
+ *  \param buf      Current array (may be NULL).
+ *  \param used     Number of bytes in use.
+ *  \param size     Current capacity, updated on return.
+ *  \param need     Number of bytes required.
+ *  \param name     Array name for checkmem().
+ *
+ *  \return Address of the (possibly new) array.
+ */
+
+static char *EqDiskCache_Grow( char *buf, int used, int *size, int need,
+        const char *name )
+{
+    if ( need <= *size )
+    {
+        return( buf );
+    }
+    int newSize = ( *size < 8192 ) ? 8192 : 2 * *size;
+    while ( need > newSize )
+    {
+        newSize *= 2;
+    }
+    char *newBuf = new char[ newSize ];
+    checkmem( __FILE__, __LINE__, newBuf, name, newSize );
+    if ( used )
+    {
+        memcpy( newBuf, buf, used );
+    }
+    delete[] buf;
+    *size = newSize;
+    return( newBuf );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Continues a 64-bit FNV-1a hash over a block of bytes.
+ *
+ *  \param h        Hash so far (start with EqDiskCache_Seed()).
+ *  \param data     Address of the bytes.
+ *  \param bytes    Number of bytes.
+ *
+ *  \return Updated hash.
+ */
+
+static Q_ULLONG EqDiskCache_Hash( Q_ULLONG h, const void *data, int bytes )
+{
+    static const Q_ULLONG prime = ( (Q_ULLONG) 0x100 << 32 ) | 0x1b3;
+    const unsigned char *b = (const unsigned char *) data;
+    for ( int i = 0;
+          i < bytes;
+          i++ )
+    {
+        h = ( h ^ b[i] ) * prime;
+    }
+    return( h );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Returns the 64-bit FNV-1a offset basis.
+ */
+
+static Q_ULLONG EqDiskCache_Seed( void )
+{
+    return( ( (Q_ULLONG) 0xcbf29ce4 << 32 ) | 0x84222325 );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief qsort() comparison function used to sort entries into most
+ *  recently used order.  Called only by qsort() on behalf of
+ *  EqDiskCache::save().
+ *
+ *  \return  -1, 0, or 1 as required by qsort().
+ */
+
+int EqDiskCache_UsedCompare( const void *e1, const void *e2 )
+{
+    unsigned int u1 = ( (const EqDiskCacheEntry *) e1 )->m_used;
+    unsigned int u2 = ( (const EqDiskCacheEntry *) e2 )->m_used;
+    return( ( u1 > u2 ) ? -1 : ( ( u1 < u2 ) ? 1 : 0 ) );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief EqDiskCache default constructor.
+ */
+
+EqDiskCache::EqDiskCache( void ) :
+    m_fileName(""),
+    m_maxEntries(100000),
+    m_release(0),
+    m_loaded(false),
+    m_dirty(false),
+    m_eqTree(0),
+    m_outVars(0),
+    m_config(0),
+    m_configId(-1),
+    m_key(0),
+    m_bufBytes(0),
+    m_bufSize(0),
+    m_buf(0),
+    m_configs(0),
+    m_configCapacity(0),
+    m_configList(0),
+    m_byteCount(0),
+    m_byteSize(0),
+    m_bytes(0),
+    m_clock(0),
+    m_entries(0),
+    m_capacity(0),
+    m_entry(0),
+    m_values(0),
+    m_poolSize(0),
+    m_pool(0),
+    m_slots(0),
+    m_slot(0),
+    m_hits(0),
+    m_misses(0),
+    m_evicted(0)
+{
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief EqDiskCache destructor.
+ */
+
+EqDiskCache::~EqDiskCache( void )
+{
+    clear();
+    delete[] m_buf;     m_buf = 0;
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Adds a configuration to the cache, unless it is already cached.
+ *
+ *  \param data     Address of the configuration's canonical bytes.
+ *  \param bytes    Number of configuration bytes.
+ *
+ *  \return Index of the configuration.
+ */
+
+int EqDiskCache::addConfig( const char *data, int bytes )
+{
+    Q_ULLONG h = EqDiskCache_Hash( EqDiskCache_Seed(), data, bytes );
+    int id;
+    for ( id = 0;
+          id < m_configs;
+          id++ )
+    {
+        if ( m_configList[id].m_hash == h
+          && m_configList[id].m_bytes == bytes
+          && memcmp( m_bytes + m_configList[id].m_offset, data, bytes ) == 0 )
+        {
+            return( id );
+        }
+    }
+    // Grow the configuration array
+    if ( m_configs == m_configCapacity )
+    {
+        int capacity = ( m_configCapacity < 16 ) ? 16 : 2 * m_configCapacity;
+        EqDiskCacheConfig *config = new EqDiskCacheConfig[ capacity ];
+        checkmem( __FILE__, __LINE__, config, "EqDiskCacheConfig m_configList",
+            capacity );
+        if ( m_configs )
+        {
+            memcpy( config, m_configList, m_configs * sizeof(EqDiskCacheConfig) );
+        }
+        delete[] m_configList;
+        m_configList = config;
+        m_configCapacity = capacity;
+    }
+    m_bytes = EqDiskCache_Grow( m_bytes, m_byteCount, &m_byteSize,
+        m_byteCount + bytes, "char m_bytes" );
+    memcpy( m_bytes + m_byteCount, data, bytes );
+    EqDiskCacheConfig *c = &m_configList[m_configs];
+    c->m_hash   = h;
+    c->m_offset = m_byteCount;
+    c->m_bytes  = bytes;
+    m_byteCount += bytes;
+    return( m_configs++ );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Appends a block of bytes to the current key in m_buf[].
+ *
+ *  \param data     Address of the bytes.
+ *  \param bytes    Number of bytes.
+ */
+
+void EqDiskCache::append( const void *data, int bytes )
+{
+    m_buf = EqDiskCache_Grow( m_buf, m_bufBytes, &m_bufSize,
+        m_bufBytes + bytes, "char m_buf" );
+    memcpy( m_buf + m_bufBytes, data, bytes );
+    m_bufBytes += bytes;
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Appends a string and its terminator to the current key in m_buf[].
+ *
+ *  \param str  String.
+ */
+
+void EqDiskCache::appendStr( const QString &str )
+{
+    const char *s = str.latin1();
+    append( s ? s : "", s ? strlen( s ) + 1 : 1 );
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Prepares the cache for a table run.
+ *
+ *  Loads the cache file (if it hasn't been loaded) and finds or adds the
+ *  configuration: everything other than the input values that determines
+ *  the run's results.
+ *
+ *  \param eqTree   Pointer to the EqTree being run.
+ *  \param outVar   Array of the run's output variables.
+ *  \param outVars  Number of output variables.
+ *
+ *  \return TRUE if the cache is active and may be used for this run.
+ */
+
+bool EqDiskCache::begin( EqTree *eqTree, EqVar **outVar, int outVars )
+{
+    m_hits = m_misses = 0;
+    m_eqTree = eqTree;
+    m_outVars = outVars;
+    if ( m_fileName.isEmpty() || outVars < 1 )
+    {
+        return( false );
+    }
+    if ( ! m_loaded )
+    {
+        load();
+        m_loaded = true;
+    }
+    // Release
+    m_bufBytes = 0;
+    append( &m_release, sizeof(m_release) );
+
+    // Calculation properties, in name order
+    QStringList names;
+    QDictIterator<Property> it( *eqTree->m_propDict );
+    while( it.current() )
+    {
+        QString name = it.currentKey();
+        if ( name.contains( "Conf" )
+          || name.contains( "Calc" )
+          || name.endsWith( "ModuleActive" ) )
+        {
+            names.append( name );
+        }
+        ++it;
+    }
+    names.sort();
+    for ( QStringList::Iterator nit = names.begin();
+          nit != names.end();
+          ++nit )
+    {
+        appendStr( *nit );
+        appendStr( eqTree->m_propDict->value( *nit ) );
+    }
+    // Fuel model and moisture scenario definitions
+    FuelModel *fm;
+    for ( fm = eqTree->m_fuelModelList->first();
+          fm;
+          fm = eqTree->m_fuelModelList->next() )
+    {
+        double parm[13] = { fm->m_depth, fm->m_mext, fm->m_heatDead,
+            fm->m_heatLive, fm->m_load1, fm->m_load10, fm->m_load100,
+            fm->m_loadHerb, fm->m_loadWood, fm->m_savr1, fm->m_savrHerb,
+            fm->m_savrWood, (double) fm->m_number };
+        appendStr( fm->m_name );
+        appendStr( fm->m_transfer );
+        append( parm, sizeof(parm) );
+    }
+    MoisScenario *ms;
+    for ( ms = eqTree->m_moisScenarioList->first();
+          ms;
+          ms = eqTree->m_moisScenarioList->next() )
+    {
+        double mois[6] = { ms->m_moisDead1, ms->m_moisDead10,
+            ms->m_moisDead100, ms->m_moisDead1000, ms->m_moisLiveHerb,
+            ms->m_moisLiveWood };
+        appendStr( ms->m_name );
+        append( mois, sizeof(mois) );
+    }
+    // Prescription, which determines each cell's inRx flag
+    appendStr( eqTree->m_propDict->value( "docRxActive" ) );
+    RxVar *rxVar;
+    for ( rxVar = eqTree->m_rxVarList->first();
+          rxVar;
+          rxVar = eqTree->m_rxVarList->next() )
+    {
+        if ( rxVar->m_isActive )
+        {
+            appendStr( rxVar->m_varPtr->m_name );
+            if ( rxVar->isContinuous() )
+            {
+                append( &rxVar->m_nativeMinimum,
+                    sizeof(rxVar->m_nativeMinimum) );
+                append( &rxVar->m_nativeMaximum,
+                    sizeof(rxVar->m_nativeMaximum) );
+            }
+            else
+            {
+                append( rxVar->m_itemChecked, sizeof(rxVar->m_itemChecked) );
+            }
+        }
+    }
+    // Input and output variables and units
+    int i;
+    for ( i = 0;
+          i < eqTree->m_leafCount;
+          i++ )
+    {
+        appendStr( eqTree->m_leaf[i]->m_name );
+    }
+    for ( i = 0;
+          i < outVars;
+          i++ )
+    {
+        appendStr( outVar[i]->m_name );
+        appendStr( outVar[i]->m_displayUnits );
+    }
+    m_configId = addConfig( m_buf, m_bufBytes );
+    m_config = m_configList[m_configId].m_hash;
+    return( true );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Stores the current value of every input variable in m_buf[] and
+ *  hashes them with the current run's configuration.
+ *
+ *  \return Current table cell's key.
+ */
+
+Q_ULLONG EqDiskCache::cellKey( void )
+{
+    m_bufBytes = 0;
+    EqVar *var;
+    for ( int i = 0;
+          i < m_eqTree->m_leafCount;
+          i++ )
+    {
+        var = m_eqTree->m_leaf[i];
+        if ( var->isDiscrete() )
+        {
+            appendStr( var->m_activeItemName );
+        }
+        else if ( var->isContinuous() )
+        {
+            append( &var->m_nativeValue, sizeof(var->m_nativeValue) );
+        }
+    }
+    return( EqDiskCache_Hash( m_config, m_buf, m_bufBytes ) );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Releases all memory and empties the cache.
+ */
+
+void EqDiskCache::clear( void )
+{
+    delete[] m_entry;       m_entry = 0;
+    delete[] m_pool;        m_pool = 0;
+    delete[] m_slot;        m_slot = 0;
+    delete[] m_configList;  m_configList = 0;
+    delete[] m_bytes;       m_bytes = 0;
+    m_entries = m_capacity = m_values = m_poolSize = m_slots = 0;
+    m_configs = m_configCapacity = m_byteCount = m_byteSize = 0;
+    m_configId = -1;
+    m_clock = 0;
+    m_dirty = false;
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Ends a table run, writing any new cells to the cache file and
+ *  logging the run's cache statistics.
+ */
+
+void EqDiskCache::end( void )
+{
+    if ( m_fileName.isEmpty() )
+    {
+        return;
+    }
+    m_evicted = 0;
+    if ( m_dirty )
+    {
+        save();
+    }
+    log( QString( "Result cache: %1 hits, %2 misses, %3 evicted, %4 cells in \"%5\"\n" )
+        .arg( m_hits ).arg( m_misses ).arg( m_evicted ).arg( m_entries )
+        .arg( m_fileName ) );
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Access to the number of cached cells.
+ *
+ *  \return Number of cached cells.
+ */
+
+int EqDiskCache::entries( void ) const
+{
+    return( m_entries );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Looks up the current table cell.
+ *
+ *  If the cell isn't found, its key and input bytes are remembered for
+ *  the following store().
+ *
+ *  \param val  Returned array of outVars output values (if found).
+ *  \param inRx Returned prescription flag (if found).
+ *
+ *  \return TRUE if the cell was found.
+ */
+
+bool EqDiskCache::fetch( double *val, bool *inRx )
+{
+    m_key = cellKey();
+    int id = find( m_key, m_configId, m_buf, m_bufBytes );
+    if ( id < 0 || m_entry[id].m_vars != m_outVars )
+    {
+        m_misses++;
+        return( false );
+    }
+    memcpy( val, m_pool + m_entry[id].m_offset, m_outVars * sizeof(double) );
+    *inRx = ( m_entry[id].m_inRx != 0 );
+    m_entry[id].m_used = ++m_clock;
+    m_hits++;
+    return( true );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Finds a cached cell.
+ *
+ *  \param key      Cell key.
+ *  \param config   Index of the cell's configuration.
+ *  \param data     Address of the cell's input bytes.
+ *  \param bytes    Number of input bytes.
+ *
+ *  \return Index of the cell's entry, or -1 if it isn't cached.
+ */
+
+int EqDiskCache::find( Q_ULLONG key, int config, const char *data,
+        int bytes ) const
+{
+    if ( m_slots == 0 )
+    {
+        return( -1 );
+    }
+    int mask = m_slots - 1;
+    const EqDiskCacheEntry *e;
+    for ( int slot = (int) ( key & mask );
+          m_slot[slot] >= 0;
+          slot = ( slot + 1 ) & mask )
+    {
+        e = &m_entry[ m_slot[slot] ];
+        if ( e->m_key == key
+          && e->m_config == config
+          && e->m_keyBytes == bytes
+          && memcmp( m_bytes + e->m_keyOffset, data, bytes ) == 0 )
+        {
+            return( m_slot[slot] );
+        }
+    }
+    return( -1 );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Access to the current run's number of cache hits.
+ *
+ *  \return Number of cells found in the cache.
+ */
+
+int EqDiskCache::hits( void ) const
+{
+    return( m_hits );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Adds a cell to the cache, growing the arrays as necessary.
+ *
+ *  \param key      Cell key.
+ *  \param used     Cell's last use clock value.
+ *  \param config   Index of the cell's configuration.
+ *  \param data     Address of the cell's input bytes.
+ *  \param bytes    Number of input bytes.
+ *  \param vars     Number of output values.
+ *  \param inRx     1 if the cell was within prescription.
+ *  \param val      Array of \a vars output values.
+ */
+
+void EqDiskCache::insert( Q_ULLONG key, unsigned int used, int config,
+        const char *data, int bytes, int vars, int inRx, const double *val )
+{
+    // Grow the entry array
+    if ( m_entries == m_capacity )
+    {
+        int capacity = ( m_capacity < 1024 ) ? 1024 : 2 * m_capacity;
+        EqDiskCacheEntry *entry = new EqDiskCacheEntry[ capacity ];
+        checkmem( __FILE__, __LINE__, entry, "EqDiskCacheEntry m_entry",
+            capacity );
+        if ( m_entries )
+        {
+            memcpy( entry, m_entry, m_entries * sizeof(EqDiskCacheEntry) );
+        }
+        delete[] m_entry;
+        m_entry = entry;
+        m_capacity = capacity;
+    }
+    // Grow the value pool
+    if ( m_values + vars > m_poolSize )
+    {
+        int poolSize = ( m_poolSize < 8192 ) ? 8192 : 2 * m_poolSize;
+        while ( m_values + vars > poolSize )
+        {
+            poolSize *= 2;
+        }
+        double *pool = new double[ poolSize ];
+        checkmem( __FILE__, __LINE__, pool, "double m_pool", poolSize );
+        if ( m_values )
+        {
+            memcpy( pool, m_pool, m_values * sizeof(double) );
+        }
+        delete[] m_pool;
+        m_pool = pool;
+        m_poolSize = poolSize;
+    }
+    // Grow the byte pool
+    m_bytes = EqDiskCache_Grow( m_bytes, m_byteCount, &m_byteSize,
+        m_byteCount + bytes, "char m_bytes" );
+    // Keep the hash table at most half full
+    if ( 2 * ( m_entries + 1 ) > m_slots )
+    {
+        rehash( ( m_slots < 2048 ) ? 2048 : 2 * m_slots );
+    }
+    EqDiskCacheEntry *e = &m_entry[m_entries];
+    e->m_key       = key;
+    e->m_used      = used;
+    e->m_config    = config;
+    e->m_keyOffset = m_byteCount;
+    e->m_keyBytes  = bytes;
+    e->m_offset    = m_values;
+    e->m_vars      = vars;
+    e->m_inRx      = inRx;
+    if ( bytes )
+    {
+        memcpy( m_bytes + m_byteCount, data, bytes );
+    }
+    m_byteCount += bytes;
+    memcpy( m_pool + m_values, val, vars * sizeof(double) );
+    m_values += vars;
+    int mask = m_slots - 1;
+    int slot = (int) ( key & mask );
+    while ( m_slot[slot] >= 0 )
+    {
+        slot = ( slot + 1 ) & mask;
+    }
+    m_slot[slot] = m_entries++;
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Reads the cache file into memory.
+ *
+ *  A missing, unreadable, or out of date cache file is simply treated as
+ *  an empty cache.
+ *
+ *  \return TRUE if the cache file was read.
+ */
+
+bool EqDiskCache::load( void )
+{
+    clear();
+    FILE *fptr = fopen( m_fileName.latin1(), "rb" );
+    if ( ! fptr )
+    {
+        return( false );
+    }
+    char magic[8];
+    int version, configs, entries;
+    unsigned int clock;
+    if ( fread( magic, sizeof(magic), 1, fptr ) != 1
+      || memcmp( magic, EqDiskCache_Magic, sizeof(magic) ) != 0
+      || fread( &version, sizeof(version), 1, fptr ) != 1
+      || version != EqDiskCache_Version
+      || fread( &configs, sizeof(configs), 1, fptr ) != 1
+      || fread( &entries, sizeof(entries), 1, fptr ) != 1
+      || fread( &clock, sizeof(clock), 1, fptr ) != 1 )
+    {
+        fclose( fptr );
+        return( false );
+    }
+    // Configurations (each written just once)
+    int i, bytes;
+    for ( i = 0;
+          i < configs;
+          i++ )
+    {
+        m_bufBytes = 0;
+        if ( fread( &bytes, sizeof(bytes), 1, fptr ) != 1
+          || bytes < 1 || bytes > EqDiskCache_MaxBytes )
+        {
+            break;
+        }
+        m_buf = EqDiskCache_Grow( m_buf, 0, &m_bufSize, bytes, "char m_buf" );
+        if ( fread( m_buf, 1, bytes, fptr ) != (size_t) bytes
+          || addConfig( m_buf, bytes ) != i )
+        {
+            break;
+        }
+    }
+    if ( i < configs )
+    {
+        fclose( fptr );
+        clear();
+        return( false );
+    }
+    // Cells
+    m_clock = clock;
+    EqDiskCacheEntry e;
+    double val[256];
+    for ( i = 0;
+          i < entries;
+          i++ )
+    {
+        if ( fread( &e.m_key, sizeof(e.m_key), 1, fptr ) != 1
+          || fread( &e.m_used, sizeof(e.m_used), 1, fptr ) != 1
+          || fread( &e.m_config, sizeof(e.m_config), 1, fptr ) != 1
+          || fread( &e.m_keyBytes, sizeof(e.m_keyBytes), 1, fptr ) != 1
+          || fread( &e.m_vars, sizeof(e.m_vars), 1, fptr ) != 1
+          || fread( &e.m_inRx, sizeof(e.m_inRx), 1, fptr ) != 1
+          || e.m_config < 0 || e.m_config >= m_configs
+          || e.m_keyBytes < 0 || e.m_keyBytes > EqDiskCache_MaxBytes
+          || e.m_vars < 1 || e.m_vars > 256 )
+        {
+            break;
+        }
+        m_buf = EqDiskCache_Grow( m_buf, 0, &m_bufSize, e.m_keyBytes,
+            "char m_buf" );
+        if ( fread( m_buf, 1, e.m_keyBytes, fptr ) != (size_t) e.m_keyBytes
+          || fread( val, sizeof(double), e.m_vars, fptr )
+                != (size_t) e.m_vars )
+        {
+            break;
+        }
+        insert( e.m_key, e.m_used, e.m_config, m_buf, e.m_keyBytes,
+            e.m_vars, e.m_inRx, val );
+    }
+    fclose( fptr );
+    return( true );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Access to the current run's number of cache misses.
+ *
+ *  \return Number of cells not found in the cache.
+ */
+
+int EqDiskCache::misses( void ) const
+{
+    return( m_misses );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Rebuilds the hash table with a new number of slots.
+ *
+ *  \param size New number of slots (a power of 2).
+ */
+
+void EqDiskCache::rehash( int size )
+{
+    delete[] m_slot;
+    m_slots = size;
+    m_slot = new int[ m_slots ];
+    checkmem( __FILE__, __LINE__, m_slot, "int m_slot", m_slots );
+    memset( m_slot, 0xff, m_slots * sizeof(int) );
+    int mask = m_slots - 1;
+    for ( int id = 0;
+          id < m_entries;
+          id++ )
+    {
+        int slot = (int) ( m_entry[id].m_key & mask );
+        while ( m_slot[slot] >= 0 )
+        {
+            slot = ( slot + 1 ) & mask;
+        }
+        m_slot[slot] = id;
+    }
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Writes the most recently used cells to the cache file.
+ *
+ *  The file is written under a temporary name and then renamed, so another
+ *  BehavePlus reading the cache never sees a partial file.
+ *
+ *  \return TRUE on success.
+ */
+
+bool EqDiskCache::save( void )
+{
+    // Evict the least recently used cells
+    if ( m_entries > m_maxEntries )
+    {
+        qsort( m_entry, m_entries, sizeof(EqDiskCacheEntry),
+            EqDiskCache_UsedCompare );
+        m_evicted = m_entries - m_maxEntries;
+        m_entries = m_maxEntries;
+        rehash( m_slots );
+    }
+    // Drop the configurations no longer used by any cell
+    int id, configs = 0;
+    int *configId = new int[ m_configs + 1 ];
+    checkmem( __FILE__, __LINE__, configId, "int configId", m_configs + 1 );
+    for ( id = 0;
+          id < m_configs;
+          id++ )
+    {
+        configId[id] = -1;
+    }
+    for ( id = 0;
+          id < m_entries;
+          id++ )
+    {
+        configId[ m_entry[id].m_config ] = 0;
+    }
+    for ( id = 0;
+          id < m_configs;
+          id++ )
+    {
+        if ( configId[id] == 0 )
+        {
+            configId[id] = configs++;
+        }
+    }
+    QString tmpName = m_fileName + ".tmp";
+    FILE *fptr = fopen( tmpName.latin1(), "wb" );
+    if ( ! fptr )
+    {
+        delete[] configId;
+        return( false );
+    }
+    fwrite( EqDiskCache_Magic, sizeof(EqDiskCache_Magic), 1, fptr );
+    fwrite( &EqDiskCache_Version, sizeof(EqDiskCache_Version), 1, fptr );
+    fwrite( &configs, sizeof(configs), 1, fptr );
+    fwrite( &m_entries, sizeof(m_entries), 1, fptr );
+    fwrite( &m_clock, sizeof(m_clock), 1, fptr );
+    EqDiskCacheConfig *c;
+    for ( id = 0;
+          id < m_configs;
+          id++ )
+    {
+        if ( configId[id] >= 0 )
+        {
+            c = &m_configList[id];
+            fwrite( &c->m_bytes, sizeof(c->m_bytes), 1, fptr );
+            fwrite( m_bytes + c->m_offset, 1, c->m_bytes, fptr );
+        }
+    }
+    EqDiskCacheEntry *e;
+    for ( id = 0;
+          id < m_entries;
+          id++ )
+    {
+        e = &m_entry[id];
+        fwrite( &e->m_key, sizeof(e->m_key), 1, fptr );
+        fwrite( &e->m_used, sizeof(e->m_used), 1, fptr );
+        fwrite( &configId[ e->m_config ], sizeof(int), 1, fptr );
+        fwrite( &e->m_keyBytes, sizeof(e->m_keyBytes), 1, fptr );
+        fwrite( &e->m_vars, sizeof(e->m_vars), 1, fptr );
+        fwrite( &e->m_inRx, sizeof(e->m_inRx), 1, fptr );
+        fwrite( m_bytes + e->m_keyOffset, 1, e->m_keyBytes, fptr );
+        fwrite( m_pool + e->m_offset, sizeof(double), e->m_vars, fptr );
+    }
+    delete[] configId;
+    bool ok = ( ferror( fptr ) == 0 );
+    fclose( fptr );
+    if ( ok )
+    {
+        remove( m_fileName.latin1() );
+        ok = ( rename( tmpName.latin1(), m_fileName.latin1() ) == 0 );
+    }
+    // Reload so the evicted cells and configurations are released
+    if ( ok && ( m_evicted > 0 || configs < m_configs ) )
+    {
+        load();
+    }
+    m_dirty = false;
+    return( ok );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Sets the cache file and limits.
+ *
+ *  \param fileName     Cache file name, or an empty string to deactivate
+ *                      the cache.
+ *  \param maxEntries   Maximum number of cached cells.
+ *  \param release      Application release number.
+ */
+
+void EqDiskCache::setFile( const QString &fileName, int maxEntries,
+        int release )
+{
+    if ( fileName != m_fileName )
+    {
+        clear();
+        m_loaded = false;
+    }
+    m_fileName = fileName;
+    m_release = release;
+    m_maxEntries = maxEntries;
+    if ( m_maxEntries < EqDiskCacheMinEntries )
+    {
+        m_maxEntries = EqDiskCacheMinEntries;
+    }
+    if ( m_maxEntries > EqDiskCacheMaxEntries )
+    {
+        m_maxEntries = EqDiskCacheMaxEntries;
+    }
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Adds the cell of the last fetch() miss to the cache.
+ *
+ *  \param val  Array of outVars output values.
+ *  \param inRx TRUE if the cell was within prescription.
+ */
+
+void EqDiskCache::store( const double *val, bool inRx )
+{
+    insert( m_key, ++m_clock, m_configId, m_buf, m_bufBytes, m_outVars,
+        inRx ? 1 : 0, val );
+    m_dirty = true;
+    return;
+}
+
+//------------------------------------------------------------------------------
+//  End of xeqdiskcache.cpp
+//------------------------------------------------------------------------------
+
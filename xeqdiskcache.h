@@ -0,0 +1,172 @@
+//------------------------------------------------------------------------------
+/*! \file xeqdiskcache.h
+ *  \version BehavePlus6
+ *  \author Copyright (C) 2002-2018 by Collin D. Bevins.  All rights reserved.
+ *
+ *  \brief EqTree persistent table cell result cache class definitions.
+ */
+
+#ifndef _XEQDISKCACHE_H_
+/*! \def _XEQDISKCACHE_H_
+ *  \brief Prevent redundant includes.
+ */
+#define _XEQDISKCACHE_H_ 1
+
+// Custom class references
+class EqTree;
+class EqVar;
+
+// Qt class references
+#include <qstring.h>
+
+//------------------------------------------------------------------------------
+/*! \enum EqDiskCacheSize
+ *  \brief EqDiskCache limits.
+ */
+
+enum EqDiskCacheSize
+{
+    EqDiskCacheMinEntries = 1000,       //!< Minimum number of cached cells
+    EqDiskCacheMaxEntries = 10000000    //!< Maximum number of cached cells
+};
+
+//------------------------------------------------------------------------------
+/*! \struct EqDiskCacheConfig xeqdiskcache.h
+ *
+ *  \brief One cached run configuration's hash and canonical bytes.
+ */
+
+struct EqDiskCacheConfig
+{
+    Q_ULLONG     m_hash;        //!< Hash of the configuration bytes
+    int          m_offset;      //!< Index of the first byte in the byte pool
+    int          m_bytes;       //!< Number of configuration bytes
+};
+
+//------------------------------------------------------------------------------
+/*! \struct EqDiskCacheEntry xeqdiskcache.h
+ *
+ *  \brief One cached table cell's key, last use, and output values.
+ */
+
+struct EqDiskCacheEntry
+{
+    Q_ULLONG     m_key;         //!< Configuration and input vector hash
+    unsigned int m_used;        //!< Clock value when last fetched or stored
+    int          m_config;      //!< Index of the cell's configuration
+    int          m_keyOffset;   //!< Index of the first input byte in the pool
+    int          m_keyBytes;    //!< Number of input bytes
+    int          m_offset;      //!< Index of the first value in the pool
+    int          m_vars;        //!< Number of output values
+    int          m_inRx;        //!< 1 if the cell was within prescription
+};
+
+//------------------------------------------------------------------------------
+/*! \class EqDiskCache xeqdiskcache.h
+ *
+ *  \brief Keeps the output values of table cells in a file, so that a
+ *  cell calculated in any earlier run is not calculated again.
+ *
+ *  If the "resultCacheActive" property is TRUE, EqTree::runTable() looks
+ *  up each cell here before calculating it.
+ *
+ *  Each cell is keyed by
+ *  \arg the application release,
+ *  \arg every property that configures the calculations (those whose names
+ *      contain "Conf" or "Calc", or end with "ModuleActive"),
+ *  \arg the fuel model and moisture scenario definitions,
+ *  \arg the prescription ("docRxActive" and the limits or acceptable items
+ *      of every active prescription variable),
+ *  \arg the names and display units of the current input and output
+ *      variables, and
+ *  \arg the current value of every input variable for this cell.
+ *
+ *  The first four are kept once per configuration, and the input values
+ *  once per cell.  The 64-bit hash of the key only locates a cell; its
+ *  configuration and input bytes must also match exactly, so the cached
+ *  values are found whenever, and only when, the cell would be calculated
+ *  exactly as before.
+ *
+ *  A cached cell has only its output values.  So runs that store every
+ *  variable to a result file or that draw diagrams (which are composed
+ *  from that file) never use the cache (see EqTree::runTable()).
+ *
+ *  The cache is loaded from its file on first use and written back after
+ *  each run that added to it.  When it holds more than its maximum number
+ *  of cells, the least recently used cells are evicted as it is written.
+ *  The hits, misses, and evictions are written to the application log.
+ */
+
+class EqDiskCache
+{
+// Public methods
+public:
+    EqDiskCache( void ) ;
+    ~EqDiskCache( void ) ;
+
+    bool    begin( EqTree *eqTree, EqVar **outVar, int outVars ) ;
+    void    end( void ) ;
+    int     entries( void ) const ;
+    bool    fetch( double *val, bool *inRx ) ;
+    int     hits( void ) const ;
+    int     misses( void ) const ;
+    void    setFile( const QString &fileName, int maxEntries, int release ) ;
+    void    store( const double *val, bool inRx ) ;
+
+// Protected methods
+protected:
+    void    clear( void ) ;
+    void    append( const void *data, int bytes ) ;
+    void    appendStr( const QString &str ) ;
+    int     addConfig( const char *data, int bytes ) ;
+    Q_ULLONG cellKey( void ) ;
+    int     find( Q_ULLONG key, int config, const char *data, int bytes )
+                const ;
+    void    insert( Q_ULLONG key, unsigned int used, int config,
+                const char *data, int bytes, int vars, int inRx,
+                const double *val ) ;
+    bool    load( void ) ;
+    void    rehash( int size ) ;
+    bool    save( void ) ;
+
+// Protected data members
+protected:
+    QString     m_fileName;     //!< Cache file name (or empty if inactive)
+    int         m_maxEntries;   //!< Maximum number of cached cells
+    int         m_release;      //!< Application release number
+    bool        m_loaded;       //!< TRUE once the cache file has been read
+    bool        m_dirty;        //!< TRUE if cells were added since loading
+    EqTree     *m_eqTree;       //!< Current run's EqTree
+    int         m_outVars;      //!< Current run's number of outputs
+    Q_ULLONG    m_config;       //!< Current run's configuration hash
+    int         m_configId;     //!< Current run's configuration index
+    Q_ULLONG    m_key;          //!< Key of the last fetch() miss
+    int         m_bufBytes;     //!< Number of key bytes in m_buf[]
+    int         m_bufSize;      //!< Capacity of the m_buf[] array
+    char       *m_buf;          //!< Key bytes of the last fetch() miss
+    int         m_configs;      //!< Number of cached configurations
+    int         m_configCapacity; //!< Capacity of the m_configList[] array
+    EqDiskCacheConfig *m_configList; //!< Array of cached configurations
+    int         m_byteCount;    //!< Number of bytes in the byte pool
+    int         m_byteSize;     //!< Capacity of the m_bytes[] array
+    char       *m_bytes;        //!< Pool of configuration and input bytes
+    unsigned int m_clock;       //!< Use clock for LRU eviction
+    int         m_entries;      //!< Number of cached cells
+    int         m_capacity;     //!< Capacity of the m_entry[] array
+    EqDiskCacheEntry *m_entry;  //!< Array of cached cells
+    int         m_values;       //!< Number of values in the pool
+    int         m_poolSize;     //!< Capacity of the m_pool[] array
+    double     *m_pool;         //!< Pool of cached output values
+    int         m_slots;        //!< Size of the m_slot[] hash table
+    int        *m_slot;         //!< Hash table of m_entry[] indices
+    int         m_hits;         //!< Current run's cache hits
+    int         m_misses;       //!< Current run's cache misses
+    int         m_evicted;      //!< Cells evicted by the last save()
+};
+
+#endif
+
+//------------------------------------------------------------------------------
+//  End of xeqdiskcache.h
+//------------------------------------------------------------------------------
+
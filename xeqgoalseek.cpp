@@ -0,0 +1,512 @@
+//------------------------------------------------------------------------------
+/*! \file xeqgoalseek.cpp
+ *  \version BehavePlus6
+ *  \author Copyright (C) 2002-2018 by Collin D. Bevins.  All rights reserved.
+ *
+ *  \brief EqTree goal-seek (inverse) solver class methods.
+ */
+
+// Custom include files
+#include "appmessage.h"
+#include "apptranslator.h"
+#include "xeqgoalseek.h"
+#include "xeqtree.h"
+#include "xeqvar.h"
+#include "xeqvaritem.h"
+
+// Qt include files
+#include <qapplication.h>
+#include <qprogressdialog.h>
+
+// Standard include files
+#include <float.h>
+#include <math.h>
+#include <stdio.h>
+
+//------------------------------------------------------------------------------
+/*! \brief EqGoalSeek constructor.
+ *
+ *  \param eqTree Pointer to the EqTree to be run.  Its worksheet inputs must
+ *  have been stored by BpDocument::validateWorksheet() and its range case
+ *  determined by EqTree::rangeCase().
+ */
+
+EqGoalSeek::EqGoalSeek( EqTree *eqTree ) :
+    m_eqTree(eqTree),
+    m_error(""),
+    m_inVar(0),
+    m_outVar(0),
+    m_target(0.),
+    m_cells(0),
+    m_solved(0),
+    m_evaluations(0)
+{
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief EqGoalSeek destructor.
+ */
+
+EqGoalSeek::~EqGoalSeek( void )
+{
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Access to the number of table cells processed by the last run().
+ *
+ *  \return Number of table cells processed.
+ */
+
+int EqGoalSeek::cells( void ) const
+{
+    return( m_cells );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Access to the last error message.
+ *
+ *  \return Description of the last error, or an empty string.
+ */
+
+const QString &EqGoalSeek::error( void ) const
+{
+    return( m_error );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Sets the solved input variable to \a x, recalculates the output
+ *  variable, and returns its deviation from the target.
+ *
+ *  \param x Solved input variable value (display units).
+ *
+ *  \return Output value minus the target value (display units).
+ */
+
+double EqGoalSeek::evaluate( double x )
+{
+    m_inVar->setDisplayValue( x );
+    m_eqTree->calculateVariable( m_outVar, 0 );
+    m_evaluations++;
+    return( m_outVar->m_displayValue - m_target );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Access to the number of output evaluations made by the last run().
+ *
+ *  \return Number of output evaluations.
+ */
+
+int EqGoalSeek::evaluations( void ) const
+{
+    return( m_evaluations );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Finds the continuous worksheet input or output variable named by
+ *  either its internal name (such as "vWindSpeedAtMidflame") or its label.
+ *
+ *  \param name     Variable name or label (case insensitive).
+ *  \param input    If TRUE, find an input, otherwise find an output.
+ *
+ *  \return Pointer to the EqVar, or 0 if there is no such variable.
+ */
+
+EqVar *EqGoalSeek::findVar( const QString &name, bool input ) const
+{
+    EqVar **var = ( input ) ? m_eqTree->m_leaf : m_eqTree->m_tableVar;
+    int vars = ( input ) ? m_eqTree->m_leafCount : m_eqTree->m_tableVars;
+    QString key = name.stripWhiteSpace().lower();
+    for ( int vid = 0;
+          vid < vars;
+          vid++ )
+    {
+        if ( var[vid]
+          && var[vid]->isContinuous()
+          && ( var[vid]->m_name.lower() == key
+            || var[vid]->m_label->lower() == key ) )
+        {
+            return( var[vid] );
+        }
+    }
+    return( 0 );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Solves every table cell for the input value at which the output
+ *  reaches the target.
+ *
+ *  \param inputName    Name or label of the continuous input to solve for.
+ *  \param outputName   Name or label of the continuous output.
+ *  \param target       Output target value (display units).
+ *  \param minimum      Lowest input value searched (display units),
+ *                      or empty for the input's minimum valid value.
+ *  \param maximum      Highest input value searched (display units),
+ *                      or empty for the input's maximum valid value.
+ *                      The search range must lie within the valid range.
+ *  \param tolerance    Solution tolerance as a fraction of the search range.
+ *  \param resultFile   Name of the comma-separated result file to write.
+ *
+ *  \return TRUE on success, FALSE on failure (see error()) or if the user
+ *  cancelled.
+ */
+
+bool EqGoalSeek::run( const QString &inputName, const QString &outputName,
+        const QString &target, const QString &minimum,
+        const QString &maximum, double tolerance, const QString &resultFile )
+{
+    m_error = "";
+    m_inVar = m_outVar = 0;
+    m_cells = m_solved = m_evaluations = 0;
+    // Each cell is a single table row and column
+    if ( m_eqTree->m_rangeVars > 2 )
+    {
+        translate( m_error, "EqGoalSeek:RangeVars" );
+        return( false );
+    }
+    if ( ! m_eqTree->runInit( false ) )
+    {
+        return( false );
+    }
+    EqVar *rowVar = m_eqTree->m_rangeVar[0];
+    EqVar *colVar = m_eqTree->m_rangeVar[1];
+
+    // Find the input and output variables
+    if ( ! ( m_inVar = findVar( inputName, true ) )
+      || m_inVar == rowVar
+      || m_inVar == colVar )
+    {
+        translate( m_error, "EqGoalSeek:NoInput", inputName );
+        m_eqTree->runClean();
+        return( false );
+    }
+    if ( ! ( m_outVar = findVar( outputName, false ) ) )
+    {
+        translate( m_error, "EqGoalSeek:NoOutput", outputName );
+        m_eqTree->runClean();
+        return( false );
+    }
+    // Get the target and the search range
+    bool ok = true;
+    m_target = target.toDouble( &ok );
+    if ( ! ok )
+    {
+        translate( m_error, "EqGoalSeek:BadValue", target,
+            *(m_outVar->m_label) );
+        m_eqTree->runClean();
+        return( false );
+    }
+    double lo = m_inVar->m_displayMinimum;
+    double hi = m_inVar->m_displayMaximum;
+    if ( ! minimum.stripWhiteSpace().isEmpty() )
+    {
+        lo = minimum.toDouble( &ok );
+    }
+    if ( ok && ! maximum.stripWhiteSpace().isEmpty() )
+    {
+        hi = maximum.toDouble( &ok );
+    }
+    // The search range must lie within the input's valid range
+    if ( ! ok
+      || lo >= hi
+      || lo < m_inVar->m_displayMinimum
+      || hi > m_inVar->m_displayMaximum )
+    {
+        translate( m_error, "EqGoalSeek:BadRange", minimum, maximum,
+            *(m_inVar->m_label),
+            QString( "%1" ).arg( m_inVar->m_displayMinimum, 0, 'f',
+                m_inVar->m_displayDecimals ),
+            QString( "%1" ).arg( m_inVar->m_displayMaximum, 0, 'f',
+                m_inVar->m_displayDecimals ) );
+        m_eqTree->runClean();
+        return( false );
+    }
+    double tol = ( tolerance > 0. ) ? tolerance * ( hi - lo ) : 0.;
+
+    // Write the result file header
+    FILE *out = fopen( resultFile.latin1(), "w" );
+    if ( ! out )
+    {
+        translate( m_error, "EqGoalSeek:CreateError", resultFile );
+        m_eqTree->runClean();
+        return( false );
+    }
+    EqVar *headVar[4] = { rowVar, colVar, m_inVar, m_outVar };
+    QString sep("");
+    int i;
+    for ( i = 0;
+          i < 4;
+          i++ )
+    {
+        if ( headVar[i] )
+        {
+            fprintf( out, "%s\"%s %s\"", sep.latin1(),
+                (*(headVar[i]->m_label)).latin1(),
+                headVar[i]->displayUnits( true ).latin1() );
+            sep = ",";
+        }
+    }
+    fprintf( out, "\n" );
+
+    // Set up the progress dialog.
+    int cells = m_eqTree->m_tableRows * m_eqTree->m_tableCols;
+    QString caption(""), button("");
+    translate( caption, "EqGoalSeek:Progress:Caption",
+        QString( "%1" ).arg( cells ), *(m_inVar->m_label),
+        *(m_outVar->m_label) );
+    translate( button, "EqTree:RunTable:Progress:Button" );
+    QProgressDialog *progress = new QProgressDialog( caption, button, cells );
+    Q_CHECK_PTR( progress );
+    progress->setMinimumDuration( 0 );
+    progress->setProgress( 0 );
+
+    // Solve every table cell
+    double inValue = m_inVar->m_displayValue;
+    double x0, x1, f0, f1, root;
+    int row, col, iid, step;
+    for ( row = 0;
+          ok && row < m_eqTree->m_tableRows;
+          row++ )
+    {
+        // Set this row's input value.
+        if ( rowVar )
+        {
+            if ( rowVar->isDiscrete() )
+            {
+                iid = (int) m_eqTree->m_tableRow[ row ];
+                rowVar->setItemName( rowVar->getItemName( iid ) );
+            }
+            else if ( rowVar->isContinuous() )
+            {
+                rowVar->setDisplayValue( m_eqTree->m_tableRow[ row ] );
+            }
+        }
+        for ( col = 0;
+              col < m_eqTree->m_tableCols;
+              col++ )
+        {
+            // Set this column's input value.
+            if ( colVar )
+            {
+                if ( colVar->isDiscrete() )
+                {
+                    iid = (int) m_eqTree->m_tableCol[ col ];
+                    colVar->setItemName( colVar->getItemName( iid ) );
+                }
+                else if ( colVar->isContinuous() )
+                {
+                    colVar->setDisplayValue( m_eqTree->m_tableCol[ col ] );
+                }
+            }
+            // Write this cell's row and column values.
+            sep = "";
+            for ( i = 0;
+                  i < 2;
+                  i++ )
+            {
+                if ( ! headVar[i] )
+                {
+                    continue;
+                }
+                if ( headVar[i]->isDiscrete() )
+                {
+                    fprintf( out, "%s\"%s\"", sep.latin1(),
+                        headVar[i]->activeItemName().latin1() );
+                }
+                else
+                {
+                    fprintf( out, "%s%1.*f", sep.latin1(),
+                        headVar[i]->m_displayDecimals,
+                        headVar[i]->m_displayValue );
+                }
+                sep = ",";
+            }
+            // Find the first interval over which the output crosses the target
+            bool found = false;
+            x0 = lo;
+            f0 = evaluate( x0 );
+            if ( f0 == 0. )
+            {
+                root = x0;
+                found = true;
+            }
+            for ( step = 1;
+                  ! found && step <= EqGoalSeekScanIntervals;
+                  step++ )
+            {
+                x1 = lo + ( hi - lo ) * step / (double) EqGoalSeekScanIntervals;
+                f1 = evaluate( x1 );
+                if ( ( f0 < 0. && f1 >= 0. )
+                  || ( f0 > 0. && f1 <= 0. ) )
+                {
+                    found = solve( x0, x1, f0, f1, tol, &root );
+                    break;
+                }
+                x0 = x1;
+                f0 = f1;
+            }
+            // Write this cell's solution.
+            if ( found )
+            {
+                evaluate( root );
+                fprintf( out, "%s%1.*f,%1.*f\n", sep.latin1(),
+                    m_inVar->m_displayDecimals + 2, root,
+                    m_outVar->m_displayDecimals, m_outVar->m_displayValue );
+                m_solved++;
+            }
+            else
+            {
+                fprintf( out, "%s,\n", sep.latin1() );
+            }
+            m_cells++;
+
+            // Update progress dialog.
+            progress->setProgress( m_cells );
+            qApp->processEvents();
+            if ( progress->wasCancelled() )
+            {
+                ok = false;
+                break;
+            }
+        }
+    }
+    delete progress;    progress = 0;
+
+    // Restore the worksheet value of the solved input
+    m_inVar->setDisplayValue( inValue );
+    if ( ferror( out ) && ok )
+    {
+        translate( m_error, "EqGoalSeek:CreateError", resultFile );
+        ok = false;
+    }
+    fclose( out );
+    m_eqTree->runClean();
+    return( ok );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Finds the input value at which the output reaches the target by
+ *  Brent's (1973) method, which combines bisection with secant and inverse
+ *  quadratic interpolation steps.
+ *
+ *  \param a    One end of the bracketing interval.
+ *  \param b    Other end of the bracketing interval.
+ *  \param fa   Value of evaluate( a ).
+ *  \param fb   Value of evaluate( b ), whose sign differs from \a fa.
+ *  \param tol  Absolute solution tolerance (display units).
+ *  \param root Returned solution.
+ *
+ *  \return TRUE if the solution converged within EqGoalSeekMaxIterations.
+ */
+
+bool EqGoalSeek::solve( double a, double b, double fa, double fb, double tol,
+        double *root )
+{
+    double c = a;
+    double fc = fa;
+    double d = b - a;
+    double e = d;
+    double p, q, r, s, tol1, xm;
+    for ( int iter = 0;
+          iter < EqGoalSeekMaxIterations;
+          iter++ )
+    {
+        // Keep the solution between b and c
+        if ( ( fb > 0. && fc > 0. )
+          || ( fb < 0. && fc < 0. ) )
+        {
+            c = a;
+            fc = fa;
+            d = e = b - a;
+        }
+        // Keep b the best estimate
+        if ( fabs( fc ) < fabs( fb ) )
+        {
+            a = b;
+            b = c;
+            c = a;
+            fa = fb;
+            fb = fc;
+            fc = fa;
+        }
+        tol1 = 2. * DBL_EPSILON * fabs( b ) + 0.5 * tol;
+        xm = 0.5 * ( c - b );
+        if ( fabs( xm ) <= tol1 || fb == 0. )
+        {
+            *root = b;
+            return( true );
+        }
+        if ( fabs( e ) >= tol1 && fabs( fa ) > fabs( fb ) )
+        {
+            // Attempt secant or inverse quadratic interpolation
+            s = fb / fa;
+            if ( a == c )
+            {
+                p = 2. * xm * s;
+                q = 1. - s;
+            }
+            else
+            {
+                q = fa / fc;
+                r = fb / fc;
+                p = s * ( 2. * xm * q * ( q - r ) - ( b - a ) * ( r - 1. ) );
+                q = ( q - 1. ) * ( r - 1. ) * ( s - 1. );
+            }
+            if ( p > 0. )
+            {
+                q = -q;
+            }
+            p = fabs( p );
+            double min1 = 3. * xm * q - fabs( tol1 * q );
+            double min2 = fabs( e * q );
+            if ( 2. * p < ( ( min1 < min2 ) ? min1 : min2 ) )
+            {
+                // Accept the interpolation
+                e = d;
+                d = p / q;
+            }
+            else
+            {
+                // Interpolation failed, so bisect
+                d = xm;
+                e = d;
+            }
+        }
+        else
+        {
+            // Bounds are decreasing too slowly, so bisect
+            d = xm;
+            e = d;
+        }
+        a = b;
+        fa = fb;
+        if ( fabs( d ) > tol1 )
+        {
+            b += d;
+        }
+        else
+        {
+            b += ( xm > 0. ) ? tol1 : -tol1;
+        }
+        fb = evaluate( b );
+    }
+    *root = b;
+    return( false );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Access to the number of table cells solved by the last run().
+ *
+ *  \return Number of table cells solved.
+ */
+
+int EqGoalSeek::solved( void ) const
+{
+    return( m_solved );
+}
+
+//------------------------------------------------------------------------------
+//  End of xeqgoalseek.cpp
+//------------------------------------------------------------------------------
+
@@ -0,0 +1,92 @@
+//------------------------------------------------------------------------------
+/*! \file xeqgoalseek.h
+ *  \version BehavePlus6
+ *  \author Copyright (C) 2002-2018 by Collin D. Bevins.  All rights reserved.
+ *
+ *  \brief EqTree goal-seek (inverse) solver class definitions.
+ */
+
+#ifndef _XEQGOALSEEK_H_
+/*! \def _XEQGOALSEEK_H_
+ *  \brief Prevent redundant includes.
+ */
+#define _XEQGOALSEEK_H_ 1
+
+// Custom class references
+class EqTree;
+class EqVar;
+
+// Qt class references
+#include <qstring.h>
+
+//------------------------------------------------------------------------------
+/*! \enum EqGoalSeekSize
+ *  \brief EqGoalSeek limits.
+ */
+
+enum EqGoalSeekSize
+{
+    EqGoalSeekScanIntervals = 10,   //!< Intervals searched for a bracket
+    EqGoalSeekMaxIterations = 100   //!< Maximum Brent iterations per cell
+};
+
+//------------------------------------------------------------------------------
+/*! \class EqGoalSeek xeqgoalseek.h
+ *
+ *  \brief Finds, for every table cell, the value of one continuous input
+ *  variable at which one continuous output variable reaches a target value.
+ *
+ *  An EqGoalSeek sets each table cell's row and column values as
+ *  EqTree::runTable() does, then searches the input's range (in
+ *  EqGoalSeekScanIntervals equal steps, from its minimum upwards) for the
+ *  first interval over which the output crosses the target, and refines
+ *  it by Brent's method.  So the solution is the smallest input value at
+ *  which the output reaches the target.
+ *
+ *  Each cell's row and column values, solution, and output value at the
+ *  solution are written to a comma-separated result file.  Cells whose
+ *  output never reaches the target within the input's range have empty
+ *  solutions.
+ */
+
+class EqGoalSeek
+{
+// Public methods
+public:
+    EqGoalSeek( EqTree *eqTree ) ;
+    ~EqGoalSeek( void ) ;
+
+    int     cells( void ) const ;
+    const QString &error( void ) const ;
+    int     evaluations( void ) const ;
+    bool    run( const QString &inputName, const QString &outputName,
+                const QString &target, const QString &minimum,
+                const QString &maximum, double tolerance,
+                const QString &resultFile ) ;
+    int     solved( void ) const ;
+
+// Protected methods
+protected:
+    double  evaluate( double x ) ;
+    EqVar  *findVar( const QString &name, bool input ) const ;
+    bool    solve( double a, double b, double fa, double fb, double tol,
+                double *root ) ;
+
+// Protected data members
+protected:
+    EqTree     *m_eqTree;       //!< Pointer to the EqTree being run
+    QString     m_error;        //!< Description of the last error
+    EqVar      *m_inVar;        //!< Input variable being solved for
+    EqVar      *m_outVar;       //!< Output variable whose target is sought
+    double      m_target;       //!< Output target value (display units)
+    int         m_cells;        //!< Number of table cells processed
+    int         m_solved;       //!< Number of table cells solved
+    int         m_evaluations;  //!< Number of output evaluations
+};
+
+#endif
+
+//------------------------------------------------------------------------------
+//  End of xeqgoalseek.h
+//------------------------------------------------------------------------------
+
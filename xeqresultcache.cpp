@@ -0,0 +1,290 @@
+//------------------------------------------------------------------------------
+/*! \file xeqresultcache.cpp
+ *  \version BehavePlus6
+ *  \author Copyright (C) 2002-2018 by Collin D. Bevins.  All rights reserved.
+ *
+ *  \brief EqTree table run result cache class methods.
+ */
+
+// Custom include files
+#include "appmessage.h"
+#include "xeqresultcache.h"
+#include "xeqvar.h"
+
+// Standard include files
+#include <string.h>
+
+//------------------------------------------------------------------------------
+/*! \brief EqResultCache default constructor.
+ */
+
+EqResultCache::EqResultCache( void ) :
+    m_rowVar(0),
+    m_colVar(0),
+    m_rows(0),
+    m_cols(0),
+    m_outVars(0),
+    m_rowValue(0),
+    m_colValue(0),
+    m_outVar(0),
+    m_val(0),
+    m_inRx(0),
+    m_outMap(0),
+    m_runVars(0),
+    m_swapped(false)
+{
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief EqResultCache destructor.
+ */
+
+EqResultCache::~EqResultCache( void )
+{
+    clear();
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Prepares the cache for lookups by a run.
+ *
+ *  \param rowVar   Pointer to the run's row range variable (may be 0).
+ *  \param colVar   Pointer to the run's column range variable (may be 0).
+ *  \param outVar   Array of the run's output variable pointers.
+ *  \param outVars  Number of run output variables.
+ *
+ *  \return TRUE if the run has the same range variables as the cache (in
+ *  either order) and all its outputs are cached, so fetch() may be used.
+ */
+
+bool EqResultCache::begin( EqVar *rowVar, EqVar *colVar, EqVar **outVar,
+        int outVars )
+{
+    delete[] m_outMap;  m_outMap = 0;
+    m_runVars = 0;
+    if ( ! m_rows )
+    {
+        return( false );
+    }
+    // The range variables may be in either order
+    if ( rowVar == m_rowVar && colVar == m_colVar )
+    {
+        m_swapped = false;
+    }
+    else if ( rowVar == m_colVar && colVar == m_rowVar )
+    {
+        m_swapped = true;
+    }
+    else
+    {
+        return( false );
+    }
+    // Every run output must be in the cache
+    m_outMap = new int[ outVars ];
+    checkmem( __FILE__, __LINE__, m_outMap, "int m_outMap", outVars );
+    for ( int vid = 0;
+          vid < outVars;
+          vid++ )
+    {
+        m_outMap[vid] = -1;
+        for ( int cid = 0;
+              cid < m_outVars;
+              cid++ )
+        {
+            if ( m_outVar[cid] == outVar[vid] )
+            {
+                m_outMap[vid] = cid;
+                break;
+            }
+        }
+        if ( m_outMap[vid] < 0 )
+        {
+            delete[] m_outMap;  m_outMap = 0;
+            return( false );
+        }
+    }
+    m_runVars = outVars;
+    return( true );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Empties the cache and releases all its memory.
+ */
+
+void EqResultCache::clear( void )
+{
+    delete[] m_rowValue;    m_rowValue = 0;
+    delete[] m_colValue;    m_colValue = 0;
+    delete[] m_outVar;      m_outVar = 0;
+    delete[] m_val;         m_val = 0;
+    delete[] m_inRx;        m_inRx = 0;
+    delete[] m_outMap;      m_outMap = 0;
+    m_rowVar = m_colVar = 0;
+    m_rows = m_cols = m_outVars = m_runVars = 0;
+    m_swapped = false;
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Retrieves the current run's output values for a cached cell.
+ *
+ *  \param rowIndex Index of the run's row value, as returned by find().
+ *  \param colIndex Index of the run's column value, as returned by find().
+ *  \param val      Returned array of the run's output values,
+ *                  in the order passed to begin().
+ *  \param inRx     Returned cell prescription flag.
+ *
+ *  \return TRUE if the cell was found, FALSE if not.
+ */
+
+bool EqResultCache::fetch( int rowIndex, int colIndex, double *val,
+        bool *inRx ) const
+{
+    if ( ! m_outMap || rowIndex < 0 || colIndex < 0 )
+    {
+        return( false );
+    }
+    int row = ( m_swapped ) ? colIndex : rowIndex;
+    int col = ( m_swapped ) ? rowIndex : colIndex;
+    int cell = row * m_cols + col;
+    const double *cellVal = m_val + cell * m_outVars;
+    for ( int vid = 0;
+          vid < m_runVars;
+          vid++ )
+    {
+        val[vid] = cellVal[ m_outMap[vid] ];
+    }
+    *inRx = m_inRx[cell];
+    return( true );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Finds a range variable value in the cache.
+ *
+ *  Values are compared exactly, since they are either parsed from the same
+ *  store text or copied from values().
+ *
+ *  \param var      Pointer to a cached range variable (or 0).
+ *  \param value    Range variable value (ignored if \a var is 0).
+ *
+ *  \return Index of the value to pass to fetch(), or -1 if not cached.
+ */
+
+int EqResultCache::find( EqVar *var, double value ) const
+{
+    int count;
+    const double *v = values( var, &count );
+    if ( ! var )
+    {
+        return( ( count > 0 ) ? 0 : -1 );
+    }
+    for ( int i = 0;
+          i < count;
+          i++ )
+    {
+        if ( v[i] == value )
+        {
+            return( i );
+        }
+    }
+    return( -1 );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Replaces the cache contents with a completed table run.
+ *
+ *  \param rowVar   Pointer to the row range variable (may be 0).
+ *  \param rows     Number of table rows.
+ *  \param rowValue Array of \a rows row values (ignored if \a rowVar is 0).
+ *  \param colVar   Pointer to the column range variable (may be 0).
+ *  \param cols     Number of table columns.
+ *  \param colValue Array of \a cols column values (ignored if \a colVar is 0).
+ *  \param outVar   Array of output variable pointers.
+ *  \param outVars  Number of output variables.
+ *  \param val      Array of rows * cols * outVars values in the
+ *                  EqTree::m_tableVal[] order.
+ *  \param inRx     Array of rows * cols cell prescription flags.
+ */
+
+void EqResultCache::store( EqVar *rowVar, int rows, const double *rowValue,
+        EqVar *colVar, int cols, const double *colValue,
+        EqVar **outVar, int outVars, const double *val, const bool *inRx )
+{
+    clear();
+    m_rowVar  = rowVar;
+    m_colVar  = colVar;
+    m_rows    = rows;
+    m_cols    = cols;
+    m_outVars = outVars;
+    int cells = m_rows * m_cols;
+
+    m_rowValue = new double[ m_rows ];
+    checkmem( __FILE__, __LINE__, m_rowValue, "double m_rowValue", m_rows );
+    m_colValue = new double[ m_cols ];
+    checkmem( __FILE__, __LINE__, m_colValue, "double m_colValue", m_cols );
+    m_outVar = new EqVar *[ m_outVars ];
+    checkmem( __FILE__, __LINE__, m_outVar, "EqVar *m_outVar", m_outVars );
+    m_val = new double[ cells * m_outVars ];
+    checkmem( __FILE__, __LINE__, m_val, "double m_val", cells * m_outVars );
+    m_inRx = new bool[ cells ];
+    checkmem( __FILE__, __LINE__, m_inRx, "bool m_inRx", cells );
+
+    int i;
+    for ( i = 0;
+          i < m_rows;
+          i++ )
+    {
+        m_rowValue[i] = ( rowVar ) ? rowValue[i] : 0.;
+    }
+    for ( i = 0;
+          i < m_cols;
+          i++ )
+    {
+        m_colValue[i] = ( colVar ) ? colValue[i] : 0.;
+    }
+    for ( i = 0;
+          i < m_outVars;
+          i++ )
+    {
+        m_outVar[i] = outVar[i];
+    }
+    memcpy( m_val, val, cells * m_outVars * sizeof(double) );
+    memcpy( m_inRx, inRx, cells * sizeof(bool) );
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Access to the cached values of a range variable.
+ *
+ *  \param var      Pointer to a range variable.
+ *  \param count    Returned number of cached values.
+ *
+ *  \return Pointer to the array of cached values, or 0 (and a \a count
+ *  of 0) if \a var is not a cached range variable.
+ */
+
+const double *EqResultCache::values( EqVar *var, int *count ) const
+{
+    *count = 0;
+    if ( ! m_rows )
+    {
+        return( 0 );
+    }
+    if ( var == m_rowVar )
+    {
+        *count = m_rows;
+        return( m_rowValue );
+    }
+    if ( var == m_colVar )
+    {
+        *count = m_cols;
+        return( m_colValue );
+    }
+    return( 0 );
+}
+
+//------------------------------------------------------------------------------
+//  End of xeqresultcache.cpp
+//------------------------------------------------------------------------------
+
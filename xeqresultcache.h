@@ -0,0 +1,76 @@
+//------------------------------------------------------------------------------
+/*! \file xeqresultcache.h
+ *  \version BehavePlus6
+ *  \author Copyright (C) 2002-2018 by Collin D. Bevins.  All rights reserved.
+ *
+ *  \brief EqTree table run result cache class definitions.
+ */
+
+#ifndef _XEQRESULTCACHE_H_
+/*! \def _XEQRESULTCACHE_H_
+ *  \brief Prevent redundant includes.
+ */
+#define _XEQRESULTCACHE_H_ 1
+
+// Custom class references
+class EqVar;
+
+//------------------------------------------------------------------------------
+/*! \class EqResultCache xeqresultcache.h
+ *
+ *  \brief Holds the output values of the most recent worksheet table run
+ *  so a subsequent graph run of the same worksheet can reuse them.
+ *
+ *  The cache is keyed by the identities and values of the two range
+ *  variables (in either order) and holds every output variable value and
+ *  prescription flag for each table cell.  A later run may use it only if
+ *  it has the same range variables and its output variables are all in
+ *  the cache; begin() checks this and maps the run's outputs onto the
+ *  cached outputs.  EqTree::runInitRowsFromRange() places the cached
+ *  range values on the graph's x-axis grid so that they are found.
+ *
+ *  The cache knows nothing about the other worksheet inputs, so the owner
+ *  must clear() it whenever they may have changed.
+ */
+
+class EqResultCache
+{
+// Public methods
+public:
+    EqResultCache( void ) ;
+    ~EqResultCache( void ) ;
+
+    bool   begin( EqVar *rowVar, EqVar *colVar, EqVar **outVar,
+                int outVars ) ;
+    void   clear( void ) ;
+    bool   fetch( int rowIndex, int colIndex, double *val, bool *inRx ) const ;
+    int    find( EqVar *var, double value ) const ;
+    void   store( EqVar *rowVar, int rows, const double *rowValue,
+                EqVar *colVar, int cols, const double *colValue,
+                EqVar **outVar, int outVars, const double *val,
+                const bool *inRx ) ;
+    const double *values( EqVar *var, int *count ) const ;
+
+// Protected data members
+protected:
+    EqVar     *m_rowVar;        //!< Cached row range variable
+    EqVar     *m_colVar;        //!< Cached column range variable
+    int        m_rows;          //!< Number of cached rows
+    int        m_cols;          //!< Number of cached columns
+    int        m_outVars;       //!< Number of cached output variables
+    double    *m_rowValue;      //!< Array of cached row values
+    double    *m_colValue;      //!< Array of cached column values
+    EqVar    **m_outVar;        //!< Array of cached output variable ptrs
+    double    *m_val;           //!< Array of cached output values
+    bool      *m_inRx;          //!< Array of cached cell prescription flags
+    int       *m_outMap;        //!< Current run's output to cache map
+    int        m_runVars;       //!< Number of current run outputs
+    bool       m_swapped;       //!< Current run's row is the cached column
+};
+
+#endif
+
+//------------------------------------------------------------------------------
+//  End of xeqresultcache.h
+//------------------------------------------------------------------------------
+
@@ -0,0 +1,1150 @@
+//------------------------------------------------------------------------------
+/*! \file xeqresultstore.cpp
+ *  \version BehavePlus6
+ *  \author Copyright (C) 2002-2018 by Collin D. Bevins.  All rights reserved.
+ *
+ *  \brief Columnar binary EqTree run result store class methods.
+ */
+
+// Custom include files
+#include "appmessage.h"
+#include "xeqresultstore.h"
+#include "xeqvar.h"
+#include "xeqvaritem.h"
+
+// Standard include files
+#include <stdlib.h>
+#include <string.h>
+
+//------------------------------------------------------------------------------
+/*! \brief Result file identification and version.
+ */
+
+static const char ResultMagic[8] = { 'B', 'P', '6', 'R', 'S', 'L', 'T', 0 };
+static const int  ResultVersion = 1;
+
+//------------------------------------------------------------------------------
+/*! \struct EqResultHeader
+ *  \brief Fixed size result file header (72 bytes).
+ */
+
+struct EqResultHeader
+{
+    char m_magic[8];        //!< ResultMagic
+    int  m_version;         //!< ResultVersion
+    int  m_rows;            //!< Number of table rows
+    int  m_cols;            //!< Number of table columns
+    int  m_vars;            //!< Number of variable columns
+    int  m_strings;         //!< Number of string table entries
+    int  m_strBytes;        //!< Total bytes of string table text
+    int  m_rowName;         //!< String index of row var name, or -1
+    int  m_rowKind;         //!< Row var EqResultStore::Kind
+    int  m_rowUnits;        //!< String index of row var display units
+    int  m_colName;         //!< String index of col var name, or -1
+    int  m_colKind;         //!< Column var EqResultStore::Kind
+    int  m_colUnits;        //!< String index of col var display units
+    int  m_reserved[4];     //!< Pads the header to a multiple of 8 bytes
+};
+
+//------------------------------------------------------------------------------
+/*! \struct EqResultVarRec
+ *  \brief Variable dictionary entry (16 bytes).
+ */
+
+struct EqResultVarRec
+{
+    int m_name;             //!< String index of the variable name
+    int m_kind;             //!< EqResultStore::Kind
+    int m_units;            //!< String index of the display units
+    int m_reserved;         //!< Pads the record to 16 bytes
+};
+
+//------------------------------------------------------------------------------
+/*! \struct EqResultAxisRec
+ *  \brief Table row or column value record (16 bytes).
+ */
+
+struct EqResultAxisRec
+{
+    double m_value;         //!< Continuous display value
+    int    m_text;          //!< String index of discrete item name, or -1
+    int    m_reserved;      //!< Pads the record to 16 bytes
+};
+
+//------------------------------------------------------------------------------
+/*! \brief Rounds a byte count up to the next multiple of 8.
+ */
+
+static long align8( long bytes )
+{
+    return( ( bytes + 7L ) & ~7L );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Writes \a bytes bytes of \a data followed by enough zero bytes
+ *  to bring the section to an 8-byte boundary.
+ */
+
+static void writeAligned( FILE *fptr, const void *data, long bytes )
+{
+    static const char zero[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+    if ( bytes > 0 )
+    {
+        fwrite( data, 1, bytes, fptr );
+    }
+    long pad = align8( bytes ) - bytes;
+    if ( pad > 0 )
+    {
+        fwrite( zero, 1, pad, fptr );
+    }
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief EqResultStore default constructor.
+ */
+
+EqResultStore::EqResultStore( void ) :
+    m_fileName(""),
+    m_fptr(0),
+    m_rows(0),
+    m_cols(0),
+    m_cells(0),
+    m_vars(0),
+    m_rowVar(0),
+    m_colVar(0),
+    m_var(0),
+    m_rowName(-1),
+    m_rowKind(KindOther),
+    m_rowUnits(-1),
+    m_colName(-1),
+    m_colKind(KindOther),
+    m_colUnits(-1),
+    m_varName(0),
+    m_varKind(0),
+    m_varUnits(0),
+    m_rowValue(0),
+    m_rowText(0),
+    m_colValue(0),
+    m_colText(0),
+    m_dbl(0),
+    m_idx(0),
+    m_spill(0),
+    m_block(0),
+    m_cellBytes(0),
+    m_varOffset(0),
+    m_blockBuf(0),
+    m_strDict(0),
+    m_strWrite(0),
+    m_strings(0),
+    m_strAlloc(0),
+    m_str(0),
+    m_buffer(0)
+{
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief EqResultStore destructor.
+ *
+ *  Any result file still being written is completed and closed.
+ */
+
+EqResultStore::~EqResultStore( void )
+{
+    close();
+    reset();
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Adds \a str to the string table if it isn't already there.
+ *
+ *  \return Index of \a str in the string table.
+ */
+
+int EqResultStore::addString( const QString &str )
+{
+    int *id = m_strDict->find( str );
+    if ( id )
+    {
+        return( *id );
+    }
+    // Grow the string table if necessary
+    if ( m_strings == m_strAlloc )
+    {
+        int alloc = ( m_strAlloc ) ? 2 * m_strAlloc : 256;
+        char **strWrite = new char *[ alloc ];
+        checkmem( __FILE__, __LINE__, strWrite, "char *strWrite", alloc );
+        for ( int i = 0;
+              i < m_strings;
+              i++ )
+        {
+            strWrite[i] = m_strWrite[i];
+        }
+        delete[] m_strWrite;
+        m_strWrite = strWrite;
+        m_strAlloc = alloc;
+    }
+    const char *latin = str.latin1();
+    int len = ( latin ) ? strlen( latin ) : 0;
+    char *copy = new char[ len + 1 ];
+    checkmem( __FILE__, __LINE__, copy, "char copy", len + 1 );
+    if ( len )
+    {
+        memcpy( copy, latin, len );
+    }
+    copy[len] = 0;
+    m_strWrite[m_strings] = copy;
+    id = new int( m_strings );
+    checkmem( __FILE__, __LINE__, id, "int id", 1 );
+    m_strDict->insert( str, id );
+    return( m_strings++ );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Writes the accumulated columns to the result file and closes it.
+ *
+ *  Does nothing if the store is not being written.
+ *
+ *  \return TRUE on success, FALSE on a write error.
+ */
+
+bool EqResultStore::close( void )
+{
+    if ( ! m_fptr )
+    {
+        return( true );
+    }
+    // Spill the last (and any untouched) column blocks
+    int blocks = ( m_cells + EqResultStoreBlockCells - 1 )
+               / EqResultStoreBlockCells;
+    bool ok = flushBlocks( blocks );
+
+    // Header
+    EqResultHeader hdr;
+    memset( &hdr, 0, sizeof(hdr) );
+    memcpy( hdr.m_magic, ResultMagic, sizeof(hdr.m_magic) );
+    hdr.m_version  = ResultVersion;
+    hdr.m_rows     = m_rows;
+    hdr.m_cols     = m_cols;
+    hdr.m_vars     = m_vars;
+    hdr.m_strings  = m_strings;
+    hdr.m_strBytes = 0;
+    int str;
+    for ( str = 0;
+          str < m_strings;
+          str++ )
+    {
+        hdr.m_strBytes += strlen( m_strWrite[str] ) + 1;
+    }
+    hdr.m_rowName  = m_rowName;
+    hdr.m_rowKind  = m_rowKind;
+    hdr.m_rowUnits = m_rowUnits;
+    hdr.m_colName  = m_colName;
+    hdr.m_colKind  = m_colKind;
+    hdr.m_colUnits = m_colUnits;
+    writeAligned( m_fptr, &hdr, sizeof(hdr) );
+
+    // Variable dictionary
+    EqResultVarRec varRec;
+    int var;
+    for ( var = 0;
+          var < m_vars;
+          var++ )
+    {
+        varRec.m_name     = m_varName[var];
+        varRec.m_kind     = m_varKind[var];
+        varRec.m_units    = m_varUnits[var];
+        varRec.m_reserved = 0;
+        fwrite( &varRec, sizeof(varRec), 1, m_fptr );
+    }
+
+    // Row and column values
+    EqResultAxisRec axisRec;
+    axisRec.m_reserved = 0;
+    int id;
+    for ( id = 0;
+          id < m_rows;
+          id++ )
+    {
+        axisRec.m_value = m_rowValue[id];
+        axisRec.m_text  = m_rowText[id];
+        fwrite( &axisRec, sizeof(axisRec), 1, m_fptr );
+    }
+    for ( id = 0;
+          id < m_cols;
+          id++ )
+    {
+        axisRec.m_value = m_colValue[id];
+        axisRec.m_text  = m_colText[id];
+        fwrite( &axisRec, sizeof(axisRec), 1, m_fptr );
+    }
+
+    // Variable columns, copied one block at a time from the spill file
+    static const char zero[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+    int size, block, cells;
+    long bytes;
+    for ( var = 0;
+          var < m_vars;
+          var++ )
+    {
+        size = ( m_dbl[var] ) ? sizeof(double) : sizeof(int);
+        if ( ! m_dbl[var] && ! m_idx[var] )
+        {
+            continue;
+        }
+        for ( block = 0;
+              ok && block < blocks;
+              block++ )
+        {
+            cells = m_cells - block * EqResultStoreBlockCells;
+            if ( cells > EqResultStoreBlockCells )
+            {
+                cells = EqResultStoreBlockCells;
+            }
+            fseek( m_spill, (long) block * EqResultStoreBlockCells * m_cellBytes
+                + (long) EqResultStoreBlockCells * m_varOffset[var], SEEK_SET );
+            if ( fread( m_blockBuf, size, cells, m_spill ) != (size_t) cells )
+            {
+                ok = false;
+                break;
+            }
+            fwrite( m_blockBuf, size, cells, m_fptr );
+        }
+        bytes = (long) m_cells * size;
+        if ( align8( bytes ) > bytes )
+        {
+            fwrite( zero, 1, align8( bytes ) - bytes, m_fptr );
+        }
+    }
+
+    // String table offsets and text
+    int *offset = new int[ m_strings + 1 ];
+    checkmem( __FILE__, __LINE__, offset, "int offset", m_strings + 1 );
+    for ( offset[0] = 0, str = 0;
+          str < m_strings;
+          str++ )
+    {
+        offset[str+1] = offset[str] + strlen( m_strWrite[str] ) + 1;
+    }
+    writeAligned( m_fptr, offset, m_strings * sizeof(int) );
+    delete[] offset;
+    for ( str = 0;
+          str < m_strings;
+          str++ )
+    {
+        fwrite( m_strWrite[str], 1, strlen( m_strWrite[str] ) + 1, m_fptr );
+    }
+
+    // Close up shop
+    if ( ferror( m_fptr ) != 0 )
+    {
+        ok = false;
+    }
+    if ( fclose( m_fptr ) != 0 )
+    {
+        ok = false;
+    }
+    m_fptr = 0;
+    reset();
+    return( ok );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Returns the number of table columns.
+ */
+
+int EqResultStore::cols( void ) const
+{
+    return( m_cols );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Copies all the cell values of the continuous variable \a name
+ *  into the caller's \a values array, which must hold rows()*cols() doubles.
+ *
+ *  \return TRUE if \a name is a stored continuous variable,
+ *  FALSE otherwise (in which case \a values is unchanged).
+ */
+
+bool EqResultStore::column( const QString &name, double *values ) const
+{
+    int var = varIndex( name );
+    if ( var < 0 || ! m_dbl[var] )
+    {
+        return( false );
+    }
+    memcpy( values, m_dbl[var], m_cells * sizeof(double) );
+    return( true );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Convenience routine to convert a binary result file into the
+ *  BehavePlus5 text result format.
+ *
+ *  \param binaryFile Name of the binary result file to read.
+ *  \param textFile   Name of the text file to write.
+ *
+ *  \return TRUE on success, FALSE on failure.
+ */
+
+bool EqResultStore::convertToText( const QString &binaryFile,
+        const QString &textFile )
+{
+    EqResultStore store;
+    if ( ! store.open( binaryFile ) )
+    {
+        return( false );
+    }
+    FILE *fptr = fopen( textFile.latin1(), "w" );
+    if ( ! fptr )
+    {
+        return( false );
+    }
+    bool ok = store.writeText( fptr );
+    fclose( fptr );
+    return( ok );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Creates a new result file, its temporary spill file, and the
+ *  column block buffer.
+ *
+ *  \param fileName Name of the result file to create.
+ *  \param rows     Number of table rows.
+ *  \param cols     Number of table columns.
+ *  \param rowVar   Pointer to the row range EqVar (may be NULL).
+ *  \param colVar   Pointer to the column range EqVar (may be NULL).
+ *  \param var      Array of pointers to every EqVar to be stored.
+ *  \param vars     Size of the \a var array.
+ *
+ *  Called only by EqTree::resultFileInit().
+ *
+ *  \return TRUE on success, FALSE if the file could not be opened.
+ */
+
+bool EqResultStore::create( const QString &fileName, int rows, int cols,
+        EqVar *rowVar, EqVar *colVar, EqVar **var, int vars )
+{
+    close();
+    reset();
+
+    // Open the output file now so permission problems are caught early
+    m_fileName = fileName;
+    if ( ! ( m_fptr = fopen( m_fileName.latin1(), "wb" ) ) )
+    {
+        return( false );
+    }
+    setvbuf( m_fptr, 0, _IOFBF, 65536 );
+
+    m_rows   = rows;
+    m_cols   = cols;
+    m_cells  = rows * cols;
+    m_vars   = vars;
+    m_rowVar = rowVar;
+    m_colVar = colVar;
+    m_var    = var;
+    m_strDict = new QDict<int>( 1031 );
+    checkmem( __FILE__, __LINE__, m_strDict, "QDict<int> m_strDict", 1 );
+    m_strDict->setAutoDelete( true );
+
+    // Range variables
+    if ( m_rowVar )
+    {
+        m_rowName  = addString( m_rowVar->m_name );
+        m_rowKind  = varKind( m_rowVar );
+        m_rowUnits = addString( m_rowVar->m_displayUnits );
+    }
+    if ( m_colVar )
+    {
+        m_colName  = addString( m_colVar->m_name );
+        m_colKind  = varKind( m_colVar );
+        m_colUnits = addString( m_colVar->m_displayUnits );
+    }
+    m_rowValue = new double[ m_rows ];
+    checkmem( __FILE__, __LINE__, m_rowValue, "double m_rowValue", m_rows );
+    m_rowText = new int[ m_rows ];
+    checkmem( __FILE__, __LINE__, m_rowText, "int m_rowText", m_rows );
+    m_colValue = new double[ m_cols ];
+    checkmem( __FILE__, __LINE__, m_colValue, "double m_colValue", m_cols );
+    m_colText = new int[ m_cols ];
+    checkmem( __FILE__, __LINE__, m_colText, "int m_colText", m_cols );
+    int id;
+    for ( id = 0;
+          id < m_rows;
+          id++ )
+    {
+        m_rowValue[id] = 0.;
+        m_rowText[id]  = -1;
+    }
+    for ( id = 0;
+          id < m_cols;
+          id++ )
+    {
+        m_colValue[id] = 0.;
+        m_colText[id]  = -1;
+    }
+
+    // Variable dictionary and one column per continuous, discrete, or text var
+    m_varName = new int[ m_vars ];
+    checkmem( __FILE__, __LINE__, m_varName, "int m_varName", m_vars );
+    m_varKind = new int[ m_vars ];
+    checkmem( __FILE__, __LINE__, m_varKind, "int m_varKind", m_vars );
+    m_varUnits = new int[ m_vars ];
+    checkmem( __FILE__, __LINE__, m_varUnits, "int m_varUnits", m_vars );
+    m_dbl = new double *[ m_vars ];
+    checkmem( __FILE__, __LINE__, m_dbl, "double *m_dbl", m_vars );
+    m_idx = new int *[ m_vars ];
+    checkmem( __FILE__, __LINE__, m_idx, "int *m_idx", m_vars );
+    m_varOffset = new int[ m_vars ];
+    checkmem( __FILE__, __LINE__, m_varOffset, "int m_varOffset", m_vars );
+    m_cellBytes = 0;
+    for ( id = 0;
+          id < m_vars;
+          id++ )
+    {
+        m_varName[id]  = addString( m_var[id]->m_name );
+        m_varKind[id]  = varKind( m_var[id] );
+        m_varUnits[id] = ( m_varKind[id] == KindContinuous )
+                       ? addString( m_var[id]->m_displayUnits )
+                       : -1;
+        m_varOffset[id] = m_cellBytes;
+        if ( m_varKind[id] == KindContinuous )
+        {
+            m_cellBytes += sizeof(double);
+        }
+        else if ( m_varKind[id] == KindDiscrete
+               || m_varKind[id] == KindText )
+        {
+            m_cellBytes += sizeof(int);
+        }
+    }
+    // Each var's column block begins at a multiple of 8 bytes
+    // because EqResultStoreBlockCells is a multiple of 2.
+    int bufSize = EqResultStoreBlockCells * m_cellBytes;
+    if ( bufSize < 8 )
+    {
+        bufSize = 8;
+    }
+    m_blockBuf = new char[ bufSize ];
+    checkmem( __FILE__, __LINE__, m_blockBuf, "char m_blockBuf", bufSize );
+    memset( m_blockBuf, 0, bufSize );
+    for ( id = 0;
+          id < m_vars;
+          id++ )
+    {
+        m_dbl[id] = 0;
+        m_idx[id] = 0;
+        char *block = m_blockBuf + EqResultStoreBlockCells * m_varOffset[id];
+        if ( m_varKind[id] == KindContinuous )
+        {
+            m_dbl[id] = (double *) block;
+        }
+        else if ( m_varKind[id] == KindDiscrete
+               || m_varKind[id] == KindText )
+        {
+            m_idx[id] = (int *) block;
+        }
+    }
+    m_block = 0;
+    if ( ! ( m_spill = tmpfile() ) )
+    {
+        fclose( m_fptr );
+        m_fptr = 0;
+        reset();
+        return( false );
+    }
+    return( true );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Spills the current column block, and any untouched blocks before
+ *  \a block, to the temporary file, and makes \a block the current block.
+ *
+ *  Every block is spilled at its full size, so block \a n begins at byte
+ *  n * EqResultStoreBlockCells * m_cellBytes of the spill file.
+ *
+ *  \param block Index of the next block to be filled.
+ *
+ *  \return TRUE on success, FALSE on a write error.
+ */
+
+bool EqResultStore::flushBlocks( int block )
+{
+    if ( m_cellBytes == 0 )
+    {
+        m_block = block;
+        return( true );
+    }
+    int bytes = EqResultStoreBlockCells * m_cellBytes;
+    while ( m_block < block )
+    {
+        if ( fwrite( m_blockBuf, 1, bytes, m_spill ) != (size_t) bytes )
+        {
+            return( false );
+        }
+        memset( m_blockBuf, 0, bytes );
+        m_block++;
+    }
+    return( true );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Returns the storage kind of variable index \a var.
+ */
+
+int EqResultStore::kind( int var ) const
+{
+    return( ( var >= 0 && var < m_vars ) ? m_varKind[var] : KindOther );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Reads an entire binary result file into memory.
+ *
+ *  The file is read with a single fread() and the column arrays are
+ *  addressed in place, so opening a result file costs one I/O regardless
+ *  of the number of variables.
+ *
+ *  \return TRUE on success, FALSE if the file could not be read or is not
+ *  a valid result file.
+ */
+
+bool EqResultStore::open( const QString &fileName )
+{
+    close();
+    reset();
+
+    // Slurp the file
+    m_fileName = fileName;
+    FILE *fptr = fopen( m_fileName.latin1(), "rb" );
+    if ( ! fptr )
+    {
+        return( false );
+    }
+    fseek( fptr, 0L, SEEK_END );
+    long bytes = ftell( fptr );
+    fseek( fptr, 0L, SEEK_SET );
+    if ( bytes < (long) sizeof(EqResultHeader) )
+    {
+        fclose( fptr );
+        return( false );
+    }
+    m_buffer = new char[ bytes ];
+    checkmem( __FILE__, __LINE__, m_buffer, "char m_buffer", bytes );
+    long got = fread( m_buffer, 1, bytes, fptr );
+    fclose( fptr );
+
+    // Validate the header
+    EqResultHeader *hdr = (EqResultHeader *) m_buffer;
+    if ( got != bytes
+      || memcmp( hdr->m_magic, ResultMagic, sizeof(hdr->m_magic) ) != 0
+      || hdr->m_version != ResultVersion
+      || hdr->m_rows < 0 || hdr->m_cols < 0 || hdr->m_vars < 0
+      || hdr->m_strings < 0 || hdr->m_strBytes < 0
+      || (double) hdr->m_rows * (double) hdr->m_cols > 2147483647.
+      || (double) hdr->m_vars * sizeof(EqResultVarRec) > (double) bytes
+      || (double) hdr->m_strings * sizeof(int) > (double) bytes )
+    {
+        reset();
+        return( false );
+    }
+    m_rows     = hdr->m_rows;
+    m_cols     = hdr->m_cols;
+    m_cells    = m_rows * m_cols;
+    m_vars     = hdr->m_vars;
+    m_strings  = hdr->m_strings;
+    m_rowName  = hdr->m_rowName;
+    m_rowKind  = hdr->m_rowKind;
+    m_rowUnits = hdr->m_rowUnits;
+    m_colName  = hdr->m_colName;
+    m_colKind  = hdr->m_colKind;
+    m_colUnits = hdr->m_colUnits;
+    long pos = align8( sizeof(EqResultHeader) );
+
+    // Variable dictionary
+    long need = pos + (long) m_vars * sizeof(EqResultVarRec)
+              + ( (long) m_rows + m_cols ) * sizeof(EqResultAxisRec);
+    if ( need > bytes )
+    {
+        reset();
+        return( false );
+    }
+    m_varName  = new int[ m_vars ];
+    checkmem( __FILE__, __LINE__, m_varName, "int m_varName", m_vars );
+    m_varKind  = new int[ m_vars ];
+    checkmem( __FILE__, __LINE__, m_varKind, "int m_varKind", m_vars );
+    m_varUnits = new int[ m_vars ];
+    checkmem( __FILE__, __LINE__, m_varUnits, "int m_varUnits", m_vars );
+    int id;
+    for ( id = 0;
+          id < m_vars;
+          id++, pos += sizeof(EqResultVarRec) )
+    {
+        EqResultVarRec *rec = (EqResultVarRec *) ( m_buffer + pos );
+        m_varName[id]  = rec->m_name;
+        m_varKind[id]  = rec->m_kind;
+        m_varUnits[id] = rec->m_units;
+    }
+
+    // Row and column values
+    m_rowValue = new double[ m_rows ];
+    checkmem( __FILE__, __LINE__, m_rowValue, "double m_rowValue", m_rows );
+    m_rowText  = new int[ m_rows ];
+    checkmem( __FILE__, __LINE__, m_rowText, "int m_rowText", m_rows );
+    m_colValue = new double[ m_cols ];
+    checkmem( __FILE__, __LINE__, m_colValue, "double m_colValue", m_cols );
+    m_colText  = new int[ m_cols ];
+    checkmem( __FILE__, __LINE__, m_colText, "int m_colText", m_cols );
+    for ( id = 0;
+          id < m_rows;
+          id++, pos += sizeof(EqResultAxisRec) )
+    {
+        EqResultAxisRec *rec = (EqResultAxisRec *) ( m_buffer + pos );
+        m_rowValue[id] = rec->m_value;
+        m_rowText[id]  = rec->m_text;
+    }
+    for ( id = 0;
+          id < m_cols;
+          id++, pos += sizeof(EqResultAxisRec) )
+    {
+        EqResultAxisRec *rec = (EqResultAxisRec *) ( m_buffer + pos );
+        m_colValue[id] = rec->m_value;
+        m_colText[id]  = rec->m_text;
+    }
+
+    // Address the variable columns in place
+    m_dbl = new double *[ m_vars ];
+    checkmem( __FILE__, __LINE__, m_dbl, "double *m_dbl", m_vars );
+    m_idx = new int *[ m_vars ];
+    checkmem( __FILE__, __LINE__, m_idx, "int *m_idx", m_vars );
+    for ( id = 0;
+          id < m_vars;
+          id++ )
+    {
+        m_dbl[id] = 0;
+        m_idx[id] = 0;
+    }
+    for ( id = 0;
+          id < m_vars;
+          id++ )
+    {
+        if ( m_varKind[id] == KindContinuous )
+        {
+            need = align8( (long) m_cells * sizeof(double) );
+            if ( pos + need > bytes )
+            {
+                reset();
+                return( false );
+            }
+            m_dbl[id] = (double *) ( m_buffer + pos );
+            pos += need;
+        }
+        else if ( m_varKind[id] == KindDiscrete
+               || m_varKind[id] == KindText )
+        {
+            need = align8( (long) m_cells * sizeof(int) );
+            if ( pos + need > bytes )
+            {
+                reset();
+                return( false );
+            }
+            m_idx[id] = (int *) ( m_buffer + pos );
+            pos += need;
+        }
+    }
+
+    // String table; every offset must lie within the string text,
+    // which must end with a NUL so no string can run past it.
+    int *offset = (int *) ( m_buffer + pos );
+    int strBytes = hdr->m_strBytes;
+    pos += align8( (long) m_strings * sizeof(int) );
+    if ( pos + strBytes > bytes
+      || ( m_strings > 0
+        && ( strBytes == 0 || m_buffer[ pos + strBytes - 1 ] != 0 ) ) )
+    {
+        reset();
+        return( false );
+    }
+    m_str = new const char *[ m_strings + 1 ];
+    checkmem( __FILE__, __LINE__, m_str, "const char *m_str", m_strings + 1 );
+    for ( id = 0;
+          id < m_strings;
+          id++ )
+    {
+        if ( offset[id] < 0 || offset[id] >= strBytes )
+        {
+            reset();
+            return( false );
+        }
+        m_str[id] = m_buffer + pos + offset[id];
+    }
+    return( true );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Frees all the store's dynamic memory and resets its state.
+ */
+
+void EqResultStore::reset( void )
+{
+    int id;
+    // Column arrays point into the writer's m_blockBuf or the reader's m_buffer
+    if ( m_spill )
+    {
+        fclose( m_spill );
+        m_spill = 0;
+    }
+    delete[] m_blockBuf;    m_blockBuf = 0;
+    delete[] m_varOffset;   m_varOffset = 0;
+    m_block = m_cellBytes = 0;
+    delete[] m_dbl;         m_dbl = 0;
+    delete[] m_idx;         m_idx = 0;
+    delete[] m_varName;     m_varName = 0;
+    delete[] m_varKind;     m_varKind = 0;
+    delete[] m_varUnits;    m_varUnits = 0;
+    delete[] m_rowValue;    m_rowValue = 0;
+    delete[] m_rowText;     m_rowText = 0;
+    delete[] m_colValue;    m_colValue = 0;
+    delete[] m_colText;     m_colText = 0;
+    for ( id = 0;
+          m_strWrite && id < m_strings;
+          id++ )
+    {
+        delete[] m_strWrite[id];
+    }
+    delete[] m_strWrite;    m_strWrite = 0;
+    delete m_strDict;       m_strDict = 0;
+    delete[] m_str;         m_str = 0;
+    delete[] m_buffer;      m_buffer = 0;
+    m_rows = m_cols = m_cells = m_vars = m_strings = m_strAlloc = 0;
+    m_rowName = m_rowUnits = m_colName = m_colUnits = -1;
+    m_rowKind = m_colKind = KindOther;
+    m_rowVar = m_colVar = 0;
+    m_var = 0;
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Returns the number of table rows.
+ */
+
+int EqResultStore::rows( void ) const
+{
+    return( m_rows );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Returns string table entry \a id, or an empty string if \a id
+ *  is out of range (as in a damaged result file).
+ */
+
+const char *EqResultStore::string( int id ) const
+{
+    if ( id < 0 || id >= m_strings )
+    {
+        return( "" );
+    }
+    return( ( m_buffer ) ? m_str[id] : m_strWrite[id] );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Stores the current values of every variable for table cell
+ *  \a row, \a col.
+ *
+ *  Called only by EqTree::runTable() after all the cell's outputs have been
+ *  calculated.
+ */
+
+void EqResultStore::storeCell( int row, int col )
+{
+    if ( ! m_fptr )
+    {
+        return;
+    }
+    int cell = col + row * m_cols;
+    int block = cell / EqResultStoreBlockCells;
+    if ( block < m_block )
+    {
+        // This cell's block has already been spilled
+        return;
+    }
+    if ( block > m_block )
+    {
+        flushBlocks( block );
+    }
+    cell -= block * EqResultStoreBlockCells;
+    EqVar *varPtr;
+    int iid;
+    for ( int var = 0;
+          var < m_vars;
+          var++ )
+    {
+        varPtr = m_var[var];
+        if ( m_varKind[var] == KindContinuous )
+        {
+            m_dbl[var][cell] = varPtr->m_displayValue;
+        }
+        else if ( m_varKind[var] == KindDiscrete )
+        {
+            iid = varPtr->m_itemList->itemIdWithName(
+                varPtr->activeItemName() );
+            m_idx[var][cell] = addString( varPtr->getItemName( iid ) );
+        }
+        else if ( m_varKind[var] == KindText )
+        {
+            m_idx[var][cell] = addString( varPtr->m_store );
+        }
+    }
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Stores the current value of the column range variable for
+ *  table column \a col.
+ */
+
+void EqResultStore::storeCol( int col )
+{
+    if ( ! m_fptr || ! m_colVar )
+    {
+        return;
+    }
+    if ( m_colKind == KindDiscrete )
+    {
+        int iid = m_colVar->m_itemList->itemIdWithName(
+            m_colVar->activeItemName() );
+        m_colText[col] = addString( m_colVar->getItemName( iid ) );
+    }
+    else if ( m_colKind == KindContinuous )
+    {
+        m_colValue[col] = m_colVar->m_displayValue;
+    }
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Stores the current value of the row range variable for
+ *  table row \a row.
+ */
+
+void EqResultStore::storeRow( int row )
+{
+    if ( ! m_fptr || ! m_rowVar )
+    {
+        return;
+    }
+    if ( m_rowKind == KindDiscrete )
+    {
+        int iid = m_rowVar->m_itemList->itemIdWithName(
+            m_rowVar->activeItemName() );
+        m_rowText[row] = addString( m_rowVar->getItemName( iid ) );
+    }
+    else if ( m_rowKind == KindContinuous )
+    {
+        m_rowValue[row] = m_rowVar->m_displayValue;
+    }
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Returns the discrete item name or text value of variable \a var
+ *  at table cell \a row, \a col, or an empty string.
+ */
+
+const char *EqResultStore::text( int row, int col, int var ) const
+{
+    if ( ! m_buffer || var < 0 || var >= m_vars || ! m_idx[var]
+      || row < 0 || row >= m_rows || col < 0 || col >= m_cols )
+    {
+        return( "" );
+    }
+    return( string( m_idx[var][ col + row * m_cols ] ) );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Returns the display units of continuous variable \a var,
+ *  or an empty string.
+ */
+
+const char *EqResultStore::units( int var ) const
+{
+    if ( var < 0 || var >= m_vars )
+    {
+        return( "" );
+    }
+    return( string( m_varUnits[var] ) );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Returns the display value of continuous variable \a var
+ *  at table cell \a row, \a col, or 0. if it is not continuous.
+ */
+
+double EqResultStore::value( int row, int col, int var ) const
+{
+    if ( ! m_buffer || var < 0 || var >= m_vars || ! m_dbl[var]
+      || row < 0 || row >= m_rows || col < 0 || col >= m_cols )
+    {
+        return( 0. );
+    }
+    return( m_dbl[var][ col + row * m_cols ] );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Returns the storage kind of the passed EqVar.
+ */
+
+int EqResultStore::varKind( EqVar *varPtr ) const
+{
+    if ( varPtr->isDiscrete() )
+    {
+        return( KindDiscrete );
+    }
+    else if ( varPtr->isContinuous() )
+    {
+        return( KindContinuous );
+    }
+    else if ( varPtr->isText() )
+    {
+        return( KindText );
+    }
+    return( KindOther );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Returns the index of variable \a name, or -1 if not stored.
+ */
+
+int EqResultStore::varIndex( const QString &name ) const
+{
+    const char *latin = name.latin1();
+    for ( int var = 0;
+          var < m_vars;
+          var++ )
+    {
+        if ( strcmp( varName( var ), latin ) == 0 )
+        {
+            return( var );
+        }
+    }
+    return( -1 );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Returns the name of variable index \a var.
+ */
+
+const char *EqResultStore::varName( int var ) const
+{
+    if ( var < 0 || var >= m_vars )
+    {
+        return( "" );
+    }
+    return( string( m_varName[var] ) );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Returns the number of stored variables.
+ */
+
+int EqResultStore::vars( void ) const
+{
+    return( m_vars );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Writes a single ROW or COL line in the text result format.
+ */
+
+void EqResultStore::writeAxisText( FILE *fptr, const char *tag, int id,
+        int nameId, int kind, int unitsId, double value, int textId ) const
+{
+    if ( kind == KindDiscrete )
+    {
+        fprintf( fptr, "%s %d %s disc %s\n", tag, id,
+            string( nameId ), string( textId ) );
+    }
+    else if ( kind == KindContinuous )
+    {
+        fprintf( fptr, "%s %d %s cont %g %s\n", tag, id,
+            string( nameId ), value, string( unitsId ) );
+    }
+    else
+    {
+        fprintf( fptr, "%s %d %s othr\n", tag, id, string( nameId ) );
+    }
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Writes the opened result file in the BehavePlus5 text format
+ *  ("ROWS", "ROW", "COL", and "CELL" lines) to \a fptr.
+ *
+ *  \return TRUE on success, FALSE if no result file is open.
+ */
+
+bool EqResultStore::writeText( FILE *fptr ) const
+{
+    if ( ! m_buffer )
+    {
+        return( false );
+    }
+    fprintf( fptr, "ROWS %d COLS %d VARS %d\n", m_rows, m_cols, m_vars );
+    int row, col, var, cell;
+    for ( row = 0;
+          row < m_rows;
+          row++ )
+    {
+        if ( m_rowName >= 0 )
+        {
+            writeAxisText( fptr, "ROW", row+1, m_rowName, m_rowKind,
+                m_rowUnits, m_rowValue[row], m_rowText[row] );
+        }
+        for ( col = 0;
+              col < m_cols;
+              col++ )
+        {
+            if ( m_colName >= 0 )
+            {
+                writeAxisText( fptr, "COL", col+1, m_colName, m_colKind,
+                    m_colUnits, m_colValue[col], m_colText[col] );
+            }
+            cell = col + row * m_cols;
+            for ( var = 0;
+                  var < m_vars;
+                  var++ )
+            {
+                if ( m_varKind[var] == KindDiscrete )
+                {
+                    fprintf( fptr, "CELL %d %d %s disc %s\n",
+                        row+1, col+1, varName( var ),
+                        string( m_idx[var][cell] ) );
+                }
+                else if ( m_varKind[var] == KindContinuous )
+                {
+                    fprintf( fptr, "CELL %d %d %s cont %g %s\n",
+                        row+1, col+1, varName( var ), m_dbl[var][cell],
+                        units( var ) );
+                }
+                else if ( m_varKind[var] == KindText )
+                {
+                    fprintf( fptr, "CELL %d %d %s text %s\n",
+                        row+1, col+1, varName( var ),
+                        string( m_idx[var][cell] ) );
+                }
+                else
+                {
+                    fprintf( fptr, "CELL %d %d %s othr\n",
+                        row+1, col+1, varName( var ) );
+                }
+            }
+        }
+    }
+    return( ferror( fptr ) == 0 );
+}
+
+//------------------------------------------------------------------------------
+//  End of xeqresultstore.cpp
+//------------------------------------------------------------------------------
+
@@ -0,0 +1,156 @@
+//------------------------------------------------------------------------------
+/*! \file xeqresultstore.h
+ *  \version BehavePlus6
+ *  \author Copyright (C) 2002-2018 by Collin D. Bevins.  All rights reserved.
+ *
+ *  \brief Columnar binary EqTree run result store class definitions.
+ */
+
+#ifndef _XEQRESULTSTORE_H_
+/*! \def _XEQRESULTSTORE_H_
+ *  \brief Prevent redundant includes.
+ */
+#define _XEQRESULTSTORE_H_ 1
+
+// Custom class references
+class EqVar;
+
+// Qt class references
+#include <qdict.h>
+#include <qstring.h>
+
+// Standard include files
+#include <stdio.h>
+
+//------------------------------------------------------------------------------
+/*! \enum EqResultStoreSize
+ *  \brief EqResultStore limits.
+ */
+
+enum EqResultStoreSize
+{
+    EqResultStoreBlockCells = 1024  //!< Cells per spilled column block
+};
+
+//------------------------------------------------------------------------------
+/*! \class EqResultStore xeqresultstore.h
+ *
+ *  \brief Writes and reads the columnar binary result file produced by
+ *  EqTree::runTable().
+ *
+ *  The file is laid out as (all values in native byte order):
+ *      -# a fixed size EqResultHeader,
+ *      -# the variable dictionary, one EqResultVarRec per EqVar,
+ *      -# one EqResultAxisRec per table row, then one per table column,
+ *      -# each EqVar's column of \a rows * \a cols values in cell order
+ *         ( cell = col + row * cols ); continuous variables are stored as
+ *         doubles, discrete and text variables as 32-bit string table
+ *         indices, and other variables have no column at all,
+ *      -# the string table offsets and the NUL-terminated strings.
+ *  Every section begins on an 8-byte boundary so the reader can address
+ *  the double columns directly within its file buffer.
+ */
+
+class EqResultStore
+{
+// Public enums
+public:
+    /*! \enum Kind
+     *  \brief Storage kind of each variable column.
+     */
+    enum Kind
+    {
+        KindOther=0,        //!< No values stored ("othr")
+        KindContinuous=1,   //!< Display values stored as doubles ("cont")
+        KindDiscrete=2,     //!< Active item names stored as strings ("disc")
+        KindText=3          //!< Text stores stored as strings ("text")
+    };
+
+// Public methods
+public:
+    EqResultStore( void ) ;
+    ~EqResultStore( void ) ;
+
+    // Writer methods called only by EqTree
+    bool   close( void ) ;
+    bool   create( const QString &fileName, int rows, int cols,
+                EqVar *rowVar, EqVar *colVar, EqVar **var, int vars ) ;
+    void   storeCell( int row, int col ) ;
+    void   storeCol( int col ) ;
+    void   storeRow( int row ) ;
+
+    // Reader methods
+    int    cols( void ) const ;
+    bool   column( const QString &name, double *values ) const ;
+    int    kind( int var ) const ;
+    bool   open( const QString &fileName ) ;
+    int    rows( void ) const ;
+    const char *text( int row, int col, int var ) const ;
+    const char *units( int var ) const ;
+    double value( int row, int col, int var ) const ;
+    const char *varName( int var ) const ;
+    int    varIndex( const QString &name ) const ;
+    int    vars( void ) const ;
+    bool   writeText( FILE *fptr ) const ;
+
+    static bool convertToText( const QString &binaryFile,
+                    const QString &textFile ) ;
+
+// Protected methods
+protected:
+    int    addString( const QString &str ) ;
+    bool   flushBlocks( int block ) ;
+    void   reset( void ) ;
+    const char *string( int id ) const ;
+    int    varKind( EqVar *varPtr ) const ;
+    void   writeAxisText( FILE *fptr, const char *tag, int id,
+                int nameId, int kind, int unitsId, double value,
+                int textId ) const ;
+
+// Protected data members
+protected:
+    QString     m_fileName;     //!< Name of the result file
+    FILE       *m_fptr;         //!< Output stream while writing
+    int         m_rows;         //!< Number of table rows
+    int         m_cols;         //!< Number of table columns
+    int         m_cells;        //!< m_rows * m_cols
+    int         m_vars;         //!< Number of variable columns
+    EqVar      *m_rowVar;       //!< Row range variable (writer only)
+    EqVar      *m_colVar;       //!< Column range variable (writer only)
+    EqVar     **m_var;          //!< SHARED array of EqVar ptrs (writer only)
+    int         m_rowName;      //!< String index of row var name, or -1
+    int         m_rowKind;      //!< Row var kind
+    int         m_rowUnits;     //!< String index of row var units
+    int         m_colName;      //!< String index of col var name, or -1
+    int         m_colKind;      //!< Column var kind
+    int         m_colUnits;     //!< String index of col var units
+    int        *m_varName;      //!< Array of var name string indices
+    int        *m_varKind;      //!< Array of var kinds
+    int        *m_varUnits;     //!< Array of var units string indices
+    double     *m_rowValue;     //!< Array of row continuous values
+    int        *m_rowText;      //!< Array of row discrete item string indices
+    double     *m_colValue;     //!< Array of column continuous values
+    int        *m_colText;      //!< Array of column discrete item string indices
+    double    **m_dbl;          //!< Array of continuous var columns (or blocks)
+    int       **m_idx;          //!< Array of discrete/text var columns (or blocks)
+    // Column block spill (writer only)
+    FILE       *m_spill;        //!< Temporary file of full column blocks
+    int         m_block;        //!< Index of the block being filled
+    int         m_cellBytes;    //!< Bytes stored per cell for all vars
+    int        *m_varOffset;    //!< Array of var byte offsets within a cell
+    char       *m_blockBuf;     //!< Current block of every var column
+    // String table
+    QDict<int> *m_strDict;      //!< String table lookup (writer only)
+    char      **m_strWrite;     //!< String table contents (writer only)
+    int         m_strings;      //!< Number of strings in the string table
+    int         m_strAlloc;     //!< Allocated size of m_strWrite[]
+    const char **m_str;         //!< String table pointers (reader only)
+    char       *m_buffer;       //!< Entire file contents (reader only)
+};
+
+#endif
+
+//------------------------------------------------------------------------------
+//  End of xeqresultstore.h
+//------------------------------------------------------------------------------
+
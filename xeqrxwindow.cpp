@@ -0,0 +1,530 @@
+//------------------------------------------------------------------------------
+/*! \file xeqrxwindow.cpp
+ *  \version BehavePlus6
+ *  \author Copyright (C) 2002-2018 by Collin D. Bevins.  All rights reserved.
+ *
+ *  \brief EqTree adaptive prescription window search class methods.
+ */
+
+// Custom include files
+#include "appmessage.h"
+#include "apptranslator.h"
+#include "rxvar.h"
+#include "xeqrxwindow.h"
+#include "xeqtree.h"
+#include "xeqvar.h"
+
+// Qt include files
+#include <qapplication.h>
+#include <qprogressdialog.h>
+
+//------------------------------------------------------------------------------
+/*! \brief EqRxWindow constructor.
+ *
+ *  \param eqTree Pointer to the EqTree to be run.  Its worksheet inputs must
+ *  have been stored by BpDocument::validateWorksheet() and its range case
+ *  determined by EqTree::rangeCase().
+ */
+
+EqRxWindow::EqRxWindow( EqTree *eqTree ) :
+    m_eqTree(eqTree),
+    m_error(""),
+    m_dims(0),
+    m_steps(0),
+    m_rxVars(0),
+    m_rxVar(0),
+    m_code(0),
+    m_done(0),
+    m_evaluations(0),
+    m_area(0),
+    m_insideArea(0),
+    m_boundaryArea(0),
+    m_out(0),
+    m_progress(0)
+{
+    m_dimVar[0] = m_dimVar[1] = 0;
+    m_dimMin[0] = m_dimMin[1] = m_dimMax[0] = m_dimMax[1] = 0.;
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief EqRxWindow destructor.
+ */
+
+EqRxWindow::~EqRxWindow( void )
+{
+    reset();
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Access to the fraction of the searched region that lies in
+ *  boundary boxes.
+ *
+ *  \return Fraction (0-1) of the searched region in boundary boxes.
+ */
+
+double EqRxWindow::boundaryFraction( void ) const
+{
+    return( ( m_area > 0 ) ? (double) m_boundaryArea / (double) m_area : 0. );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Determines whether a box is entirely within prescription,
+ *  entirely out of prescription, or mixed, from its corner points.
+ *
+ *  \param i0 Row lattice index of the box's low edge.
+ *  \param i1 Row lattice index of the box's high edge.
+ *  \param j0 Column lattice index of the box's low edge.
+ *  \param j1 Column lattice index of the box's high edge.
+ *
+ *  \return EqRxWindowInside, EqRxWindowOutside, or EqRxWindowBoundary
+ *  if the corners are mixed.
+ */
+
+int EqRxWindow::boxStatus( int i0, int i1, int j0, int j1 )
+{
+    const signed char *corner[4];
+    corner[0] = point( i0, j0 );
+    corner[1] = point( i1, j0 );
+    corner[2] = point( i0, j1 );
+    corner[3] = point( i1, j1 );
+    bool inside = true;
+    for ( int rx = 0;
+          rx < m_rxVars;
+          rx++ )
+    {
+        // All corners out of this RxVar's range for the same reason?
+        signed char code = corner[0][rx];
+        int k;
+        for ( k = 1;
+              k < 4 && corner[k][rx] == code;
+              k++ )
+        {
+            // Empty
+        }
+        if ( k == 4 && code != 0 )
+        {
+            return( EqRxWindowOutside );
+        }
+        if ( k < 4 || code != 0 )
+        {
+            inside = false;
+        }
+    }
+    return( inside ? EqRxWindowInside : EqRxWindowBoundary );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Access to the number of points a dense table of the same
+ *  resolution would have evaluated.
+ *
+ *  \return Number of lattice points.
+ */
+
+int EqRxWindow::denseEvaluations( void ) const
+{
+    return( ( m_dims == 2 )
+        ? ( m_steps + 1 ) * ( m_steps + 1 )
+        : m_steps + 1 );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Access to the last error message.
+ *
+ *  \return Description of the last error, or an empty string.
+ */
+
+const QString &EqRxWindow::error( void ) const
+{
+    return( m_error );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Access to the number of points evaluated by the last run().
+ *
+ *  \return Number of points evaluated.
+ */
+
+int EqRxWindow::evaluations( void ) const
+{
+    return( m_evaluations );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Access to the fraction of the searched region that is within
+ *  prescription.
+ *
+ *  \return Fraction (0-1) of the searched region within prescription.
+ */
+
+double EqRxWindow::insideFraction( void ) const
+{
+    return( ( m_area > 0 ) ? (double) m_insideArea / (double) m_area : 0. );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Evaluates a lattice point (if not already evaluated).
+ *
+ *  Each active RxVar's code is 0 if within prescription, -1 if below its
+ *  minimum, +1 if above its maximum, or (for discrete RxVars) 2 plus the
+ *  index of its unacceptable item.
+ *
+ *  \param i Row lattice index.
+ *  \param j Column lattice index.
+ *
+ *  \return Pointer to the point's m_rxVars codes.
+ */
+
+const signed char *EqRxWindow::point( int i, int j )
+{
+    int idx = i * ( ( m_dims == 2 ) ? m_steps + 1 : 1 ) + j;
+    signed char *code = &m_code[ idx * m_rxVars ];
+    if ( m_done[idx] )
+    {
+        return( code );
+    }
+    m_dimVar[0]->setDisplayValue( value( 0, i ) );
+    if ( m_dims == 2 )
+    {
+        m_dimVar[1]->setDisplayValue( value( 1, j ) );
+    }
+    RxVar *rxVar;
+    EqVar *var;
+    for ( int rx = 0;
+          rx < m_rxVars;
+          rx++ )
+    {
+        rxVar = m_rxVar[rx];
+        var = rxVar->m_varPtr;
+        m_eqTree->calculateVariable( var, 0 );
+        if ( rxVar->isContinuous() )
+        {
+            code[rx] = ( var->m_nativeValue < rxVar->m_nativeMinimum )
+                ? -1
+                : ( ( var->m_nativeValue > rxVar->m_nativeMaximum ) ? 1 : 0 );
+        }
+        else
+        {
+            int item = var->activeItemDataIndex();
+            code[rx] = rxVar->itemChecked( item ) ? 0 : 2 + item;
+        }
+    }
+    m_done[idx] = true;
+    m_evaluations++;
+    return( code );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Determines whether a lattice point is within prescription.
+ *
+ *  \param i Row lattice index.
+ *  \param j Column lattice index.
+ *
+ *  \return TRUE if every active RxVar is within its range at the point.
+ */
+
+bool EqRxWindow::pointInside( int i, int j )
+{
+    const signed char *code = point( i, j );
+    for ( int rx = 0;
+          rx < m_rxVars;
+          rx++ )
+    {
+        if ( code[rx] )
+        {
+            return( false );
+        }
+    }
+    return( true );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Releases all memory and returns the EqRxWindow to its initial
+ *  state.
+ */
+
+void EqRxWindow::reset( void )
+{
+    delete[] m_rxVar;   m_rxVar = 0;
+    delete[] m_code;    m_code = 0;
+    delete[] m_done;    m_done = 0;
+    delete m_progress;  m_progress = 0;
+    if ( m_out )
+    {
+        fclose( m_out );
+        m_out = 0;
+    }
+    m_dims = m_steps = m_rxVars = 0;
+    m_evaluations = m_area = m_insideArea = m_boundaryArea = 0;
+    m_dimVar[0] = m_dimVar[1] = 0;
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Searches the table's row and column input ranges for the region
+ *  within all the active output prescriptions.
+ *
+ *  \param depth        Maximum number of bisections along each axis
+ *                      (EqRxWindowMinDepth - EqRxWindowMaxDepth).
+ *  \param resultFile   Name of the comma-separated result file to write.
+ *
+ *  \return TRUE on success, FALSE on failure (see error()) or if the user
+ *  cancelled.
+ */
+
+bool EqRxWindow::run( int depth, const QString &resultFile )
+{
+    reset();
+    m_error = "";
+    // The row and column variables span the searched region
+    if ( m_eqTree->m_rangeVars < 1
+      || m_eqTree->m_rangeVars > 2 )
+    {
+        translate( m_error, "EqRxWindow:RangeVars" );
+        return( false );
+    }
+    if ( ! m_eqTree->runInit( false ) )
+    {
+        return( false );
+    }
+    m_dims = m_eqTree->m_rangeVars;
+    int dim, k;
+    for ( dim = 0;
+          dim < m_dims;
+          dim++ )
+    {
+        m_dimVar[dim] = m_eqTree->m_rangeVar[dim];
+        if ( ! m_dimVar[dim]->isContinuous() )
+        {
+            translate( m_error, "EqRxWindow:Discrete",
+                *(m_dimVar[dim]->m_label) );
+            reset();
+            m_eqTree->runClean();
+            return( false );
+        }
+        double *val = ( dim == 0 ) ? m_eqTree->m_tableRow : m_eqTree->m_tableCol;
+        int vals = ( dim == 0 ) ? m_eqTree->m_tableRows : m_eqTree->m_tableCols;
+        m_dimMin[dim] = m_dimMax[dim] = val[0];
+        for ( k = 1;
+              k < vals;
+              k++ )
+        {
+            if ( val[k] < m_dimMin[dim] )
+            {
+                m_dimMin[dim] = val[k];
+            }
+            if ( val[k] > m_dimMax[dim] )
+            {
+                m_dimMax[dim] = val[k];
+            }
+        }
+    }
+    // Get the active output prescription variables
+    RxVar *rxVar;
+    for ( rxVar = m_eqTree->m_rxVarList->first();
+          rxVar;
+          rxVar = m_eqTree->m_rxVarList->next() )
+    {
+        if ( rxVar->m_isActive
+          && rxVar->m_varPtr->m_isUserOutput )
+        {
+            m_rxVars++;
+        }
+    }
+    if ( m_rxVars == 0 )
+    {
+        translate( m_error, "EqRxWindow:NoRxVars" );
+        reset();
+        m_eqTree->runClean();
+        return( false );
+    }
+    m_rxVar = new RxVar *[ m_rxVars ];
+    checkmem( __FILE__, __LINE__, m_rxVar, "RxVar *m_rxVar", m_rxVars );
+    int rx = 0;
+    for ( rxVar = m_eqTree->m_rxVarList->first();
+          rxVar;
+          rxVar = m_eqTree->m_rxVarList->next() )
+    {
+        if ( rxVar->m_isActive
+          && rxVar->m_varPtr->m_isUserOutput )
+        {
+            m_rxVar[rx++] = rxVar;
+        }
+    }
+    // Create the point lattice
+    if ( depth < EqRxWindowMinDepth )
+    {
+        depth = EqRxWindowMinDepth;
+    }
+    if ( depth > EqRxWindowMaxDepth )
+    {
+        depth = EqRxWindowMaxDepth;
+    }
+    m_steps = 1 << depth;
+    int points = denseEvaluations();
+    m_code = new signed char[ points * m_rxVars ];
+    checkmem( __FILE__, __LINE__, m_code, "signed char m_code",
+        points * m_rxVars );
+    m_done = new bool[ points ];
+    checkmem( __FILE__, __LINE__, m_done, "bool m_done", points );
+    for ( k = 0;
+          k < points;
+          k++ )
+    {
+        m_done[k] = false;
+    }
+
+    // Write the result file header
+    if ( ! ( m_out = fopen( resultFile.latin1(), "w" ) ) )
+    {
+        translate( m_error, "EqRxWindow:CreateError", resultFile );
+        reset();
+        m_eqTree->runClean();
+        return( false );
+    }
+    QString from(""), thru(""), status("");
+    translate( from, "EqRxWindow:From" );
+    translate( thru, "EqRxWindow:Thru" );
+    translate( status, "EqRxWindow:Status" );
+    translate( m_statusText[EqRxWindowOutside], "EqRxWindow:Outside" );
+    translate( m_statusText[EqRxWindowInside], "EqRxWindow:Inside" );
+    translate( m_statusText[EqRxWindowBoundary], "EqRxWindow:Boundary" );
+    for ( dim = 0;
+          dim < m_dims;
+          dim++ )
+    {
+        fprintf( m_out, "\"%s %s %s\",\"%s %s %s\",",
+            (*(m_dimVar[dim]->m_label)).latin1(),
+            m_dimVar[dim]->displayUnits( true ).latin1(), from.latin1(),
+            (*(m_dimVar[dim]->m_label)).latin1(),
+            m_dimVar[dim]->displayUnits( true ).latin1(), thru.latin1() );
+    }
+    fprintf( m_out, "\"%s\"\n", status.latin1() );
+
+    // Set up the progress dialog.
+    QString caption(""), button("");
+    translate( caption, "EqRxWindow:Progress:Caption",
+        QString( "%1" ).arg( m_dims ), QString( "%1" ).arg( m_rxVars ) );
+    translate( button, "EqTree:RunTable:Progress:Button" );
+    int area = ( m_dims == 2 ) ? m_steps * m_steps : m_steps;
+    m_progress = new QProgressDialog( caption, button, area );
+    Q_CHECK_PTR( m_progress );
+    m_progress->setMinimumDuration( 0 );
+    m_progress->setProgress( 0 );
+
+    // Search the whole region
+    bool ok = search( 0, m_steps, 0, ( m_dims == 2 ) ? m_steps : 0 );
+    if ( ferror( m_out ) && ok )
+    {
+        translate( m_error, "EqRxWindow:CreateError", resultFile );
+        ok = false;
+    }
+    fclose( m_out );
+    m_out = 0;
+    delete m_progress;  m_progress = 0;
+    m_eqTree->runClean();
+    return( ok );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Accepts a box whose corners (and center) agree, or bisects it
+ *  along each axis and searches the halves (or quarters).
+ *
+ *  \param i0 Row lattice index of the box's low edge.
+ *  \param i1 Row lattice index of the box's high edge.
+ *  \param j0 Column lattice index of the box's low edge.
+ *  \param j1 Column lattice index of the box's high edge.
+ *
+ *  \return FALSE if the user cancelled.
+ */
+
+bool EqRxWindow::search( int i0, int i1, int j0, int j1 )
+{
+    int status = boxStatus( i0, i1, j0, j1 );
+    int im = ( i0 + i1 ) / 2;
+    int jm = ( j0 + j1 ) / 2;
+    if ( i1 - i0 <= 1 )
+    {
+        // Smallest box, so accept it whatever its status
+        writeBox( i0, i1, j0, j1, status );
+        return( ! m_progress->wasCancelled() );
+    }
+    if ( status != EqRxWindowBoundary
+      && pointInside( im, jm ) == ( status == EqRxWindowInside ) )
+    {
+        writeBox( i0, i1, j0, j1, status );
+        return( ! m_progress->wasCancelled() );
+    }
+    // Otherwise bisect the box
+    if ( m_dims == 2 )
+    {
+        return( search( i0, im, j0, jm )
+             && search( im, i1, j0, jm )
+             && search( i0, im, jm, j1 )
+             && search( im, i1, jm, j1 ) );
+    }
+    return( search( i0, im, j0, j1 )
+         && search( im, i1, j0, j1 ) );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Determines an input value at a lattice index.
+ *
+ *  \param dim      Input dimension (0 for the row, 1 for the column).
+ *  \param index    Lattice index (0 - m_steps).
+ *
+ *  \return Input value (display units).
+ */
+
+double EqRxWindow::value( int dim, int index ) const
+{
+    return( m_dimMin[dim]
+        + ( m_dimMax[dim] - m_dimMin[dim] ) * index / (double) m_steps );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Writes an accepted box to the result file and updates the
+ *  search progress.
+ *
+ *  \param i0       Row lattice index of the box's low edge.
+ *  \param i1       Row lattice index of the box's high edge.
+ *  \param j0       Column lattice index of the box's low edge.
+ *  \param j1       Column lattice index of the box's high edge.
+ *  \param status   EqRxWindowInside, EqRxWindowOutside, or
+ *                  EqRxWindowBoundary.
+ */
+
+void EqRxWindow::writeBox( int i0, int i1, int j0, int j1, int status )
+{
+    int area = ( m_dims == 2 ) ? ( i1 - i0 ) * ( j1 - j0 ) : i1 - i0;
+    m_area += area;
+    if ( status == EqRxWindowInside )
+    {
+        m_insideArea += area;
+    }
+    else if ( status == EqRxWindowBoundary )
+    {
+        m_boundaryArea += area;
+    }
+    int decimals = m_dimVar[0]->m_displayDecimals + 2;
+    fprintf( m_out, "%1.*f,%1.*f,", decimals, value( 0, i0 ),
+        decimals, value( 0, i1 ) );
+    if ( m_dims == 2 )
+    {
+        decimals = m_dimVar[1]->m_displayDecimals + 2;
+        fprintf( m_out, "%1.*f,%1.*f,", decimals, value( 1, j0 ),
+            decimals, value( 1, j1 ) );
+    }
+    fprintf( m_out, "\"%s\"\n", m_statusText[status].latin1() );
+
+    // Update progress dialog.
+    m_progress->setProgress( m_area );
+    qApp->processEvents();
+    return;
+}
+
+//------------------------------------------------------------------------------
+//  End of xeqrxwindow.cpp
+//------------------------------------------------------------------------------
+
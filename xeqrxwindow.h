@@ -0,0 +1,126 @@
+//------------------------------------------------------------------------------
+/*! \file xeqrxwindow.h
+ *  \version BehavePlus6
+ *  \author Copyright (C) 2002-2018 by Collin D. Bevins.  All rights reserved.
+ *
+ *  \brief EqTree adaptive prescription window search class definitions.
+ */
+
+#ifndef _XEQRXWINDOW_H_
+/*! \def _XEQRXWINDOW_H_
+ *  \brief Prevent redundant includes.
+ */
+#define _XEQRXWINDOW_H_ 1
+
+// Custom class references
+class EqTree;
+class EqVar;
+class RxVar;
+
+// Qt class references
+#include <qstring.h>
+class QProgressDialog;
+
+// Standard include files
+#include <stdio.h>
+
+//------------------------------------------------------------------------------
+/*! \enum EqRxWindowSize
+ *  \brief EqRxWindow limits.
+ */
+
+enum EqRxWindowSize
+{
+    EqRxWindowMinDepth = 1,     //!< Minimum number of box bisections
+    EqRxWindowMaxDepth = 10     //!< Maximum number of box bisections
+};
+
+//------------------------------------------------------------------------------
+/*! \enum EqRxWindowStatus
+ *  \brief Prescription status of an EqRxWindow search box.
+ */
+
+enum EqRxWindowStatus
+{
+    EqRxWindowOutside  = 0,     //!< Box is entirely out of prescription
+    EqRxWindowInside   = 1,     //!< Box is entirely within prescription
+    EqRxWindowBoundary = 2      //!< Smallest box containing the boundary
+};
+
+//------------------------------------------------------------------------------
+/*! \class EqRxWindow xeqrxwindow.h
+ *
+ *  \brief Finds the region of the table's continuous row and column input
+ *  ranges that is within all the active output prescriptions, using far
+ *  fewer evaluations than a dense table.
+ *
+ *  run() searches the box spanned by the lowest and highest row and column
+ *  values, bisecting it (up to "rxWindowDepth" times along each axis) only
+ *  where it contains part of the window's boundary.
+ *
+ *  Outputs such as spread rate and flame length change monotonically with
+ *  wind speed and fuel moisture over any small box, so their extreme values
+ *  over a box are found at its corners.  A box is therefore entirely within
+ *  prescription if every active RxVar is within its range at every corner,
+ *  and entirely outside if any one RxVar is below (or above) its range at
+ *  every corner.  As a guard against outputs that are not monotone, such a
+ *  box is only accepted if its center agrees; otherwise it is bisected.
+ *  Boxes that are still mixed at the greatest depth are boundary boxes.
+ *
+ *  Each evaluated point's status is kept on a lattice of the greatest
+ *  depth, so points shared by adjacent boxes are calculated only once.
+ *  Every accepted box is written to a comma-separated result file.
+ */
+
+class EqRxWindow
+{
+// Public methods
+public:
+    EqRxWindow( EqTree *eqTree ) ;
+    ~EqRxWindow( void ) ;
+
+    double  boundaryFraction( void ) const ;
+    int     denseEvaluations( void ) const ;
+    const QString &error( void ) const ;
+    int     evaluations( void ) const ;
+    double  insideFraction( void ) const ;
+    bool    run( int depth, const QString &resultFile ) ;
+
+// Protected methods
+protected:
+    int     boxStatus( int i0, int i1, int j0, int j1 ) ;
+    const signed char *point( int i, int j ) ;
+    bool    pointInside( int i, int j ) ;
+    void    reset( void ) ;
+    bool    search( int i0, int i1, int j0, int j1 ) ;
+    double  value( int dim, int index ) const ;
+    void    writeBox( int i0, int i1, int j0, int j1, int status ) ;
+
+// Protected data members
+protected:
+    EqTree     *m_eqTree;       //!< Pointer to the EqTree being run
+    QString     m_error;        //!< Description of the last error
+    int         m_dims;         //!< Number of searched inputs (1 or 2)
+    EqVar      *m_dimVar[2];    //!< Searched row and column input variables
+    double      m_dimMin[2];    //!< Lowest searched input value
+    double      m_dimMax[2];    //!< Highest searched input value
+    int         m_steps;        //!< Lattice steps along each axis
+    int         m_rxVars;       //!< Number of active output RxVars
+    RxVar     **m_rxVar;        //!< Array of active output RxVar ptrs
+    signed char *m_code;        //!< Lattice point RxVar codes (or 0)
+    bool       *m_done;         //!< TRUE if the lattice point is evaluated
+    int         m_evaluations;  //!< Number of points evaluated
+    int         m_area;         //!< Finest boxes accepted so far
+    int         m_insideArea;   //!< Finest boxes within prescription
+    int         m_boundaryArea; //!< Finest boxes on the boundary
+    FILE       *m_out;          //!< Result file
+    QProgressDialog *m_progress;    //!< Progress dialog
+    QString     m_statusText[3];    //!< Result file box status names
+};
+
+#endif
+
+//------------------------------------------------------------------------------
+//  End of xeqrxwindow.h
+//------------------------------------------------------------------------------
+
@@ -0,0 +1,823 @@
+//------------------------------------------------------------------------------
+/*! \file xeqsample.cpp
+ *  \version BehavePlus6
+ *  \author Copyright (C) 2002-2018 by Collin D. Bevins.  All rights reserved.
+ *
+ *  \brief EqTree input uncertainty sampling class methods.
+ */
+
+// Custom include files
+#include "appmessage.h"
+#include "apptranslator.h"
+#include "parser.h"
+#include "rxvar.h"
+#include "xeqcalc.h"
+#include "xeqsample.h"
+#include "xeqtree.h"
+#include "xeqvar.h"
+#include "xeqvaritem.h"
+
+// Qt include files
+#include <qapplication.h>
+#include <qprogressdialog.h>
+
+// Standard include files
+#include <math.h>
+#include <stdlib.h>
+
+//------------------------------------------------------------------------------
+/*! \brief qsort() comparison function used to sort sampled output values
+ *  into ascending order.  Called only by qsort() on behalf of EqSample::run().
+ *
+ *  \return  -1, 0, or 1 as required by qsort().
+ */
+
+int EqSample_ValueCompare( const void *s1, const void *s2 )
+{
+    double d1 = *(const double *) s1;
+    double d2 = *(const double *) s2;
+    return( ( d1 < d2 ) ? -1 : ( ( d1 > d2 ) ? 1 : 0 ) );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Inverse of the standard normal cumulative distribution function.
+ *
+ *  Uses P.J. Acklam's rational approximation, which has a relative error
+ *  of less than 1.15e-09 over the entire range.
+ *
+ *  \param p Probability (0 < p < 1).
+ *
+ *  \return Standard normal deviate whose cumulative probability is \a p.
+ */
+
+static double EqSample_NormalQuantile( double p )
+{
+    static const double a[6] =
+    {
+        -3.969683028665376e+01,  2.209460984245205e+02,
+        -2.759285104469687e+02,  1.383577518672690e+02,
+        -3.066479806614716e+01,  2.506628277459239e+00
+    };
+    static const double b[5] =
+    {
+        -5.447609879822406e+01,  1.615858368580409e+02,
+        -1.556989798598866e+02,  6.680131188771972e+01,
+        -1.328068155288572e+01
+    };
+    static const double c[6] =
+    {
+        -7.784894002430293e-03, -3.223964580411365e-01,
+        -2.400758277161838e+00, -2.549732539343734e+00,
+         4.374664141464968e+00,  2.938163982698783e+00
+    };
+    static const double d[4] =
+    {
+         7.784695709041462e-03,  3.224671290700398e-01,
+         2.445134137142996e+00,  3.754408661907416e+00
+    };
+    double q, r;
+    // Lower tail
+    if ( p < 0.02425 )
+    {
+        q = sqrt( -2. * log( p ) );
+        return( ( ( ( ( ( c[0] * q + c[1] ) * q + c[2] ) * q + c[3] ) * q
+            + c[4] ) * q + c[5] )
+            / ( ( ( ( d[0] * q + d[1] ) * q + d[2] ) * q + d[3] ) * q + 1. ) );
+    }
+    // Upper tail
+    if ( p > 1. - 0.02425 )
+    {
+        q = sqrt( -2. * log( 1. - p ) );
+        return( -( ( ( ( ( c[0] * q + c[1] ) * q + c[2] ) * q + c[3] ) * q
+            + c[4] ) * q + c[5] )
+            / ( ( ( ( d[0] * q + d[1] ) * q + d[2] ) * q + d[3] ) * q + 1. ) );
+    }
+    // Central region
+    q = p - 0.5;
+    r = q * q;
+    return( ( ( ( ( ( a[0] * r + a[1] ) * r + a[2] ) * r + a[3] ) * r
+        + a[4] ) * r + a[5] ) * q
+        / ( ( ( ( ( b[0] * r + b[1] ) * r + b[2] ) * r + b[3] ) * r
+        + b[4] ) * r + 1. ) );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief EqSample constructor.
+ *
+ *  \param eqTree Pointer to the EqTree to be sampled.  Its m_rangeVar[] array
+ *  must have been set by EqTree::validateInputs().
+ */
+
+EqSample::EqSample( EqTree *eqTree ) :
+    m_eqTree(eqTree),
+    m_inputs(0),
+    m_inVar(0),
+    m_inDist(0),
+    m_inValues(0),
+    m_inValue(0),
+    m_outVars(0),
+    m_outVar(0),
+    m_samples(0),
+    m_val(0),
+    m_inRxCount(0),
+    m_rxActive(false),
+    m_lhs(true),
+    m_seed(1)
+{
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief EqSample destructor.
+ */
+
+EqSample::~EqSample( void )
+{
+    reset();
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Access to an uncertain input variable's sampling distribution.
+ *
+ *  \param input Input index (0 to inputs()-1).
+ *
+ *  \return One of the EqSampleDist values.
+ */
+
+int EqSample::dist( int input ) const
+{
+    return( m_inDist[input] );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Describes an uncertain input variable's sampling distribution.
+ *
+ *  \param input Input index (0 to inputs()-1).
+ *
+ *  \return Translated distribution description.
+ */
+
+QString EqSample::distText( int input ) const
+{
+    EqVar *var = m_inVar[input];
+    const double *v = m_inValue[input];
+    int dec = var->m_displayDecimals;
+    QString text("");
+    if ( m_inDist[input] == EqSampleUniform )
+    {
+        translate( text, "EqSample:Dist:Uniform",
+            QString::number( v[0], 'f', dec ),
+            QString::number( v[1], 'f', dec ) );
+    }
+    else if ( m_inDist[input] == EqSampleNormal )
+    {
+        translate( text, "EqSample:Dist:Normal",
+            QString::number( v[0], 'f', dec ),
+            QString::number( v[1], 'f', dec ) );
+    }
+    else if ( m_inDist[input] == EqSampleTriangular )
+    {
+        translate( text, "EqSample:Dist:Triangular",
+            QString::number( v[0], 'f', dec ),
+            QString::number( v[2], 'f', dec ),
+            QString::number( v[1], 'f', dec ) );
+    }
+    else
+    {
+        translate( text, "EqSample:Dist:Empirical",
+            QString( "%1" ).arg( m_inValues[input] ) );
+    }
+    return( text );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Counts an output variable's sampled values in equal-width bins
+ *  between its minimum and maximum sampled values.
+ *
+ *  \param vid      Output variable index (0 to outVars()-1).
+ *  \param bins     Number of bins.
+ *  \param count    Returned array of \a bins counts.
+ *  \param lo       Returned lower limit of the first bin.
+ *  \param hi       Returned upper limit of the last bin.
+ *
+ *  \return Largest bin count.
+ */
+
+int EqSample::histogram( int vid, int bins, int *count, double *lo,
+        double *hi ) const
+{
+    const double *v = m_val + vid * m_samples;
+    *lo = v[0];
+    *hi = v[m_samples-1];
+    int bin;
+    for ( bin = 0;
+          bin < bins;
+          bin++ )
+    {
+        count[bin] = 0;
+    }
+    double width = ( *hi - *lo ) / (double) bins;
+    for ( int s = 0;
+          s < m_samples;
+          s++ )
+    {
+        bin = ( width > 0. )
+            ? (int) ( ( v[s] - *lo ) / width )
+            : 0;
+        if ( bin >= bins )
+        {
+            bin = bins - 1;
+        }
+        count[bin]++;
+    }
+    int maxCount = 0;
+    for ( bin = 0;
+          bin < bins;
+          bin++ )
+    {
+        if ( count[bin] > maxCount )
+        {
+            maxCount = count[bin];
+        }
+    }
+    return( maxCount );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Access to the fraction of samples within prescription.
+ *
+ *  \return Fraction (0 to 1) of samples that satisfied every active
+ *  prescription variable, or 1 if there are none.
+ */
+
+double EqSample::inRxProbability( void ) const
+{
+    return( ( m_samples > 0 )
+        ? ( (double) m_inRxCount / (double) m_samples )
+        : 0. );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Access to the number of uncertain input variables.
+ *
+ *  \return Number of uncertain input variables.
+ */
+
+int EqSample::inputs( void ) const
+{
+    return( m_inputs );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Access to an uncertain input variable.
+ *
+ *  \param input Input index (0 to inputs()-1).
+ *
+ *  \return Pointer to the input EqVar.
+ */
+
+EqVar *EqSample::inputVar( int input ) const
+{
+    return( m_inVar[input] );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Determines the value of an uncertain input at a cumulative
+ *  probability.
+ *
+ *  \param input    Input index (0 to inputs()-1).
+ *  \param p        Cumulative probability (0 < p < 1).
+ *
+ *  \return Input value (0.5 + item id for discrete variables).
+ */
+
+double EqSample::inverse( int input, double p ) const
+{
+    const double *v = m_inValue[input];
+    int n = m_inValues[input];
+    EqVar *var = m_inVar[input];
+    double x;
+    if ( m_inDist[input] == EqSampleUniform )
+    {
+        return( v[0] + p * ( v[1] - v[0] ) );
+    }
+    else if ( m_inDist[input] == EqSampleNormal )
+    {
+        // v[0] and v[1] are the 5th and 95th percentiles
+        double mean = 0.5 * ( v[0] + v[1] );
+        double sd = ( v[1] - v[0] ) / ( 2. * 1.6448536269514722 );
+        x = mean + sd * EqSample_NormalQuantile( p );
+        if ( x < var->m_displayMinimum )
+        {
+            x = var->m_displayMinimum;
+        }
+        if ( x > var->m_displayMaximum )
+        {
+            x = var->m_displayMaximum;
+        }
+        return( x );
+    }
+    else if ( m_inDist[input] == EqSampleTriangular )
+    {
+        // v[0], v[1], and v[2] are the minimum, maximum, and mode
+        double range = v[1] - v[0];
+        if ( range <= 0. )
+        {
+            return( v[0] );
+        }
+        double fc = ( v[2] - v[0] ) / range;
+        if ( p < fc )
+        {
+            return( v[0] + sqrt( p * range * ( v[2] - v[0] ) ) );
+        }
+        return( v[1] - sqrt( ( 1. - p ) * range * ( v[1] - v[2] ) ) );
+    }
+    // Empirical values are equally likely
+    int i = (int) ( p * (double) n );
+    if ( i >= n )
+    {
+        i = n - 1;
+    }
+    return( v[i] );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Access to the sampling design.
+ *
+ *  \return TRUE if the samples were a Latin hypercube, FALSE if Monte Carlo.
+ */
+
+bool EqSample::latinHypercube( void ) const
+{
+    return( m_lhs );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Access to an output variable's sample mean.
+ *
+ *  \param vid Output variable index (0 to outVars()-1).
+ *
+ *  \return Mean of the sampled values.
+ */
+
+double EqSample::mean( int vid ) const
+{
+    const double *v = m_val + vid * m_samples;
+    double sum = 0.;
+    for ( int s = 0;
+          s < m_samples;
+          s++ )
+    {
+        sum += v[s];
+    }
+    return( ( m_samples > 0 ) ? ( sum / (double) m_samples ) : 0. );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Access to the number of output variables.
+ *
+ *  \return Number of output variables.
+ */
+
+int EqSample::outVars( void ) const
+{
+    return( m_outVars );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Access to an output variable.
+ *
+ *  \param vid Output variable index (0 to outVars()-1).
+ *
+ *  \return Pointer to the output EqVar.
+ */
+
+EqVar *EqSample::outVar( int vid ) const
+{
+    return( m_outVar[vid] );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Determines an output variable's sample quantile.
+ *
+ *  Interpolates linearly between the sorted sample values.
+ *
+ *  \param vid  Output variable index (0 to outVars()-1).
+ *  \param p    Probability (0 to 1).
+ *
+ *  \return Sample quantile.
+ */
+
+double EqSample::quantile( int vid, double p ) const
+{
+    const double *v = m_val + vid * m_samples;
+    double h = p * (double) ( m_samples - 1 );
+    int lo = (int) h;
+    if ( lo >= m_samples - 1 )
+    {
+        return( v[m_samples-1] );
+    }
+    return( v[lo] + ( h - (double) lo ) * ( v[lo+1] - v[lo] ) );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Returns a uniform pseudo-random number.
+ *
+ *  Uses the Park and Miller minimal standard generator with Schrage's
+ *  method, so that sample sequences are the same on every platform.
+ *
+ *  \return Pseudo-random number in the open interval (0, 1).
+ */
+
+double EqSample::random( void )
+{
+    long hi = m_seed / 127773L;
+    long lo = m_seed % 127773L;
+    m_seed = 16807L * lo - 2836L * hi;
+    if ( m_seed <= 0 )
+    {
+        m_seed += 2147483647L;
+    }
+    return( (double) m_seed / 2147483647. );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Releases all memory and returns the EqSample to its initial state.
+ */
+
+void EqSample::reset( void )
+{
+    if ( m_inValue )
+    {
+        for ( int i = 0;
+              i < m_inputs;
+              i++ )
+        {
+            delete[] m_inValue[i];
+        }
+    }
+    delete[] m_inValue;     m_inValue = 0;
+    delete[] m_inValues;    m_inValues = 0;
+    delete[] m_inDist;      m_inDist = 0;
+    delete[] m_inVar;       m_inVar = 0;
+    delete[] m_outVar;      m_outVar = 0;
+    delete[] m_val;         m_val = 0;
+    m_inputs = m_outVars = m_samples = m_inRxCount = 0;
+    m_rxActive = false;
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Access to the prescription status.
+ *
+ *  \return TRUE if any active prescription variable is an output variable.
+ */
+
+bool EqSample::rxActive( void ) const
+{
+    return( m_rxActive );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Samples the EqTree's range variables and calculates every output
+ *  variable for every sample.
+ *
+ *  \param samples          Number of samples (limited to the range
+ *                          #EqSampleMinSamples to #EqSampleMaxSamples).
+ *  \param latinHypercube   If TRUE, a Latin hypercube design is used,
+ *                          otherwise simple Monte Carlo sampling.
+ *  \param normal           If TRUE, two entered continuous values are the
+ *                          5th and 95th percentiles of a normal
+ *                          distribution, otherwise uniform limits.
+ *  \param seed             Random number generator seed.
+ *
+ *  \return TRUE on success, FALSE on failure or if the user cancelled.
+ */
+
+bool EqSample::run( int samples, bool latinHypercube, bool normal, long seed )
+{
+    reset();
+    m_lhs = latinHypercube;
+    m_seed = seed % 2147483647L;
+    if ( m_seed <= 0 )
+    {
+        m_seed += 2147483646L;
+    }
+    m_samples = samples;
+    if ( m_samples < EqSampleMinSamples )
+    {
+        m_samples = EqSampleMinSamples;
+    }
+    if ( m_samples > EqSampleMaxSamples )
+    {
+        m_samples = EqSampleMaxSamples;
+    }
+    // Get the range variables and parse their values
+    m_inputs = m_eqTree->m_rangeVars;
+    if ( m_inputs < 1 )
+    {
+        return( false );
+    }
+    m_inVar = new EqVar *[ m_inputs ];
+    checkmem( __FILE__, __LINE__, m_inVar, "EqVar *m_inVar", m_inputs );
+    m_inDist = new int[ m_inputs ];
+    checkmem( __FILE__, __LINE__, m_inDist, "int m_inDist", m_inputs );
+    m_inValues = new int[ m_inputs ];
+    checkmem( __FILE__, __LINE__, m_inValues, "int m_inValues", m_inputs );
+    m_inValue = new double *[ m_inputs ];
+    checkmem( __FILE__, __LINE__, m_inValue, "double *m_inValue", m_inputs );
+    Parser parser( " \t,\"", "", "" );
+    QString token;
+    int in, i, n, s;
+    for ( in = 0;
+          in < m_inputs;
+          in++ )
+    {
+        m_inValue[in] = 0;
+    }
+    for ( in = 0;
+          in < m_inputs;
+          in++ )
+    {
+        EqVar *var = m_inVar[in] = m_eqTree->m_rangeVar[in];
+        m_inValue[in] = new double[ var->m_tokens ];
+        checkmem( __FILE__, __LINE__, m_inValue[in], "double m_inValue",
+            var->m_tokens );
+        parser.parse( var->m_store );
+        for ( i = 0, n = 0;
+              i < parser.tokens() && n < var->m_tokens;
+              i++ )
+        {
+            token = parser.token( i );
+            if ( var->isDiscrete() )
+            {
+                token = m_eqTree->tokenConverter( var, token );
+                m_inValue[in][n++] = 0.5 +
+                    (double) var->m_itemList->itemIdWithName( token );
+            }
+            else if ( var->isContinuous() )
+            {
+                m_inValue[in][n++] = token.toDouble();
+            }
+        }
+        m_inValues[in] = n;
+        // Determine the distribution
+        m_inDist[in] = EqSampleEmpirical;
+        if ( var->isContinuous() && n == 2 )
+        {
+            if ( m_inValue[in][1] < m_inValue[in][0] )
+            {
+                double tmp = m_inValue[in][0];
+                m_inValue[in][0] = m_inValue[in][1];
+                m_inValue[in][1] = tmp;
+            }
+            m_inDist[in] = ( normal ) ? EqSampleNormal : EqSampleUniform;
+        }
+        else if ( var->isContinuous() && n == 3 )
+        {
+            // Store as minimum, maximum, and mode
+            qsort( m_inValue[in], 3, sizeof(double), EqSample_ValueCompare );
+            double mode = m_inValue[in][1];
+            m_inValue[in][1] = m_inValue[in][2];
+            m_inValue[in][2] = mode;
+            m_inDist[in] = EqSampleTriangular;
+        }
+    }
+    // Get the output variables
+    if ( ! m_eqTree->runInitTableVars() )
+    {
+        return( false );
+    }
+    m_outVars = m_eqTree->m_tableVars;
+    m_outVar = new EqVar *[ m_outVars ];
+    checkmem( __FILE__, __LINE__, m_outVar, "EqVar *m_outVar", m_outVars );
+    for ( i = 0;
+          i < m_outVars;
+          i++ )
+    {
+        m_outVar[i] = m_eqTree->m_tableVar[i];
+    }
+    RxVar *rxVar;
+    for ( rxVar = m_eqTree->m_rxVarList->first();
+          rxVar;
+          rxVar = m_eqTree->m_rxVarList->next() )
+    {
+        if ( rxVar->m_isActive
+          && rxVar->m_varPtr->m_isUserOutput )
+        {
+            m_rxActive = true;
+        }
+    }
+    m_val = new double[ m_samples * m_outVars ];
+    checkmem( __FILE__, __LINE__, m_val, "double m_val",
+        m_samples * m_outVars );
+
+    // Draw every input's sample values up front, so the design does not
+    // depend on how the outputs are calculated.
+    double *inSample = new double[ m_samples * m_inputs ];
+    checkmem( __FILE__, __LINE__, inSample, "double inSample",
+        m_samples * m_inputs );
+    int *perm = new int[ m_samples ];
+    checkmem( __FILE__, __LINE__, perm, "int perm", m_samples );
+    for ( in = 0;
+          in < m_inputs;
+          in++ )
+    {
+        // Each Latin hypercube stratum is used once in random order
+        for ( s = 0;
+              s < m_samples;
+              s++ )
+        {
+            perm[s] = s;
+        }
+        for ( s = m_samples - 1;
+              m_lhs && s > 0;
+              s-- )
+        {
+            int j = (int) ( random() * (double) ( s + 1 ) );
+            if ( j > s )
+            {
+                j = s;
+            }
+            int tmp = perm[s];
+            perm[s] = perm[j];
+            perm[j] = tmp;
+        }
+        for ( s = 0;
+              s < m_samples;
+              s++ )
+        {
+            double p = ( m_lhs )
+                     ? ( ( (double) perm[s] + random() ) / (double) m_samples )
+                     : random();
+            inSample[ s * m_inputs + in ] = inverse( in, p );
+        }
+    }
+    delete[] perm;  perm = 0;
+
+    // Set up the progress dialog.
+    QString caption(""), button("");
+    translate( caption, "EqSample:Progress:Caption",
+        QString( "%1" ).arg( m_samples ),
+        QString( "%1" ).arg( m_inputs ),
+        QString( "%1" ).arg( m_outVars ) );
+    translate( button, "EqTree:RunTable:Progress:Button" );
+    QProgressDialog *progress = new QProgressDialog( caption, button,
+        m_samples );
+    Q_CHECK_PTR( progress );
+    progress->setMinimumDuration( 0 );
+    progress->setProgress( 0 );
+
+    // Make an Equation Tree run for every sample
+    bool ok = true;
+    EqVar *outVar;
+    for ( s = 0;
+          s < m_samples;
+          s++ )
+    {
+        for ( in = 0;
+              in < m_inputs;
+              in++ )
+        {
+            setInputValue( in, inSample[ s * m_inputs + in ] );
+        }
+        for ( int vid = 0;
+              vid < m_outVars;
+              vid++ )
+        {
+            outVar = m_outVar[vid];
+            m_eqTree->calculateVariable( outVar, 0 );
+            double *val = m_val + vid * m_samples + s;
+            *val = 0.;
+            if ( outVar->isDiscrete() )
+            {
+                *val = 0.5 + (double)
+                    outVar->m_itemList->itemIdWithName(
+                        outVar->activeItemName() );
+            }
+            else if ( outVar->isContinuous() )
+            {
+                *val = outVar->m_displayValue;
+            }
+        }
+        // Determine if results are within prescription
+        bool inRx = true;
+        for ( rxVar = m_eqTree->m_rxVarList->first();
+              rxVar;
+              rxVar = m_eqTree->m_rxVarList->next() )
+        {
+            if ( rxVar->m_isActive
+              && rxVar->m_varPtr->m_isUserOutput
+              && ! rxVar->inRange() )
+            {
+                inRx = false;
+                break;
+            }
+        }
+        if ( inRx )
+        {
+            m_inRxCount++;
+        }
+        // Update progress dialog.
+        progress->setProgress( s + 1 );
+        qApp->processEvents();
+        if ( progress->wasCancelled() )
+        {
+            ok = false;
+            break;
+        }
+    }
+    delete progress;    progress = 0;
+    delete[] inSample;  inSample = 0;
+    if ( ! ok )
+    {
+        return( false );
+    }
+    // Sort each output variable's values for the quantiles
+    for ( i = 0;
+          i < m_outVars;
+          i++ )
+    {
+        qsort( m_val + i * m_samples, m_samples, sizeof(double),
+            EqSample_ValueCompare );
+    }
+    return( true );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Access to the number of samples.
+ *
+ *  \return Number of samples.
+ */
+
+int EqSample::samples( void ) const
+{
+    return( m_samples );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Sets an uncertain input variable to a sampled value.
+ *
+ *  \param input    Input index.
+ *  \param value    Sampled value (0.5 + item id for discrete variables).
+ */
+
+void EqSample::setInputValue( int input, double value )
+{
+    EqVar *var = m_inVar[input];
+    if ( var->isDiscrete() )
+    {
+        var->setItemName( var->getItemName( (int) value ) );
+    }
+    else if ( var->isContinuous() )
+    {
+        var->setDisplayValue( value );
+    }
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Access to an output variable's sample standard deviation.
+ *
+ *  \param vid Output variable index (0 to outVars()-1).
+ *
+ *  \return Sample standard deviation of the sampled values.
+ */
+
+double EqSample::stdDev( int vid ) const
+{
+    if ( m_samples < 2 )
+    {
+        return( 0. );
+    }
+    const double *v = m_val + vid * m_samples;
+    double avg = mean( vid );
+    double sum = 0.;
+    for ( int s = 0;
+          s < m_samples;
+          s++ )
+    {
+        sum += ( v[s] - avg ) * ( v[s] - avg );
+    }
+    return( sqrt( sum / (double) ( m_samples - 1 ) ) );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Access to an output variable's sorted sample values.
+ *
+ *  \param vid  Output variable index (0 to outVars()-1).
+ *  \param rank Rank of the value (0 to samples()-1, smallest first).
+ *
+ *  \return Sampled value (0.5 + item id for discrete variables).
+ */
+
+double EqSample::value( int vid, int rank ) const
+{
+    return( m_val[ vid * m_samples + rank ] );
+}
+
+//------------------------------------------------------------------------------
+//  End of xeqsample.cpp
+//------------------------------------------------------------------------------
+
@@ -0,0 +1,130 @@
+//------------------------------------------------------------------------------
+/*! \file xeqsample.h
+ *  \version BehavePlus6
+ *  \author Copyright (C) 2002-2018 by Collin D. Bevins.  All rights reserved.
+ *
+ *  \brief EqTree input uncertainty sampling class definitions.
+ */
+
+#ifndef _XEQSAMPLE_H_
+/*! \def _XEQSAMPLE_H_
+ *  \brief Prevent redundant includes.
+ */
+#define _XEQSAMPLE_H_ 1
+
+// Custom class references
+class EqTree;
+class EqVar;
+
+// Qt class references
+#include <qstring.h>
+
+//------------------------------------------------------------------------------
+/*! \enum EqSampleDist
+ *  \brief Input variable sampling distributions.
+ */
+
+enum EqSampleDist
+{
+    EqSampleUniform=0,      //!< Uniform between two entered values
+    EqSampleNormal=1,       //!< Normal with two entered 5th and 95th %-iles
+    EqSampleTriangular=2,   //!< Triangular with entered min, mode, and max
+    EqSampleEmpirical=3     //!< Equally likely entered values
+};
+
+//------------------------------------------------------------------------------
+/*! \enum EqSampleSize
+ *  \brief EqSample limits.
+ */
+
+enum EqSampleSize
+{
+    EqSampleMinSamples = 10,                //!< Minimum number of samples
+    EqSampleMaxSamples = 100000             //!< Maximum number of samples
+};
+
+//------------------------------------------------------------------------------
+/*! \class EqSample xeqsample.h
+ *
+ *  \brief Runs an EqTree for a sample of values drawn from distributions of
+ *  its multi-valued (range) input variables, and summarizes the resulting
+ *  distributions of its output variables.
+ *
+ *  The entered values of each range variable describe an uncertain input:
+ *  \arg two continuous values are the limits of a uniform distribution,
+ *      or (if requested) the 5th and 95th percentiles of a normal
+ *      distribution truncated to the variable's valid range,
+ *  \arg three continuous values are the minimum, mode, and maximum of a
+ *      triangular distribution, and
+ *  \arg more than three continuous values, or any number of discrete
+ *      values, are equally likely empirical values.
+ *
+ *  run() draws the samples with either a Latin hypercube design, in which
+ *  each input's probability range is divided into as many equally likely
+ *  strata as there are samples and each stratum is used exactly once, or
+ *  by simple Monte Carlo.  The pseudo-random number generator is seeded
+ *  by the caller, so that runs are repeatable.
+ *
+ *  Every output variable value is kept for every sample, so quantile(),
+ *  histogram(), mean(), and stdDev() may be used after the run, along with
+ *  inRxProbability(), the fraction of the samples that satisfied all the
+ *  active prescription variables.
+
+ */
+
+class EqSample
+{
+// Public methods
+public:
+    EqSample( EqTree *eqTree ) ;
+    ~EqSample( void ) ;
+
+    int     dist( int input ) const ;
+    QString distText( int input ) const ;
+    int     histogram( int vid, int bins, int *count, double *lo,
+                double *hi ) const ;
+    int     inputs( void ) const ;
+    EqVar  *inputVar( int input ) const ;
+    double  inRxProbability( void ) const ;
+    bool    latinHypercube( void ) const ;
+    double  mean( int vid ) const ;
+    int     outVars( void ) const ;
+    EqVar  *outVar( int vid ) const ;
+    double  quantile( int vid, double p ) const ;
+    bool    rxActive( void ) const ;
+    bool    run( int samples, bool latinHypercube, bool normal, long seed ) ;
+    int     samples( void ) const ;
+    double  stdDev( int vid ) const ;
+    double  value( int vid, int rank ) const ;
+
+// Protected methods
+protected:
+    double  inverse( int input, double p ) const ;
+    double  random( void ) ;
+    void    reset( void ) ;
+    void    setInputValue( int input, double value ) ;
+
+// Protected data members
+protected:
+    EqTree     *m_eqTree;       //!< Pointer to the EqTree being sampled
+    int         m_inputs;       //!< Number of uncertain input variables
+    EqVar     **m_inVar;        //!< Array of uncertain input variable ptrs
+    int        *m_inDist;       //!< Array of input EqSampleDist
+    int        *m_inValues;     //!< Array of number of entered values
+    double    **m_inValue;      //!< Array of arrays of entered values
+    int         m_outVars;      //!< Number of output variables
+    EqVar     **m_outVar;       //!< Array of output variable ptrs
+    int         m_samples;      //!< Number of samples
+    double     *m_val;          //!< Sorted output values, one var at a time
+    int         m_inRxCount;    //!< Number of samples within prescription
+    bool        m_rxActive;     //!< TRUE if any prescription var is active
+    bool        m_lhs;          //!< TRUE if Latin hypercube, FALSE if MC
+    long        m_seed;         //!< Current random number generator state
+};
+
+#endif
+
+//------------------------------------------------------------------------------
+//  End of xeqsample.h
+//------------------------------------------------------------------------------
+
@@ -0,0 +1,828 @@
+//------------------------------------------------------------------------------
+/*! \file xeqsensitivity.cpp
+ *  \version BehavePlus6
+ *  \author Copyright (C) 2002-2018 by Collin D. Bevins.  All rights reserved.
+ *
+ *  \brief EqTree local sensitivity (Jacobian and elasticity) class methods.
+ */
+
+// Custom include files
+#include "Bp6CrownFire.h"
+#include "Bp6Dual.h"
+#include "Bp6SurfaceFire.h"
+#include "appmessage.h"
+#include "apptranslator.h"
+#include "xeqcalc.h"
+#include "xeqsensitivity.h"
+#include "xeqtree.h"
+#include "xeqvar.h"
+
+// Qt include files
+#include <qapplication.h>
+#include <qprogressdialog.h>
+
+// Standard include files
+#include <math.h>
+#include <stdio.h>
+
+/*! \brief A two-sided difference is flagged as straddling a kink if its
+ *  second difference exceeds this fraction of the step times the output.
+ *
+ *  For a smooth output the relative second difference shrinks with the
+ *  square of the step, while across a kink it shrinks only with the step
+ *  itself (in proportion to the change in elasticity).
+ */
+static const double KinkTolerance = 0.1;
+
+/*! \brief A fire model output is differentiated in forward mode only if
+ *  the Bp6Dual fire reproduces its value within this fraction.
+ */
+static const double MatchTolerance = 1.e-6;
+
+/*! \brief Derivative flags.
+ */
+enum { DerivativeOk=0, DerivativeEmpty=1, DerivativeKink=2 };
+
+//------------------------------------------------------------------------------
+/*! \brief EqSensitivity constructor.
+ *
+ *  \param eqTree Pointer to the EqTree to be run.  Its worksheet inputs must
+ *  have been stored by BpDocument::validateWorksheet() and its range case
+ *  determined by EqTree::rangeCase().
+ */
+
+EqSensitivity::EqSensitivity( EqTree *eqTree ) :
+    m_eqTree(eqTree),
+    m_error(""),
+    m_inVars(0),
+    m_inVar(0),
+    m_outVars(0),
+    m_outVar(0),
+    m_regimes(0),
+    m_regimeVar(0),
+    m_regimeOf(0),
+    m_state(0),
+    m_flag(0),
+    m_val(0),
+    m_fireVars(0),
+    m_fireVar(0),
+    m_fireVal(0),
+    m_fireKink(0),
+    m_dualFire(0),
+    m_dualCrown(0),
+    m_cells(0),
+    m_evaluations(0),
+    m_flagged(0),
+    m_propagated(0)
+{
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief EqSensitivity destructor.
+ */
+
+EqSensitivity::~EqSensitivity( void )
+{
+    reset();
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Access to the number of table cells processed by the last run().
+ *
+ *  \return Number of table cells processed.
+ */
+
+int EqSensitivity::cells( void ) const
+{
+    return( m_cells );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Access to the last error message.
+ *
+ *  \return Description of the last error, or an empty string.
+ */
+
+const QString &EqSensitivity::error( void ) const
+{
+    return( m_error );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Recalculates all the output variables for the current inputs.
+ *
+ *  \param val   Array of m_outVars output values (display units) to fill.
+ *  \param state Array of m_regimes regime variable item indices to fill.
+ */
+
+void EqSensitivity::evaluate( double *val, int *state )
+{
+    int vid;
+    for ( vid = 0;
+          vid < m_outVars;
+          vid++ )
+    {
+        m_eqTree->calculateVariable( m_outVar[vid], 0 );
+        val[vid] = m_outVar[vid]->m_displayValue;
+    }
+    // The regime variables are produced along with the outputs' inputs
+    for ( vid = 0;
+          vid < m_regimes;
+          vid++ )
+    {
+        state[vid] = m_regimeVar[vid]->activeItemDataIndex();
+    }
+    m_evaluations++;
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Access to the number of output evaluations made by the last run().
+ *
+ *  \return Number of output evaluations.
+ */
+
+int EqSensitivity::evaluations( void ) const
+{
+    return( m_evaluations );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Recursively finds the discrete variables produced upstream of
+ *  an output variable, which serve as its regime (kink) indicators.
+ *
+ *  Every discrete output of every active EqFun the output depends upon is
+ *  added to m_regimeVar[] (if not already there) and toggled in the
+ *  output's row of m_regimeOf[].
+ *
+ *  \param out     Index of the output variable in m_outVar[].
+ *  \param varPtr  Pointer to the current upstream variable.
+ *  \param visited Array of the EqFuns already visited for this output.
+ *  \param visits  Number of EqFuns in the \a visited array.
+ */
+
+void EqSensitivity::findRegimes( int out, EqVar *varPtr, EqFun **visited,
+        int *visits )
+{
+    // User inputs have no producer
+    EqFun *funPtr;
+    if ( ! ( funPtr = varPtr->activeProducerFunPtr() ) )
+    {
+        return;
+    }
+    int fid, vid, rid;
+    for ( fid = 0;
+          fid < *visits;
+          fid++ )
+    {
+        if ( visited[fid] == funPtr )
+        {
+            return;
+        }
+    }
+    visited[(*visits)++] = funPtr;
+    for ( vid = 0;
+          vid < funPtr->m_outputs;
+          vid++ )
+    {
+        EqVar *var = funPtr->m_output[vid];
+        if ( ! var->isDiscrete() )
+        {
+            continue;
+        }
+        for ( rid = 0;
+              rid < m_regimes;
+              rid++ )
+        {
+            if ( m_regimeVar[rid] == var )
+            {
+                break;
+            }
+        }
+        if ( rid == m_regimes )
+        {
+            m_regimeVar[m_regimes++] = var;
+        }
+        m_regimeOf[ out * m_eqTree->m_varCount + rid ] = true;
+    }
+    for ( vid = 0;
+          vid < funPtr->m_inputs;
+          vid++ )
+    {
+        findRegimes( out, funPtr->m_input[vid], visited, visits );
+    }
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Access to the number of derivatives flagged as straddling a kink
+ *  by the last run().
+ *
+ *  \return Number of flagged derivatives.
+ */
+
+int EqSensitivity::flagged( void ) const
+{
+    return( m_flagged );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Access to the number of perturbed input variables.
+ *
+ *  \return Number of perturbed input variables.
+ */
+
+int EqSensitivity::inVars( void ) const
+{
+    return( m_inVars );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Access to the number of differentiated output variables.
+ *
+ *  \return Number of differentiated output variables.
+ */
+
+int EqSensitivity::outVars( void ) const
+{
+    return( m_outVars );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Replaces the finite-difference derivatives of the fire model
+ *  outputs with forward-mode derivatives.
+ *
+ *  The fire model inputs are seeded with their derivatives with respect to
+ *  (up to Bp6Dual::Size of) the worksheet inputs, and the Bp6Dual fires
+ *  carry them through to the outputs.  An output's derivatives are kept as
+ *  they are if the Bp6Dual fire does not reproduce its value, and so does
+ *  not model it; a derivative is also kept if the fire model inputs'
+ *  differences straddle a kink, or it is empty.
+ *
+ *  \param nat Array of m_outVars output values (native units).
+ *  \param jac Output x input jacobian (display units) to update.
+ */
+
+void EqSensitivity::propagate( const double *nat, double *jac )
+{
+    EqCalc *calc = m_eqTree->m_eqCalc;
+    const double *fireX = m_fireVal;
+    const double *fireJac = m_fireVal + 3 * m_fireVars;
+    Bp6Dual *x = new Bp6Dual[ m_fireVars ];
+    checkmem( __FILE__, __LINE__, x, "Bp6Dual x", m_fireVars );
+    Bp6Dual y;
+    int in0, in, fid, out1, idx;
+    double factor;
+    for ( in0 = 0;
+          in0 < m_inVars;
+          in0 += Bp6Dual::Size )
+    {
+        // Seed the fire model inputs with this chunk of the worksheet inputs
+        for ( fid = 0;
+              fid < m_fireVars;
+              fid++ )
+        {
+            x[fid] = Bp6Dual( fireX[fid] );
+            for ( in = in0;
+                  in < m_inVars && in < in0 + Bp6Dual::Size;
+                  in++ )
+            {
+                x[fid].setDerivative( in - in0,
+                    fireJac[ fid * m_inVars + in ] );
+            }
+        }
+        calc->SensitivityFire( m_dualFire, m_dualCrown, x );
+        for ( out1 = 0;
+              out1 < m_outVars;
+              out1++ )
+        {
+            EqVar *var = m_outVar[out1];
+            if ( var->m_convert == 2
+              || ! calc->SensitivityFireOutput( var, m_dualFire, m_dualCrown,
+                    &y )
+              || ! ( fabs( y.value() - nat[out1] )
+                     <= MatchTolerance * fabs( nat[out1] ) ) )
+            {
+                continue;
+            }
+            factor = ( var->m_convert == 1 ) ? var->m_factor : 1.;
+            for ( in = in0;
+                  in < m_inVars && in < in0 + Bp6Dual::Size;
+                  in++ )
+            {
+                idx = out1 * m_inVars + in;
+                if ( m_flag[idx] == DerivativeEmpty
+                  || m_fireKink[in] )
+                {
+                    continue;
+                }
+                if ( m_flag[idx] == DerivativeKink )
+                {
+                    m_flagged--;
+                }
+                jac[idx] = factor * y.derivative( in - in0 );
+                m_flag[idx] = DerivativeOk;
+                m_propagated++;
+            }
+        }
+    }
+    delete[] x;     x = 0;
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Access to the number of derivatives propagated through the fire
+ *  models in forward mode by the last run().
+ *
+ *  \return Number of forward-mode derivatives.
+ */
+
+int EqSensitivity::propagated( void ) const
+{
+    return( m_propagated );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Releases all memory and returns the EqSensitivity to its initial
+ *  state.
+ */
+
+void EqSensitivity::reset( void )
+{
+    delete[] m_inVar;   m_inVar = 0;
+    delete[] m_outVar;  m_outVar = 0;
+    delete[] m_regimeVar;   m_regimeVar = 0;
+    delete[] m_regimeOf;    m_regimeOf = 0;
+    delete[] m_state;   m_state = 0;
+    delete[] m_flag;    m_flag = 0;
+    delete[] m_val;     m_val = 0;
+    delete[] m_fireVar;     m_fireVar = 0;
+    delete[] m_fireVal;     m_fireVal = 0;
+    delete[] m_fireKink;    m_fireKink = 0;
+    delete m_dualFire;  m_dualFire = 0;
+    delete m_dualCrown; m_dualCrown = 0;
+    m_inVars = m_outVars = m_regimes = m_cells = m_evaluations = 0;
+    m_fireVars = m_flagged = m_propagated = 0;
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Determines the derivatives and elasticities of every continuous
+ *  output with respect to every continuous input for every table cell.
+ *
+ *  Finite-difference derivatives that straddle a kink are written as
+ *  "kink", and those whose input cannot be perturbed within its valid range
+ *  are left empty.  The elasticity is the derivative times the input value
+ *  over the output value.
+ *
+ *  \param step         Input perturbation as a fraction of its value
+ *                      (or of its valid range if its value is zero).
+ *  \param resultFile   Name of the comma-separated result file to write.
+ *
+ *  \return TRUE on success, FALSE on failure (see error()) or if the user
+ *  cancelled.
+ */
+
+bool EqSensitivity::run( double step, const QString &resultFile )
+{
+    reset();
+    m_error = "";
+    // Each cell is a single table row and column
+    if ( m_eqTree->m_rangeVars > 2 )
+    {
+        translate( m_error, "EqSensitivity:RangeVars" );
+        return( false );
+    }
+    if ( step <= 0. )
+    {
+        translate( m_error, "EqSensitivity:BadStep",
+            QString( "%1" ).arg( step ) );
+        return( false );
+    }
+    if ( ! m_eqTree->runInit( false ) )
+    {
+        return( false );
+    }
+    EqVar *rowVar = m_eqTree->m_rangeVar[0];
+    EqVar *colVar = m_eqTree->m_rangeVar[1];
+
+    // Get the continuous, single-valued inputs and continuous outputs
+    m_inVar = new EqVar *[ m_eqTree->m_leafCount + 1 ];
+    checkmem( __FILE__, __LINE__, m_inVar, "EqVar *m_inVar",
+        m_eqTree->m_leafCount + 1 );
+    int vid, iid, row, col;
+    EqVar *var;
+    for ( vid = 0;
+          vid < m_eqTree->m_leafCount;
+          vid++ )
+    {
+        var = m_eqTree->m_leaf[vid];
+        if ( var
+          && var->isContinuous()
+          && var != rowVar
+          && var != colVar )
+        {
+            m_inVar[m_inVars++] = var;
+        }
+    }
+    m_outVar = new EqVar *[ m_eqTree->m_tableVars + 1 ];
+    checkmem( __FILE__, __LINE__, m_outVar, "EqVar *m_outVar",
+        m_eqTree->m_tableVars + 1 );
+    for ( vid = 0;
+          vid < m_eqTree->m_tableVars;
+          vid++ )
+    {
+        var = m_eqTree->m_tableVar[vid];
+        if ( var->isContinuous() )
+        {
+            m_outVar[m_outVars++] = var;
+        }
+    }
+    if ( m_inVars == 0
+      || m_outVars == 0 )
+    {
+        translate( m_error, "EqSensitivity:NoVars" );
+        reset();
+        m_eqTree->runClean();
+        return( false );
+    }
+    // Find each output's regime variables
+    int vars = m_eqTree->m_varCount;
+    m_regimeVar = new EqVar *[ vars + 1 ];
+    checkmem( __FILE__, __LINE__, m_regimeVar, "EqVar *m_regimeVar",
+        vars + 1 );
+    m_regimeOf = new bool[ m_outVars * vars ];
+    checkmem( __FILE__, __LINE__, m_regimeOf, "bool m_regimeOf",
+        m_outVars * vars );
+    for ( vid = 0;
+          vid < m_outVars * vars;
+          vid++ )
+    {
+        m_regimeOf[vid] = false;
+    }
+    EqFun **visited = new EqFun *[ m_eqTree->m_funCount + 1 ];
+    checkmem( __FILE__, __LINE__, visited, "EqFun *visited",
+        m_eqTree->m_funCount + 1 );
+    int visits;
+    for ( vid = 0;
+          vid < m_outVars;
+          vid++ )
+    {
+        visits = 0;
+        findRegimes( vid, m_outVar[vid], visited, &visits );
+    }
+    delete[] visited;   visited = 0;
+    m_state = new int[ 3 * m_regimes + 1 ];
+    checkmem( __FILE__, __LINE__, m_state, "int m_state", 3 * m_regimes + 1 );
+    int *state = m_state;
+    int *hiState = m_state + m_regimes;
+    int *loState = hiState + m_regimes;
+    m_flag = new int[ m_outVars * m_inVars ];
+    checkmem( __FILE__, __LINE__, m_flag, "int m_flag",
+        m_outVars * m_inVars );
+
+    // Output values, upper and lower perturbed values, the jacobian,
+    // and the native output values
+    int size = m_outVars * ( 4 + m_inVars );
+    m_val = new double[ size ];
+    checkmem( __FILE__, __LINE__, m_val, "double m_val", size );
+    double *val = m_val;
+    double *hiVal = m_val + m_outVars;
+    double *loVal = hiVal + m_outVars;
+    double *jac = loVal + m_outVars;
+    double *nat = jac + m_outVars * m_inVars;
+
+    // Fire model inputs at x, x+h, and x-h, and their jacobian
+    EqCalc *calc = m_eqTree->m_eqCalc;
+    m_fireVars = calc->SensitivityFireVars( 0 );
+    m_fireVar = new EqVar *[ m_fireVars ];
+    checkmem( __FILE__, __LINE__, m_fireVar, "EqVar *m_fireVar",
+        m_fireVars );
+    calc->SensitivityFireVars( m_fireVar );
+    size = m_fireVars * ( 3 + m_inVars );
+    m_fireVal = new double[ size ];
+    checkmem( __FILE__, __LINE__, m_fireVal, "double m_fireVal", size );
+    double *fireX = m_fireVal;
+    double *fireHi = fireX + m_fireVars;
+    double *fireLo = fireHi + m_fireVars;
+    double *fireJac = fireLo + m_fireVars;
+    m_fireKink = new bool[ m_inVars ];
+    checkmem( __FILE__, __LINE__, m_fireKink, "bool m_fireKink", m_inVars );
+    m_dualFire = new Bp6SurfaceFireT<Bp6Dual>();
+    checkmem( __FILE__, __LINE__, m_dualFire,
+        "Bp6SurfaceFireT<Bp6Dual> m_dualFire", 1 );
+    m_dualCrown = new Bp6CrownFireT<Bp6Dual>();
+    checkmem( __FILE__, __LINE__, m_dualCrown,
+        "Bp6CrownFireT<Bp6Dual> m_dualCrown", 1 );
+
+    // Write the result file header
+    FILE *out = fopen( resultFile.latin1(), "w" );
+    if ( ! out )
+    {
+        translate( m_error, "EqSensitivity:CreateError", resultFile );
+        reset();
+        m_eqTree->runClean();
+        return( false );
+    }
+    QString text(""), kink("");
+    translate( kink, "EqSensitivity:Kink" );
+    int in;
+    for ( vid = 0;
+          vid < 2;
+          vid++ )
+    {
+        if ( ( var = m_eqTree->m_rangeVar[vid] ) )
+        {
+            fprintf( out, "\"%s %s\",", (*(var->m_label)).latin1(),
+                var->displayUnits( true ).latin1() );
+        }
+    }
+    translate( text, "EqSensitivity:Output" );
+    fprintf( out, "\"%s\",", text.latin1() );
+    translate( text, "EqSensitivity:Value" );
+    fprintf( out, "\"%s\"", text.latin1() );
+    for ( in = 0;
+          in < m_inVars;
+          in++ )
+    {
+        translate( text, "EqSensitivity:Derivative", *(m_inVar[in]->m_label),
+            m_inVar[in]->displayUnits( true ) );
+        fprintf( out, ",\"%s\"", text.latin1() );
+    }
+    for ( in = 0;
+          in < m_inVars;
+          in++ )
+    {
+        translate( text, "EqSensitivity:Elasticity", *(m_inVar[in]->m_label) );
+        fprintf( out, ",\"%s\"", text.latin1() );
+    }
+    fprintf( out, "\n" );
+
+    // Set up the progress dialog.
+    int cells = m_eqTree->m_tableRows * m_eqTree->m_tableCols;
+    QString caption(""), button("");
+    translate( caption, "EqSensitivity:Progress:Caption",
+        QString( "%1" ).arg( cells ), QString( "%1" ).arg( m_inVars ),
+        QString( "%1" ).arg( m_outVars ) );
+    translate( button, "EqTree:RunTable:Progress:Button" );
+    QProgressDialog *progress = new QProgressDialog( caption, button, cells );
+    Q_CHECK_PTR( progress );
+    progress->setMinimumDuration( 0 );
+    progress->setProgress( 0 );
+
+    // Differentiate every table cell
+    bool ok = true;
+    double x0, xHi, xLo, h, scale;
+    int out1, rid, flag, fid;
+    for ( row = 0;
+          ok && row < m_eqTree->m_tableRows;
+          row++ )
+    {
+        // Set this row's input value.
+        if ( rowVar )
+        {
+            if ( rowVar->isDiscrete() )
+            {
+                iid = (int) m_eqTree->m_tableRow[ row ];
+                rowVar->setItemName( rowVar->getItemName( iid ) );
+            }
+            else if ( rowVar->isContinuous() )
+            {
+                rowVar->setDisplayValue( m_eqTree->m_tableRow[ row ] );
+            }
+        }
+        for ( col = 0;
+              col < m_eqTree->m_tableCols;
+              col++ )
+        {
+            // Set this column's input value.
+            if ( colVar )
+            {
+                if ( colVar->isDiscrete() )
+                {
+                    iid = (int) m_eqTree->m_tableCol[ col ];
+                    colVar->setItemName( colVar->getItemName( iid ) );
+                }
+                else if ( colVar->isContinuous() )
+                {
+                    colVar->setDisplayValue( m_eqTree->m_tableCol[ col ] );
+                }
+            }
+            // Determine the outputs and each input's column of the jacobian.
+            evaluate( val, state );
+            for ( out1 = 0;
+                  out1 < m_outVars;
+                  out1++ )
+            {
+                nat[out1] = m_outVar[out1]->m_nativeValue;
+            }
+            for ( fid = 0;
+                  fid < m_fireVars;
+                  fid++ )
+            {
+                fireX[fid] = m_fireVar[fid]->m_nativeValue;
+            }
+            for ( in = 0;
+                  in < m_inVars;
+                  in++ )
+            {
+                var = m_inVar[in];
+                x0 = var->m_displayValue;
+                h = ( x0 != 0. )
+                  ? step * fabs( x0 )
+                  : step * ( var->m_displayMaximum - var->m_displayMinimum );
+                xHi = ( x0 + h <= var->m_displayMaximum ) ? x0 + h : x0;
+                xLo = ( x0 - h >= var->m_displayMinimum ) ? x0 - h : x0;
+                m_fireKink[in] = false;
+                if ( xHi > xLo )
+                {
+                    var->setDisplayValue( xHi );
+                    evaluate( hiVal, hiState );
+                    for ( fid = 0;
+                          fid < m_fireVars;
+                          fid++ )
+                    {
+                        fireHi[fid] = m_fireVar[fid]->m_nativeValue;
+                    }
+                    var->setDisplayValue( xLo );
+                    evaluate( loVal, loState );
+                    for ( fid = 0;
+                          fid < m_fireVars;
+                          fid++ )
+                    {
+                        fireLo[fid] = m_fireVar[fid]->m_nativeValue;
+                    }
+                    var->setDisplayValue( x0 );
+                }
+                // Fire model input derivatives, and any kink in them
+                for ( fid = 0;
+                      fid < m_fireVars;
+                      fid++ )
+                {
+                    fireJac[ fid * m_inVars + in ] = 0.;
+                    if ( xHi <= xLo )
+                    {
+                        continue;
+                    }
+                    fireJac[ fid * m_inVars + in ] =
+                        ( fireHi[fid] - fireLo[fid] ) / ( xHi - xLo );
+                    scale = fabs( fireX[fid] );
+                    scale = ( fabs( fireHi[fid] ) > scale )
+                          ? fabs( fireHi[fid] ) : scale;
+                    scale = ( fabs( fireLo[fid] ) > scale )
+                          ? fabs( fireLo[fid] ) : scale;
+                    if ( xHi > x0
+                      && xLo < x0
+                      && fabs( fireHi[fid] - 2. * fireX[fid] + fireLo[fid] )
+                         > KinkTolerance * step * scale )
+                    {
+                        m_fireKink[in] = true;
+                    }
+                }
+                for ( out1 = 0;
+                      out1 < m_outVars;
+                      out1++ )
+                {
+                    jac[ out1 * m_inVars + in ] = 0.;
+                    if ( xHi <= xLo )
+                    {
+                        m_flag[ out1 * m_inVars + in ] = DerivativeEmpty;
+                        continue;
+                    }
+                    jac[ out1 * m_inVars + in ] =
+                        ( hiVal[out1] - loVal[out1] ) / ( xHi - xLo );
+                    // Did any of this output's regime variables change?
+                    flag = DerivativeOk;
+                    for ( rid = 0;
+                          rid < m_regimes;
+                          rid++ )
+                    {
+                        if ( m_regimeOf[ out1 * vars + rid ]
+                          && ( hiState[rid] != state[rid]
+                            || loState[rid] != state[rid] ) )
+                        {
+                            flag = DerivativeKink;
+                            break;
+                        }
+                    }
+                    // Is a two-sided difference too curved to be smooth?
+                    scale = fabs( val[out1] );
+                    scale = ( fabs( hiVal[out1] ) > scale )
+                          ? fabs( hiVal[out1] ) : scale;
+                    scale = ( fabs( loVal[out1] ) > scale )
+                          ? fabs( loVal[out1] ) : scale;
+                    if ( flag == DerivativeOk
+                      && xHi > x0
+                      && xLo < x0
+                      && scale > 0.
+                      && fabs( hiVal[out1] - 2. * val[out1] + loVal[out1] )
+                         > KinkTolerance * step * scale )
+                    {
+                        flag = DerivativeKink;
+                    }
+                    if ( flag == DerivativeKink )
+                    {
+                        m_flagged++;
+                    }
+                    m_flag[ out1 * m_inVars + in ] = flag;
+                }
+            }
+            // Differentiate the fire model outputs in forward mode.
+            propagate( nat, jac );
+
+            // Write this cell's outputs, derivatives, and elasticities.
+            for ( out1 = 0;
+                  out1 < m_outVars;
+                  out1++ )
+            {
+                for ( vid = 0;
+                      vid < 2;
+                      vid++ )
+                {
+                    if ( ! ( var = m_eqTree->m_rangeVar[vid] ) )
+                    {
+                        continue;
+                    }
+                    if ( var->isDiscrete() )
+                    {
+                        fprintf( out, "\"%s\",",
+                            var->activeItemName().latin1() );
+                    }
+                    else
+                    {
+                        fprintf( out, "%1.*f,", var->m_displayDecimals,
+                            var->m_displayValue );
+                    }
+                }
+                var = m_outVar[out1];
+                fprintf( out, "\"%s %s\",%1.*f", (*(var->m_label)).latin1(),
+                    var->displayUnits( true ).latin1(),
+                    var->m_displayDecimals, val[out1] );
+                for ( in = 0;
+                      in < m_inVars;
+                      in++ )
+                {
+                    flag = m_flag[ out1 * m_inVars + in ];
+                    if ( flag == DerivativeOk )
+                    {
+                        fprintf( out, ",%g", jac[ out1 * m_inVars + in ] );
+                    }
+                    else if ( flag == DerivativeKink )
+                    {
+                        fprintf( out, ",\"%s\"", kink.latin1() );
+                    }
+                    else
+                    {
+                        fprintf( out, "," );
+                    }
+                }
+                for ( in = 0;
+                      in < m_inVars;
+                      in++ )
+                {
+                    flag = m_flag[ out1 * m_inVars + in ];
+                    if ( flag == DerivativeKink )
+                    {
+                        fprintf( out, ",\"%s\"", kink.latin1() );
+                    }
+                    else if ( flag == DerivativeOk && val[out1] != 0. )
+                    {
+                        fprintf( out, ",%1.4f", jac[ out1 * m_inVars + in ]
+                            * m_inVar[in]->m_displayValue / val[out1] );
+                    }
+                    else
+                    {
+                        fprintf( out, "," );
+                    }
+                }
+                fprintf( out, "\n" );
+            }
+            m_cells++;
+
+            // Update progress dialog.
+            progress->setProgress( m_cells );
+            qApp->processEvents();
+            if ( progress->wasCancelled() )
+            {
+                ok = false;
+                break;
+            }
+        }
+    }
+    delete progress;    progress = 0;
+    if ( ferror( out ) && ok )
+    {
+        translate( m_error, "EqSensitivity:CreateError", resultFile );
+        ok = false;
+    }
+    fclose( out );
+    m_eqTree->runClean();
+    return( ok );
+}
+
+//------------------------------------------------------------------------------
+//  End of xeqsensitivity.cpp
+//------------------------------------------------------------------------------
+
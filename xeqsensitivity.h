@@ -0,0 +1,98 @@
+//------------------------------------------------------------------------------
+/*! \file xeqsensitivity.h
+ *  \version BehavePlus6
+ *  \author Copyright (C) 2002-2018 by Collin D. Bevins.  All rights reserved.
+ *
+ *  \brief EqTree local sensitivity (Jacobian and elasticity) class
+ *  definitions.
+ */
+
+#ifndef _XEQSENSITIVITY_H_
+/*! \def _XEQSENSITIVITY_H_
+ *  \brief Prevent redundant includes.
+ */
+#define _XEQSENSITIVITY_H_ 1
+
+// Custom class references
+template <class Real> class Bp6CrownFireT;
+template <class Real> class Bp6SurfaceFireT;
+class Bp6Dual;
+class EqFun;
+class EqTree;
+class EqVar;
+
+// Qt class references
+#include <qstring.h>
+
+//------------------------------------------------------------------------------
+/*! \class EqSensitivity xeqsensitivity.h
+ *
+ *  \brief Writes the derivative and elasticity of every continuous output
+ *  with respect to every continuous single valued input, for every table
+ *  cell, to a comma-separated result file.
+ *
+ *  Outputs calculated by the Bp6 fire models (see
+ *  EqCalc::SensitivityFireOutput()) are differentiated in forward mode by
+ *  Bp6SurfaceFireT<Bp6Dual> and Bp6CrownFireT<Bp6Dual>; only the smooth
+ *  conversions from the worksheet inputs to the fire model inputs are
+ *  central differences.  All other outputs are central differences, and
+ *  those straddling a kink (a change in an upstream discrete variable or
+ *  too large a second difference) are written as "kink".
+ */
+
+class EqSensitivity
+{
+// Public methods
+public:
+    EqSensitivity( EqTree *eqTree ) ;
+    ~EqSensitivity( void ) ;
+
+    int     cells( void ) const ;
+    const QString &error( void ) const ;
+    int     evaluations( void ) const ;
+    int     flagged( void ) const ;
+    int     inVars( void ) const ;
+    int     outVars( void ) const ;
+    int     propagated( void ) const ;
+    bool    run( double step, const QString &resultFile ) ;
+
+// Protected methods
+protected:
+    void    evaluate( double *val, int *state ) ;
+    void    findRegimes( int out, EqVar *varPtr, EqFun **visited,
+                int *visits ) ;
+    void    propagate( const double *nat, double *jac ) ;
+    void    reset( void ) ;
+
+// Protected data members
+protected:
+    EqTree     *m_eqTree;       //!< Pointer to the EqTree being run
+    QString     m_error;        //!< Description of the last error
+    int         m_inVars;       //!< Number of perturbed input variables
+    EqVar     **m_inVar;        //!< Array of perturbed input variable ptrs
+    int         m_outVars;      //!< Number of differentiated output variables
+    EqVar     **m_outVar;       //!< Array of output variable ptrs
+    int         m_regimes;      //!< Number of upstream discrete variables
+    EqVar     **m_regimeVar;    //!< Array of upstream discrete variable ptrs
+    bool       *m_regimeOf;     //!< Output x regime upstream toggles
+    int        *m_state;        //!< Regime item indices at x, x+h, and x-h
+    int        *m_flag;         //!< Output x input derivative flags
+    double     *m_val;          //!< Output values, jacobian, and work space
+    int         m_fireVars;     //!< Number of fire model input variables
+    EqVar     **m_fireVar;      //!< Array of fire model input variable ptrs
+    double     *m_fireVal;      //!< Fire model inputs and their jacobian
+    bool       *m_fireKink;     //!< Input x true if a fire model input kinks
+    Bp6SurfaceFireT<Bp6Dual> *m_dualFire;   //!< Forward-mode surface fire
+    Bp6CrownFireT<Bp6Dual>   *m_dualCrown;  //!< Forward-mode crown fire
+    int         m_cells;        //!< Number of table cells processed
+    int         m_evaluations;  //!< Number of output evaluations
+    int         m_flagged;      //!< Number of derivatives written as "kink"
+    int         m_propagated;   //!< Number of forward-mode derivatives
+};
+
+#endif
+
+//------------------------------------------------------------------------------
+//  End of xeqsensitivity.h
+//------------------------------------------------------------------------------
+
@@ -0,0 +1,173 @@
+//------------------------------------------------------------------------------
+/*! \file xeqspreadprofile.cpp
+ *  \version BehavePlus6
+ *  \author Copyright (C) 2002-2018 by Collin D. Bevins.  All rights reserved.
+ *
+ *  \brief Binary EqTree run surface fire spread profile file class methods.
+ */
+
+// Custom include files
+#include "appmessage.h"
+#include "Bp6SurfaceFire.h"
+#include "xeqspreadprofile.h"
+
+// Standard include files
+#include <string.h>
+
+//------------------------------------------------------------------------------
+/*! \brief Profile file identification and version.
+ */
+
+static const char ProfileMagic[8] = { 'B', 'P', '6', 'P', 'R', 'O', 'F', 0 };
+static const int  ProfileVersion = 1;
+
+//------------------------------------------------------------------------------
+/*! \struct EqSpreadProfileHeader
+ *  \brief Fixed size profile file header (32 bytes).
+ */
+
+struct EqSpreadProfileHeader
+{
+    char m_magic[8];        //!< ProfileMagic
+    int  m_version;         //!< ProfileVersion
+    int  m_rows;            //!< Number of table rows
+    int  m_cols;            //!< Number of table columns
+    int  m_directions;      //!< Number of directions per profile array
+    int  m_arrays;          //!< Number of profile arrays per cell (6)
+    int  m_reserved;        //!< Pads the header to a multiple of 8 bytes
+};
+
+//------------------------------------------------------------------------------
+/*! \brief Number of profile arrays stored per cell.
+ */
+
+static const int ProfileArrays = 6;
+
+//------------------------------------------------------------------------------
+/*! \brief EqSpreadProfile default constructor.
+ */
+
+EqSpreadProfile::EqSpreadProfile( void ) :
+    m_fileName(""),
+    m_fptr(0),
+    m_rows(0),
+    m_cols(0),
+    m_directions(0),
+    m_buffer(0),
+    m_fire(0)
+{
+    m_fire = new Bp6SurfaceFire();
+    checkmem( __FILE__, __LINE__, m_fire, "Bp6SurfaceFire m_fire", 1 );
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief EqSpreadProfile destructor.
+ *
+ *  Any profile file still being written is closed.
+ */
+
+EqSpreadProfile::~EqSpreadProfile( void )
+{
+    close();
+    delete m_fire;      m_fire = 0;
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Closes the profile file.
+ *
+ *  Does nothing if the file is not being written.
+ *
+ *  \return TRUE on success, FALSE on a write error.
+ */
+
+bool EqSpreadProfile::close( void )
+{
+    delete[] m_buffer;  m_buffer = 0;
+    if ( ! m_fptr )
+    {
+        return( true );
+    }
+    bool ok = ( ferror( m_fptr ) == 0 );
+    if ( fclose( m_fptr ) != 0 )
+    {
+        ok = false;
+    }
+    m_fptr = 0;
+    return( ok );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Creates the profile file \a fileName for a table of \a rows by
+ *  \a cols cells with \a directions profile directions.
+ *
+ *  \return TRUE on success, FALSE if the file cannot be opened.
+ */
+
+bool EqSpreadProfile::create( const QString &fileName, int rows, int cols,
+        int directions )
+{
+    close();
+    m_fileName = fileName;
+    if ( ! ( m_fptr = fopen( m_fileName.latin1(), "wb" ) ) )
+    {
+        return( false );
+    }
+    m_rows       = rows;
+    m_cols       = cols;
+    m_directions = directions;
+    int n = ProfileArrays * m_directions;
+    m_buffer = new double[ n ];
+    checkmem( __FILE__, __LINE__, m_buffer, "double m_buffer", n );
+
+    // Header
+    EqSpreadProfileHeader hdr;
+    memset( &hdr, 0, sizeof(hdr) );
+    memcpy( hdr.m_magic, ProfileMagic, sizeof(hdr.m_magic) );
+    hdr.m_version    = ProfileVersion;
+    hdr.m_rows       = m_rows;
+    hdr.m_cols       = m_cols;
+    hdr.m_directions = m_directions;
+    hdr.m_arrays     = ProfileArrays;
+    fwrite( &hdr, sizeof(hdr), 1, m_fptr );
+    return( true );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Access to the Bp6SurfaceFire whose profiles are stored by the
+ *  next storeCell().
+ */
+
+Bp6SurfaceFire *EqSpreadProfile::fire( void )
+{
+    return( m_fire );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Writes the beta and psi spread profiles of the current fire()
+ *  as cell \a row, \a col.
+ */
+
+void EqSpreadProfile::storeCell( int row, int col )
+{
+    if ( ! m_fptr )
+    {
+        return;
+    }
+    int n = m_directions;
+    m_fire->getSpreadProfileAtBeta( n, m_buffer, m_buffer + n,
+        m_buffer + 2 * n );
+    m_fire->getSpreadProfileAtPsi( n, m_buffer + 3 * n, m_buffer + 4 * n,
+        m_buffer + 5 * n );
+    long cellBytes = (long) ( ProfileArrays * n ) * sizeof(double);
+    long offset = (long) sizeof(EqSpreadProfileHeader)
+                + (long) ( col + row * m_cols ) * cellBytes;
+    fseek( m_fptr, offset, SEEK_SET );
+    fwrite( m_buffer, sizeof(double), ProfileArrays * n, m_fptr );
+    return;
+}
+
+//------------------------------------------------------------------------------
+//  End of xeqspreadprofile.cpp
+//------------------------------------------------------------------------------
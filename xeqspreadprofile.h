@@ -0,0 +1,78 @@
+//------------------------------------------------------------------------------
+/*! \file xeqspreadprofile.h
+ *  \version BehavePlus6
+ *  \author Copyright (C) 2002-2018 by Collin D. Bevins.  All rights reserved.
+ *
+ *  \brief Binary EqTree run surface fire spread profile file class definitions.
+ */
+
+#ifndef _XEQSPREADPROFILE_H_
+/*! \def _XEQSPREADPROFILE_H_
+ *  \brief Prevent redundant includes.
+ */
+#define _XEQSPREADPROFILE_H_ 1
+
+// Custom class references
+template <class Real> class Bp6SurfaceFireT;
+typedef Bp6SurfaceFireT<double> Bp6SurfaceFire;
+
+// Qt class references
+#include <qstring.h>
+
+// Standard include files
+#include <stdio.h>
+
+//------------------------------------------------------------------------------
+/*! \enum EqSpreadProfileSize
+ *  \brief EqSpreadProfile limits.
+ */
+
+enum EqSpreadProfileSize
+{
+    EqSpreadProfileDirections = 360 //!< Default profile directions per cell
+};
+
+//------------------------------------------------------------------------------
+/*! \class EqSpreadProfile xeqspreadprofile.h
+ *
+ *  \brief Writes the spread rate, fireline intensity, and flame length of
+ *  each EqTree::runTable() cell's surface fire in every direction.
+ *
+ *  The file is laid out as (all values in native byte order):
+ *      -# a fixed size EqSpreadProfileHeader,
+ *      -# for each cell ( cell = col + row * cols ), the Bp6SurfaceFire
+ *         getSpreadProfileAtBeta() ros, fli, and flame arrays, then the
+ *         getSpreadProfileAtPsi() ros, fli, and flame arrays, each of
+ *         \a directions doubles.
+ *  Cells without a surface fire are left zero filled.
+ */
+
+class EqSpreadProfile
+{
+// Public methods
+public:
+    EqSpreadProfile( void ) ;
+    ~EqSpreadProfile( void ) ;
+
+    bool   close( void ) ;
+    bool   create( const QString &fileName, int rows, int cols,
+                int directions=EqSpreadProfileDirections ) ;
+    Bp6SurfaceFire *fire( void ) ;
+    void   storeCell( int row, int col ) ;
+
+// Protected data members
+protected:
+    QString         m_fileName;     //!< Name of the profile file
+    FILE           *m_fptr;         //!< Output stream while writing
+    int             m_rows;         //!< Number of table rows
+    int             m_cols;         //!< Number of table columns
+    int             m_directions;   //!< Number of directions per profile
+    double         *m_buffer;       //!< One cell's 6 profile arrays
+    Bp6SurfaceFire *m_fire;         //!< Fire set up by EqCalc::SpreadProfileFire()
+};
+
+#endif
+
+//------------------------------------------------------------------------------
+//  End of xeqspreadprofile.h
+//------------------------------------------------------------------------------
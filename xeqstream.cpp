@@ -0,0 +1,529 @@
+//------------------------------------------------------------------------------
+/*! \file xeqstream.cpp
+ *  \version BehavePlus6
+ *  \author Copyright (C) 2002-2018 by Collin D. Bevins.  All rights reserved.
+ *
+ *  \brief EqTree weather stream time series class methods.
+ */
+
+// Custom include files
+#include "appmessage.h"
+#include "apptranslator.h"
+#include "rxvar.h"
+#include "xeqstream.h"
+#include "xeqtree.h"
+#include "xeqvar.h"
+#include "xeqvaritem.h"
+
+// Qt include files
+#include <qapplication.h>
+#include <qfileinfo.h>
+#include <qprogressdialog.h>
+
+// Standard include files
+#include <string.h>
+
+//------------------------------------------------------------------------------
+/*! \struct EqStreamAlias
+ *  \brief Maps a weather stream column alias to the EqVars it may refer to.
+ */
+
+struct EqStreamAlias
+{
+    const char *m_alias;        //!< Column alias
+    const char *m_varName[3];   //!< Candidate EqVar names (or 0)
+};
+
+//------------------------------------------------------------------------------
+/*! \brief Weather stream column aliases.  The first candidate that is an
+ *  input to the current worksheet is used.
+ */
+
+static const EqStreamAlias EqStream_Alias[] =
+{
+    { "temperature", { "vWthrAirTemp", 0, 0 } },
+    { "rh",          { "vWthrRelativeHumidity", 0, 0 } },
+    { "windSpeed",   { "vWindSpeedAtMidflame", "vWindSpeedAt20Ft",
+                       "vWindSpeedAt10M" } },
+    { "windDir",     { "vWindDirFromNorth", "vWindDirFromUpslope", 0 } },
+    { "mois1",       { "vSurfaceFuelMoisDead1", 0, 0 } },
+    { "mois10",      { "vSurfaceFuelMoisDead10", 0, 0 } },
+    { "mois100",     { "vSurfaceFuelMoisDead100", 0, 0 } },
+    { "mois1000",    { "vSurfaceFuelMoisDead1000", 0, 0 } },
+    { "moisHerb",    { "vSurfaceFuelMoisLiveHerb", 0, 0 } },
+    { "moisWood",    { "vSurfaceFuelMoisLiveWood", 0, 0 } },
+    { "moisDead",    { "vSurfaceFuelMoisLifeDead", 0, 0 } },
+    { "moisLive",    { "vSurfaceFuelMoisLifeLive", 0, 0 } },
+    { 0,             { 0, 0, 0 } }
+};
+
+//------------------------------------------------------------------------------
+/*! \brief EqStream constructor.
+ *
+ *  \param eqTree Pointer to the EqTree to be run.  Its worksheet inputs must
+ *  have been stored by BpDocument::validateWorksheet().
+ */
+
+EqStream::EqStream( EqTree *eqTree ) :
+    m_eqTree(eqTree),
+    m_error(""),
+    m_columns(0),
+    m_colVar(0),
+    m_field(0),
+    m_outVars(0),
+    m_outVar(0),
+    m_records(0),
+    m_line(0),
+    m_rxActive(false)
+{
+    m_buf[0] = '\0';
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief EqStream destructor.
+ */
+
+EqStream::~EqStream( void )
+{
+    reset();
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Access to the number of weather stream columns.
+ *
+ *  \return Number of weather stream columns, including the timestamp.
+ */
+
+int EqStream::columns( void ) const
+{
+    return( m_columns );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Access to a weather stream column's input variable.
+ *
+ *  \param col Column index (0 to columns()-1).
+ *
+ *  \return Pointer to the column's input EqVar, or 0 for the timestamp.
+ */
+
+EqVar *EqStream::columnVar( int col ) const
+{
+    return( m_colVar[col] );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Access to the last error message.
+ *
+ *  \return Description of the last error, or an empty string.
+ */
+
+const QString &EqStream::error( void ) const
+{
+    return( m_error );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Finds the worksheet input variable named by a column header.
+ *
+ *  \param name Column header (alias or EqVar name).
+ *
+ *  \return Pointer to the input EqVar, or 0 if there is no such input.
+ */
+
+EqVar *EqStream::findInput( const QString &name ) const
+{
+    EqVar *var;
+    for ( int i = 0;
+          EqStream_Alias[i].m_alias;
+          i++ )
+    {
+        if ( name.lower() != QString( EqStream_Alias[i].m_alias ).lower() )
+        {
+            continue;
+        }
+        for ( int j = 0;
+              j < 3 && EqStream_Alias[i].m_varName[j];
+              j++ )
+        {
+            var = m_eqTree->m_varDict->find( EqStream_Alias[i].m_varName[j] );
+            if ( var && var->m_isUserInput )
+            {
+                return( var );
+            }
+        }
+        return( 0 );
+    }
+    var = m_eqTree->m_varDict->find( name );
+    return( ( var && var->m_isUserInput ) ? var : 0 );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Access to the number of output variables.
+ *
+ *  \return Number of output variables written for each record.
+ */
+
+int EqStream::outVars( void ) const
+{
+    return( m_outVars );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Reads the next non-blank weather stream record into m_field[]
+ *  (or, if m_field is still 0, just into m_buf).
+ *
+ *  \param fptr Open weather stream file.
+ *
+ *  \return Number of comma-separated fields in the record, 0 at the end
+ *  of the file, or -1 if the record is too long to fit in m_buf.
+ */
+
+int EqStream::readRecord( FILE *fptr )
+{
+    while ( fgets( m_buf, sizeof(m_buf), fptr ) )
+    {
+        m_line++;
+        // A record without its line ending must be the file's last record
+        int len = strlen( m_buf );
+        if ( len > 0
+          && m_buf[len-1] != '\n'
+          && getc( fptr ) != EOF )
+        {
+            return( -1 );
+        }
+        // Strip the line ending
+        while ( len > 0 && ( m_buf[len-1] == '\n' || m_buf[len-1] == '\r' ) )
+        {
+            m_buf[--len] = '\0';
+        }
+        if ( QString( m_buf ).stripWhiteSpace().isEmpty() )
+        {
+            continue;
+        }
+        int fields = 1;
+        char *beg = m_buf;
+        char *end;
+        while ( true )
+        {
+            end = strchr( beg, ',' );
+            if ( m_field && fields <= m_columns )
+            {
+                m_field[fields-1] = ( end )
+                    ? QString::fromLatin1( beg, end - beg )
+                    : QString( beg );
+                m_field[fields-1] = m_field[fields-1].stripWhiteSpace();
+                if ( m_field[fields-1].startsWith( "\"" )
+                  && m_field[fields-1].endsWith( "\"" ) )
+                {
+                    m_field[fields-1] =
+                        m_field[fields-1].mid( 1, m_field[fields-1].length() - 2 );
+                }
+            }
+            if ( ! end )
+            {
+                break;
+            }
+            beg = end + 1;
+            fields++;
+        }
+        return( fields );
+    }
+    return( 0 );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Access to the number of records processed by the last run().
+ *
+ *  \return Number of weather stream records processed.
+ */
+
+int EqStream::records( void ) const
+{
+    return( m_records );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Releases all memory and returns the EqStream to its initial state.
+ */
+
+void EqStream::reset( void )
+{
+    delete[] m_colVar;  m_colVar = 0;
+    delete[] m_field;   m_field = 0;
+    delete[] m_outVar;  m_outVar = 0;
+    m_columns = m_outVars = m_records = m_line = 0;
+    m_rxActive = false;
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Runs the EqTree for every weather stream record.
+ *
+ *  \param streamFile   Name of the comma-separated weather stream file.
+ *  \param resultFile   Name of the comma-separated result file to write.
+ *
+ *  \return TRUE on success, FALSE on failure (see error()) or if the user
+ *  cancelled.
+ */
+
+bool EqStream::run( const QString &streamFile, const QString &resultFile )
+{
+    reset();
+    m_error = "";
+    // Every stream value replaces a single worksheet value
+    if ( m_eqTree->m_rangeVars > 0 )
+    {
+        translate( m_error, "EqStream:RangeVars" );
+        return( false );
+    }
+    FILE *in = fopen( streamFile.latin1(), "r" );
+    if ( ! in )
+    {
+        translate( m_error, "EqStream:OpenError", streamFile );
+        return( false );
+    }
+    // The header record names the input variable of each column
+    m_columns = readRecord( in );
+    if ( m_columns < 0 )
+    {
+        translate( m_error, "EqStream:LongRecord", streamFile,
+            QString( "%1" ).arg( m_line ),
+            QString( "%1" ).arg( EqStreamMaxLine - 2 ) );
+        fclose( in );
+        return( false );
+    }
+    if ( m_columns < 2 )
+    {
+        translate( m_error, "EqStream:NoColumns", streamFile );
+        fclose( in );
+        return( false );
+    }
+    m_colVar = new EqVar *[ m_columns ];
+    checkmem( __FILE__, __LINE__, m_colVar, "EqVar *m_colVar", m_columns );
+    m_field = new QString[ m_columns ];
+    checkmem( __FILE__, __LINE__, m_field, "QString m_field", m_columns );
+    int col;
+    for ( col = 0;
+          col < m_columns;
+          col++ )
+    {
+        m_colVar[col] = 0;
+    }
+    // Parse the header again, now that there is somewhere to put it
+    rewind( in );
+    m_line = 0;
+    readRecord( in );
+    for ( col = 1;
+          col < m_columns;
+          col++ )
+    {
+        if ( ! ( m_colVar[col] = findInput( m_field[col] ) ) )
+        {
+            translate( m_error, "EqStream:UnknownColumn", streamFile,
+                m_field[col] );
+            fclose( in );
+            return( false );
+        }
+    }
+    // Get the output variables
+    if ( ! m_eqTree->runInitTableVars() )
+    {
+        fclose( in );
+        return( false );
+    }
+    m_outVars = m_eqTree->m_tableVars;
+    m_outVar = new EqVar *[ m_outVars ];
+    checkmem( __FILE__, __LINE__, m_outVar, "EqVar *m_outVar", m_outVars );
+    int vid;
+    for ( vid = 0;
+          vid < m_outVars;
+          vid++ )
+    {
+        m_outVar[vid] = m_eqTree->m_tableVar[vid];
+    }
+    RxVar *rxVar;
+    for ( rxVar = m_eqTree->m_rxVarList->first();
+          rxVar;
+          rxVar = m_eqTree->m_rxVarList->next() )
+    {
+        if ( rxVar->m_isActive
+          && rxVar->m_varPtr->m_isUserOutput )
+        {
+            m_rxActive = true;
+        }
+    }
+    // Write the result file header
+    FILE *out = fopen( resultFile.latin1(), "w" );
+    if ( ! out )
+    {
+        translate( m_error, "EqStream:CreateError", resultFile );
+        fclose( in );
+        return( false );
+    }
+    fprintf( out, "\"%s\"", m_field[0].latin1() );
+    for ( vid = 0;
+          vid < m_outVars;
+          vid++ )
+    {
+        fprintf( out, ",\"%s %s\"", (*(m_outVar[vid]->m_label)).latin1(),
+            m_outVar[vid]->displayUnits( true ).latin1() );
+    }
+    if ( m_rxActive )
+    {
+        QString inRx("");
+        translate( inRx, "EqStream:InRx" );
+        fprintf( out, ",\"%s\"", inRx.latin1() );
+    }
+    fprintf( out, "\n" );
+
+    // Progress is measured by the bytes read, since the number of records
+    // isn't known until the whole file has been read.
+    int size = QFileInfo( streamFile ).size();
+    QString caption(""), button("");
+    translate( caption, "EqStream:Progress:Caption",
+        QFileInfo( streamFile ).fileName(),
+        QString( "%1" ).arg( m_columns - 1 ),
+        QString( "%1" ).arg( m_outVars ) );
+    translate( button, "EqTree:RunTable:Progress:Button" );
+    QProgressDialog *progress = new QProgressDialog( caption, button,
+        ( size > 0 ) ? size : 1 );
+    Q_CHECK_PTR( progress );
+    progress->setMinimumDuration( 0 );
+    progress->setProgress( 0 );
+
+    // Make an Equation Tree run for every record
+    bool ok = true;
+    int fields;
+    EqVar *var;
+    QString item("");
+    while ( ok && ( fields = readRecord( in ) ) != 0 )
+    {
+        if ( fields < 0 )
+        {
+            translate( m_error, "EqStream:LongRecord", streamFile,
+                QString( "%1" ).arg( m_line ),
+                QString( "%1" ).arg( EqStreamMaxLine - 2 ) );
+            ok = false;
+            break;
+        }
+        if ( fields != m_columns )
+        {
+            translate( m_error, "EqStream:BadRecord", streamFile,
+                QString( "%1" ).arg( m_line ),
+                QString( "%1" ).arg( fields ),
+                QString( "%1" ).arg( m_columns ) );
+            ok = false;
+            break;
+        }
+        // Set this record's inputs; empty values keep the previous value
+        for ( col = 1;
+              col < m_columns;
+              col++ )
+        {
+            if ( m_field[col].isEmpty() )
+            {
+                continue;
+            }
+            var = m_colVar[col];
+            if ( var->isDiscrete() )
+            {
+                item = m_eqTree->tokenConverter( var, m_field[col] );
+                if ( var->m_itemList->itemIdWithName( item ) < 0 )
+                {
+                    ok = false;
+                }
+                else
+                {
+                    var->setItemName( item );
+                }
+            }
+            else if ( var->isContinuous() )
+            {
+                // Stream values get the same range check as worksheet entries
+                double value = m_field[col].toDouble( &ok );
+                if ( ok && ! var->isValidRange( value ) )
+                {
+                    ok = false;
+                }
+                if ( ok )
+                {
+                    var->setDisplayValue( value );
+                }
+            }
+            if ( ! ok )
+            {
+                translate( m_error, "EqStream:BadValue", streamFile,
+                    QString( "%1" ).arg( m_line ), m_field[col],
+                    *(var->m_label) );
+                break;
+            }
+        }
+        if ( ! ok )
+        {
+            break;
+        }
+        // Calculate and write this record's outputs
+        fprintf( out, "\"%s\"", m_field[0].latin1() );
+        for ( vid = 0;
+              vid < m_outVars;
+              vid++ )
+        {
+            var = m_outVar[vid];
+            m_eqTree->calculateVariable( var, 0 );
+            if ( var->isDiscrete() )
+            {
+                fprintf( out, ",\"%s\"", var->activeItemName().latin1() );
+            }
+            else
+            {
+                fprintf( out, ",%1.*f", var->m_displayDecimals,
+                    var->m_displayValue );
+            }
+        }
+        if ( m_rxActive )
+        {
+            bool inRx = true;
+            for ( rxVar = m_eqTree->m_rxVarList->first();
+                  rxVar;
+                  rxVar = m_eqTree->m_rxVarList->next() )
+            {
+                if ( rxVar->m_isActive
+                  && rxVar->m_varPtr->m_isUserOutput
+                  && ! rxVar->inRange() )
+                {
+                    inRx = false;
+                    break;
+                }
+            }
+            fprintf( out, ",%d", inRx ? 1 : 0 );
+        }
+        fprintf( out, "\n" );
+        m_records++;
+
+        // Update progress dialog.
+        progress->setProgress( (int) ftell( in ) );
+        qApp->processEvents();
+        if ( progress->wasCancelled() )
+        {
+            ok = false;
+            break;
+        }
+    }
+    delete progress;    progress = 0;
+    if ( ferror( out ) && ok )
+    {
+        translate( m_error, "EqStream:CreateError", resultFile );
+        ok = false;
+    }
+    fclose( out );
+    fclose( in );
+    return( ok );
+}
+
+//------------------------------------------------------------------------------
+//  End of xeqstream.cpp
+//------------------------------------------------------------------------------
+
@@ -0,0 +1,94 @@
+//------------------------------------------------------------------------------
+/*! \file xeqstream.h
+ *  \version BehavePlus6
+ *  \author Copyright (C) 2002-2018 by Collin D. Bevins.  All rights reserved.
+ *
+ *  \brief EqTree weather stream time series class definitions.
+ */
+
+#ifndef _XEQSTREAM_H_
+/*! \def _XEQSTREAM_H_
+ *  \brief Prevent redundant includes.
+ */
+#define _XEQSTREAM_H_ 1
+
+// Custom class references
+class EqTree;
+class EqVar;
+
+// Qt class references
+#include <qstring.h>
+
+// Standard include files
+#include <stdio.h>
+
+//------------------------------------------------------------------------------
+/*! \enum EqStreamSize
+ *  \brief EqStream limits.
+ */
+
+enum EqStreamSize
+{
+    EqStreamMaxLine = 4096      //!< Maximum weather stream record length
+};
+
+//------------------------------------------------------------------------------
+/*! \class EqStream xeqstream.h
+ *
+ *  \brief Runs an EqTree once for every record of a comma-separated weather
+ *  stream file, writing the output variables of each record to a result
+ *  file as soon as they are calculated.
+ *
+ *  The first record names the columns.  The first column is a timestamp
+ *  (or any other record label), which is copied to the result file.  Every
+ *  other column names a worksheet input variable, either by its internal
+ *  name (such as "vWthrAirTemp") or by one of the aliases temperature, rh,
+ *  windSpeed, windDir, mois1, mois10, mois100, mois1000, moisHerb,
+ *  moisWood, moisDead, or moisLive, which refer to whichever wind speed,
+ *  wind direction, or fuel moisture variable is an input to the current
+ *  worksheet.  Values are in the variable's current display units, and an
+ *  empty value keeps the previous record's value.  All other inputs keep
+ *  their worksheet values.
+ */
+
+class EqStream
+{
+// Public methods
+public:
+    EqStream( EqTree *eqTree ) ;
+    ~EqStream( void ) ;
+
+    int     columns( void ) const ;
+    EqVar  *columnVar( int col ) const ;
+    const QString &error( void ) const ;
+    int     outVars( void ) const ;
+    int     records( void ) const ;
+    bool    run( const QString &streamFile, const QString &resultFile ) ;
+
+// Protected methods
+protected:
+    EqVar  *findInput( const QString &name ) const ;
+    int     readRecord( FILE *fptr ) ;
+    void    reset( void ) ;
+
+// Protected data members
+protected:
+    EqTree     *m_eqTree;       //!< Pointer to the EqTree being run
+    QString     m_error;        //!< Description of the last error
+    int         m_columns;      //!< Number of stream file columns
+    EqVar     **m_colVar;       //!< Array of column input variable ptrs
+    QString    *m_field;        //!< Array of current record field values
+    int         m_outVars;      //!< Number of output variables
+    EqVar     **m_outVar;       //!< Array of output variable ptrs
+    int         m_records;      //!< Number of records processed
+    int         m_line;         //!< Current stream file line number
+    bool        m_rxActive;     //!< TRUE if any prescription var is active
+    char        m_buf[EqStreamMaxLine];     //!< Stream record buffer
+};
+
+#endif
+
+//------------------------------------------------------------------------------
+//  End of xeqstream.h
+//------------------------------------------------------------------------------
+
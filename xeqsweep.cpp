@@ -0,0 +1,674 @@
+//------------------------------------------------------------------------------
+/*! \file xeqsweep.cpp
+ *  \version BehavePlus6
+ *  \author Copyright (C) 2002-2018 by Collin D. Bevins.  All rights reserved.
+ *
+ *  \brief EqTree N-dimensional range variable sweep class methods.
+ */
+
+// Custom include files
+#include "appmessage.h"
+#include "apptranslator.h"
+#include "parser.h"
+#include "rxvar.h"
+#include "xeqcalc.h"
+#include "xeqsweep.h"
+#include "xeqtree.h"
+#include "xeqvar.h"
+#include "xeqvaritem.h"
+
+// Qt include files
+#include <qapplication.h>
+#include <qprogressdialog.h>
+
+//------------------------------------------------------------------------------
+/*! \brief EqSweep constructor.
+ *
+ *  \param eqTree Pointer to the EqTree to be swept.  Its m_rangeVar[] array
+ *  must have been set by EqTree::validateInputs().
+ */
+
+EqSweep::EqSweep( EqTree *eqTree ) :
+    m_eqTree(eqTree),
+    m_dims(0),
+    m_dimVar(0),
+    m_dimValues(0),
+    m_dimValue(0),
+    m_outVars(0),
+    m_outVar(0),
+    m_cells(0),
+    m_val(0),
+    m_inRx(0),
+    m_spillFile(""),
+    m_spill(0),
+    m_loaded(-1)
+{
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief EqSweep destructor.
+ */
+
+EqSweep::~EqSweep( void )
+{
+    reset();
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Determines the dense array index of a cell.
+ *
+ *  \param index Array of m_dims range variable value indices.
+ *
+ *  \return Cell index, with the last dimension varying fastest.
+ */
+
+long EqSweep::cellIndex( const int *index ) const
+{
+    long cell = 0;
+    for ( int dim = 0;
+          dim < m_dims;
+          dim++ )
+    {
+        cell = cell * m_dimValues[dim] + index[dim];
+    }
+    return( cell );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Access to the total number of cells in the sweep.
+ *
+ *  \return Total number of cells in the sweep.
+ */
+
+long EqSweep::cells( void ) const
+{
+    return( m_cells );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Reads a chunk from the spill file into m_val[] and m_inRx[].
+ *
+ *  \param chunk Chunk index.
+ *
+ *  \return TRUE on success, FALSE on failure.
+ */
+
+bool EqSweep::chunkLoad( int chunk )
+{
+    if ( chunk == m_loaded )
+    {
+        return( true );
+    }
+    long values = (long) EqSweepChunkCells * m_outVars;
+    long bytes  = values * sizeof(double) + EqSweepChunkCells * sizeof(bool);
+    if ( fseek( m_spill, chunk * bytes, SEEK_SET ) != 0
+      || fread( m_val, sizeof(double), values, m_spill ) != (size_t) values
+      || fread( m_inRx, sizeof(bool), EqSweepChunkCells, m_spill )
+            != (size_t) EqSweepChunkCells )
+    {
+        m_loaded = -1;
+        return( false );
+    }
+    m_loaded = chunk;
+    return( true );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Writes m_val[] and m_inRx[] to the spill file as a chunk.
+ *
+ *  Every chunk is written at its full size so they may be addressed
+ *  directly, even though the last chunk may be only partly used.
+ *
+ *  \param chunk Chunk index.
+ *
+ *  \return TRUE on success, FALSE on failure.
+ */
+
+bool EqSweep::chunkSave( int chunk )
+{
+    long values = (long) EqSweepChunkCells * m_outVars;
+    long bytes  = values * sizeof(double) + EqSweepChunkCells * sizeof(bool);
+    if ( fseek( m_spill, chunk * bytes, SEEK_SET ) != 0
+      || fwrite( m_val, sizeof(double), values, m_spill ) != (size_t) values
+      || fwrite( m_inRx, sizeof(bool), EqSweepChunkCells, m_spill )
+            != (size_t) EqSweepChunkCells )
+    {
+        return( false );
+    }
+    m_loaded = chunk;
+    return( true );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Access to the number of dimensions (range variables).
+ *
+ *  \return Number of dimensions (range variables).
+ */
+
+int EqSweep::dims( void ) const
+{
+    return( m_dims );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Access to a dimension's value.
+ *
+ *  \param dim      Dimension index.
+ *  \param index    Value index.
+ *
+ *  \return The continuous display value, or 0.5 plus the item id of a
+ *  discrete variable, as stored in the EqTree's m_tableRow[] array.
+ */
+
+double EqSweep::dimValue( int dim, int index ) const
+{
+    return( m_dimValue[dim][index] );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Formats a dimension's value for display.
+ *
+ *  \param dim      Dimension index.
+ *  \param index    Value index.
+ *
+ *  \return "label value units" text for continuous variables, or
+ *  "label item" text for discrete variables.
+ */
+
+QString EqSweep::dimValueText( int dim, int index ) const
+{
+    EqVar *var = m_dimVar[dim];
+    QString text("");
+    if ( var->isDiscrete() )
+    {
+        text = *(var->m_label) + " "
+             + var->m_itemList->itemName( (int) m_dimValue[dim][index] );
+    }
+    else
+    {
+        text.sprintf( " %1.*f ", var->m_displayDecimals,
+            m_dimValue[dim][index] );
+        text = *(var->m_label) + text + var->displayUnits();
+    }
+    return( text );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Access to the number of values of a dimension.
+ *
+ *  \param dim Dimension index.
+ *
+ *  \return Number of values of the dimension.
+ */
+
+int EqSweep::dimValues( int dim ) const
+{
+    return( m_dimValues[dim] );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Access to a dimension's range variable.
+ *
+ *  \param dim Dimension index.
+ *
+ *  \return Pointer to the dimension's EqVar.
+ */
+
+EqVar *EqSweep::dimVar( int dim ) const
+{
+    return( m_dimVar[dim] );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Access to a cell's prescription flag.
+ *
+ *  \param index Array of m_dims range variable value indices.
+ *
+ *  \return TRUE if all the active prescription outputs are in range.
+ */
+
+bool EqSweep::inRx( const int *index )
+{
+    long cell = cellIndex( index );
+    if ( m_spill )
+    {
+        chunkLoad( (int) ( cell / EqSweepChunkCells ) );
+        cell %= EqSweepChunkCells;
+    }
+    return( m_inRx[cell] );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Access to the number of output variables.
+ *
+ *  \return Number of output variables.
+ */
+
+int EqSweep::outVars( void ) const
+{
+    return( m_outVars );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Releases all the sweep's memory and removes its spill file.
+ */
+
+void EqSweep::reset( void )
+{
+    if ( m_spill )
+    {
+        fclose( m_spill );
+        m_spill = 0;
+        remove( m_spillFile.latin1() );
+    }
+    m_spillFile = "";
+    m_loaded = -1;
+    if ( m_dimValue )
+    {
+        for ( int dim = 0;
+              dim < m_dims;
+              dim++ )
+        {
+            delete[] m_dimValue[dim];
+        }
+    }
+    delete[] m_dimValue;    m_dimValue = 0;
+    delete[] m_dimValues;   m_dimValues = 0;
+    delete[] m_dimVar;      m_dimVar = 0;
+    delete[] m_outVar;      m_outVar = 0;
+    delete[] m_val;         m_val = 0;
+    delete[] m_inRx;        m_inRx = 0;
+    m_dims = m_outVars = 0;
+    m_cells = 0;
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Evaluates every output variable for every combination of the
+ *  EqTree's range variable values.
+ *
+ *  \param spillFile Name of the temporary file used if the results are too
+ *  large to keep in memory.  It is removed when the EqSweep is destroyed.
+ *
+ *  \return TRUE on success, FALSE on failure or if the user cancelled.
+ */
+
+bool EqSweep::run( const QString &spillFile )
+{
+    reset();
+    // Get the range variables and parse their values
+    m_dims = m_eqTree->m_rangeVars;
+    if ( m_dims < 1 )
+    {
+        return( false );
+    }
+    m_dimVar = new EqVar *[ m_dims ];
+    checkmem( __FILE__, __LINE__, m_dimVar, "EqVar *m_dimVar", m_dims );
+    m_dimValues = new int[ m_dims ];
+    checkmem( __FILE__, __LINE__, m_dimValues, "int m_dimValues", m_dims );
+    m_dimValue = new double *[ m_dims ];
+    checkmem( __FILE__, __LINE__, m_dimValue, "double *m_dimValue", m_dims );
+    Parser parser( " \t,\"", "", "" );
+    QString token;
+    int dim, i, n;
+    m_cells = 1;
+    for ( dim = 0;
+          dim < m_dims;
+          dim++ )
+    {
+        EqVar *var = m_dimVar[dim] = m_eqTree->m_rangeVar[dim];
+        m_dimValue[dim] = new double[ var->m_tokens ];
+        checkmem( __FILE__, __LINE__, m_dimValue[dim], "double m_dimValue",
+            var->m_tokens );
+        parser.parse( var->m_store );
+        for ( i = 0, n = 0;
+              i < parser.tokens() && n < var->m_tokens;
+              i++ )
+        {
+            token = parser.token( i );
+            if ( var->isDiscrete() )
+            {
+                token = m_eqTree->tokenConverter( var, token );
+                m_dimValue[dim][n++] = 0.5 +
+                    (double) var->m_itemList->itemIdWithName( token );
+            }
+            else if ( var->isContinuous() )
+            {
+                m_dimValue[dim][n++] = token.toDouble();
+            }
+        }
+        m_dimValues[dim] = n;
+        m_cells *= n;
+    }
+    // Get the output variables
+    if ( m_cells < 1
+      || ! m_eqTree->runInitTableVars() )
+    {
+        return( false );
+    }
+    m_outVars = m_eqTree->m_tableVars;
+    m_outVar = new EqVar *[ m_outVars ];
+    checkmem( __FILE__, __LINE__, m_outVar, "EqVar *m_outVar", m_outVars );
+    for ( i = 0;
+          i < m_outVars;
+          i++ )
+    {
+        m_outVar[i] = m_eqTree->m_tableVar[i];
+    }
+
+    // Keep all the results in memory, or one chunk at a time if too large
+    long residentCells = m_cells;
+    if ( m_cells * m_outVars > EqSweepMaxResidentValues )
+    {
+        m_spillFile = spillFile;
+        if ( ! ( m_spill = fopen( m_spillFile.latin1(), "w+b" ) ) )
+        {
+            QString msg("");
+            translate( msg, "EqSweep:UnopenedSpillFile", m_spillFile );
+            error( msg );
+            return( false );
+        }
+        residentCells = EqSweepChunkCells;
+    }
+    m_val = new double[ residentCells * m_outVars ];
+    checkmem( __FILE__, __LINE__, m_val, "double m_val",
+        residentCells * m_outVars );
+    m_inRx = new bool[ residentCells ];
+    checkmem( __FILE__, __LINE__, m_inRx, "bool m_inRx", residentCells );
+
+    // Set up the progress dialog.
+    QString caption(""), button("");
+    translate( caption, "EqSweep:Progress:Caption",
+        QString( "%1" ).arg( m_cells * m_outVars ),
+        QString( "%1" ).arg( m_dims ),
+        QString( "%1" ).arg( m_outVars ) );
+    translate( button, "EqTree:RunTable:Progress:Button" );
+    QProgressDialog *progress = new QProgressDialog( caption, button,
+        (int) m_cells );
+    Q_CHECK_PTR( progress );
+    progress->setMinimumDuration( 0 );
+    progress->setProgress( 0 );
+
+    // Start every range variable at its first value
+    int *index = new int[ m_dims ];
+    checkmem( __FILE__, __LINE__, index, "int index", m_dims );
+    for ( dim = 0;
+          dim < m_dims;
+          dim++ )
+    {
+        index[dim] = 0;
+        setDimValue( dim, 0 );
+    }
+    // Make an Equation Tree run for every cell
+    bool ok = true;
+    RxVar *rxVar;
+    EqVar *outVar;
+    for ( long cell = 0;
+          cell < m_cells;
+          cell++ )
+    {
+        long local = ( m_spill )
+                   ? ( cell % EqSweepChunkCells )
+                   : cell;
+        double *val = m_val + local * m_outVars;
+        for ( int vid = 0;
+              vid < m_outVars;
+              vid++ )
+        {
+            outVar = m_outVar[vid];
+            m_eqTree->calculateVariable( outVar, 0 );
+            if ( outVar->isDiscrete() )
+            {
+                val[vid] = 0.5 + (double)
+                    outVar->m_itemList->itemIdWithName(
+                        outVar->activeItemName() );
+            }
+            else if ( outVar->isContinuous() )
+            {
+                val[vid] = outVar->m_displayValue;
+            }
+        }
+        // Determine if results are within prescription
+        m_inRx[local] = true;
+        for ( rxVar = m_eqTree->m_rxVarList->first();
+              rxVar;
+              rxVar = m_eqTree->m_rxVarList->next() )
+        {
+            if ( rxVar->m_isActive
+              && rxVar->m_varPtr->m_isUserOutput )
+            {
+                if ( ! rxVar->inRange() )
+                {
+                    m_inRx[local] = false;
+                    break;
+                }
+            }
+        }
+        // Write each full chunk (and the last one) to the spill file
+        if ( m_spill
+          && ( local == EqSweepChunkCells - 1 || cell == m_cells - 1 )
+          && ! chunkSave( (int) ( cell / EqSweepChunkCells ) ) )
+        {
+            QString msg("");
+            translate( msg, "EqSweep:UnopenedSpillFile", m_spillFile );
+            error( msg );
+            ok = false;
+            break;
+        }
+        // Update progress dialog.
+        progress->setProgress( (int) ( cell + 1 ) );
+        qApp->processEvents();
+        if ( progress->wasCancelled() )
+        {
+            ok = false;
+            break;
+        }
+        // Step to the next cell, setting only the inputs that change
+        for ( dim = m_dims - 1;
+              dim >= 0;
+              dim-- )
+        {
+            if ( ++index[dim] < m_dimValues[dim] )
+            {
+                setDimValue( dim, index[dim] );
+                break;
+            }
+            index[dim] = 0;
+            setDimValue( dim, 0 );
+        }
+    }
+    delete[] index;     index = 0;
+    delete progress;    progress = 0;
+    return( ok );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Sets a dimension's range variable to one of its values.
+ *
+ *  \param dim      Dimension index.
+ *  \param index    Value index.
+ */
+
+void EqSweep::setDimValue( int dim, int index )
+{
+    EqVar *var = m_dimVar[dim];
+    if ( var->isDiscrete() )
+    {
+        var->setItemName( var->getItemName( (int) m_dimValue[dim][index] ) );
+    }
+    else if ( var->isContinuous() )
+    {
+        var->setDisplayValue( m_dimValue[dim][index] );
+    }
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Copies a one or two dimensional slice of the sweep into the
+ *  EqTree's run table arrays.
+ *
+ *  The EqTree's range variables and range case are set to the slice's
+ *  row (and column) variables, and its m_tableSlice text describes the
+ *  fixed values of the other range variables, which are also set as the
+ *  current values of those variables.
+ *
+ *  \param rowDim   Dimension used for the table rows.
+ *  \param colDim   Dimension used for the table columns, or -1 if none.
+ *  \param index    Array of m_dims value indices; those of the fixed
+ *                  dimensions select the slice and the rest are ignored.
+ *
+ *  \return TRUE on success, FALSE if the dimensions are invalid.
+ */
+
+bool EqSweep::slice( int rowDim, int colDim, const int *index )
+{
+    if ( rowDim < 0 || rowDim >= m_dims || colDim >= m_dims
+      || rowDim == colDim )
+    {
+        return( false );
+    }
+    // Set the EqTree's range variables as if it had been a table run
+    m_eqTree->runClean();
+    int i;
+    for ( i = 0;
+          i < m_eqTree->m_maxRangeVars;
+          i++ )
+    {
+        m_eqTree->m_rangeVar[i] = 0;
+    }
+    m_eqTree->m_rangeVar[0] = m_dimVar[rowDim];
+    m_eqTree->m_rangeVars = 1;
+    if ( colDim >= 0 )
+    {
+        m_eqTree->m_rangeVar[1] = m_dimVar[colDim];
+        m_eqTree->m_rangeVars = 2;
+    }
+    m_eqTree->rangeCase();
+
+    // Create the run table arrays
+    int rows = m_dimValues[rowDim];
+    int cols = ( colDim >= 0 )
+             ? m_dimValues[colDim]
+             : 1;
+    m_eqTree->m_tableRows  = rows;
+    m_eqTree->m_tableCols  = cols;
+    m_eqTree->m_tableVars  = m_outVars;
+    m_eqTree->m_tableCells = rows * cols * m_outVars;
+    m_eqTree->m_tableRow = new double[ rows ];
+    checkmem( __FILE__, __LINE__, m_eqTree->m_tableRow,
+        "double m_tableRow", rows );
+    for ( i = 0;
+          i < rows;
+          i++ )
+    {
+        m_eqTree->m_tableRow[i] = m_dimValue[rowDim][i];
+    }
+    if ( colDim >= 0 )
+    {
+        m_eqTree->m_tableCol = new double[ cols ];
+        checkmem( __FILE__, __LINE__, m_eqTree->m_tableCol,
+            "double m_tableCol", cols );
+        for ( i = 0;
+              i < cols;
+              i++ )
+        {
+            m_eqTree->m_tableCol[i] = m_dimValue[colDim][i];
+        }
+    }
+    m_eqTree->m_tableVar = new EqVar *[ m_outVars ];
+    checkmem( __FILE__, __LINE__, m_eqTree->m_tableVar,
+        "EqVar *m_tableVar", m_outVars );
+    for ( i = 0;
+          i < m_outVars;
+          i++ )
+    {
+        m_eqTree->m_tableVar[i] = m_outVar[i];
+    }
+    m_eqTree->m_tableVal = new double[ m_eqTree->m_tableCells ];
+    checkmem( __FILE__, __LINE__, m_eqTree->m_tableVal,
+        "double m_tableVal", m_eqTree->m_tableCells );
+    m_eqTree->m_tableInRx = new bool[ rows * cols ];
+    checkmem( __FILE__, __LINE__, m_eqTree->m_tableInRx,
+        "bool m_tableInRx", rows * cols );
+
+    // Copy the slice's cells
+    int *at = new int[ m_dims ];
+    checkmem( __FILE__, __LINE__, at, "int at", m_dims );
+    for ( i = 0;
+          i < m_dims;
+          i++ )
+    {
+        at[i] = index[i];
+    }
+    int var = 0;
+    int cell = 0;
+    for ( int row = 0;
+          row < rows;
+          row++ )
+    {
+        at[rowDim] = row;
+        for ( int col = 0;
+              col < cols;
+              col++, cell++ )
+        {
+            if ( colDim >= 0 )
+            {
+                at[colDim] = col;
+            }
+            for ( int vid = 0;
+                  vid < m_outVars;
+                  vid++ )
+            {
+                m_eqTree->m_tableVal[var++] = value( at, vid );
+            }
+            m_eqTree->m_tableInRx[cell] = inRx( at );
+        }
+    }
+    delete[] at;    at = 0;
+
+    // Describe and set the fixed range variable values
+    m_eqTree->m_tableSlice = "";
+    for ( int dim = 0;
+          dim < m_dims;
+          dim++ )
+    {
+        if ( dim != rowDim && dim != colDim )
+        {
+            if ( ! m_eqTree->m_tableSlice.isEmpty() )
+            {
+                m_eqTree->m_tableSlice += ", ";
+            }
+            m_eqTree->m_tableSlice += dimValueText( dim, index[dim] );
+            setDimValue( dim, index[dim] );
+        }
+    }
+    return( true );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Access to a cell's output variable value.
+ *
+ *  \param index    Array of m_dims range variable value indices.
+ *  \param vid      Output variable index.
+ *
+ *  \return The output's continuous display value, or 0.5 plus the item id
+ *  of a discrete output, as stored in the EqTree's m_tableVal[] array.
+ */
+
+double EqSweep::value( const int *index, int vid )
+{
+    long cell = cellIndex( index );
+    if ( m_spill )
+    {
+        chunkLoad( (int) ( cell / EqSweepChunkCells ) );
+        cell %= EqSweepChunkCells;
+    }
+    return( m_val[ cell * m_outVars + vid ] );
+}
+
+//------------------------------------------------------------------------------
+//  End of xeqsweep.cpp
+//------------------------------------------------------------------------------
+
@@ -0,0 +1,106 @@
+//------------------------------------------------------------------------------
+/*! \file xeqsweep.h
+ *  \version BehavePlus6
+ *  \author Copyright (C) 2002-2018 by Collin D. Bevins.  All rights reserved.
+ *
+ *  \brief EqTree N-dimensional range variable sweep class definitions.
+ */
+
+#ifndef _XEQSWEEP_H_
+/*! \def _XEQSWEEP_H_
+ *  \brief Prevent redundant includes.
+ */
+#define _XEQSWEEP_H_ 1
+
+// Custom class references
+class EqTree;
+class EqVar;
+
+// Qt class references
+#include <qstring.h>
+
+// Standard include files
+#include <stdio.h>
+
+//------------------------------------------------------------------------------
+/*! \enum EqSweepSize
+ *  \brief EqSweep result storage limits.
+ */
+
+enum EqSweepSize
+{
+    EqSweepChunkCells = 4096,               //!< Cells per spilled chunk
+    EqSweepMaxResidentValues = 8388608      //!< Values kept in memory (64 Mb)
+};
+
+//------------------------------------------------------------------------------
+/*! \class EqSweep xeqsweep.h
+ *
+ *  \brief Runs an EqTree over every combination of the values of any
+ *  number of multi-valued (range) input variables.
+ *
+ *  run() evaluates every output variable for every combination of the
+ *  EqTree's m_rangeVar[] values, stepping the last range variable fastest
+ *  and setting only those inputs whose values change between cells.  The
+ *  results are stored in a dense array indexed by the range variable value
+ *  indices.  If the array would hold more than #EqSweepMaxResidentValues
+ *  values, it is written to a spill file in chunks of #EqSweepChunkCells
+ *  cells, and read back one chunk at a time by value() and inRx().
+ *
+ *  slice() copies any row (and column) of the array, with the remaining
+ *  range variables held at fixed values, into the EqTree's run table
+ *  arrays, exactly as if EqTree::runTable() had produced them, so the
+ *  existing table and graph composers can display them.
+
+ */
+
+class EqSweep
+{
+// Public methods
+public:
+    EqSweep( EqTree *eqTree ) ;
+    ~EqSweep( void ) ;
+
+    long    cells( void ) const ;
+    int     dims( void ) const ;
+    double  dimValue( int dim, int index ) const ;
+    QString dimValueText( int dim, int index ) const ;
+    int     dimValues( int dim ) const ;
+    EqVar  *dimVar( int dim ) const ;
+    bool    inRx( const int *index ) ;
+    int     outVars( void ) const ;
+    bool    run( const QString &spillFile ) ;
+    bool    slice( int rowDim, int colDim, const int *index ) ;
+    double  value( const int *index, int vid ) ;
+
+// Protected methods
+protected:
+    long    cellIndex( const int *index ) const ;
+    bool    chunkLoad( int chunk ) ;
+    bool    chunkSave( int chunk ) ;
+    void    reset( void ) ;
+    void    setDimValue( int dim, int index ) ;
+
+// Protected data members
+protected:
+    EqTree     *m_eqTree;       //!< Pointer to the EqTree being swept
+    int         m_dims;         //!< Number of range variables (dimensions)
+    EqVar     **m_dimVar;       //!< Array of range variable ptrs
+    int        *m_dimValues;    //!< Array of number of values per dimension
+    double    **m_dimValue;     //!< Array of arrays of dimension values
+    int         m_outVars;      //!< Number of output variables
+    EqVar     **m_outVar;       //!< Array of output variable ptrs
+    long        m_cells;        //!< Total number of cells
+    double     *m_val;          //!< Resident values (all or one chunk)
+    bool       *m_inRx;         //!< Resident prescription flags
+    QString     m_spillFile;    //!< Spill file name, or empty if resident
+    FILE       *m_spill;        //!< Spill file stream
+    int         m_loaded;       //!< Chunk in m_val[] if spilled, or -1
+};
+
+#endif
+
+//------------------------------------------------------------------------------
+//  End of xeqsweep.h
+//------------------------------------------------------------------------------
+
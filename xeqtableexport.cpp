@@ -0,0 +1,792 @@
+//------------------------------------------------------------------------------
+/*! \file xeqtableexport.cpp
+ *  \version BehavePlus6
+ *  \author Copyright (C) 2002-2018 by Collin D. Bevins.  All rights reserved.
+ *
+ *  \brief Streaming two-way table HTML, spreadsheet, and columnar exporter
+ *  class methods.
+ */
+
+// Custom include files
+#include "appmessage.h"
+#include "xeqtableexport.h"
+#include "xeqvar.h"
+#include "xeqvaritem.h"
+
+// Standard include files
+#include <math.h>
+#include <string.h>
+
+//------------------------------------------------------------------------------
+/*! \brief Columnar file identification and version.
+ */
+
+static const char ColumnarMagic[8] = { 'B', 'P', '6', 'C', 'O', 'L', 'Z', 0 };
+static const int  ColumnarVersion = 1;
+
+//------------------------------------------------------------------------------
+/*! \struct EqTableExportVar
+ *  \brief Per-variable export state and spool files.
+ */
+
+struct EqTableExportVar
+{
+    EqVar   *m_var;         //!< Output variable
+    int      m_vid;         //!< Index into each cell's value array
+    int      m_kind;        //!< 1=continuous, 2=discrete
+    int      m_decimals;    //!< Display decimals of continuous values
+    double   m_scale;       //!< 10 raised to the m_decimals power
+    Q_LLONG  m_prev;        //!< Previous cell's columnar value
+    long     m_colBytes;    //!< Bytes in the compressed column spool
+    FILE    *m_html;        //!< HTML table spool
+    FILE    *m_sheet;       //!< Spreadsheet table spool
+    FILE    *m_column;      //!< Compressed column spool
+};
+
+//------------------------------------------------------------------------------
+/*! \brief EqTableExport constructor.
+ */
+
+EqTableExport::EqTableExport( void ) :
+    m_var(0),
+    m_vars(0),
+    m_rows(0),
+    m_cols(0),
+    m_rowVar(0),
+    m_colVar(0),
+    m_rowValue(0),
+    m_colValue(0),
+    m_rowText(0),
+    m_colText(0),
+    m_doRx(false),
+    m_doBlank(false),
+    m_subtitle(""),
+    m_bytes(0),
+    m_msecs(0),
+    m_timer()
+{
+    m_buf[0] = 0;
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief EqTableExport destructor.
+ */
+
+EqTableExport::~EqTableExport( void )
+{
+    reset();
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Determines the number of decimals needed to display all the
+ *  \a value[] array elements without trailing zeros (6 at most).
+ *
+ *  This is the same rule BpDocument::composeTable3() uses for its
+ *  m_rowDecimals and m_colDecimals.
+ *
+ *  \param value Array of values.
+ *  \param n     Number of elements in \a value[].
+ *
+ *  \return Number of decimals.
+ */
+
+int EqTableExport::axisDecimals( const double *value, int n )
+{
+    char buf[64];
+    int decimals = 0;
+    for ( int i = 0;
+          i < n;
+          i++ )
+    {
+        int digits = 6;
+        sprintf( buf, "%1.*f", digits, value[i] );
+        int len = strlen( buf );
+        while ( len > 0 && buf[len-1] == '0' )
+        {
+            buf[--len] = 0;
+            digits--;
+        }
+        decimals = ( digits > decimals ) ? digits : decimals;
+    }
+    return( decimals );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Prepares the exporter to receive the cells of a new table.
+ *
+ *  Opens a temporary spool file for each of the HTML, spreadsheet, and
+ *  columnar formats of every continuous or discrete non-diagram output
+ *  variable, and writes the table headers into them.
+ *
+ *  \param rows     Number of table rows.
+ *  \param cols     Number of table columns.
+ *  \param rowVar   Row range variable.
+ *  \param colVar   Column range variable.
+ *  \param rowValue Array of \a rows row values (item ids for discrete).
+ *  \param colValue Array of \a cols column values (item ids for discrete).
+ *  \param var      Array of the table output variables.
+ *  \param vars     Number of table output variables.
+ *  \param doRx     If TRUE, HTML cells are shaded by prescription.
+ *  \param doBlank  If TRUE, HTML cells outside the prescription are blank.
+ *  \param subtitle HTML table subtitle (may be empty).
+ *
+ *  \return TRUE on success, FALSE if a spool file could not be opened.
+ */
+
+bool EqTableExport::begin( int rows, int cols, EqVar *rowVar, EqVar *colVar,
+        const double *rowValue, const double *colValue,
+        EqVar **var, int vars, bool doRx, bool doBlank,
+        const QString &subtitle )
+{
+    reset();
+    m_timer.start();
+    m_rows     = rows;
+    m_cols     = cols;
+    m_rowVar   = rowVar;
+    m_colVar   = colVar;
+    m_doRx     = doRx;
+    m_doBlank  = doBlank;
+    m_subtitle = subtitle;
+
+    // Copy the axis values and format their text just once
+    int row, col, vid;
+    m_rowValue = new double[ m_rows ];
+    checkmem( __FILE__, __LINE__, m_rowValue, "double m_rowValue", m_rows );
+    m_rowText = new char *[ m_rows ];
+    checkmem( __FILE__, __LINE__, m_rowText, "char *m_rowText", m_rows );
+    int decimals = axisDecimals( rowValue, m_rows );
+    for ( row = 0;
+          row < m_rows;
+          row++ )
+    {
+        m_rowValue[row] = rowValue[row];
+        if ( m_rowVar->isDiscrete() )
+        {
+            strcpy( m_buf,
+                m_rowVar->m_itemList->itemName( (int) rowValue[row] ).latin1() );
+        }
+        else
+        {
+            sprintf( m_buf, "%1.*f", decimals, rowValue[row] );
+        }
+        m_rowText[row] = new char[ strlen( m_buf ) + 1 ];
+        checkmem( __FILE__, __LINE__, m_rowText[row], "char m_rowText[]",
+            strlen( m_buf ) + 1 );
+        strcpy( m_rowText[row], m_buf );
+    }
+    m_colValue = new double[ m_cols ];
+    checkmem( __FILE__, __LINE__, m_colValue, "double m_colValue", m_cols );
+    m_colText = new char *[ m_cols ];
+    checkmem( __FILE__, __LINE__, m_colText, "char *m_colText", m_cols );
+    decimals = axisDecimals( colValue, m_cols );
+    for ( col = 0;
+          col < m_cols;
+          col++ )
+    {
+        m_colValue[col] = colValue[col];
+        if ( m_colVar->isDiscrete() )
+        {
+            strcpy( m_buf,
+                m_colVar->m_itemList->itemName( (int) colValue[col] ).latin1() );
+        }
+        else
+        {
+            sprintf( m_buf, " %1.*f", decimals, colValue[col] );
+        }
+        m_colText[col] = new char[ strlen( m_buf ) + 1 ];
+        checkmem( __FILE__, __LINE__, m_colText[col], "char m_colText[]",
+            strlen( m_buf ) + 1 );
+        strcpy( m_colText[col], m_buf );
+    }
+
+    // Only continuous and discrete non-diagram variables are exported
+    m_var = new EqTableExportVar[ vars ];
+    checkmem( __FILE__, __LINE__, m_var, "EqTableExportVar m_var", vars );
+    for ( vid = 0;
+          vid < vars;
+          vid++ )
+    {
+        if ( ! ( var[vid]->isDiscrete() || var[vid]->isContinuous() )
+          || var[vid]->isDiagram() )
+        {
+            continue;
+        }
+        EqTableExportVar *ev = &m_var[m_vars++];
+        ev->m_var      = var[vid];
+        ev->m_vid      = vid;
+        ev->m_kind     = ( var[vid]->isContinuous() ) ? 1 : 2;
+        ev->m_decimals = ( ev->m_kind == 1 ) ? var[vid]->m_displayDecimals : 0;
+        ev->m_scale    = pow( 10., (double) ev->m_decimals );
+        ev->m_prev     = 0;
+        ev->m_colBytes = 0;
+        ev->m_html     = tmpfile();
+        ev->m_sheet    = tmpfile();
+        ev->m_column   = tmpfile();
+        if ( ! ev->m_html || ! ev->m_sheet || ! ev->m_column )
+        {
+            reset();
+            return( false );
+        }
+        writeHtmlHeader( ev );
+        writeSpreadsheetHeader( ev );
+    }
+    m_msecs = m_timer.elapsed();
+    return( true );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Access to the total number of bytes formatted and written.
+ *
+ *  \return Total number of bytes formatted and written.
+ */
+
+long EqTableExport::bytes( void ) const
+{
+    return( m_bytes );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Appends the entire contents of the \a from spool to \a to.
+ *
+ *  \return TRUE on success, FALSE on write error.
+ */
+
+bool EqTableExport::copy( FILE *to, FILE *from )
+{
+    char buf[16384];
+    size_t n;
+    rewind( from );
+    while ( ( n = fread( buf, 1, sizeof(buf), from ) ) > 0 )
+    {
+        if ( fwrite( buf, 1, n, to ) != n )
+        {
+            return( false );
+        }
+        m_bytes += n;
+    }
+    return( true );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Finishes the current table by writing each variable's HTML
+ *  trailer.  The spools remain open until the next begin() or destruction
+ *  so that writeHtml(), writeSpreadsheet(), and writeColumnar() may be
+ *  called any number of times.
+ *
+ *  \return TRUE on success, FALSE on write error.
+ */
+
+bool EqTableExport::end( void )
+{
+    int t0 = m_timer.elapsed();
+    bool ok = true;
+    for ( int i = 0;
+          i < m_vars;
+          i++ )
+    {
+        EqTableExportVar *ev = &m_var[i];
+        m_bytes += fprintf( ev->m_html,
+            "  </table>\n"
+            "</p>\n"
+            "<!-- End 2-Way Output Table for %s -->\n\n",
+            (*(ev->m_var->m_label)).latin1()
+        );
+        if ( ferror( ev->m_html ) || ferror( ev->m_sheet )
+          || ferror( ev->m_column ) )
+        {
+            ok = false;
+        }
+    }
+    m_msecs += m_timer.elapsed() - t0;
+    return( ok );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Formats a single output value into the reusable buffer.
+ *
+ *  \param var   Output variable.
+ *  \param value Continuous display value or discrete item id.
+ *
+ *  \return Pointer to the formatted value text.
+ */
+
+const char *EqTableExport::format( EqVar *var, double value )
+{
+    if ( var->isDiscrete() )
+    {
+        return( var->m_itemList->itemName( (int) value ).latin1() );
+    }
+    sprintf( m_buf, "%1.*f", var->m_displayDecimals, value );
+    return( m_buf );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Writes a string to the file and counts its bytes.
+ */
+
+void EqTableExport::put( FILE *fptr, const char *str )
+{
+    size_t len = strlen( str );
+    m_bytes += fwrite( str, 1, len, fptr );
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Writes a 32-bit integer to the file and counts its bytes.
+ */
+
+void EqTableExport::putInt( FILE *fptr, int value )
+{
+    m_bytes += sizeof(int) * fwrite( &value, sizeof(int), 1, fptr );
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Writes a string's 32-bit length and characters to the file.
+ */
+
+void EqTableExport::putString( FILE *fptr, const QString &str )
+{
+    int len = str.length();
+    putInt( fptr, len );
+    if ( len > 0 )
+    {
+        m_bytes += fwrite( str.latin1(), 1, len, fptr );
+    }
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Writes an unsigned value as a base-128 varint (7 bits per byte,
+ *  high bit set on all but the last byte).
+ */
+
+void EqTableExport::putVarint( FILE *fptr, Q_ULLONG value )
+{
+    unsigned char buf[10];
+    int n = 0;
+    while ( value >= 0x80 )
+    {
+        buf[n++] = (unsigned char) ( ( value & 0x7f ) | 0x80 );
+        value >>= 7;
+    }
+    buf[n++] = (unsigned char) value;
+    m_bytes += fwrite( buf, 1, n, fptr );
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Closes all spool files and frees all dynamic memory.
+ */
+
+void EqTableExport::reset( void )
+{
+    int i;
+    for ( i = 0;
+          i < m_vars;
+          i++ )
+    {
+        if ( m_var[i].m_html )   fclose( m_var[i].m_html );
+        if ( m_var[i].m_sheet )  fclose( m_var[i].m_sheet );
+        if ( m_var[i].m_column ) fclose( m_var[i].m_column );
+    }
+    delete[] m_var;         m_var = 0;
+    m_vars = 0;
+    if ( m_rowText )
+    {
+        for ( i = 0;
+              i < m_rows;
+              i++ )
+        {
+            delete[] m_rowText[i];
+        }
+    }
+    if ( m_colText )
+    {
+        for ( i = 0;
+              i < m_cols;
+              i++ )
+        {
+            delete[] m_colText[i];
+        }
+    }
+    delete[] m_rowText;     m_rowText = 0;
+    delete[] m_colText;     m_colText = 0;
+    delete[] m_rowValue;    m_rowValue = 0;
+    delete[] m_colValue;    m_colValue = 0;
+    m_rows = m_cols = 0;
+    m_bytes = 0;
+    m_msecs = 0;
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Access to the total time spent formatting and writing.
+ *
+ *  Each call's elapsed milliseconds are accumulated, so the many short
+ *  storeCell() intervals average out to the true time spent exporting.
+ *
+ *  \return Total export time in seconds.
+ */
+
+double EqTableExport::seconds( void ) const
+{
+    return( 0.001 * (double) m_msecs );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Formats and spools a single table cell's output values.
+ *
+ *  Called by EqTree::runTable() as each cell is calculated, so cells must
+ *  be stored in row-major order.
+ *
+ *  \param row   Table row index.
+ *  \param col   Table column index.
+ *  \param value Array of the cell's output values in EqTree::m_tableVar[]
+ *               order (discrete values are item ids plus 0.5).
+ *  \param inRx  TRUE if the cell is within the prescription.
+ */
+
+void EqTableExport::storeCell( int row, int col, const double *value,
+        bool inRx )
+{
+    int t0 = m_timer.elapsed();
+    int rowClass = row % 2;
+    for ( int i = 0;
+          i < m_vars;
+          i++ )
+    {
+        EqTableExportVar *ev = &m_var[i];
+        double v = value[ ev->m_vid ];
+
+        // Row value is in the first column
+        if ( col == 0 )
+        {
+            m_bytes += fprintf( ev->m_html,
+                "    <tr>\n"
+                "      <td class=\"bp2hdr\" align=\"center\">\n"
+                "        %s\n"
+                "      </td>\n",
+                m_rowText[row]
+            );
+            put( ev->m_sheet, m_rowText[row] );
+        }
+        // Format the value just once for both text formats
+        const char *text = format( ev->m_var, v );
+        if ( m_doRx )
+        {
+            if ( inRx )
+            {
+                m_bytes += fprintf( ev->m_html,
+                    "      <td class=\"bp2row%din\" align=\"center\">\n"
+                    "        %s\n"
+                    "      </td>\n",
+                    rowClass, text
+                );
+            }
+            else if ( m_doBlank )
+            {
+                m_bytes += fprintf( ev->m_html,
+                    "      <td class=\"bp2row%dout\" align=\"center\">\n"
+                    "        &nbsp;\n"
+                    "      </td>\n",
+                    rowClass
+                );
+            }
+            else
+            {
+                m_bytes += fprintf( ev->m_html,
+                    "      <td class=\"bp2row%dout\" align=\"center\">\n"
+                    "        %s\n"
+                    "      </td>\n",
+                    rowClass, text
+                );
+            }
+        }
+        else
+        {
+            m_bytes += fprintf( ev->m_html,
+                "      <td  class=\"bp2row%d\" align=\"center\">\n"
+                "        %s\n"
+                "      </td>\n",
+                rowClass, text
+            );
+        }
+        m_bytes += fprintf( ev->m_sheet, "\t%s", text );
+        if ( col == m_cols - 1 )
+        {
+            put( ev->m_html, "    </tr>\n" );
+            put( ev->m_sheet, "\n" );
+        }
+
+        // Delta, zig-zag, and varint encode the columnar value
+        Q_LLONG q = ( ev->m_kind == 2 )
+                  ? (Q_LLONG) v
+                  : (Q_LLONG) floor( v * ev->m_scale + 0.5 );
+        Q_LLONG delta = q - ev->m_prev;
+        ev->m_prev = q;
+        long before = m_bytes;
+        putVarint( ev->m_column, ( delta < 0 )
+            ? ( ( (Q_ULLONG) ( -( delta + 1 ) ) ) << 1 ) | 1
+            : ( (Q_ULLONG) delta ) << 1 );
+        ev->m_colBytes += m_bytes - before;
+    }
+    m_msecs += m_timer.elapsed() - t0;
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Access to the export throughput.
+ *
+ *  \return Export throughput in megabytes per second, or 0 if no
+ *  measurable time has been spent.
+ */
+
+double EqTableExport::throughput( void ) const
+{
+    if ( m_msecs <= 0 )
+    {
+        return( 0. );
+    }
+    return( ( (double) m_bytes / 1048576. ) / seconds() );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Writes the compressed columnar file.
+ *
+ *  \param fptr Open binary output stream.
+ *
+ *  \return TRUE on success, FALSE on write error.
+ */
+
+bool EqTableExport::writeColumnar( FILE *fptr )
+{
+    int t0 = m_timer.elapsed();
+    bool ok = true;
+    int i;
+
+    // File header
+    m_bytes += fwrite( ColumnarMagic, 1, sizeof(ColumnarMagic), fptr );
+    putInt( fptr, ColumnarVersion );
+    putInt( fptr, m_rows );
+    putInt( fptr, m_cols );
+    putInt( fptr, m_vars );
+
+    // Axis variables and values
+    putString( fptr, m_rowVar->m_name );
+    putString( fptr, m_rowVar->isContinuous() ? m_rowVar->displayUnits() : "" );
+    putString( fptr, m_colVar->m_name );
+    putString( fptr, m_colVar->isContinuous() ? m_colVar->displayUnits() : "" );
+    m_bytes += sizeof(double) * fwrite( m_rowValue, sizeof(double), m_rows, fptr );
+    m_bytes += sizeof(double) * fwrite( m_colValue, sizeof(double), m_cols, fptr );
+
+    // Variable dictionary
+    for ( i = 0;
+          i < m_vars;
+          i++ )
+    {
+        EqTableExportVar *ev = &m_var[i];
+        putString( fptr, ev->m_var->m_name );
+        putString( fptr, ( ev->m_kind == 1 ) ? ev->m_var->displayUnits() : "" );
+        putInt( fptr, ev->m_kind );
+        putInt( fptr, ev->m_decimals );
+        if ( ev->m_kind == 2 )
+        {
+            int items = ev->m_var->m_itemList->count();
+            putInt( fptr, items );
+            for ( int iid = 0;
+                  iid < items;
+                  iid++ )
+            {
+                putString( fptr, ev->m_var->m_itemList->itemName( iid ) );
+            }
+        }
+        putInt( fptr, (int) ev->m_colBytes );
+    }
+
+    // Compressed columns
+    for ( i = 0;
+          i < m_vars;
+          i++ )
+    {
+        fflush( m_var[i].m_column );
+        ok = copy( fptr, m_var[i].m_column ) && ok;
+    }
+    m_msecs += m_timer.elapsed() - t0;
+    return( ok && ! ferror( fptr ) );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Writes every output variable's HTML table.
+ *
+ *  The caller is responsible for the HTML document header and footer
+ *  (see BpDocument::composeTableHtmlHeader() and composeTableHtmlFooter()).
+ *
+ *  \param fptr Open output stream.
+ *
+ *  \return TRUE on success, FALSE on write error.
+ */
+
+bool EqTableExport::writeHtml( FILE *fptr )
+{
+    int t0 = m_timer.elapsed();
+    bool ok = true;
+    for ( int i = 0;
+          i < m_vars;
+          i++ )
+    {
+        fflush( m_var[i].m_html );
+        ok = copy( fptr, m_var[i].m_html ) && ok;
+    }
+    m_msecs += m_timer.elapsed() - t0;
+    return( ok );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Writes a variable's HTML table header into its spool.
+ */
+
+void EqTableExport::writeHtmlHeader( EqTableExportVar *ev )
+{
+    FILE *fptr = ev->m_html;
+    EqVar *outVar = ev->m_var;
+    QString units("");
+    if ( outVar->isContinuous() )
+    {
+        units = "(" + outVar->displayUnits() + ")";
+    }
+    QString subTitle("");
+    if ( m_subtitle.length() > 0 )
+    {
+        subTitle = "  <h3 class=\"bp2subhead\"><b>" + m_subtitle + "</b></h3>\n";
+    }
+    m_bytes += fprintf( fptr,
+        "<!-- Begin 2-Way Output Table for %s -->\n"
+        "<p class=\"bp2\">\n%s"
+        "  <h3 class=\"bp2\">Results for: %s %s</h3>\n"
+        "  <table cellpadding=\"5\" cellspacing=\"2\" border=\"0\">\n",
+        (*(outVar->m_label)).latin1(),
+        subTitle.latin1(),
+        (*(outVar->m_label)).latin1(),
+        units.latin1()
+    );
+
+    // First column headers
+    m_bytes += fprintf( fptr,
+        "    <tr>\n"
+        "      <td class=\"bp2hdr\" align=\"center\">\n"
+        "        %s\n"
+        "      </td>\n"
+        "      <td class=\"bp2hdr\" colspan=\"%d\" align=\"center\">\n"
+        "        %s\n"
+        "      </td>\n"
+        "    </tr>\n",
+        (*(m_rowVar->m_hdr0)).latin1(),
+        m_cols,
+        (*(m_colVar->m_label)).latin1()
+    );
+
+    // Second column header
+    m_bytes += fprintf( fptr,
+        "    <tr>\n"
+        "      <td class=\"bp2hdr\" align=\"center\">\n"
+        "        %s\n"
+        "      </td>\n"
+        "      <td class=\"bp2hdr\" colspan=\"%d\" align=\"center\">\n"
+        "        %s\n"
+        "      </td>\n"
+        "    </tr>\n",
+        (*(m_rowVar->m_hdr1)).latin1(),
+        m_cols,
+        ( m_colVar->isContinuous() ) ? m_colVar->displayUnits().latin1() : ""
+    );
+
+    // Third column header has the row units and column values
+    m_bytes += fprintf( fptr,
+        "    <tr>\n"
+        "      <td class=\"bp2hdr\" align=\"center\">\n"
+        "        %s\n"
+        "      </td>\n",
+        ( m_rowVar->isContinuous() ) ? m_rowVar->displayUnits().latin1() : ""
+    );
+    for ( int col = 0;
+          col < m_cols;
+          col++ )
+    {
+        m_bytes += fprintf( fptr,
+            "      <td class=\"bp2hdr\" align=\"center\">\n"
+            "        %s\n"
+            "      </td>\n",
+            m_colText[col]
+        );
+    }
+    put( fptr, "    </tr>\n" );
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Writes every output variable's tab-delimited spreadsheet table.
+ *
+ *  The caller is responsible for the spreadsheet's program and run header.
+ *
+ *  \param fptr Open output stream.
+ *
+ *  \return TRUE on success, FALSE on write error.
+ */
+
+bool EqTableExport::writeSpreadsheet( FILE *fptr )
+{
+    int t0 = m_timer.elapsed();
+    bool ok = true;
+    for ( int i = 0;
+          i < m_vars;
+          i++ )
+    {
+        fflush( m_var[i].m_sheet );
+        ok = copy( fptr, m_var[i].m_sheet ) && ok;
+    }
+    m_msecs += m_timer.elapsed() - t0;
+    return( ok );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Writes a variable's spreadsheet table header into its spool.
+ */
+
+void EqTableExport::writeSpreadsheetHeader( EqTableExportVar *ev )
+{
+    FILE *fptr = ev->m_sheet;
+    EqVar *outVar = ev->m_var;
+    // Two blank lines between tables
+    m_bytes += fprintf( fptr, "\n\n%s\t%s\n%s\t%s\n%s\t%s\n",
+        (*(outVar->m_label)).latin1(),
+        ( outVar->isContinuous() ) ? outVar->displayUnits().latin1() : "",
+        (*(m_rowVar->m_label)).latin1(),
+        ( m_rowVar->isContinuous() ) ? m_rowVar->displayUnits().latin1() : "",
+        (*(m_colVar->m_label)).latin1(),
+        ( m_colVar->isContinuous() ) ? m_colVar->displayUnits().latin1() : "" );
+
+    // First column header row
+    m_bytes += fprintf( fptr, "\n%s\t \t%s\t%s\n",
+        (*(m_rowVar->m_hdr0)).latin1(),
+        (*(m_colVar->m_hdr0)).latin1(),
+        (*(m_colVar->m_hdr1)).latin1() );
+
+    // Second column header row
+    put( fptr, (*(m_rowVar->m_hdr1)).latin1() );
+    for ( int col = 0;
+          col < m_cols;
+          col++ )
+    {
+        m_bytes += fprintf( fptr, "\t%s", m_colText[col] );
+    }
+    put( fptr, "\n" );
+    return;
+}
+
+//------------------------------------------------------------------------------
+//  End of xeqtableexport.cpp
+//------------------------------------------------------------------------------
+
@@ -0,0 +1,115 @@
+//------------------------------------------------------------------------------
+/*! \file xeqtableexport.h
+ *  \version BehavePlus6
+ *  \author Copyright (C) 2002-2018 by Collin D. Bevins.  All rights reserved.
+ *
+ *  \brief Streaming two-way table HTML, spreadsheet, and columnar exporter
+ *  class definitions.
+ */
+
+#ifndef _XEQTABLEEXPORT_H_
+/*! \def _XEQTABLEEXPORT_H_
+ *  \brief Prevent redundant includes.
+ */
+#define _XEQTABLEEXPORT_H_ 1
+
+// Custom class references
+class EqVar;
+struct EqTableExportVar;
+
+// Qt class references
+#include <qdatetime.h>
+#include <qstring.h>
+
+// Standard include files
+#include <stdio.h>
+
+//------------------------------------------------------------------------------
+/*! \class EqTableExport xeqtableexport.h
+ *
+ *  \brief Formats the two-way output tables as HTML, tab-delimited
+ *  spreadsheet, and compressed columnar files as EqTree::runTable()
+ *  produces each table cell.
+ *
+ *  Each cell value is formatted once and appended to a per-variable spool
+ *  file; writeHtml(), writeSpreadsheet(), and writeColumnar() copy the
+ *  spools into the output files.
+ *
+ *  The columnar file is laid out as (all values in native byte order):
+ *      -# an 8 byte magic string, the format version, and the number of
+ *         rows, columns, and variables,
+ *      -# the row and column variable names and units, and the \a rows row
+ *         values and \a cols column values as doubles,
+ *      -# for each variable, its name, units, kind (1=continuous,
+ *         2=discrete), decimals, item names (discrete only), and the byte
+ *         length of its compressed column,
+ *      -# each variable's compressed column in cell order
+ *         ( cell = col + row * cols ).
+ *  Each string is written as a 32-bit length followed by its characters.
+ *  Continuous values are rounded to their display decimals and discrete
+ *  values are their item ids.  The resulting integers are delta encoded
+ *  from the previous cell, zig-zag mapped, and written as base-128 varints,
+ *  so smooth or repetitive columns shrink to a byte or two per cell.
+ */
+
+class EqTableExport
+{
+// Public methods
+public:
+    EqTableExport( void ) ;
+    ~EqTableExport( void ) ;
+
+    bool   begin( int rows, int cols, EqVar *rowVar, EqVar *colVar,
+                const double *rowValue, const double *colValue,
+                EqVar **var, int vars, bool doRx, bool doBlank,
+                const QString &subtitle ) ;
+    long   bytes( void ) const ;
+    bool   end( void ) ;
+    double seconds( void ) const ;
+    void   storeCell( int row, int col, const double *value, bool inRx ) ;
+    double throughput( void ) const ;
+    bool   writeColumnar( FILE *fptr ) ;
+    bool   writeHtml( FILE *fptr ) ;
+    bool   writeSpreadsheet( FILE *fptr ) ;
+
+    static int axisDecimals( const double *value, int n ) ;
+
+// Protected methods
+protected:
+    bool   copy( FILE *to, FILE *from ) ;
+    const char *format( EqVar *var, double value ) ;
+    void   put( FILE *fptr, const char *str ) ;
+    void   putInt( FILE *fptr, int value ) ;
+    void   putString( FILE *fptr, const QString &str ) ;
+    void   putVarint( FILE *fptr, Q_ULLONG value ) ;
+    void   reset( void ) ;
+    void   writeHtmlHeader( EqTableExportVar *ev ) ;
+    void   writeSpreadsheetHeader( EqTableExportVar *ev ) ;
+
+// Protected data members
+protected:
+    EqTableExportVar *m_var;    //!< Array of exported output variables
+    int         m_vars;         //!< Number of exported output variables
+    int         m_rows;         //!< Number of table rows
+    int         m_cols;         //!< Number of table columns
+    EqVar      *m_rowVar;       //!< Row range variable
+    EqVar      *m_colVar;       //!< Column range variable
+    double     *m_rowValue;     //!< Array of row values
+    double     *m_colValue;     //!< Array of column values
+    char      **m_rowText;      //!< Array of formatted row values
+    char      **m_colText;      //!< Array of formatted column values
+    bool        m_doRx;         //!< Shade cells by prescription
+    bool        m_doBlank;      //!< Blank cells outside the prescription
+    QString     m_subtitle;     //!< HTML table subtitle
+    char        m_buf[1024];    //!< Reusable value formatting buffer
+    long        m_bytes;        //!< Total bytes written
+    int         m_msecs;        //!< Total milliseconds spent exporting
+    QTime       m_timer;        //!< Timer started by begin()
+};
+
+#endif
+
+//------------------------------------------------------------------------------
+//  End of xeqtableexport.h
+//------------------------------------------------------------------------------
+
@@ -0,0 +1,1237 @@
+//------------------------------------------------------------------------------
+/*! \file xeqtrace.cpp
+ *  \version BehavePlus6
+ *  \author Copyright (C) 2002-2018 by Collin D. Bevins.  All rights reserved.
+ *
+ *  \brief Binary ring-buffer EqTree/EqCalc run trace class methods.
+ */
+
+// Custom include files
+#include "appmessage.h"
+#include "xeqtrace.h"
+#include "xeqvar.h"
+#include "xeqvaritem.h"
+
+// Qt include files
+#include <qstringlist.h>
+
+// Standard include files
+#include <string.h>
+
+//------------------------------------------------------------------------------
+/*! \brief Trace file identification and version.
+ */
+
+static const char TraceMagic[8] = { 'B', 'P', '6', 'T', 'R', 'C', 'E', 0 };
+static const int  TraceVersion = 2;
+
+//------------------------------------------------------------------------------
+/*! \brief Indentation of EqCalc function records within the text trace.
+ */
+
+static const char Margin[] = { "        " };
+
+//------------------------------------------------------------------------------
+/*! \enum EqTraceType
+ *  \brief Trace record types.  Each type regenerates one text trace line.
+ */
+
+enum EqTraceType
+{
+    TraceTableBegin=1,      //!< "begin table ..."
+    TraceTableOutput=2,     //!< "  output ..."
+    TraceRowBegin=3,        //!< "  begin row ..."
+    TraceColBegin=4,        //!< "    begin column ..."
+    TraceOutputBegin=5,     //!< "      begin output ..."
+    TraceOutputEnd=6,       //!< "      end output ..."
+    TraceColEnd=7,          //!< "    end column ..."
+    TraceRowEnd=8,          //!< "    end row ..."
+    TraceTableEnd=9,        //!< "end table ..."
+    TraceProc=10,           //!< "begin proc name() inputs outputs"
+    TraceVar=11,            //!< "i|o name nativeValue nativeUnits"
+    TraceValue=12,          //!< "i|o name value nativeUnits"
+    TraceDisplay=13,        //!< "i|o name displayValue decimals displayUnits"
+    TraceRatio=14,          //!< "i|o name displayValue decimals ratio"
+    TraceItem=15,           //!< "i|o name itemIndex itemName"
+    TraceItemZero=16,       //!< "i|o name itemIndex 0 itemName"
+    TraceItemUnits=17,      //!< "i|o name itemIndex nativeUnits"
+    TraceItemName=18,       //!< "i|o name itemName"
+    TracePoint=19,          //!< "x y"
+    TraceVarValue=20        //!< "i|o name nativeValue"
+};
+
+//------------------------------------------------------------------------------
+/*! \struct EqTraceRec
+ *  \brief In-memory ring buffer record.
+ *
+ *  Holds only pointers and values; strings are not resolved until the
+ *  record is flushed or written.
+ */
+
+struct EqTraceRec
+{
+    const void *m_ptr;      //!< EqVar or function name
+    const void *m_ptr2;     //!< Column EqVar, active EqVarItem, or name
+    double      m_value;    //!< Variable value or x coordinate
+    double      m_value2;   //!< y coordinate
+    int         m_type;     //!< EqTraceType
+    int         m_tag;      //!< 'i', 'o', or row/column kind
+    int         m_int;      //!< Index, count, or decimals
+    int         m_int2;     //!< Item id or second count
+};
+
+//------------------------------------------------------------------------------
+/*! \struct EqTraceFileRec
+ *  \brief Resolved trace file record (48 bytes).
+ */
+
+struct EqTraceFileRec
+{
+    int    m_type;          //!< EqTraceType
+    int    m_tag;           //!< 'i', 'o', or row/column kind
+    int    m_int;           //!< Index, count, or decimals
+    int    m_int2;          //!< Item id or second count
+    int    m_str[4];        //!< String table indices, or -1
+    double m_value;         //!< Variable value or x coordinate
+    double m_value2;        //!< y coordinate
+};
+
+//------------------------------------------------------------------------------
+/*! \brief EqTrace constructor.
+ *
+ *  \param capacity Number of records in the ring buffer.
+ */
+
+EqTrace::EqTrace( int capacity ) :
+    m_rec(0),
+    m_capacity( ( capacity > 16 ) ? capacity : 16 ),
+    m_count(0),
+    m_next(0),
+    m_lost(0),
+    m_modules(ModuleAll),
+    m_procOn(true),
+    m_funDict(0),
+    m_fptr(0),
+    m_strDict(0),
+    m_str(0),
+    m_strings(0),
+    m_strAlloc(0),
+    m_strFlushed(0)
+{
+    m_rec = new EqTraceRec[ m_capacity ];
+    checkmem( __FILE__, __LINE__, m_rec, "EqTraceRec m_rec", m_capacity );
+    m_strDict = new QDict<int>( 257 );
+    checkmem( __FILE__, __LINE__, m_strDict, "QDict<int> m_strDict", 1 );
+    m_strDict->setAutoDelete( true );
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief EqTrace destructor.
+ */
+
+EqTrace::~EqTrace( void )
+{
+    close();
+    for ( int i = 0;
+          i < m_strings;
+          i++ )
+    {
+        delete[] m_str[i];
+    }
+    delete[] m_str;     m_str = 0;
+    delete m_strDict;   m_strDict = 0;
+    delete m_funDict;   m_funDict = 0;
+    delete[] m_rec;     m_rec = 0;
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Adds \a str to the string table if not already there.
+ *
+ *  \return Index of \a str in the string table.
+ */
+
+int EqTrace::addString( const QString &str )
+{
+    int *id = m_strDict->find( str );
+    if ( id )
+    {
+        return( *id );
+    }
+    // Grow the string table if necessary
+    if ( m_strings == m_strAlloc )
+    {
+        int alloc = ( m_strAlloc ) ? 2 * m_strAlloc : 256;
+        char **strTable = new char *[ alloc ];
+        checkmem( __FILE__, __LINE__, strTable, "char *strTable", alloc );
+        for ( int i = 0;
+              i < m_strings;
+              i++ )
+        {
+            strTable[i] = m_str[i];
+        }
+        delete[] m_str;
+        m_str = strTable;
+        m_strAlloc = alloc;
+    }
+    const char *latin = str.latin1();
+    int len = ( latin ) ? strlen( latin ) : 0;
+    char *copy = new char[ len + 1 ];
+    checkmem( __FILE__, __LINE__, copy, "char copy", len + 1 );
+    if ( len )
+    {
+        memcpy( copy, latin, len );
+    }
+    copy[len] = 0;
+    m_str[m_strings] = copy;
+    id = new int( m_strings );
+    checkmem( __FILE__, __LINE__, id, "int id", 1 );
+    m_strDict->insert( str, id );
+    return( m_strings++ );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Access to the ring buffer size.
+ *
+ *  \return Number of records the ring buffer holds.
+ */
+
+int EqTrace::capacity( void ) const
+{
+    return( m_capacity );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Discards all buffered records without writing them.
+ */
+
+void EqTrace::clear( void )
+{
+    m_count  = 0;
+    m_next   = 0;
+    m_lost   = 0;
+    m_procOn = true;
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Flushes any buffered records to the attached trace file
+ *  and closes it.
+ *
+ *  Does nothing if no file is attached.
+ *
+ *  \return TRUE on success, FALSE on a write error.
+ */
+
+bool EqTrace::close( void )
+{
+    if ( ! m_fptr )
+    {
+        return( true );
+    }
+    bool ok = flush();
+    if ( fclose( m_fptr ) != 0 )
+    {
+        ok = false;
+    }
+    m_fptr = 0;
+    return( ok );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Checks that a binary trace file decodes to exactly the text of a
+ *  baseline text trace file.
+ *
+ *  The baseline is a text trace written for the same worksheet and inputs,
+ *  either by a release that still fprintf()'d the trace or by an earlier
+ *  convertToText().
+ *
+ *  \param binaryFile   Name of the binary trace file to decode.
+ *  \param textFile     Name of the baseline text trace file.
+ *  \param mismatch     Returns a description of the first differing line.
+ *
+ *  \return TRUE if every decoded line matches the baseline, FALSE if not
+ *  or if either file could not be read.
+ */
+
+bool EqTrace::compare( const QString &binaryFile, const QString &textFile,
+        QString &mismatch )
+{
+    mismatch = "";
+    FILE *base = fopen( textFile.latin1(), "r" );
+    if ( ! base )
+    {
+        mismatch = QString( "unable to read \"%1\"" ).arg( textFile );
+        return( false );
+    }
+    FILE *text = tmpfile();
+    if ( ! text
+      || ! decode( binaryFile, text ) )
+    {
+        mismatch = QString( "unable to decode \"%1\"" ).arg( binaryFile );
+        if ( text )
+        {
+            fclose( text );
+        }
+        fclose( base );
+        return( false );
+    }
+    rewind( text );
+    char baseLine[1024], textLine[1024];
+    const char *b, *t;
+    int line = 0;
+    do
+    {
+        line++;
+        b = fgets( baseLine, sizeof(baseLine), base );
+        t = fgets( textLine, sizeof(textLine), text );
+        if ( ( b == 0 ) != ( t == 0 )
+          || ( b && strcmp( b, t ) != 0 ) )
+        {
+            QString expected = ( b ) ? QString( b ).stripWhiteSpace() : "EOF";
+            QString decoded  = ( t ) ? QString( t ).stripWhiteSpace() : "EOF";
+            mismatch = QString( "line %1: expected \"%2\", decoded \"%3\"" )
+                .arg( line ).arg( expected ).arg( decoded );
+            break;
+        }
+    } while ( b );
+    fclose( text );
+    fclose( base );
+    return( mismatch.isEmpty() );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Regenerates the text trace file from a binary trace file.
+ *
+ *  \param binaryFile   Name of the binary trace file to read.
+ *  \param textFile     Name of the text trace file to write.
+ *
+ *  \return TRUE on success, FALSE on failure.
+ */
+
+bool EqTrace::convertToText( const QString &binaryFile,
+        const QString &textFile )
+{
+    FILE *fptr = fopen( textFile.latin1(), "w" );
+    if ( ! fptr )
+    {
+        return( false );
+    }
+    bool ok = decode( binaryFile, fptr );
+    fclose( fptr );
+    return( ok );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Regenerates the text trace from a binary trace file.
+ *
+ *  \param binaryFile   Name of the binary trace file to read.
+ *  \param fptr         Stream to which the text trace is written.
+ *
+ *  \return TRUE on success, FALSE if the file could not be read or is not
+ *  a trace file.
+ */
+
+bool EqTrace::decode( const QString &binaryFile, FILE *fptr )
+{
+    FILE *in = fopen( binaryFile.latin1(), "rb" );
+    if ( ! in )
+    {
+        return( false );
+    }
+    // Check the file header
+    char magic[8];
+    int version = 0, recSize = 0;
+    if ( fread( magic, 1, 8, in ) != 8
+      || memcmp( magic, TraceMagic, 8 ) != 0
+      || fread( &version, sizeof(int), 1, in ) != 1
+      || version != TraceVersion
+      || fread( &recSize, sizeof(int), 1, in ) != 1
+      || recSize != (int) sizeof(EqTraceFileRec) )
+    {
+        fclose( in );
+        return( false );
+    }
+    // Read and format each block
+    char **str = 0;
+    int strings = 0, strAlloc = 0, n, i, len;
+    bool ok = true;
+    EqTraceFileRec rec;
+    while ( ok && fread( &n, sizeof(int), 1, in ) == 1 )
+    {
+        // Append the block's new strings to the string table
+        if ( strings + n > strAlloc )
+        {
+            int alloc = ( strAlloc ) ? 2 * strAlloc : 256;
+            while ( alloc < strings + n )
+            {
+                alloc *= 2;
+            }
+            char **strTable = new char *[ alloc ];
+            checkmem( __FILE__, __LINE__, strTable, "char *strTable", alloc );
+            for ( i = 0;
+                  i < strings;
+                  i++ )
+            {
+                strTable[i] = str[i];
+            }
+            delete[] str;
+            str = strTable;
+            strAlloc = alloc;
+        }
+        for ( i = 0;
+              ok && i < n;
+              i++ )
+        {
+            if ( fread( &len, sizeof(int), 1, in ) != 1 || len < 0 )
+            {
+                ok = false;
+                break;
+            }
+            str[strings] = new char[ len + 1 ];
+            checkmem( __FILE__, __LINE__, str[strings], "char str", len + 1 );
+            if ( len && (int) fread( str[strings], 1, len, in ) != len )
+            {
+                ok = false;
+            }
+            str[strings++][len] = 0;
+        }
+        // Format the block's records
+        if ( ! ok || fread( &n, sizeof(int), 1, in ) != 1 )
+        {
+            ok = false;
+            break;
+        }
+        for ( i = 0;
+              i < n;
+              i++ )
+        {
+            if ( fread( &rec, sizeof(EqTraceFileRec), 1, in ) != 1 )
+            {
+                ok = false;
+                break;
+            }
+            formatRecord( fptr, &rec, str );
+        }
+    }
+    fclose( in );
+    for ( i = 0;
+          i < strings;
+          i++ )
+    {
+        delete[] str[i];
+    }
+    delete[] str;
+    return( ok );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Logs an EqCalc function input or output variable's display
+ *  value, decimals, and display units.
+ *
+ *  \param name Variable name written to the trace in place of the
+ *  variable's own name, or NULL (see varRec()).
+ */
+
+void EqTrace::display( char tag, EqVar *var, const char *name )
+{
+    varRec( TraceDisplay, tag, var, var->m_displayValue, name );
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Resolves and appends all buffered records to the attached trace
+ *  file as a single block, then empties the ring buffer.
+ *
+ *  Called by next() when the buffer is full and by close().
+ *
+ *  \return TRUE on success, FALSE on a write error.
+ */
+
+bool EqTrace::flush( void )
+{
+    if ( ! m_fptr || m_count == 0 )
+    {
+        return( true );
+    }
+    // Resolve all records first so their strings precede them in the block
+    EqTraceFileRec *out = new EqTraceFileRec[ m_count ];
+    checkmem( __FILE__, __LINE__, out, "EqTraceFileRec out", m_count );
+    int first = ( m_next - m_count + m_capacity ) % m_capacity;
+    int i;
+    for ( i = 0;
+          i < m_count;
+          i++ )
+    {
+        resolve( &m_rec[ ( first + i ) % m_capacity ], &out[i] );
+    }
+    // Write the new strings
+    int n = m_strings - m_strFlushed;
+    fwrite( &n, sizeof(int), 1, m_fptr );
+    for ( i = m_strFlushed;
+          i < m_strings;
+          i++ )
+    {
+        int len = strlen( m_str[i] );
+        fwrite( &len, sizeof(int), 1, m_fptr );
+        fwrite( m_str[i], 1, len, m_fptr );
+    }
+    m_strFlushed = m_strings;
+    // Write the records
+    fwrite( &m_count, sizeof(int), 1, m_fptr );
+    fwrite( out, sizeof(EqTraceFileRec), m_count, m_fptr );
+    delete[] out;
+    m_count = 0;
+    m_next  = 0;
+    return( ferror( m_fptr ) == 0 );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Writes the text trace line for a single resolved record.
+ *
+ *  \param fptr Stream to which the text is written.
+ *  \param rec  Pointer to the resolved record.
+ *  \param str  String table referenced by \a rec.
+ */
+
+void EqTrace::formatRecord( FILE *fptr, const EqTraceFileRec *rec,
+        char **str )
+{
+    const char *s[4];
+    for ( int i = 0;
+          i < 4;
+          i++ )
+    {
+        s[i] = ( rec->m_str[i] >= 0 ) ? str[ rec->m_str[i] ] : "none";
+    }
+    char tag = (char) rec->m_tag;
+    switch ( rec->m_type )
+    {
+    case TraceTableBegin:
+        fprintf( fptr, "begin table %d %s %d %s %d\n",
+            rec->m_int, s[0], rec->m_int2, s[1], (int) rec->m_value );
+        break;
+    case TraceTableOutput:
+        fprintf( fptr, "  output %d %s\n", rec->m_int, s[0] );
+        break;
+    case TraceRowBegin:
+    case TraceColBegin:
+        {
+            const char *what = ( rec->m_type == TraceRowBegin )
+                             ? "  begin row" : "    begin column";
+            if ( tag == 'd' )
+            {
+                fprintf( fptr, "%s %d discrete %s \"%s\" %d \"%s\"\n",
+                    what, rec->m_int, s[0], s[1], rec->m_int2, s[2] );
+            }
+            else if ( tag == 'c' )
+            {
+                fprintf( fptr, "%s %d continuous %s \"%s\" %g \"%s\"\n",
+                    what, rec->m_int, s[0], s[1], rec->m_value, s[2] );
+            }
+            else
+            {
+                fprintf( fptr, "%s %d none\n", what, rec->m_int );
+            }
+        }
+        break;
+    case TraceOutputBegin:
+        fprintf( fptr, "      begin output %d %s \"%s\"\n",
+            rec->m_int, s[0], s[1] );
+        break;
+    case TraceOutputEnd:
+        fprintf( fptr, "      end output %d %s\n", rec->m_int, s[0] );
+        break;
+    case TraceColEnd:
+        fprintf( fptr, "    end column %d %s\n", rec->m_int, s[0] );
+        break;
+    case TraceRowEnd:
+        fprintf( fptr, "    end row %d %s\n", rec->m_int, s[0] );
+        break;
+    case TraceTableEnd:
+        fprintf( fptr, "end table %d %d %d\n",
+            rec->m_int, rec->m_int2, (int) rec->m_value );
+        break;
+    case TraceProc:
+        if ( rec->m_str[1] >= 0 )
+        {
+            fprintf( fptr, "%sbegin proc %s\n", Margin, s[1] );
+        }
+        else
+        {
+            fprintf( fptr, "%sbegin proc %s() %d %d\n", Margin,
+                s[0], rec->m_int, rec->m_int2 );
+        }
+        break;
+    case TraceVarValue:
+        fprintf( fptr, "%s  %c %s %g\n", Margin, tag, s[0], rec->m_value );
+        break;
+    case TraceVar:
+    case TraceValue:
+        fprintf( fptr, "%s  %c %s %g %s\n", Margin, tag,
+            s[0], rec->m_value, s[1] );
+        break;
+    case TraceDisplay:
+        fprintf( fptr, "%s  %c %s %g %d %s\n", Margin, tag,
+            s[0], rec->m_value, rec->m_int, s[1] );
+        break;
+    case TraceRatio:
+        fprintf( fptr, "%s  %c %s %g %d ratio\n", Margin, tag,
+            s[0], rec->m_value, rec->m_int );
+        break;
+    case TraceItem:
+    case TraceItemUnits:
+        fprintf( fptr, "%s  %c %s %d %s\n", Margin, tag,
+            s[0], rec->m_int, s[1] );
+        break;
+    case TraceItemZero:
+        fprintf( fptr, "%s  %c %s %d %d %s\n", Margin, tag,
+            s[0], rec->m_int, 0, s[1] );
+        break;
+    case TraceItemName:
+        fprintf( fptr, "%s  %c %s %s\n", Margin, tag, s[0], s[1] );
+        break;
+    case TracePoint:
+        fprintf( fptr, " %s      %f %f\n", Margin,
+            rec->m_value, rec->m_value2 );
+        break;
+    }
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Logs an EqCalc function input or output discrete variable's
+ *  active item index and name.
+ */
+
+void EqTrace::item( char tag, EqVar *var )
+{
+    varRec( TraceItem, tag, var, 0. );
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Logs an EqCalc function input or output discrete variable's
+ *  active item name.
+ */
+
+void EqTrace::itemName( char tag, EqVar *var )
+{
+    varRec( TraceItemName, tag, var, 0. );
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Logs an EqCalc function input or output discrete variable's
+ *  active item index and native units.
+ */
+
+void EqTrace::itemUnits( char tag, EqVar *var )
+{
+    varRec( TraceItemUnits, tag, var, 0. );
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Logs an EqCalc function input or output discrete variable's
+ *  active item index, a zero decimals field, and its active item name.
+ */
+
+void EqTrace::itemZero( char tag, EqVar *var )
+{
+    varRec( TraceItemZero, tag, var, 0. );
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Access to the number of records overwritten in memory-only mode.
+ *
+ *  \return Number of records lost since the last clear().
+ */
+
+int EqTrace::lost( void ) const
+{
+    return( m_lost );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Claims the next ring buffer slot for a record of \a module.
+ *
+ *  If the buffer is full it is first flushed to the attached file, or,
+ *  if no file is attached, the oldest record is overwritten.
+ *
+ *  \return Pointer to the slot, or NULL if the record is filtered out.
+ */
+
+EqTraceRec *EqTrace::next( int module )
+{
+    if ( ! ( m_modules & module ) )
+    {
+        return( 0 );
+    }
+    if ( ! m_procOn
+      && ( module & ( ModuleInput | ModuleOutput | ModulePoint ) ) )
+    {
+        return( 0 );
+    }
+    if ( m_count == m_capacity )
+    {
+        if ( m_fptr )
+        {
+            flush();
+        }
+        else
+        {
+            m_count--;
+            m_lost++;
+        }
+    }
+    EqTraceRec *rec = &m_rec[ m_next ];
+    memset( rec, 0, sizeof(EqTraceRec) );
+    m_next = ( m_next + 1 ) % m_capacity;
+    m_count++;
+    return( rec );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Attaches the trace to a new binary trace file.
+ *
+ *  Any previously buffered records and strings are discarded.
+ *
+ *  \param fileName Name of the binary trace file to create.
+ *
+ *  \return TRUE on success, FALSE if the file could not be opened.
+ */
+
+bool EqTrace::open( const QString &fileName )
+{
+    close();
+    clear();
+    for ( int i = 0;
+          i < m_strings;
+          i++ )
+    {
+        delete[] m_str[i];
+    }
+    m_strDict->clear();
+    m_strings = m_strFlushed = 0;
+
+    if ( ! ( m_fptr = fopen( fileName.latin1(), "wb" ) ) )
+    {
+        return( false );
+    }
+    int recSize = sizeof(EqTraceFileRec);
+    fwrite( TraceMagic, 1, 8, m_fptr );
+    fwrite( &TraceVersion, sizeof(int), 1, m_fptr );
+    fwrite( &recSize, sizeof(int), 1, m_fptr );
+    return( true );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Logs the start of the calculation of an output variable.
+ */
+
+void EqTrace::outputBegin( int vid, EqVar *var )
+{
+    EqTraceRec *rec = next( ModuleTable );
+    if ( rec )
+    {
+        rec->m_type = TraceOutputBegin;
+        rec->m_ptr  = var;
+        rec->m_int  = vid;
+    }
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Logs the end of the calculation of an output variable.
+ */
+
+void EqTrace::outputEnd( int vid, EqVar *var )
+{
+    EqTraceRec *rec = next( ModuleTable );
+    if ( rec )
+    {
+        rec->m_type = TraceOutputEnd;
+        rec->m_ptr  = var;
+        rec->m_int  = vid;
+    }
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Logs the start of a table column.
+ *
+ *  \param col  Column index.
+ *  \param var  Column range variable, or NULL if there is none.
+ *  \param iid  Item id if \a var is discrete.
+ */
+
+void EqTrace::colBegin( int col, EqVar *var, int iid )
+{
+    EqTraceRec *rec = next( ModuleTable );
+    if ( rec )
+    {
+        rec->m_type  = TraceColBegin;
+        rec->m_ptr   = var;
+        rec->m_int   = col;
+        rec->m_int2  = iid;
+        rec->m_tag   = ( ! var ) ? 'n' : ( var->isDiscrete() ? 'd' : 'c' );
+        rec->m_value = ( var ) ? var->m_nativeValue : 0.;
+    }
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Logs the end of a table column.
+ */
+
+void EqTrace::colEnd( int col, EqVar *var )
+{
+    EqTraceRec *rec = next( ModuleTable );
+    if ( rec )
+    {
+        rec->m_type = TraceColEnd;
+        rec->m_ptr  = var;
+        rec->m_int  = col;
+    }
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Logs an EqCalc function coordinate pair.
+ */
+
+void EqTrace::point( double x, double y )
+{
+    EqTraceRec *rec = next( ModulePoint );
+    if ( rec )
+    {
+        rec->m_type   = TracePoint;
+        rec->m_value  = x;
+        rec->m_value2 = y;
+    }
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Logs the start of an EqCalc function and applies the function
+ *  name filter to all its subsequent input, output, and point records.
+ *
+ *  \param name     Function name, which must be a string literal or
+ *                  otherwise persist until the record is flushed.
+ *  \param inputs   Number of function inputs.
+ *  \param outputs  Number of function outputs.
+ *  \param header   Header text written after "begin proc " in place of
+ *                  "name() inputs outputs" for the few functions whose
+ *                  traditional header differs, or NULL.  Like \a name, it
+ *                  must persist until the record is flushed.
+ */
+
+void EqTrace::proc( const char *name, int inputs, int outputs,
+        const char *header )
+{
+    m_procOn = ( ! m_funDict || m_funDict->find( name ) );
+    if ( ! m_procOn )
+    {
+        return;
+    }
+    EqTraceRec *rec = next( ModuleProc );
+    if ( rec )
+    {
+        rec->m_type = TraceProc;
+        rec->m_ptr  = name;
+        rec->m_ptr2 = header;
+        rec->m_int  = inputs;
+        rec->m_int2 = outputs;
+    }
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Logs an EqCalc function input or output variable's display
+ *  value and decimals with "ratio" units.
+ */
+
+void EqTrace::ratio( char tag, EqVar *var )
+{
+    varRec( TraceRatio, tag, var, var->m_displayValue );
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Resolves an in-memory record's pointers into string table
+ *  indices.
+ *
+ *  \param rec  Pointer to the in-memory record.
+ *  \param out  Pointer to the resolved record to be filled.
+ */
+
+void EqTrace::resolve( const EqTraceRec *rec, EqTraceFileRec *out )
+{
+    out->m_type   = rec->m_type;
+    out->m_tag    = rec->m_tag;
+    out->m_int    = rec->m_int;
+    out->m_int2   = rec->m_int2;
+    out->m_value  = rec->m_value;
+    out->m_value2 = rec->m_value2;
+    out->m_str[0] = out->m_str[1] = out->m_str[2] = out->m_str[3] = -1;
+
+    EqVar *var = (EqVar *) rec->m_ptr;
+    EqVarItem *item = (EqVarItem *) rec->m_ptr2;
+    switch ( rec->m_type )
+    {
+    case TraceTableBegin:
+        if ( var )
+        {
+            out->m_str[0] = addString( var->m_name );
+        }
+        if ( rec->m_ptr2 )
+        {
+            out->m_str[1] = addString( ( (EqVar *) rec->m_ptr2 )->m_name );
+        }
+        break;
+    case TraceRowBegin:
+    case TraceColBegin:
+        if ( var )
+        {
+            out->m_str[0] = addString( var->m_name );
+            out->m_str[1] = addString( *var->m_label );
+            out->m_str[2] = addString( ( rec->m_tag == 'd' )
+                ? var->getItemName( rec->m_int2 ) : var->m_nativeUnits );
+        }
+        break;
+    case TraceOutputBegin:
+        out->m_str[0] = addString( var->m_name );
+        out->m_str[1] = addString( *var->m_label );
+        break;
+    case TraceTableOutput:
+    case TraceOutputEnd:
+    case TraceColEnd:
+    case TraceRowEnd:
+        if ( var )
+        {
+            out->m_str[0] = addString( var->m_name );
+        }
+        break;
+    case TraceProc:
+        out->m_str[0] = addString( QString( (const char *) rec->m_ptr ) );
+        if ( rec->m_ptr2 )
+        {
+            out->m_str[1] = addString(
+                QString( (const char *) rec->m_ptr2 ) );
+        }
+        break;
+    case TraceVar:
+    case TraceValue:
+        out->m_str[0] = addString( ( rec->m_ptr2 )
+            ? QString( (const char *) rec->m_ptr2 ) : var->m_name );
+        out->m_str[1] = addString( var->m_nativeUnits );
+        break;
+    case TraceItemUnits:
+        out->m_str[0] = addString( var->m_name );
+        out->m_str[1] = addString( var->m_nativeUnits );
+        break;
+    case TraceDisplay:
+        out->m_str[0] = addString( ( rec->m_ptr2 )
+            ? QString( (const char *) rec->m_ptr2 ) : var->m_name );
+        out->m_str[1] = addString( var->m_displayUnits );
+        break;
+    case TraceVarValue:
+        out->m_str[0] = addString( var->m_name );
+        break;
+    case TraceRatio:
+        out->m_str[0] = addString( var->m_name );
+        break;
+    case TraceItem:
+    case TraceItemZero:
+    case TraceItemName:
+        out->m_str[0] = addString( var->m_name );
+        out->m_str[1] = addString( item ? item->m_name : var->m_activeItemName );
+        break;
+    }
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Logs the start of a table row.
+ *
+ *  \param row  Row index.
+ *  \param var  Row range variable, or NULL if there is none.
+ *  \param iid  Item id if \a var is discrete.
+ */
+
+void EqTrace::rowBegin( int row, EqVar *var, int iid )
+{
+    EqTraceRec *rec = next( ModuleTable );
+    if ( rec )
+    {
+        rec->m_type  = TraceRowBegin;
+        rec->m_ptr   = var;
+        rec->m_int   = row;
+        rec->m_int2  = iid;
+        rec->m_tag   = ( ! var ) ? 'n' : ( var->isDiscrete() ? 'd' : 'c' );
+        rec->m_value = ( var ) ? var->m_nativeValue : 0.;
+    }
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Logs the end of a table row.
+ */
+
+void EqTrace::rowEnd( int row, EqVar *var )
+{
+    EqTraceRec *rec = next( ModuleTable );
+    if ( rec )
+    {
+        rec->m_type = TraceRowEnd;
+        rec->m_ptr  = var;
+        rec->m_int  = row;
+    }
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Sets the EqCalc function name filter.
+ *
+ *  \param names Comma or white space separated list of function names,
+ *  with or without trailing "()".  If empty, all functions are traced.
+ */
+
+void EqTrace::setFunctions( const QString &names )
+{
+    delete m_funDict;   m_funDict = 0;
+    m_procOn = true;
+    QString list( names );
+    list.replace( ",", " " );
+    list.replace( "()", "" );
+    QStringList tokens = QStringList::split( " ", list.simplifyWhiteSpace() );
+    if ( tokens.isEmpty() )
+    {
+        return;
+    }
+    m_funDict = new QAsciiDict<int>( 61 );
+    checkmem( __FILE__, __LINE__, m_funDict, "QAsciiDict<int> m_funDict", 1 );
+    m_funDict->setAutoDelete( true );
+    for ( QStringList::Iterator it = tokens.begin();
+          it != tokens.end();
+          ++it )
+    {
+        int *on = new int( 1 );
+        checkmem( __FILE__, __LINE__, on, "int on", 1 );
+        m_funDict->replace( (*it).latin1(), on );
+    }
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Sets the module filter.
+ *
+ *  \param names White space separated list of any of "table", "proc",
+ *  "input", "output", "point", "all", or "none".  Unknown names are ignored.
+ */
+
+void EqTrace::setModules( const QString &names )
+{
+    m_modules = 0;
+    QStringList tokens = QStringList::split( " ",
+        names.lower().simplifyWhiteSpace() );
+    for ( QStringList::Iterator it = tokens.begin();
+          it != tokens.end();
+          ++it )
+    {
+        if ( *it == "table" )
+        {
+            m_modules |= ModuleTable;
+        }
+        else if ( *it == "proc" )
+        {
+            m_modules |= ModuleProc;
+        }
+        else if ( *it == "input" )
+        {
+            m_modules |= ModuleInput;
+        }
+        else if ( *it == "output" )
+        {
+            m_modules |= ModuleOutput;
+        }
+        else if ( *it == "point" )
+        {
+            m_modules |= ModulePoint;
+        }
+        else if ( *it == "all" )
+        {
+            m_modules = ModuleAll;
+        }
+        else if ( *it == "none" )
+        {
+            m_modules = 0;
+        }
+    }
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Logs the table header.
+ */
+
+void EqTrace::tableBegin( int rows, EqVar *rowVar, int cols, EqVar *colVar,
+        int vars )
+{
+    EqTraceRec *rec = next( ModuleTable );
+    if ( rec )
+    {
+        rec->m_type  = TraceTableBegin;
+        rec->m_ptr   = rowVar;
+        rec->m_ptr2  = colVar;
+        rec->m_int   = rows;
+        rec->m_int2  = cols;
+        rec->m_value = vars;
+    }
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Logs the table footer.
+ */
+
+void EqTrace::tableEnd( int rows, int cols, int vars )
+{
+    EqTraceRec *rec = next( ModuleTable );
+    if ( rec )
+    {
+        rec->m_type  = TraceTableEnd;
+        rec->m_int   = rows;
+        rec->m_int2  = cols;
+        rec->m_value = vars;
+    }
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Logs one of the table's output variable names.
+ */
+
+void EqTrace::tableOutput( int vid, EqVar *var )
+{
+    EqTraceRec *rec = next( ModuleTable );
+    if ( rec )
+    {
+        rec->m_type = TraceTableOutput;
+        rec->m_ptr  = var;
+        rec->m_int  = vid;
+    }
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Logs an EqCalc function input or output variable with a
+ *  value other than its current native value, in its native units.
+ *
+ *  \param name Variable name written to the trace in place of the
+ *  variable's own name, or NULL (see varRec()).
+ */
+
+void EqTrace::value( char tag, EqVar *var, double value, const char *name )
+{
+    varRec( TraceValue, tag, var, value, name );
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Logs an EqCalc function input or output variable's native value
+ *  and native units.
+ *
+ *  \param name Variable name written to the trace in place of the
+ *  variable's own name, or NULL (see varRec()).
+ */
+
+void EqTrace::var( char tag, EqVar *var, const char *name )
+{
+    varRec( TraceVar, tag, var, var->m_nativeValue, name );
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Logs an EqCalc function input or output variable's native value
+ *  without its units.
+ */
+
+void EqTrace::varValue( char tag, EqVar *var )
+{
+    varRec( TraceVarValue, tag, var, var->m_nativeValue );
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Fills the next ring buffer slot with an EqCalc function input
+ *  or output variable record.
+ *
+ *  Discrete variable records capture the active EqVarItem now, since the
+ *  active item may change before the record is resolved.
+ *
+ *  \param name Name written in place of the variable's own name by a
+ *  TraceVar, TraceValue, or TraceDisplay record, so that the few trace
+ *  lines that never matched their variable's name (such as
+ *  "vSurfaceFireElaspedTime") decode unchanged.  Must be a string literal.
+ */
+
+void EqTrace::varRec( int type, char tag, EqVar *var, double value,
+        const char *name )
+{
+    EqTraceRec *rec = next( ( tag == 'o' ) ? ModuleOutput : ModuleInput );
+    if ( ! rec )
+    {
+        return;
+    }
+    rec->m_type  = type;
+    rec->m_tag   = tag;
+    rec->m_ptr   = var;
+    rec->m_value = value;
+    rec->m_ptr2  = name;
+    rec->m_int   = var->m_displayDecimals;
+    if ( type >= TraceItem && type <= TraceItemName )
+    {
+        EqVarItem *item = ( var->m_itemList )
+            ? var->m_itemList->itemWithName( var->m_activeItemName, false )
+            : 0;
+        rec->m_ptr2 = item;
+        rec->m_int  = ( item ) ? item->m_index : -1;
+    }
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Writes the text trace of all records currently held in the
+ *  ring buffer, oldest first.
+ *
+ *  In memory-only mode this must be called before the EqTree variables
+ *  are changed or destroyed, since their names and units are resolved
+ *  from the variables themselves.
+ *
+ *  \param fptr Stream to which the text trace is written.
+ *
+ *  \return TRUE on success, FALSE on a write error.
+ */
+
+bool EqTrace::writeText( FILE *fptr )
+{
+    EqTraceFileRec out;
+    int first = ( m_next - m_count + m_capacity ) % m_capacity;
+    for ( int i = 0;
+          i < m_count;
+          i++ )
+    {
+        resolve( &m_rec[ ( first + i ) % m_capacity ], &out );
+        formatRecord( fptr, &out, m_str );
+    }
+    return( ferror( fptr ) == 0 );
+}
+
+//------------------------------------------------------------------------------
+//  End of xeqtrace.cpp
+//------------------------------------------------------------------------------
+
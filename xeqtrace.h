@@ -0,0 +1,174 @@
+//------------------------------------------------------------------------------
+/*! \file xeqtrace.h
+ *  \version BehavePlus6
+ *  \author Copyright (C) 2002-2018 by Collin D. Bevins.  All rights reserved.
+ *
+ *  \brief Binary ring-buffer EqTree/EqCalc run trace class definitions.
+ */
+
+#ifndef _XEQTRACE_H_
+/*! \def _XEQTRACE_H_
+ *  \brief Prevent redundant includes.
+ */
+#define _XEQTRACE_H_ 1
+
+// Custom class references
+class EqVar;
+struct EqTraceRec;
+struct EqTraceFileRec;
+
+// Qt class references
+#include <qasciidict.h>
+#include <qdict.h>
+#include <qstring.h>
+
+// Standard include files
+#include <stdio.h>
+
+//------------------------------------------------------------------------------
+/*! \def EQTRACE_ON
+ *  \brief Guards every trace call site.
+ *
+ *  All EqTree and EqCalc trace calls are written as
+ *  \code
+ *  if ( EQTRACE_ON( m_trace ) )
+ *  {
+ *      m_trace->proc( "FireArea", 2, 1 );
+ *      ...
+ *  }
+ *  \endcode
+ *  so that defining BP6_NO_TRACE at compile time reduces every call site
+ *  to dead code that the compiler removes entirely.
+ */
+
+#ifdef BP6_NO_TRACE
+#define EQTRACE_ON(trace) (0)
+#else
+#define EQTRACE_ON(trace) (trace)
+#endif
+
+//------------------------------------------------------------------------------
+/*! \class EqTrace xeqtrace.h
+ *
+ *  \brief Records the EqTree::runTable() and EqCalc trace as fixed size
+ *  binary records in a ring buffer.
+ *
+ *  If the trace is attached to a file by open(), the full ring buffer is
+ *  resolved and appended to the file as a single block, and decode() or
+ *  convertToText() regenerate the traditional text trace from the file.
+ *  If no file is attached, the buffer wraps and keeps only the most
+ *  recent records, which writeText() formats on demand.
+ *
+ *  Records may be filtered by module (see setModules()) and by EqCalc
+ *  function name (see setFunctions()).  When a function is filtered out,
+ *  all its input, output, and point records are filtered out with it.
+ *
+ *  The binary file is laid out as (all values in native byte order):
+ *      -# an 8 byte magic string, the format version, and the record size,
+ *      -# any number of blocks, each consisting of the count and text of
+ *         the strings first referenced by the block, followed by the count
+ *         and contents of the block's EqTraceFileRec records.
+ */
+
+class EqTrace
+{
+// Public enums
+public:
+    /*! \enum Module
+     *  \brief Trace record filter flags.
+     */
+    enum Module
+    {
+        ModuleTable=1,      //!< EqTree table, row, column, and output records
+        ModuleProc=2,       //!< EqCalc "begin proc" records
+        ModuleInput=4,      //!< EqCalc function input records
+        ModuleOutput=8,     //!< EqCalc function output records
+        ModulePoint=16,     //!< EqCalc function coordinate records
+        ModuleAll=31        //!< All of the above
+    };
+
+// Public methods
+public:
+    EqTrace( int capacity=4096 ) ;
+    ~EqTrace( void ) ;
+
+    // Control methods
+    int    capacity( void ) const ;
+    void   clear( void ) ;
+    bool   close( void ) ;
+    int    lost( void ) const ;
+    bool   open( const QString &fileName ) ;
+    void   setFunctions( const QString &names ) ;
+    void   setModules( const QString &names ) ;
+    bool   writeText( FILE *fptr ) ;
+
+    // EqTree table record methods
+    void   outputBegin( int vid, EqVar *var ) ;
+    void   outputEnd( int vid, EqVar *var ) ;
+    void   colBegin( int col, EqVar *var, int iid ) ;
+    void   colEnd( int col, EqVar *var ) ;
+    void   rowBegin( int row, EqVar *var, int iid ) ;
+    void   rowEnd( int row, EqVar *var ) ;
+    void   tableBegin( int rows, EqVar *rowVar, int cols, EqVar *colVar,
+                int vars ) ;
+    void   tableEnd( int rows, int cols, int vars ) ;
+    void   tableOutput( int vid, EqVar *var ) ;
+
+    // EqCalc function record methods
+    void   display( char tag, EqVar *var, const char *name=0 ) ;
+    void   item( char tag, EqVar *var ) ;
+    void   itemName( char tag, EqVar *var ) ;
+    void   itemUnits( char tag, EqVar *var ) ;
+    void   itemZero( char tag, EqVar *var ) ;
+    void   point( double x, double y ) ;
+    void   proc( const char *name, int inputs, int outputs,
+                const char *header=0 ) ;
+    void   ratio( char tag, EqVar *var ) ;
+    void   value( char tag, EqVar *var, double value,
+                const char *name=0 ) ;
+    void   var( char tag, EqVar *var, const char *name=0 ) ;
+    void   varValue( char tag, EqVar *var ) ;
+
+    static bool compare( const QString &binaryFile,
+                    const QString &textFile, QString &mismatch ) ;
+    static bool convertToText( const QString &binaryFile,
+                    const QString &textFile ) ;
+    static bool decode( const QString &binaryFile, FILE *fptr ) ;
+
+// Protected methods
+protected:
+    int    addString( const QString &str ) ;
+    bool   flush( void ) ;
+    EqTraceRec *next( int module ) ;
+    void   resolve( const EqTraceRec *rec, EqTraceFileRec *out ) ;
+    void   varRec( int type, char tag, EqVar *var, double value,
+                const char *name=0 ) ;
+
+    static void formatRecord( FILE *fptr, const EqTraceFileRec *rec,
+                    char **str ) ;
+
+// Protected data members
+protected:
+    EqTraceRec *m_rec;          //!< Ring buffer of trace records
+    int         m_capacity;     //!< Size of the m_rec[] ring buffer
+    int         m_count;        //!< Number of records in m_rec[]
+    int         m_next;         //!< Index of the next m_rec[] slot
+    int         m_lost;         //!< Records overwritten in memory-only mode
+    int         m_modules;      //!< Bitwise OR of enabled Module flags
+    bool        m_procOn;       //!< TRUE if the current function is enabled
+    QAsciiDict<int> *m_funDict; //!< Enabled function names, or NULL for all
+    FILE       *m_fptr;         //!< Attached binary trace file stream
+    // String table
+    QDict<int> *m_strDict;      //!< String table lookup
+    char      **m_str;          //!< String table contents
+    int         m_strings;      //!< Number of strings in the string table
+    int         m_strAlloc;     //!< Allocated size of m_str[]
+    int         m_strFlushed;   //!< Number of strings already written
+};
+
+#endif
+
+//------------------------------------------------------------------------------
+//  End of xeqtrace.h
+//------------------------------------------------------------------------------
+
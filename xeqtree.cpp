@@ -20,6 +20,12 @@
 #include "rxvar.h"
 #include "xeqapp.h"
 #include "xeqcalc.h"
+#include "xeqdiskcache.h"
+#include "xeqresultcache.h"
+#include "xeqresultstore.h"
+#include "xeqspreadprofile.h"
+#include "xeqtableexport.h"
+#include "xeqtrace.h"
 #include "xeqtree.h"
 #include "xeqtreeparser.h"
 #include "xeqvar.h"
@@ -31,7 +37,9 @@
 #include <qdatetime.h>
 
 // Standard include files
+#include <math.h>
 #include <stdlib.h>
+#include <string.h>
 #include <iostream>
 
 //------------------------------------------------------------------------------
@@ -89,10 +97,16 @@ EqTree::EqTree( EqApp *eqApp, const QString &name, int funCount, int funPrime,
     m_tableVal(0),
     m_tableInRx(0),
     m_tableVar(0),
+    m_tableSlice(""),
     m_resultFile(""),
     m_traceFile(""),
-    m_resultFptr(0),
-    m_traceFptr(0)
+    m_profileFile(""),
+    m_resultStore(0),
+    m_spreadProfile(0),
+    m_trace(0),
+    m_tableExport(0),
+    m_resultCache(0),
+    m_diskCache(0)
 {
     // Allocate all dynamic storage
     QString text("");
@@ -112,6 +126,13 @@ EqTree::EqTree( EqApp *eqApp, const QString &name, int funCount, int funPrime,
     checkmem( __FILE__, __LINE__, m_rangeVar, "EqVar *m_rangeVar",
         m_maxRangeVars );
 
+    m_resultCache = new EqResultCache();
+    checkmem( __FILE__, __LINE__, m_resultCache, "EqResultCache m_resultCache",
+        1 );
+
+    m_diskCache = new EqDiskCache();
+    checkmem( __FILE__, __LINE__, m_diskCache, "EqDiskCache m_diskCache", 1 );
+
     // Create local dictionaries
     m_funDict = new QDict<EqFun>( funPrime, true );
     Q_CHECK_PTR( m_funDict );
@@ -283,6 +304,12 @@ EqTree::EqTree( EqApp *eqApp, const QString &name, int funCount, int funPrime,
 EqTree::~EqTree( void )
 {
     //runClean();
+    delete   m_resultStore; m_resultStore = 0;
+    delete   m_spreadProfile; m_spreadProfile = 0;
+    delete   m_trace;       m_trace = 0;
+    delete   m_tableExport; m_tableExport = 0;
+    delete   m_resultCache; m_resultCache = 0;
+    delete   m_diskCache;   m_diskCache = 0;
     delete   m_rxVarList;   m_rxVarList = 0;
     delete   m_eqCalc;      m_eqCalc = 0;
     delete[] m_fun;         m_fun = 0;
@@ -876,6 +903,53 @@ int EqTree_OutOrderCompare( const void *s1, const void *s2 )
     return ( strcmp( (*v1)->m_outOrder.latin1(), (*v2)->m_outOrder.latin1() ) );
 }
 
+//------------------------------------------------------------------------------
+/*! \brief qsort() comparison function used to sort graph interval scores
+ *  into descending order.  Called only by qsort() on behalf of
+ *  runTableRefine().
+ *
+ *  \return  -1, 0, or 1 as required by qsort().
+ */
+
+int EqTree_ScoreCompare( const void *s1, const void *s2 )
+{
+    double d1 = *(const double *) s1;
+    double d2 = *(const double *) s2;
+    return( ( d1 > d2 ) ? -1 : ( ( d1 < d2 ) ? 1 : 0 ) );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Checks the closed binary trace file against the baseline text
+ *  trace named by the "docTraceBaseline" property, if any.
+ *
+ *  Lets a developer confirm that EqTrace::decode() still regenerates the
+ *  traditional text trace for a worksheet whose baseline trace was saved
+ *  earlier.  The first differing line is reported in a warning dialog.
+ *
+ *  Usually called only by EqTree::runTable().
+ *
+ *  \return TRUE if there is no baseline or the trace matches it.
+ */
+
+bool EqTree::traceFileCheck( void )
+{
+    QString baseline = m_propDict->string( "docTraceBaseline" );
+    if ( baseline.isEmpty()
+      || m_traceFile.isEmpty() )
+    {
+        return( true );
+    }
+    QString mismatch("");
+    if ( EqTrace::compare( m_traceFile, baseline, mismatch ) )
+    {
+        return( true );
+    }
+    QString msg("");
+    translate( msg, "EqTree:TraceMismatch", baseline, mismatch );
+    warn( msg );
+    return( false );
+}
+
 //------------------------------------------------------------------------------
 /*! \brief Closes the temporary EqTree trace file if it is open.
  *
@@ -886,17 +960,22 @@ int EqTree_OutOrderCompare( const void *s1, const void *s2 )
 
 void EqTree::traceFileClose( void )
 {
-    // Close the file if it is open.
-    if ( m_traceFptr )
+    // Flush and close the file if it is open.
+    if ( m_trace )
     {
-        fclose( m_traceFptr );
-        m_traceFptr = m_eqCalc->m_log = 0;
+        m_trace->close();
     }
+    m_eqCalc->m_trace = 0;
     return;
 }
 
 //------------------------------------------------------------------------------
-/*! \brief Opens a new temporary EqTree log file.
+/*! \brief Opens a new temporary EqTree binary trace file.
+ *
+ *  The trace ring buffer size and its module and function filters are set
+ *  from the "docTraceBufferSize", "docTraceModules", and
+ *  "docTraceFunctions" properties.  Use EqTrace::decode() to regenerate
+ *  the text trace from the file.
  *
  *  Usually called only by EqTree::runTable().
  *
@@ -908,9 +987,20 @@ bool EqTree::traceFileInit( const QString &fileName )
     // Close the file if it is open.
     traceFileClose();
 
+    // (Re)create the trace recorder if the buffer size has changed.
+    int records = m_propDict->integer( "docTraceBufferSize" );
+    if ( ! m_trace || m_trace->capacity() != records )
+    {
+        delete m_trace;
+        m_trace = new EqTrace( records );
+        checkmem( __FILE__, __LINE__, m_trace, "EqTrace m_trace", 1 );
+    }
+    m_trace->setModules( m_propDict->string( "docTraceModules" ) );
+    m_trace->setFunctions( m_propDict->string( "docTraceFunctions" ) );
+
     // Get the file name and try to open it.
     m_traceFile = fileName;
-    if ( ! ( m_traceFptr = fopen( m_traceFile.latin1(), "w" ) ) )
+    if ( ! m_trace->open( m_traceFile ) )
     // This code block should never be executed!
     {
         QString msg("");
@@ -919,8 +1009,8 @@ bool EqTree::traceFileInit( const QString &fileName )
         m_traceFile = "";
         return( false );
     }
-    // Let EqCalc know about the file stream
-    m_eqCalc->m_log = m_traceFptr;
+    // Let EqCalc know about the trace
+    m_eqCalc->m_trace = m_trace;
     return( true );
 }
 
@@ -1096,7 +1186,8 @@ int EqTree::rangeCase( void )
 }
 
 //------------------------------------------------------------------------------
-/*! \brief Closes the temporary EqTree result file if it is open.
+/*! \brief Closes the temporary EqTree result file (and any spread profile
+ *  file) if it is open.
  *
  *  Usually called only by EqTree::runTable().
  *  Note that the m_resultFile member is not cleared since other functions
@@ -1105,11 +1196,18 @@ int EqTree::rangeCase( void )
 
 void EqTree::resultFileClose( void )
 {
-    // Close the file if it is open.
-    if ( m_resultFptr )
+    // Write the columns and close the file if it is open.
+    if ( m_resultStore )
+    {
+        m_resultStore->close();
+        delete m_resultStore;
+        m_resultStore = 0;
+    }
+    if ( m_spreadProfile )
     {
-        fclose( m_resultFptr );
-        m_resultFptr = 0;
+        m_spreadProfile->close();
+        delete m_spreadProfile;
+        m_spreadProfile = 0;
     }
     return;
 }
@@ -1117,7 +1215,13 @@ void EqTree::resultFileClose( void )
 //------------------------------------------------------------------------------
 /*! \brief Opens a new temporary EqTree result file.
  *
- *  Usually called only by EqTree::runTable().
+ *  The result file is a columnar binary EqResultStore holding the value of
+ *  every EqVar for every table cell.  Use EqResultStore::open() to read it,
+ *  or EqResultStore::convertToText() to get the old text format.
+ *  If #m_profileFile is set, the surface fire spread profiles of each cell
+ *  are written to that EqSpreadProfile file alongside it.
+ *
+ *  Usually called only by EqTree::runTable() after EqTree::runInit().
  *
  *  \return TRUE on success, FALSE on failure.
  */
@@ -1129,15 +1233,35 @@ bool EqTree::resultFileInit( const QString &fileName )
 
     // Get the file name and try to open it.
     m_resultFile = fileName;
-    if ( ! ( m_resultFptr = fopen( m_resultFile.latin1(), "w" ) ) )
+    m_resultStore = new EqResultStore();
+    checkmem( __FILE__, __LINE__, m_resultStore, "EqResultStore m_resultStore", 1 );
+    if ( ! m_resultStore->create( m_resultFile, m_tableRows, m_tableCols,
+            m_rangeVar[0], m_rangeVar[1], m_var, m_varCount ) )
     // This code block should never be executed!
     {
+        delete m_resultStore;
+        m_resultStore = 0;
         QString msg("");
         translate( msg, "EqTree:UnopenedResultFile", m_resultFile );
         error( msg );
         m_resultFile = "";
         return( false );
     }
+    // Single fuel model surface fire runs also export their spread profiles.
+    if ( ! m_profileFile.isEmpty()
+      && m_propDict->boolean( "surfaceModuleActive" )
+      && m_eqCalc->fSurfaceFireSpreadAtHead->m_active )
+    {
+        m_spreadProfile = new EqSpreadProfile();
+        checkmem( __FILE__, __LINE__, m_spreadProfile,
+            "EqSpreadProfile m_spreadProfile", 1 );
+        if ( ! m_spreadProfile->create( m_profileFile, m_tableRows,
+                m_tableCols ) )
+        {
+            delete m_spreadProfile;
+            m_spreadProfile = 0;
+        }
+    }
     return( true );
 }
 
@@ -1199,10 +1323,54 @@ void EqTree::runClean( void )
     delete[] m_tableVal;    m_tableVal = 0;
     delete[] m_tableInRx;   m_tableInRx = 0;
     delete[] m_tableVar;    m_tableVar = 0;
+    delete   m_tableExport; m_tableExport = 0;
     m_tableVars = m_tableCols = m_tableRows = m_tableCells = 0;
+    m_tableSlice = "";
     return;
 }
 
+//------------------------------------------------------------------------------
+/*! \brief Moves the current run's table arrays into a new EqTreeRun.
+ *
+ *  The EqTree's table arrays are set to NULL so the next runClean() or
+ *  runInit() does not free them, while its range variables are copied so
+ *  they remain valid for the EqTree.
+ *
+ *  Called only by BpDocument::runWorksheet().
+ *
+ *  \return Pointer to a new EqTreeRun, which the caller must delete.
+ */
+
+EqTreeRun *EqTree::runDetach( void )
+{
+    EqTreeRun *run = new EqTreeRun( m_maxRangeVars );
+    checkmem( __FILE__, __LINE__, run, "EqTreeRun run", 1 );
+    for ( int i = 0;
+          i < m_maxRangeVars;
+          i++ )
+    {
+        run->m_rangeVar[i] = m_rangeVar[i];
+    }
+    run->m_rangeVars  = m_rangeVars;
+    run->m_rangeCase  = m_rangeCase;
+    run->m_tableRows  = m_tableRows;
+    run->m_tableCols  = m_tableCols;
+    run->m_tableVars  = m_tableVars;
+    run->m_tableCells = m_tableCells;
+    run->m_tableCol   = m_tableCol;
+    run->m_tableRow   = m_tableRow;
+    run->m_tableVal   = m_tableVal;
+    run->m_tableInRx  = m_tableInRx;
+    run->m_tableVar   = m_tableVar;
+    run->m_tableSlice = m_tableSlice;
+    m_tableRow = m_tableCol = m_tableVal = 0;
+    m_tableInRx = 0;
+    m_tableVar = 0;
+    m_tableVars = m_tableCols = m_tableRows = m_tableCells = 0;
+    m_tableSlice = "";
+    return( run );
+}
+
 //------------------------------------------------------------------------------
 /*! \brief Performs the necessary initialization determine all the outputs for
  *  the current set of tables.
@@ -1314,6 +1482,10 @@ void EqTree::runInitColsFromStore( void )
  *  from the row variable's m_store minimum and maximum value and from the
  *  current "graphLinepoints" property.
  *
+ *  If the m_resultCache holds a table run with the same row variable,
+ *  the nearest x-axis value to each of its row values is replaced by that
+ *  row value.
+ *
  *  The row variable is pointed to by m_rangeVar[0],
  *  which is set by the most recent call to EqTree::rangeCase()
  *  and must always point to a valid EqVar, even if it is not multi-valued.
@@ -1340,12 +1512,27 @@ void EqTree::runInitRowsFromRange( void )
     xStep = (xMax - xMin) / ( m_tableRows - 1 );
 
     // Fill the row array
-    for ( int row = 0;
+    int row;
+    for ( row = 0;
           row < m_tableRows;
           row++ )
     {
         m_tableRow[row] = xMin + row * xStep;
     }
+    // Move the nearest x-axis values onto any row variable values
+    // of a preceding table run, so the graph run can reuse its cells.
+    int cached;
+    const double *value = m_resultCache->values( rowVar, &cached );
+    for ( int i = 0;
+          i < cached && xStep > 0.;
+          i++ )
+    {
+        if ( value[i] >= xMin && value[i] <= xMax )
+        {
+            row = (int) ( ( value[i] - xMin ) / xStep + 0.5 );
+            m_tableRow[row] = value[i];
+        }
+    }
     return;
 }
 
@@ -1462,6 +1649,52 @@ bool EqTree::runInitTableVars( void )
     return( true );
 }
 
+//------------------------------------------------------------------------------
+/*! \brief Exchanges the EqTree's current run table arrays and range
+ *  variables with those held by \a run.
+ *
+ *  Calling runSwap() a second time with the same \a run restores the
+ *  EqTree to its original state.
+ *
+ *  Called only by BpDocument::composePending().
+ *
+ *  \param run Pointer to an EqTreeRun created by runDetach().
+ */
+
+void EqTree::runSwap( EqTreeRun *run )
+{
+    EqVar *var;
+    for ( int i = 0;
+          i < m_maxRangeVars && i < run->m_maxRangeVars;
+          i++ )
+    {
+        var = m_rangeVar[i];
+        m_rangeVar[i] = run->m_rangeVar[i];
+        run->m_rangeVar[i] = var;
+    }
+    int n;
+    n = m_rangeVars;    m_rangeVars  = run->m_rangeVars;    run->m_rangeVars  = n;
+    n = m_rangeCase;    m_rangeCase  = run->m_rangeCase;    run->m_rangeCase  = n;
+    n = m_tableRows;    m_tableRows  = run->m_tableRows;    run->m_tableRows  = n;
+    n = m_tableCols;    m_tableCols  = run->m_tableCols;    run->m_tableCols  = n;
+    n = m_tableVars;    m_tableVars  = run->m_tableVars;    run->m_tableVars  = n;
+    n = m_tableCells;   m_tableCells = run->m_tableCells;   run->m_tableCells = n;
+    double *dp;
+    dp = m_tableCol;    m_tableCol = run->m_tableCol;   run->m_tableCol = dp;
+    dp = m_tableRow;    m_tableRow = run->m_tableRow;   run->m_tableRow = dp;
+    dp = m_tableVal;    m_tableVal = run->m_tableVal;   run->m_tableVal = dp;
+    bool *bp = m_tableInRx;
+    m_tableInRx = run->m_tableInRx;
+    run->m_tableInRx = bp;
+    EqVar **vp = m_tableVar;
+    m_tableVar = run->m_tableVar;
+    run->m_tableVar = vp;
+    QString slice = m_tableSlice;
+    m_tableSlice = run->m_tableSlice;
+    run->m_tableSlice = slice;
+    return;
+}
+
 //------------------------------------------------------------------------------
 /*! \brief Creates a table of results from the current input values and range
  *  variables.
@@ -1474,6 +1707,9 @@ bool EqTree::runInitTableVars( void )
  *                      select n equi-distant computation points suitable
  *                      for generating graph results.
  *
+ *  Runs that are not traced, have no result file, and have no diagram
+ *  outputs look up each cell in the m_diskCache before calculating it.
+ *
  *  Called only by EqTree::run() or BpDocument::runWorksheet().
  *
  *  \return TRUE on success, FALSE on failure.
@@ -1503,23 +1739,20 @@ bool EqTree::runTable( const QString &traceFile, const QString &resultFile,
             return( false );
         }
         // Log the table header
-        fprintf( m_traceFptr, "begin table %d %s %d %s %d\n",
-            m_tableRows,
-            ( rowVar ? rowVar->m_name.latin1() : "none" ),
-            m_tableCols,
-            ( colVar ? colVar->m_name.latin1() : "none" ),
+        m_trace->tableBegin( m_tableRows, rowVar, m_tableCols, colVar,
             m_tableVars );
         // Log the output variable names
         for ( vid = 0;
               vid < m_tableVars;
               vid++ )
         {
-            outVar = m_tableVar[ vid ];
-            fprintf( m_traceFptr, "  output %d %s\n",
-                vid, outVar->m_name.latin1() );
+            m_trace->tableOutput( vid, m_tableVar[ vid ] );
         }
     }
 
+    // Trace recorder, or NULL if not tracing
+    EqTrace *trace = m_eqCalc->m_trace;
+
     // Attempt to open a new copy of the result file
     if ( ! graphTable
       && ! resultFile.isNull()
@@ -1530,11 +1763,22 @@ bool EqTree::runTable( const QString &traceFile, const QString &resultFile,
             traceFileClose();
             return( false );
         }
-        fprintf( m_resultFptr,
-            "ROWS %d COLS %d VARS %d\n",
-            m_tableRows,
-            m_tableCols,
-            m_varCount );
+    }
+
+    // Two-way tables are exported as each cell is calculated.
+    if ( ! graphTable && rowVar && colVar )
+    {
+        m_tableExport = new EqTableExport();
+        checkmem( __FILE__, __LINE__, m_tableExport,
+            "EqTableExport m_tableExport", 1 );
+        if ( ! m_tableExport->begin( m_tableRows, m_tableCols, rowVar, colVar,
+                m_tableRow, m_tableCol, m_tableVar, m_tableVars,
+                m_propDict->boolean( "tableShading" ),
+                m_propDict->boolean( "tableShadingBlank" ),
+                m_eqCalc->getSubtitle() ) )
+        {
+            delete m_tableExport;   m_tableExport = 0;
+        }
     }
 
     // Set up the progress dialog.
@@ -1551,9 +1795,33 @@ bool EqTree::runTable( const QString &traceFile, const QString &resultFile,
     progress->setMinimumDuration( 0 );
     progress->setProgress( 0 );
 
+    // Graph runs may reuse the cells already calculated by the table run.
+    // (Graph runs are never traced or stored to a result file.)
+    bool useCache = graphTable
+        && m_resultCache->begin( rowVar, colVar, m_tableVar, m_tableVars );
+    int cacheRow = -1;
+
+    // Runs may reuse cells calculated by earlier runs and kept on disk.
+    // The disk cache keeps only the output values, so it is not used by
+    // traced runs, by runs that store every variable in the result file,
+    // or by runs with diagrams (which are composed from the result file).
+    bool useDisk = ! EQTRACE_ON( trace ) && ! m_resultStore;
+    for ( vid = 0;
+          useDisk && vid < m_tableVars;
+          vid++ )
+    {
+        if ( m_tableVar[ vid ]->isDiagram() )
+        {
+            useDisk = false;
+        }
+    }
+    useDisk = useDisk
+        && m_diskCache->begin( this, m_tableVar, m_tableVars );
+
     // Make an Equation Tree run for every table cell
     // Loop for each table row or graph x-axis variable.
     RxVar *rxVar;
+    int cellVar;
     for ( step = 0, var = 0, row = 0, cell = 0;
           row < m_tableRows;
           row++ )
@@ -1566,74 +1834,54 @@ bool EqTree::runTable( const QString &traceFile, const QString &resultFile,
                 iid = (int) m_tableRow[ row ];
                 // Get the item name for this id and make it the current item.
                 rowVar->setItemName( rowVar->getItemName( iid ) );
-                if ( m_traceFptr )
-                {
-                    fprintf( m_traceFptr,
-                        "  begin row %d discrete %s \"%s\" %d \"%s\"\n",
-                        row,
-                        rowVar->m_name.latin1(),
-                        rowVar->m_label->latin1(),
-                        iid,
-                        rowVar->getItemName( iid ).latin1() );
-                }
-                if ( ! graphTable
-                  && m_resultFptr )
+                if ( EQTRACE_ON( trace ) )
                 {
-                    fprintf( m_resultFptr,
-                        "ROW %d %s disc %s\n",
-                        row+1,
-                        rowVar->m_name.latin1(),
-                        rowVar->getItemName( iid ).latin1() );
+                    trace->rowBegin( row, rowVar, iid );
                 }
             }
             else if ( rowVar->isContinuous() )
             {
                 rowVar->setDisplayValue( m_tableRow[ row ] );
-                if ( m_traceFptr )
+                if ( EQTRACE_ON( trace ) )
                 {
-                    fprintf( m_traceFptr,
-                        "  begin row %d continuous %s \"%s\" %g \"%s\"\n",
-                        row,
-                        rowVar->m_name.latin1(),
-                        rowVar->m_label->latin1(),
-                        rowVar->m_nativeValue,
-                        rowVar->m_nativeUnits.latin1() );
-                }
-                if ( ! graphTable
-                  && m_resultFptr )
-                {
-                    fprintf( m_resultFptr,
-                        "ROW %d %s cont %g %s\n",
-                        row+1,
-                        rowVar->m_name.latin1(),
-                        rowVar->m_displayValue,
-                        rowVar->m_displayUnits.latin1() );
+                    trace->rowBegin( row, rowVar, -1 );
                 }
             }
-            else
+            // Store this row's value in the result file.
+            if ( m_resultStore )
             {
-                if ( ! graphTable
-                  && m_resultFptr )
-                {
-                    fprintf( m_resultFptr,
-                        "ROW %d %s othr\n",
-                        row+1,
-                        rowVar->m_name.latin1() );
-                }
+                m_resultStore->storeRow( row );
             }
         }
         else // if ( ! rowVar )
         {
-            if ( m_traceFptr )
+            if ( EQTRACE_ON( trace ) )
             {
-                fprintf( m_traceFptr, "  begin row %d none\n", row );
+                trace->rowBegin( row, 0, -1 );
             }
         }
+        if ( useCache )
+        {
+            cacheRow = m_resultCache->find( rowVar,
+                ( rowVar ) ? m_tableRow[ row ] : 0. );
+        }
         // Loop for each table column or graph z-axis variable.
         for ( col = 0;
               col < m_tableCols;
               col++, cell++ )
         {
+            // Reuse this cell's outputs if the table run calculated them.
+            if ( useCache
+              && m_resultCache->fetch( cacheRow,
+                    m_resultCache->find( colVar,
+                        ( colVar ) ? m_tableCol[ col ] : 0. ),
+                    &m_tableVal[ var ], &m_tableInRx[ cell ] ) )
+            {
+                var  += m_tableVars;
+                step += m_tableVars;
+                progress->setProgress( step );
+                continue;
+            }
             if ( colVar )
             {
                 // Set this column's input value.
@@ -1642,69 +1890,47 @@ bool EqTree::runTable( const QString &traceFile, const QString &resultFile,
                     iid = (int) m_tableCol[ col ];
                     // Get the item name for this id and make it the current item.
                     colVar->setItemName( colVar->getItemName( iid ) );
-                    if ( m_traceFptr )
+                    if ( EQTRACE_ON( trace ) )
                     {
-                        fprintf( m_traceFptr,
-                            "    begin column %d discrete %s \"%s\" %d \"%s\"\n",
-                            col,
-                            colVar->m_name.latin1(),
-                            colVar->m_label->latin1(),
-                            iid,
-                            colVar->getItemName( iid ).latin1() );
-                    }
-                    if ( ! graphTable
-                      && m_resultFptr )
-                    {
-                        fprintf( m_resultFptr,
-                            "COL %d %s disc %s\n",
-                            col+1,
-                            colVar->m_name.latin1(),
-                            colVar->getItemName( iid ).latin1() );
+                        trace->colBegin( col, colVar, iid );
                     }
                 }
                 else if ( colVar->isContinuous() )
                 {
                     colVar->setDisplayValue( m_tableCol[ col ] );
-                    if ( m_traceFptr )
+                    if ( EQTRACE_ON( trace ) )
                     {
-                        fprintf( m_traceFptr,
-                            "    begin column %d continuous %s \"%s\" %g \"%s\"\n",
-                            col,
-                            colVar->m_name.latin1(),
-                            colVar->m_label->latin1(),
-                            colVar->m_nativeValue,
-                            colVar->m_nativeUnits.latin1() );
-                    }
-                    if ( ! graphTable
-                      && m_resultFptr )
-                    {
-                        fprintf( m_resultFptr,
-                            "COL %d %s cont %g %s\n",
-                            col+1,
-                            colVar->m_name.latin1(),
-                            colVar->m_displayValue,
-                            colVar->m_displayUnits.latin1() );
+                        trace->colBegin( col, colVar, -1 );
                     }
                 }
-                else
+                // Store this column's value in the result file.
+                if ( m_resultStore )
                 {
-                    if ( ! graphTable
-                      && m_resultFptr )
-                    {
-                        fprintf( m_resultFptr,
-                            "COL %d %s othr\n",
-                            col+1,
-                            colVar->m_name.latin1() );
-                    }
+                    m_resultStore->storeCol( col );
                 }
             }
             else // if ( ! colVar )
             {
-                if ( m_traceFptr )
+                if ( EQTRACE_ON( trace ) )
                 {
-                    fprintf( m_traceFptr, "    begin column %d none\n", col );
+                    trace->colBegin( col, 0, -1 );
                 }
             }
+            // Reuse this cell's outputs if an earlier run calculated them.
+            cellVar = var;
+            if ( useDisk
+              && m_diskCache->fetch( &m_tableVal[ var ], &m_tableInRx[ cell ] ) )
+            {
+                if ( m_tableExport )
+                {
+                    m_tableExport->storeCell( row, col, &m_tableVal[ cellVar ],
+                        m_tableInRx[ cell ] );
+                }
+                var  += m_tableVars;
+                step += m_tableVars;
+                progress->setProgress( step );
+                continue;
+            }
             // Loop for each table output or graph y-axis variable.
             for ( vid = 0;
                   vid < m_tableVars;
@@ -1714,13 +1940,9 @@ bool EqTree::runTable( const QString &traceFile, const QString &resultFile,
                 outVar = m_tableVar[ vid ];
 
                 // Log start of this loop.
-                if ( m_traceFptr )
+                if ( EQTRACE_ON( trace ) )
                 {
-                    fprintf( m_traceFptr,
-                        "      begin output %d %s \"%s\"\n",
-                        vid,
-                        outVar->m_name.latin1(),
-                        outVar->m_label->latin1() );
+                    trace->outputBegin( vid, outVar );
                 }
                 // Calculate the output for this row/col combination.
                 calculateVariable( outVar, 0 );
@@ -1739,10 +1961,9 @@ bool EqTree::runTable( const QString &traceFile, const QString &resultFile,
                 }
 
                 // Log end of this loop.
-                if ( m_traceFptr )
+                if ( EQTRACE_ON( trace ) )
                 {
-                    fprintf( m_traceFptr, "      end output %d %s\n",
-                        vid, outVar->m_name.latin1() );
+                    trace->outputEnd( vid, outVar );
                 }
                 // Update progress dialog.
                 progress->setProgress( ++step );
@@ -1750,6 +1971,7 @@ bool EqTree::runTable( const QString &traceFile, const QString &resultFile,
                 if ( progress->wasCancelled() )
                 {
                     delete progress;    progress = 0;
+                    delete m_tableExport;   m_tableExport = 0;
                     resultFileClose();
                     traceFileClose();
                     return( false );
@@ -1774,106 +1996,377 @@ bool EqTree::runTable( const QString &traceFile, const QString &resultFile,
             }
 //fprintf( stderr, "Cell %d is %s\n",
 //cell, m_tableInRx[cell] ? "INSIDE" : "OUTSIDE" );
+            if ( useDisk )
+            {
+                m_diskCache->store( &m_tableVal[ cellVar ], m_tableInRx[ cell ] );
+            }
+
+            // Store all variables in the result file columns
+            if ( m_resultStore )
+            {
+                m_resultStore->storeCell( row, col );
+            }
+            // Store the cell's surface fire spread profiles
+            if ( m_spreadProfile )
+            {
+                m_eqCalc->SpreadProfileFire( m_spreadProfile->fire() );
+                m_spreadProfile->storeCell( row, col );
+            }
+            // Format all variables into the table export spools
+            if ( m_tableExport )
+            {
+                m_tableExport->storeCell( row, col, &m_tableVal[ cellVar ],
+                    m_tableInRx[ cell ] );
+            }
+
+            // Log end of this loop.
+            if ( EQTRACE_ON( trace ) )
+            {
+                trace->colEnd( col, colVar );
+            }
+        } // Next table column or graph z-axis variable.
+        // Log end of this loop.
+        if ( EQTRACE_ON( trace ) )
+        {
+            trace->rowEnd( row, rowVar );
+        }
+    } // Next table row or graph x-axis variable.
+    // Log the table footer
+    if ( EQTRACE_ON( trace ) )
+    {
+        trace->tableEnd( m_tableRows, m_tableCols, m_tableVars );
+    }
+    // Clean up and return.
+    if ( m_tableExport && ! m_tableExport->end() )
+    {
+        delete m_tableExport;   m_tableExport = 0;
+    }
+    resultFileClose();
+    traceFileClose();
+    if ( EQTRACE_ON( trace ) )
+    {
+        traceFileCheck();
+    }
+    if ( useDisk )
+    {
+        m_diskCache->end();
+    }
+
+    // Keep the table results for a subsequent graph run.
+    if ( ! graphTable )
+    {
+        m_resultCache->store( rowVar, m_tableRows, m_tableRow,
+            colVar, m_tableCols, m_tableCol, m_tableVar, m_tableVars,
+            m_tableVal, m_tableInRx );
+    }
 
-            // Dump all variables
-            if ( ! graphTable
-              && m_resultFptr )
+    // Refine graph curves where they bend or jump.
+    if ( graphTable && ! runTableRefine( progress, &step ) )
+    {
+        delete progress;    progress = 0;
+        return( false );
+    }
+
+    // Clean up and return.
+    delete progress;    progress = 0;
+    return( true );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Adds graph x-axis points where the graph curves bend or jump.
+ *
+ *  If the "graphLineAdaptive" property is TRUE, the equally spaced run is
+ *  refined in passes until there are "graphLineMaxPoints" x-axis values.
+ *  Each pass measures how far each interior point of every curve lies from
+ *  the chord between its neighbours, as a fraction of that curve's y range,
+ *  and adds an x-axis value midway through each interval next to the most
+ *  distant points.  Only the new x-axis values are calculated, for every
+ *  table column and output variable, and they are merged into the
+ *  m_tableRow[], m_tableVal[], and m_tableInRx[] arrays so the rows remain
+ *  in x-axis order.  Refinement stops early when every curve is within a
+ *  small fraction of its y range of a straight line, and no interval is
+ *  split into pieces narrower than half the x range divided by
+ *  "graphLineMaxPoints", so a discontinuity is bracketed without using up
+ *  the whole budget.
+ *
+ *  The added points are not traced, since the trace file is closed first.
+ *
+ *  Called only by EqTree::runTable() for graph runs.
+ *
+ *  \param progress Pointer to the runTable() progress dialog.
+ *  \param step     Pointer to the current progress dialog step.
+ *
+ *  \return TRUE on success, FALSE if the user cancelled the run.
+ */
+
+bool EqTree::runTableRefine( QProgressDialog *progress, int *step )
+{
+    // Only continuous graph x-axis variables may be refined.
+    EqVar *rowVar = m_rangeVar[0];
+    if ( ! rowVar
+      || ! rowVar->isContinuous()
+      || ! m_propDict->boolean( "graphLineAdaptive" ) )
+    {
+        return( true );
+    }
+    int maxRows = m_propDict->integer( "graphLineMaxPoints" );
+    if ( m_tableRows < 3
+      || maxRows <= m_tableRows )
+    {
+        return( true );
+    }
+    double xRange = m_tableRow[ m_tableRows - 1 ] - m_tableRow[0];
+    if ( xRange <= 0. )
+    {
+        return( true );
+    }
+    // Deviations less than this fraction of a curve's y range are ignored
+    const double tolerance = 0.001;
+    // Intervals narrower than this are never split
+    double minDx = xRange / ( 2. * maxRows );
+
+    // Each row has this many output values
+    int rowSize = m_tableCols * m_tableVars;
+    double *yMin = new double[ 2 * rowSize ];
+    checkmem( __FILE__, __LINE__, yMin, "double yMin", 2 * rowSize );
+    double *yMax = yMin + rowSize;
+    int row, k, vid;
+    while ( m_tableRows < maxRows )
+    {
+        // Determine each continuous curve's current y range
+        for ( k = 0;
+              k < rowSize;
+              k++ )
+        {
+            yMin[k] = yMax[k] = m_tableVal[k];
+            for ( row = 1;
+                  row < m_tableRows;
+                  row++ )
             {
-                for ( vid = 0;
-                      vid < m_varCount;
-                      vid++ )
+                double y = m_tableVal[ row * rowSize + k ];
+                if ( y < yMin[k] )
                 {
-                    // Set the output variable pointer.
-                    outVar = m_var[ vid ];
-                    // Dump the variable's current value
-                    if ( outVar->isDiscrete() )
-                    {
-                        iid = outVar->m_itemList->itemIdWithName(
-                            outVar->activeItemName() );
-                        fprintf( m_resultFptr,
-                            "CELL %d %d %s disc %s\n",
-                            row+1,
-                            col+1,
-                            outVar->m_name.latin1(),
-                            outVar->getItemName( iid ).latin1() );
-                    }
-                    else if ( outVar->isContinuous() )
-                    {
-                        fprintf( m_resultFptr,
-                            "CELL %d %d %s cont %g %s\n",
-                            row+1,
-                            col+1,
-                            outVar->m_name.latin1(),
-                            outVar->m_displayValue,
-                            outVar->m_displayUnits.latin1() );
-                    }
-                    else if ( outVar->isText() )
-                    {
-                        fprintf( m_resultFptr,
-                            "CELL %d %d %s text %s\n",
-                            row+1,
-                            col+1,
-                            outVar->m_name.latin1(),
-                            outVar->m_store.latin1() );
-                    }
-                    else
+                    yMin[k] = y;
+                }
+                if ( y > yMax[k] )
+                {
+                    yMax[k] = y;
+                }
+            }
+            // Discrete outputs are not refined
+            vid = k % m_tableVars;
+            if ( ! m_tableVar[vid]->isContinuous() )
+            {
+                yMax[k] = yMin[k];
+            }
+        }
+        // Determine each interior point's largest relative chord deviation
+        double *dev = new double[ 2 * m_tableRows ];
+        checkmem( __FILE__, __LINE__, dev, "double dev", 2 * m_tableRows );
+        double *score = dev + m_tableRows;
+        dev[0] = dev[ m_tableRows - 1 ] = 0.;
+        for ( row = 1;
+              row < m_tableRows - 1;
+              row++ )
+        {
+            double x0 = m_tableRow[ row - 1 ];
+            double x2 = m_tableRow[ row + 1 ];
+            double f  = ( m_tableRow[row] - x0 ) / ( x2 - x0 );
+            const double *y0 = &m_tableVal[ ( row - 1 ) * rowSize ];
+            const double *y1 = y0 + rowSize;
+            const double *y2 = y1 + rowSize;
+            dev[row] = 0.;
+            for ( k = 0;
+                  k < rowSize;
+                  k++ )
+            {
+                if ( yMax[k] > yMin[k] )
+                {
+                    double d = fabs( y1[k] - y0[k] - f * ( y2[k] - y0[k] ) )
+                             / ( yMax[k] - yMin[k] );
+                    if ( d > dev[row] )
                     {
-                        fprintf( m_resultFptr,
-                            "CELL %d %d %s othr\n",
-                            row+1,
-                            col+1,
-                            outVar->m_name.latin1() );
+                        dev[row] = d;
                     }
                 }
             }
-
-            // Log end of this loop.
-            if ( colVar )
+        }
+        // Score each interval by its end points' deviations
+        int candidates = 0;
+        for ( row = 0;
+              row < m_tableRows - 1;
+              row++ )
+        {
+            score[row] = 0.;
+            if ( m_tableRow[ row + 1 ] - m_tableRow[row] >= 2. * minDx )
             {
-                if ( m_traceFptr )
+                score[row] = ( dev[row] > dev[ row + 1 ] )
+                           ? dev[row]
+                           : dev[ row + 1 ];
+                if ( score[row] > tolerance )
                 {
-                    fprintf( m_traceFptr, "    end column %d %s\n",
-                        col, colVar->m_name.latin1() );
+                    candidates++;
+                }
+                else
+                {
+                    score[row] = 0.;
                 }
             }
-            else // if ( ! colVar )
+        }
+        // If every curve is straight enough, we're done
+        if ( ! candidates )
+        {
+            delete[] dev;
+            break;
+        }
+        // Split only the highest scoring intervals if over budget
+        int budget = maxRows - m_tableRows;
+        double threshold = tolerance;
+        if ( candidates > budget )
+        {
+            memcpy( dev, score, ( m_tableRows - 1 ) * sizeof(double) );
+            qsort( dev, m_tableRows - 1, sizeof(double), EqTree_ScoreCompare );
+            threshold = dev[ budget - 1 ];
+            candidates = budget;
+        }
+        // Allocate the refined table arrays
+        int newRows  = m_tableRows + candidates;
+        int newCells = newRows * rowSize;
+        double *newRow = new double[ newRows ];
+        checkmem( __FILE__, __LINE__, newRow, "double newRow", newRows );
+        double *newVal = new double[ newCells ];
+        checkmem( __FILE__, __LINE__, newVal, "double newVal", newCells );
+        bool *newInRx = new bool[ newRows * m_tableCols ];
+        checkmem( __FILE__, __LINE__, newInRx, "bool newInRx",
+            newRows * m_tableCols );
+        progress->setTotalSteps( progress->totalSteps()
+            + candidates * rowSize );
+
+        // Copy the existing rows and calculate the new rows between them
+        int added = 0;
+        int to = 0;
+        for ( row = 0;
+              row < m_tableRows;
+              row++ )
+        {
+            newRow[to] = m_tableRow[row];
+            memcpy( &newVal[ to * rowSize ], &m_tableVal[ row * rowSize ],
+                rowSize * sizeof(double) );
+            memcpy( &newInRx[ to * m_tableCols ],
+                &m_tableInRx[ row * m_tableCols ],
+                m_tableCols * sizeof(bool) );
+            to++;
+            if ( row < m_tableRows - 1
+              && added < candidates
+              && score[row] > tolerance
+              && score[row] >= threshold )
             {
-                if ( m_traceFptr )
+                newRow[to] = 0.5 * ( m_tableRow[row] + m_tableRow[ row + 1 ] );
+                runTableRow( newRow[to], &newVal[ to * rowSize ],
+                    &newInRx[ to * m_tableCols ] );
+                to++;
+                added++;
+                *step += rowSize;
+                progress->setProgress( *step );
+                qApp->processEvents();
+                if ( progress->wasCancelled() )
                 {
-                    fprintf( m_traceFptr, "    end column %d none\n", col );
+                    delete[] newRow;
+                    delete[] newVal;
+                    delete[] newInRx;
+                    delete[] dev;
+                    delete[] yMin;
+                    return( false );
                 }
             }
-        } // Next table column or graph z-axis variable.
-        // Log end of this loop.
-        if ( rowVar )
+        }
+        delete[] dev;   dev = 0;
+        // Replace the table arrays with the refined arrays
+        delete[] m_tableRow;    m_tableRow = newRow;
+        delete[] m_tableVal;    m_tableVal = newVal;
+        delete[] m_tableInRx;   m_tableInRx = newInRx;
+        m_tableRows  = to;
+        m_tableCells = m_tableRows * rowSize;
+    }
+    delete[] yMin;  yMin = 0;
+
+    // Leave the row variable at its last value, as runTable() does
+    rowVar->setDisplayValue( m_tableRow[ m_tableRows - 1 ] );
+    return( true );
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Calculates every table column and output variable for a single
+ *  graph x-axis value, without tracing or storing to the result file.
+ *
+ *  Called only by EqTree::runTableRefine().
+ *
+ *  \param rowValue Row (graph x-axis) variable display value.
+ *  \param val      Array of m_tableCols * m_tableVars returned values,
+ *                  in the same order as a row of m_tableVal[].
+ *  \param inRx     Array of m_tableCols returned prescription flags.
+ */
+
+void EqTree::runTableRow( double rowValue, double *val, bool *inRx )
+{
+    EqVar *colVar = m_rangeVar[1];
+    EqVar *outVar;
+    RxVar *rxVar;
+    m_rangeVar[0]->setDisplayValue( rowValue );
+    int var = 0;
+    for ( int col = 0;
+          col < m_tableCols;
+          col++ )
+    {
+        // Set this column's input value.
+        if ( colVar )
         {
-            if ( m_traceFptr )
+            if ( colVar->isDiscrete() )
             {
-                fprintf( m_traceFptr, "    end row %d %s\n",
-                    row, rowVar->m_name.latin1() );
+                int iid = (int) m_tableCol[ col ];
+                colVar->setItemName( colVar->getItemName( iid ) );
+            }
+            else if ( colVar->isContinuous() )
+            {
+                colVar->setDisplayValue( m_tableCol[ col ] );
             }
         }
-        else // if ( ! rowVar )
+        // Calculate and store each output value.
+        for ( int vid = 0;
+              vid < m_tableVars;
+              vid++ )
         {
-            if ( m_traceFptr )
+            outVar = m_tableVar[ vid ];
+            calculateVariable( outVar, 0 );
+            if ( outVar->isDiscrete() )
+            {
+                val[ var++ ] = 0.5 + (double)
+                    outVar->m_itemList->itemIdWithName(
+                        outVar->activeItemName() );
+            }
+            else if ( outVar->isContinuous() )
             {
-                fprintf( m_traceFptr, "    end row %d none\n", row );
+                val[ var++ ] = outVar->m_displayValue;
+            }
+        }
+        // Determine if results are within prescription
+        inRx[col] = true;
+        for ( rxVar = m_rxVarList->first();
+              rxVar;
+              rxVar = m_rxVarList->next() )
+        {
+            if ( rxVar->m_isActive
+              && rxVar->m_varPtr->m_isUserOutput )
+            {
+                if ( ! rxVar->inRange() )
+                {
+                    inRx[col] = false;
+                    break;
+                }
             }
         }
-    } // Next table row or graph x-axis variable.
-    // Log the table footer
-    if ( m_traceFptr )
-    {
-        fprintf( m_traceFptr, "end table %d %d %d\n",
-            m_tableRows, m_tableCols, m_tableVars );
     }
-    // Clean up and return.
-    resultFileClose();
-    traceFileClose();
-
-    // Clean up and return.
-    delete progress;    progress = 0;
-    return( true );
+    return;
 }
 
 //------------------------------------------------------------------------------
@@ -2061,9 +2554,13 @@ QString EqTree::tokenConverter( EqVar* varPtr, const QString &token )
  *  \retval -3 More than 2 range variables were detected.
  *  \retval -4 The EqCalc::validateInputs() detected an error.
  *  \retval -5 Mismatched number of values between master and slave input fields.
+ *
+ *  \param maxRangeVars Maximum number of range variables allowed; an
+ *  EqSweep may have more than the two a table run allows.
  */
 
-int EqTree::validateInputs( int *badLid, int *badPosition, int *badLength )
+int EqTree::validateInputs( int *badLid, int *badPosition, int *badLength,
+        int maxRangeVars )
 {
     // Initialize the rangeVar[] pointer array.
     m_rangeVars = 0;
@@ -2154,8 +2651,8 @@ int EqTree::validateInputs( int *badLid, int *badPosition, int *badLength )
         }   //if ( varPtr->isDiscrete() || varPtr->isContinuous() )
     }   // for
 
-    // Ensure there are no more than 2 range variables.
-    if ( m_rangeVars > 2 )
+    // Ensure there are no more than 2 (or maxRangeVars) range variables.
+    if ( m_rangeVars > maxRangeVars )
     {
         QString text("");
         for ( int mid = 0;
@@ -2414,6 +2911,55 @@ int strMinMax( const QString &qStr, double *minval, double *maxval )
     return( n );
 }
 
+//------------------------------------------------------------------------------
+/*! \brief EqTreeRun constructor.
+ *
+ *  \param maxRangeVars Size of the range variable array.
+ */
+
+EqTreeRun::EqTreeRun( int maxRangeVars ) :
+    m_maxRangeVars(maxRangeVars),
+    m_rangeVar(0),
+    m_rangeVars(0),
+    m_rangeCase(0),
+    m_tableRows(0),
+    m_tableCols(0),
+    m_tableVars(0),
+    m_tableCells(0),
+    m_tableCol(0),
+    m_tableRow(0),
+    m_tableVal(0),
+    m_tableInRx(0),
+    m_tableVar(0),
+    m_tableSlice("")
+{
+    m_rangeVar = new EqVar *[ m_maxRangeVars ];
+    checkmem( __FILE__, __LINE__, m_rangeVar, "EqVar *m_rangeVar",
+        m_maxRangeVars );
+    for ( int i = 0;
+          i < m_maxRangeVars;
+          i++ )
+    {
+        m_rangeVar[i] = 0;
+    }
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief EqTreeRun destructor.
+ */
+
+EqTreeRun::~EqTreeRun( void )
+{
+    delete[] m_rangeVar;    m_rangeVar = 0;
+    delete[] m_tableRow;    m_tableRow = 0;
+    delete[] m_tableCol;    m_tableCol = 0;
+    delete[] m_tableVal;    m_tableVal = 0;
+    delete[] m_tableInRx;   m_tableInRx = 0;
+    delete[] m_tableVar;    m_tableVar = 0;
+    return;
+}
+
 //------------------------------------------------------------------------------
 //  End of xeqtree.cpp
 //------------------------------------------------------------------------------
@@ -16,7 +16,13 @@
 #include "xeqvar.h"
 class EqApp;
 class EqCalc;
+class EqDiskCache;
 class EqFun;
+class EqResultCache;
+class EqResultStore;
+class EqSpreadProfile;
+class EqTableExport;
+class EqTrace;
 class EqVarItem;
 class EqVarItemList;
 class FuelModelList;
@@ -26,11 +32,49 @@ class RxVarList;
 
 // Qt class references
 #include <qdict.h>
+class QProgressDialog;
 #include <qstring.h>
 
 // Standard include files
 #include <stdio.h>
 
+//------------------------------------------------------------------------------
+/*! \class EqTreeRun xeqtree.h
+ *
+ *  \brief Holds the table arrays and range variables of a completed
+ *  EqTree::runTable() so they may outlive the run.
+ *
+ *  EqTree::runDetach() moves the EqTree's current run results into a new
+ *  EqTreeRun, and EqTree::runSwap() exchanges them with the EqTree's
+ *  current run results.  This allows BpDocument to compose result pages
+ *  long after EqTree::runClean() or a subsequent graph run.
+ */
+
+class EqTreeRun
+{
+// Public methods
+public:
+    EqTreeRun( int maxRangeVars ) ;
+    ~EqTreeRun( void ) ;
+
+// Public data members
+public:
+    int             m_maxRangeVars; //!< Size of the m_rangeVar[] array
+    EqVar         **m_rangeVar;     //!< Arrays of ptrs to range vars
+    int             m_rangeVars;    //!< Number of range variables
+    int             m_rangeCase;    //!< Continuous/discrete range variable case
+    int             m_tableRows;    //!< Results table rows
+    int             m_tableCols;    //!< Results table columns
+    int             m_tableVars;    //!< Results table variables
+    int             m_tableCells;   //!< Results table cells
+    double         *m_tableCol;     //!< Dynamic array of table column values
+    double         *m_tableRow;     //!< Dynamic array of table row values
+    double         *m_tableVal;     //!< Dynamic array of table results
+    bool           *m_tableInRx;    //!< Dynamic array of table shade toggles
+    EqVar         **m_tableVar;     //!< Dynamic array of table EqVar ptrs
+    QString         m_tableSlice;   //!< Fixed sweep values of a table slice
+};
+
 //------------------------------------------------------------------------------
 /*! \class EqTree xeqtree.h
  *
@@ -66,6 +110,7 @@ public:
     void   resultFileClose( void ) ;
     bool   resultFileInit( const QString &fileName ) ;
     void   resultFileRemove( void ) ;
+    bool   traceFileCheck( void ) ;
     void   traceFileClose( void ) ;
     bool   traceFileInit( const QString &fileName ) ;
     void   traceFileRemove( void ) ;
@@ -91,19 +136,24 @@ public:
     int    rangeCase( void );
     bool   run( const QString &traceFile, const QString &resultFile ) ;
     void   runClean( void ) ;
+    EqTreeRun *runDetach( void ) ;
     bool   runInit( bool graphTable ) ;
     void   runInitColsFromStore( void ) ;
     void   runInitRowsFromRange( void ) ;
     void   runInitRowsFromStore( void ) ;
     bool   runInitTableVars( void ) ;
+    void   runSwap( EqTreeRun *run ) ;
     bool   runTable( const QString &traceFile="", const QString &resultFile="",
                 bool graphTable=false ) ;
+    bool   runTableRefine( QProgressDialog *progress, int *step ) ;
+    void   runTableRow( double rowValue, double *val, bool *inRx ) ;
     EqFun *setEqFunAddress( const QString &name, PFV address ) ;
     void   setLabel( EqVar *varPtr, const QString &stuff ) ;
     void   setLanguage( const QString &lang ) ;
     double setResult( int row, int col, int var, double value ) ;
 	QString tokenConverter( EqVar* varPtr, const QString &token ) ;
-    int    validateInputs( int *badLid, int *badPosition, int *badLength ) ;
+    int    validateInputs( int *badLid, int *badPosition, int *badLength,
+                int maxRangeVars=2 ) ;
 	int    validateRxInputs( int *badRx ) ;
     void   variableModuleList( EqVar *varPtr, QString &str ) const ;
     bool   writeXmlFile( const QString &fileName, const QString &elementName,
@@ -150,10 +200,16 @@ public:
 	double         *m_tableVal;     //!< Dynamic array of table results
     bool           *m_tableInRx;   	//!< Dynamic array of table shade toggles
     EqVar         **m_tableVar;     //!< Dynamic array of table EqVar ptrs
+    QString         m_tableSlice;   //!< Fixed sweep values of a table slice
     QString         m_resultFile;   //!< Run time result file name
     QString         m_traceFile;    //!< Run time trace file name
-    FILE           *m_resultFptr;   //!< Run time result file stream ptr
-    FILE           *m_traceFptr;    //!< Run time trace file stream ptr
+    QString         m_profileFile;  //!< Spread profile export file name, or empty
+    EqResultStore  *m_resultStore;  //!< Run time columnar result file writer
+    EqSpreadProfile *m_spreadProfile;//!< Run time spread profile file writer
+    EqTrace        *m_trace;        //!< Run time binary trace recorder
+    EqTableExport  *m_tableExport;  //!< Run time two-way table exporter
+    EqResultCache  *m_resultCache;  //!< Most recent table run results
+    EqDiskCache    *m_diskCache;    //!< Persistent table cell results
 };
 
 // Convenience routines
@@ -164,6 +220,7 @@ int  strMinMax( const QString &qStr, double *minval, double *maxval ) ;
 // Comparison functions for sorting variable ptr arrays
 int EqTree_InpOrderCompare( const void *s1, const void *s2 ) ;
 int EqTree_OutOrderCompare( const void *s1, const void *s2 ) ;
+int EqTree_ScoreCompare( const void *s1, const void *s2 ) ;
 
 #endif
 